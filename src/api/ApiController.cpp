@@ -35,6 +35,7 @@ namespace service::api {
             return Result<void>::error(request_handler_result.error());
         }
 
+        // The listener opens only after the core started, so backend warm-up gates serving
         if (const auto transport_result = transport_->start(server_address_); transport_result.isError()) {
             if (const auto result = request_handler_->stop(); result.isError()) {
                 return Result<void>::error(result.error());
@@ -65,11 +66,11 @@ namespace service::api {
         is_running_ = false;
 
         if (const auto transport_result = transport_->stop(); transport_result.isError()) {
-            return Result<void>::error("Error stopping transport: " + transport_result.error());
+            return Result<void>::error(transport_result.error().prefixed("Error stopping transport: "));
         }
 
         if (const auto stop_result = request_handler_->stop(); stop_result.isError()) {
-            return Result<void>::error("Failed to stop request handler: " + stop_result.error());
+            return Result<void>::error(stop_result.error().prefixed("Failed to stop request handler: "));
         }
 
         LOG_DEBUG("ApiController stopped");
@@ -18,14 +18,15 @@ namespace service::api {
         if (server_address == "0.0.0.0:50051") {
             const auto ip_result = common::network::getPrimaryIpAddress();
             if (ip_result.isError()) {
-                throw std::runtime_error("Failed to get device IP: " + ip_result.error());
+                throw std::runtime_error("Failed to get device IP: " + ip_result.error().message);
             }
             server_address = ip_result.value() + ":50051";
         }
 
         if (config.api == "grpc") {
             auto request_handler = std::make_unique<RequestHandler>(std::move(core));
-            auto transport = std::make_unique<GrpcTransport>(*request_handler);
+            auto transport = std::make_unique<GrpcTransport>(*request_handler, config.passthrough,
+                                                             config.control_stream, config.quotas);
             return std::make_unique<ApiController>(std::move(request_handler), std::move(transport), server_address);
         }
 
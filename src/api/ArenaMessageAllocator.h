@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <grpcpp/support/message_allocator.h>
+
+#include "common/memory/ReusableArena.h"
+
+namespace service::api {
+    /**
+     * Type-erased base so allocators of different message types can be owned together
+     */
+    class IArenaMessageAllocator {
+    public:
+        virtual ~IArenaMessageAllocator() = default;
+    };
+
+    /**
+     * gRPC callback message allocator placing request and response on a recycled arena
+     * Each call takes a holder from the free list, the holder's arena is reset on release
+     * and the holder goes back to the list, so steady-state calls do not touch the heap
+     */
+    template<typename RequestType, typename ResponseType>
+    class ArenaMessageAllocator final : public IArenaMessageAllocator,
+                                        public grpc::MessageAllocator<RequestType, ResponseType> {
+    public:
+        /**
+         * @param block_size arena block size per call
+         * @param max_idle_holders holders kept for reuse, extra ones are freed on release
+         */
+        explicit ArenaMessageAllocator(const std::size_t block_size = DEFAULT_BLOCK_SIZE,
+                                       const std::size_t max_idle_holders = DEFAULT_MAX_IDLE_HOLDERS)
+            : block_size_(block_size), max_idle_holders_(max_idle_holders) {
+            idle_holders_.reserve(max_idle_holders_);
+        }
+
+        grpc::MessageHolder<RequestType, ResponseType>* AllocateMessages() override {
+            Holder* holder = nullptr;
+            {
+                std::lock_guard lock(mutex_);
+                if (!idle_holders_.empty()) {
+                    holder = idle_holders_.back().release();
+                    idle_holders_.pop_back();
+                }
+            }
+            if (holder == nullptr) {
+                holder = new Holder(*this);
+            }
+
+            holder->prepare();
+            return holder;
+        }
+
+    private:
+        static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1024;
+        static constexpr std::size_t DEFAULT_MAX_IDLE_HOLDERS = 32;
+
+        class Holder final : public grpc::MessageHolder<RequestType, ResponseType> {
+        public:
+            explicit Holder(ArenaMessageAllocator& allocator)
+                : allocator_(allocator), arena_(allocator.block_size_) {
+            }
+
+            void prepare() {
+                this->set_request(arena_.create<RequestType>());
+                this->set_response(arena_.create<ResponseType>());
+            }
+
+            void Release() override {
+                arena_.reset();
+                allocator_.recycle(this);
+            }
+
+        private:
+            ArenaMessageAllocator& allocator_;
+            common::memory::ReusableArena arena_;
+        };
+
+        void recycle(Holder* holder) {
+            std::unique_ptr<Holder> owned(holder);
+            std::lock_guard lock(mutex_);
+            if (idle_holders_.size() < max_idle_holders_) {
+                idle_holders_.push_back(std::move(owned));
+            }
+        }
+
+        std::size_t block_size_;
+        std::size_t max_idle_holders_;
+
+        std::mutex mutex_;
+        std::vector<std::unique_ptr<Holder>> idle_holders_;
+    };
+} // namespace service::api
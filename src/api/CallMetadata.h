@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <grpcpp/server_context.h>
+
+#include "common/state/CallContext.h"
+
+namespace service::api {
+    // Call metadata carrying the lease_id returned by AcquireControl, in decimal
+    constexpr auto CONTROL_LEASE_METADATA = "x-control-lease";
+    // Call metadata carrying the priority class: interactive, normal or background
+    constexpr auto PRIORITY_METADATA = "x-priority";
+    // Call metadata naming the client, calls without it are attributed to the host of their peer
+    constexpr auto CLIENT_ID_METADATA = "x-client-id";
+    // Call metadata naming a Set call across its retries, a retry with the same key does not reach the camera again
+    constexpr auto IDEMPOTENCY_KEY_METADATA = "x-idempotency-key";
+    // Trailing metadata of a call rejected by its caller's quota, milliseconds until the quota allows a call
+    constexpr auto RETRY_AFTER_METADATA = "retry-after-ms";
+
+    // Longer client ids are truncated
+    constexpr std::size_t MAX_CLIENT_ID_LENGTH = 64;
+    // Longer idempotency keys are ignored, truncating them could make distinct calls share a key
+    constexpr std::size_t MAX_IDEMPOTENCY_KEY_LENGTH = 128;
+
+    /**
+     * @return peer address of a call without its port, e.g. ipv4:10.0.0.5 or ipv6:[::1]
+     */
+    inline std::string peerHost(const grpc::ServerContextBase& context) {
+        auto peer = context.peer();
+        if (const auto colon = peer.rfind(':'); colon != std::string::npos && peer.find(':') != colon) {
+            peer.resize(colon);
+        }
+        return peer;
+    }
+
+    /**
+     * @return context of a call from its metadata, missing or malformed entries keep their defaults
+     */
+    inline common::state::CallContext callContextOf(const grpc::ServerContextBase& context) {
+        common::state::CallContext call;
+        const auto& metadata = context.client_metadata();
+
+        if (const auto entry = metadata.find(CONTROL_LEASE_METADATA); entry != metadata.end()) {
+            uint64_t lease_id = 0;
+            const auto* const end = entry->second.data() + entry->second.size();
+            if (const auto [parsed, error] = std::from_chars(entry->second.data(), end, lease_id);
+                error == std::errc() && parsed == end) {
+                call.lease_id = lease_id;
+            }
+        }
+
+        if (const auto entry = metadata.find(PRIORITY_METADATA); entry != metadata.end()) {
+            const std::string_view priority(entry->second.data(), entry->second.size());
+            if (priority == "interactive") {
+                call.priority = common::types::Priority::Interactive;
+            } else if (priority == "background") {
+                call.priority = common::types::Priority::Background;
+            }
+        }
+
+        if (const auto entry = metadata.find(CLIENT_ID_METADATA); entry != metadata.end() && !entry->second.empty()) {
+            call.caller.assign(entry->second.data(), std::min(entry->second.size(), MAX_CLIENT_ID_LENGTH));
+        } else {
+            call.caller = peerHost(context);
+        }
+
+        if (const auto entry = metadata.find(IDEMPOTENCY_KEY_METADATA);
+            entry != metadata.end() && entry->second.size() <= MAX_IDEMPOTENCY_KEY_LENGTH) {
+            call.idempotency_key.assign(entry->second.data(), entry->second.size());
+        }
+
+        if (const auto deadline = context.deadline(); deadline != std::chrono::system_clock::time_point::max()) {
+            call.deadline = std::chrono::steady_clock::now() +
+                            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                deadline - std::chrono::system_clock::now());
+        }
+        return call;
+    }
+} // namespace service::api
@@ -0,0 +1,107 @@
+#include "CallerQuotas.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "api/CallMetadata.h"
+#include "common/logger/Logger.h"
+#include "common/types/DispatchMetrics.h"
+
+namespace service::api {
+    CallerQuotas::CallerQuotas(const common::QuotasConfig& config) : config_(config) {
+        for (const auto& quota : config_.callers) {
+            quotas_.emplace(quota.caller, &quota);
+        }
+    }
+
+    std::optional<std::chrono::milliseconds> CallerQuotas::acquire(const std::string& caller,
+                                                                   const std::string& host) {
+        const auto& quota = quotaOf(caller);
+        if (quota.rate_hz <= 0) {
+            return std::nullopt;
+        }
+
+        const auto now = Clock::now();
+        std::lock_guard lock(mutex_);
+        expireIdle(now);
+        auto [bucket, created] = bucketOf(caller, quota, now);
+
+        // Client ids are chosen by the client, so a new one inherits the tokens left to its host and its first call
+        // is charged to the host as well, rotating ids then neither refills the burst nor escapes the host's quota
+        if (created && !host.empty() && host != caller && !quotas_.contains(caller)) {
+            if (const auto& host_quota = quotaOf(host); host_quota.rate_hz > 0) {
+                auto& host_bucket = bucketOf(host, host_quota, now).first;
+                bucket.tokens = std::min(bucket.tokens, host_bucket.tokens);
+                host_bucket.tokens = std::max(host_bucket.tokens - 1, 0.0);
+            }
+        }
+
+        if (bucket.tokens >= 1) {
+            bucket.tokens -= 1;
+            return std::nullopt;
+        }
+
+        ++bucket.throttled;
+        const auto wait_ms = std::ceil((1 - bucket.tokens) * 1000 / quota.rate_hz);
+        return std::chrono::milliseconds(std::max<int64_t>(static_cast<int64_t>(wait_ms), 1));
+    }
+
+    grpc::Status CallerQuotas::admit(grpc::ServerContextBase& context, const common::state::CallContext& call) {
+        const auto retry_after = acquire(call.caller, peerHost(context));
+        if (!retry_after) {
+            return grpc::Status::OK;
+        }
+
+        LOG_DEBUG("Throttled call of {}, retry in {} ms", call.caller, retry_after->count());
+        context.AddTrailingMetadata(RETRY_AFTER_METADATA, std::to_string(retry_after->count()));
+        return {grpc::StatusCode::RESOURCE_EXHAUSTED, "Request rate quota of " + call.caller + " is used up, retry in " +
+                                                          std::to_string(retry_after->count()) + " ms"};
+    }
+
+    std::unordered_map<std::string, uint64_t> CallerQuotas::throttled() const {
+        std::unordered_map<std::string, uint64_t> throttled;
+        std::lock_guard lock(mutex_);
+        for (const auto& [caller, bucket] : buckets_) {
+            if (bucket.throttled > 0) {
+                throttled.emplace(caller, bucket.throttled);
+            }
+        }
+        return throttled;
+    }
+
+    const common::CallerQuota& CallerQuotas::quotaOf(const std::string& caller) const {
+        const auto it = quotas_.find(caller);
+        return it == quotas_.end() ? config_.defaults : *it->second;
+    }
+
+    std::pair<CallerQuotas::Bucket&, bool> CallerQuotas::bucketOf(const std::string& caller,
+                                                                  const common::CallerQuota& quota,
+                                                                  const Clock::time_point now) {
+        auto it = buckets_.find(caller);
+        if (it == buckets_.end() && buckets_.size() >= config_.max_callers) {
+            it = buckets_.find(std::string(common::types::OTHER_CALLERS));
+        }
+        if (it == buckets_.end()) {
+            const auto& key = buckets_.size() < config_.max_callers ? caller
+                                                                    : std::string(common::types::OTHER_CALLERS);
+            auto& bucket = buckets_.try_emplace(key).first->second;
+            bucket.tokens = quota.burst;
+            bucket.refilled = now;
+            return {bucket, key == caller};
+        }
+
+        auto& bucket = it->second;
+        const std::chrono::duration<double> elapsed = now - bucket.refilled;
+        bucket.tokens = std::min<double>(quota.burst, bucket.tokens + elapsed.count() * quota.rate_hz);
+        bucket.refilled = now;
+        return {bucket, false};
+    }
+
+    void CallerQuotas::expireIdle(const Clock::time_point now) {
+        if (now < next_expiry_) {
+            return;
+        }
+        next_expiry_ = now + config_.idle_timeout;
+        std::erase_if(buckets_, [&](const auto& entry) { return now - entry.second.refilled >= config_.idle_timeout; });
+    }
+} // namespace service::api
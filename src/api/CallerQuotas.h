@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <grpcpp/server_context.h>
+
+#include "common/config/ConfigManager.h"
+#include "common/state/CallContext.h"
+
+namespace service::api {
+    /**
+     * Request rate quotas of callers, a token bucket per caller refilled at its rate up to its burst
+     * Callers without a quota of their own share the default one, each with its own bucket
+     * At most max_callers buckets are kept, later callers share one, and buckets idle for idle_timeout are dropped
+     */
+    class CallerQuotas {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit CallerQuotas(const common::QuotasConfig& config = {});
+
+        CallerQuotas(const CallerQuotas&) = delete;
+        CallerQuotas& operator=(const CallerQuotas&) = delete;
+
+        /**
+         * Take one call from the quota of a caller
+         * @param host peer host of the caller, a client id seen for the first time starts from what is left in the
+         *             bucket of its host instead of a full burst, empty if the caller is named by its host
+         * @return time until the quota allows the next call if it is used up, nothing if the call may proceed
+         */
+        std::optional<std::chrono::milliseconds> acquire(const std::string& caller, const std::string& host = {});
+
+        /**
+         * Take one call from the quota of the caller of a call
+         * @return RESOURCE_EXHAUSTED with the retry-after-ms trailing metadata set if the quota is used up
+         */
+        grpc::Status admit(grpc::ServerContextBase& context, const common::state::CallContext& call);
+
+        /**
+         * @return calls rejected so far by caller, callers never rejected or dropped while idle are left out
+         */
+        std::unordered_map<std::string, uint64_t> throttled() const;
+
+    private:
+        struct Bucket {
+            double tokens{0};
+            Clock::time_point refilled;
+            uint64_t throttled{0};
+        };
+
+        const common::CallerQuota& quotaOf(const std::string& caller) const;
+
+        /**
+         * @return bucket of a caller refilled up to now and whether it was just created with a full burst,
+         *         the shared OTHER_CALLERS bucket once max_callers buckets exist
+         */
+        std::pair<Bucket&, bool> bucketOf(const std::string& caller, const common::CallerQuota& quota,
+                                          Clock::time_point now);
+
+        /**
+         * Drop the buckets not used for idle_timeout, at most once per idle_timeout
+         */
+        void expireIdle(Clock::time_point now);
+
+        const common::QuotasConfig config_;
+        std::unordered_map<std::string, const common::CallerQuota*> quotas_; // by caller, into config_
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Bucket> buckets_; // by caller, created on its first limited call
+        Clock::time_point next_expiry_;
+    };
+} // namespace service::api
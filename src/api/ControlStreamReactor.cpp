@@ -0,0 +1,188 @@
+#include "ControlStreamReactor.h"
+
+#include <utility>
+
+#include "api/IRequestHandler.h"
+
+namespace service::api {
+    ControlStreamReactor::ControlStreamReactor(IRequestHandler& request_handler, ServerStreamRegistry& streams,
+                                               const std::chrono::microseconds min_interval,
+                                               const common::state::CallContext& call)
+        : request_handler_(request_handler), streams_(streams), min_interval_(min_interval), call_(call) {
+        StartRead(&setpoint_);
+        forwarder_ = std::jthread([this](const std::stop_token& stop_token) { forward(stop_token); });
+    }
+
+    void ControlStreamReactor::OnReadDone(const bool ok) {
+        std::optional<uint32_t> bound_camera_id;
+        {
+            std::lock_guard lock(mutex_);
+            if (!ok) {
+                // Client half-closed, the forwarder flushes what is pending and finishes
+                reads_done_ = true;
+                pending_cv_.notify_all();
+                return;
+            }
+            if (finish_requested_) {
+                return;
+            }
+
+            if (camera_id_ && *camera_id_ != setpoint_.camera_id()) {
+                bound_camera_id = camera_id_;
+            } else {
+                camera_id_ = setpoint_.camera_id();
+                if (setpoint_.has_zoom()) {
+                    pending_zoom_ = setpoint_.zoom();
+                }
+                if (setpoint_.has_focus()) {
+                    pending_focus_ = setpoint_.focus();
+                }
+                pending_cv_.notify_all();
+            }
+        }
+
+        if (bound_camera_id) {
+            close(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                               "ControlStream is bound to camera " + std::to_string(*bound_camera_id)));
+            return;
+        }
+        StartRead(&setpoint_);
+    }
+
+    void ControlStreamReactor::OnWriteDone(const bool ok) {
+        bool write = false;
+        bool finish = false;
+        {
+            std::lock_guard lock(mutex_);
+            writing_ = false;
+            if (ok && pending_report_ && (!finish_requested_ || final_status_.ok())) {
+                applied_ = std::move(*pending_report_);
+                pending_report_.reset();
+                writing_ = true;
+                write = true;
+            } else if (finish_requested_) {
+                finish = true;
+            }
+        }
+
+        if (write) {
+            StartWrite(&applied_);
+        } else if (finish) {
+            Finish(final_status_);
+        } else if (!ok) {
+            close(grpc::Status::CANCELLED);
+        }
+    }
+
+    void ControlStreamReactor::OnCancel() {
+        close(grpc::Status::CANCELLED);
+    }
+
+    void ControlStreamReactor::OnDone() {
+        forwarder_.request_stop();
+        if (forwarder_.joinable()) {
+            forwarder_.join();
+        }
+        streams_.remove(this);
+        delete this;
+    }
+
+    void ControlStreamReactor::close(const grpc::Status& status) {
+        {
+            std::lock_guard lock(mutex_);
+            if (finish_requested_) {
+                return;
+            }
+            finish_requested_ = true;
+            final_status_ = status;
+            pending_cv_.notify_all();
+            if (writing_) {
+                // Finished once the outstanding write completes
+                return;
+            }
+        }
+        Finish(status);
+    }
+
+    void ControlStreamReactor::forward(const std::stop_token& stop_token) {
+        common::state::CallContext::Scope scope(call_);
+        auto next_allowed = std::chrono::steady_clock::now();
+        while (!stop_token.stop_requested()) {
+            uint32_t camera_id = 0;
+            std::optional<common::types::zoom> zoom_level;
+            std::optional<common::types::focus> focus_value;
+            {
+                std::unique_lock lock(mutex_);
+                pending_cv_.wait(lock, stop_token, [this] {
+                    return pending_zoom_ || pending_focus_ || reads_done_ || finish_requested_;
+                });
+                if (stop_token.stop_requested() || finish_requested_) {
+                    return;
+                }
+                if (!pending_zoom_ && !pending_focus_) {
+                    // Client is done and every setpoint was forwarded
+                    lock.unlock();
+                    close(grpc::Status::OK);
+                    return;
+                }
+
+                // Setpoints read meanwhile replace the pending ones
+                if (pending_cv_.wait_until(lock, stop_token, next_allowed, [this] { return finish_requested_; }) ||
+                    stop_token.stop_requested()) {
+                    return;
+                }
+
+                camera_id = *camera_id_;
+                zoom_level = std::exchange(pending_zoom_, std::nullopt);
+                focus_value = std::exchange(pending_focus_, std::nullopt);
+            }
+
+            next_allowed = std::chrono::steady_clock::now() + min_interval_;
+            report(apply(camera_id, zoom_level, focus_value));
+        }
+    }
+
+    core::v1::ControlApplied ControlStreamReactor::apply(
+        const uint32_t camera_id,
+        const std::optional<common::types::zoom> zoom_level,
+        const std::optional<common::types::focus> focus_value) const {
+        core::v1::ControlApplied applied;
+        if (zoom_level) {
+            if (const auto result = request_handler_.setZoom(camera_id, *zoom_level); result.isError()) {
+                applied.set_error_message(result.error().message);
+            } else {
+                applied.set_zoom(result.value());
+            }
+        }
+        if (focus_value) {
+            if (const auto result = request_handler_.setFocus(camera_id, *focus_value); result.isError()) {
+                applied.set_error_message(applied.error_message().empty()
+                                              ? result.error().message
+                                              : applied.error_message() + "; " + result.error().message);
+            } else {
+                applied.set_focus(result.value());
+            }
+        }
+        return applied;
+    }
+
+    void ControlStreamReactor::report(const core::v1::ControlApplied& applied) {
+        {
+            std::lock_guard lock(mutex_);
+            if (finish_requested_) {
+                return;
+            }
+            if (writing_) {
+                // Keep the newest value of each field and the newest error only
+                auto merged = pending_report_.value_or(core::v1::ControlApplied());
+                merged.MergeFrom(applied);
+                merged.set_error_message(applied.error_message());
+                pending_report_ = std::move(merged);
+                return;
+            }
+            applied_ = applied;
+            writing_ = true;
+        }
+        StartWrite(&applied_);
+    }
+} // namespace service::api
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <grpcpp/support/server_callback.h>
+
+#include "api/ServerStreamRegistry.h"
+#include "api/proto/core_service.grpc.pb.h"
+#include "common/state/CallContext.h"
+#include "common/types/CameraTypes.h"
+
+namespace service::api {
+    class IRequestHandler;
+
+    /**
+     * Serves one ControlStream call
+     * Setpoints read from the client overwrite the pending ones, so only the newest zoom and focus
+     * are forwarded, at most once per interval. Each forwarded setpoint is reported back, reports
+     * are conflated the same way while the client is slow to read them
+     */
+    class ControlStreamReactor final
+        : public grpc::ServerBidiReactor<core::v1::ControlSetpoint, core::v1::ControlApplied>,
+          public IServerStream {
+    public:
+        /**
+         * @param request_handler handler applying the setpoints
+         * @param streams registry the stream removes itself from once done
+         * @param min_interval minimum time between two forwarded setpoints
+         * @param call context of the call, the setpoints are applied under it
+         */
+        ControlStreamReactor(IRequestHandler& request_handler, ServerStreamRegistry& streams,
+                             std::chrono::microseconds min_interval, const common::state::CallContext& call);
+
+        void OnReadDone(bool ok) override;
+        void OnWriteDone(bool ok) override;
+        void OnCancel() override;
+        void OnDone() override;
+
+        void close(const grpc::Status& status) override;
+
+    private:
+        void forward(const std::stop_token& stop_token);
+        core::v1::ControlApplied apply(uint32_t camera_id, std::optional<common::types::zoom> zoom_level,
+                                       std::optional<common::types::focus> focus_value) const;
+        void report(const core::v1::ControlApplied& applied);
+
+        IRequestHandler& request_handler_;
+        ServerStreamRegistry& streams_;
+        const std::chrono::microseconds min_interval_;
+        const common::state::CallContext call_;
+
+        core::v1::ControlSetpoint setpoint_; // owned by the outstanding read
+
+        std::mutex mutex_;
+        std::condition_variable_any pending_cv_;
+        std::optional<uint32_t> camera_id_;
+        std::optional<common::types::zoom> pending_zoom_;
+        std::optional<common::types::focus> pending_focus_;
+        bool reads_done_{false};
+
+        core::v1::ControlApplied applied_; // owned by the outstanding write
+        std::optional<core::v1::ControlApplied> pending_report_;
+        bool writing_{false};
+        bool finish_requested_{false};
+        grpc::Status final_status_;
+
+        std::jthread forwarder_;
+    };
+} // namespace service::api
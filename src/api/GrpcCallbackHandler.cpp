@@ -3,22 +3,68 @@
 #include <future>
 #include <grpcpp/grpcpp.h>
 
+#include "api/ControlStreamReactor.h"
 #include "api/IRequestHandler.h"
+#include "api/CallMetadata.h"
+#include "api/CallerQuotas.h"
+#include "api/PassthroughCodec.h"
+#include "common/async/Task.h"
 #include "common/logger/Logger.h"
+#include "common/types/BatchOperation.h"
 #include "common/types/CameraCapabilities.h"
+#include "common/types/ControlLease.h"
+#include "common/types/Convergence.h"
+#include "common/types/Macro.h"
+#include "common/types/Preset.h"
+#include "common/types/ScheduledBatch.h"
+#include "common/types/StateGeneration.h"
+#include "common/types/SystemSnapshot.h"
+#include "common/types/CameraState.h"
 
 namespace service::api {
     namespace {
+        /**
+         * @return code of a failed call, RESOURCE_EXHAUSTED when backend admission refused it or the dispatcher
+         *         shed it, FAILED_PRECONDITION when another client holds the camera, DEADLINE_EXCEEDED when it ran out
+         *         of time waiting for another call
+         */
+        grpc::StatusCode errorCodeOf(const common::types::Error& error) {
+            switch (error.code) {
+            case common::types::ErrorCode::ControlledByAnotherClient:
+                return grpc::StatusCode::FAILED_PRECONDITION;
+            case common::types::ErrorCode::CallShed:
+            case common::types::ErrorCode::AdmissionRejected:
+                return grpc::StatusCode::RESOURCE_EXHAUSTED;
+            case common::types::ErrorCode::DeadlineExceeded:
+                return grpc::StatusCode::DEADLINE_EXCEEDED;
+            case common::types::ErrorCode::Internal:
+                break;
+            }
+            return grpc::StatusCode::INTERNAL;
+        }
+
+        grpc::Status statusOf(const common::types::Error& error) {
+            return {errorCodeOf(error), error.message};
+        }
+
         template<typename RequestType, typename ResponseType, typename ProcessFunc>
         grpc::ServerUnaryReactor* handleGrpcSyncRequest(
+            CallerQuotas& quotas,
             grpc::CallbackServerContext* context,
             const RequestType* request,
             ResponseType* response,
             ProcessFunc process_function) {
             auto* const reactor = context->DefaultReactor();
+            const auto call = callContextOf(*context);
+            if (auto throttled = quotas.admit(*context, call); !throttled.ok()) {
+                reactor->Finish(throttled);
+                return reactor;
+            }
+
+            common::state::CallContext::Scope scope(call);
             const auto status = [&]() {
                 if (auto result = process_function(request, response); result.isError()) {
-                    return grpc::Status(grpc::StatusCode::INTERNAL, result.error());
+                    return statusOf(result.error());
                 }
                 return grpc::Status::OK;
             }();
@@ -27,21 +73,69 @@ namespace service::api {
             return reactor;
         }
 
+        /**
+         * Start the task of a call, the reactor finishes on the thread the task ends on
+         * The call context is current while the task runs up to its first suspension
+         */
+        template<typename RequestType, typename ResponseType, typename StartFunc>
+        grpc::ServerUnaryReactor* handleGrpcTaskRequest(
+            CallerQuotas& quotas,
+            grpc::CallbackServerContext* context,
+            const RequestType* request,
+            ResponseType* response,
+            StartFunc start_function) {
+            auto* const reactor = context->DefaultReactor();
+            const auto call = callContextOf(*context);
+            if (auto throttled = quotas.admit(*context, call); !throttled.ok()) {
+                reactor->Finish(throttled);
+                return reactor;
+            }
+
+            common::state::CallContext::Scope scope(call);
+            common::async::start(start_function(request, response), [reactor](const Result<void>& result) {
+                reactor->Finish(result.isError() ? statusOf(result.error())
+                                                 : grpc::Status::OK);
+            });
+            return reactor;
+        }
+
+        /**
+         * Await the result of a call and write its value into the response
+         */
+        template<typename T, typename SetValue>
+        common::async::Task<Result<void>> respondWith(common::async::Task<Result<T>> task, SetValue set_value) {
+            auto result = co_await std::move(task);
+            if (result.isError()) {
+                co_return Result<void>::error(std::move(result).error());
+            }
+            set_value(std::move(result).value());
+            co_return Result<void>::success();
+        }
+
         template<typename RequestType, typename ResponseType, typename ProcessFunc>
         grpc::ServerUnaryReactor* handleGrpcAsyncRequest(
+            CallerQuotas& quotas,
             grpc::CallbackServerContext* context,
             const RequestType* request,
             ResponseType* response,
             ProcessFunc process_function) {
             auto* const reactor = context->DefaultReactor();
+            auto call = callContextOf(*context);
+            if (auto throttled = quotas.admit(*context, call); !throttled.ok()) {
+                reactor->Finish(throttled);
+                return reactor;
+            }
             const auto deadline = grpc::Timespec2Timepoint(context->raw_deadline());
 
             const auto now = std::chrono::system_clock::now();
             const auto remaining_time = deadline > now ? deadline - now : std::chrono::seconds(0);
 
-            std::future<grpc::Status> future = std::async(std::launch::async, [request, response, process_function] {
+            std::future<grpc::Status> future = std::async(std::launch::async,
+                                                          [request, response, process_function,
+                                                           call = std::move(call)] {
+                common::state::CallContext::Scope scope(call);
                 if (auto result = process_function(request, response); result.isError()) {
-                    return grpc::Status(grpc::StatusCode::INTERNAL, result.error());
+                    return statusOf(result.error());
                 }
                 return grpc::Status::OK;
             });
@@ -58,6 +152,65 @@ namespace service::api {
             return reactor;
         }
 
+        core::v1::ConvergenceStatus toProto(const common::types::ConvergenceStatus status) {
+            switch (status) {
+            case common::types::ConvergenceStatus::Reached:
+                return core::v1::CONVERGENCE_STATUS_REACHED;
+            case common::types::ConvergenceStatus::Settled:
+                return core::v1::CONVERGENCE_STATUS_SETTLED;
+            case common::types::ConvergenceStatus::TimedOut:
+                return core::v1::CONVERGENCE_STATUS_TIMED_OUT;
+            }
+            return core::v1::CONVERGENCE_STATUS_UNSPECIFIED;
+        }
+
+        /**
+         * Requested wait, shortened to the call deadline so the reply still reaches the client
+         */
+        std::chrono::milliseconds waitTimeout(const grpc::CallbackServerContext* context, const uint32_t timeout_ms) {
+            std::chrono::milliseconds timeout(timeout_ms);
+            const auto deadline = grpc::Timespec2Timepoint(context->raw_deadline());
+            if (deadline != std::chrono::system_clock::time_point::max()) {
+                const auto remaining = std::max(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                    deadline - std::chrono::system_clock::now()),
+                                                std::chrono::milliseconds(1));
+                timeout = timeout == std::chrono::milliseconds::zero() ? remaining : std::min(timeout, remaining);
+            }
+            return timeout;
+        }
+
+        /**
+         * Serve a Get through the conditional read, the value is left unset when it is not modified
+         * A long poll holds no thread, the task ends on the thread that published the change or at the deadline
+         */
+        template<typename RequestType, typename ResponseType, typename SetValue>
+        common::async::Task<Result<void>> readVersioned(const IRequestHandler& request_handler,
+                                                        const grpc::CallbackServerContext* context,
+                                                        const RequestType& request, common::types::StateField field,
+                                                        ResponseType& response, SetValue set_value) {
+            common::types::ReadCondition condition;
+            if (request.has_if_generation_not()) {
+                condition.if_generation_not = request.if_generation_not();
+                if (request.wait_ms() > 0) {
+                    condition.wait = waitTimeout(context, request.wait_ms());
+                }
+            }
+
+            const auto result = co_await request_handler.getIfChangedAsync(request.camera_id(), std::move(field),
+                                                                           condition);
+            if (result.isError()) {
+                co_return Result<void>::error(result.error());
+            }
+
+            response.set_generation(result.value().generation);
+            if (result.value().value) {
+                set_value(*result.value().value);
+            } else {
+                response.set_not_modified(true);
+            }
+            co_return Result<void>::success();
+        }
+
         core::v1::Capability toProto(const common::capabilities::Capability capability) {
             switch (capability) {
             case common::capabilities::Capability::Zoom:
@@ -74,19 +227,701 @@ namespace service::api {
                 return core::v1::CAPABILITY_UNSPECIFIED;
             }
         }
+
+        Result<common::types::Operation> toOperation(const core::v1::BatchOperation& operation) {
+            using common::types::OperationType;
+            using ResultType = Result<common::types::Operation>;
+
+            switch (operation.operation_case()) {
+            case core::v1::BatchOperation::kSetZoom:
+                return ResultType::success({.type = OperationType::SetZoom,
+                                            .camera_id = operation.set_zoom().camera_id(),
+                                            .value = operation.set_zoom().zoom()});
+            case core::v1::BatchOperation::kGetZoom:
+                return ResultType::success({.type = OperationType::GetZoom,
+                                            .camera_id = operation.get_zoom().camera_id()});
+            case core::v1::BatchOperation::kGoToMinZoom:
+                return ResultType::success({.type = OperationType::GoToMinZoom,
+                                            .camera_id = operation.go_to_min_zoom().camera_id()});
+            case core::v1::BatchOperation::kGoToMaxZoom:
+                return ResultType::success({.type = OperationType::GoToMaxZoom,
+                                            .camera_id = operation.go_to_max_zoom().camera_id()});
+            case core::v1::BatchOperation::kSetFocus:
+                return ResultType::success({.type = OperationType::SetFocus,
+                                            .camera_id = operation.set_focus().camera_id(),
+                                            .value = operation.set_focus().focus()});
+            case core::v1::BatchOperation::kGetFocus:
+                return ResultType::success({.type = OperationType::GetFocus,
+                                            .camera_id = operation.get_focus().camera_id()});
+            case core::v1::BatchOperation::kSetAutoFocus:
+                return ResultType::success({.type = OperationType::SetAutoFocus,
+                                            .camera_id = operation.set_auto_focus().camera_id(),
+                                            .enable = operation.set_auto_focus().enable()});
+            case core::v1::BatchOperation::kGetAutoFocus:
+                return ResultType::success({.type = OperationType::GetAutoFocus,
+                                            .camera_id = operation.get_auto_focus().camera_id()});
+            case core::v1::BatchOperation::kGetInfo:
+                return ResultType::success({.type = OperationType::GetInfo,
+                                            .camera_id = operation.get_info().camera_id()});
+            case core::v1::BatchOperation::kGetCapabilities:
+                return ResultType::success({.type = OperationType::GetCapabilities,
+                                            .camera_id = operation.get_capabilities().camera_id()});
+            case core::v1::BatchOperation::kSetStabilization:
+                return ResultType::success({.type = OperationType::SetStabilization,
+                                            .camera_id = operation.set_stabilization().camera_id(),
+                                            .enable = operation.set_stabilization().enable()});
+            case core::v1::BatchOperation::kGetStabilization:
+                return ResultType::success({.type = OperationType::GetStabilization,
+                                            .camera_id = operation.get_stabilization().camera_id()});
+            case core::v1::BatchOperation::kSetVideoCapabilityState:
+                return ResultType::success({.type = OperationType::SetVideoCapabilityState,
+                                            .camera_id = operation.set_video_capability_state().camera_id(),
+                                            .enable = operation.set_video_capability_state().enable(),
+                                            .capability = operation.set_video_capability_state().capability()});
+            case core::v1::BatchOperation::kGetVideoCapabilities:
+                return ResultType::success({.type = OperationType::GetVideoCapabilities,
+                                            .camera_id = operation.get_video_capabilities().camera_id()});
+            case core::v1::BatchOperation::kGetVideoCapabilityState:
+                return ResultType::success({.type = OperationType::GetVideoCapabilityState,
+                                            .camera_id = operation.get_video_capability_state().camera_id(),
+                                            .capability = operation.get_video_capability_state().capability()});
+            default:
+                return ResultType::error("Operation is not set");
+            }
+        }
+
+        common::types::BatchOrdering toOrdering(const core::v1::BatchOrdering ordering) {
+            switch (ordering) {
+            case core::v1::BATCH_ORDERING_SEQUENTIAL:
+                return common::types::BatchOrdering::Sequential;
+            case core::v1::BATCH_ORDERING_PARALLEL:
+                return common::types::BatchOrdering::Parallel;
+            default:
+                return common::types::BatchOrdering::PerCamera;
+            }
+        }
+
+        common::types::ExecuteAt toExecuteAt(const core::v1::ExecuteAt& message) {
+            return {.clock = message.clock() == core::v1::SCHEDULE_CLOCK_REALTIME
+                                 ? common::types::ScheduleClock::Realtime
+                                 : common::types::ScheduleClock::Monotonic,
+                    .time = std::chrono::nanoseconds(static_cast<int64_t>(message.time_ns()))};
+        }
+
+        Result<common::types::MacroStep> toMacroStep(const core::v1::MacroStep& message) {
+            using common::types::MacroStepType;
+            using ResultType = Result<common::types::MacroStep>;
+
+            common::types::MacroStep step;
+            switch (message.step_case()) {
+            case core::v1::MacroStep::kOperation: {
+                auto operation = toOperation(message.operation());
+                if (operation.isError()) {
+                    return ResultType::error(operation.error());
+                }
+                step.type = MacroStepType::Operation;
+                step.operation = operation.value();
+                break;
+            }
+            case core::v1::MacroStep::kZoomStep:
+            case core::v1::MacroStep::kFocusStep:
+                step.type = message.has_zoom_step() ? MacroStepType::ZoomStep : MacroStepType::FocusStep;
+                step.delta = message.has_zoom_step() ? message.zoom_step() : message.focus_step();
+                break;
+            case core::v1::MacroStep::kWaitUs:
+                step.type = MacroStepType::Wait;
+                step.duration = std::chrono::microseconds(message.wait_us());
+                break;
+            case core::v1::MacroStep::kAwaitZoom:
+            case core::v1::MacroStep::kAwaitFocus: {
+                const auto& await = message.has_await_zoom() ? message.await_zoom() : message.await_focus();
+                step.type = message.has_await_zoom() ? MacroStepType::AwaitZoom : MacroStepType::AwaitFocus;
+                step.tolerance = await.tolerance();
+                step.timeout = std::chrono::milliseconds(await.timeout_ms());
+                break;
+            }
+            case core::v1::MacroStep::kRepeat:
+                step.type = MacroStepType::Repeat;
+                step.count = message.repeat().count();
+                for (const auto& nested : message.repeat().steps()) {
+                    auto nested_step = toMacroStep(nested);
+                    if (nested_step.isError()) {
+                        return nested_step;
+                    }
+                    step.steps.push_back(std::move(nested_step).value());
+                }
+                break;
+            default:
+                return ResultType::error("Macro step is not set");
+            }
+            return ResultType::success(std::move(step));
+        }
+
+        Result<common::types::Macro> toMacro(const core::v1::Macro& message) {
+            common::types::Macro macro{.name = message.name()};
+            for (const auto& step : message.steps()) {
+                auto converted = toMacroStep(step);
+                if (converted.isError()) {
+                    return Result<common::types::Macro>::error(converted.error());
+                }
+                macro.steps.push_back(std::move(converted).value());
+            }
+            return Result<common::types::Macro>::success(std::move(macro));
+        }
+
+        void toProto(const common::types::ControlLease& lease, core::v1::ControlLease* message) {
+            message->set_camera_id(lease.camera_id);
+            message->set_lease_id(lease.lease_id);
+            message->set_ttl_ms(static_cast<uint32_t>(lease.ttl.count()));
+        }
+
+        core::v1::PriorityClass toProto(const common::types::Priority priority) {
+            switch (priority) {
+            case common::types::Priority::Interactive:
+                return core::v1::PRIORITY_CLASS_INTERACTIVE;
+            case common::types::Priority::Normal:
+                return core::v1::PRIORITY_CLASS_NORMAL;
+            case common::types::Priority::Background:
+                return core::v1::PRIORITY_CLASS_BACKGROUND;
+            }
+            return core::v1::PRIORITY_CLASS_NORMAL;
+        }
+
+        void toProto(const common::types::LatencySummary& summary, core::v1::LatencySummary* message) {
+            message->set_count(summary.count);
+            message->set_p50_us(static_cast<uint64_t>(summary.p50.count()));
+            message->set_p99_us(static_cast<uint64_t>(summary.p99.count()));
+            message->set_max_us(static_cast<uint64_t>(summary.max.count()));
+        }
+
+        void toProto(const common::types::CallerMetrics& metrics, core::v1::CallerMetrics* message) {
+            message->set_caller(metrics.caller);
+            message->set_admitted(metrics.admitted);
+            message->set_shed(metrics.shed);
+            message->set_throttled(metrics.throttled);
+            toProto(metrics.queue_wait, message->mutable_queue_wait());
+        }
+
+        void toProto(const common::types::PriorityClassMetrics& metrics, core::v1::PriorityClassMetrics* message) {
+            message->set_priority(toProto(metrics.priority));
+            message->set_admitted(metrics.admitted);
+            message->set_shed(metrics.shed);
+            toProto(metrics.queue_wait, message->mutable_queue_wait());
+            toProto(metrics.latency, message->mutable_latency());
+        }
+
+        void toProto(const common::types::CameraConcurrencyMetrics& metrics, core::v1::CameraConcurrency* message) {
+            message->set_camera_id(metrics.camera_id);
+            message->set_limit(static_cast<uint32_t>(metrics.limit));
+            message->set_in_flight(static_cast<uint32_t>(metrics.in_flight));
+            message->set_queued(static_cast<uint32_t>(metrics.queued));
+            message->set_adaptive(metrics.adaptive);
+            message->set_increases(metrics.increases);
+            message->set_decreases(metrics.decreases);
+            message->set_baseline_us(static_cast<uint64_t>(metrics.baseline.count()));
+            message->set_latency_us(static_cast<uint64_t>(metrics.latency.count()));
+        }
+
+        void toProto(const common::types::WarmupMetrics& metrics, core::v1::BackendWarmup* message) {
+            message->set_enabled(metrics.enabled);
+            message->set_ready(static_cast<uint32_t>(metrics.ready));
+            message->set_total(static_cast<uint32_t>(metrics.total));
+            message->set_complete(metrics.complete);
+        }
+
+        void toProto(const common::types::DesiredState& desired, core::v1::DesiredState* message) {
+            const auto& state = desired.state;
+            if (state.zoom_level) {
+                message->set_zoom(*state.zoom_level);
+            }
+            if (state.focus_value) {
+                message->set_focus(*state.focus_value);
+            }
+            if (state.auto_focus) {
+                message->set_auto_focus(*state.auto_focus);
+            }
+            if (state.stabilization) {
+                message->set_stabilization(*state.stabilization);
+            }
+            for (const auto& [capability, enable] : desired.video) {
+                auto* const video = message->add_video_capabilities();
+                video->set_capability(capability);
+                video->set_enable(enable);
+            }
+        }
+
+        void toProto(const common::types::DriftEvent& event, core::v1::DriftEvent* message) {
+            message->set_camera_id(event.camera_id);
+            message->set_cause(event.cause == common::types::DriftCause::Reconnect ? core::v1::DRIFT_CAUSE_RECONNECT
+                                                                                   : core::v1::DRIFT_CAUSE_CHECK);
+            message->set_detected_unix_ms(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                              event.detected.time_since_epoch()).count());
+            toProto(event.drifted, message->mutable_drifted());
+            message->set_restored(event.restored);
+            message->set_error(event.error);
+        }
+
+        core::v1::MacroStatus toProto(const common::types::MacroStatus status) {
+            switch (status) {
+            case common::types::MacroStatus::Running:
+                return core::v1::MACRO_STATUS_RUNNING;
+            case common::types::MacroStatus::Completed:
+                return core::v1::MACRO_STATUS_COMPLETED;
+            case common::types::MacroStatus::Failed:
+                return core::v1::MACRO_STATUS_FAILED;
+            case common::types::MacroStatus::Cancelled:
+                return core::v1::MACRO_STATUS_CANCELLED;
+            }
+            return core::v1::MACRO_STATUS_UNSPECIFIED;
+        }
+
+        void toProto(const common::types::MacroProgress& progress, core::v1::MacroProgress* message) {
+            message->Clear();
+            message->set_status(toProto(progress.status));
+            message->set_sequence(progress.sequence);
+            for (const auto index : progress.path) {
+                message->add_path(index);
+            }
+            for (const auto iteration : progress.iterations) {
+                message->add_iterations(iteration);
+            }
+            message->set_elapsed_us(static_cast<uint64_t>(progress.elapsed.count()));
+            if (progress.value) {
+                message->set_value(*progress.value);
+            }
+            message->set_error_message(progress.error);
+        }
+
+        void toProto(const common::types::OperationType type,
+                     const common::types::OperationValue& value,
+                     core::v1::BatchOperationResult* result) {
+            using common::types::OperationType;
+
+            switch (type) {
+            case OperationType::SetZoom:
+                result->mutable_set_zoom()->set_zoom(std::get<uint32_t>(value));
+                break;
+            case OperationType::GetZoom:
+                result->mutable_get_zoom()->set_zoom(std::get<uint32_t>(value));
+                break;
+            case OperationType::GoToMinZoom:
+                result->mutable_go_to_min_zoom()->set_zoom(std::get<uint32_t>(value));
+                break;
+            case OperationType::GoToMaxZoom:
+                result->mutable_go_to_max_zoom()->set_zoom(std::get<uint32_t>(value));
+                break;
+            case OperationType::SetFocus:
+                result->mutable_set_focus()->set_focus(std::get<uint32_t>(value));
+                break;
+            case OperationType::GetFocus:
+                result->mutable_get_focus()->set_focus(std::get<uint32_t>(value));
+                break;
+            case OperationType::SetAutoFocus:
+                result->mutable_set_auto_focus();
+                break;
+            case OperationType::GetAutoFocus:
+                result->mutable_get_auto_focus()->set_enable(std::get<bool>(value));
+                break;
+            case OperationType::GetInfo:
+                result->mutable_get_info()->set_info(std::get<common::types::info>(value));
+                break;
+            case OperationType::GetCapabilities:
+                for (const auto capability : std::get<common::capabilities::CapabilityList>(value)) {
+                    result->mutable_get_capabilities()->add_capabilities(toProto(capability));
+                }
+                break;
+            case OperationType::SetStabilization:
+                result->mutable_set_stabilization();
+                break;
+            case OperationType::GetStabilization:
+                result->mutable_get_stabilization()->set_enable(std::get<bool>(value));
+                break;
+            case OperationType::SetVideoCapabilityState:
+                result->mutable_set_video_capability_state();
+                break;
+            case OperationType::GetVideoCapabilities:
+                for (const auto& capability : std::get<std::vector<std::string>>(value)) {
+                    result->mutable_get_video_capabilities()->add_capabilities(capability);
+                }
+                break;
+            case OperationType::GetVideoCapabilityState:
+                result->mutable_get_video_capability_state()->set_enable(std::get<bool>(value));
+                break;
+            }
+        }
+
+        /**
+         * Results of a batch in operation order
+         */
+        void toProto(const std::vector<common::types::Operation>& operations,
+                     const std::vector<common::types::OperationResult>& results,
+                     core::v1::ExecuteBatchResponse* response) {
+            for (std::size_t index = 0; index < results.size(); ++index) {
+                auto* const result = response->add_results();
+                if (results[index].isError()) {
+                    result->set_status_code(errorCodeOf(results[index].error()));
+                    result->set_error_message(results[index].error().message);
+                    continue;
+                }
+                result->set_status_code(grpc::StatusCode::OK);
+                toProto(operations[index].type, results[index].value(), result);
+            }
+        }
+
+        Result<common::types::CameraStateFields> toStateFields(const google::protobuf::FieldMask& mask) {
+            if (mask.paths().empty()) {
+                return Result<common::types::CameraStateFields>::success(common::types::ALL_CAMERA_STATE_FIELDS);
+            }
+
+            common::types::CameraStateFields fields = 0;
+            for (const auto& path : mask.paths()) {
+                if (path == "zoom") {
+                    fields |= static_cast<common::types::CameraStateFields>(common::types::CameraStateField::Zoom);
+                } else if (path == "focus") {
+                    fields |= static_cast<common::types::CameraStateFields>(common::types::CameraStateField::Focus);
+                } else if (path == "auto_focus") {
+                    fields |= static_cast<common::types::CameraStateFields>(common::types::CameraStateField::AutoFocus);
+                } else if (path == "stabilization") {
+                    fields |= static_cast<common::types::CameraStateFields>(
+                        common::types::CameraStateField::Stabilization);
+                } else {
+                    return Result<common::types::CameraStateFields>::error("Unknown camera state field: " + path);
+                }
+            }
+            return Result<common::types::CameraStateFields>::success(fields);
+        }
+
+        Result<common::types::SnapshotFields> toSnapshotFields(const google::protobuf::FieldMask& mask) {
+            using common::types::SnapshotField;
+            if (mask.paths().empty()) {
+                return Result<common::types::SnapshotFields>::success(common::types::ALL_SNAPSHOT_FIELDS);
+            }
+
+            common::types::SnapshotFields fields = 0;
+            for (const auto& path : mask.paths()) {
+                SnapshotField field;
+                if (path == "zoom") {
+                    field = SnapshotField::Zoom;
+                } else if (path == "focus") {
+                    field = SnapshotField::Focus;
+                } else if (path == "auto_focus") {
+                    field = SnapshotField::AutoFocus;
+                } else if (path == "stabilization") {
+                    field = SnapshotField::Stabilization;
+                } else if (path == "capabilities") {
+                    field = SnapshotField::Capabilities;
+                } else if (path == "info") {
+                    field = SnapshotField::Info;
+                } else if (path == "video_capabilities") {
+                    field = SnapshotField::VideoCapabilities;
+                } else {
+                    return Result<common::types::SnapshotFields>::error("Unknown snapshot field: " + path);
+                }
+                fields |= static_cast<common::types::SnapshotFields>(field);
+            }
+            return Result<common::types::SnapshotFields>::success(fields);
+        }
+
+        void toProto(const common::types::CameraSnapshot& snapshot, core::v1::CameraSnapshot* message) {
+            message->set_camera_id(snapshot.camera_id);
+            if (snapshot.state.zoom_level) {
+                message->set_zoom(*snapshot.state.zoom_level);
+            }
+            if (snapshot.state.focus_value) {
+                message->set_focus(*snapshot.state.focus_value);
+            }
+            if (snapshot.state.auto_focus) {
+                message->set_auto_focus(*snapshot.state.auto_focus);
+            }
+            if (snapshot.state.stabilization) {
+                message->set_stabilization(*snapshot.state.stabilization);
+            }
+            if (snapshot.capabilities) {
+                for (const auto capability : *snapshot.capabilities) {
+                    message->add_capabilities(toProto(capability));
+                }
+            }
+            if (snapshot.device_info) {
+                message->set_info(*snapshot.device_info);
+            }
+            if (snapshot.video_capabilities) {
+                for (const auto& [capability, enable] : *snapshot.video_capabilities) {
+                    auto* const state = message->add_video_capabilities();
+                    state->set_capability(capability);
+                    state->set_enable(enable);
+                }
+            }
+            for (const auto& error : snapshot.errors) {
+                message->add_errors(error);
+            }
+        }
+
+        common::types::Preset toPreset(const core::v1::Preset& message) {
+            common::types::Preset preset;
+            preset.name = message.name();
+            for (const auto& camera_message : message.cameras()) {
+                auto& camera = preset.cameras.emplace_back();
+                camera.camera_id = camera_message.camera_id();
+                if (camera_message.has_zoom()) {
+                    camera.state.zoom_level = camera_message.zoom();
+                }
+                if (camera_message.has_focus()) {
+                    camera.state.focus_value = camera_message.focus();
+                }
+                if (camera_message.has_auto_focus()) {
+                    camera.state.auto_focus = camera_message.auto_focus();
+                }
+                if (camera_message.has_stabilization()) {
+                    camera.state.stabilization = camera_message.stabilization();
+                }
+                camera.video_capabilities.insert(camera_message.video_capabilities().begin(),
+                                                 camera_message.video_capabilities().end());
+            }
+            return preset;
+        }
+
+        void toProto(const common::types::Preset& preset, core::v1::Preset* message) {
+            message->set_name(preset.name);
+            for (const auto& camera : preset.cameras) {
+                auto* const camera_message = message->add_cameras();
+                camera_message->set_camera_id(camera.camera_id);
+                if (camera.state.zoom_level) {
+                    camera_message->set_zoom(*camera.state.zoom_level);
+                }
+                if (camera.state.focus_value) {
+                    camera_message->set_focus(*camera.state.focus_value);
+                }
+                if (camera.state.auto_focus) {
+                    camera_message->set_auto_focus(*camera.state.auto_focus);
+                }
+                if (camera.state.stabilization) {
+                    camera_message->set_stabilization(*camera.state.stabilization);
+                }
+                camera_message->mutable_video_capabilities()->insert(camera.video_capabilities.begin(),
+                                                                     camera.video_capabilities.end());
+            }
+        }
+
+        void toProto(const common::types::CameraStateUpdate& update, core::v1::CameraStateUpdate* message) {
+            message->Clear();
+            message->set_snapshot(update.snapshot);
+            if (update.state.zoom_level) {
+                message->set_zoom(*update.state.zoom_level);
+            }
+            if (update.state.focus_value) {
+                message->set_focus(*update.state.focus_value);
+            }
+            if (update.state.auto_focus) {
+                message->set_auto_focus(*update.state.auto_focus);
+            }
+            if (update.state.stabilization) {
+                message->set_stabilization(*update.state.stabilization);
+            }
+        }
+
+        /**
+         * Stream refused before any message was written
+         */
+        template<typename Message>
+        class RejectedWriter final : public grpc::ServerWriteReactor<Message> {
+        public:
+            explicit RejectedWriter(const grpc::Status& status) {
+                this->Finish(status);
+            }
+
+            void OnDone() override {
+                delete this;
+            }
+        };
+
+        /**
+         * Drains a subscription into a server stream, one write in flight at a time
+         * What arrives meanwhile is conflated or queued by the subscription. The stream finishes with end_status once
+         * the subscription is closed and drained, leaving it early cancels the subscription
+         */
+        template<typename Message, typename Subscription>
+        class SubscriptionWriter final : public grpc::ServerWriteReactor<Message>, public IServerStream {
+        public:
+            SubscriptionWriter(ServerStreamRegistry& streams, std::shared_ptr<Subscription> subscription,
+                               grpc::Status end_status)
+                : streams_(streams), subscription_(std::move(subscription)), end_status_(std::move(end_status)) {
+            }
+
+            void start() {
+                subscription_->setListener([this] { writeNext(); });
+            }
+
+            void close(const grpc::Status& status) override {
+                {
+                    std::lock_guard lock(mutex_);
+                    if (finish_requested_) {
+                        return;
+                    }
+                    finish_requested_ = true;
+                    final_status_ = status;
+                    if (writing_) {
+                        // Finished once the outstanding write completes
+                        return;
+                    }
+                }
+                this->Finish(status);
+            }
+
+            void OnWriteDone(const bool ok) override {
+                bool finish = false;
+                {
+                    std::lock_guard lock(mutex_);
+                    writing_ = false;
+                    finish = finish_requested_;
+                }
+                if (finish) {
+                    this->Finish(final_status_);
+                    return;
+                }
+                if (!ok) {
+                    close(grpc::Status::CANCELLED);
+                    return;
+                }
+                writeNext();
+            }
+
+            void OnCancel() override {
+                close(grpc::Status::CANCELLED);
+            }
+
+            void OnDone() override {
+                subscription_->cancel();
+                streams_.remove(this);
+                delete this;
+            }
+
+        private:
+            void writeNext() {
+                bool start_write = false;
+                {
+                    std::lock_guard lock(mutex_);
+                    if (writing_ || finish_requested_) {
+                        return;
+                    }
+                    if (auto next = subscription_->poll()) {
+                        toProto(*next, &message_);
+                        writing_ = true;
+                        start_write = true;
+                    } else if (!subscription_->isClosed()) {
+                        return;
+                    }
+                }
+
+                if (start_write) {
+                    this->StartWrite(&message_);
+                } else {
+                    close(end_status_);
+                }
+            }
+
+            ServerStreamRegistry& streams_;
+            std::shared_ptr<Subscription> subscription_;
+            const grpc::Status end_status_;
+
+            std::mutex mutex_;
+            Message message_;
+            bool writing_{false};
+            bool finish_requested_{false};
+            grpc::Status final_status_;
+        };
+
+        // Watched state ends only when the camera goes away
+        using CameraStateWriter =
+            SubscriptionWriter<core::v1::CameraStateUpdate, common::state::CameraStateSubscription>;
+
+        // A macro run ends after its final report, leaving its stream early cancels the macro
+        using MacroProgressWriter = SubscriptionWriter<core::v1::MacroProgress, common::state::MacroExecution>;
     } // unnamed namespace
 
-    GrpcCallbackHandler::GrpcCallbackHandler(IRequestHandler& request_handler)
-        : request_handler_(request_handler) {
+    template<typename RequestType, typename ResponseType>
+    grpc::MessageAllocator<RequestType, ResponseType>* GrpcCallbackHandler::arenaAllocator() {
+        auto allocator = std::make_unique<ArenaMessageAllocator<RequestType, ResponseType>>();
+        auto* const raw_allocator = allocator.get();
+        message_allocators_.push_back(std::move(allocator));
+        return raw_allocator;
+    }
+
+    GrpcCallbackHandler::GrpcCallbackHandler(IRequestHandler& request_handler, CallerQuotas& quotas,
+                                             const bool passthrough,
+                                             const common::ControlStreamConfig& control_stream)
+        : request_handler_(request_handler), quotas_(quotas),
+          control_interval_(std::chrono::microseconds(std::chrono::seconds(1)) / control_stream.max_rate_hz) {
+        // Request and response messages live on recycled arenas instead of the heap
+        SetMessageAllocatorFor_SetZoom(arenaAllocator<core::v1::SetZoomRequest, core::v1::SetZoomResponse>());
+        SetMessageAllocatorFor_SetFocus(arenaAllocator<core::v1::SetFocusRequest, core::v1::SetFocusResponse>());
+        SetMessageAllocatorFor_GetZoom(arenaAllocator<core::v1::GetZoomRequest, core::v1::GetZoomResponse>());
+        SetMessageAllocatorFor_GetFocus(arenaAllocator<core::v1::GetFocusRequest, core::v1::GetFocusResponse>());
+        SetMessageAllocatorFor_GetInfo(arenaAllocator<core::v1::GetInfoRequest, core::v1::GetInfoResponse>());
+        SetMessageAllocatorFor_GetCapabilities(
+            arenaAllocator<core::v1::GetCapabilitiesRequest, core::v1::GetCapabilitiesResponse>());
+        SetMessageAllocatorFor_GoToMinZoom(
+            arenaAllocator<core::v1::GoToMinZoomRequest, core::v1::GoToMinZoomResponse>());
+        SetMessageAllocatorFor_GoToMaxZoom(
+            arenaAllocator<core::v1::GoToMaxZoomRequest, core::v1::GoToMaxZoomResponse>());
+        SetMessageAllocatorFor_SetAutoFocus(arenaAllocator<core::v1::SetAutoFocusRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_GetAutoFocus(
+            arenaAllocator<core::v1::GetAutoFocusRequest, core::v1::GetAutoFocusResponse>());
+        SetMessageAllocatorFor_SetStabilization(
+            arenaAllocator<core::v1::SetStabilizationRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_GetStabilization(
+            arenaAllocator<core::v1::GetStabilizationRequest, core::v1::GetStabilizationResponse>());
+        SetMessageAllocatorFor_SetVideoCapabilityState(
+            arenaAllocator<core::v1::SetVideoCapabilityStateRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_GetVideoCapabilities(
+            arenaAllocator<core::v1::GetVideoCapabilitiesRequest, core::v1::GetVideoCapabilitiesResponse>());
+        SetMessageAllocatorFor_GetVideoCapabilityState(
+            arenaAllocator<core::v1::GetVideoCapabilityStateRequest, core::v1::GetVideoCapabilityStateResponse>());
+        SetMessageAllocatorFor_ExecuteBatch(
+            arenaAllocator<core::v1::ExecuteBatchRequest, core::v1::ExecuteBatchResponse>());
+        SetMessageAllocatorFor_GetSystemSnapshot(
+            arenaAllocator<core::v1::GetSystemSnapshotRequest, core::v1::GetSystemSnapshotResponse>());
+        SetMessageAllocatorFor_ZoomStep(arenaAllocator<core::v1::ZoomStepRequest, core::v1::ZoomStepResponse>());
+        SetMessageAllocatorFor_FocusStep(arenaAllocator<core::v1::FocusStepRequest, core::v1::FocusStepResponse>());
+        SetMessageAllocatorFor_ZoomVelocity(arenaAllocator<core::v1::ZoomVelocityRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_FocusVelocity(arenaAllocator<core::v1::FocusVelocityRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_SetZoomAndWait(
+            arenaAllocator<core::v1::SetZoomAndWaitRequest, core::v1::SetZoomAndWaitResponse>());
+        SetMessageAllocatorFor_SetFocusAndWait(
+            arenaAllocator<core::v1::SetFocusAndWaitRequest, core::v1::SetFocusAndWaitResponse>());
+        SetMessageAllocatorFor_SavePreset(arenaAllocator<core::v1::SavePresetRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_DeletePreset(arenaAllocator<core::v1::DeletePresetRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_ListPresets(arenaAllocator<google::protobuf::Empty, core::v1::ListPresetsResponse>());
+        SetMessageAllocatorFor_RecallPreset(
+            arenaAllocator<core::v1::RecallPresetRequest, core::v1::RecallPresetResponse>());
+        SetMessageAllocatorFor_CancelMacro(arenaAllocator<core::v1::CancelMacroRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_AcquireControl(
+            arenaAllocator<core::v1::AcquireControlRequest, core::v1::ControlLease>());
+        SetMessageAllocatorFor_RenewControl(arenaAllocator<core::v1::RenewControlRequest, core::v1::ControlLease>());
+        SetMessageAllocatorFor_ReleaseControl(
+            arenaAllocator<core::v1::ReleaseControlRequest, google::protobuf::Empty>());
+        SetMessageAllocatorFor_GetDispatchMetrics(
+            arenaAllocator<google::protobuf::Empty, core::v1::DispatchMetricsResponse>());
+        SetMessageAllocatorFor_GetReconcileStatus(
+            arenaAllocator<google::protobuf::Empty, core::v1::ReconcileStatusResponse>());
+
+        if (passthrough) {
+            // Unregistered methods are served by the generic passthrough handler
+            const auto* const service_descriptor =
+                core::v1::SetZoomRequest::descriptor()->file()->FindServiceByName("CoreService");
+            for (const auto method : passthrough::CAMERA_METHODS) {
+                MarkMethodGeneric(service_descriptor->FindMethodByName(std::string(method))->index());
+            }
+        }
     }
 
     grpc::ServerUnaryReactor* GrpcCallbackHandler::SetZoom(
         grpc::CallbackServerContext* context,
         const core::v1::SetZoomRequest* request,
         core::v1::SetZoomResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::SetZoomRequest* req, core::v1::SetZoomResponse*) {
-                return request_handler_.setZoom(req->camera_id(), req->zoom());
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this](const core::v1::SetZoomRequest* req, core::v1::SetZoomResponse* resp) {
+                return respondWith(request_handler_.setZoomAsync(req->camera_id(), req->zoom()),
+                                   [resp](const common::types::zoom zoom) { resp->set_zoom(zoom); });
             });
     }
 
@@ -94,9 +929,10 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::SetFocusRequest* request,
         core::v1::SetFocusResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::SetFocusRequest* req, core::v1::SetFocusResponse*) {
-                return request_handler_.setFocus(req->camera_id(), req->focus());
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this](const core::v1::SetFocusRequest* req, core::v1::SetFocusResponse* resp) {
+                return respondWith(request_handler_.setFocusAsync(req->camera_id(), req->focus()),
+                                   [resp](const common::types::focus focus) { resp->set_focus(focus); });
             });
 
     }
@@ -105,14 +941,12 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GetZoomRequest* request,
         core::v1::GetZoomResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::GetZoomRequest* req, core::v1::GetZoomResponse* resp) {
-                const auto result = request_handler_.getZoom(req->camera_id());
-                if (result.isSuccess()) {
-                    resp->set_zoom(result.value());
-                    return Result<void>::success();
-                }
-                return Result<void>::error(result.error());
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this, context](const core::v1::GetZoomRequest* req, core::v1::GetZoomResponse* resp) {
+                return readVersioned(request_handler_, context, *req, common::types::CameraStateField::Zoom, *resp,
+                                     [resp](const common::types::StateValue& value) {
+                                         resp->set_zoom(std::get<uint32_t>(value));
+                                     });
             });
     }
 
@@ -120,14 +954,12 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GetFocusRequest* request,
         core::v1::GetFocusResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::GetFocusRequest* req, core::v1::GetFocusResponse* resp) {
-                const auto result = request_handler_.getFocus(req->camera_id());
-                if (result.isSuccess()) {
-                    resp->set_focus(result.value());
-                    return Result<void>::success();
-                }
-                return Result<void>::error(result.error());
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this, context](const core::v1::GetFocusRequest* req, core::v1::GetFocusResponse* resp) {
+                return readVersioned(request_handler_, context, *req, common::types::CameraStateField::Focus, *resp,
+                                     [resp](const common::types::StateValue& value) {
+                                         resp->set_focus(std::get<uint32_t>(value));
+                                     });
             });
     }
 
@@ -135,7 +967,7 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GetInfoRequest* request,
         core::v1::GetInfoResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
+        return handleGrpcSyncRequest(quotas_, context, request, response,
             [this](const core::v1::GetInfoRequest* req, core::v1::GetInfoResponse* resp) {
                 const auto result = request_handler_.getInfo(req->camera_id());
                 if (result.isSuccess()) {
@@ -150,7 +982,7 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GetCapabilitiesRequest* request,
         core::v1::GetCapabilitiesResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
+        return handleGrpcSyncRequest(quotas_, context, request, response,
             [this](const core::v1::GetCapabilitiesRequest* req, core::v1::GetCapabilitiesResponse* resp) {
                 const auto result = request_handler_.getCapabilities(req->camera_id());
                 if (result.isError()) {
@@ -169,10 +1001,11 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GoToMinZoomRequest* request,
         core::v1::GoToMinZoomResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::GoToMinZoomRequest* req, core::v1::GoToMinZoomResponse*) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::GoToMinZoomRequest* req, core::v1::GoToMinZoomResponse* resp) {
                 const auto result = request_handler_.goToMinZoom(req->camera_id());
                 if (result.isSuccess()) {
+                    resp->set_zoom(result.value());
                     return Result<void>::success();
                 }
                 return Result<void>::error(result.error());
@@ -183,10 +1016,11 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GoToMaxZoomRequest* request,
         core::v1::GoToMaxZoomResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::GoToMaxZoomRequest* req, core::v1::GoToMaxZoomResponse*) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::GoToMaxZoomRequest* req, core::v1::GoToMaxZoomResponse* resp) {
                 const auto result = request_handler_.goToMaxZoom(req->camera_id());
                 if (result.isSuccess()) {
+                    resp->set_zoom(result.value());
                     return Result<void>::success();
                 }
                 return Result<void>::error(result.error());
@@ -197,7 +1031,7 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::SetAutoFocusRequest* request,
         google::protobuf::Empty* response) {
-        return handleGrpcSyncRequest(context, request, response,
+        return handleGrpcSyncRequest(quotas_, context, request, response,
             [this](const core::v1::SetAutoFocusRequest* req, google::protobuf::Empty*) {
                 return request_handler_.enableAutoFocus(req->camera_id(), req->enable());
             });
@@ -207,22 +1041,281 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GetAutoFocusRequest* request,
         core::v1::GetAutoFocusResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::GetAutoFocusRequest* req, core::v1::GetAutoFocusResponse* resp) {
-                const auto result = request_handler_.getAutoFocus(req->camera_id());
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this, context](const core::v1::GetAutoFocusRequest* req, core::v1::GetAutoFocusResponse* resp) {
+                return readVersioned(request_handler_, context, *req, common::types::CameraStateField::AutoFocus, *resp,
+                                     [resp](const common::types::StateValue& value) {
+                                         resp->set_enable(std::get<bool>(value));
+                                     });
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::ZoomStep(
+        grpc::CallbackServerContext* context,
+        const core::v1::ZoomStepRequest* request,
+        core::v1::ZoomStepResponse* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::ZoomStepRequest* req, core::v1::ZoomStepResponse* resp) {
+                const auto result = request_handler_.stepZoom(req->camera_id(), req->delta());
                 if (result.isSuccess()) {
-                    resp->set_enable(result.value());
+                    resp->set_zoom(result.value());
                     return Result<void>::success();
                 }
                 return Result<void>::error(result.error());
             });
     }
 
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::FocusStep(
+        grpc::CallbackServerContext* context,
+        const core::v1::FocusStepRequest* request,
+        core::v1::FocusStepResponse* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::FocusStepRequest* req, core::v1::FocusStepResponse* resp) {
+                const auto result = request_handler_.stepFocus(req->camera_id(), req->delta());
+                if (result.isSuccess()) {
+                    resp->set_focus(result.value());
+                    return Result<void>::success();
+                }
+                return Result<void>::error(result.error());
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::ZoomVelocity(
+        grpc::CallbackServerContext* context,
+        const core::v1::ZoomVelocityRequest* request,
+        google::protobuf::Empty* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::ZoomVelocityRequest* req, google::protobuf::Empty*) {
+                return request_handler_.setZoomVelocity(req->camera_id(), req->velocity(),
+                                                        std::chrono::milliseconds(req->duration_ms()));
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::FocusVelocity(
+        grpc::CallbackServerContext* context,
+        const core::v1::FocusVelocityRequest* request,
+        google::protobuf::Empty* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::FocusVelocityRequest* req, google::protobuf::Empty*) {
+                return request_handler_.setFocusVelocity(req->camera_id(), req->velocity(),
+                                                         std::chrono::milliseconds(req->duration_ms()));
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::SetZoomAndWait(
+        grpc::CallbackServerContext* context,
+        const core::v1::SetZoomAndWaitRequest* request,
+        core::v1::SetZoomAndWaitResponse* response) {
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this, context](const core::v1::SetZoomAndWaitRequest* req, core::v1::SetZoomAndWaitResponse* resp) {
+                auto wait = request_handler_.setZoomAndWaitAsync(req->camera_id(), req->zoom(), req->tolerance(),
+                                                                  waitTimeout(context, req->timeout_ms()));
+                return respondWith(std::move(wait),
+                                   [resp](const common::types::Convergence& convergence) {
+                                       resp->set_zoom(convergence.value);
+                                       resp->set_elapsed_ms(static_cast<uint32_t>(convergence.elapsed.count()));
+                                       resp->set_status(toProto(convergence.status));
+                                   });
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::SetFocusAndWait(
+        grpc::CallbackServerContext* context,
+        const core::v1::SetFocusAndWaitRequest* request,
+        core::v1::SetFocusAndWaitResponse* response) {
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this, context](const core::v1::SetFocusAndWaitRequest* req, core::v1::SetFocusAndWaitResponse* resp) {
+                auto wait = request_handler_.setFocusAndWaitAsync(req->camera_id(), req->focus(), req->tolerance(),
+                                                                  waitTimeout(context, req->timeout_ms()));
+                return respondWith(std::move(wait),
+                                   [resp](const common::types::Convergence& convergence) {
+                                       resp->set_focus(convergence.value);
+                                       resp->set_elapsed_ms(static_cast<uint32_t>(convergence.elapsed.count()));
+                                       resp->set_status(toProto(convergence.status));
+                                   });
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::SavePreset(
+        grpc::CallbackServerContext* context,
+        const core::v1::SavePresetRequest* request,
+        google::protobuf::Empty* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::SavePresetRequest* req, google::protobuf::Empty*) {
+                return request_handler_.savePreset(toPreset(req->preset()));
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::DeletePreset(
+        grpc::CallbackServerContext* context,
+        const core::v1::DeletePresetRequest* request,
+        google::protobuf::Empty* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::DeletePresetRequest* req, google::protobuf::Empty*) {
+                return request_handler_.deletePreset(req->name());
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::ListPresets(
+        grpc::CallbackServerContext* context,
+        const google::protobuf::Empty* request,
+        core::v1::ListPresetsResponse* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const google::protobuf::Empty*, core::v1::ListPresetsResponse* resp) {
+                const auto result = request_handler_.listPresets();
+                if (result.isError()) {
+                    return Result<void>::error(result.error());
+                }
+                for (const auto& preset : result.value()) {
+                    toProto(preset, resp->add_presets());
+                }
+                return Result<void>::success();
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::RecallPreset(
+        grpc::CallbackServerContext* context,
+        const core::v1::RecallPresetRequest* request,
+        core::v1::RecallPresetResponse* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::RecallPresetRequest* req, core::v1::RecallPresetResponse* resp) {
+                const std::vector<uint32_t> camera_ids(req->camera_ids().begin(), req->camera_ids().end());
+                const auto result = request_handler_.recallPreset(camera_ids, req->name());
+                if (result.isError()) {
+                    return Result<void>::error(result.error());
+                }
+                resp->set_elapsed_ms(static_cast<uint32_t>(result.value().elapsed.count()));
+                resp->set_applied(result.value().applied);
+                resp->set_skipped(result.value().skipped);
+                for (const auto& error : result.value().errors) {
+                    resp->add_errors(error);
+                }
+                return Result<void>::success();
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::CancelMacro(
+        grpc::CallbackServerContext* context,
+        const core::v1::CancelMacroRequest* request,
+        google::protobuf::Empty* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::CancelMacroRequest* req, google::protobuf::Empty*) {
+                return request_handler_.cancelMacro(req->camera_id());
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::AcquireControl(
+        grpc::CallbackServerContext* context,
+        const core::v1::AcquireControlRequest* request,
+        core::v1::ControlLease* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::AcquireControlRequest* req, core::v1::ControlLease* resp) {
+                const auto result = request_handler_.acquireControl(req->camera_id(),
+                                                                    std::chrono::milliseconds(req->ttl_ms()));
+                if (result.isError()) {
+                    return Result<void>::error(result.error());
+                }
+                toProto(result.value(), resp);
+                return Result<void>::success();
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::RenewControl(
+        grpc::CallbackServerContext* context,
+        const core::v1::RenewControlRequest* request,
+        core::v1::ControlLease* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::RenewControlRequest* req, core::v1::ControlLease* resp) {
+                const auto result = request_handler_.renewControl(req->camera_id(), req->lease_id(),
+                                                                  std::chrono::milliseconds(req->ttl_ms()));
+                if (result.isError()) {
+                    return Result<void>::error(result.error());
+                }
+                toProto(result.value(), resp);
+                return Result<void>::success();
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::ReleaseControl(
+        grpc::CallbackServerContext* context,
+        const core::v1::ReleaseControlRequest* request,
+        google::protobuf::Empty* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const core::v1::ReleaseControlRequest* req, google::protobuf::Empty*) {
+                return request_handler_.releaseControl(req->camera_id(), req->lease_id());
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::GetDispatchMetrics(
+        grpc::CallbackServerContext* context,
+        const google::protobuf::Empty* request,
+        core::v1::DispatchMetricsResponse* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const google::protobuf::Empty*, core::v1::DispatchMetricsResponse* resp) {
+                auto result = request_handler_.getDispatchMetrics();
+                if (result.isError()) {
+                    return Result<void>::error(result.error());
+                }
+                auto metrics = std::move(result).value();
+                for (const auto& class_metrics : metrics.classes) {
+                    toProto(class_metrics, resp->add_classes());
+                }
+
+                // Throttled calls never reach Core, a caller may only be known to the quotas
+                auto throttled = quotas_.throttled();
+                for (auto& caller : metrics.callers) {
+                    if (const auto it = throttled.find(caller.caller); it != throttled.end()) {
+                        caller.throttled = it->second;
+                        throttled.erase(it);
+                    }
+                }
+                for (const auto& [caller, count] : throttled) {
+                    metrics.callers.push_back({.caller = caller, .throttled = count});
+                }
+                for (const auto& caller : metrics.callers) {
+                    toProto(caller, resp->add_callers());
+                }
+                for (const auto& camera : metrics.cameras) {
+                    toProto(camera, resp->add_cameras());
+                }
+                toProto(metrics.warmup, resp->mutable_warmup());
+                return Result<void>::success();
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::GetReconcileStatus(
+        grpc::CallbackServerContext* context,
+        const google::protobuf::Empty* request,
+        core::v1::ReconcileStatusResponse* response) {
+        return handleGrpcSyncRequest(quotas_, context, request, response,
+            [this](const google::protobuf::Empty*, core::v1::ReconcileStatusResponse* resp) {
+                const auto result = request_handler_.getReconcileStatus();
+                if (result.isError()) {
+                    return Result<void>::error(result.error());
+                }
+                const auto& status = result.value();
+                resp->set_enabled(status.enabled);
+                for (const auto& camera : status.cameras) {
+                    auto* const message = resp->add_cameras();
+                    message->set_camera_id(camera.camera_id);
+                    toProto(camera.desired, message->mutable_desired());
+                    message->set_checks(camera.checks);
+                    message->set_drifts(camera.drifts);
+                    message->set_restored(camera.restored);
+                }
+                for (const auto& event : status.recent_drifts) {
+                    toProto(event, resp->add_recent_drifts());
+                }
+                toProto(status.latency, resp->mutable_latency());
+                return Result<void>::success();
+            });
+    }
+
     grpc::ServerUnaryReactor* GrpcCallbackHandler::SetStabilization(
         grpc::CallbackServerContext* context,
         const core::v1::SetStabilizationRequest* request,
         google::protobuf::Empty* response) {
-        return handleGrpcSyncRequest(context, request, response,
+        return handleGrpcSyncRequest(quotas_, context, request, response,
             [this](const core::v1::SetStabilizationRequest* req, google::protobuf::Empty*) {
                 return request_handler_.stabilize(req->camera_id(), req->enable());
             });
@@ -232,14 +1325,13 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GetStabilizationRequest* request,
         core::v1::GetStabilizationResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::GetStabilizationRequest* req, core::v1::GetStabilizationResponse* resp) {
-                const auto result = request_handler_.getStabilization(req->camera_id());
-                if (result.isSuccess()) {
-                    resp->set_enable(result.value());
-                    return Result<void>::success();
-                }
-                return Result<void>::error(result.error());
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this, context](const core::v1::GetStabilizationRequest* req, core::v1::GetStabilizationResponse* resp) {
+                return readVersioned(request_handler_, context, *req, common::types::CameraStateField::Stabilization,
+                                     *resp,
+                                     [resp](const common::types::StateValue& value) {
+                                         resp->set_enable(std::get<bool>(value));
+                                     });
             });
     }
 
@@ -247,7 +1339,7 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::SetVideoCapabilityStateRequest* request,
         google::protobuf::Empty* response) {
-        return handleGrpcSyncRequest(context, request, response,
+        return handleGrpcSyncRequest(quotas_, context, request, response,
             [this](const core::v1::SetVideoCapabilityStateRequest* req, google::protobuf::Empty*) {
                 return request_handler_.SetVideoCapabilityState(req->camera_id(), req->capability(), req->enable());
             });
@@ -257,7 +1349,7 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GetVideoCapabilitiesRequest* request,
         core::v1::GetVideoCapabilitiesResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
+        return handleGrpcSyncRequest(quotas_, context, request, response,
             [this](const core::v1::GetVideoCapabilitiesRequest* req, core::v1::GetVideoCapabilitiesResponse* resp) {
                 const auto result = request_handler_.getVideoCapabilities(req->camera_id());
                 if (result.isError()) {
@@ -276,16 +1368,193 @@ namespace service::api {
         grpc::CallbackServerContext* context,
         const core::v1::GetVideoCapabilityStateRequest* request,
         core::v1::GetVideoCapabilityStateResponse* response) {
-        return handleGrpcSyncRequest(context, request, response,
-            [this](const core::v1::GetVideoCapabilityStateRequest* req, core::v1::GetVideoCapabilityStateResponse* resp) {
-                const auto result = request_handler_.getVideoCapabilityState(req->camera_id(), req->capability());
+        return handleGrpcTaskRequest(quotas_, context, request, response,
+            [this, context](const core::v1::GetVideoCapabilityStateRequest* req,
+                            core::v1::GetVideoCapabilityStateResponse* resp) {
+                return readVersioned(request_handler_, context, *req, req->capability(), *resp,
+                                     [resp](const common::types::StateValue& value) {
+                                         resp->set_enable(std::get<bool>(value));
+                                     });
+            });
+    }
+
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::ExecuteBatch(
+        grpc::CallbackServerContext* context,
+        const core::v1::ExecuteBatchRequest* request,
+        core::v1::ExecuteBatchResponse* response) {
+        auto* const reactor = context->DefaultReactor();
+        const auto call = callContextOf(*context);
+        if (auto throttled = quotas_.admit(*context, call); !throttled.ok()) {
+            reactor->Finish(throttled);
+            return reactor;
+        }
+        common::state::CallContext::Scope scope(call);
+
+        std::vector<common::types::Operation> operations;
+        operations.reserve(request->operations_size());
+        for (int index = 0; index < request->operations_size(); ++index) {
+            auto operation = toOperation(request->operations(index));
+            if (operation.isError()) {
+                reactor->Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                                             "Operation " + std::to_string(index) + ": " + operation.error().message));
+                return reactor;
+            }
+            operations.push_back(std::move(operation).value());
+        }
+
+        if (request->has_execute_at()) {
+            // The batch waits for its dispatch time without a thread, the reactor finishes once it ran
+            auto batch = request_handler_.executeBatchAtAsync(operations, toOrdering(request->ordering()),
+                                                              toExecuteAt(request->execute_at()));
+            common::async::start(std::move(batch), [reactor, response, operations = std::move(operations)](
+                                                        Result<common::types::ScheduledBatch> result) {
                 if (result.isError()) {
-                    return Result<void>::error(result.error());
+                    reactor->Finish(statusOf(result.error()));
+                    return;
                 }
-
-                resp->set_enable(result.value());
-                return Result<void>::success();
+                const auto& scheduled = result.value();
+                for (const auto& dispatch : scheduled.dispatches) {
+                    auto* const camera = response->add_dispatches();
+                    camera->set_camera_id(dispatch.camera_id);
+                    camera->set_skew_us(dispatch.skew.count());
+                }
+                toProto(operations, scheduled.results, response);
+                reactor->Finish(grpc::Status::OK);
             });
+            return reactor;
+        }
+
+        // Lanes run on the batch pool meanwhile, the reactor finishes on the thread that ends the last one
+        auto batch = request_handler_.executeBatchAsync(operations, toOrdering(request->ordering()));
+        common::async::start(std::move(batch), [reactor, response, operations = std::move(operations)](
+                                                    std::vector<common::types::OperationResult> results) {
+            toProto(operations, results, response);
+            reactor->Finish(grpc::Status::OK);
+        });
+        return reactor;
     }
-} // namespace service::api
 
+    grpc::ServerUnaryReactor* GrpcCallbackHandler::GetSystemSnapshot(
+        grpc::CallbackServerContext* context,
+        const core::v1::GetSystemSnapshotRequest* request,
+        core::v1::GetSystemSnapshotResponse* response) {
+        auto* const reactor = context->DefaultReactor();
+        const auto call = callContextOf(*context);
+        if (auto throttled = quotas_.admit(*context, call); !throttled.ok()) {
+            reactor->Finish(throttled);
+            return reactor;
+        }
+        common::state::CallContext::Scope scope(call);
+
+        const auto fields = toSnapshotFields(request->fields());
+        if (fields.isError()) {
+            reactor->Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, fields.error().message));
+            return reactor;
+        }
+
+        // The cameras are read on the snapshot readers, the reactor finishes once the last one answered or timed out
+        std::vector<uint32_t> camera_ids(request->camera_ids().begin(), request->camera_ids().end());
+        auto snapshot = request_handler_.getSystemSnapshotAsync(std::move(camera_ids), fields.value());
+        common::async::start(std::move(snapshot),
+                             [reactor, response](Result<std::vector<common::types::CameraSnapshot>> result) {
+                                 if (result.isError()) {
+                                     reactor->Finish(statusOf(result.error()));
+                                     return;
+                                 }
+                                 for (const auto& camera : result.value()) {
+                                     toProto(camera, response->add_cameras());
+                                 }
+                                 reactor->Finish(grpc::Status::OK);
+                             });
+        return reactor;
+    }
+
+    grpc::ServerWriteReactor<core::v1::CameraStateUpdate>* GrpcCallbackHandler::WatchCameraState(
+        grpc::CallbackServerContext* context,
+        const core::v1::WatchCameraStateRequest* request) {
+        using RejectedStateWriter = RejectedWriter<core::v1::CameraStateUpdate>;
+        if (auto throttled = quotas_.admit(*context, callContextOf(*context)); !throttled.ok()) {
+            return new RejectedStateWriter(throttled);
+        }
+
+        const auto fields = toStateFields(request->fields());
+        if (fields.isError()) {
+            return new RejectedStateWriter(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, fields.error().message));
+        }
+
+        auto subscription = request_handler_.watchCameraState(request->camera_id(), fields.value());
+        if (subscription.isError()) {
+            return new RejectedStateWriter(statusOf(subscription.error()));
+        }
+
+        auto* const writer = new CameraStateWriter(
+            streams_, subscription.value(),
+            grpc::Status(grpc::StatusCode::UNAVAILABLE, "Camera state is no longer available"));
+        if (!streams_.add(writer)) {
+            delete writer;
+            subscription.value()->cancel();
+            return new RejectedStateWriter(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down"));
+        }
+        writer->start();
+        return writer;
+    }
+
+    grpc::ServerWriteReactor<core::v1::MacroProgress>* GrpcCallbackHandler::RunMacro(
+        grpc::CallbackServerContext* context,
+        const core::v1::RunMacroRequest* request) {
+        using RejectedMacroWriter = RejectedWriter<core::v1::MacroProgress>;
+        const auto call = callContextOf(*context);
+        if (auto throttled = quotas_.admit(*context, call); !throttled.ok()) {
+            return new RejectedMacroWriter(throttled);
+        }
+        common::state::CallContext::Scope scope(call);
+
+        Result<std::shared_ptr<common::state::MacroExecution>> execution =
+            Result<std::shared_ptr<common::state::MacroExecution>>::error("Macro is not set");
+        switch (request->macro_case()) {
+        case core::v1::RunMacroRequest::kName:
+            execution = request_handler_.runNamedMacro(request->camera_id(), request->name());
+            break;
+        case core::v1::RunMacroRequest::kDefinition: {
+            const auto macro = toMacro(request->definition());
+            if (macro.isError()) {
+                return new RejectedMacroWriter(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, macro.error().message));
+            }
+            execution = request_handler_.runMacro(request->camera_id(), macro.value());
+            break;
+        }
+        default:
+            return new RejectedMacroWriter(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, execution.error().message));
+        }
+        if (execution.isError()) {
+            return new RejectedMacroWriter(statusOf(execution.error()));
+        }
+
+        auto* const writer = new MacroProgressWriter(streams_, execution.value(), grpc::Status::OK);
+        if (!streams_.add(writer)) {
+            delete writer;
+            execution.value()->cancel();
+            return new RejectedMacroWriter(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down"));
+        }
+        writer->start();
+        return writer;
+    }
+
+    grpc::ServerBidiReactor<core::v1::ControlSetpoint, core::v1::ControlApplied>* GrpcCallbackHandler::ControlStream(
+        grpc::CallbackServerContext* context) {
+        auto call = callContextOf(*context);
+        // A key names a single call, setpoints of a stream are never retried as such
+        call.idempotency_key.clear();
+        auto* const reactor = new ControlStreamReactor(request_handler_, streams_, control_interval_, call);
+        if (auto throttled = quotas_.admit(*context, call); !throttled.ok()) {
+            reactor->close(throttled);
+        } else if (!streams_.add(reactor)) {
+            reactor->close(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down"));
+        }
+        return reactor;
+    }
+
+    void GrpcCallbackHandler::closeStreams() {
+        streams_.closeAll(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down"));
+    }
+} // namespace service::api
@@ -1,13 +1,27 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
+#include "api/ArenaMessageAllocator.h"
+#include "api/ServerStreamRegistry.h"
 #include "api/proto/core_service.grpc.pb.h"
+#include "common/config/ConfigManager.h"
 
 namespace service::api {
+    class CallerQuotas;
     class IRequestHandler;
 
     class GrpcCallbackHandler final : public core::v1::CoreService::CallbackService {
     public:
-        explicit GrpcCallbackHandler(IRequestHandler& request_handler);
+        /**
+         * @param request_handler handler serving the decoded requests
+         * @param quotas request rate quotas of the callers, must outlive the handler
+         * @param passthrough leave the camera methods to the generic passthrough handler
+         * @param control_stream rate limit of ControlStream calls
+         */
+        GrpcCallbackHandler(IRequestHandler& request_handler, CallerQuotas& quotas, bool passthrough = false,
+                            const common::ControlStreamConfig& control_stream = {});
 
         grpc::ServerUnaryReactor* SetZoom(
             grpc::CallbackServerContext* context,
@@ -85,7 +99,133 @@ namespace service::api {
             const core::v1::GetVideoCapabilityStateRequest* request,
             core::v1::GetVideoCapabilityStateResponse* response) override;
 
+        // Batched operations
+        grpc::ServerUnaryReactor* ExecuteBatch(
+            grpc::CallbackServerContext* context,
+            const core::v1::ExecuteBatchRequest* request,
+            core::v1::ExecuteBatchResponse* response) override;
+
+        // Motion
+        grpc::ServerUnaryReactor* ZoomStep(
+            grpc::CallbackServerContext* context,
+            const core::v1::ZoomStepRequest* request,
+            core::v1::ZoomStepResponse* response) override;
+
+        grpc::ServerUnaryReactor* FocusStep(
+            grpc::CallbackServerContext* context,
+            const core::v1::FocusStepRequest* request,
+            core::v1::FocusStepResponse* response) override;
+
+        grpc::ServerUnaryReactor* ZoomVelocity(
+            grpc::CallbackServerContext* context,
+            const core::v1::ZoomVelocityRequest* request,
+            google::protobuf::Empty* response) override;
+
+        grpc::ServerUnaryReactor* FocusVelocity(
+            grpc::CallbackServerContext* context,
+            const core::v1::FocusVelocityRequest* request,
+            google::protobuf::Empty* response) override;
+
+        grpc::ServerUnaryReactor* SetZoomAndWait(
+            grpc::CallbackServerContext* context,
+            const core::v1::SetZoomAndWaitRequest* request,
+            core::v1::SetZoomAndWaitResponse* response) override;
+
+        grpc::ServerUnaryReactor* SetFocusAndWait(
+            grpc::CallbackServerContext* context,
+            const core::v1::SetFocusAndWaitRequest* request,
+            core::v1::SetFocusAndWaitResponse* response) override;
+
+        grpc::ServerUnaryReactor* SavePreset(
+            grpc::CallbackServerContext* context,
+            const core::v1::SavePresetRequest* request,
+            google::protobuf::Empty* response) override;
+
+        grpc::ServerUnaryReactor* DeletePreset(
+            grpc::CallbackServerContext* context,
+            const core::v1::DeletePresetRequest* request,
+            google::protobuf::Empty* response) override;
+
+        grpc::ServerUnaryReactor* ListPresets(
+            grpc::CallbackServerContext* context,
+            const google::protobuf::Empty* request,
+            core::v1::ListPresetsResponse* response) override;
+
+        grpc::ServerUnaryReactor* RecallPreset(
+            grpc::CallbackServerContext* context,
+            const core::v1::RecallPresetRequest* request,
+            core::v1::RecallPresetResponse* response) override;
+
+        grpc::ServerUnaryReactor* CancelMacro(
+            grpc::CallbackServerContext* context,
+            const core::v1::CancelMacroRequest* request,
+            google::protobuf::Empty* response) override;
+
+        // Control leases
+        grpc::ServerUnaryReactor* AcquireControl(
+            grpc::CallbackServerContext* context,
+            const core::v1::AcquireControlRequest* request,
+            core::v1::ControlLease* response) override;
+
+        grpc::ServerUnaryReactor* RenewControl(
+            grpc::CallbackServerContext* context,
+            const core::v1::RenewControlRequest* request,
+            core::v1::ControlLease* response) override;
+
+        grpc::ServerUnaryReactor* ReleaseControl(
+            grpc::CallbackServerContext* context,
+            const core::v1::ReleaseControlRequest* request,
+            google::protobuf::Empty* response) override;
+
+        // Dispatch
+        grpc::ServerUnaryReactor* GetDispatchMetrics(
+            grpc::CallbackServerContext* context,
+            const google::protobuf::Empty* request,
+            core::v1::DispatchMetricsResponse* response) override;
+
+        // Reconciliation
+        grpc::ServerUnaryReactor* GetReconcileStatus(
+            grpc::CallbackServerContext* context,
+            const google::protobuf::Empty* request,
+            core::v1::ReconcileStatusResponse* response) override;
+
+        // System snapshot
+        grpc::ServerUnaryReactor* GetSystemSnapshot(
+            grpc::CallbackServerContext* context,
+            const core::v1::GetSystemSnapshotRequest* request,
+            core::v1::GetSystemSnapshotResponse* response) override;
+
+        // State streaming
+        grpc::ServerWriteReactor<core::v1::CameraStateUpdate>* WatchCameraState(
+            grpc::CallbackServerContext* context,
+            const core::v1::WatchCameraStateRequest* request) override;
+
+        // Macro progress streaming
+        grpc::ServerWriteReactor<core::v1::MacroProgress>* RunMacro(
+            grpc::CallbackServerContext* context,
+            const core::v1::RunMacroRequest* request) override;
+
+        // Continuous control
+        grpc::ServerBidiReactor<core::v1::ControlSetpoint, core::v1::ControlApplied>* ControlStream(
+            grpc::CallbackServerContext* context) override;
+
+        /**
+         * Finish every open state and macro stream and refuse new ones, server shutdown would otherwise wait for them
+         */
+        void closeStreams();
+
     private:
+        /**
+         * Create an arena allocator owned by this handler for one method's message types
+         */
+        template<typename RequestType, typename ResponseType>
+        grpc::MessageAllocator<RequestType, ResponseType>* arenaAllocator();
+
         IRequestHandler& request_handler_;
+        CallerQuotas& quotas_;
+        std::vector<std::unique_ptr<IArenaMessageAllocator>> message_allocators_;
+
+        std::chrono::microseconds control_interval_;
+        ServerStreamRegistry streams_;
     };
 } // namespace service::api
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "GrpcPassthroughHandler.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include "api/IRequestHandler.h"
+#include "api/CallMetadata.h"
+#include "api/CallerQuotas.h"
+#include "api/PassthroughCodec.h"
+#include "infrastructure/clients/RawCall.h"
+
+namespace service::api {
+    namespace {
+        /**
+         * Reads the single request of a unary call, forwards it and writes the backend reply
+         */
+        class PassthroughReactor final : public grpc::ServerGenericBidiReactor {
+        public:
+            PassthroughReactor(grpc::GenericCallbackServerContext* context, IRequestHandler& request_handler,
+                               CallerQuotas& quotas)
+                : context_(context), request_handler_(request_handler),
+                  method_(passthrough::cameraMethodOf(context->method())), call_(callContextOf(*context)) {
+                if (method_.empty()) {
+                    Finish(grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "Unknown method: " + context->method()));
+                    return;
+                }
+                if (auto throttled = quotas.admit(*context, call_); !throttled.ok()) {
+                    Finish(throttled);
+                    return;
+                }
+                StartRead(&request_);
+            }
+
+            void OnReadDone(const bool ok) override {
+                if (!ok) {
+                    Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "Missing request message"));
+                    return;
+                }
+
+                const auto camera_id = passthrough::toCameraRequest(request_, &backend_request_);
+                if (camera_id.isError()) {
+                    Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, camera_id.error().message));
+                    return;
+                }
+
+                infrastructure::RawCall call;
+                call.method = std::string(method_);
+                call.request = &backend_request_;
+                call.response = &response_;
+                call.deadline = grpc::Timespec2Timepoint(context_->raw_deadline());
+                call.on_done = [this](const grpc::Status& status) {
+                    if (status.ok()) {
+                        StartWriteAndFinish(&response_, grpc::WriteOptions(), grpc::Status::OK);
+                    } else {
+                        Finish(status);
+                    }
+                };
+
+                common::state::CallContext::Scope scope(call_);
+                request_handler_.forwardCameraCall(camera_id.value(), std::move(call));
+            }
+
+            void OnDone() override {
+                delete this;
+            }
+
+        private:
+            grpc::GenericCallbackServerContext* context_;
+            IRequestHandler& request_handler_;
+            std::string_view method_;
+            const common::state::CallContext call_;
+
+            grpc::ByteBuffer request_;
+            grpc::ByteBuffer backend_request_;
+            grpc::ByteBuffer response_;
+        };
+    } // unnamed namespace
+
+    GrpcPassthroughHandler::GrpcPassthroughHandler(IRequestHandler& request_handler, CallerQuotas& quotas)
+        : request_handler_(request_handler), quotas_(quotas) {
+    }
+
+    grpc::ServerGenericBidiReactor* GrpcPassthroughHandler::CreateReactor(
+        grpc::GenericCallbackServerContext* context) {
+        return new PassthroughReactor(context, request_handler_, quotas_);
+    }
+} // namespace service::api
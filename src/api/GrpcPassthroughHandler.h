@@ -0,0 +1,27 @@
+#pragma once
+
+#include <grpcpp/generic/async_generic_service.h>
+
+namespace service::api {
+    class CallerQuotas;
+    class IRequestHandler;
+
+    /**
+     * Generic handler relaying CoreService camera calls to camera_service as raw bytes
+     * camera_id is read from the request payload for routing, the remaining payload is
+     * forwarded and the backend reply returned without decoding either message
+     */
+    class GrpcPassthroughHandler final : public grpc::CallbackGenericService {
+    public:
+        /**
+         * @param quotas request rate quotas of the callers, must outlive the handler
+         */
+        GrpcPassthroughHandler(IRequestHandler& request_handler, CallerQuotas& quotas);
+
+        grpc::ServerGenericBidiReactor* CreateReactor(grpc::GenericCallbackServerContext* context) override;
+
+    private:
+        IRequestHandler& request_handler_;
+        CallerQuotas& quotas_;
+    };
+} // namespace service::api
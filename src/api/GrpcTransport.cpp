@@ -6,13 +6,22 @@
 #include <grpcpp/grpcpp.h>
 // #include <grpcpp/ext/proto_server_reflection_plugin.h>
 
+#include "api/CallerQuotas.h"
 #include "api/GrpcCallbackHandler.h"
+#include "api/GrpcPassthroughHandler.h"
 #include "api/IRequestHandler.h"
 #include "common/logger/Logger.h"
 
 namespace service::api {
-    GrpcTransport::GrpcTransport(IRequestHandler& request_handler) {
-        callback_handler_ = std::make_unique<GrpcCallbackHandler>(request_handler);
+    GrpcTransport::GrpcTransport(IRequestHandler& request_handler, const bool passthrough,
+                                 const common::ControlStreamConfig& control_stream,
+                                 const common::QuotasConfig& quotas) {
+        quotas_ = std::make_unique<CallerQuotas>(quotas);
+        callback_handler_ =
+            std::make_unique<GrpcCallbackHandler>(request_handler, *quotas_, passthrough, control_stream);
+        if (passthrough) {
+            passthrough_handler_ = std::make_unique<GrpcPassthroughHandler>(request_handler, *quotas_);
+        }
     }
 
     GrpcTransport::~GrpcTransport() {
@@ -30,9 +39,12 @@ namespace service::api {
 
         grpc::ServerBuilder builder;
         builder.AddChannelArgument(GRPC_ARG_ALLOW_REUSEPORT, 0);
-        int selected_port = 0;
-        builder.AddListeningPort(server_address, grpc::InsecureServerCredentials(), &selected_port);
+        port_ = 0;
+        builder.AddListeningPort(server_address, grpc::InsecureServerCredentials(), &port_);
         builder.RegisterService(callback_handler_.get());
+        if (passthrough_handler_) {
+            builder.RegisterCallbackGenericService(passthrough_handler_.get());
+        }
 
         // Temporarily suppress STDERR to hide gRPC internal error messages
         const int stderr_backup = dup(STDERR_FILENO);
@@ -46,7 +58,7 @@ namespace service::api {
         dup2(stderr_backup, STDERR_FILENO);
         close(stderr_backup);
 
-        if (!server_ || selected_port == 0) {
+        if (!server_ || port_ == 0) {
             return Result<void>::error("Failed to open server on: " + server_address);
         }
 
@@ -61,6 +73,8 @@ namespace service::api {
         }
 
         if (server_) {
+            // Streams never end on their own, finish them so shutdown doesn't wait for the deadline
+            callback_handler_->closeStreams();
             LOG_DEBUG("Shutting down server with 30s deadline...");
             server_->Shutdown(std::chrono::system_clock::now() + std::chrono::seconds(30));
             server_.reset();
@@ -78,4 +92,8 @@ namespace service::api {
         server_->Wait();
         return Result<void>::success();
     }
+
+    int GrpcTransport::port() const {
+        return port_;
+    }
 } // namespace service::api
\ No newline at end of file
@@ -2,24 +2,43 @@
 
 #include "api/ITransport.h"
 #include "api/proto/camera_service.grpc.pb.h" //TODO: can move to implementation file?
+#include "common/config/ConfigManager.h"
 #include "common/types/Result.h"
 
 namespace service::api {
+    class CallerQuotas;
     class IRequestHandler;
     class GrpcCallbackHandler;
+    class GrpcPassthroughHandler;
 
     class GrpcTransport final : public ITransport {
     public:
-        explicit GrpcTransport(IRequestHandler& request_handler);
+        /**
+         * @param request_handler handler serving the requests
+         * @param passthrough relay camera calls to camera_service as raw bytes instead of decoding them
+         * @param control_stream rate limit of ControlStream calls
+         * @param quotas request rate quotas of the callers
+         */
+        explicit GrpcTransport(IRequestHandler& request_handler, bool passthrough = false,
+                               const common::ControlStreamConfig& control_stream = {},
+                               const common::QuotasConfig& quotas = {});
         ~GrpcTransport() override;
 
         Result<void> start(const std::string& server_address) override;
         Result<void> stop() override;
         Result<void> runLoop() override;
 
+        /**
+         * @return port the server listens on, the one picked by the system when started on port 0
+         */
+        int port() const;
+
     private:
+        std::unique_ptr<CallerQuotas> quotas_;
         std::unique_ptr<GrpcCallbackHandler> callback_handler_;
+        std::unique_ptr<GrpcPassthroughHandler> passthrough_handler_;
         std::unique_ptr<grpc::Server> server_;
+        int port_{0};
         bool is_running_{false};
     };
 } // namespace service::api
\ No newline at end of file
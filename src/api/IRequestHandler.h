@@ -1,10 +1,30 @@
 #pragma once
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
+#include "common/async/Task.h"
 #include "common/types/Result.h"
 #include "common/types/CameraTypes.h"
+#include "common/types/BatchOperation.h"
 #include "common/types/CameraCapabilities.h"
+#include "common/types/CameraState.h"
+#include "common/types/ControlLease.h"
+#include "common/types/DispatchMetrics.h"
+#include "common/types/Reconcile.h"
+#include "common/types/Convergence.h"
+#include "common/types/Macro.h"
+#include "common/types/Preset.h"
+#include "common/types/ScheduledBatch.h"
+#include "common/types/StateGeneration.h"
+#include "common/types/SystemSnapshot.h"
+#include "common/state/CameraStateSubscription.h"
+#include "common/state/MacroExecution.h"
+
+namespace service::infrastructure {
+    struct RawCall;
+} // namespace service::infrastructure
 
 namespace service::api {
     class IRequestHandler {
@@ -15,16 +35,61 @@ namespace service::api {
         virtual Result<void> stop() = 0;
         virtual bool isRunning() const = 0;
 
-        virtual Result<void> setZoom(uint32_t camera_id, common::types::zoom zoom_level) const = 0;
+        virtual Result<common::types::zoom> setZoom(uint32_t camera_id, common::types::zoom zoom_level) const = 0;
         virtual Result<common::types::zoom> getZoom(uint32_t camera_id) const = 0;
-        virtual Result<void> goToMinZoom(uint32_t camera_id) const = 0;
-        virtual Result<void> goToMaxZoom(uint32_t camera_id) const = 0;
+        virtual Result<common::types::zoom> goToMinZoom(uint32_t camera_id) const = 0;
+        virtual Result<common::types::zoom> goToMaxZoom(uint32_t camera_id) const = 0;
 
-        virtual Result<void> setFocus(uint32_t camera_id, common::types::focus focus_value) const = 0;
+        virtual Result<common::types::focus> setFocus(uint32_t camera_id, common::types::focus focus_value) const = 0;
         virtual Result<common::types::focus> getFocus(uint32_t camera_id) const = 0;
         virtual Result<void> enableAutoFocus(uint32_t camera_id, bool on) const = 0;
         virtual Result<bool> getAutoFocus(uint32_t camera_id) const = 0;
 
+        // Asynchronous absolute commands, the defaults make the synchronous call when awaited
+        virtual common::async::Task<Result<common::types::zoom>> setZoomAsync(
+            uint32_t camera_id, common::types::zoom zoom_level) const {
+            co_return setZoom(camera_id, zoom_level);
+        }
+
+        virtual common::async::Task<Result<common::types::focus>> setFocusAsync(
+            uint32_t camera_id, common::types::focus focus_value) const {
+            co_return setFocus(camera_id, focus_value);
+        }
+
+        // Relative and continuous motion, clamped to the normalized range
+        virtual Result<common::types::zoom> stepZoom(uint32_t camera_id, int32_t delta) const = 0;
+        virtual Result<common::types::focus> stepFocus(uint32_t camera_id, int32_t delta) const = 0;
+        virtual Result<void> setZoomVelocity(uint32_t camera_id, double velocity,
+                                     std::chrono::milliseconds duration) const = 0;
+        virtual Result<void> setFocusVelocity(uint32_t camera_id, double velocity,
+                                      std::chrono::milliseconds duration) const = 0;
+
+        // Absolute positioning that returns once the lens has reached the value or stopped moving
+        virtual Result<common::types::Convergence> setZoomAndWait(
+            uint32_t camera_id,
+            common::types::zoom zoom_level,
+            uint32_t tolerance,
+            std::chrono::milliseconds timeout) const = 0;
+        virtual Result<common::types::Convergence> setFocusAndWait(
+            uint32_t camera_id,
+            common::types::focus focus_value,
+            uint32_t tolerance,
+            std::chrono::milliseconds timeout) const = 0;
+
+        // The same positioning awaited without holding a thread while the lens moves, the defaults make the
+        // synchronous call when awaited
+        virtual common::async::Task<Result<common::types::Convergence>> setZoomAndWaitAsync(
+            uint32_t camera_id, common::types::zoom zoom_level, uint32_t tolerance,
+            std::chrono::milliseconds timeout) const {
+            co_return setZoomAndWait(camera_id, zoom_level, tolerance, timeout);
+        }
+
+        virtual common::async::Task<Result<common::types::Convergence>> setFocusAndWaitAsync(
+            uint32_t camera_id, common::types::focus focus_value, uint32_t tolerance,
+            std::chrono::milliseconds timeout) const {
+            co_return setFocusAndWait(camera_id, focus_value, tolerance, timeout);
+        }
+
         virtual Result<common::types::info> getInfo(uint32_t camera_id) const = 0;
 
         virtual Result<void> stabilize(uint32_t camera_id, bool on) const = 0;
@@ -39,5 +104,102 @@ namespace service::api {
             bool enable) const = 0;
         virtual Result<std::vector<std::string>> getVideoCapabilities(uint32_t camera_id) const = 0;
         virtual Result<bool> getVideoCapabilityState(uint32_t camera_id, const std::string& capability) const = 0;
+
+        // Passthrough of serialized camera_service calls (routed by camera_id)
+        virtual void forwardCameraCall(uint32_t camera_id, infrastructure::RawCall call) const = 0;
+
+        // State streaming (routed by camera_id)
+        virtual Result<std::shared_ptr<common::state::CameraStateSubscription>> watchCameraState(
+            uint32_t camera_id,
+            common::types::CameraStateFields fields) const = 0;
+
+        // Batched operations, results in operation order
+        virtual std::vector<common::types::OperationResult> executeBatch(
+            const std::vector<common::types::Operation>& operations,
+            common::types::BatchOrdering ordering) const = 0;
+
+        // The same batch awaited without holding a thread while the other lanes run, the default makes the synchronous
+        // call when awaited
+        virtual common::async::Task<std::vector<common::types::OperationResult>> executeBatchAsync(
+            std::vector<common::types::Operation> operations,
+            common::types::BatchOrdering ordering) const {
+            co_return executeBatch(operations, ordering);
+        }
+
+        // Batched operations dispatched together at a requested time, with the achieved skew per camera
+        virtual Result<common::types::ScheduledBatch> executeBatchAt(
+            const std::vector<common::types::Operation>& operations,
+            common::types::BatchOrdering ordering,
+            const common::types::ExecuteAt& execute_at) const = 0;
+
+        // The same batch awaited without holding a thread until its dispatch time, the default makes the synchronous
+        // call when awaited
+        virtual common::async::Task<Result<common::types::ScheduledBatch>> executeBatchAtAsync(
+            std::vector<common::types::Operation> operations,
+            common::types::BatchOrdering ordering,
+            common::types::ExecuteAt execute_at) const {
+            co_return executeBatchAt(operations, ordering, execute_at);
+        }
+
+        // Full state of several cameras, gathered concurrently with a deadline per camera
+        virtual Result<std::vector<common::types::CameraSnapshot>> getSystemSnapshot(
+            const std::vector<uint32_t>& camera_ids,
+            common::types::SnapshotFields fields) const = 0;
+
+        // The same snapshot awaited without holding a thread while the cameras are read, the default makes the
+        // synchronous call when awaited
+        virtual common::async::Task<Result<std::vector<common::types::CameraSnapshot>>> getSystemSnapshotAsync(
+            std::vector<uint32_t> camera_ids,
+            common::types::SnapshotFields fields) const {
+            co_return getSystemSnapshot(camera_ids, fields);
+        }
+
+        // Conditional read of one state field, long-polled when wait is set
+        virtual Result<common::types::VersionedValue> getIfChanged(
+            uint32_t camera_id,
+            const common::types::StateField& field,
+            const common::types::ReadCondition& condition) const = 0;
+
+        // The same read awaited without holding a thread while it long-polls, the default makes the synchronous call
+        // when awaited
+        virtual common::async::Task<Result<common::types::VersionedValue>> getIfChangedAsync(
+            uint32_t camera_id,
+            common::types::StateField field,
+            common::types::ReadCondition condition) const {
+            co_return getIfChanged(camera_id, field, condition);
+        }
+
+        // Presets, named settings of several cameras applied in one call
+        virtual Result<void> savePreset(const common::types::Preset& preset) const = 0;
+        virtual Result<void> deletePreset(const std::string& name) const = 0;
+        virtual Result<std::vector<common::types::Preset>> listPresets() const = 0;
+        virtual Result<common::types::PresetRecall> recallPreset(
+            const std::vector<uint32_t>& camera_ids,
+            const std::string& name) const = 0;
+
+        // Macros, timed sequences of operations run on one camera with streamed progress
+        virtual Result<std::shared_ptr<common::state::MacroExecution>> runMacro(
+            uint32_t camera_id,
+            const common::types::Macro& macro) const = 0;
+        virtual Result<std::shared_ptr<common::state::MacroExecution>> runNamedMacro(
+            uint32_t camera_id,
+            const std::string& name) const = 0;
+        virtual Result<void> cancelMacro(uint32_t camera_id) const = 0;
+
+        // Exclusive control, mutating calls of other clients are rejected while a lease is held
+        virtual Result<common::types::ControlLease> acquireControl(
+            uint32_t camera_id,
+            std::chrono::milliseconds ttl) const = 0;
+        virtual Result<common::types::ControlLease> renewControl(
+            uint32_t camera_id,
+            uint64_t lease_id,
+            std::chrono::milliseconds ttl) const = 0;
+        virtual Result<void> releaseControl(uint32_t camera_id, uint64_t lease_id) const = 0;
+
+        // Admission of backend calls by priority class
+        virtual Result<common::types::DispatchMetrics> getDispatchMetrics() const = 0;
+
+        // Desired-state mode
+        virtual Result<common::types::ReconcileMetrics> getReconcileStatus() const = 0;
     };
 }
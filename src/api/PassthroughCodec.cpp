@@ -0,0 +1,84 @@
+#include "PassthroughCodec.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+
+namespace service::api::passthrough {
+    namespace {
+        using google::protobuf::internal::WireFormatLite;
+
+        constexpr int CAMERA_ID_FIELD = 1;
+    } // unnamed namespace
+
+    std::string_view cameraMethodOf(const std::string_view method_path) {
+        if (!method_path.starts_with(CORE_SERVICE_PREFIX)) {
+            return {};
+        }
+
+        const auto method = method_path.substr(CORE_SERVICE_PREFIX.size());
+        if (std::find(CAMERA_METHODS.begin(), CAMERA_METHODS.end(), method) == CAMERA_METHODS.end()) {
+            return {};
+        }
+        return method;
+    }
+
+    Result<uint32_t> toCameraRequest(const grpc::ByteBuffer& core_request, grpc::ByteBuffer* camera_request) {
+        std::vector<grpc::Slice> slices;
+        if (!core_request.Dump(&slices).ok()) {
+            return Result<uint32_t>::error("Failed to read request payload");
+        }
+
+        // Unary requests normally arrive in a single slice, only fragmented payloads are joined
+        std::string joined;
+        const uint8_t* data = nullptr;
+        std::size_t size = 0;
+        if (slices.size() == 1) {
+            data = slices.front().begin();
+            size = slices.front().size();
+        } else {
+            for (const auto& slice : slices) {
+                joined.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+            }
+            data = reinterpret_cast<const uint8_t*>(joined.data());
+            size = joined.size();
+        }
+
+        uint32_t camera_id = 0;
+        std::string payload;
+        payload.reserve(size);
+        {
+            google::protobuf::io::CodedInputStream input(data, static_cast<int>(size));
+            google::protobuf::io::StringOutputStream output_stream(&payload);
+            google::protobuf::io::CodedOutputStream output(&output_stream);
+
+            while (const uint32_t tag = input.ReadTag()) {
+                const int field = WireFormatLite::GetTagFieldNumber(tag);
+                const auto wire_type = WireFormatLite::GetTagWireType(tag);
+
+                if (field == CAMERA_ID_FIELD) {
+                    if (wire_type != WireFormatLite::WIRETYPE_VARINT || !input.ReadVarint32(&camera_id)) {
+                        return Result<uint32_t>::error("Malformed camera_id in request");
+                    }
+                    continue;
+                }
+
+                // SkipField copies the value behind the tag it is given, so pass the renumbered tag
+                if (!WireFormatLite::SkipField(&input, WireFormatLite::MakeTag(field - 1, wire_type), &output)) {
+                    return Result<uint32_t>::error("Malformed field " + std::to_string(field) + " in request");
+                }
+            }
+
+            if (!input.ConsumedEntireMessage()) {
+                return Result<uint32_t>::error("Malformed request payload");
+            }
+        }
+
+        grpc::Slice slice(payload.data(), payload.size());
+        *camera_request = grpc::ByteBuffer(&slice, 1);
+        return Result<uint32_t>::success(camera_id);
+    }
+} // namespace service::api::passthrough
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <grpcpp/support/byte_buffer.h>
+
+#include "common/types/Result.h"
+
+namespace service::api::passthrough {
+    /**
+     * CoreService camera methods with a camera_service counterpart of the same name
+     * Their responses are wire-identical, their requests differ only by camera_id
+     */
+    inline constexpr std::array<std::string_view, 12> CAMERA_METHODS{
+        "SetZoom", "GetZoom", "GoToMinZoom", "GoToMaxZoom",
+        "SetFocus", "GetFocus", "SetAutoFocus", "GetAutoFocus",
+        "GetInfo", "GetCapabilities", "SetStabilization", "GetStabilization"
+    };
+
+    inline constexpr std::string_view CORE_SERVICE_PREFIX = "/core.v1.CoreService/";
+
+    /**
+     * Get the camera method name of a CoreService method path
+     * @param method_path full method path (e.g., "/core.v1.CoreService/SetZoom")
+     * @return method name, empty if the method cannot be passed through
+     */
+    std::string_view cameraMethodOf(std::string_view method_path);
+
+    /**
+     * Convert a serialized CoreService camera request into its camera_service form
+     * CoreService requests carry camera_id as field 1 followed by the camera_service
+     * fields shifted by one, so field 1 is dropped and the remaining tags renumbered
+     * without parsing the message
+     * @param core_request serialized CoreService request
+     * @param camera_request receives the serialized camera_service request
+     * @return camera_id of the request, error on malformed input
+     */
+    Result<uint32_t> toCameraRequest(const grpc::ByteBuffer& core_request, grpc::ByteBuffer* camera_request);
+} // namespace service::api::passthrough
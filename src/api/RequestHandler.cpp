@@ -1,9 +1,258 @@
 #include "RequestHandler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
 #include "common/logger/Logger.h"
 #include "core/ICore.h"
+#include "infrastructure/clients/RawCall.h"
 
 namespace service::api {
+    namespace {
+        using Level = LoggerInterface::LogLevel;
+
+        constexpr RequestOperation SET_ZOOM{.call = &core::ICore::setZoom,
+                                            .request = "Request: setZoom camera_id={} zoom={}"};
+        constexpr RequestOperation SET_ZOOM_ASYNC{.call = &core::ICore::setZoomAsync, .request = SET_ZOOM.request};
+        // Reads are polled by clients and logged at debug level
+        constexpr RequestOperation GET_ZOOM{.call = &core::ICore::getZoom,
+                                            .request = "Request: getZoom camera_id={}",
+                                            .level = Level::Debug};
+        constexpr RequestOperation GO_TO_MIN_ZOOM{.call = &core::ICore::goToMinZoom,
+                                                  .request = "Request: goToMinZoom camera_id={}"};
+        constexpr RequestOperation GO_TO_MAX_ZOOM{.call = &core::ICore::goToMaxZoom,
+                                                  .request = "Request: goToMaxZoom camera_id={}"};
+        constexpr RequestOperation SET_FOCUS{.call = &core::ICore::setFocus,
+                                             .request = "Request: setFocus camera_id={} focus={}"};
+        constexpr RequestOperation SET_FOCUS_ASYNC{.call = &core::ICore::setFocusAsync,
+                                                   .request = SET_FOCUS.request};
+        constexpr RequestOperation GET_FOCUS{.call = &core::ICore::getFocus,
+                                             .request = "Request: getFocus camera_id={}",
+                                             .level = Level::Debug};
+        constexpr RequestOperation ENABLE_AUTO_FOCUS{.call = &core::ICore::enableAutoFocus,
+                                                     .request = "Request: enableAutoFocus camera_id={} enable={}"};
+        constexpr RequestOperation GET_AUTO_FOCUS{.call = &core::ICore::getAutoFocus,
+                                                  .request = "Request: getAutoFocus camera_id={}",
+                                                  .level = Level::Debug};
+        constexpr RequestOperation STEP_ZOOM{.call = &core::ICore::stepZoom,
+                                             .request = "Request: stepZoom camera_id={} delta={}"};
+        constexpr RequestOperation STEP_FOCUS{.call = &core::ICore::stepFocus,
+                                              .request = "Request: stepFocus camera_id={} delta={}"};
+        constexpr RequestOperation SET_ZOOM_VELOCITY{
+            .call = &core::ICore::setZoomVelocity,
+            .request = "Request: setZoomVelocity camera_id={} velocity={} duration_ms={}"};
+        constexpr RequestOperation SET_FOCUS_VELOCITY{
+            .call = &core::ICore::setFocusVelocity,
+            .request = "Request: setFocusVelocity camera_id={} velocity={} duration_ms={}"};
+        constexpr RequestOperation SET_ZOOM_AND_WAIT{
+            .call = &core::ICore::setZoomAndWaitAsync,
+            .request = "Request: setZoomAndWait camera_id={} zoom={} tolerance={} timeout_ms={}",
+            .respond = [](const common::types::Convergence& converged) {
+                LOG_INFO("Response: zoom={} elapsed_ms={}", converged.value, converged.elapsed.count());
+            }};
+        constexpr RequestOperation SET_FOCUS_AND_WAIT{
+            .call = &core::ICore::setFocusAndWaitAsync,
+            .request = "Request: setFocusAndWait camera_id={} focus={} tolerance={} timeout_ms={}",
+            .respond = [](const common::types::Convergence& converged) {
+                LOG_INFO("Response: focus={} elapsed_ms={}", converged.value, converged.elapsed.count());
+            }};
+        constexpr RequestOperation GET_INFO{.call = &core::ICore::getInfo,
+                                            .request = "Request: getInfo camera_id={}"};
+        constexpr RequestOperation STABILIZE{.call = &core::ICore::stabilize,
+                                             .request = "Request: stabilize camera_id={} enable={}"};
+        constexpr RequestOperation GET_STABILIZATION{.call = &core::ICore::getStabilization,
+                                                     .request = "Request: getStabilization camera_id={}",
+                                                     .level = Level::Debug};
+        constexpr RequestOperation GET_CAPABILITIES{.call = &core::ICore::getCapabilities,
+                                                    .request = "Request: getCapabilities camera_id={}",
+                                                    .response = "Response: {} capabilities"};
+        constexpr RequestOperation SET_VIDEO_CAPABILITY_STATE{
+            .call = &core::ICore::SetVideoCapabilityState,
+            .request = "Request: SetVideoCapabilityState camera_id={} capability={} enable={}"};
+        constexpr RequestOperation GET_VIDEO_CAPABILITIES{.call = &core::ICore::getVideoCapabilities,
+                                                          .request = "Request: getVideoCapabilities camera_id={}",
+                                                          .response = "Response: {} capabilities"};
+        constexpr RequestOperation GET_VIDEO_CAPABILITY_STATE{
+            .call = &core::ICore::getVideoCapabilityState,
+            .request = "Request: getVideoCapabilityState camera_id={} capability={}",
+            .response = "Response: capability enabled={}",
+            .level = Level::Debug};
+        constexpr RequestOperation WATCH_CAMERA_STATE{.call = &core::ICore::watchCameraState,
+                                                      .request = "Request: watchCameraState camera_id={} fields={:#x}",
+                                                      .response = "Response: Subscribed"};
+        constexpr RequestOperation EXECUTE_BATCH_AT{
+            .call = &core::ICore::executeBatchAtAsync,
+            .request = "Request: executeBatchAt operations={} ordering={} at={}",
+            .respond = [](const common::types::ScheduledBatch& batch) {
+                const auto failed = std::count_if(batch.results.begin(), batch.results.end(),
+                                                  [](const auto& operation) { return operation.isError(); });
+                auto max_skew = std::chrono::microseconds::zero();
+                for (const auto& dispatch : batch.dispatches) {
+                    max_skew = std::max(max_skew, std::chrono::abs(dispatch.skew));
+                }
+                if (failed > 0) {
+                    LOG_ERROR("Response: {} of {} operations failed, max skew {} us", failed, batch.results.size(),
+                              max_skew.count());
+                } else {
+                    LOG_INFO("Response: Success, max skew {} us", max_skew.count());
+                }
+            }};
+        constexpr RequestOperation GET_SYSTEM_SNAPSHOT{
+            .call = &core::ICore::getSystemSnapshotAsync,
+            .request = "Request: getSystemSnapshot cameras={} fields={:#x}",
+            .respond = [](const std::vector<common::types::CameraSnapshot>& cameras) {
+                const auto incomplete = std::count_if(cameras.begin(), cameras.end(),
+                                                      [](const auto& camera) { return !camera.errors.empty(); });
+                if (incomplete > 0) {
+                    LOG_WARN("Response: {} of {} cameras incomplete", incomplete, cameras.size());
+                } else {
+                    LOG_INFO("Response: Success");
+                }
+            }};
+        constexpr RequestOperation SAVE_PRESET{.call = &core::ICore::savePreset,
+                                               .request = "Request: savePreset name={}"};
+        constexpr RequestOperation DELETE_PRESET{.call = &core::ICore::deletePreset,
+                                                 .request = "Request: deletePreset name={}"};
+        constexpr RequestOperation LIST_PRESETS{.call = &core::ICore::listPresets,
+                                                .request = "Request: listPresets",
+                                                .response = "Response: {} presets"};
+        constexpr RequestOperation RECALL_PRESET{
+            .call = &core::ICore::recallPreset,
+            .request = "Request: recallPreset name={1} cameras={0}",
+            .respond = [](const common::types::PresetRecall& recall) {
+                if (!recall.errors.empty()) {
+                    LOG_WARN("Response: {} settings failed, {} applied in {} ms", recall.errors.size(),
+                             recall.applied, recall.elapsed.count());
+                } else {
+                    LOG_INFO("Response: {} applied, {} skipped in {} ms", recall.applied, recall.skipped,
+                             recall.elapsed.count());
+                }
+            }};
+        constexpr RequestOperation RUN_MACRO{.call = &core::ICore::runMacro,
+                                             .request = "Request: runMacro camera_id={} macro={}",
+                                             .response = "Response: Started"};
+        constexpr RequestOperation RUN_NAMED_MACRO{.call = &core::ICore::runNamedMacro,
+                                                   .request = "Request: runNamedMacro camera_id={} name={}",
+                                                   .response = "Response: Started"};
+        constexpr RequestOperation CANCEL_MACRO{.call = &core::ICore::cancelMacro,
+                                                .request = "Request: cancelMacro camera_id={}"};
+        // The lease_id is a bearer credential, the lines name arguments by position to leave it out
+        constexpr RequestOperation ACQUIRE_CONTROL{.call = &core::ICore::acquireControl,
+                                                   .request = "Request: acquireControl camera_id={} ttl_ms={}",
+                                                   .response = "Response: Granted for {} ms"};
+        constexpr RequestOperation RENEW_CONTROL{.call = &core::ICore::renewControl,
+                                                 .request = "Request: renewControl camera_id={0} ttl_ms={2}",
+                                                 .response = "Response: Renewed for {} ms"};
+        constexpr RequestOperation RELEASE_CONTROL{.call = &core::ICore::releaseControl,
+                                                   .request = "Request: releaseControl camera_id={0}"};
+        constexpr RequestOperation GET_DISPATCH_METRICS{.call = &core::ICore::getDispatchMetrics,
+                                                        .request = "Request: getDispatchMetrics",
+                                                        .response = "Response: Success"};
+        constexpr RequestOperation GET_RECONCILE_STATUS{.call = &core::ICore::getReconcileStatus,
+                                                        .request = "Request: getReconcileStatus",
+                                                        .response = "Response: Success"};
+
+        /**
+         * @return argument or value as it is logged, durations in their count, lists by their size, named types by
+         *         their name and leases by their TTL
+         */
+        template<typename V>
+        const V& loggable(const V& value) {
+            return value;
+        }
+
+        auto loggable(const std::chrono::milliseconds duration) {
+            return duration.count();
+        }
+
+        template<typename V>
+        std::size_t loggable(const std::vector<V>& values) {
+            return values.size();
+        }
+
+        int loggable(const common::types::BatchOrdering ordering) {
+            return static_cast<int>(ordering);
+        }
+
+        std::string loggable(const common::types::ExecuteAt& execute_at) {
+            return std::to_string(execute_at.time.count()) + " ns on clock " +
+                   std::to_string(static_cast<int>(execute_at.clock));
+        }
+
+        const std::string& loggable(const common::types::Preset& preset) {
+            return preset.name;
+        }
+
+        const std::string& loggable(const common::types::Macro& macro) {
+            return macro.name;
+        }
+
+        auto loggable(const common::types::ControlLease& lease) {
+            return lease.ttl.count();
+        }
+
+        // The level is a template argument, a request logs without branching on it
+        template<Level level, typename... Args>
+        void logAt(const std::string_view format, const Args&... args) {
+            if constexpr (level == Level::Debug) {
+                LOG_DEBUG(format, args...);
+            } else {
+                LOG_INFO(format, args...);
+            }
+        }
+
+        template<const auto& Operation, typename... Args>
+        void logRequest(const Args&... args) {
+            logAt<Operation.level>(Operation.request, loggable(args)...);
+        }
+
+        template<const auto& Operation, typename T>
+        void logResponse(const Result<T>& operation) {
+            if (operation.isError()) {
+                LOG_ERROR("Response: {}", operation.error().message);
+                return;
+            }
+            if constexpr (std::is_void_v<T>) {
+                logAt<Operation.level>("Response: Success");
+            } else if constexpr (Operation.respond != nullptr) {
+                Operation.respond(operation.value());
+            } else if constexpr (Operation.response.find('{') == std::string_view::npos) {
+                logAt<Operation.level>(Operation.response);
+            } else {
+                logAt<Operation.level>(Operation.response, loggable(operation.value()));
+            }
+        }
+    } // namespace
+
+    template<const auto& Operation, typename... Args>
+    RequestResult<Operation> RequestHandler::forward(const Args&... args) const {
+        if (!isRunning()) {
+            return RequestResult<Operation>::error("RequestHandler is not running");
+        }
+
+        logRequest<Operation>(args...);
+        auto operation = (core_.get()->*Operation.call)(args...);
+        logResponse<Operation>(operation);
+        return operation;
+    }
+
+    template<const auto& Operation, typename... Args>
+    common::async::Task<RequestResult<Operation>> RequestHandler::forwardAsync(Args... args) const {
+        if (!isRunning()) {
+            co_return RequestResult<Operation>::error("RequestHandler is not running");
+        }
+
+        logRequest<Operation>(args...);
+        auto call = (core_.get()->*Operation.call)(std::move(args)...);
+        auto operation = co_await std::move(call);
+        logResponse<Operation>(operation);
+        co_return operation;
+    }
+
     RequestHandler::RequestHandler(std::unique_ptr<core::ICore> core)
         : core_(std::move(core)), running_(false) {
         if (!core_) {
@@ -38,8 +287,8 @@ namespace service::api {
 
         if (core_) {
             if (const auto shutdown_result = core_->stop(); shutdown_result.isError()) {
-                LOG_ERROR("Error stopping core: {}", shutdown_result.error());
-                return Result<void>::error("Failed to shut down core: " + shutdown_result.error());
+                LOG_ERROR("Error stopping core: {}", shutdown_result.error().message);
+                return Result<void>::error(shutdown_result.error().prefixed("Failed to shut down core: "));
             }
         }
         LOG_DEBUG("RequestHandler stopped");
@@ -50,279 +299,302 @@ namespace service::api {
         return running_;
     }
 
-    Result<void> RequestHandler::setZoom(uint32_t camera_id, const common::types::zoom zoom_level) const {
-        if (!isRunning()) {
-            return Result<void>::error("RequestHandler is not running");
-        }
+    Result<common::types::zoom> RequestHandler::setZoom(uint32_t camera_id,
+                                                        const common::types::zoom zoom_level) const {
+        return forward<SET_ZOOM>(camera_id, zoom_level);
+    }
 
-        LOG_INFO("Request: {} camera_id={} zoom={}", __func__, camera_id, zoom_level);
+    common::async::Task<Result<common::types::zoom>> RequestHandler::setZoomAsync(
+        uint32_t camera_id, const common::types::zoom zoom_level) const {
+        return forwardAsync<SET_ZOOM_ASYNC>(camera_id, zoom_level);
+    }
 
-        auto operation = core_->setZoom(camera_id, zoom_level);
+    Result<common::types::zoom> RequestHandler::getZoom(uint32_t camera_id) const {
+        return forward<GET_ZOOM>(camera_id);
+    }
 
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: Success");
-        }
+    Result<common::types::zoom> RequestHandler::goToMinZoom(uint32_t camera_id) const {
+        return forward<GO_TO_MIN_ZOOM>(camera_id);
+    }
 
-        return operation;
+    Result<common::types::zoom> RequestHandler::goToMaxZoom(uint32_t camera_id) const {
+        return forward<GO_TO_MAX_ZOOM>(camera_id);
     }
 
-    Result<common::types::zoom> RequestHandler::getZoom(uint32_t camera_id) const {
-        if (!isRunning()) {
-            return Result<common::types::zoom>::error("Request Handler is not running");
-        }
+    Result<common::types::focus> RequestHandler::setFocus(uint32_t camera_id,
+                                                          const common::types::focus focus_value) const {
+        return forward<SET_FOCUS>(camera_id, focus_value);
+    }
 
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
+    common::async::Task<Result<common::types::focus>> RequestHandler::setFocusAsync(
+        uint32_t camera_id, const common::types::focus focus_value) const {
+        return forwardAsync<SET_FOCUS_ASYNC>(camera_id, focus_value);
+    }
 
-        auto operation = core_->getZoom(camera_id);
+    Result<common::types::focus> RequestHandler::getFocus(uint32_t camera_id) const {
+        return forward<GET_FOCUS>(camera_id);
+    }
 
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: {}", operation.value());
-        }
+    Result<void> RequestHandler::enableAutoFocus(uint32_t camera_id, bool on) const {
+        return forward<ENABLE_AUTO_FOCUS>(camera_id, on);
+    }
 
-        return operation;
+    Result<bool> RequestHandler::getAutoFocus(uint32_t camera_id) const {
+        return forward<GET_AUTO_FOCUS>(camera_id);
     }
 
-    Result<void> RequestHandler::goToMinZoom(uint32_t camera_id) const {
-        if (!isRunning()) {
-            return Result<void>::error("Request Handler is not running");
-        }
+    Result<common::types::zoom> RequestHandler::stepZoom(uint32_t camera_id, const int32_t delta) const {
+        return forward<STEP_ZOOM>(camera_id, delta);
+    }
 
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
+    Result<common::types::focus> RequestHandler::stepFocus(uint32_t camera_id, const int32_t delta) const {
+        return forward<STEP_FOCUS>(camera_id, delta);
+    }
 
-        auto operation = core_->goToMinZoom(camera_id);
+    Result<void> RequestHandler::setZoomVelocity(uint32_t camera_id, const double velocity,
+                                                 const std::chrono::milliseconds duration) const {
+        return forward<SET_ZOOM_VELOCITY>(camera_id, velocity, duration);
+    }
 
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: Success");
-        }
+    Result<void> RequestHandler::setFocusVelocity(uint32_t camera_id, const double velocity,
+                                                  const std::chrono::milliseconds duration) const {
+        return forward<SET_FOCUS_VELOCITY>(camera_id, velocity, duration);
+    }
 
-        return operation;
+    Result<common::types::Convergence> RequestHandler::setZoomAndWait(uint32_t camera_id,
+                                                                      const common::types::zoom zoom_level,
+                                                                      const uint32_t tolerance,
+                                                                      const std::chrono::milliseconds timeout) const {
+        return common::async::syncWait(setZoomAndWaitAsync(camera_id, zoom_level, tolerance, timeout));
     }
 
-    Result<void> RequestHandler::goToMaxZoom(uint32_t camera_id) const {
-        if (!isRunning()) {
-            return Result<void>::error("Request Handler is not running");
-        }
+    Result<common::types::Convergence> RequestHandler::setFocusAndWait(uint32_t camera_id,
+                                                                       const common::types::focus focus_value,
+                                                                       const uint32_t tolerance,
+                                                                       const std::chrono::milliseconds timeout) const {
+        return common::async::syncWait(setFocusAndWaitAsync(camera_id, focus_value, tolerance, timeout));
+    }
 
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
+    common::async::Task<Result<common::types::Convergence>> RequestHandler::setZoomAndWaitAsync(
+        uint32_t camera_id, const common::types::zoom zoom_level, const uint32_t tolerance,
+        const std::chrono::milliseconds timeout) const {
+        return forwardAsync<SET_ZOOM_AND_WAIT>(camera_id, zoom_level, tolerance, timeout);
+    }
 
-        auto operation = core_->goToMaxZoom(camera_id);
+    common::async::Task<Result<common::types::Convergence>> RequestHandler::setFocusAndWaitAsync(
+        uint32_t camera_id, const common::types::focus focus_value, const uint32_t tolerance,
+        const std::chrono::milliseconds timeout) const {
+        return forwardAsync<SET_FOCUS_AND_WAIT>(camera_id, focus_value, tolerance, timeout);
+    }
 
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: Success");
-        }
+    Result<common::types::info> RequestHandler::getInfo(uint32_t camera_id) const {
+        return forward<GET_INFO>(camera_id);
+    }
 
-        return operation;
+    Result<void> RequestHandler::stabilize(uint32_t camera_id, const bool on) const {
+        return forward<STABILIZE>(camera_id, on);
     }
 
-    Result<void> RequestHandler::setFocus(uint32_t camera_id, const common::types::focus focus_value) const {
-        if (!isRunning()) {
-            return Result<void>::error("Request Handler is not running");
-        }
+    Result<bool> RequestHandler::getStabilization(uint32_t camera_id) const {
+        return forward<GET_STABILIZATION>(camera_id);
+    }
 
-        LOG_INFO("Request: {} camera_id={} focus={}", __func__, camera_id, focus_value);
+    Result<common::capabilities::CapabilityList> RequestHandler::getCapabilities(uint32_t camera_id) const {
+        return forward<GET_CAPABILITIES>(camera_id);
+    }
 
-        auto operation = core_->setFocus(camera_id, focus_value);
+    Result<void> RequestHandler::SetVideoCapabilityState(
+        uint32_t camera_id,
+        const std::string& capability,
+        const bool enable) const {
+        return forward<SET_VIDEO_CAPABILITY_STATE>(camera_id, capability, enable);
+    }
 
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: Success");
-        }
+    Result<std::vector<std::string>> RequestHandler::getVideoCapabilities(uint32_t camera_id) const {
+        return forward<GET_VIDEO_CAPABILITIES>(camera_id);
+    }
 
-        return operation;
+    Result<bool> RequestHandler::getVideoCapabilityState(
+        uint32_t camera_id,
+        const std::string& capability) const {
+        return forward<GET_VIDEO_CAPABILITY_STATE>(camera_id, capability);
     }
 
-    Result<common::types::focus> RequestHandler::getFocus(uint32_t camera_id) const {
+    void RequestHandler::forwardCameraCall(uint32_t camera_id, infrastructure::RawCall call) const {
         if (!isRunning()) {
-            return Result<common::types::focus>::error("Request Handler is not running");
+            call.on_done(grpc::Status(grpc::StatusCode::UNAVAILABLE, "RequestHandler is not running"));
+            return;
         }
 
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
+        // Logged at debug level, passthrough is meant for high-rate control
+        LOG_DEBUG("Request: {} camera_id={} method={}", __func__, camera_id, call.method);
 
-        auto operation = core_->getFocus(camera_id);
-
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: {}", operation.value());
-        }
+        call.on_done = [on_done = std::move(call.on_done)](const grpc::Status& status) {
+            if (!status.ok()) {
+                LOG_ERROR("Response: {}", status.error_message());
+            } else {
+                LOG_DEBUG("Response: Success");
+            }
+            on_done(status);
+        };
 
-        return operation;
+        core_->forwardCameraCall(camera_id, std::move(call));
     }
 
-    Result<void> RequestHandler::enableAutoFocus(uint32_t camera_id, bool on) const {
-        if (!isRunning()) {
-            return Result<void>::error("Request Handler is not running");
-        }
-
-        LOG_INFO("Request: {} camera_id={} enable={}", __func__, camera_id, on);
-
-        auto operation = core_->enableAutoFocus(camera_id, on);
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: Success");
-        }
+    Result<std::shared_ptr<common::state::CameraStateSubscription>> RequestHandler::watchCameraState(
+        uint32_t camera_id,
+        const common::types::CameraStateFields fields) const {
+        return forward<WATCH_CAMERA_STATE>(camera_id, fields);
+    }
 
-        return operation;
+    std::vector<common::types::OperationResult> RequestHandler::executeBatch(
+        const std::vector<common::types::Operation>& operations,
+        const common::types::BatchOrdering ordering) const {
+        return common::async::syncWait(executeBatchAsync(operations, ordering));
     }
 
-    Result<bool> RequestHandler::getAutoFocus(uint32_t camera_id) const {
+    common::async::Task<std::vector<common::types::OperationResult>> RequestHandler::executeBatchAsync(
+        std::vector<common::types::Operation> operations,
+        const common::types::BatchOrdering ordering) const {
         if (!isRunning()) {
-            return Result<bool>::error("Request Handler is not running");
+            co_return std::vector(operations.size(),
+                                  common::types::OperationResult::error("RequestHandler is not running"));
         }
 
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
+        LOG_INFO("Request: executeBatch operations={} ordering={}", operations.size(), static_cast<int>(ordering));
 
-        auto operation = core_->getAutoFocus(camera_id);
+        auto results = co_await core_->executeBatchAsync(std::move(operations), ordering);
 
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
+        const auto failed = std::count_if(results.begin(), results.end(),
+                                          [](const auto& result) { return result.isError(); });
+        if (failed > 0) {
+            LOG_ERROR("Response: {} of {} operations failed", failed, results.size());
         } else {
-            LOG_INFO("Response: {}", operation.value());
+            LOG_INFO("Response: Success");
         }
 
-        return operation;
+        co_return results;
     }
 
-    Result<common::types::info> RequestHandler::getInfo(uint32_t camera_id) const {
-        if (!isRunning()) {
-            return Result<common::types::info>::error("Request Handler is not running");
-        }
+    Result<common::types::ScheduledBatch> RequestHandler::executeBatchAt(
+        const std::vector<common::types::Operation>& operations,
+        const common::types::BatchOrdering ordering,
+        const common::types::ExecuteAt& execute_at) const {
+        return common::async::syncWait(executeBatchAtAsync(operations, ordering, execute_at));
+    }
 
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
+    common::async::Task<Result<common::types::ScheduledBatch>> RequestHandler::executeBatchAtAsync(
+        std::vector<common::types::Operation> operations,
+        const common::types::BatchOrdering ordering,
+        const common::types::ExecuteAt execute_at) const {
+        return forwardAsync<EXECUTE_BATCH_AT>(std::move(operations), ordering, execute_at);
+    }
 
-        auto operation = core_->getInfo(camera_id);
+    Result<std::vector<common::types::CameraSnapshot>> RequestHandler::getSystemSnapshot(
+        const std::vector<uint32_t>& camera_ids,
+        const common::types::SnapshotFields fields) const {
+        return common::async::syncWait(getSystemSnapshotAsync(camera_ids, fields));
+    }
 
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: {}", operation.value());
-        }
+    common::async::Task<Result<std::vector<common::types::CameraSnapshot>>> RequestHandler::getSystemSnapshotAsync(
+        std::vector<uint32_t> camera_ids,
+        const common::types::SnapshotFields fields) const {
+        return forwardAsync<GET_SYSTEM_SNAPSHOT>(std::move(camera_ids), fields);
+    }
 
-        return operation;
+    Result<common::types::VersionedValue> RequestHandler::getIfChanged(
+        uint32_t camera_id,
+        const common::types::StateField& field,
+        const common::types::ReadCondition& condition) const {
+        return common::async::syncWait(getIfChangedAsync(camera_id, field, condition));
     }
 
-    Result<void> RequestHandler::stabilize(uint32_t camera_id, const bool on) const {
+    common::async::Task<Result<common::types::VersionedValue>> RequestHandler::getIfChangedAsync(
+        uint32_t camera_id,
+        common::types::StateField field,
+        const common::types::ReadCondition condition) const {
         if (!isRunning()) {
-            return Result<void>::error("Request Handler is not running");
+            co_return Result<common::types::VersionedValue>::error("RequestHandler is not running");
         }
 
-        LOG_INFO("Request: {} camera_id={} enable={}", __func__, camera_id, on);
-
-        auto operation = core_->stabilize(camera_id, on);
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
+        // Conditional reads are meant for tight polling loops and are logged at debug level
+        if (condition.if_generation_not) {
+            LOG_DEBUG("Request: getIfChanged camera_id={} if_generation_not={} wait_ms={}", camera_id,
+                      *condition.if_generation_not, condition.wait.count());
         } else {
-            LOG_INFO("Response: Success");
+            LOG_INFO("Request: getIfChanged camera_id={}", camera_id);
         }
 
-        return operation;
-    }
+        auto result = co_await core_->getIfChangedAsync(camera_id, std::move(field), condition);
 
-    Result<bool> RequestHandler::getStabilization(uint32_t camera_id) const {
-        if (!isRunning()) {
-            return Result<bool>::error("Request Handler is not running");
-        }
-
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
-
-        auto operation = core_->getStabilization(camera_id);
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
+        if (result.isError()) {
+            LOG_ERROR("Response: {}", result.error().message);
+        } else if (condition.if_generation_not) {
+            LOG_DEBUG("Response: generation={} modified={}", result.value().generation,
+                      result.value().value.has_value());
         } else {
-            LOG_INFO("Response: {}", operation.value());
+            LOG_INFO("Response: generation={}", result.value().generation);
         }
 
-        return operation;
+        co_return result;
     }
 
-    Result<common::capabilities::CapabilityList> RequestHandler::getCapabilities(uint32_t camera_id) const {
-        if (!isRunning()) {
-            return Result<common::capabilities::CapabilityList>::error("Request Handler is not running");
-        }
+    Result<void> RequestHandler::savePreset(const common::types::Preset& preset) const {
+        return forward<SAVE_PRESET>(preset);
+    }
 
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
+    Result<void> RequestHandler::deletePreset(const std::string& name) const {
+        return forward<DELETE_PRESET>(name);
+    }
 
-        auto operation = core_->getCapabilities(camera_id);
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: {} capabilities", operation.value().size());
-        }
+    Result<std::vector<common::types::Preset>> RequestHandler::listPresets() const {
+        return forward<LIST_PRESETS>();
+    }
 
-        return operation;
+    Result<common::types::PresetRecall> RequestHandler::recallPreset(
+        const std::vector<uint32_t>& camera_ids,
+        const std::string& name) const {
+        return forward<RECALL_PRESET>(camera_ids, name);
     }
 
-    Result<void> RequestHandler::SetVideoCapabilityState(
+    Result<std::shared_ptr<common::state::MacroExecution>> RequestHandler::runMacro(
         uint32_t camera_id,
-        const std::string& capability,
-        const bool enable) const {
-        if (!isRunning()) {
-            return Result<void>::error("RequestHandler is not running");
-        }
-
-        LOG_INFO(
-            "Request: {} camera_id={} capability={} enable={}",
-            __func__,
-            camera_id,
-            capability,
-            enable);
-
-        auto operation = core_->SetVideoCapabilityState(camera_id, capability, enable);
-
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: Success");
-        }
-
-        return operation;
+        const common::types::Macro& macro) const {
+        return forward<RUN_MACRO>(camera_id, macro);
     }
 
-    Result<std::vector<std::string>> RequestHandler::getVideoCapabilities(uint32_t camera_id) const {
-        if (!isRunning()) {
-            return Result<std::vector<std::string>>::error("RequestHandler is not running");
-        }
-
-        LOG_INFO("Request: {} camera_id={}", __func__, camera_id);
-
-        auto operation = core_->getVideoCapabilities(camera_id);
-
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: {} capabilities", operation.value().size());
-        }
+    Result<std::shared_ptr<common::state::MacroExecution>> RequestHandler::runNamedMacro(
+        uint32_t camera_id,
+        const std::string& name) const {
+        return forward<RUN_NAMED_MACRO>(camera_id, name);
+    }
 
-        return operation;
+    Result<void> RequestHandler::cancelMacro(uint32_t camera_id) const {
+        return forward<CANCEL_MACRO>(camera_id);
     }
 
-    Result<bool> RequestHandler::getVideoCapabilityState(
+    Result<common::types::ControlLease> RequestHandler::acquireControl(
         uint32_t camera_id,
-        const std::string& capability) const {
-        if (!isRunning()) {
-            return Result<bool>::error("RequestHandler is not running");
-        }
+        const std::chrono::milliseconds ttl) const {
+        return forward<ACQUIRE_CONTROL>(camera_id, ttl);
+    }
 
-        LOG_INFO("Request: {} camera_id={} capability={}", __func__, camera_id, capability);
+    Result<common::types::ControlLease> RequestHandler::renewControl(
+        uint32_t camera_id,
+        const uint64_t lease_id,
+        const std::chrono::milliseconds ttl) const {
+        return forward<RENEW_CONTROL>(camera_id, lease_id, ttl);
+    }
 
-        auto operation = core_->getVideoCapabilityState(camera_id, capability);
+    Result<void> RequestHandler::releaseControl(uint32_t camera_id, const uint64_t lease_id) const {
+        return forward<RELEASE_CONTROL>(camera_id, lease_id);
+    }
 
-        if (operation.isError()) {
-            LOG_ERROR("Response: {}", operation.error());
-        } else {
-            LOG_INFO("Response: capability enabled={}", operation.value());
-        }
+    Result<common::types::DispatchMetrics> RequestHandler::getDispatchMetrics() const {
+        return forward<GET_DISPATCH_METRICS>();
+    }
 
-        return operation;
+    Result<common::types::ReconcileMetrics> RequestHandler::getReconcileStatus() const {
+        return forward<GET_RECONCILE_STATUS>();
     }
-} // namespace service::api
\ No newline at end of file
+} // namespace service::api
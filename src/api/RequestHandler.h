@@ -1,10 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <vector>
 
 #include "api/IRequestHandler.h"
+#include "api/RequestOperation.h"
 #include "common/types/CameraTypes.h"
 #include "common/types/Result.h"
 
@@ -23,16 +25,47 @@ namespace service::api {
         bool isRunning() const override;
 
         // Capability-aware request methods
-        Result<void> setZoom(uint32_t camera_id, common::types::zoom zoom_level) const override;
+        Result<common::types::zoom> setZoom(uint32_t camera_id, common::types::zoom zoom_level) const override;
         Result<common::types::zoom> getZoom(uint32_t camera_id) const override;
-        Result<void> goToMinZoom(uint32_t camera_id) const override;
-        Result<void> goToMaxZoom(uint32_t camera_id) const override;
+        Result<common::types::zoom> goToMinZoom(uint32_t camera_id) const override;
+        Result<common::types::zoom> goToMaxZoom(uint32_t camera_id) const override;
 
-        Result<void> setFocus(uint32_t camera_id, common::types::focus focus_value) const override;
+        Result<common::types::focus> setFocus(uint32_t camera_id, common::types::focus focus_value) const override;
         Result<common::types::focus> getFocus(uint32_t camera_id) const override;
         Result<void> enableAutoFocus(uint32_t camera_id, bool on) const override;
         Result<bool> getAutoFocus(uint32_t camera_id) const override;
 
+        common::async::Task<Result<common::types::zoom>> setZoomAsync(
+            uint32_t camera_id, common::types::zoom zoom_level) const override;
+        common::async::Task<Result<common::types::focus>> setFocusAsync(
+            uint32_t camera_id, common::types::focus focus_value) const override;
+
+        // Relative and continuous motion, clamped to the normalized range
+        Result<common::types::zoom> stepZoom(uint32_t camera_id, int32_t delta) const override;
+        Result<common::types::focus> stepFocus(uint32_t camera_id, int32_t delta) const override;
+        Result<void> setZoomVelocity(uint32_t camera_id, double velocity,
+                                     std::chrono::milliseconds duration) const override;
+        Result<void> setFocusVelocity(uint32_t camera_id, double velocity,
+                                      std::chrono::milliseconds duration) const override;
+
+        // Absolute positioning that returns once the lens has reached the value or stopped moving
+        Result<common::types::Convergence> setZoomAndWait(
+            uint32_t camera_id,
+            common::types::zoom zoom_level,
+            uint32_t tolerance,
+            std::chrono::milliseconds timeout) const override;
+        Result<common::types::Convergence> setFocusAndWait(
+            uint32_t camera_id,
+            common::types::focus focus_value,
+            uint32_t tolerance,
+            std::chrono::milliseconds timeout) const override;
+        common::async::Task<Result<common::types::Convergence>> setZoomAndWaitAsync(
+            uint32_t camera_id, common::types::zoom zoom_level, uint32_t tolerance,
+            std::chrono::milliseconds timeout) const override;
+        common::async::Task<Result<common::types::Convergence>> setFocusAndWaitAsync(
+            uint32_t camera_id, common::types::focus focus_value, uint32_t tolerance,
+            std::chrono::milliseconds timeout) const override;
+
         Result<common::types::info> getInfo(uint32_t camera_id) const override;
 
         Result<void> stabilize(uint32_t camera_id, bool on) const override;
@@ -48,7 +81,96 @@ namespace service::api {
         Result<std::vector<std::string>> getVideoCapabilities(uint32_t camera_id) const override;
         Result<bool> getVideoCapabilityState(uint32_t camera_id, const std::string& capability) const override;
 
+        // Passthrough of serialized camera_service calls (routed by camera_id)
+        void forwardCameraCall(uint32_t camera_id, infrastructure::RawCall call) const override;
+
+        // State streaming (routed by camera_id)
+        Result<std::shared_ptr<common::state::CameraStateSubscription>> watchCameraState(
+            uint32_t camera_id,
+            common::types::CameraStateFields fields) const override;
+
+        // Batched operations, results in operation order
+        std::vector<common::types::OperationResult> executeBatch(
+            const std::vector<common::types::Operation>& operations,
+            common::types::BatchOrdering ordering) const override;
+        common::async::Task<std::vector<common::types::OperationResult>> executeBatchAsync(
+            std::vector<common::types::Operation> operations,
+            common::types::BatchOrdering ordering) const override;
+
+        // Batched operations dispatched together at a requested time, with the achieved skew per camera
+        Result<common::types::ScheduledBatch> executeBatchAt(
+            const std::vector<common::types::Operation>& operations,
+            common::types::BatchOrdering ordering,
+            const common::types::ExecuteAt& execute_at) const override;
+        common::async::Task<Result<common::types::ScheduledBatch>> executeBatchAtAsync(
+            std::vector<common::types::Operation> operations,
+            common::types::BatchOrdering ordering,
+            common::types::ExecuteAt execute_at) const override;
+
+        // Full state of several cameras, gathered concurrently with a deadline per camera
+        Result<std::vector<common::types::CameraSnapshot>> getSystemSnapshot(
+            const std::vector<uint32_t>& camera_ids,
+            common::types::SnapshotFields fields) const override;
+        common::async::Task<Result<std::vector<common::types::CameraSnapshot>>> getSystemSnapshotAsync(
+            std::vector<uint32_t> camera_ids,
+            common::types::SnapshotFields fields) const override;
+
+        // Conditional read of one state field, long-polled when wait is set
+        Result<common::types::VersionedValue> getIfChanged(
+            uint32_t camera_id,
+            const common::types::StateField& field,
+            const common::types::ReadCondition& condition) const override;
+        common::async::Task<Result<common::types::VersionedValue>> getIfChangedAsync(
+            uint32_t camera_id,
+            common::types::StateField field,
+            common::types::ReadCondition condition) const override;
+
+        // Presets, named settings of several cameras applied in one call
+        Result<void> savePreset(const common::types::Preset& preset) const override;
+        Result<void> deletePreset(const std::string& name) const override;
+        Result<std::vector<common::types::Preset>> listPresets() const override;
+        Result<common::types::PresetRecall> recallPreset(
+            const std::vector<uint32_t>& camera_ids,
+            const std::string& name) const override;
+
+        // Macros, timed sequences of operations run on one camera with streamed progress
+        Result<std::shared_ptr<common::state::MacroExecution>> runMacro(
+            uint32_t camera_id,
+            const common::types::Macro& macro) const override;
+        Result<std::shared_ptr<common::state::MacroExecution>> runNamedMacro(
+            uint32_t camera_id,
+            const std::string& name) const override;
+        Result<void> cancelMacro(uint32_t camera_id) const override;
+
+        // Exclusive control, mutating calls of other clients are rejected while a lease is held
+        Result<common::types::ControlLease> acquireControl(
+            uint32_t camera_id,
+            std::chrono::milliseconds ttl) const override;
+        Result<common::types::ControlLease> renewControl(
+            uint32_t camera_id,
+            uint64_t lease_id,
+            std::chrono::milliseconds ttl) const override;
+        Result<void> releaseControl(uint32_t camera_id, uint64_t lease_id) const override;
+
+        // Admission of backend calls by priority class
+        Result<common::types::DispatchMetrics> getDispatchMetrics() const override;
+
+        // Desired-state mode
+        Result<common::types::ReconcileMetrics> getReconcileStatus() const override;
+
     private:
+        /**
+         * Forward a request described by a RequestOperation to the core, logging it and its response
+         */
+        template<const auto& Operation, typename... Args>
+        RequestResult<Operation> forward(const Args&... args) const;
+
+        /**
+         * Forward a request whose core call responds through a task, the arguments are kept for its lifetime
+         */
+        template<const auto& Operation, typename... Args>
+        common::async::Task<RequestResult<Operation>> forwardAsync(Args... args) const;
+
         std::unique_ptr<core::ICore> core_;
         std::atomic<bool> running_;
     };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "common/async/Task.h"
+#include "common/logger/LoggerInterface.h"
+#include "common/types/Result.h"
+#include "core/ICore.h"
+
+namespace service::api {
+    namespace detail {
+        /**
+         * Value a core call responds with, at once or through a task
+         */
+        template<typename Response>
+        struct ResponseValue;
+
+        template<typename T>
+        struct ResponseValue<Result<T>> {
+            using type = T;
+        };
+
+        template<typename T>
+        struct ResponseValue<common::async::Task<Result<T>>> {
+            using type = T;
+        };
+
+        /**
+         * Function logging a successful response, calls without a value respond with Success instead
+         */
+        template<typename T>
+        struct ResponseLogger {
+            using type = void (*)(const T&);
+        };
+
+        template<>
+        struct ResponseLogger<void> {
+            using type = void (*)();
+        };
+    } // namespace detail
+
+    /**
+     * Compile-time description of a request RequestHandler forwards to the core as it is, and of the lines it logs
+     * The request line is formatted with the arguments of the call, the response line with the value. A response line
+     * without a placeholder is logged as it is, respond logs a value one placeholder does not describe
+     */
+    template<typename Response, typename... Args>
+    struct RequestOperation {
+        using Value = typename detail::ResponseValue<Response>::type;
+
+        Response (core::ICore::*call)(Args...) const;
+        std::string_view request;
+        std::string_view response{"Response: {}"}; // unused by calls without a value, they respond with Success
+        LoggerInterface::LogLevel level{LoggerInterface::LogLevel::Info}; // of both lines, errors are always logged
+        typename detail::ResponseLogger<Value>::type respond{nullptr}; // logs the value in place of the response line
+    };
+
+    /**
+     * Result of the request a RequestOperation constant describes
+     */
+    template<const auto& Operation>
+    using RequestResult = Result<typename std::remove_cvref_t<decltype(Operation)>::Value>;
+} // namespace service::api
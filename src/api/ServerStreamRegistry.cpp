@@ -0,0 +1,26 @@
+#include "ServerStreamRegistry.h"
+
+namespace service::api {
+    bool ServerStreamRegistry::add(IServerStream* stream) {
+        std::lock_guard lock(mutex_);
+        if (closed_) {
+            return false;
+        }
+        streams_.insert(stream);
+        return true;
+    }
+
+    void ServerStreamRegistry::remove(IServerStream* stream) {
+        std::lock_guard lock(mutex_);
+        streams_.erase(stream);
+    }
+
+    void ServerStreamRegistry::closeAll(const grpc::Status& status) {
+        // Held while closing so no stream is deleted underneath, close() must not call remove()
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+        for (auto* const stream : streams_) {
+            stream->close(status);
+        }
+    }
+} // namespace service::api
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_set>
+#include <grpcpp/support/status.h>
+
+namespace service::api {
+    /**
+     * Long-lived streaming reactor the server can end on shutdown
+     */
+    class IServerStream {
+    public:
+        virtual ~IServerStream() = default;
+
+        /**
+         * Finish the stream with status, safe to call from any thread and more than once
+         */
+        virtual void close(const grpc::Status& status) = 0;
+    };
+
+    /**
+     * Open streams of a service, server shutdown otherwise waits for them until its deadline
+     */
+    class ServerStreamRegistry {
+    public:
+        /**
+         * @return false once the registry was closed, the stream must then be refused
+         */
+        bool add(IServerStream* stream);
+
+        /**
+         * Called from the stream's OnDone, before it is deleted
+         */
+        void remove(IServerStream* stream);
+
+        /**
+         * Close every registered stream and refuse new ones
+         */
+        void closeAll(const grpc::Status& status);
+
+    private:
+        std::mutex mutex_;
+        std::unordered_set<IServerStream*> streams_;
+        bool closed_{false};
+    };
+} // namespace service::api
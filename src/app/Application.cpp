@@ -68,7 +68,8 @@ namespace service::app {
             LOG_INFO("{} v{}.{}.{}{}", APP_NAME, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_PATCH,
                      APP_VERSION_DIRTY);
 
-            auto core = core::CoreFactory::createCore(config_->getInfrastructureConfig());
+            auto core = core::CoreFactory::createCore(config_->getCoreConfig(),
+                                                      config_->getInfrastructureConfig());
             api_controller_ = api::ApiControllerFactory::createController(std::move(core), config_->getApiConfig());
 
             return Result<void>::success();
@@ -5,19 +5,19 @@ int main(int argc, char* argv[]) {
     service::app::Application app(argc, argv);
 
     if (const auto result = app.initialize(); result.isError()) {
-        LOG_ERROR("Initialization failed: {}", result.error());
+        LOG_ERROR("Initialization failed: {}", result.error().message);
         return EXIT_FAILURE;
     }
 
     if (const auto result = app.start(); result.isError()) {
-        LOG_ERROR("Failed to start: {}", result.error());
+        LOG_ERROR("Failed to start: {}", result.error().message);
         return EXIT_FAILURE;
     }
 
     app.run(); // Blocking call
 
     if (const auto result = app.stop(); result.isError()) {
-        LOG_ERROR("Shutdown error: {}", result.error());
+        LOG_ERROR("Shutdown error: {}", result.error().message);
         return EXIT_FAILURE;
     }
 
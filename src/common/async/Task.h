@@ -0,0 +1,319 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace service::common::async {
+    template<typename T>
+    class Task;
+
+    namespace detail {
+        /**
+         * Resume the coroutine awaiting a finished task on the thread that finished it, without growing the stack
+         */
+        struct FinalAwaiter {
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+                if (const auto continuation = handle.promise().continuation) {
+                    return continuation;
+                }
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {
+            }
+        };
+
+        template<typename T>
+        struct TaskPromise {
+            std::coroutine_handle<> continuation;
+            std::optional<T> value;
+            std::exception_ptr exception;
+
+            Task<T> get_return_object() {
+                return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept {
+                return {};
+            }
+
+            template<typename U>
+            void return_value(U&& result) {
+                value.emplace(std::forward<U>(result));
+            }
+
+            void unhandled_exception() {
+                exception = std::current_exception();
+            }
+        };
+
+        /**
+         * Coroutine that runs as soon as it is called and frees itself when it ends, nothing awaits it
+         */
+        struct Detached {
+            struct promise_type {
+                Detached get_return_object() const noexcept {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() const noexcept {
+                    return {};
+                }
+
+                void return_void() const noexcept {
+                }
+
+                void unhandled_exception() const noexcept {
+                    std::terminate();
+                }
+            };
+        };
+
+        template<typename T, typename Done>
+        Detached runDetached(Task<T> task, Done done) {
+            std::optional<T> value;
+            std::exception_ptr exception;
+            try {
+                value.emplace(co_await std::move(task));
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            done(std::move(value), exception);
+        }
+    } // namespace detail
+
+    /**
+     * Lazily started coroutine producing a T, e.g. Task<Result<zoom>>
+     * The body runs when the task is awaited, on the awaiting thread up to its first suspension, then on whichever
+     * thread resumes it (a gRPC completion thread for backend calls). The awaiting coroutine continues on the thread
+     * the task ends on. Move-only, the frame is freed with the task
+     */
+    template<typename T>
+    class [[nodiscard]] Task {
+        static_assert(!std::is_void_v<T> && !std::is_reference_v<T>, "Task carries a value, e.g. Result<void>");
+
+    public:
+        using promise_type = detail::TaskPromise<T>;
+
+        Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {
+        }
+
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (handle_) {
+                    handle_.destroy();
+                }
+                handle_ = std::exchange(other.handle_, nullptr);
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task() {
+            if (handle_) {
+                handle_.destroy();
+            }
+        }
+
+        auto operator co_await() && noexcept {
+            struct Awaiter {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume() const {
+                    auto& promise = handle.promise();
+                    if (promise.exception) {
+                        std::rethrow_exception(promise.exception);
+                    }
+                    return std::move(*promise.value);
+                }
+            };
+            return Awaiter{handle_};
+        }
+
+    private:
+        friend struct detail::TaskPromise<T>;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {
+        }
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    /**
+     * Run a task without waiting for it
+     * @param done called with the value of the task on the thread it ends on, an exception of the task or of done
+     *             ends the process
+     */
+    template<typename T, typename Done>
+    void start(Task<T> task, Done done) {
+        detail::runDetached(std::move(task), [done = std::move(done)](std::optional<T> value,
+                                                                      const std::exception_ptr& exception) mutable {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+            done(std::move(*value));
+        });
+    }
+
+    /**
+     * Block the calling thread until a task ends, the bridge from synchronous code
+     * @return value of the task, rethrows its exception
+     */
+    template<typename T>
+    T syncWait(Task<T> task) {
+        std::promise<T> promise;
+        auto result = promise.get_future();
+        detail::runDetached(std::move(task), [&promise](std::optional<T> value, const std::exception_ptr& exception) {
+            if (exception) {
+                promise.set_exception(exception);
+            } else {
+                promise.set_value(std::move(*value));
+            }
+        });
+        return result.get();
+    }
+
+    /**
+     * Start every task at once and resume when the last one ends
+     * The tasks run concurrently as far as they suspend, e.g. on backend calls, the awaiting coroutine continues on
+     * the thread that ended the last one
+     * @return values in the order of the tasks, rethrows the first exception once all of them ended
+     */
+    template<typename T>
+    Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks) {
+        struct State {
+            explicit State(const std::size_t count) : remaining(count + 1), values(count) {
+            }
+
+            std::atomic<std::size_t> remaining; // tasks running, plus one held by the awaiter until all are started
+            std::vector<std::optional<T>> values;
+            std::exception_ptr exception;
+            std::atomic<bool> failed{false};
+            std::coroutine_handle<> awaiting;
+        };
+
+        // Awaiters hold no owning members, some compilers destroy a temporary awaiter twice
+        struct Awaiter {
+            std::vector<Task<T>>* tasks;
+            std::shared_ptr<State>* state;
+
+            bool await_ready() const noexcept {
+                return tasks->empty();
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting) const {
+                (*state)->awaiting = awaiting;
+                for (std::size_t index = 0; index < tasks->size(); ++index) {
+                    detail::runDetached(std::move((*tasks)[index]),
+                                        [state = *state, index](std::optional<T> value,
+                                                                const std::exception_ptr& exception) {
+                                            if (exception) {
+                                                if (!state->failed.exchange(true, std::memory_order_relaxed)) {
+                                                    state->exception = exception;
+                                                }
+                                            } else {
+                                                state->values[index] = std::move(value);
+                                            }
+                                            if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                                                state->awaiting.resume();
+                                            }
+                                        });
+                }
+                // Every task may have ended already, then the awaiting coroutine just goes on
+                return (*state)->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+            }
+
+            void await_resume() const noexcept {
+            }
+        };
+
+        auto state = std::make_shared<State>(tasks.size());
+        co_await Awaiter{&tasks, &state};
+        if (state->exception) {
+            std::rethrow_exception(state->exception);
+        }
+
+        std::vector<T> values;
+        values.reserve(state->values.size());
+        for (auto& value : state->values) {
+            values.push_back(std::move(*value));
+        }
+        co_return values;
+    }
+
+    /**
+     * Suspend until a callback delivers the value, the bridge from callback based code such as timers and listeners
+     * @param arm called with a completion function when the task is awaited, the completion may be called once on any
+     *            thread, also before arm returns, and the awaiting coroutine continues on that thread
+     * @return value passed to the completion
+     */
+    template<typename T, typename Arm>
+    Task<T> fromCallback(Arm arm) {
+        struct State {
+            std::atomic<int> remaining{2}; // the completion, plus one held by the awaiter until arm returned
+            std::optional<T> value;
+            std::coroutine_handle<> awaiting;
+        };
+
+        // Awaiters hold no owning members, some compilers destroy a temporary awaiter twice
+        struct Awaiter {
+            Arm* arm;
+            std::shared_ptr<State>* state;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting) const {
+                (*state)->awaiting = awaiting;
+                (*arm)([state = *state](T value) {
+                    state->value.emplace(std::move(value));
+                    if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        state->awaiting.resume();
+                    }
+                });
+                // The completion may have run already, then the awaiting coroutine just goes on
+                return (*state)->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+            }
+
+            void await_resume() const noexcept {
+            }
+        };
+
+        auto state = std::make_shared<State>();
+        co_await Awaiter{&arm, &state};
+        co_return std::move(*state->value);
+    }
+} // namespace service::common::async
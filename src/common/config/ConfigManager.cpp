@@ -3,8 +3,47 @@
 #include <set>
 #include <yaml-cpp/yaml.h>
 
+#include "common/config/MacroYaml.h"
+#include "common/config/PresetYaml.h"
+#include "common/network/NetworkUtils.h"
+
 namespace service::common {
 
+    void ControlStreamConfig::validate() const {
+        if (max_rate_hz == 0 || max_rate_hz > 1000) {
+            throw std::runtime_error("Control stream max rate must be within [1, 1000] Hz");
+        }
+    }
+
+    void CallerQuota::validate() const {
+        if (rate_hz < 0) {
+            throw std::runtime_error("Quota rate must not be negative");
+        }
+        if (rate_hz > 0 && burst == 0) {
+            throw std::runtime_error("Quota burst must be positive");
+        }
+    }
+
+    void QuotasConfig::validate() const {
+        defaults.validate();
+        if (max_callers == 0) {
+            throw std::runtime_error("Quota max callers must be positive");
+        }
+        if (idle_timeout.count() <= 0) {
+            throw std::runtime_error("Quota idle timeout must be positive");
+        }
+        std::set<std::string> names;
+        for (const auto& quota : callers) {
+            if (quota.caller.empty()) {
+                throw std::runtime_error("Quota caller cannot be empty");
+            }
+            if (!names.insert(quota.caller).second) {
+                throw std::runtime_error("Duplicate quota for caller " + quota.caller);
+            }
+            quota.validate();
+        }
+    }
+
     void ApiConfig::validate() const {
         static const std::set<std::string> valid_apis{"grpc"};
 
@@ -20,10 +59,181 @@ namespace service::common {
         if (server_address.find(':') == std::string::npos) {
             throw std::runtime_error("Server address must include port (format: host:port)");
         }
+        control_stream.validate();
+        quotas.validate();
+    }
+
+    void StateHubConfig::validate() const {
+        if (poll_min <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("State hub minimum poll interval must be positive");
+        }
+        if (poll_max < poll_min) {
+            throw std::runtime_error("State hub maximum poll interval must not be below the minimum");
+        }
+        if (queue_size == 0) {
+            throw std::runtime_error("State hub queue size must be positive");
+        }
+        if (max_wait <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("State hub maximum wait must be positive");
+        }
+    }
+
+    void SnapshotConfig::validate() const {
+        if (camera_timeout <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Snapshot camera timeout must be positive");
+        }
+        if (static_ttl < std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Snapshot static TTL must not be negative");
+        }
+        if (max_readers == 0) {
+            throw std::runtime_error("Snapshot max readers must be positive");
+        }
+    }
+
+    void MotionConfig::validate() const {
+        if (tick_hz == 0 || tick_hz > 1000) {
+            throw std::runtime_error("Motion tick rate must be within [1, 1000] Hz");
+        }
+        if (max_duration <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Motion maximum duration must be positive");
+        }
+    }
+
+    void ConvergenceConfig::validate() const {
+        if (min_poll_interval <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Convergence minimum poll interval must be positive");
+        }
+        if (max_poll_interval < min_poll_interval) {
+            throw std::runtime_error("Convergence maximum poll interval must not be below the minimum");
+        }
+        if (settle_time <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Convergence settle time must be positive");
+        }
+        if (max_wait <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Convergence maximum wait must be positive");
+        }
+    }
+
+    void PresetsConfig::validate() const {
+        std::set<std::string> names;
+        for (const auto& preset : definitions) {
+            if (const auto reason = preset.invalidReason(); !reason.empty()) {
+                throw std::runtime_error(reason);
+            }
+            if (!names.insert(preset.name).second) {
+                throw std::runtime_error("Duplicate preset name: " + preset.name);
+            }
+        }
+    }
+
+    void MacrosConfig::validate() const {
+        std::set<std::string> names;
+        for (const auto& macro : definitions) {
+            if (macro.name.empty()) {
+                throw std::runtime_error("Macro name cannot be empty");
+            }
+            if (const auto reason = macro.invalidReason(); !reason.empty()) {
+                throw std::runtime_error(reason);
+            }
+            if (!names.insert(macro.name).second) {
+                throw std::runtime_error("Duplicate macro name: " + macro.name);
+            }
+        }
+    }
+
+    void SchedulingConfig::validate() const {
+        if (resolution <= std::chrono::microseconds::zero()) {
+            throw std::runtime_error("Scheduling resolution must be positive");
+        }
+        if (prepare_lead < std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Scheduling prepare lead must not be negative");
+        }
+        if (max_lead <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Scheduling maximum lead must be positive");
+        }
+    }
+
+    void LeasesConfig::validate() const {
+        if (default_ttl <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Default lease TTL must be positive");
+        }
+        if (max_ttl < default_ttl) {
+            throw std::runtime_error("Maximum lease TTL must not be below the default TTL");
+        }
+    }
+
+    void AdaptiveConcurrencyConfig::validate() const {
+        if (!enabled) {
+            return;
+        }
+        if (min_limit == 0 || min_limit > max_limit) {
+            throw std::runtime_error("Adaptive concurrency limits must satisfy 0 < min_limit <= max_limit");
+        }
+        if (tolerance < 1.0) {
+            throw std::runtime_error("Adaptive concurrency tolerance must be at least 1");
+        }
+        if (smoothing <= 0.0 || smoothing > 1.0) {
+            throw std::runtime_error("Adaptive concurrency smoothing must be within (0, 1]");
+        }
+        if (queue_per_limit == 0) {
+            throw std::runtime_error("Adaptive concurrency queue per limit must be positive");
+        }
+    }
+
+    void DispatchConfig::validate() const {
+        adaptive.validate();
+        if (adaptive.enabled && (max_in_flight < adaptive.min_limit || max_in_flight > adaptive.max_limit)) {
+            throw std::runtime_error("Dispatch max in flight must be within the adaptive concurrency limits");
+        }
+        if (background_max_queued > max_queued) {
+            throw std::runtime_error("Dispatch background max queued must not exceed max queued");
+        }
+        for (const auto& [caller, weight] : caller_weights) {
+            if (weight == 0) {
+                throw std::runtime_error("Dispatch weight of caller " + caller + " must be positive");
+            }
+        }
+    }
+
+    void IdempotencyConfig::validate() const {
+        if (ttl < std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Idempotency TTL must not be negative");
+        }
+        if (max_entries == 0) {
+            throw std::runtime_error("Idempotency max entries must be positive");
+        }
+    }
+
+    void ReconcileConfig::validate() const {
+        if (check_interval <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Reconcile check interval must be positive");
+        }
+        if (settle_time < std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Reconcile settle time must not be negative");
+        }
+        if (connection_poll <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Reconcile connection poll must be positive");
+        }
+        if (connection_poll > check_interval) {
+            throw std::runtime_error("Reconcile connection poll must not exceed the check interval");
+        }
+        if (max_checks == 0) {
+            throw std::runtime_error("Reconcile max checks must be positive");
+        }
     }
 
     void CoreConfig::validate() const {
-        // No validation needed for CoreConfig after removing camera dependency
+        state_hub.validate();
+        snapshot.validate();
+        motion.validate();
+        convergence.validate();
+        presets.validate();
+        scheduling.validate();
+        macros.validate();
+        leases.validate();
+        dispatch.validate();
+        idempotency.validate();
+        reconcile.validate();
     }
 
     void ServiceInstance::validate() const {
@@ -33,6 +243,62 @@ namespace service::common {
         if (address.find(':') == std::string::npos) {
             throw std::runtime_error("Service instance address must include port (format: host:port)");
         }
+        if (!pinned_ip.empty() && !network::isIpv4Address(pinned_ip)) {
+            throw std::runtime_error("Service instance pinned IP must be an IPv4 address: " + pinned_ip);
+        }
+    }
+
+    void BatchingConfig::validate() const {
+        if (!enabled) {
+            return;
+        }
+        if (window <= std::chrono::microseconds::zero() || window > std::chrono::milliseconds(1)) {
+            throw std::runtime_error("Batching window must be within (0, 1000] us");
+        }
+        if (max_batch_size < 2) {
+            throw std::runtime_error("Batching max batch size must be at least 2");
+        }
+    }
+
+    void AdmissionLimit::validate() const {
+        if (rate_hz < 0) {
+            throw std::runtime_error("Admission rate must not be negative");
+        }
+        if (rate_hz == 0) {
+            return;
+        }
+        if (burst == 0) {
+            throw std::runtime_error("Admission burst must be at least 1");
+        }
+        if (on_limit != AdmissionMode::Reject && max_wait < std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Admission max wait must not be negative");
+        }
+    }
+
+    void AdmissionConfig::validate() const {
+        set.validate();
+        get.validate();
+        if (get.rate_hz > 0 && get.on_limit == AdmissionMode::Conflate) {
+            throw std::runtime_error("Admission of reads cannot conflate, use queue or reject");
+        }
+    }
+
+    void WarmupConfig::validate() const {
+        if (!enabled) {
+            return;
+        }
+        if (budget <= std::chrono::milliseconds::zero()) {
+            throw std::runtime_error("Warm-up budget must be positive");
+        }
+        if (min_ready_fraction < 0.0 || min_ready_fraction > 1.0) {
+            throw std::runtime_error("Warm-up min ready fraction must be within [0, 1]");
+        }
+    }
+
+    void ResolverConfig::validate() const {
+        if (enabled && ttl <= std::chrono::seconds::zero()) {
+            throw std::runtime_error("Resolver TTL must be positive");
+        }
     }
 
     void ClientConfig::validate() const {
@@ -42,6 +308,8 @@ namespace service::common {
         for (const auto& instance : instances) {
             instance.validate();
         }
+        batching.validate();
+        admission.validate();
     }
 
     void InfrastructureConfig::validate() const {
@@ -49,6 +317,8 @@ namespace service::common {
         for (const auto& [name, client] : clients) {
             client.validate();
         }
+        warmup.validate();
+        resolver.validate();
 
         const auto camera_it = clients.find("camera_service");
         const auto video_it = clients.find("video_service");
@@ -101,6 +371,7 @@ namespace service::common {
             if (const YAML::Node config = YAML::LoadFile(filename); config["app"]) {
                 const auto& app_node = config["app"];
                 loadApiConfig(app_node);
+                loadCoreConfig(app_node);
                 loadInfrastructureConfig(app_node);
                 loadAppConfig(app_node);
             }
@@ -119,6 +390,218 @@ namespace service::common {
             if (api_node["server_address"]) {
                 app_config_->api_config.server_address = api_node["server_address"].as<std::string>();
             }
+            if (api_node["passthrough"]) {
+                app_config_->api_config.passthrough = api_node["passthrough"].as<bool>();
+            }
+            if (const auto& control_node = api_node["control_stream"]) {
+                if (control_node["max_rate_hz"]) {
+                    app_config_->api_config.control_stream.max_rate_hz = control_node["max_rate_hz"].as<uint32_t>();
+                }
+            }
+            if (const auto& quotas_node = api_node["quotas"]) {
+                auto& quotas = app_config_->api_config.quotas;
+                const auto load = [](const YAML::Node& node, CallerQuota& quota) {
+                    if (node["rate_hz"]) {
+                        quota.rate_hz = node["rate_hz"].as<double>();
+                    }
+                    if (node["burst"]) {
+                        quota.burst = node["burst"].as<uint32_t>();
+                    }
+                };
+                load(quotas_node, quotas.defaults);
+                if (quotas_node["max_callers"]) {
+                    quotas.max_callers = quotas_node["max_callers"].as<std::size_t>();
+                }
+                if (quotas_node["idle_timeout_ms"]) {
+                    quotas.idle_timeout = std::chrono::milliseconds(quotas_node["idle_timeout_ms"].as<int64_t>());
+                }
+                if (const auto& callers_node = quotas_node["callers"]) {
+                    for (const auto& caller_node : callers_node) {
+                        CallerQuota quota;
+                        quota.caller = caller_node["caller"] ? caller_node["caller"].as<std::string>() : "";
+                        load(caller_node, quota);
+                        quotas.callers.push_back(std::move(quota));
+                    }
+                }
+            }
+        }
+    }
+
+    void ConfigManager::loadCoreConfig(const YAML::Node& app_node) const {
+        if (!app_node["core"]) {
+            return;
+        }
+
+        if (const auto& state_hub_node = app_node["core"]["state_hub"]) {
+            auto& state_hub = app_config_->core_config.state_hub;
+            if (state_hub_node["poll_min_ms"]) {
+                state_hub.poll_min = std::chrono::milliseconds(state_hub_node["poll_min_ms"].as<int64_t>());
+            }
+            if (state_hub_node["poll_max_ms"]) {
+                state_hub.poll_max = std::chrono::milliseconds(state_hub_node["poll_max_ms"].as<int64_t>());
+            }
+            if (state_hub_node["queue_size"]) {
+                state_hub.queue_size = state_hub_node["queue_size"].as<std::size_t>();
+            }
+            if (state_hub_node["max_wait_ms"]) {
+                state_hub.max_wait = std::chrono::milliseconds(state_hub_node["max_wait_ms"].as<int64_t>());
+            }
+        }
+
+        if (const auto& snapshot_node = app_node["core"]["snapshot"]) {
+            auto& snapshot = app_config_->core_config.snapshot;
+            if (snapshot_node["camera_timeout_ms"]) {
+                snapshot.camera_timeout = std::chrono::milliseconds(snapshot_node["camera_timeout_ms"].as<int64_t>());
+            }
+            if (snapshot_node["static_ttl_ms"]) {
+                snapshot.static_ttl = std::chrono::milliseconds(snapshot_node["static_ttl_ms"].as<int64_t>());
+            }
+            if (snapshot_node["max_readers"]) {
+                snapshot.max_readers = snapshot_node["max_readers"].as<std::size_t>();
+            }
+        }
+
+        if (const auto& motion_node = app_node["core"]["motion"]) {
+            auto& motion = app_config_->core_config.motion;
+            if (motion_node["tick_hz"]) {
+                motion.tick_hz = motion_node["tick_hz"].as<uint32_t>();
+            }
+            if (motion_node["max_duration_ms"]) {
+                motion.max_duration = std::chrono::milliseconds(motion_node["max_duration_ms"].as<int64_t>());
+            }
+        }
+
+        if (const auto& convergence_node = app_node["core"]["convergence"]) {
+            auto& convergence = app_config_->core_config.convergence;
+            if (convergence_node["min_poll_interval_ms"]) {
+                convergence.min_poll_interval =
+                    std::chrono::milliseconds(convergence_node["min_poll_interval_ms"].as<int64_t>());
+            }
+            if (convergence_node["max_poll_interval_ms"]) {
+                convergence.max_poll_interval =
+                    std::chrono::milliseconds(convergence_node["max_poll_interval_ms"].as<int64_t>());
+            }
+            if (convergence_node["settle_time_ms"]) {
+                convergence.settle_time = std::chrono::milliseconds(convergence_node["settle_time_ms"].as<int64_t>());
+            }
+            if (convergence_node["max_wait_ms"]) {
+                convergence.max_wait = std::chrono::milliseconds(convergence_node["max_wait_ms"].as<int64_t>());
+            }
+        }
+
+        if (const auto& presets_node = app_node["core"]["presets"]) {
+            auto& presets = app_config_->core_config.presets;
+            if (presets_node["file"]) {
+                presets.file = presets_node["file"].as<std::string>();
+            }
+            if (presets_node["definitions"]) {
+                presets.definitions = presets_node["definitions"].as<std::vector<types::Preset>>();
+            }
+        }
+
+        if (const auto& scheduling_node = app_node["core"]["scheduling"]) {
+            auto& scheduling = app_config_->core_config.scheduling;
+            if (scheduling_node["resolution_us"]) {
+                scheduling.resolution = std::chrono::microseconds(scheduling_node["resolution_us"].as<int64_t>());
+            }
+            if (scheduling_node["prepare_lead_ms"]) {
+                scheduling.prepare_lead = std::chrono::milliseconds(scheduling_node["prepare_lead_ms"].as<int64_t>());
+            }
+            if (scheduling_node["max_lead_ms"]) {
+                scheduling.max_lead = std::chrono::milliseconds(scheduling_node["max_lead_ms"].as<int64_t>());
+            }
+        }
+
+        if (const auto& macros_node = app_node["core"]["macros"]) {
+            if (macros_node["definitions"]) {
+                app_config_->core_config.macros.definitions =
+                    macros_node["definitions"].as<std::vector<types::Macro>>();
+            }
+        }
+
+        if (const auto& leases_node = app_node["core"]["leases"]) {
+            auto& leases = app_config_->core_config.leases;
+            if (leases_node["default_ttl_ms"]) {
+                leases.default_ttl = std::chrono::milliseconds(leases_node["default_ttl_ms"].as<int64_t>());
+            }
+            if (leases_node["max_ttl_ms"]) {
+                leases.max_ttl = std::chrono::milliseconds(leases_node["max_ttl_ms"].as<int64_t>());
+            }
+        }
+
+        if (const auto& dispatch_node = app_node["core"]["dispatch"]) {
+            auto& dispatch = app_config_->core_config.dispatch;
+            if (dispatch_node["max_in_flight"]) {
+                dispatch.max_in_flight = dispatch_node["max_in_flight"].as<std::size_t>();
+            }
+            if (dispatch_node["max_queued"]) {
+                dispatch.max_queued = dispatch_node["max_queued"].as<std::size_t>();
+            }
+            if (dispatch_node["background_max_queued"]) {
+                dispatch.background_max_queued = dispatch_node["background_max_queued"].as<std::size_t>();
+            }
+            if (dispatch_node["max_callers"]) {
+                dispatch.max_callers = dispatch_node["max_callers"].as<std::size_t>();
+            }
+            if (const auto& weights_node = dispatch_node["caller_weights"]) {
+                for (const auto& weight : weights_node) {
+                    dispatch.caller_weights[weight.first.as<std::string>()] = weight.second.as<uint32_t>();
+                }
+            }
+            if (const auto& adaptive_node = dispatch_node["adaptive"]) {
+                auto& adaptive = dispatch.adaptive;
+                if (adaptive_node["enabled"]) {
+                    adaptive.enabled = adaptive_node["enabled"].as<bool>();
+                }
+                if (adaptive_node["min_limit"]) {
+                    adaptive.min_limit = adaptive_node["min_limit"].as<std::size_t>();
+                }
+                if (adaptive_node["max_limit"]) {
+                    adaptive.max_limit = adaptive_node["max_limit"].as<std::size_t>();
+                }
+                if (adaptive_node["tolerance"]) {
+                    adaptive.tolerance = adaptive_node["tolerance"].as<double>();
+                }
+                if (adaptive_node["smoothing"]) {
+                    adaptive.smoothing = adaptive_node["smoothing"].as<double>();
+                }
+                if (adaptive_node["queue_per_limit"]) {
+                    adaptive.queue_per_limit = adaptive_node["queue_per_limit"].as<std::size_t>();
+                }
+            }
+        }
+
+        if (const auto& idempotency_node = app_node["core"]["idempotency"]) {
+            auto& idempotency = app_config_->core_config.idempotency;
+            if (idempotency_node["ttl_ms"]) {
+                idempotency.ttl = std::chrono::milliseconds(idempotency_node["ttl_ms"].as<int64_t>());
+            }
+            if (idempotency_node["max_entries"]) {
+                idempotency.max_entries = idempotency_node["max_entries"].as<std::size_t>();
+            }
+        }
+
+        if (const auto& reconcile_node = app_node["core"]["reconcile"]) {
+            auto& reconcile = app_config_->core_config.reconcile;
+            if (reconcile_node["enabled"]) {
+                reconcile.enabled = reconcile_node["enabled"].as<bool>();
+            }
+            if (reconcile_node["check_interval_ms"]) {
+                reconcile.check_interval = std::chrono::milliseconds(reconcile_node["check_interval_ms"].as<int64_t>());
+            }
+            if (reconcile_node["settle_time_ms"]) {
+                reconcile.settle_time = std::chrono::milliseconds(reconcile_node["settle_time_ms"].as<int64_t>());
+            }
+            if (reconcile_node["connection_poll_ms"]) {
+                reconcile.connection_poll =
+                    std::chrono::milliseconds(reconcile_node["connection_poll_ms"].as<int64_t>());
+            }
+            if (reconcile_node["max_checks"]) {
+                reconcile.max_checks = reconcile_node["max_checks"].as<std::size_t>();
+            }
+            if (reconcile_node["history"]) {
+                reconcile.history = reconcile_node["history"].as<std::size_t>();
+            }
         }
     }
 
@@ -129,6 +612,29 @@ namespace service::common {
 
         const auto& infrastructure_node = app_node["infrastructure"];
 
+        if (const auto& warmup_node = infrastructure_node["warmup"]) {
+            auto& warmup = app_config_->infrastructure_config.warmup;
+            if (warmup_node["enabled"]) {
+                warmup.enabled = warmup_node["enabled"].as<bool>();
+            }
+            if (warmup_node["budget_ms"]) {
+                warmup.budget = std::chrono::milliseconds(warmup_node["budget_ms"].as<int64_t>());
+            }
+            if (warmup_node["min_ready_fraction"]) {
+                warmup.min_ready_fraction = warmup_node["min_ready_fraction"].as<double>();
+            }
+        }
+
+        if (const auto& resolver_node = infrastructure_node["resolver"]) {
+            auto& resolver = app_config_->infrastructure_config.resolver;
+            if (resolver_node["enabled"]) {
+                resolver.enabled = resolver_node["enabled"].as<bool>();
+            }
+            if (resolver_node["ttl_s"]) {
+                resolver.ttl = std::chrono::seconds(resolver_node["ttl_s"].as<int64_t>());
+            }
+        }
+
         if (!infrastructure_node["clients"]) {
             return;
         }
@@ -161,6 +667,9 @@ namespace service::common {
                     } else {
                         throw std::runtime_error("Service instance must have an 'address' field");
                     }
+                    if (instance_node["pinned_ip"]) {
+                        instance.pinned_ip = instance_node["pinned_ip"].as<std::string>();
+                    }
                     client_config.instances.emplace_back(instance);
                 }
             } else if (client_node["address"]) {
@@ -171,6 +680,50 @@ namespace service::common {
                 client_config.instances.emplace_back(instance);
             }
 
+            if (const auto& batching_node = client_node["batching"]) {
+                if (batching_node["enabled"]) {
+                    client_config.batching.enabled = batching_node["enabled"].as<bool>();
+                }
+                if (batching_node["window_us"]) {
+                    client_config.batching.window =
+                        std::chrono::microseconds(batching_node["window_us"].as<int64_t>());
+                }
+                if (batching_node["max_batch_size"]) {
+                    client_config.batching.max_batch_size = batching_node["max_batch_size"].as<std::size_t>();
+                }
+            }
+
+            if (const auto& admission_node = client_node["admission"]) {
+                const auto load = [&client_name](const YAML::Node& node, AdmissionLimit& limit) {
+                    if (!node) {
+                        return;
+                    }
+                    if (node["rate_hz"]) {
+                        limit.rate_hz = node["rate_hz"].as<double>();
+                    }
+                    if (node["burst"]) {
+                        limit.burst = node["burst"].as<uint32_t>();
+                    }
+                    if (node["on_limit"]) {
+                        const auto mode = node["on_limit"].as<std::string>();
+                        if (mode == "queue") {
+                            limit.on_limit = AdmissionMode::Queue;
+                        } else if (mode == "reject") {
+                            limit.on_limit = AdmissionMode::Reject;
+                        } else if (mode == "conflate") {
+                            limit.on_limit = AdmissionMode::Conflate;
+                        } else {
+                            throw std::runtime_error("Unknown admission mode of " + client_name + ": " + mode);
+                        }
+                    }
+                    if (node["max_wait_ms"]) {
+                        limit.max_wait = std::chrono::milliseconds(node["max_wait_ms"].as<int64_t>());
+                    }
+                };
+                load(admission_node["set"], client_config.admission.set);
+                load(admission_node["get"], client_config.admission.get);
+            }
+
             app_config_->infrastructure_config.clients.emplace(client_name, client_config);
         }
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -7,33 +8,225 @@
 #include <vector>
 #include <yaml-cpp/yaml.h>
 
+#include "common/types/Macro.h"
+#include "common/types/Preset.h"
+
 namespace service::common {
+    struct ControlStreamConfig {
+        uint32_t max_rate_hz{20}; // setpoints forwarded per stream per second, newer ones replace pending ones
+
+        void validate() const;
+    };
+
+    struct CallerQuota {
+        std::string caller; // x-client-id of the caller, or the host of its peer address, e.g. ipv4:10.0.0.5
+        double rate_hz{0}; // sustained calls per second, 0 = unlimited
+        uint32_t burst{20}; // calls allowed at once after the caller was idle
+
+        void validate() const;
+    };
+
+    struct QuotasConfig {
+        CallerQuota defaults; // quota of every caller not listed, its caller name is unused
+        std::vector<CallerQuota> callers;
+        std::size_t max_callers{256}; // callers with a bucket of their own, later ones share one
+        std::chrono::milliseconds idle_timeout{60000}; // buckets of callers idle this long are dropped
+
+        void validate() const;
+    };
+
     struct ApiConfig {
         std::string api;
         std::string server_address;
+        bool passthrough{false}; // relay camera calls to camera_service as raw bytes, idempotency keys are not honoured
+        ControlStreamConfig control_stream; // continuous zoom/focus control
+        QuotasConfig quotas; // request rate per caller, calls over it fail with RESOURCE_EXHAUSTED
+
+        void validate() const;
+    };
+
+    struct StateHubConfig {
+        std::chrono::milliseconds poll_min{100}; // poll interval of watched cameras right after a change
+        std::chrono::milliseconds poll_max{2000}; // poll interval backs off up to this while nothing changes
+        std::size_t queue_size{8}; // updates queued per subscriber before they are conflated
+        std::chrono::milliseconds max_wait{30000}; // conditional Gets hold the call at most this long for a change
+
+        void validate() const;
+    };
+
+    struct SnapshotConfig {
+        std::chrono::milliseconds camera_timeout{500}; // per-camera deadline, late sections are left empty
+        std::chrono::milliseconds static_ttl{60000}; // info and capabilities are served from cache this long, 0 = off
+        std::size_t max_readers{16}; // section reads running at once across all snapshot calls, later ones queue
+
+        void validate() const;
+    };
+
+    struct MotionConfig {
+        uint32_t tick_hz{20}; // backend commands per second of a moving zoom/focus axis
+        std::chrono::milliseconds max_duration{2000}; // velocity commands auto-stop after at most this long
+
+        void validate() const;
+    };
+
+    struct ConvergenceConfig {
+        std::chrono::milliseconds min_poll_interval{20}; // backend reads while the lens moves quickly
+        std::chrono::milliseconds max_poll_interval{250}; // backend reads while the lens is far from its target
+        std::chrono::milliseconds settle_time{200}; // a value unchanged this long counts as stopped
+        std::chrono::milliseconds max_wait{5000}; // SetAndWait timeout when unset, and its upper bound
+
+        void validate() const;
+    };
+
+    struct PresetsConfig {
+        std::string file; // runtime presets are persisted here, empty = kept in memory only
+        std::vector<types::Preset> definitions; // seed the store while the file does not exist yet
+
+        void validate() const;
+    };
+
+    struct MacrosConfig {
+        std::vector<types::Macro> definitions; // run by name through RunMacro
+
+        void validate() const;
+    };
+
+    struct SchedulingConfig {
+        std::chrono::microseconds resolution{1000}; // timer wheel tick, scheduled batches are armed at most this late
+        std::chrono::milliseconds prepare_lead{20}; // channels are warmed and lanes started this long before dispatch
+        std::chrono::milliseconds max_lead{60000}; // dispatch times further ahead are rejected
+
+        void validate() const;
+    };
+
+    struct LeasesConfig {
+        std::chrono::milliseconds default_ttl{10000}; // granted to AcquireControl/RenewControl calls that set none
+        std::chrono::milliseconds max_ttl{60000}; // longer requested lifetimes are capped
+
+        void validate() const;
+    };
+
+    struct AdaptiveConcurrencyConfig {
+        bool enabled{false}; // adapt the in-flight limit of each camera to its latency, starting at max_in_flight
+        std::size_t min_limit{1};
+        std::size_t max_limit{16};
+        double tolerance{1.5}; // latency up to this multiple of the no-load baseline does not lower the limit
+        double smoothing{0.2}; // weight of each sample in the limit, lower reacts slower but steadier
+        std::size_t queue_per_limit{4}; // calls waiting per allowed call, more are shed at once, not left to time out
+
+        void validate() const;
+    };
+
+    struct DispatchConfig {
+        std::size_t max_in_flight{0}; // backend calls per camera at once, later ones queue by priority, 0 = ungated
+        AdaptiveConcurrencyConfig adaptive; // moves the limit with the latency each camera answers in
+        std::size_t max_queued{64}; // calls waiting per camera, a full queue sheds its lowest class first
+        std::size_t background_max_queued{8}; // background calls waiting per camera, more are shed on arrival
+        std::unordered_map<std::string, uint32_t> caller_weights; // fair share of a caller in a busy queue, 1 if unset
+        std::size_t max_callers{256}; // callers with metrics of their own per camera, later ones are counted together
+
+        void validate() const;
+    };
+
+    struct IdempotencyConfig {
+        std::chrono::milliseconds ttl{60000}; // outcome of a keyed Set is replayed to retries this long, 0 = off
+        std::size_t max_entries{4096}; // keys remembered at once, the oldest completed ones are dropped first
+
+        void validate() const;
+    };
+
+    struct ReconcileConfig {
+        bool enabled{false}; // record the desired state of every camera and restore it after drift
+        std::chrono::milliseconds check_interval{10000}; // desired fields of a camera are read back this often
+        std::chrono::milliseconds settle_time{2000}; // a camera commanded more recently is not checked yet
+        std::chrono::milliseconds connection_poll{250}; // backend connections are watched for a reconnect this often
+        std::size_t max_checks{4}; // cameras read and restored at once, later ones of a round queue
+        std::size_t history{32}; // drift events kept for GetReconcileStatus
 
         void validate() const;
     };
 
     struct CoreConfig {
+        StateHubConfig state_hub; // shared camera state behind WatchCameraState
+        SnapshotConfig snapshot; // GetSystemSnapshot fan-out
+        MotionConfig motion; // server-side zoom/focus velocity loop
+        ConvergenceConfig convergence; // SetZoomAndWait/SetFocusAndWait polling
+        PresetsConfig presets; // named multi-camera settings applied by RecallPreset
+        SchedulingConfig scheduling; // batches dispatched at a requested time
+        MacrosConfig macros; // timed operation sequences run by sensor-core
+        LeasesConfig leases; // exclusive control of a camera by one client
+        DispatchConfig dispatch; // per-camera admission of backend calls by priority class
+        IdempotencyConfig idempotency; // retries of Set calls that carry an idempotency key
+        ReconcileConfig reconcile; // desired-state mode
+
         void validate() const;
     };
 
     struct ServiceInstance {
         uint32_t id;
         std::string address;
+        std::string pinned_ip; // optional static IPv4 used instead of resolving the address host
+
+        void validate() const;
+    };
+
+    struct BatchingConfig {
+        bool enabled{false};
+        std::chrono::microseconds window{500}; // collection window per host, at most 1 ms
+        std::size_t max_batch_size{16};
+
+        void validate() const;
+    };
+
+    enum class AdmissionMode {
+        Queue, // wait for a token up to max_wait, longer waits are rejected
+        Reject, // fail at once with RESOURCE_EXHAUSTED
+        Conflate // wait like queue, a newer command of the same kind replaces the waiting one
+    };
+
+    struct AdmissionLimit {
+        double rate_hz{0}; // commands per second to one instance, 0 = unlimited
+        uint32_t burst{5}; // commands allowed at once after the instance was idle
+        AdmissionMode on_limit{AdmissionMode::Queue};
+        std::chrono::milliseconds max_wait{200}; // longest a queued or conflated command waits for its token
+
+        void validate() const;
+    };
+
+    struct AdmissionConfig {
+        AdmissionLimit set; // commands that change the camera
+        AdmissionLimit get; // reads, conflation does not apply
 
         void validate() const;
     };
 
     struct ClientConfig {
         std::vector<ServiceInstance> instances; // multiple instances for load balancing/failover
+        BatchingConfig batching; // groups commands to instances sharing a host into one call
+        AdmissionConfig admission; // token-bucket rate limits per instance, protecting the backend
+
+        void validate() const;
+    };
+
+    struct WarmupConfig {
+        bool enabled{false};
+        std::chrono::milliseconds budget{3000}; // global deadline for all backend channels to connect
+        double min_ready_fraction{0.0}; // fraction of backends that must be ready before serving, 0 = don't wait
+
+        void validate() const;
+    };
+
+    struct ResolverConfig {
+        bool enabled{false};
+        std::chrono::seconds ttl{60}; // resolved addresses are refreshed in the background within this time
 
         void validate() const;
     };
 
     struct InfrastructureConfig {
         std::unordered_map<std::string, ClientConfig> clients; // service name -> ClientConfig
+        WarmupConfig warmup; // eager parallel connect of all backend channels at startup
+        ResolverConfig resolver; // cached host resolution, channels dial ipv4: targets and follow address changes
 
         void validate() const;
     };
@@ -63,6 +256,7 @@ namespace service::common {
         void loadFromFile(const std::filesystem::path& filename) const;
         void validateConfiguration() const;
         void loadApiConfig(const YAML::Node& app_node) const;
+        void loadCoreConfig(const YAML::Node& app_node) const;
         void loadInfrastructureConfig(const YAML::Node& app_node) const;
         void loadAppConfig(const YAML::Node& app_node) const;
 
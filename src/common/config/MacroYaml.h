@@ -0,0 +1,89 @@
+#pragma once
+
+#include <yaml-cpp/yaml.h>
+
+#include "common/types/Macro.h"
+
+/**
+ * yaml-cpp conversions of macros defined in config.yaml
+ * Each step is a map with a single key naming it, e.g. `set_zoom: 40`, `wait_ms: 250` or
+ * `repeat: {count: 10, steps: [...]}`
+ */
+namespace YAML {
+    template<>
+    struct convert<service::common::types::MacroStep> {
+        static bool decode(const Node& node, service::common::types::MacroStep& step) {
+            using service::common::types::MacroStepType;
+            using service::common::types::OperationType;
+            if (!node.IsMap() || node.size() != 1) {
+                return false;
+            }
+
+            const auto key = node.begin()->first.as<std::string>();
+            const auto& value = node.begin()->second;
+            const auto operation = [&step](const OperationType type) {
+                step.type = MacroStepType::Operation;
+                step.operation.type = type;
+            };
+
+            if (key == "set_zoom" || key == "set_focus") {
+                operation(key == "set_zoom" ? OperationType::SetZoom : OperationType::SetFocus);
+                step.operation.value = value.as<uint32_t>();
+            } else if (key == "go_to_min_zoom") {
+                operation(OperationType::GoToMinZoom);
+            } else if (key == "go_to_max_zoom") {
+                operation(OperationType::GoToMaxZoom);
+            } else if (key == "get_zoom") {
+                operation(OperationType::GetZoom);
+            } else if (key == "get_focus") {
+                operation(OperationType::GetFocus);
+            } else if (key == "set_auto_focus" || key == "set_stabilization") {
+                operation(key == "set_auto_focus" ? OperationType::SetAutoFocus : OperationType::SetStabilization);
+                step.operation.enable = value.as<bool>();
+            } else if (key == "set_video_capability") {
+                operation(OperationType::SetVideoCapabilityState);
+                step.operation.capability = value["capability"].as<std::string>();
+                step.operation.enable = value["enable"].as<bool>();
+            } else if (key == "zoom_step" || key == "focus_step") {
+                step.type = key == "zoom_step" ? MacroStepType::ZoomStep : MacroStepType::FocusStep;
+                step.delta = value.as<int32_t>();
+            } else if (key == "wait_ms") {
+                step.type = MacroStepType::Wait;
+                step.duration = std::chrono::milliseconds(value.as<uint32_t>());
+            } else if (key == "wait_us") {
+                step.type = MacroStepType::Wait;
+                step.duration = std::chrono::microseconds(value.as<uint64_t>());
+            } else if (key == "await_zoom" || key == "await_focus") {
+                step.type = key == "await_zoom" ? MacroStepType::AwaitZoom : MacroStepType::AwaitFocus;
+                if (value.IsMap()) {
+                    step.tolerance = value["tolerance"] ? value["tolerance"].as<uint32_t>() : 0;
+                    if (value["timeout_ms"]) {
+                        step.timeout = std::chrono::milliseconds(value["timeout_ms"].as<uint32_t>());
+                    }
+                }
+            } else if (key == "repeat") {
+                if (!value.IsMap() || !value["count"] || !value["steps"]) {
+                    return false;
+                }
+                step.type = MacroStepType::Repeat;
+                step.count = value["count"].as<uint32_t>();
+                step.steps = value["steps"].as<std::vector<service::common::types::MacroStep>>();
+            } else {
+                return false;
+            }
+            return true;
+        }
+    };
+
+    template<>
+    struct convert<service::common::types::Macro> {
+        static bool decode(const Node& node, service::common::types::Macro& macro) {
+            if (!node.IsMap() || !node["name"] || !node["steps"]) {
+                return false;
+            }
+            macro.name = node["name"].as<std::string>();
+            macro.steps = node["steps"].as<std::vector<service::common::types::MacroStep>>();
+            return true;
+        }
+    };
+} // namespace YAML
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <yaml-cpp/yaml.h>
+
+#include "common/types/Preset.h"
+
+/**
+ * yaml-cpp conversions of presets, shared by config.yaml and the preset file
+ */
+namespace YAML {
+    template<>
+    struct convert<service::common::types::CameraPreset> {
+        static Node encode(const service::common::types::CameraPreset& camera) {
+            Node node;
+            node["camera_id"] = camera.camera_id;
+            if (camera.state.zoom_level) {
+                node["zoom"] = *camera.state.zoom_level;
+            }
+            if (camera.state.focus_value) {
+                node["focus"] = *camera.state.focus_value;
+            }
+            if (camera.state.auto_focus) {
+                node["auto_focus"] = *camera.state.auto_focus;
+            }
+            if (camera.state.stabilization) {
+                node["stabilization"] = *camera.state.stabilization;
+            }
+            if (!camera.video_capabilities.empty()) {
+                node["video_capabilities"] = camera.video_capabilities;
+            }
+            return node;
+        }
+
+        static bool decode(const Node& node, service::common::types::CameraPreset& camera) {
+            if (!node.IsMap() || !node["camera_id"]) {
+                return false;
+            }
+            camera.camera_id = node["camera_id"].as<uint32_t>();
+            if (node["zoom"]) {
+                camera.state.zoom_level = node["zoom"].as<uint32_t>();
+            }
+            if (node["focus"]) {
+                camera.state.focus_value = node["focus"].as<uint32_t>();
+            }
+            if (node["auto_focus"]) {
+                camera.state.auto_focus = node["auto_focus"].as<bool>();
+            }
+            if (node["stabilization"]) {
+                camera.state.stabilization = node["stabilization"].as<bool>();
+            }
+            if (node["video_capabilities"]) {
+                camera.video_capabilities = node["video_capabilities"].as<std::map<std::string, bool>>();
+            }
+            return true;
+        }
+    };
+
+    template<>
+    struct convert<service::common::types::Preset> {
+        static Node encode(const service::common::types::Preset& preset) {
+            Node node;
+            node["name"] = preset.name;
+            node["cameras"] = preset.cameras;
+            return node;
+        }
+
+        static bool decode(const Node& node, service::common::types::Preset& preset) {
+            if (!node.IsMap() || !node["name"] || !node["cameras"]) {
+                return false;
+            }
+            preset.name = node["name"].as<std::string>();
+            preset.cameras = node["cameras"].as<std::vector<service::common::types::CameraPreset>>();
+            return true;
+        }
+    };
+} // namespace YAML
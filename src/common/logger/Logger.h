@@ -45,32 +45,32 @@ namespace service::common {
         }
 
         template <typename... Args>
-        void trace(const std::string& format_str, Args&&... args) const {
+        void trace(const std::string_view format_str, Args&&... args) const {
             log(LoggerInterface::LogLevel::Trace, format_str, std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        void debug(const std::string& format_str, Args&&... args) const {
+        void debug(const std::string_view format_str, Args&&... args) const {
             log(LoggerInterface::LogLevel::Debug, format_str, std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        void info(const std::string& format_str, Args&&... args) const {
+        void info(const std::string_view format_str, Args&&... args) const {
             log(LoggerInterface::LogLevel::Info, format_str, std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        void warn(const std::string& format_str, Args&&... args) const {
+        void warn(const std::string_view format_str, Args&&... args) const {
             log(LoggerInterface::LogLevel::Warn, format_str, std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        void error(const std::string& format_str, Args&&... args) const {
+        void error(const std::string_view format_str, Args&&... args) const {
             log(LoggerInterface::LogLevel::Error, format_str, std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        void critical(const std::string& format_str, Args&&... args) const {
+        void critical(const std::string_view format_str, Args&&... args) const {
             log(LoggerInterface::LogLevel::Critical, format_str, std::forward<Args>(args)...);
         }
 
@@ -79,12 +79,14 @@ namespace service::common {
         std::string scope_name_;
 
         template <typename... Args>
-        void log(LoggerInterface::LogLevel level, const std::string& format_str, Args&&... args) const {
-            if (!logger_impl_) {
+        void log(LoggerInterface::LogLevel level, const std::string_view format_str, Args&&... args) const {
+            if (!logger_impl_ || !logger_impl_->isEnabled(level)) {
                 return;
             }
 
-            const std::string prefixed_format = "[" + scope_name_ + "] " + format_str;
+            std::string prefixed_format;
+            prefixed_format.reserve(scope_name_.size() + 3 + format_str.size());
+            prefixed_format.append("[").append(scope_name_).append("] ").append(format_str);
             logger_impl_->log(level, prefixed_format, std::forward<Args>(args)...);
         }
     };
@@ -171,8 +173,12 @@ namespace service::common {
             return LogScope::App;
         }
 
-        inline ScopedLogger& loggerFor(const char* file) {
-            return LoggerRegistry::instance().getLogger(scopeFromFile(file));
+        /**
+         * Scope is resolved from the file at compile time, a log line does not search its path
+         */
+        template <LogScope Scope>
+        ScopedLogger& loggerFor() {
+            return LoggerRegistry::instance().getLogger(Scope);
         }
     } // namespace detail
 } // namespace service::common
@@ -183,9 +189,15 @@ namespace service::common {
 
 #define SET_LOG_LEVEL(level) service::common::LoggerRegistry::instance().setLogLevel((level))
 
-#define LOG_TRACE(...) service::common::detail::loggerFor(__FILE__).trace(__VA_ARGS__)
-#define LOG_DEBUG(...) service::common::detail::loggerFor(__FILE__).debug(__VA_ARGS__)
-#define LOG_INFO(...) service::common::detail::loggerFor(__FILE__).info(__VA_ARGS__)
-#define LOG_WARN(...) service::common::detail::loggerFor(__FILE__).warn(__VA_ARGS__)
-#define LOG_ERROR(...) service::common::detail::loggerFor(__FILE__).error(__VA_ARGS__)
-#define LOG_CRITICAL(...) service::common::detail::loggerFor(__FILE__).critical(__VA_ARGS__)
+#define LOG_TRACE(...) \
+    service::common::detail::loggerFor<service::common::detail::scopeFromFile(__FILE__)>().trace(__VA_ARGS__)
+#define LOG_DEBUG(...) \
+    service::common::detail::loggerFor<service::common::detail::scopeFromFile(__FILE__)>().debug(__VA_ARGS__)
+#define LOG_INFO(...) \
+    service::common::detail::loggerFor<service::common::detail::scopeFromFile(__FILE__)>().info(__VA_ARGS__)
+#define LOG_WARN(...) \
+    service::common::detail::loggerFor<service::common::detail::scopeFromFile(__FILE__)>().warn(__VA_ARGS__)
+#define LOG_ERROR(...) \
+    service::common::detail::loggerFor<service::common::detail::scopeFromFile(__FILE__)>().error(__VA_ARGS__)
+#define LOG_CRITICAL(...) \
+    service::common::detail::loggerFor<service::common::detail::scopeFromFile(__FILE__)>().critical(__VA_ARGS__)
@@ -19,6 +19,9 @@ public:
 
     template<typename... Args>
     void log(const LogLevel level, const std::string& format_str, Args&&... args) {
+        if (!isEnabled(level)) {
+            return;
+        }
         const std::string formatted_str = fmt::format(fmt::runtime(format_str), std::forward<Args>(args)...);
         logImpl(level, formatted_str);
     }
@@ -26,6 +29,13 @@ public:
     virtual void setLogLevel(LogLevel level) = 0;
     virtual void setLogLevel(const std::string& level) = 0;
 
+    /**
+     * @return whether messages of the level are written, the others are not even formatted
+     */
+    virtual bool isEnabled(LogLevel /*level*/) const {
+        return true;
+    }
+
 protected:
     virtual void logImpl(LogLevel level, const std::string &msg) = 0;
 };
\ No newline at end of file
@@ -45,6 +45,10 @@ public:
         }
     }
 
+    bool isEnabled(const LogLevel level) const override {
+        return logger_->should_log(toSpdLogLevel(level));
+    }
+
     void logImpl(const LogLevel level, const std::string &msg) override {
         logger_->log(toSpdLogLevel(level), msg);
     }
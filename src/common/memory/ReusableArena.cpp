@@ -0,0 +1,33 @@
+#include "ReusableArena.h"
+
+namespace service::common::memory {
+    namespace {
+        constexpr std::size_t THREAD_ARENA_BLOCK_SIZE = 1024;
+    } // unnamed namespace
+
+    ReusableArena::ReusableArena(const std::size_t block_size)
+        : block_(std::make_unique<char[]>(block_size)),
+          arena_(makeOptions(block_.get(), block_size)) {
+    }
+
+    google::protobuf::Arena* ReusableArena::get() {
+        return &arena_;
+    }
+
+    void ReusableArena::reset() {
+        arena_.Reset();
+    }
+
+    google::protobuf::ArenaOptions ReusableArena::makeOptions(char* block, const std::size_t block_size) {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = block;
+        options.initial_block_size = block_size;
+        return options;
+    }
+
+    ReusableArena& threadLocalArena() {
+        thread_local ReusableArena arena(THREAD_ARENA_BLOCK_SIZE);
+        arena.reset();
+        return arena;
+    }
+} // namespace service::common::memory
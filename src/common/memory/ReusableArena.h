@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <google/protobuf/arena.h>
+
+namespace service::common::memory {
+    /**
+     * Protobuf arena backed by an owned initial block that survives reset()
+     * Messages created on the arena are released in bulk by reset(), after which
+     * the block is reused without returning memory to the heap
+     */
+    class ReusableArena {
+    public:
+        /**
+         * @param block_size size of the initial block, larger messages spill into heap blocks
+         */
+        explicit ReusableArena(std::size_t block_size);
+
+        ReusableArena(const ReusableArena&) = delete;
+        ReusableArena& operator=(const ReusableArena&) = delete;
+
+        google::protobuf::Arena* get();
+
+        /**
+         * Destroy all messages created on the arena and keep the initial block for reuse
+         */
+        void reset();
+
+        template<typename T>
+        T* create() {
+            return google::protobuf::Arena::CreateMessage<T>(&arena_);
+        }
+
+    private:
+        static google::protobuf::ArenaOptions makeOptions(char* block, std::size_t block_size);
+
+        std::unique_ptr<char[]> block_;
+        google::protobuf::Arena arena_;
+    };
+
+    /**
+     * Per-thread arena for the messages of a blocking backend call
+     * The arena is reset on every call, so messages of a previous call must no longer be in use
+     * @return arena of the calling thread, emptied
+     */
+    ReusableArena& threadLocalArena();
+} // namespace service::common::memory
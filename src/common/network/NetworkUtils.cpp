@@ -5,6 +5,7 @@
 #include <arpa/inet.h>
 #include <ifaddrs.h>
 #include <net/if.h>
+#include <netdb.h>
 #include <netinet/in.h>
 
 #include "common/logger/Logger.h"
@@ -119,5 +120,42 @@ namespace service::common::network {
 
         return Result<std::string>::error("Interface " + interface_name + " not found");
     }
-} // namespace service::common::network
 
+    Result<std::string> resolveIpv4Address(const std::string& host) {
+        if (host.empty()) {
+            return Result<std::string>::error("Host name cannot be empty");
+        }
+
+        struct addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+
+        struct addrinfo* addresses = nullptr;
+        if (const int status = ::getaddrinfo(host.c_str(), nullptr, &hints, &addresses); status != 0) {
+            return Result<std::string>::error("Failed to resolve " + host + ": " + ::gai_strerror(status));
+        }
+
+        std::string ip_address;
+        for (const struct addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+            const auto* addr = reinterpret_cast<const struct sockaddr_in*>(address->ai_addr);
+            char ip_str[INET_ADDRSTRLEN];
+            if (::inet_ntop(AF_INET, &addr->sin_addr, ip_str, INET_ADDRSTRLEN) != nullptr) {
+                ip_address = ip_str;
+                break;
+            }
+        }
+
+        ::freeaddrinfo(addresses);
+
+        if (ip_address.empty()) {
+            return Result<std::string>::error("No IPv4 address found for " + host);
+        }
+
+        return Result<std::string>::success(ip_address);
+    }
+
+    bool isIpv4Address(const std::string& address) {
+        struct in_addr addr{};
+        return ::inet_pton(AF_INET, address.c_str(), &addr) == 1;
+    }
+} // namespace service::common::network
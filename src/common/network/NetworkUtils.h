@@ -35,5 +35,19 @@ namespace service::common::network {
      * @return Result containing IP address string or error message
      */
     Result<std::string> getIpAddress(const std::string& interface_name);
+
+    /**
+     * Resolve a host name to its first IPv4 address (blocking)
+     * @param host Host name or IPv4 literal (e.g., "camera.local")
+     * @return Result containing IP address string or error message
+     */
+    Result<std::string> resolveIpv4Address(const std::string& host);
+
+    /**
+     * Check whether a string is a dotted-quad IPv4 address
+     * @param address String to check (e.g., "192.168.1.10")
+     * @return true if address is a valid IPv4 literal
+     */
+    bool isIpv4Address(const std::string& address);
 } // namespace service::common::network
 
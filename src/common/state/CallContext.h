@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "common/types/Priority.h"
+
+namespace service::common::state {
+    /**
+     * What the transport knows about the call running on the current thread
+     * Set for the duration of a call, work a call hands to other threads carries it along
+     */
+    struct CallContext {
+        static constexpr uint64_t NO_LEASE = 0;
+
+        uint64_t lease_id{NO_LEASE}; // control lease presented by the call
+        types::Priority priority{types::Priority::Normal};
+        std::string caller; // identity of the client, calls are queued fairly and rate limited per caller
+        std::string idempotency_key; // names one Set call of the caller across its retries, empty if unset
+        std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()}; // max if none
+
+        /**
+         * @return context of the call on this thread, the defaults outside of one
+         */
+        static const CallContext& current();
+
+        class Scope;
+    };
+
+    /**
+     * Make a context current on this thread until the scope ends
+     */
+    class CallContext::Scope {
+    public:
+        explicit Scope(const CallContext& context);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const CallContext previous_;
+    };
+
+    namespace detail {
+        inline thread_local CallContext current_call;
+    } // namespace detail
+
+    inline const CallContext& CallContext::current() {
+        return detail::current_call;
+    }
+
+    inline CallContext::Scope::Scope(const CallContext& context) : previous_(detail::current_call) {
+        detail::current_call = context;
+    }
+
+    inline CallContext::Scope::~Scope() {
+        detail::current_call = previous_;
+    }
+} // namespace service::common::state
@@ -0,0 +1,98 @@
+#include "CameraStateSubscription.h"
+
+#include <algorithm>
+
+namespace service::common::state {
+    CameraStateSubscription::CameraStateSubscription(const uint32_t camera_id,
+                                                     const types::CameraStateFields fields,
+                                                     const std::size_t capacity)
+        : camera_id_(camera_id), fields_(fields), capacity_(std::max<std::size_t>(capacity, 1)) {
+    }
+
+    void CameraStateSubscription::setListener(Listener listener) {
+        {
+            std::lock_guard lock(listener_mutex_);
+            listener_ = std::move(listener);
+        }
+        notify();
+    }
+
+    std::optional<types::CameraStateUpdate> CameraStateSubscription::poll() {
+        std::lock_guard lock(mutex_);
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        auto update = std::move(queue_.front());
+        queue_.pop_front();
+        return update;
+    }
+
+    void CameraStateSubscription::cancel() {
+        {
+            std::lock_guard lock(mutex_);
+            closed_ = true;
+            queue_.clear();
+        }
+        // Waits for a listener invocation in progress on another thread
+        std::lock_guard lock(listener_mutex_);
+        listener_ = nullptr;
+    }
+
+    bool CameraStateSubscription::isClosed() const {
+        std::lock_guard lock(mutex_);
+        return closed_;
+    }
+
+    uint32_t CameraStateSubscription::cameraId() const {
+        return camera_id_;
+    }
+
+    types::CameraStateFields CameraStateSubscription::fields() const {
+        return fields_;
+    }
+
+    void CameraStateSubscription::push(const types::CameraState& state, const bool snapshot) {
+        const auto watched = state.masked(fields_);
+        if (watched.empty() && !snapshot) {
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_) {
+                return;
+            }
+            if (queue_.size() < capacity_) {
+                queue_.push_back({watched, snapshot});
+            } else {
+                queue_.back().state.merge(watched);
+            }
+        }
+        notify();
+    }
+
+    void CameraStateSubscription::close() {
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_) {
+                return;
+            }
+            closed_ = true;
+        }
+        notify();
+    }
+
+    void CameraStateSubscription::notify() {
+        std::lock_guard lock(listener_mutex_);
+        if (!listener_) {
+            return;
+        }
+        {
+            std::lock_guard state_lock(mutex_);
+            if (queue_.empty() && !closed_) {
+                return;
+            }
+        }
+        listener_();
+    }
+} // namespace service::common::state
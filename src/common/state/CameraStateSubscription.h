@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include "common/types/CameraState.h"
+
+namespace service::common::state {
+    /**
+     * One subscriber's view of a camera state hub
+     * Updates are kept in a bounded queue; once it is full new deltas are conflated into the newest
+     * queued update, so a slow reader receives the latest state instead of an ever growing backlog
+     */
+    class CameraStateSubscription {
+    public:
+        using Listener = std::function<void()>;
+
+        /**
+         * @param camera_id watched camera
+         * @param fields watched fields, deltas touching no watched field are dropped
+         * @param capacity maximum number of queued updates before conflation
+         */
+        CameraStateSubscription(uint32_t camera_id, types::CameraStateFields fields, std::size_t capacity);
+
+        CameraStateSubscription(const CameraStateSubscription&) = delete;
+        CameraStateSubscription& operator=(const CameraStateSubscription&) = delete;
+
+        /**
+         * Set the callback invoked whenever an update is queued or the subscription is closed
+         * Invoked once immediately if updates are already pending
+         */
+        void setListener(Listener listener);
+
+        /**
+         * @return the oldest queued update, std::nullopt if none is pending
+         */
+        std::optional<types::CameraStateUpdate> poll();
+
+        /**
+         * Stop receiving updates, the listener is not invoked after this returns
+         */
+        void cancel();
+
+        /**
+         * @return true once cancelled or closed by the hub
+         */
+        bool isClosed() const;
+
+        uint32_t cameraId() const;
+        types::CameraStateFields fields() const;
+
+        /**
+         * Queue an update, called by the publisher
+         * @param state changed fields, or the full state for a snapshot
+         * @param snapshot first update of the subscription
+         */
+        void push(const types::CameraState& state, bool snapshot);
+
+        /**
+         * End the subscription from the publisher side, the listener sees isClosed() afterwards
+         */
+        void close();
+
+    private:
+        void notify();
+
+        const uint32_t camera_id_;
+        const types::CameraStateFields fields_;
+        const std::size_t capacity_;
+
+        mutable std::mutex mutex_;
+        std::deque<types::CameraStateUpdate> queue_;
+        bool closed_{false};
+
+        std::mutex listener_mutex_;
+        Listener listener_;
+    };
+} // namespace service::common::state
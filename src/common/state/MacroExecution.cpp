@@ -0,0 +1,103 @@
+#include "MacroExecution.h"
+
+namespace service::common::state {
+    MacroExecution::MacroExecution(const uint32_t camera_id, std::string name)
+        : camera_id_(camera_id), name_(std::move(name)) {
+    }
+
+    void MacroExecution::setListener(Listener listener) {
+        {
+            std::lock_guard lock(listener_mutex_);
+            listener_ = std::move(listener);
+        }
+        notify();
+    }
+
+    std::optional<types::MacroProgress> MacroExecution::poll() {
+        std::lock_guard lock(mutex_);
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        auto progress = std::move(queue_.front());
+        queue_.pop_front();
+        return progress;
+    }
+
+    void MacroExecution::cancel() {
+        stop();
+        {
+            std::lock_guard lock(mutex_);
+            queue_.clear();
+        }
+        // Waits for a listener invocation in progress on another thread
+        std::lock_guard lock(listener_mutex_);
+        listener_ = nullptr;
+    }
+
+    bool MacroExecution::isClosed() const {
+        std::lock_guard lock(mutex_);
+        return closed_;
+    }
+
+    uint32_t MacroExecution::cameraId() const {
+        return camera_id_;
+    }
+
+    const std::string& MacroExecution::name() const {
+        return name_;
+    }
+
+    void MacroExecution::stop() {
+        {
+            std::lock_guard lock(mutex_);
+            stopped_ = true;
+        }
+        stop_cv_.notify_all();
+    }
+
+    bool MacroExecution::stopRequested() const {
+        std::lock_guard lock(mutex_);
+        return stopped_;
+    }
+
+    bool MacroExecution::waitForStop(const Clock::time_point until) const {
+        std::unique_lock lock(mutex_);
+        return stop_cv_.wait_until(lock, until, [this] { return stopped_; });
+    }
+
+    void MacroExecution::push(types::MacroProgress progress) {
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_) {
+                return;
+            }
+            queue_.push_back(std::move(progress));
+        }
+        notify();
+    }
+
+    void MacroExecution::close() {
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_) {
+                return;
+            }
+            closed_ = true;
+        }
+        notify();
+    }
+
+    void MacroExecution::notify() {
+        std::lock_guard lock(listener_mutex_);
+        if (!listener_) {
+            return;
+        }
+        {
+            std::lock_guard state_lock(mutex_);
+            if (queue_.empty() && !closed_) {
+                return;
+            }
+        }
+        listener_();
+    }
+} // namespace service::common::state
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "common/types/Macro.h"
+
+namespace service::common::state {
+    /**
+     * One running macro as seen by its caller and by the thread running it
+     * The runner queues a progress report per step and a final one, the caller drains them and can stop the
+     * run. Reports are never conflated, a macro produces a bounded number of them at the pace of its steps
+     */
+    class MacroExecution {
+    public:
+        using Listener = std::function<void()>;
+        using Clock = std::chrono::steady_clock;
+
+        MacroExecution(uint32_t camera_id, std::string name);
+
+        MacroExecution(const MacroExecution&) = delete;
+        MacroExecution& operator=(const MacroExecution&) = delete;
+
+        /**
+         * Set the callback invoked whenever a report is queued or the run ends
+         * Invoked once immediately if reports are already pending
+         */
+        void setListener(Listener listener);
+
+        /**
+         * @return the oldest queued report, std::nullopt if none is pending
+         */
+        std::optional<types::MacroProgress> poll();
+
+        /**
+         * Stop the run and stop listening, the listener is not invoked after this returns
+         */
+        void cancel();
+
+        /**
+         * @return true once the final report was queued
+         */
+        bool isClosed() const;
+
+        uint32_t cameraId() const;
+        const std::string& name() const;
+
+        /**
+         * Ask the runner to stop, it reports the run as cancelled at its next step
+         */
+        void stop();
+
+        bool stopRequested() const;
+
+        /**
+         * Block until stop() is called or until passes
+         * @return true if the run was stopped
+         */
+        bool waitForStop(Clock::time_point until) const;
+
+        /**
+         * Queue a report, called by the runner
+         */
+        void push(types::MacroProgress progress);
+
+        /**
+         * Mark the run as ended after its final report, called by the runner
+         */
+        void close();
+
+    private:
+        void notify();
+
+        const uint32_t camera_id_;
+        const std::string name_;
+
+        mutable std::mutex mutex_;
+        mutable std::condition_variable stop_cv_;
+        std::deque<types::MacroProgress> queue_;
+        bool stopped_{false};
+        bool closed_{false};
+
+        std::mutex listener_mutex_;
+        Listener listener_;
+    };
+} // namespace service::common::state
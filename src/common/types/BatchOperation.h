@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "common/types/CameraCapabilities.h"
+#include "common/types/CameraTypes.h"
+#include "common/types/Result.h"
+
+namespace service::common::types {
+    enum class OperationType {
+        SetZoom,
+        GetZoom,
+        GoToMinZoom,
+        GoToMaxZoom,
+        SetFocus,
+        GetFocus,
+        SetAutoFocus,
+        GetAutoFocus,
+        GetInfo,
+        GetCapabilities,
+        SetStabilization,
+        GetStabilization,
+        SetVideoCapabilityState,
+        GetVideoCapabilities,
+        GetVideoCapabilityState
+    };
+
+    /**
+     * One operation of a batch, only the arguments used by its type are read
+     */
+    struct Operation {
+        OperationType type;
+        uint32_t camera_id{0};
+        uint32_t value{0};      // zoom or focus of SetZoom/SetFocus
+        bool enable{false};     // SetAutoFocus, SetStabilization, SetVideoCapabilityState
+        std::string capability; // video capability name
+    };
+
+    enum class BatchOrdering {
+        PerCamera,  // cameras in parallel, request order within a camera
+        Sequential, // one operation at a time in request order
+        Parallel    // every operation concurrently
+    };
+
+    using OperationValue = std::variant<std::monostate,
+                                        uint32_t,                     // zoom, focus, applied by Set/GoTo
+                                        bool,                         // auto focus, stabilization, video state
+                                        info,                         // device info
+                                        capabilities::CapabilityList, // camera capabilities
+                                        std::vector<std::string>>;    // video capabilities
+
+    using OperationResult = Result<OperationValue>;
+} // namespace service::common::types
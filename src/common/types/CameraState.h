@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "common/types/CameraTypes.h"
+
+namespace service::common::types {
+    enum class CameraStateField : uint8_t {
+        Zoom = 1 << 0,
+        Focus = 1 << 1,
+        AutoFocus = 1 << 2,
+        Stabilization = 1 << 3
+    };
+
+    using CameraStateFields = uint8_t; // bitwise OR of CameraStateField values
+
+    inline constexpr CameraStateFields ALL_CAMERA_STATE_FIELDS = 0x0F;
+
+    constexpr bool hasField(const CameraStateFields fields, const CameraStateField field) {
+        return (fields & static_cast<CameraStateFields>(field)) != 0;
+    }
+
+    /**
+     * Observed state of one camera. Unset fields are unknown (in a full state) or unchanged (in a delta).
+     */
+    struct CameraState {
+        std::optional<zoom> zoom_level;
+        std::optional<focus> focus_value;
+        std::optional<bool> auto_focus;
+        std::optional<bool> stabilization;
+
+        bool empty() const {
+            return !zoom_level && !focus_value && !auto_focus && !stabilization;
+        }
+
+        /**
+         * Overwrite the fields set in delta
+         */
+        void merge(const CameraState& delta) {
+            if (delta.zoom_level) { zoom_level = delta.zoom_level; }
+            if (delta.focus_value) { focus_value = delta.focus_value; }
+            if (delta.auto_focus) { auto_focus = delta.auto_focus; }
+            if (delta.stabilization) { stabilization = delta.stabilization; }
+        }
+
+        /**
+         * @return fields that are set
+         */
+        CameraStateFields fields() const {
+            CameraStateFields result = 0;
+            if (zoom_level) { result |= static_cast<CameraStateFields>(CameraStateField::Zoom); }
+            if (focus_value) { result |= static_cast<CameraStateFields>(CameraStateField::Focus); }
+            if (auto_focus) { result |= static_cast<CameraStateFields>(CameraStateField::AutoFocus); }
+            if (stabilization) { result |= static_cast<CameraStateFields>(CameraStateField::Stabilization); }
+            return result;
+        }
+
+        /**
+         * @param fields fields to keep
+         * @return copy with every other field unset
+         */
+        CameraState masked(const CameraStateFields fields) const {
+            CameraState result;
+            if (hasField(fields, CameraStateField::Zoom)) { result.zoom_level = zoom_level; }
+            if (hasField(fields, CameraStateField::Focus)) { result.focus_value = focus_value; }
+            if (hasField(fields, CameraStateField::AutoFocus)) { result.auto_focus = auto_focus; }
+            if (hasField(fields, CameraStateField::Stabilization)) { result.stabilization = stabilization; }
+            return result;
+        }
+
+        /**
+         * @param observed newly observed state
+         * @return fields of observed that are set and differ from this state
+         */
+        CameraState changesIn(const CameraState& observed) const {
+            CameraState result;
+            if (observed.zoom_level && observed.zoom_level != zoom_level) {
+                result.zoom_level = observed.zoom_level;
+            }
+            if (observed.focus_value && observed.focus_value != focus_value) {
+                result.focus_value = observed.focus_value;
+            }
+            if (observed.auto_focus && observed.auto_focus != auto_focus) {
+                result.auto_focus = observed.auto_focus;
+            }
+            if (observed.stabilization && observed.stabilization != stabilization) {
+                result.stabilization = observed.stabilization;
+            }
+            return result;
+        }
+
+        bool operator==(const CameraState&) const = default;
+    };
+
+    struct CameraStateUpdate {
+        CameraState state;
+        bool snapshot{false}; // full state of the watched fields rather than a delta
+    };
+} // namespace service::common::types
@@ -23,4 +23,7 @@ namespace service::common::types {
         focus min;
         focus max;
     };
+
+    inline constexpr ZoomRange NORMALIZED_ZOOM_RANGE{.min = MIN_NORMALIZED_ZOOM, .max = MAX_NORMALIZED_ZOOM};
+    inline constexpr FocusRange NORMALIZED_FOCUS_RANGE{.min = MIN_NORMALIZED_FOCUS, .max = MAX_NORMALIZED_FOCUS};
 } // namespace service::common::types
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "common/types/Error.h"
+
+namespace service::common::types {
+    /**
+     * @return error of a call refused because another client holds the lease, the API reports it as
+     *         FAILED_PRECONDITION on the decoded and the passthrough path alike
+     */
+    inline Error controlledByAnotherClient(const uint32_t camera_id) {
+        return {ErrorCode::ControlledByAnotherClient,
+                "Camera " + std::to_string(camera_id) + " is controlled by another client"};
+    }
+
+    /**
+     * Exclusive control of one camera granted to one client
+     */
+    struct ControlLease {
+        uint32_t camera_id{0};
+        uint64_t lease_id{0};             // presented by the holder on its mutating calls
+        std::chrono::milliseconds ttl{0}; // the lease expires this long after it was granted unless renewed
+    };
+} // namespace service::common::types
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace service::common::types {
+    enum class ConvergenceStatus {
+        Reached,  // within tolerance of the target
+        Settled,  // stopped changing away from the target, e.g. at a hardware limit
+        TimedOut  // still moving when the wait ended
+    };
+
+    /**
+     * Where an axis ended up after a Set command and how long it took to get there
+     */
+    struct Convergence {
+        uint32_t value{0};
+        std::chrono::milliseconds elapsed{0};
+        ConvergenceStatus status{ConvergenceStatus::Reached};
+    };
+} // namespace service::common::types
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/types/Priority.h"
+
+namespace service::common::types {
+    // Callers past the tables' caps share one entry, reported under this name
+    constexpr std::string_view OTHER_CALLERS = "(other)";
+
+    /**
+     * Distribution of durations, percentiles are the upper bound of their histogram bucket
+     */
+    struct LatencySummary {
+        uint64_t count{0};
+        std::chrono::microseconds p50{0};
+        std::chrono::microseconds p99{0};
+        std::chrono::microseconds max{0};
+    };
+
+    /**
+     * Backend calls of one priority class across every camera since Core started
+     */
+    struct PriorityClassMetrics {
+        Priority priority{Priority::Normal};
+        uint64_t admitted{0};
+        uint64_t shed{0};           // rejected on arrival or evicted from the queue by a higher class
+        LatencySummary queue_wait;  // arrival until admission
+        LatencySummary latency;     // arrival until the backend call returned
+    };
+
+    /**
+     * Calls of one caller across every camera since Core started
+     */
+    struct CallerMetrics {
+        std::string caller;
+        uint64_t admitted{0};
+        uint64_t shed{0};
+        uint64_t throttled{0};     // rejected by the caller's request rate quota before reaching Core
+        LatencySummary queue_wait; // arrival until admission
+    };
+
+    /**
+     * Concurrency of the calls to one camera right now, the limit moves with latency when it is adaptive
+     */
+    struct CameraConcurrencyMetrics {
+        uint32_t camera_id{0};
+        std::size_t limit{0};              // calls allowed at once
+        std::size_t in_flight{0};
+        std::size_t queued{0};
+        bool adaptive{false};
+        uint64_t increases{0};             // times the limit went up since Core started
+        uint64_t decreases{0};
+        std::chrono::microseconds baseline{0}; // no-load latency the adaptive limit is kept near
+        std::chrono::microseconds latency{0};  // smoothed latency of recent calls
+    };
+
+    /**
+     * Readiness of the backend channels warmed up at startup, as it is now
+     */
+    struct WarmupMetrics {
+        bool enabled{false};
+        std::size_t ready{0};  // channels connected
+        std::size_t total{0};
+        bool complete{false};  // every channel connected or ran out of budget
+    };
+
+    struct DispatchMetrics {
+        std::array<PriorityClassMetrics, PRIORITY_COUNT> classes; // indexed by Priority
+        std::vector<CallerMetrics> callers;                       // by caller name
+        std::vector<CameraConcurrencyMetrics> cameras;            // by camera_id
+        WarmupMetrics warmup;
+    };
+} // namespace service::common::types
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+namespace service::common::types {
+    /**
+     * What went wrong, the API picks the status of a failed call by it, never by the message
+     */
+    enum class ErrorCode {
+        Internal,                  // any failure without a code of its own
+        ControlledByAnotherClient, // another client holds the control lease of the camera
+        CallShed,                  // the dispatcher shed the call under load
+        AdmissionRejected,         // backend admission control refused the command
+        DeadlineExceeded           // the call ran out of time waiting for another one
+    };
+
+    /**
+     * Error of a failed Result, the message is for humans and may be reworded freely
+     */
+    struct Error {
+        ErrorCode code{ErrorCode::Internal};
+        std::string message;
+
+        Error() = default;
+
+        // Plain messages convert implicitly so that Result<T>::error("...") stays an Internal error
+        Error(std::string message) : message(std::move(message)) {}
+        Error(const char* message) : message(message) {}
+
+        Error(const ErrorCode code, std::string message) : code(code), message(std::move(message)) {}
+
+        /**
+         * @return the same error with its message prefixed, e.g. by the operation of a batch it failed in
+         */
+        Error prefixed(const std::string& prefix) const {
+            return {code, prefix + message};
+        }
+    };
+} // namespace service::common::types
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/types/BatchOperation.h"
+
+namespace service::common::types {
+    enum class MacroStepType {
+        Operation,  // one operation on the camera of the macro
+        ZoomStep,   // relative zoom move
+        FocusStep,  // relative focus move
+        Wait,       // pause
+        AwaitZoom,  // block until the zoom converges on the last zoom applied by the macro
+        AwaitFocus, // block until the focus converges on the last focus applied by the macro
+        Repeat      // run a nested sequence several times
+    };
+
+    /**
+     * One step of a macro, only the fields used by its type are read
+     */
+    struct MacroStep {
+        MacroStepType type{MacroStepType::Wait};
+        Operation operation{};                 // Operation, its camera_id is replaced by the macro's camera
+        int32_t delta{0};                      // ZoomStep, FocusStep
+        std::chrono::microseconds duration{0}; // Wait
+        uint32_t tolerance{0};                 // AwaitZoom, AwaitFocus
+        std::chrono::milliseconds timeout{0};  // AwaitZoom, AwaitFocus; 0 = the convergence maximum wait
+        uint32_t count{0};                     // Repeat
+        std::vector<MacroStep> steps;          // Repeat body
+    };
+
+    /**
+     * Sequence of steps run by sensor-core on one camera without client round trips
+     */
+    struct Macro {
+        std::string name;
+        std::vector<MacroStep> steps;
+
+        /**
+         * @return why the macro cannot run, empty when it is valid
+         */
+        std::string invalidReason() const {
+            if (steps.empty()) {
+                return "Macro " + name + " has no steps";
+            }
+            return invalidSteps(steps, 1);
+        }
+
+    private:
+        static constexpr std::size_t MAX_DEPTH = 8; // nested repeats
+
+        std::string invalidSteps(const std::vector<MacroStep>& sequence, const std::size_t depth) const {
+            for (const auto& step : sequence) {
+                if (step.type != MacroStepType::Repeat) {
+                    continue;
+                }
+                if (depth >= MAX_DEPTH) {
+                    return "Macro " + name + " nests repeats deeper than " + std::to_string(MAX_DEPTH);
+                }
+                if (step.count == 0 || step.steps.empty()) {
+                    return "Macro " + name + " has a repeat without a count or steps";
+                }
+                if (auto reason = invalidSteps(step.steps, depth + 1); !reason.empty()) {
+                    return reason;
+                }
+            }
+            return {};
+        }
+    };
+
+    enum class MacroStatus {
+        Running,   // a step finished, more follow
+        Completed, // every step ran
+        Failed,    // a step failed, the rest was skipped
+        Cancelled  // stopped before its end
+    };
+
+    /**
+     * Report of a finished step, or the final report of a run
+     */
+    struct MacroProgress {
+        MacroStatus status{MacroStatus::Running};
+        uint64_t sequence{0};            // steps executed so far, repeated steps count every time
+        std::vector<uint32_t> path;      // index of the step in the macro, then in each enclosing repeat
+        std::vector<uint32_t> iterations; // iteration of each enclosing repeat, from 0
+        std::chrono::microseconds elapsed{0}; // since the macro started
+        std::optional<uint32_t> value;   // zoom or focus after the step, if it has one
+        std::string error;               // with Failed
+    };
+} // namespace service::common::types
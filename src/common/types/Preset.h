@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/types/CameraState.h"
+#include "common/types/CameraTypes.h"
+
+namespace service::common::types {
+    /**
+     * Settings of one camera in a preset, unset fields are left as they are on recall
+     */
+    struct CameraPreset {
+        uint32_t camera_id{0};
+        CameraState state;
+        std::map<std::string, bool> video_capabilities; // capability name -> enable
+
+        bool operator==(const CameraPreset&) const = default;
+    };
+
+    /**
+     * Named set of camera settings applied together by RecallPreset
+     */
+    struct Preset {
+        std::string name;
+        std::vector<CameraPreset> cameras;
+
+        /**
+         * @return why the preset cannot be stored, empty when it is valid
+         */
+        std::string invalidReason() const {
+            if (name.empty()) {
+                return "Preset name cannot be empty";
+            }
+            if (cameras.empty()) {
+                return "Preset " + name + " has no cameras";
+            }
+            std::set<uint32_t> camera_ids;
+            for (const auto& camera : cameras) {
+                const auto prefix = "Preset " + name + " camera " + std::to_string(camera.camera_id);
+                if (!camera_ids.insert(camera.camera_id).second) {
+                    return prefix + " is listed more than once";
+                }
+                if (camera.state.empty() && camera.video_capabilities.empty()) {
+                    return prefix + " has no settings";
+                }
+                if (camera.state.zoom_level && *camera.state.zoom_level > MAX_NORMALIZED_ZOOM) {
+                    return prefix + " zoom is out of range";
+                }
+                if (camera.state.focus_value && *camera.state.focus_value > MAX_NORMALIZED_FOCUS) {
+                    return prefix + " focus is out of range";
+                }
+                if (camera.state.focus_value && camera.state.auto_focus.value_or(false)) {
+                    return prefix + " sets focus with auto focus on";
+                }
+            }
+            return {};
+        }
+
+        bool operator==(const Preset&) const = default;
+    };
+
+    /**
+     * Outcome of a preset recall, settings already in place are skipped rather than sent again
+     */
+    struct PresetRecall {
+        std::chrono::milliseconds elapsed{0};
+        uint32_t applied{0};
+        uint32_t skipped{0};
+        std::vector<std::string> errors; // one entry per setting or camera that could not be applied
+    };
+} // namespace service::common::types
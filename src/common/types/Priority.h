@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace service::common::types {
+    /**
+     * Scheduling class of a call, a camera serves waiting calls of a higher class first
+     */
+    enum class Priority : uint8_t {
+        Interactive, // operator commands
+        Normal,      // default for calls that set none
+        Background   // telemetry polls, shed first under load
+    };
+
+    constexpr std::size_t PRIORITY_COUNT = 3;
+
+    constexpr const char* toString(const Priority priority) {
+        switch (priority) {
+        case Priority::Interactive:
+            return "interactive";
+        case Priority::Normal:
+            return "normal";
+        case Priority::Background:
+            return "background";
+        }
+        return "unknown";
+    }
+} // namespace service::common::types
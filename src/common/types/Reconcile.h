@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/types/CameraState.h"
+#include "common/types/DispatchMetrics.h"
+
+namespace service::common::types {
+    /**
+     * State a camera is meant to be in, the values its last successful commands applied
+     */
+    struct DesiredState {
+        CameraState state;
+        std::map<std::string, bool> video; // video capability states by name
+
+        bool empty() const {
+            return state.empty() && video.empty();
+        }
+    };
+
+    enum class DriftCause : uint8_t {
+        Reconnect, // found when the backend connection came back
+        Check      // found by a periodic read of the desired fields
+    };
+
+    /**
+     * A camera found away from its desired state, and how restoring it went
+     */
+    struct DriftEvent {
+        uint32_t camera_id{0};
+        DriftCause cause{DriftCause::Check};
+        std::chrono::system_clock::time_point detected;
+        DesiredState drifted; // desired values of the fields found different
+        bool restored{false};
+        std::string error; // first failed re-apply, empty when restored
+    };
+
+    struct CameraReconcileMetrics {
+        uint32_t camera_id{0};
+        DesiredState desired;
+        uint64_t checks{0};   // reads compared with the desired state
+        uint64_t drifts{0};   // checks that found a difference
+        uint64_t restored{0}; // drifts whose re-apply succeeded
+    };
+
+    struct ReconcileMetrics {
+        bool enabled{false};
+        std::vector<CameraReconcileMetrics> cameras; // ascending camera_id, cameras with a desired state
+        std::vector<DriftEvent> recent_drifts;       // oldest first
+        LatencySummary latency;                      // drift detected until the camera was restored
+    };
+} // namespace service::common::types
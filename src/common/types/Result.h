@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "common/logger/Logger.h"
+#include "common/types/Error.h"
 
 // Helper type for void Results
 struct Empty {};
@@ -17,7 +18,7 @@ struct Success {
     explicit Success(T v) : value(std::move(v)) {}
 };
 
-template<typename T, typename E = std::string>
+template<typename T, typename E = service::common::types::Error>
 class [[nodiscard]] Result {
 public:
     // Success constructor - for non-void types, using Success wrapper to avoid ambiguity
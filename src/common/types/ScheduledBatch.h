@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "common/types/BatchOperation.h"
+
+namespace service::common::types {
+    enum class ScheduleClock {
+        Monotonic, // CLOCK_MONOTONIC of the sensor-core host
+        Realtime   // CLOCK_REALTIME, for clients on other hosts sharing a synchronized clock
+    };
+
+    /**
+     * Point in time at which a batch is dispatched, counted from the epoch of clock
+     */
+    struct ExecuteAt {
+        ScheduleClock clock{ScheduleClock::Monotonic};
+        std::chrono::nanoseconds time{0};
+    };
+
+    /**
+     * How far from the requested time the first operation of a camera was sent, positive is late
+     */
+    struct CameraDispatch {
+        uint32_t camera_id{0};
+        std::chrono::microseconds skew{0};
+    };
+
+    struct ScheduledBatch {
+        std::vector<OperationResult> results;    // in operation order
+        std::vector<CameraDispatch> dispatches; // one per camera, in order of first appearance
+    };
+} // namespace service::common::types
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <variant>
+
+#include "common/types/CameraState.h"
+
+namespace service::common::types {
+    using Generation = uint64_t; // bumped on every observed change of a field, 0 = never observed
+
+    using StateField = std::variant<CameraStateField, std::string>; // camera field or video capability name
+
+    using StateValue = std::variant<uint32_t, bool>; // zoom/focus or an enable state
+
+    /**
+     * Value of a field with the generation it was observed at, no value when it is not modified
+     */
+    struct VersionedValue {
+        std::optional<StateValue> value;
+        Generation generation{0};
+    };
+
+    /**
+     * Conditional read of a field, without if_generation_not the value is always returned
+     */
+    struct ReadCondition {
+        std::optional<Generation> if_generation_not; // skip the value while the field is at this generation
+        std::chrono::milliseconds wait{0}; // hold the read up to this long for the generation to move
+    };
+} // namespace service::common::types
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/types/CameraCapabilities.h"
+#include "common/types/CameraState.h"
+#include "common/types/CameraTypes.h"
+
+namespace service::common::types {
+    /**
+     * Sections of a camera snapshot, the state sections share their bits with CameraStateField
+     */
+    enum class SnapshotField : uint8_t {
+        Zoom = static_cast<uint8_t>(CameraStateField::Zoom),
+        Focus = static_cast<uint8_t>(CameraStateField::Focus),
+        AutoFocus = static_cast<uint8_t>(CameraStateField::AutoFocus),
+        Stabilization = static_cast<uint8_t>(CameraStateField::Stabilization),
+        Capabilities = 1 << 4,
+        Info = 1 << 5,
+        VideoCapabilities = 1 << 6
+    };
+
+    using SnapshotFields = uint8_t; // bitwise OR of SnapshotField values
+
+    inline constexpr SnapshotFields ALL_SNAPSHOT_FIELDS = 0x7F;
+
+    constexpr bool hasField(const SnapshotFields fields, const SnapshotField field) {
+        return (fields & static_cast<SnapshotFields>(field)) != 0;
+    }
+
+    struct VideoCapabilityState {
+        std::string capability;
+        bool enable{false};
+    };
+
+    /**
+     * Everything known about one camera, unset sections were not requested or could not be read in time
+     */
+    struct CameraSnapshot {
+        uint32_t camera_id{0};
+        CameraState state;
+        std::optional<capabilities::CapabilityList> capabilities;
+        std::optional<info> device_info;
+        std::optional<std::vector<VideoCapabilityState>> video_capabilities;
+        std::vector<std::string> errors; // one entry per section that failed or missed the deadline
+    };
+} // namespace service::common::types
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "common/async/Task.h"
+#include "common/state/CallContext.h"
+#include "common/types/CameraState.h"
+#include "common/types/Result.h"
+
+namespace service::core {
+    /**
+     * What a successful backend call tells about the camera
+     */
+    enum class StateEffect : uint8_t {
+        None, // nothing, e.g. device info
+        Observed, // the camera is in that state
+        Commanded // the camera was set to that state, it also becomes the state to keep it in
+    };
+
+    /**
+     * Compile-time description of one call Core makes on a backend client, Core runs all of them on one generic path
+     * The state value is the result, or the last argument of a call without one. Video calls key it by their first
+     * argument, the capability
+     */
+    template<typename Client, typename T, typename... Args>
+    struct BackendOperation {
+        using ClientType = Client;
+        using Value = T;
+
+        std::string_view name; // names the operation in errors
+        Result<T> (Client::*send)(Args...);
+        StateEffect effect{StateEffect::None};
+        common::types::CameraStateField field{}; // camera state read or set, unused by video calls
+        bool stops_motion{false}; // a command first stops a running motion of the field's axis
+        // Takes the context of the call, the thread that awaits it may have resumed with another one
+        common::async::Task<Result<T>> (Client::*send_async)(common::state::CallContext, Args...){nullptr};
+    };
+
+    /**
+     * Result of the operation a BackendOperation constant describes
+     */
+    template<const auto& Operation>
+    using BackendResult = Result<typename std::remove_cvref_t<decltype(Operation)>::Value>;
+} // namespace service::core
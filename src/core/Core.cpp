@@ -1,12 +1,394 @@
 #include "Core.h"
 
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "api/proto/camera_service.grpc.pb.h"
 #include "common/logger/Logger.h"
+#include "common/state/CallContext.h"
+#include "core/idempotency/IdempotencyTable.h"
+#include "core/lease/LeaseTable.h"
+#include "core/preset/PresetStore.h"
+#include "core/reconcile/Reconciler.h"
+#include "core/schedule/PreciseWait.h"
+#include "core/state/CameraStateHub.h"
+#include "infrastructure/clients/CameraPassthroughClient.h"
 #include "infrastructure/clients/GrpcClientManager.h"
 #include "infrastructure/clients/ICameraServiceClient.h"
+#include "infrastructure/clients/IVideoServiceClient.h"
 
 namespace service::core {
-    Core::Core(const common::InfrastructureConfig& infrastructure_config)
-        : infrastructure_config_(infrastructure_config), is_running_(false) {
+    namespace {
+        // Upper bound on concurrently executing lanes of one batch
+        constexpr std::size_t MAX_BATCH_LANES = 16;
+
+        // Motion ticks follow an operator's velocity command, hub refreshes are telemetry that gives way to calls
+        const common::state::CallContext MOTION_TICK_CALL{.priority = common::types::Priority::Interactive,
+                                                          .caller = "sensor-core:motion"};
+        const common::state::CallContext STATE_REFRESH_CALL{.priority = common::types::Priority::Background,
+                                                            .caller = "sensor-core:state-hub"};
+        // Drift checks are telemetry too, restoring a drifted camera is ordinary control
+        const common::state::CallContext RECONCILE_CHECK_CALL{.priority = common::types::Priority::Background,
+                                                              .caller = "sensor-core:reconcile"};
+        const common::state::CallContext RECONCILE_CALL{.priority = common::types::Priority::Normal,
+                                                        .caller = "sensor-core:reconcile"};
+
+        template<typename T>
+        common::types::OperationResult toOperationResult(Result<T> result) {
+            if (result.isError()) {
+                return common::types::OperationResult::error(result.error());
+            }
+            if constexpr (std::is_void_v<T>) {
+                return common::types::OperationResult::success(common::types::OperationValue{});
+            } else {
+                return common::types::OperationResult::success(
+                    common::types::OperationValue{std::move(result).value()});
+            }
+        }
+
+        template<typename T>
+        Result<T> fromOperationResult(common::types::OperationResult result) {
+            if (result.isError()) {
+                return Result<T>::error(std::move(result).error());
+            }
+            if constexpr (std::is_void_v<T>) {
+                return Result<T>::success();
+            } else {
+                return Result<T>::success(std::get<T>(std::move(result).value()));
+            }
+        }
+
+        template<typename T>
+        common::async::Task<common::types::OperationResult> toOperationResult(common::async::Task<Result<T>> task) {
+            co_return toOperationResult(co_await std::move(task));
+        }
+
+        /**
+         * @return context of the current call for the operations it runs, without its idempotency key
+         * The key names the call itself, the operations of a batch or macro are not looked up by it
+         */
+        common::state::CallContext delegatedCall() {
+            auto call = common::state::CallContext::current();
+            call.idempotency_key.clear();
+            return call;
+        }
+
+        /**
+         * Task that runs work on the thread awaiting it and ends with it
+         */
+        common::async::Task<bool> runInline(const std::function<void()> work) {
+            work();
+            co_return true;
+        }
+
+        using common::types::CameraStateField;
+        using infrastructure::ICameraServiceClient;
+        using infrastructure::IVideoServiceClient;
+
+        // Backend calls run on the generic path of call() and command()
+        constexpr BackendOperation SET_ZOOM{.name = "setZoom",
+                                           .send = &ICameraServiceClient::setZoom,
+                                           .effect = StateEffect::Commanded,
+                                           .field = CameraStateField::Zoom,
+                                           .stops_motion = true,
+                                           .send_async = &ICameraServiceClient::setZoomAsync};
+        constexpr BackendOperation GET_ZOOM{.name = "getZoom",
+                                           .send = &ICameraServiceClient::getZoom,
+                                           .effect = StateEffect::Observed,
+                                           .field = CameraStateField::Zoom};
+        constexpr BackendOperation GO_TO_MIN_ZOOM{.name = "goToMinZoom",
+                                                 .send = &ICameraServiceClient::goToMinZoom,
+                                                 .effect = StateEffect::Commanded,
+                                                 .field = CameraStateField::Zoom,
+                                                 .stops_motion = true};
+        constexpr BackendOperation GO_TO_MAX_ZOOM{.name = "goToMaxZoom",
+                                                 .send = &ICameraServiceClient::goToMaxZoom,
+                                                 .effect = StateEffect::Commanded,
+                                                 .field = CameraStateField::Zoom,
+                                                 .stops_motion = true};
+        constexpr BackendOperation SET_FOCUS{.name = "setFocus",
+                                            .send = &ICameraServiceClient::setFocus,
+                                            .effect = StateEffect::Commanded,
+                                            .field = CameraStateField::Focus,
+                                            .stops_motion = true,
+                                            .send_async = &ICameraServiceClient::setFocusAsync};
+        constexpr BackendOperation GET_FOCUS{.name = "getFocus",
+                                            .send = &ICameraServiceClient::getFocus,
+                                            .effect = StateEffect::Observed,
+                                            .field = CameraStateField::Focus};
+        constexpr BackendOperation ENABLE_AUTO_FOCUS{.name = "enableAutoFocus",
+                                                    .send = &ICameraServiceClient::enableAutoFocus,
+                                                    .effect = StateEffect::Commanded,
+                                                    .field = CameraStateField::AutoFocus};
+        constexpr BackendOperation GET_AUTO_FOCUS{.name = "getAutoFocus",
+                                                 .send = &ICameraServiceClient::getAutoFocus,
+                                                 .effect = StateEffect::Observed,
+                                                 .field = CameraStateField::AutoFocus};
+        constexpr BackendOperation GET_INFO{.name = "getInfo", .send = &ICameraServiceClient::getInfo};
+        constexpr BackendOperation STABILIZE{.name = "stabilize",
+                                            .send = &ICameraServiceClient::stabilize,
+                                            .effect = StateEffect::Commanded,
+                                            .field = CameraStateField::Stabilization};
+        constexpr BackendOperation GET_STABILIZATION{.name = "getStabilization",
+                                                    .send = &ICameraServiceClient::getStabilization,
+                                                    .effect = StateEffect::Observed,
+                                                    .field = CameraStateField::Stabilization};
+        constexpr BackendOperation GET_CAPABILITIES{.name = "getCapabilities",
+                                                   .send = &ICameraServiceClient::getCapabilities};
+        constexpr BackendOperation SET_VIDEO_CAPABILITY_STATE{.name = "SetVideoCapabilityState",
+                                                             .send = &IVideoServiceClient::SetVideoCapabilityState,
+                                                             .effect = StateEffect::Commanded};
+        constexpr BackendOperation GET_VIDEO_CAPABILITIES{.name = "getVideoCapabilities",
+                                                         .send = &IVideoServiceClient::getVideoCapabilities};
+        constexpr BackendOperation GET_VIDEO_CAPABILITY_STATE{.name = "getVideoCapabilityState",
+                                                             .send = &IVideoServiceClient::getVideoCapabilityState,
+                                                             .effect = StateEffect::Observed};
+
+        /**
+         * @return camera state with only the field set
+         */
+        template<typename V>
+        common::types::CameraState stateOf(const CameraStateField field, const V& value) {
+            common::types::CameraState state;
+            switch (field) {
+                case CameraStateField::Zoom:
+                    state.zoom_level = static_cast<common::types::zoom>(value);
+                    break;
+                case CameraStateField::Focus:
+                    state.focus_value = static_cast<common::types::focus>(value);
+                    break;
+                case CameraStateField::AutoFocus:
+                    state.auto_focus = static_cast<bool>(value);
+                    break;
+                case CameraStateField::Stabilization:
+                    state.stabilization = static_cast<bool>(value);
+                    break;
+            }
+            return state;
+        }
+
+        /**
+         * Parse a serialized camera_service message, the buffer itself is left for the client
+         */
+        template<typename Message>
+        Message parsed(const grpc::ByteBuffer& buffer) {
+            grpc::ByteBuffer copy(buffer);
+            Message message;
+            if (!grpc::SerializationTraits<Message>::Deserialize(&copy, &message).ok()) {
+                throw std::runtime_error("Malformed camera_service message");
+            }
+            return message;
+        }
+
+        /**
+         * @return state a passed through command left the camera in, unset for calls that change none
+         * The applied value comes from the backend response as for the decoded methods
+         */
+        std::optional<common::types::CameraState> passthroughState(const infrastructure::RawCall& call) {
+            if (call.method == "SetZoom") {
+                const auto response = parsed<camera::v1::SetZoomResponse>(*call.response);
+                return stateOf(CameraStateField::Zoom, response.has_zoom()
+                                                           ? response.zoom()
+                                                           : parsed<camera::v1::SetZoomRequest>(*call.request).zoom());
+            }
+            if (call.method == "GoToMinZoom") {
+                const auto response = parsed<camera::v1::GoToMinZoomResponse>(*call.response);
+                return stateOf(CameraStateField::Zoom,
+                               response.has_zoom() ? response.zoom() : common::types::MIN_NORMALIZED_ZOOM);
+            }
+            if (call.method == "GoToMaxZoom") {
+                const auto response = parsed<camera::v1::GoToMaxZoomResponse>(*call.response);
+                return stateOf(CameraStateField::Zoom,
+                               response.has_zoom() ? response.zoom() : common::types::MAX_NORMALIZED_ZOOM);
+            }
+            if (call.method == "SetFocus") {
+                const auto response = parsed<camera::v1::SetFocusResponse>(*call.response);
+                return stateOf(CameraStateField::Focus,
+                               response.has_focus() ? response.focus()
+                                                    : parsed<camera::v1::SetFocusRequest>(*call.request).focus());
+            }
+            if (call.method == "SetAutoFocus") {
+                return stateOf(CameraStateField::AutoFocus,
+                               parsed<camera::v1::SetAutoFocusRequest>(*call.request).enable());
+            }
+            if (call.method == "SetStabilization") {
+                return stateOf(CameraStateField::Stabilization,
+                               parsed<camera::v1::SetStabilizationRequest>(*call.request).enable());
+            }
+            return std::nullopt;
+        }
+
+        constexpr MotionScheduler::Axis axisOf(const CameraStateField field) {
+            return field == CameraStateField::Focus ? MotionScheduler::Axis::Focus : MotionScheduler::Axis::Zoom;
+        }
+
+        /**
+         * @return axis whose motion a passthrough command stops like its decoded operation, none for other methods
+         */
+        std::optional<MotionScheduler::Axis> stoppedAxis(const std::string& method) {
+            if (method == "SetZoom" || method == "GoToMinZoom" || method == "GoToMaxZoom") {
+                return MotionScheduler::Axis::Zoom;
+            }
+            if (method == "SetFocus") {
+                return MotionScheduler::Axis::Focus;
+            }
+            return std::nullopt;
+        }
+
+        template<typename Client>
+        std::string unavailable(const uint32_t camera_id) {
+            const std::string service = std::is_same_v<Client, IVideoServiceClient> ? "video_service"
+                                                                                     : "camera_service";
+            return service + " client for instance " + std::to_string(camera_id) + " is not available";
+        }
+
+        constexpr common::types::SnapshotField SNAPSHOT_FIELDS[] = {
+            common::types::SnapshotField::Zoom,
+            common::types::SnapshotField::Focus,
+            common::types::SnapshotField::AutoFocus,
+            common::types::SnapshotField::Stabilization,
+            common::types::SnapshotField::Capabilities,
+            common::types::SnapshotField::Info,
+            common::types::SnapshotField::VideoCapabilities
+        };
+
+        const char* toString(const common::types::SnapshotField field) {
+            switch (field) {
+            case common::types::SnapshotField::Zoom:
+                return "zoom";
+            case common::types::SnapshotField::Focus:
+                return "focus";
+            case common::types::SnapshotField::AutoFocus:
+                return "auto_focus";
+            case common::types::SnapshotField::Stabilization:
+                return "stabilization";
+            case common::types::SnapshotField::Capabilities:
+                return "capabilities";
+            case common::types::SnapshotField::Info:
+                return "info";
+            case common::types::SnapshotField::VideoCapabilities:
+                return "video_capabilities";
+            }
+            return "unknown";
+        }
+
+        uint32_t stepped(const uint32_t current, const int32_t delta, const uint32_t min, const uint32_t max) {
+            return static_cast<uint32_t>(std::clamp<int64_t>(static_cast<int64_t>(current) + delta, min, max));
+        }
+
+        /**
+         * Sections of one camera filled in by concurrent readers, shared so late readers outlive the request
+         */
+        struct PendingSnapshot {
+            std::mutex mutex;
+            common::types::CameraSnapshot snapshot;
+            common::types::SnapshotFields missing{0}; // sections still being read
+            std::function<void(bool)> done;           // ends the wait for the camera, cleared once called
+        };
+
+        /**
+         * End the wait for a camera, only the first of its last reader and its deadline does
+         * @param lock held on the mutex of pending, released before the waiting snapshot goes on
+         */
+        void endWait(PendingSnapshot& pending, std::unique_lock<std::mutex> lock) {
+            auto done = std::exchange(pending.done, nullptr);
+            lock.unlock();
+            if (done) {
+                done(true);
+            }
+        }
+
+        /**
+         * Move the sections set in part into target
+         */
+        void mergeSections(common::types::CameraSnapshot& target, common::types::CameraSnapshot&& part) {
+            target.state.merge(part.state);
+            if (part.capabilities) {
+                target.capabilities = std::move(part.capabilities);
+            }
+            if (part.device_info) {
+                target.device_info = std::move(part.device_info);
+            }
+            if (part.video_capabilities) {
+                target.video_capabilities = std::move(part.video_capabilities);
+            }
+        }
+
+        /**
+         * @return name of the setting a preset operation applies
+         */
+        std::string settingName(const common::types::Operation& operation) {
+            switch (operation.type) {
+            case common::types::OperationType::SetZoom:
+                return "zoom";
+            case common::types::OperationType::SetFocus:
+                return "focus";
+            case common::types::OperationType::SetAutoFocus:
+                return "auto_focus";
+            case common::types::OperationType::SetStabilization:
+                return "stabilization";
+            default:
+                return operation.capability;
+            }
+        }
+
+        /**
+         * Convert a dispatch time to the steady clock, which is CLOCK_MONOTONIC on Linux
+         */
+        CommandScheduler::Clock::time_point toSteady(const common::types::ExecuteAt& execute_at) {
+            using Clock = CommandScheduler::Clock;
+            if (execute_at.clock == common::types::ScheduleClock::Monotonic) {
+                return Clock::time_point(std::chrono::duration_cast<Clock::duration>(execute_at.time));
+            }
+            const auto realtime = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(execute_at.time));
+            return Clock::now() + (realtime - std::chrono::system_clock::now());
+        }
+
+        /**
+         * Split a batch into lanes, operations of one lane run in order and lanes run concurrently
+         */
+        std::vector<std::vector<std::size_t>> toLanes(const std::vector<common::types::Operation>& operations,
+                                                      const common::types::BatchOrdering ordering) {
+            std::vector<std::vector<std::size_t>> lanes;
+            if (ordering == common::types::BatchOrdering::Sequential) {
+                lanes.emplace_back();
+                for (std::size_t index = 0; index < operations.size(); ++index) {
+                    lanes.front().push_back(index);
+                }
+                return lanes;
+            }
+
+            std::unordered_map<uint32_t, std::size_t> camera_lanes;
+            for (std::size_t index = 0; index < operations.size(); ++index) {
+                std::size_t lane = 0;
+                if (ordering == common::types::BatchOrdering::Parallel) {
+                    lane = index % MAX_BATCH_LANES;
+                } else {
+                    // Cameras beyond the lane limit share lanes, order within a camera still holds
+                    const auto [it, inserted] = camera_lanes.try_emplace(
+                        operations[index].camera_id, camera_lanes.size() % MAX_BATCH_LANES);
+                    lane = it->second;
+                }
+                if (lane >= lanes.size()) {
+                    lanes.resize(lane + 1);
+                }
+                lanes[lane].push_back(index);
+            }
+            return lanes;
+        }
+    } // unnamed namespace
+
+    Core::Core(const common::InfrastructureConfig& infrastructure_config, const common::CoreConfig& core_config)
+        : core_config_(core_config), infrastructure_config_(infrastructure_config),
+          info_cache_(core_config.snapshot.static_ttl), capabilities_cache_(core_config.snapshot.static_ttl),
+          video_capabilities_cache_(core_config.snapshot.static_ttl), is_running_(false) {
     }
 
     Core::~Core() {
@@ -23,10 +405,53 @@ namespace service::core {
         }
 
         try {
+            // The clients time each camera_service call for the adaptive limit of its camera
+            dispatcher_ = std::make_unique<CameraDispatcher>(configuredCameraIds(), core_config_.dispatch);
+            // Asynchronous commands past a backend admission limit await their token on it
+            command_scheduler_ = std::make_unique<CommandScheduler>(core_config_.scheduling.resolution);
+
             // Initialize gRPC client manager
-            client_manager_ = std::make_unique<infrastructure::GrpcClientManager>(infrastructure_config_);
+            client_manager_ = std::make_unique<infrastructure::GrpcClientManager>(
+                infrastructure_config_,
+                [this](const uint32_t camera_id, const std::chrono::microseconds round_trip) {
+                    dispatcher_->sample(camera_id, round_trip);
+                },
+                [this](const CommandScheduler::Clock::time_point due, std::function<void(bool fired)> wake) {
+                    command_scheduler_->schedule(due, std::move(wake));
+                });
             client_manager_->initialize();
 
+            state_hub_ = std::make_unique<CameraStateHub>(core_config_.state_hub, [this](const uint32_t camera_id) {
+                common::state::CallContext::Scope scope(STATE_REFRESH_CALL);
+                return readCameraState(camera_id);
+            });
+            preset_store_ = std::make_unique<PresetStore>(core_config_.presets);
+            lanes_pool_ = std::make_unique<WorkerPool>(MAX_BATCH_LANES);
+            snapshot_readers_ = std::make_unique<WorkerPool>(core_config_.snapshot.max_readers);
+            lease_table_ = std::make_unique<LeaseTable>(configuredCameraIds(), core_config_.leases,
+                                                        *command_scheduler_);
+            if (core_config_.idempotency.ttl > std::chrono::milliseconds::zero()) {
+                idempotency_table_ = std::make_unique<IdempotencyTable>(core_config_.idempotency, *command_scheduler_);
+            }
+            if (core_config_.reconcile.enabled) {
+                reconciler_ = std::make_unique<Reconciler>(core_config_.reconcile, Reconciler::Actions{
+                    .read = [this](const uint32_t camera_id, const common::types::DesiredState& desired) {
+                        common::state::CallContext::Scope scope(RECONCILE_CHECK_CALL);
+                        return readDesired(camera_id, desired);
+                    },
+                    .apply = [this](const uint32_t camera_id, const std::vector<common::types::Operation>& operations) {
+                        // A restore acts for whoever holds the camera, it repeats commands made before or under
+                        // the lease and never one of another client
+                        auto call = RECONCILE_CALL;
+                        call.lease_id = lease_table_->holder(camera_id);
+                        common::state::CallContext::Scope scope(call);
+                        return executeBatch(operations, common::types::BatchOrdering::Sequential);
+                    },
+                    .connected = [this](const uint32_t camera_id) {
+                        return client_manager_->isCameraConnected(camera_id);
+                    }});
+            }
+
             is_running_ = true;
             LOG_DEBUG("Core started successfully");
             return Result<void>::success();
@@ -43,10 +468,45 @@ namespace service::core {
         LOG_DEBUG("Stopping Core...");
 
         try {
+            // Restores command the cameras through everything below
+            reconciler_.reset();
+
+            // Batches still waiting for their dispatch time fail instead of running, timers set from here on fail
+            // at once. The leases and idempotency keys it serves stay in place for the commands still running
+            command_scheduler_->stop();
+
+            // Macros command the camera and await on the convergence watchers
+            {
+                std::lock_guard lock(macro_mutex_);
+                macro_runners_.clear();
+            }
+            lanes_pool_.reset();
+
+            // Waiters, motion and the hub command the clients, stop them first
+            {
+                std::lock_guard lock(convergence_mutex_);
+                convergence_watchers_.clear();
+            }
+            {
+                std::lock_guard lock(motion_mutex_);
+                motion_schedulers_.clear();
+            }
+            state_hub_.reset();
+
+            // Snapshot readers that missed their deadline and long-polled reads still use the clients, no hub wait
+            // queues more of them now
+            snapshot_readers_.reset();
+
+            // Every thread that issues commands is joined, nothing checks a lease or a key anymore
+            idempotency_table_.reset();
+            lease_table_.reset();
             if (client_manager_) {
                 client_manager_->shutdown();
                 client_manager_.reset();
             }
+            // The admission limiters of the clients held on to it
+            command_scheduler_.reset();
+            dispatcher_.reset();
             is_running_ = false;
             LOG_DEBUG("Core stopped successfully");
             return Result<void>::success();
@@ -59,254 +519,1388 @@ namespace service::core {
         return is_running_;
     }
 
-    Result<void> Core::setZoom(uint32_t camera_id, const common::types::zoom zoom_level) const {
+    template<typename T>
+    Result<T> Core::idempotent(const common::types::Operation& operation,
+                               const std::function<Result<T>()>& run) const {
+        const auto& call = common::state::CallContext::current();
+        if (call.idempotency_key.empty() || !idempotency_table_) {
+            return run();
+        }
+        return fromOperationResult<T>(
+            idempotency_table_->run(call.caller, call.idempotency_key, operation, call.deadline, [&run] {
+                return toOperationResult(run());
+            }));
+    }
+
+    template<typename T>
+    common::async::Task<Result<T>> Core::idempotentAsync(const common::types::Operation operation,
+                                                         common::async::Task<Result<T>> run) const {
+        // Read before the first suspension, the context is only current up to there
+        const auto call = common::state::CallContext::current();
+        if (call.idempotency_key.empty() || !idempotency_table_) {
+            co_return co_await std::move(run);
+        }
+        co_return fromOperationResult<T>(co_await idempotency_table_->runAsync(
+            call.caller, call.idempotency_key, operation, call.deadline, toOperationResult(std::move(run))));
+    }
+
+    template<typename Client>
+    Client* Core::clientOf(uint32_t camera_id) const {
+        if constexpr (std::is_same_v<Client, infrastructure::IVideoServiceClient>) {
+            return client_manager_->getVideoServiceClient(camera_id);
+        } else {
+            return client_manager_->getCameraServiceClient(camera_id);
+        }
+    }
+
+    template<const auto& Operation, typename... Args>
+    BackendResult<Operation> Core::call(uint32_t camera_id, const Args&... args) const {
+        using Client = typename std::remove_cvref_t<decltype(Operation)>::ClientType;
         if (!isRunning()) {
-            return Result<void>::error("Core is not initialized");
+            return BackendResult<Operation>::error("Core is not initialized");
         }
 
         try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
+            auto* client = clientOf<Client>(camera_id);
             if (!client) {
-                return Result<void>::error("camera_service client for instance " + std::to_string(camera_id) +
-                                          " is not available");
+                return BackendResult<Operation>::error(unavailable<Client>(camera_id));
             }
 
-            return client->setZoom(zoom_level);
+            const auto ticket = admit(camera_id);
+            if (!ticket.admitted()) {
+                return BackendResult<Operation>::error(ticket.error());
+            }
+            auto result = (client->*Operation.send)(args...);
+            if (result.isSuccess()) {
+                record<Operation>(camera_id, result, args...);
+            }
+            return result;
         } catch (const std::exception& e) {
-            return Result<void>::error(std::string("setZoom failed: ") + e.what());
+            return BackendResult<Operation>::error(std::string(Operation.name) + " failed: " + e.what());
         }
     }
 
-    Result<common::types::zoom> Core::getZoom(uint32_t camera_id) const {
+    template<const auto& Operation, typename... Args>
+    BackendResult<Operation> Core::command(uint32_t camera_id, const Args&... args) const {
         if (!isRunning()) {
-            return Result<common::types::zoom>::error("Core is not initialized");
+            return BackendResult<Operation>::error("Core is not initialized");
+        }
+        if (const auto control = checkControl(camera_id); control.isError()) {
+            return BackendResult<Operation>::error(control.error());
+        }
+        if constexpr (Operation.stops_motion) {
+            // Stopping waits for a motion tick, which needs a slot of its own
+            stopMotion(camera_id, axisOf(Operation.field));
+        }
+        return call<Operation>(camera_id, args...);
+    }
+
+    template<const auto& Operation, typename... Args>
+    common::async::Task<BackendResult<Operation>> Core::commandAsync(uint32_t camera_id, Args... args) const {
+        static_assert(Operation.send_async != nullptr, "the operation has no asynchronous client call");
+        using Client = typename std::remove_cvref_t<decltype(Operation)>::ClientType;
+        if (!isRunning()) {
+            co_return BackendResult<Operation>::error("Core is not initialized");
+        }
+        if (const auto control = checkControl(camera_id); control.isError()) {
+            co_return BackendResult<Operation>::error(control.error());
+        }
+        // The call context is only current up to the first suspension
+        const auto call = common::state::CallContext::current();
+        if constexpr (Operation.stops_motion) {
+            co_await common::async::fromCallback<bool>([&](auto complete) {
+                stopMotion(camera_id, axisOf(Operation.field), [complete] { complete(true); });
+            });
+            // The core may have stopped while the tick ended
+            if (!isRunning()) {
+                co_return BackendResult<Operation>::error("Core is not initialized");
+            }
         }
 
         try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
+            auto* client = clientOf<Client>(camera_id);
             if (!client) {
-                return Result<common::types::zoom>::error("camera_service client for instance " +
-                                                        std::to_string(camera_id) + " is not available");
+                co_return BackendResult<Operation>::error(unavailable<Client>(camera_id));
             }
 
-            return client->getZoom();
+            const auto ticket = co_await dispatcher_->admitAsync(camera_id, call, *command_scheduler_);
+            if (!ticket.admitted()) {
+                co_return BackendResult<Operation>::error(ticket.error());
+            }
+            auto result = co_await (client->*Operation.send_async)(call, args...);
+            if (result.isSuccess()) {
+                record<Operation>(camera_id, result, args...);
+            }
+            co_return result;
         } catch (const std::exception& e) {
-            return Result<common::types::zoom>::error(std::string("getZoom failed: ") + e.what());
+            co_return BackendResult<Operation>::error(std::string(Operation.name) + " failed: " + e.what());
+        }
+    }
+
+    template<const auto& Operation, typename T, typename... Args>
+    void Core::record(uint32_t camera_id, const Result<T>& result, const Args&... args) const {
+        using Client = typename std::remove_cvref_t<decltype(Operation)>::ClientType;
+        if constexpr (Operation.effect != StateEffect::None) {
+            const auto& value = [&]() -> const auto& {
+                if constexpr (std::is_void_v<T>) {
+                    return std::get<sizeof...(Args) - 1>(std::forward_as_tuple(args...));
+                } else {
+                    return result.value();
+                }
+            }();
+
+            if constexpr (std::is_same_v<Client, infrastructure::IVideoServiceClient>) {
+                const auto& capability = std::get<0>(std::forward_as_tuple(args...));
+                if constexpr (Operation.effect == StateEffect::Commanded) {
+                    commandedVideo(camera_id, capability, value);
+                } else {
+                    observeVideo(camera_id, capability, value);
+                }
+            } else if constexpr (Operation.effect == StateEffect::Commanded) {
+                commanded(camera_id, stateOf(Operation.field, value));
+            } else {
+                observe(camera_id, stateOf(Operation.field, value));
+            }
         }
     }
 
-    Result<void> Core::goToMinZoom(uint32_t camera_id) const {
-        return setZoom(camera_id, common::types::MIN_NORMALIZED_ZOOM);
+    Result<common::types::zoom> Core::setZoom(uint32_t camera_id, const common::types::zoom zoom_level) const {
+        const common::types::Operation operation{.type = common::types::OperationType::SetZoom,
+                                                 .camera_id = camera_id,
+                                                 .value = zoom_level};
+        return idempotent<common::types::zoom>(operation, [&] { return command<SET_ZOOM>(camera_id, zoom_level); });
     }
 
-    Result<void> Core::goToMaxZoom(uint32_t camera_id) const {
-        return setZoom(camera_id, common::types::MAX_NORMALIZED_ZOOM);
+    Result<common::types::zoom> Core::applyZoom(uint32_t camera_id, const common::types::zoom zoom_level) const {
+        return call<SET_ZOOM>(camera_id, zoom_level);
     }
 
-    Result<void> Core::setFocus(uint32_t camera_id, const common::types::focus focus_value) const {
+    common::async::Task<Result<common::types::zoom>> Core::setZoomAsync(
+        uint32_t camera_id, const common::types::zoom zoom_level) const {
+        const common::types::Operation operation{.type = common::types::OperationType::SetZoom,
+                                                 .camera_id = camera_id,
+                                                 .value = zoom_level};
+        return idempotentAsync<common::types::zoom>(operation, commandAsync<SET_ZOOM>(camera_id, zoom_level));
+    }
+
+    Result<common::types::zoom> Core::getZoom(uint32_t camera_id) const {
+        return call<GET_ZOOM>(camera_id);
+    }
+
+    Result<common::types::zoom> Core::goToMinZoom(uint32_t camera_id) const {
+        const common::types::Operation operation{.type = common::types::OperationType::GoToMinZoom,
+                                                 .camera_id = camera_id};
+        return idempotent<common::types::zoom>(operation, [&] { return command<GO_TO_MIN_ZOOM>(camera_id); });
+    }
+
+    Result<common::types::zoom> Core::goToMaxZoom(uint32_t camera_id) const {
+        const common::types::Operation operation{.type = common::types::OperationType::GoToMaxZoom,
+                                                 .camera_id = camera_id};
+        return idempotent<common::types::zoom>(operation, [&] { return command<GO_TO_MAX_ZOOM>(camera_id); });
+    }
+
+    Result<common::types::focus> Core::setFocus(uint32_t camera_id, const common::types::focus focus_value) const {
+        const common::types::Operation operation{.type = common::types::OperationType::SetFocus,
+                                                 .camera_id = camera_id,
+                                                 .value = focus_value};
+        return idempotent<common::types::focus>(operation, [&] {
+            return command<SET_FOCUS>(camera_id, focus_value);
+        });
+    }
+
+    Result<common::types::focus> Core::applyFocus(uint32_t camera_id,
+                                                  const common::types::focus focus_value) const {
+        return call<SET_FOCUS>(camera_id, focus_value);
+    }
+
+    common::async::Task<Result<common::types::focus>> Core::setFocusAsync(
+        uint32_t camera_id, const common::types::focus focus_value) const {
+        const common::types::Operation operation{.type = common::types::OperationType::SetFocus,
+                                                 .camera_id = camera_id,
+                                                 .value = focus_value};
+        return idempotentAsync<common::types::focus>(operation, commandAsync<SET_FOCUS>(camera_id, focus_value));
+    }
+
+    Result<common::types::focus> Core::getFocus(uint32_t camera_id) const {
+        return call<GET_FOCUS>(camera_id);
+    }
+
+    Result<void> Core::enableAutoFocus(uint32_t camera_id, const bool on) const {
+        const common::types::Operation operation{.type = common::types::OperationType::SetAutoFocus,
+                                                 .camera_id = camera_id,
+                                                 .enable = on};
+        return idempotent<void>(operation, [&] { return command<ENABLE_AUTO_FOCUS>(camera_id, on); });
+    }
+
+    Result<bool> Core::getAutoFocus(uint32_t camera_id) const {
+        return call<GET_AUTO_FOCUS>(camera_id);
+    }
+
+    Result<common::types::zoom> Core::stepZoom(uint32_t camera_id, const int32_t delta) const {
+        if (!isRunning()) {
+            return Result<common::types::zoom>::error("Core is not initialized");
+        }
+        if (const auto control = checkControl(camera_id); control.isError()) {
+            return Result<common::types::zoom>::error(control.error());
+        }
+        stopMotion(camera_id, MotionScheduler::Axis::Zoom);
+        const auto current = getZoom(camera_id);
+        if (current.isError()) {
+            return current;
+        }
+        return applyZoom(camera_id, stepped(current.value(), delta, common::types::NORMALIZED_ZOOM_RANGE.min,
+                                            common::types::NORMALIZED_ZOOM_RANGE.max));
+    }
+
+    Result<common::types::focus> Core::stepFocus(uint32_t camera_id, const int32_t delta) const {
+        if (!isRunning()) {
+            return Result<common::types::focus>::error("Core is not initialized");
+        }
+        if (const auto control = checkControl(camera_id); control.isError()) {
+            return Result<common::types::focus>::error(control.error());
+        }
+        stopMotion(camera_id, MotionScheduler::Axis::Focus);
+        const auto current = getFocus(camera_id);
+        if (current.isError()) {
+            return current;
+        }
+        return applyFocus(camera_id, stepped(current.value(), delta, common::types::NORMALIZED_FOCUS_RANGE.min,
+                                             common::types::NORMALIZED_FOCUS_RANGE.max));
+    }
+
+    Result<void> Core::setZoomVelocity(uint32_t camera_id, const double velocity,
+                                       const std::chrono::milliseconds duration) const {
+        return setVelocity(camera_id, MotionScheduler::Axis::Zoom, velocity, duration);
+    }
+
+    Result<void> Core::setFocusVelocity(uint32_t camera_id, const double velocity,
+                                        const std::chrono::milliseconds duration) const {
+        return setVelocity(camera_id, MotionScheduler::Axis::Focus, velocity, duration);
+    }
+
+    Result<void> Core::setVelocity(uint32_t camera_id, const MotionScheduler::Axis axis, const double velocity,
+                                   const std::chrono::milliseconds duration) const {
         if (!isRunning()) {
             return Result<void>::error("Core is not initialized");
         }
+        if (const auto control = checkControl(camera_id); control.isError()) {
+            return Result<void>::error(control.error());
+        }
 
         try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
-            if (!client) {
-                return Result<void>::error("camera_service client for instance " + std::to_string(camera_id) +
-                                          " is not available");
+            if (!client_manager_->getCameraServiceClient(camera_id)) {
+                return Result<void>::error(unavailable<ICameraServiceClient>(camera_id));
             }
 
-            return client->setFocus(focus_value);
+            // Unset or overlong deadlines are capped so a lost client cannot leave the camera moving
+            const auto max_duration = core_config_.motion.max_duration;
+            const auto auto_stop = duration <= std::chrono::milliseconds::zero()
+                                       ? max_duration
+                                       : std::min(duration, max_duration);
+
+            MotionScheduler* scheduler = nullptr;
+            {
+                std::lock_guard lock(motion_mutex_);
+                auto& entry = motion_schedulers_[camera_id];
+                if (!entry) {
+                    entry = std::make_unique<MotionScheduler>(
+                        std::chrono::microseconds(std::chrono::seconds(1)) / core_config_.motion.tick_hz,
+                        [this, camera_id](const MotionScheduler::Axis moved) {
+                            common::state::CallContext::Scope scope(MOTION_TICK_CALL);
+                            return moved == MotionScheduler::Axis::Zoom ? getZoom(camera_id) : getFocus(camera_id);
+                        },
+                        [this, camera_id](const MotionScheduler::Axis moved, const uint32_t position) {
+                            common::state::CallContext::Scope scope(MOTION_TICK_CALL);
+                            return moved == MotionScheduler::Axis::Zoom ? applyZoom(camera_id, position)
+                                                                        : applyFocus(camera_id, position);
+                        });
+                }
+                scheduler = entry.get();
+            }
+            return scheduler->move(axis, velocity, auto_stop);
         } catch (const std::exception& e) {
-            return Result<void>::error(std::string("setFocus failed: ") + e.what());
+            return Result<void>::error(std::string("setVelocity failed: ") + e.what());
         }
     }
 
-    Result<common::types::focus> Core::getFocus(uint32_t camera_id) const {
+    void Core::stopMotion(uint32_t camera_id, const MotionScheduler::Axis axis) const {
+        MotionScheduler* scheduler = nullptr;
+        {
+            std::lock_guard lock(motion_mutex_);
+            const auto it = motion_schedulers_.find(camera_id);
+            if (it == motion_schedulers_.end()) {
+                return;
+            }
+            scheduler = it->second.get();
+        }
+        scheduler->stop(axis);
+    }
+
+    void Core::stopMotion(uint32_t camera_id, const MotionScheduler::Axis axis, std::function<void()> stopped) const {
+        MotionScheduler* scheduler = nullptr;
+        {
+            std::lock_guard lock(motion_mutex_);
+            if (const auto it = motion_schedulers_.find(camera_id); it != motion_schedulers_.end()) {
+                scheduler = it->second.get();
+            }
+        }
+        if (!scheduler) {
+            stopped();
+            return;
+        }
+        scheduler->stop(axis, std::move(stopped));
+    }
+
+    Result<common::types::Convergence> Core::setZoomAndWait(uint32_t camera_id, const common::types::zoom zoom_level,
+                                                            const uint32_t tolerance,
+                                                            const std::chrono::milliseconds timeout) const {
+        return common::async::syncWait(setZoomAndWaitAsync(camera_id, zoom_level, tolerance, timeout));
+    }
+
+    Result<common::types::Convergence> Core::setFocusAndWait(uint32_t camera_id,
+                                                             const common::types::focus focus_value,
+                                                             const uint32_t tolerance,
+                                                             const std::chrono::milliseconds timeout) const {
+        return common::async::syncWait(setFocusAndWaitAsync(camera_id, focus_value, tolerance, timeout));
+    }
+
+    common::async::Task<Result<common::types::Convergence>> Core::setZoomAndWaitAsync(
+        uint32_t camera_id, const common::types::zoom zoom_level, const uint32_t tolerance,
+        const std::chrono::milliseconds timeout) const {
+        return setAndWait(camera_id, MotionScheduler::Axis::Zoom, zoom_level, tolerance, timeout);
+    }
+
+    common::async::Task<Result<common::types::Convergence>> Core::setFocusAndWaitAsync(
+        uint32_t camera_id, const common::types::focus focus_value, const uint32_t tolerance,
+        const std::chrono::milliseconds timeout) const {
+        return setAndWait(camera_id, MotionScheduler::Axis::Focus, focus_value, tolerance, timeout);
+    }
+
+    common::async::Task<Result<common::types::Convergence>> Core::setAndWait(
+        uint32_t camera_id, const MotionScheduler::Axis axis, const uint32_t value, const uint32_t tolerance,
+        const std::chrono::milliseconds timeout) const {
         if (!isRunning()) {
-            return Result<common::types::focus>::error("Core is not initialized");
+            co_return Result<common::types::Convergence>::error("Core is not initialized");
+        }
+
+        const auto started = std::chrono::steady_clock::now();
+        const auto max_wait = core_config_.convergence.max_wait;
+        const auto deadline = started + (timeout <= std::chrono::milliseconds::zero() ? max_wait
+                                                                                      : std::min(timeout, max_wait));
+
+        // The backend may clamp the value, wait for what it applied rather than what was asked
+        auto set = axis == MotionScheduler::Axis::Zoom ? setZoomAsync(camera_id, value)
+                                                       : setFocusAsync(camera_id, value);
+        const auto applied = co_await std::move(set);
+        if (applied.isError()) {
+            co_return Result<common::types::Convergence>::error(applied.error());
         }
 
         try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
-            if (!client) {
-                return Result<common::types::focus>::error("camera_service client for instance " +
-                                                         std::to_string(camera_id) + " is not available");
+            auto& watcher = convergenceWatcher(camera_id);
+            const auto result = co_await common::async::fromCallback<Result<common::types::Convergence>>(
+                [&watcher, axis, target = applied.value(), tolerance, deadline](auto complete) {
+                    watcher.watch(axis, target, tolerance, deadline, std::move(complete));
+                });
+            if (result.isError()) {
+                co_return result;
             }
 
-            return client->getFocus();
+            // Report the whole call, the Set included
+            auto convergence = result.value();
+            convergence.elapsed =
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+            co_return Result<common::types::Convergence>::success(convergence);
         } catch (const std::exception& e) {
-            return Result<common::types::focus>::error(std::string("getFocus failed: ") + e.what());
+            co_return Result<common::types::Convergence>::error(std::string("setAndWait failed: ") + e.what());
         }
     }
 
-    Result<void> Core::enableAutoFocus(uint32_t camera_id, const bool on) const {
+    ConvergenceWatcher& Core::convergenceWatcher(uint32_t camera_id) const {
+        std::lock_guard lock(convergence_mutex_);
+        auto& entry = convergence_watchers_[camera_id];
+        if (!entry) {
+            entry = std::make_unique<ConvergenceWatcher>(
+                core_config_.convergence, [this, camera_id](const MotionScheduler::Axis polled) {
+                    return polled == MotionScheduler::Axis::Zoom ? getZoom(camera_id) : getFocus(camera_id);
+                });
+        }
+        return *entry;
+    }
+
+    Result<common::types::info> Core::getInfo(uint32_t camera_id) const {
+        return call<GET_INFO>(camera_id);
+    }
+
+    Result<void> Core::stabilize(uint32_t camera_id, const bool on) const {
+        const common::types::Operation operation{.type = common::types::OperationType::SetStabilization,
+                                                 .camera_id = camera_id,
+                                                 .enable = on};
+        return idempotent<void>(operation, [&] { return command<STABILIZE>(camera_id, on); });
+    }
+
+    Result<bool> Core::getStabilization(uint32_t camera_id) const {
+        return call<GET_STABILIZATION>(camera_id);
+    }
+
+    Result<common::capabilities::CapabilityList> Core::getCapabilities(uint32_t camera_id) const {
+        return call<GET_CAPABILITIES>(camera_id);
+    }
+
+    Result<void> Core::SetVideoCapabilityState(
+        uint32_t camera_id,
+        const std::string& capability,
+        const bool enable) const {
+        const common::types::Operation operation{.type = common::types::OperationType::SetVideoCapabilityState,
+                                                 .camera_id = camera_id,
+                                                 .enable = enable,
+                                                 .capability = capability};
+        return idempotent<void>(operation, [&] {
+            return command<SET_VIDEO_CAPABILITY_STATE>(camera_id, capability, enable);
+        });
+    }
+
+    Result<std::vector<std::string>> Core::getVideoCapabilities(uint32_t camera_id) const {
+        return call<GET_VIDEO_CAPABILITIES>(camera_id);
+    }
+
+    Result<bool> Core::getVideoCapabilityState(uint32_t camera_id, const std::string& capability) const {
+        return call<GET_VIDEO_CAPABILITY_STATE>(camera_id, capability);
+    }
+
+    void Core::forwardCameraCall(uint32_t camera_id, infrastructure::RawCall call) const {
         if (!isRunning()) {
-            return Result<void>::error("Core is not initialized");
+            call.on_done(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Core is not initialized"));
+            return;
+        }
+
+        // Reads pass through, commands honour the lease and record the state they leave like the decoded methods
+        if (call.isCommand()) {
+            if (const auto control = checkControl(camera_id); control.isError()) {
+                call.on_done(grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, control.error().message));
+                return;
+            }
+            call.on_done = [this, camera_id, method = call.method, request = call.request, response = call.response,
+                            done = std::move(call.on_done)](const grpc::Status& status) {
+                if (status.ok()) {
+                    try {
+                        if (const auto state = passthroughState({.method = method, .request = request,
+                                                                 .response = response})) {
+                            commanded(camera_id, *state);
+                        }
+                    } catch (const std::exception& e) {
+                        LOG_WARN("Passthrough {} to camera {} left no state: {}", method, camera_id, e.what());
+                    }
+                }
+                done(status);
+            };
+        }
+
+        // This is a gRPC callback thread, the call awaits its slot and token without holding it
+        auto done = std::move(call.on_done);
+        common::async::start(forward(camera_id, std::move(call), common::state::CallContext::current()),
+                             std::move(done));
+    }
+
+    common::async::Task<grpc::Status> Core::forward(uint32_t camera_id, infrastructure::RawCall call,
+                                                    const common::state::CallContext context) const {
+        if (const auto axis = stoppedAxis(call.method)) {
+            co_await common::async::fromCallback<bool>([&](auto complete) {
+                stopMotion(camera_id, *axis, [complete] { complete(true); });
+            });
+            // The core may have stopped while the tick ended
+            if (!isRunning()) {
+                co_return grpc::Status(grpc::StatusCode::UNAVAILABLE, "Core is not initialized");
+            }
         }
 
         try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
+            auto* const client = client_manager_->getCameraPassthroughClient(camera_id);
             if (!client) {
-                return Result<void>::error("camera_service client for instance " + std::to_string(camera_id) +
-                                          " is not available");
+                co_return grpc::Status(grpc::StatusCode::UNAVAILABLE, unavailable<ICameraServiceClient>(camera_id));
             }
 
-            return client->enableAutoFocus(on);
+            // The camera's gate counts the call like a decoded one, its slot is held until the backend replies
+            const auto ticket = co_await dispatcher_->admitAsync(camera_id, context, *command_scheduler_);
+            if (!ticket.admitted()) {
+                co_return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, ticket.error().message);
+            }
+            co_return co_await common::async::fromCallback<grpc::Status>([&](auto complete) {
+                call.on_done = [complete](const grpc::Status& status) { complete(status); };
+                client->forward(std::move(call));
+            });
         } catch (const std::exception& e) {
-            return Result<void>::error(std::string("enableAutoFocus failed: ") + e.what());
+            co_return grpc::Status(grpc::StatusCode::INTERNAL, std::string("forwardCameraCall failed: ") + e.what());
         }
     }
 
-    Result<bool> Core::getAutoFocus(uint32_t camera_id) const {
+    Result<std::shared_ptr<common::state::CameraStateSubscription>> Core::watchCameraState(
+        uint32_t camera_id,
+        const common::types::CameraStateFields fields) const {
+        using ResultType = Result<std::shared_ptr<common::state::CameraStateSubscription>>;
         if (!isRunning()) {
-            return Result<bool>::error("Core is not initialized");
+            return ResultType::error("Core is not initialized");
         }
 
         try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
-            if (!client) {
-                return Result<bool>::error("camera_service client for instance " + std::to_string(camera_id) +
-                                          " is not available");
+            if (!client_manager_->getCameraServiceClient(camera_id)) {
+                return ResultType::error(unavailable<ICameraServiceClient>(camera_id));
+            }
+
+            // The first subscriber of a camera pays for one read so its snapshot is complete
+            if (!state_hub_->hasState(camera_id)) {
+                state_hub_->publish(camera_id, readCameraState(camera_id));
             }
 
-            return client->getAutoFocus();
+            return ResultType::success(state_hub_->subscribe(camera_id, fields));
         } catch (const std::exception& e) {
-            return Result<bool>::error(std::string("getAutoFocus failed: ") + e.what());
+            return ResultType::error(std::string("watchCameraState failed: ") + e.what());
         }
     }
 
-    Result<common::types::info> Core::getInfo(uint32_t camera_id) const {
+    common::types::CameraState Core::readCameraState(uint32_t camera_id) const {
+        // Each read is admitted like any other call, under the priority of the current call
+        common::types::CameraState state;
+        if (auto zoom = call<GET_ZOOM>(camera_id); zoom.isSuccess()) {
+            state.zoom_level = zoom.value();
+        }
+        if (auto focus = call<GET_FOCUS>(camera_id); focus.isSuccess()) {
+            state.focus_value = focus.value();
+        }
+        if (auto auto_focus = call<GET_AUTO_FOCUS>(camera_id); auto_focus.isSuccess()) {
+            state.auto_focus = auto_focus.value();
+        }
+        if (auto stabilization = call<GET_STABILIZATION>(camera_id); stabilization.isSuccess()) {
+            state.stabilization = stabilization.value();
+        }
+        return state;
+    }
+
+    void Core::observe(uint32_t camera_id, const common::types::CameraState& state) const {
+        if (state_hub_) {
+            state_hub_->publish(camera_id, state);
+        }
+    }
+
+    void Core::observeVideo(uint32_t camera_id, const std::string& capability, const bool enable) const {
+        if (state_hub_) {
+            state_hub_->publishVideoState(camera_id, capability, enable);
+        }
+    }
+
+    void Core::commanded(uint32_t camera_id, const common::types::CameraState& state) const {
+        observe(camera_id, state);
+        if (reconciler_) {
+            reconciler_->desire(camera_id, state);
+        }
+    }
+
+    void Core::commandedVideo(uint32_t camera_id, const std::string& capability, const bool enable) const {
+        observeVideo(camera_id, capability, enable);
+        if (reconciler_) {
+            reconciler_->desireVideo(camera_id, capability, enable);
+        }
+    }
+
+    common::types::DesiredState Core::readDesired(uint32_t camera_id,
+                                                  const common::types::DesiredState& desired) const {
+        // Reads go through the business methods, so they queue fairly and refresh the state hub
+        common::types::DesiredState observed;
+        if (desired.state.zoom_level) {
+            if (auto zoom = getZoom(camera_id); zoom.isSuccess()) {
+                observed.state.zoom_level = zoom.value();
+            }
+        }
+        if (desired.state.focus_value && desired.state.auto_focus != true) {
+            if (auto focus = getFocus(camera_id); focus.isSuccess()) {
+                observed.state.focus_value = focus.value();
+            }
+        }
+        if (desired.state.auto_focus) {
+            if (auto auto_focus = getAutoFocus(camera_id); auto_focus.isSuccess()) {
+                observed.state.auto_focus = auto_focus.value();
+            }
+        }
+        if (desired.state.stabilization) {
+            if (auto stabilization = getStabilization(camera_id); stabilization.isSuccess()) {
+                observed.state.stabilization = stabilization.value();
+            }
+        }
+        for (const auto& [capability, enable] : desired.video) {
+            if (auto state = getVideoCapabilityState(camera_id, capability); state.isSuccess()) {
+                observed.video[capability] = state.value();
+            }
+        }
+        return observed;
+    }
+
+    Result<common::types::VersionedValue> Core::getIfChanged(uint32_t camera_id,
+                                                             const common::types::StateField& field,
+                                                             const common::types::ReadCondition& condition) const {
+        return common::async::syncWait(getIfChangedAsync(camera_id, field, condition));
+    }
+
+    common::async::Task<Result<common::types::VersionedValue>> Core::getIfChangedAsync(
+        uint32_t camera_id, const common::types::StateField field,
+        const common::types::ReadCondition condition) const {
+        using ResultType = Result<common::types::VersionedValue>;
         if (!isRunning()) {
-            return Result<common::types::info>::error("Core is not initialized");
+            co_return ResultType::error("Core is not initialized");
         }
 
-        try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
-            if (!client) {
-                return Result<common::types::info>::error("camera_service client for instance " +
-                                                        std::to_string(camera_id) + " is not available");
+        // The hub poller keeps watched cameras current, anything else is read from the backend first
+        const auto* const camera_field = std::get_if<common::types::CameraStateField>(&field);
+        if (!condition.if_generation_not || !camera_field || !state_hub_->watchedState(camera_id)) {
+            if (const auto read = readField(camera_id, field); read.isError()) {
+                co_return ResultType::error(read.error());
             }
+        }
 
-            return client->getInfo();
-        } catch (const std::exception& e) {
-            return Result<common::types::info>::error(std::string("getInfo failed: ") + e.what());
+        auto current = state_hub_->versioned(camera_id, field);
+        if (!condition.if_generation_not) {
+            co_return ResultType::success(current);
         }
+
+        const auto unchanged = *condition.if_generation_not;
+        if (current.generation == unchanged && condition.wait > std::chrono::milliseconds::zero()) {
+            const auto waited = co_await waitForChange(camera_id, field, unchanged, condition.wait);
+            if (waited.isError()) {
+                co_return ResultType::error(waited.error());
+            }
+            current = state_hub_->versioned(camera_id, field);
+        }
+
+        if (current.generation == unchanged) {
+            current.value.reset();
+        }
+        co_return ResultType::success(current);
     }
 
-    Result<void> Core::stabilize(uint32_t camera_id, const bool on) const {
+    Result<void> Core::savePreset(const common::types::Preset& preset) const {
         if (!isRunning()) {
             return Result<void>::error("Core is not initialized");
         }
+        return preset_store_->save(preset);
+    }
 
-        try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
-            if (!client) {
-                return Result<void>::error("camera_service client for instance " + std::to_string(camera_id) +
-                                          " is not available");
-            }
+    Result<void> Core::deletePreset(const std::string& name) const {
+        if (!isRunning()) {
+            return Result<void>::error("Core is not initialized");
+        }
+        return preset_store_->remove(name);
+    }
 
-            return client->stabilize(on);
-        } catch (const std::exception& e) {
-            return Result<void>::error(std::string("stabilize failed: ") + e.what());
+    Result<std::vector<common::types::Preset>> Core::listPresets() const {
+        if (!isRunning()) {
+            return Result<std::vector<common::types::Preset>>::error("Core is not initialized");
         }
+        return Result<std::vector<common::types::Preset>>::success(preset_store_->list());
     }
 
-    Result<bool> Core::getStabilization(uint32_t camera_id) const {
+    Result<common::types::PresetRecall> Core::recallPreset(const std::vector<uint32_t>& camera_ids,
+                                                           const std::string& name) const {
+        using common::types::CameraStateField;
+        using common::types::OperationType;
+        using ResultType = Result<common::types::PresetRecall>;
         if (!isRunning()) {
-            return Result<bool>::error("Core is not initialized");
+            return ResultType::error("Core is not initialized");
         }
 
-        try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
-            if (!client) {
-                return Result<bool>::error("camera_service client for instance " + std::to_string(camera_id) +
-                                          " is not available");
+        const auto started = std::chrono::steady_clock::now();
+        const auto preset = preset_store_->find(name);
+        if (!preset) {
+            return ResultType::error("Unknown preset: " + name);
+        }
+
+        common::types::PresetRecall recall;
+        std::vector<const common::types::CameraPreset*> cameras;
+        for (const auto& camera : preset->cameras) {
+            if (camera_ids.empty() || std::ranges::find(camera_ids, camera.camera_id) != camera_ids.end()) {
+                cameras.push_back(&camera);
+            }
+        }
+        for (const auto camera_id : camera_ids) {
+            if (std::ranges::none_of(preset->cameras, [camera_id](const auto& camera) {
+                    return camera.camera_id == camera_id;
+                })) {
+                recall.errors.push_back("Preset " + name + " has no settings for camera " + std::to_string(camera_id));
             }
+        }
 
-            return client->getStabilization();
-        } catch (const std::exception& e) {
-            return Result<bool>::error(std::string("getStabilization failed: ") + e.what());
+        // Settings the hub last observed at their target are not sent again. A focus is only kept with
+        // auto focus off, so it follows an auto focus change of its camera; everything else runs at once.
+        std::vector<common::types::Operation> first;
+        std::vector<common::types::Operation> second;
+        for (const auto* const camera : cameras) {
+            const auto camera_id = camera->camera_id;
+            const auto& state = camera->state;
+            const auto pending = [&](const common::types::StateField& field, const common::types::StateValue& target) {
+                if (state_hub_->versioned(camera_id, field).value == target) {
+                    ++recall.skipped;
+                    return false;
+                }
+                return true;
+            };
+
+            bool auto_focus_changes = false;
+            if (state.zoom_level && pending(CameraStateField::Zoom, *state.zoom_level)) {
+                first.push_back({.type = OperationType::SetZoom, .camera_id = camera_id, .value = *state.zoom_level});
+            }
+            if (state.auto_focus && pending(CameraStateField::AutoFocus, *state.auto_focus)) {
+                first.push_back(
+                    {.type = OperationType::SetAutoFocus, .camera_id = camera_id, .enable = *state.auto_focus});
+                auto_focus_changes = true;
+            }
+            if (state.focus_value && pending(CameraStateField::Focus, *state.focus_value)) {
+                (auto_focus_changes ? second : first).push_back(
+                    {.type = OperationType::SetFocus, .camera_id = camera_id, .value = *state.focus_value});
+            }
+            if (state.stabilization && pending(CameraStateField::Stabilization, *state.stabilization)) {
+                first.push_back(
+                    {.type = OperationType::SetStabilization, .camera_id = camera_id, .enable = *state.stabilization});
+            }
+            for (const auto& [capability, enable] : camera->video_capabilities) {
+                if (pending(capability, enable)) {
+                    first.push_back({.type = OperationType::SetVideoCapabilityState, .camera_id = camera_id,
+                                     .enable = enable, .capability = capability});
+                }
+            }
         }
+
+        for (const auto* const phase : {&first, &second}) {
+            if (phase->empty()) {
+                continue;
+            }
+            const auto results = executeBatch(*phase, common::types::BatchOrdering::Parallel);
+            for (std::size_t index = 0; index < results.size(); ++index) {
+                if (results[index].isError()) {
+                    const auto& operation = (*phase)[index];
+                    recall.errors.push_back("Camera " + std::to_string(operation.camera_id) + " " +
+                                            settingName(operation) + ": " + results[index].error().message);
+                } else {
+                    ++recall.applied;
+                }
+            }
+        }
+
+        recall.elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        LOG_DEBUG("Preset {} recalled in {} ms: {} applied, {} skipped, {} failed", name, recall.elapsed.count(),
+                  recall.applied, recall.skipped, recall.errors.size());
+        return ResultType::success(std::move(recall));
     }
 
-    Result<common::capabilities::CapabilityList> Core::getCapabilities(uint32_t camera_id) const {
+    Result<std::shared_ptr<common::state::MacroExecution>> Core::runMacro(uint32_t camera_id,
+                                                                         const common::types::Macro& macro) const {
+        using ResultType = Result<std::shared_ptr<common::state::MacroExecution>>;
         if (!isRunning()) {
-            return Result<common::capabilities::CapabilityList>::error("Core is not initialized");
+            return ResultType::error("Core is not initialized");
+        }
+        if (const auto reason = macro.invalidReason(); !reason.empty()) {
+            return ResultType::error("Invalid macro: " + reason);
         }
 
         try {
-            auto* client = client_manager_->getCameraServiceClient(camera_id);
-            if (!client) {
-                return Result<common::capabilities::CapabilityList>::error("camera_service client for instance " +
-                                                                          std::to_string(camera_id) +
-                                                                          " is not available");
+            if (!client_manager_->getCameraServiceClient(camera_id)) {
+                return ResultType::error(unavailable<ICameraServiceClient>(camera_id));
+            }
+
+            if (const auto control = checkControl(camera_id); control.isError()) {
+                return ResultType::error(control.error());
+            }
+
+            std::lock_guard lock(macro_mutex_);
+            auto& runner = macro_runners_[camera_id];
+            if (runner && runner->isRunning()) {
+                return ResultType::error("Camera " + std::to_string(camera_id) + " is already running macro " +
+                                         runner->name());
             }
 
-            return client->getCapabilities();
+            // The steps run with the lease of the caller that started the macro
+            const auto call = delegatedCall();
+            MacroRunner::Actions actions{
+                .execute = [this, call](const common::types::Operation& operation) {
+                    common::state::CallContext::Scope scope(call);
+                    return execute(operation);
+                },
+                .step = [this, camera_id, call](const MotionScheduler::Axis axis, const int32_t delta) {
+                    common::state::CallContext::Scope scope(call);
+                    return axis == MotionScheduler::Axis::Zoom ? stepZoom(camera_id, delta)
+                                                               : stepFocus(camera_id, delta);
+                },
+                .await = [this, camera_id](const MotionScheduler::Axis axis, const uint32_t target,
+                                           const uint32_t tolerance, const MacroRunner::Clock::time_point deadline) {
+                    return convergenceWatcher(camera_id).waitFor(axis, target, tolerance, deadline);
+                }};
+
+            auto execution = std::make_shared<common::state::MacroExecution>(camera_id, macro.name);
+            // A finished runner only has its thread left to join
+            runner = std::make_unique<MacroRunner>(camera_id, macro, std::move(actions),
+                                                   core_config_.convergence.max_wait, execution);
+            return ResultType::success(std::move(execution));
         } catch (const std::exception& e) {
-            return Result<common::capabilities::CapabilityList>::error(std::string("getCapabilities failed: ") +
-                                                                       e.what());
+            return ResultType::error(std::string("runMacro failed: ") + e.what());
         }
     }
 
-    Result<void> Core::SetVideoCapabilityState(
-        uint32_t camera_id,
-        const std::string& capability,
-        const bool enable) const {
+    Result<std::shared_ptr<common::state::MacroExecution>> Core::runNamedMacro(uint32_t camera_id,
+                                                                              const std::string& name) const {
+        const auto& definitions = core_config_.macros.definitions;
+        const auto macro = std::ranges::find(definitions, name, &common::types::Macro::name);
+        if (macro == definitions.end()) {
+            return Result<std::shared_ptr<common::state::MacroExecution>>::error("Unknown macro: " + name);
+        }
+        return runMacro(camera_id, *macro);
+    }
+
+    Result<void> Core::cancelMacro(uint32_t camera_id) const {
         if (!isRunning()) {
             return Result<void>::error("Core is not initialized");
         }
 
-        try {
-            auto* client = client_manager_->getVideoServiceClient(camera_id);
-            if (!client) {
-                return Result<void>::error("video_service client for instance " + std::to_string(camera_id) +
-                                          " is not available");
+        std::lock_guard lock(macro_mutex_);
+        const auto runner = macro_runners_.find(camera_id);
+        if (runner == macro_runners_.end() || !runner->second->isRunning()) {
+            return Result<void>::error("Camera " + std::to_string(camera_id) + " is not running a macro");
+        }
+        // The run reports itself cancelled once its current step ends
+        runner->second->stop();
+        return Result<void>::success();
+    }
+
+    Result<common::types::ControlLease> Core::acquireControl(uint32_t camera_id,
+                                                             const std::chrono::milliseconds ttl) const {
+        if (!isRunning()) {
+            return Result<common::types::ControlLease>::error("Core is not initialized");
+        }
+        return lease_table_->acquire(camera_id, ttl);
+    }
+
+    Result<common::types::ControlLease> Core::renewControl(uint32_t camera_id, const uint64_t lease_id,
+                                                           const std::chrono::milliseconds ttl) const {
+        if (!isRunning()) {
+            return Result<common::types::ControlLease>::error("Core is not initialized");
+        }
+        return lease_table_->renew(camera_id, lease_id, ttl);
+    }
+
+    Result<void> Core::releaseControl(uint32_t camera_id, const uint64_t lease_id) const {
+        if (!isRunning()) {
+            return Result<void>::error("Core is not initialized");
+        }
+        return lease_table_->release(camera_id, lease_id);
+    }
+
+    Result<void> Core::checkControl(uint32_t camera_id) const {
+        if (lease_table_->permits(camera_id, common::state::CallContext::current().lease_id)) {
+            return Result<void>::success();
+        }
+        return Result<void>::error(common::types::controlledByAnotherClient(camera_id));
+    }
+
+    Result<common::types::DispatchMetrics> Core::getDispatchMetrics() const {
+        if (!isRunning()) {
+            return Result<common::types::DispatchMetrics>::error("Core is not initialized");
+        }
+        auto metrics = dispatcher_->metrics();
+        metrics.warmup = client_manager_->warmupState();
+        return Result<common::types::DispatchMetrics>::success(std::move(metrics));
+    }
+
+    Result<common::types::ReconcileMetrics> Core::getReconcileStatus() const {
+        if (!isRunning()) {
+            return Result<common::types::ReconcileMetrics>::error("Core is not initialized");
+        }
+        if (!reconciler_) {
+            return Result<common::types::ReconcileMetrics>::success({});
+        }
+        return Result<common::types::ReconcileMetrics>::success(reconciler_->metrics());
+    }
+
+    CameraDispatcher::Ticket Core::admit(uint32_t camera_id) const {
+        return dispatcher_->admit(camera_id, common::state::CallContext::current());
+    }
+
+    Result<void> Core::readField(uint32_t camera_id, const common::types::StateField& field) const {
+        const auto discard = [](const auto& result) {
+            return result.isError() ? Result<void>::error(result.error()) : Result<void>::success();
+        };
+
+        if (const auto* const capability = std::get_if<std::string>(&field)) {
+            return discard(getVideoCapabilityState(camera_id, *capability));
+        }
+        switch (std::get<common::types::CameraStateField>(field)) {
+        case common::types::CameraStateField::Zoom:
+            return discard(getZoom(camera_id));
+        case common::types::CameraStateField::Focus:
+            return discard(getFocus(camera_id));
+        case common::types::CameraStateField::AutoFocus:
+            return discard(getAutoFocus(camera_id));
+        case common::types::CameraStateField::Stabilization:
+            return discard(getStabilization(camera_id));
+        }
+        return Result<void>::error("Unknown state field");
+    }
+
+    common::async::Task<Result<void>> Core::waitForChange(uint32_t camera_id, const common::types::StateField field,
+                                                          const common::types::Generation generation,
+                                                          const std::chrono::milliseconds wait) const {
+        const auto deadline = std::chrono::steady_clock::now() + std::min(wait, core_config_.state_hub.max_wait);
+
+        if (const auto* const camera_field = std::get_if<common::types::CameraStateField>(&field)) {
+            // Holding a subscription makes the hub poll the camera, shared with every other watcher
+            const auto subscription =
+                state_hub_->subscribe(camera_id, static_cast<common::types::CameraStateFields>(*camera_field));
+            const auto current = co_await changeOf(camera_id, field, generation, deadline);
+            subscription->close();
+            co_return current ? Result<void>::success() : Result<void>::error("Core is stopping");
+        }
+
+        // The hub does not poll video capability states, read them here with the same back-off. The wait ends on
+        // the hub poller, the read goes to the readers pool under the priority of the call so polling goes on
+        const auto call = common::state::CallContext::current();
+        auto interval = core_config_.state_hub.poll_min;
+        while (true) {
+            const auto wake = std::min(deadline, std::chrono::steady_clock::now() + interval);
+            const auto current = co_await changeOf(camera_id, field, generation, wake);
+            if (!current) {
+                co_return Result<void>::error("Core is stopping");
+            }
+            if (*current != generation || std::chrono::steady_clock::now() >= deadline) {
+                co_return Result<void>::success();
+            }
+            auto read = co_await common::async::fromCallback<Result<void>>([&](auto complete) {
+                submitSnapshotReader(call, [this, camera_id, &field, complete = std::move(complete)] {
+                    complete(readField(camera_id, field));
+                });
+            });
+            if (read.isError()) {
+                co_return read;
             }
+            interval = std::min(interval * 2, core_config_.state_hub.poll_max);
+        }
+    }
 
-            return client->SetVideoCapabilityState(capability, enable);
-        } catch (const std::exception& e) {
-            return Result<void>::error(std::string("SetVideoCapabilityState failed: ") + e.what());
+    common::async::Task<std::optional<common::types::Generation>> Core::changeOf(
+        uint32_t camera_id, const common::types::StateField field, const common::types::Generation generation,
+        const std::chrono::steady_clock::time_point deadline) const {
+        co_return co_await common::async::fromCallback<std::optional<common::types::Generation>>(
+            [this, camera_id, &field, generation, deadline](auto complete) {
+                state_hub_->onChange(camera_id, field, generation, deadline, std::move(complete));
+            });
+    }
+
+    std::vector<common::types::OperationResult> Core::executeBatch(
+        const std::vector<common::types::Operation>& operations,
+        const common::types::BatchOrdering ordering) const {
+        if (!isRunning()) {
+            return {operations.size(), common::types::OperationResult::error("Core is not initialized")};
         }
+
+        return common::async::syncWait(
+            runLanes(operations, toLanes(operations, ordering), delegatedCall(), std::nullopt, nullptr));
     }
 
-    Result<std::vector<std::string>> Core::getVideoCapabilities(uint32_t camera_id) const {
+    common::async::Task<std::vector<common::types::OperationResult>> Core::executeBatchAsync(
+        std::vector<common::types::Operation> operations,
+        const common::types::BatchOrdering ordering) const {
         if (!isRunning()) {
-            return Result<std::vector<std::string>>::error("Core is not initialized");
+            co_return std::vector(operations.size(), common::types::OperationResult::error("Core is not initialized"));
         }
 
-        try {
-            auto* client = client_manager_->getVideoServiceClient(camera_id);
-            if (!client) {
-                return Result<std::vector<std::string>>::error(
-                    "video_service client for instance " + std::to_string(camera_id) +
-                    " is not available");
+        const auto lanes = toLanes(operations, ordering);
+        co_return co_await runLanes(operations, lanes, delegatedCall(), std::nullopt, nullptr);
+    }
+
+    Result<common::types::ScheduledBatch> Core::executeBatchAt(
+        const std::vector<common::types::Operation>& operations,
+        const common::types::BatchOrdering ordering,
+        const common::types::ExecuteAt& execute_at) const {
+        return common::async::syncWait(executeBatchAtAsync(operations, ordering, execute_at));
+    }
+
+    common::async::Task<Result<common::types::ScheduledBatch>> Core::executeBatchAtAsync(
+        std::vector<common::types::Operation> operations,
+        const common::types::BatchOrdering ordering,
+        const common::types::ExecuteAt execute_at) const {
+        using Clock = CommandScheduler::Clock;
+        using ResultType = Result<common::types::ScheduledBatch>;
+        if (!isRunning()) {
+            co_return ResultType::error("Core is not initialized");
+        }
+
+        const auto start = toSteady(execute_at);
+        const auto& scheduling = core_config_.scheduling;
+        if (start - Clock::now() > scheduling.max_lead) {
+            co_return ResultType::error("Dispatch time is more than " + std::to_string(scheduling.max_lead.count()) +
+                                        " ms ahead");
+        }
+
+        // The wheel wakes the batch shortly before its time, a time already passed runs at once. Nothing holds a
+        // thread meanwhile, the batch resumes on the lanes pool so it never runs on the scheduler thread
+        const auto call = delegatedCall();
+        const auto fired = co_await common::async::fromCallback<bool>(
+            [this, due = start - scheduling.prepare_lead](auto complete) {
+                command_scheduler_->schedule(due, [this, complete](const bool on_time) {
+                    if (!on_time) {
+                        complete(false);
+                        return;
+                    }
+                    lanes_pool_->submit([complete] { complete(true); });
+                });
+            });
+        if (!fired) {
+            co_return ResultType::error("Core stopped before the dispatch time");
+        }
+
+        std::vector<uint32_t> camera_ids;
+        for (const auto& operation : operations) {
+            if (std::ranges::find(camera_ids, operation.camera_id) == camera_ids.end()) {
+                camera_ids.push_back(operation.camera_id);
+                client_manager_->connectInstance(operation.camera_id);
             }
+        }
 
-            return client->getVideoCapabilities();
-        } catch (const std::exception& e) {
-            return Result<std::vector<std::string>>::error(
-                std::string("getVideoCapabilities failed: ") + e.what());
+        common::types::ScheduledBatch batch;
+        std::vector<Clock::time_point> dispatched(operations.size(), Clock::time_point::max());
+        const auto lanes = toLanes(operations, ordering);
+        batch.results = co_await runLanes(operations, lanes, call, start, &dispatched);
+
+        for (const auto camera_id : camera_ids) {
+            auto first = Clock::time_point::max();
+            for (std::size_t index = 0; index < operations.size(); ++index) {
+                if (operations[index].camera_id == camera_id) {
+                    first = std::min(first, dispatched[index]);
+                }
+            }
+            batch.dispatches.push_back(
+                {.camera_id = camera_id,
+                 .skew = std::chrono::duration_cast<std::chrono::microseconds>(first - start)});
         }
+        co_return ResultType::success(std::move(batch));
     }
 
-    Result<bool> Core::getVideoCapabilityState(uint32_t camera_id, const std::string& capability) const {
+    common::async::Task<std::vector<common::types::OperationResult>> Core::runLanes(
+        const std::vector<common::types::Operation>& operations,
+        const std::vector<std::vector<std::size_t>>& lanes,
+        const common::state::CallContext call,
+        const std::optional<CommandScheduler::Clock::time_point> start,
+        std::vector<CommandScheduler::Clock::time_point>* dispatched) const {
+        std::vector results(operations.size(), common::types::OperationResult::error("Operation was not executed"));
+        // Lanes on other threads act for the same caller
+        const auto run_lane = [this, &operations, &results, start, dispatched,
+                               &call](const std::vector<std::size_t>& lane) {
+            common::state::CallContext::Scope scope(call);
+            if (start) {
+                preciseWaitUntil(*start, [](const auto time) {
+                    std::this_thread::sleep_until(time);
+                    return true;
+                });
+            }
+            for (const auto index : lane) {
+                if (dispatched) {
+                    (*dispatched)[index] = CommandScheduler::Clock::now();
+                }
+                results[index] = execute(operations[index]);
+            }
+        };
+
+        if (lanes.size() == 1) {
+            run_lane(lanes.front());
+            co_return results;
+        }
+
+        // Every lane beyond the first is a task that ends once whoever claimed the lane ran it: a pool worker, or
+        // the awaiting thread so a batch never waits on workers busy with other batches. A job that finds its lane
+        // claimed touches nothing but the shared state, the batch may be gone by then
+        struct LaneRuns {
+            explicit LaneRuns(const std::size_t count) : claimed(count), done(count) {}
+
+            std::vector<std::atomic<bool>> claimed;
+            std::vector<std::function<void(bool)>> done; // ends the task of a lane
+        };
+        const auto runs = std::make_shared<LaneRuns>(lanes.size());
+        const auto claim = [runs, &run_lane, &lanes](const std::size_t lane) {
+            if (runs->claimed[lane].exchange(true)) {
+                return;
+            }
+            run_lane(lanes[lane]);
+            runs->done[lane](true);
+        };
+
+        std::vector<common::async::Task<bool>> tasks;
+        tasks.reserve(lanes.size());
+        for (std::size_t lane = 1; lane < lanes.size(); ++lane) {
+            tasks.push_back(common::async::fromCallback<bool>([this, runs, claim, lane](auto complete) {
+                runs->done[lane] = std::move(complete);
+                lanes_pool_->submit([claim, lane] { claim(lane); });
+            }));
+        }
+        // Started last, once every other lane is queued
+        tasks.push_back(runInline([&run_lane, &lanes, &claim] {
+            run_lane(lanes.front());
+            for (std::size_t lane = 1; lane < lanes.size(); ++lane) {
+                claim(lane);
+            }
+        }));
+        co_await common::async::whenAll(std::move(tasks));
+        co_return results;
+    }
+
+    Result<std::vector<common::types::CameraSnapshot>> Core::getSystemSnapshot(
+        const std::vector<uint32_t>& camera_ids,
+        const common::types::SnapshotFields fields) const {
+        return common::async::syncWait(getSystemSnapshotAsync(camera_ids, fields));
+    }
+
+    common::async::Task<Result<std::vector<common::types::CameraSnapshot>>> Core::getSystemSnapshotAsync(
+        std::vector<uint32_t> camera_ids,
+        const common::types::SnapshotFields fields) const {
+        using ResultType = Result<std::vector<common::types::CameraSnapshot>>;
         if (!isRunning()) {
-            return Result<bool>::error("Core is not initialized");
+            co_return ResultType::error("Core is not initialized");
         }
 
         try {
-            auto* client = client_manager_->getVideoServiceClient(camera_id);
-            if (!client) {
-                return Result<bool>::error(
-                    "video_service client for instance " + std::to_string(camera_id) +
-                    " is not available");
+            const auto cameras = camera_ids.empty() ? configuredCameraIds() : camera_ids;
+            const auto camera_timeout = core_config_.snapshot.camera_timeout;
+            // Cameras are read concurrently, so they share one deadline
+            const auto deadline = std::chrono::steady_clock::now() + camera_timeout;
+            // Readers act for the caller, whose scope is gone once the snapshot waits. Their backend calls end at
+            // the snapshot deadline, a hung camera does not hold a reader past it
+            auto reader_call = common::state::CallContext::current();
+            reader_call.deadline = std::min(reader_call.deadline, deadline);
+
+            std::vector<std::shared_ptr<PendingSnapshot>> pending_cameras;
+            std::vector<common::async::Task<bool>> tasks;
+            pending_cameras.reserve(cameras.size());
+            tasks.reserve(cameras.size());
+            for (const auto camera_id : cameras) {
+                auto pending = std::make_shared<PendingSnapshot>();
+                pending->snapshot.camera_id = camera_id;
+                pending->missing = fields;
+
+                // The hub keeps watched cameras current, their state needs no backend call
+                if (const auto state = state_hub_->watchedState(camera_id)) {
+                    pending->snapshot.state = state->masked(fields & common::types::ALL_CAMERA_STATE_FIELDS);
+                    pending->missing &= ~pending->snapshot.state.fields();
+                }
+
+                // A camera waits for its last reader or its deadline, the snapshot then goes on on that thread
+                tasks.push_back(common::async::fromCallback<bool>([this, pending, camera_id, deadline,
+                                                                   &reader_call](auto complete) {
+                    const auto missing = pending->missing;
+                    if (missing == 0) {
+                        complete(true);
+                        return;
+                    }
+                    pending->done = std::move(complete);
+
+                    for (const auto field : SNAPSHOT_FIELDS) {
+                        if (!common::types::hasField(missing, field)) {
+                            continue;
+                        }
+                        submitSnapshotReader(reader_call, [this, pending, camera_id, field, deadline] {
+                            // A reader queued behind a hung camera starts late, the snapshot went on without it
+                            if (std::chrono::steady_clock::now() >= deadline) {
+                                return;
+                            }
+                            {
+                                std::lock_guard lock(pending->mutex);
+                                if (!pending->done) {
+                                    return;
+                                }
+                            }
+                            common::types::CameraSnapshot part;
+                            const auto result = readSnapshotSection(camera_id, field, part);
+
+                            std::unique_lock lock(pending->mutex);
+                            mergeSections(pending->snapshot, std::move(part));
+                            if (result.isError()) {
+                                pending->snapshot.errors.push_back(std::string(toString(field)) + ": " +
+                                                                   result.error().message);
+                            }
+                            pending->missing &= ~static_cast<common::types::SnapshotFields>(field);
+                            if (pending->missing == 0) {
+                                endWait(*pending, std::move(lock));
+                            }
+                        });
+                    }
+                    command_scheduler_->schedule(deadline, [pending](bool) {
+                        endWait(*pending, std::unique_lock(pending->mutex));
+                    });
+                }));
+                pending_cameras.push_back(std::move(pending));
             }
+            co_await common::async::whenAll(std::move(tasks));
 
-            return client->getVideoCapabilityState(capability);
+            std::vector<common::types::CameraSnapshot> snapshots;
+            snapshots.reserve(pending_cameras.size());
+            for (const auto& pending : pending_cameras) {
+                std::lock_guard lock(pending->mutex);
+                // A slow camera only loses the sections it did not deliver in time
+                for (const auto field : SNAPSHOT_FIELDS) {
+                    if (common::types::hasField(pending->missing, field)) {
+                        pending->snapshot.errors.push_back(std::string(toString(field)) + ": no response within " +
+                                                           std::to_string(camera_timeout.count()) + " ms");
+                    }
+                }
+                snapshots.push_back(pending->snapshot);
+            }
+            co_return ResultType::success(std::move(snapshots));
         } catch (const std::exception& e) {
-            return Result<bool>::error(
-                std::string("getVideoCapabilityState failed: ") + e.what());
+            co_return ResultType::error(std::string("getSystemSnapshot failed: ") + e.what());
+        }
+    }
+
+    std::vector<uint32_t> Core::configuredCameraIds() const {
+        std::set<uint32_t> camera_ids;
+        for (const auto* service : {"camera_service", "video_service"}) {
+            if (const auto it = infrastructure_config_.clients.find(service);
+                it != infrastructure_config_.clients.end()) {
+                for (const auto& instance : it->second.instances) {
+                    camera_ids.insert(instance.id);
+                }
+            }
+        }
+        return {camera_ids.begin(), camera_ids.end()};
+    }
+
+    Result<void> Core::readSnapshotSection(const uint32_t camera_id,
+                                           const common::types::SnapshotField field,
+                                           common::types::CameraSnapshot& part) const {
+        using common::types::SnapshotField;
+
+        switch (field) {
+        case SnapshotField::Zoom: {
+            auto zoom = getZoom(camera_id);
+            if (zoom.isError()) {
+                return Result<void>::error(zoom.error());
+            }
+            part.state.zoom_level = zoom.value();
+            return Result<void>::success();
+        }
+        case SnapshotField::Focus: {
+            auto focus = getFocus(camera_id);
+            if (focus.isError()) {
+                return Result<void>::error(focus.error());
+            }
+            part.state.focus_value = focus.value();
+            return Result<void>::success();
+        }
+        case SnapshotField::AutoFocus: {
+            auto auto_focus = getAutoFocus(camera_id);
+            if (auto_focus.isError()) {
+                return Result<void>::error(auto_focus.error());
+            }
+            part.state.auto_focus = auto_focus.value();
+            return Result<void>::success();
+        }
+        case SnapshotField::Stabilization: {
+            auto stabilization = getStabilization(camera_id);
+            if (stabilization.isError()) {
+                return Result<void>::error(stabilization.error());
+            }
+            part.state.stabilization = stabilization.value();
+            return Result<void>::success();
+        }
+        case SnapshotField::Capabilities: {
+            part.capabilities = capabilities_cache_.get(camera_id);
+            if (!part.capabilities) {
+                auto capabilities = getCapabilities(camera_id);
+                if (capabilities.isError()) {
+                    return Result<void>::error(capabilities.error());
+                }
+                capabilities_cache_.put(camera_id, capabilities.value());
+                part.capabilities = std::move(capabilities).value();
+            }
+            return Result<void>::success();
+        }
+        case SnapshotField::Info: {
+            part.device_info = info_cache_.get(camera_id);
+            if (!part.device_info) {
+                auto info = getInfo(camera_id);
+                if (info.isError()) {
+                    return Result<void>::error(info.error());
+                }
+                info_cache_.put(camera_id, info.value());
+                part.device_info = std::move(info).value();
+            }
+            return Result<void>::success();
+        }
+        case SnapshotField::VideoCapabilities: {
+            // The list of capabilities is static, their states are always read
+            auto names = video_capabilities_cache_.get(camera_id);
+            if (!names) {
+                auto video_capabilities = getVideoCapabilities(camera_id);
+                if (video_capabilities.isError()) {
+                    return Result<void>::error(video_capabilities.error());
+                }
+                video_capabilities_cache_.put(camera_id, video_capabilities.value());
+                names = std::move(video_capabilities).value();
+            }
+
+            std::vector<common::types::VideoCapabilityState> states;
+            states.reserve(names->size());
+            for (const auto& name : *names) {
+                auto state = getVideoCapabilityState(camera_id, name);
+                if (state.isError()) {
+                    return Result<void>::error(state.error().prefixed(name + ": "));
+                }
+                states.push_back({name, state.value()});
+            }
+            part.video_capabilities = std::move(states);
+            return Result<void>::success();
+        }
+        }
+        return Result<void>::error("Unknown snapshot field");
+    }
+
+    void Core::submitSnapshotReader(const common::state::CallContext& call, std::function<void()> read) const {
+        // Readers are dispatched at the priority of the snapshot call
+        snapshot_readers_->submit([read = std::move(read), call] {
+            common::state::CallContext::Scope scope(call);
+            read();
+        });
+    }
+
+    common::types::OperationResult Core::execute(const common::types::Operation& operation) const {
+        using common::types::OperationType;
+        const auto camera_id = operation.camera_id;
+
+        switch (operation.type) {
+        case OperationType::SetZoom:
+            return toOperationResult(setZoom(camera_id, operation.value));
+        case OperationType::GetZoom:
+            return toOperationResult(getZoom(camera_id));
+        case OperationType::GoToMinZoom:
+            return toOperationResult(goToMinZoom(camera_id));
+        case OperationType::GoToMaxZoom:
+            return toOperationResult(goToMaxZoom(camera_id));
+        case OperationType::SetFocus:
+            return toOperationResult(setFocus(camera_id, operation.value));
+        case OperationType::GetFocus:
+            return toOperationResult(getFocus(camera_id));
+        case OperationType::SetAutoFocus:
+            return toOperationResult(enableAutoFocus(camera_id, operation.enable));
+        case OperationType::GetAutoFocus:
+            return toOperationResult(getAutoFocus(camera_id));
+        case OperationType::GetInfo:
+            return toOperationResult(getInfo(camera_id));
+        case OperationType::GetCapabilities:
+            return toOperationResult(getCapabilities(camera_id));
+        case OperationType::SetStabilization:
+            return toOperationResult(stabilize(camera_id, operation.enable));
+        case OperationType::GetStabilization:
+            return toOperationResult(getStabilization(camera_id));
+        case OperationType::SetVideoCapabilityState:
+            return toOperationResult(SetVideoCapabilityState(camera_id, operation.capability, operation.enable));
+        case OperationType::GetVideoCapabilities:
+            return toOperationResult(getVideoCapabilities(camera_id));
+        case OperationType::GetVideoCapabilityState:
+            return toOperationResult(getVideoCapabilityState(camera_id, operation.capability));
+        default:
+            return common::types::OperationResult::error("Unknown operation");
         }
     }
 } // namespace service::core
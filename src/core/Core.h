@@ -1,12 +1,27 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
+#include <grpcpp/support/status.h>
 
 #include "common/types/CameraTypes.h"
 #include "common/types/Result.h"
 #include "common/config/ConfigManager.h"
+#include "core/BackendOperation.h"
 #include "core/ICore.h"
+#include "core/cache/ExpiringCache.h"
+#include "core/dispatch/CameraDispatcher.h"
+#include "core/macro/MacroRunner.h"
+#include "core/motion/ConvergenceWatcher.h"
+#include "core/motion/MotionScheduler.h"
+#include "core/schedule/CommandScheduler.h"
+#include "core/schedule/WorkerPool.h"
 
 namespace service::infrastructure {
     class GrpcClientManager;
@@ -14,9 +29,16 @@ namespace service::infrastructure {
 } // namespace service::infrastructure
 
 namespace service::core {
+    class CameraStateHub;
+    class IdempotencyTable;
+    class LeaseTable;
+    class PresetStore;
+    class Reconciler;
+
     class Core final : public ICore {
     public:
-        explicit Core(const common::InfrastructureConfig& infrastructure_config);
+        explicit Core(const common::InfrastructureConfig& infrastructure_config,
+                      const common::CoreConfig& core_config = {});
         ~Core() override;
 
         // ICore implementation
@@ -24,17 +46,49 @@ namespace service::core {
         Result<void> stop() override;
 
         // Business methods for zoom operations
-        Result<void> setZoom(uint32_t camera_id, common::types::zoom zoom_level) const override;
+        Result<common::types::zoom> setZoom(uint32_t camera_id, common::types::zoom zoom_level) const override;
         Result<common::types::zoom> getZoom(uint32_t camera_id) const override;
-        Result<void> goToMinZoom(uint32_t camera_id) const override;
-        Result<void> goToMaxZoom(uint32_t camera_id) const override;
+        Result<common::types::zoom> goToMinZoom(uint32_t camera_id) const override;
+        Result<common::types::zoom> goToMaxZoom(uint32_t camera_id) const override;
 
         // Business methods for focus operations
-        Result<void> setFocus(uint32_t camera_id, common::types::focus focus_value) const override;
+        Result<common::types::focus> setFocus(uint32_t camera_id, common::types::focus focus_value) const override;
         Result<common::types::focus> getFocus(uint32_t camera_id) const override;
         Result<void> enableAutoFocus(uint32_t camera_id, bool on) const override;
         Result<bool> getAutoFocus(uint32_t camera_id) const override;
 
+        // Absolute commands that wait for the backend without holding a thread
+        common::async::Task<Result<common::types::zoom>> setZoomAsync(
+            uint32_t camera_id, common::types::zoom zoom_level) const override;
+        common::async::Task<Result<common::types::focus>> setFocusAsync(
+            uint32_t camera_id, common::types::focus focus_value) const override;
+
+        // Relative and continuous motion, clamped to the normalized range
+        Result<common::types::zoom> stepZoom(uint32_t camera_id, int32_t delta) const override;
+        Result<common::types::focus> stepFocus(uint32_t camera_id, int32_t delta) const override;
+        Result<void> setZoomVelocity(uint32_t camera_id, double velocity,
+                                     std::chrono::milliseconds duration) const override;
+        Result<void> setFocusVelocity(uint32_t camera_id, double velocity,
+                                      std::chrono::milliseconds duration) const override;
+
+        // Absolute positioning that returns once the lens has reached the value or stopped moving
+        Result<common::types::Convergence> setZoomAndWait(
+            uint32_t camera_id,
+            common::types::zoom zoom_level,
+            uint32_t tolerance,
+            std::chrono::milliseconds timeout) const override;
+        Result<common::types::Convergence> setFocusAndWait(
+            uint32_t camera_id,
+            common::types::focus focus_value,
+            uint32_t tolerance,
+            std::chrono::milliseconds timeout) const override;
+        common::async::Task<Result<common::types::Convergence>> setZoomAndWaitAsync(
+            uint32_t camera_id, common::types::zoom zoom_level, uint32_t tolerance,
+            std::chrono::milliseconds timeout) const override;
+        common::async::Task<Result<common::types::Convergence>> setFocusAndWaitAsync(
+            uint32_t camera_id, common::types::focus focus_value, uint32_t tolerance,
+            std::chrono::milliseconds timeout) const override;
+
         // Business methods for info operations
         Result<common::types::info> getInfo(uint32_t camera_id) const override;
 
@@ -53,10 +107,290 @@ namespace service::core {
         Result<std::vector<std::string>> getVideoCapabilities(uint32_t camera_id) const override;
         Result<bool> getVideoCapabilityState(uint32_t camera_id, const std::string& capability) const override;
 
+        // Passthrough of serialized camera_service calls (routed by camera_id)
+        void forwardCameraCall(uint32_t camera_id, infrastructure::RawCall call) const override;
+
+        // State streaming, a snapshot of the watched fields followed by deltas
+        Result<std::shared_ptr<common::state::CameraStateSubscription>> watchCameraState(
+            uint32_t camera_id,
+            common::types::CameraStateFields fields) const override;
+
+        // Batched operations, results in operation order
+        std::vector<common::types::OperationResult> executeBatch(
+            const std::vector<common::types::Operation>& operations,
+            common::types::BatchOrdering ordering) const override;
+        common::async::Task<std::vector<common::types::OperationResult>> executeBatchAsync(
+            std::vector<common::types::Operation> operations,
+            common::types::BatchOrdering ordering) const override;
+
+        // Batched operations dispatched together at a requested time, with the achieved skew per camera
+        Result<common::types::ScheduledBatch> executeBatchAt(
+            const std::vector<common::types::Operation>& operations,
+            common::types::BatchOrdering ordering,
+            const common::types::ExecuteAt& execute_at) const override;
+        common::async::Task<Result<common::types::ScheduledBatch>> executeBatchAtAsync(
+            std::vector<common::types::Operation> operations,
+            common::types::BatchOrdering ordering,
+            common::types::ExecuteAt execute_at) const override;
+
+        // Full state of several cameras, gathered concurrently with a deadline per camera
+        Result<std::vector<common::types::CameraSnapshot>> getSystemSnapshot(
+            const std::vector<uint32_t>& camera_ids,
+            common::types::SnapshotFields fields) const override;
+        common::async::Task<Result<std::vector<common::types::CameraSnapshot>>> getSystemSnapshotAsync(
+            std::vector<uint32_t> camera_ids,
+            common::types::SnapshotFields fields) const override;
+
+        // Conditional read of one state field, long-polled when wait is set
+        Result<common::types::VersionedValue> getIfChanged(
+            uint32_t camera_id,
+            const common::types::StateField& field,
+            const common::types::ReadCondition& condition) const override;
+        common::async::Task<Result<common::types::VersionedValue>> getIfChangedAsync(
+            uint32_t camera_id,
+            common::types::StateField field,
+            common::types::ReadCondition condition) const override;
+
+        // Presets, named settings of several cameras applied in one call
+        Result<void> savePreset(const common::types::Preset& preset) const override;
+        Result<void> deletePreset(const std::string& name) const override;
+        Result<std::vector<common::types::Preset>> listPresets() const override;
+        Result<common::types::PresetRecall> recallPreset(
+            const std::vector<uint32_t>& camera_ids,
+            const std::string& name) const override;
+
+        // Macros, timed sequences of operations run on one camera with streamed progress
+        Result<std::shared_ptr<common::state::MacroExecution>> runMacro(
+            uint32_t camera_id,
+            const common::types::Macro& macro) const override;
+        Result<std::shared_ptr<common::state::MacroExecution>> runNamedMacro(
+            uint32_t camera_id,
+            const std::string& name) const override;
+        Result<void> cancelMacro(uint32_t camera_id) const override;
+
+        // Exclusive control, mutating calls of other clients are rejected while a lease is held
+        Result<common::types::ControlLease> acquireControl(
+            uint32_t camera_id,
+            std::chrono::milliseconds ttl) const override;
+        Result<common::types::ControlLease> renewControl(
+            uint32_t camera_id,
+            uint64_t lease_id,
+            std::chrono::milliseconds ttl) const override;
+        Result<void> releaseControl(uint32_t camera_id, uint64_t lease_id) const override;
+
+        // Admission of backend calls by priority class
+        Result<common::types::DispatchMetrics> getDispatchMetrics() const override;
+
+        // Desired-state mode, cameras found away from their last commanded state are restored
+        Result<common::types::ReconcileMetrics> getReconcileStatus() const override;
+
     private:
         bool isRunning() const;
+
+        /**
+         * Reject a mutating call unless the camera is free or the caller presents its lease, takes no lock
+         * Only valid while the core is running, the lease table goes with it
+         */
+        Result<void> checkControl(uint32_t camera_id) const;
+
+        /**
+         * Wait for a dispatch slot of a camera at the priority and fair share of the current call
+         * Hold the ticket only around the backend call, never across stopMotion
+         */
+        CameraDispatcher::Ticket admit(uint32_t camera_id) const;
+
+        /**
+         * Admit a passthrough call to its camera and forward it, the task ends with the status of the backend call
+         * @param context call context of the call, it is not current past the first suspension
+         */
+        common::async::Task<grpc::Status> forward(uint32_t camera_id, infrastructure::RawCall call,
+                                                  common::state::CallContext context) const;
+
+        /**
+         * Run a Set call once per idempotency key of the current call, calls without a key just run
+         */
+        template<typename T>
+        Result<T> idempotent(const common::types::Operation& operation, const std::function<Result<T>()>& run) const;
+
+        /**
+         * idempotent() for a call that responds through a task, run is dropped unstarted when the call is replayed
+         */
+        template<typename T>
+        common::async::Task<Result<T>> idempotentAsync(common::types::Operation operation,
+                                                       common::async::Task<Result<T>> run) const;
+
+        template<typename Client>
+        Client* clientOf(uint32_t camera_id) const;
+
+        /**
+         * Generic path of every BackendOperation: look up the client, wait for a dispatch slot, send, and record
+         * the state the result tells about
+         */
+        template<const auto& Operation, typename... Args>
+        BackendResult<Operation> call(uint32_t camera_id, const Args&... args) const;
+
+        /**
+         * Run a command of the current call, which must hold control of the camera
+         */
+        template<const auto& Operation, typename... Args>
+        BackendResult<Operation> command(uint32_t camera_id, const Args&... args) const;
+
+        /**
+         * command() on the asynchronous client call, keyed calls reach it through idempotentAsync()
+         * A running motion tick and a full dispatch queue are awaited: the call resumes on the motion thread, on
+         * the thread that freed its slot, or on the command scheduler at its deadline. The client call itself only
+         * blocks past the set rate limit, see RateLimitedCameraServiceClient
+         */
+        template<const auto& Operation, typename... Args>
+        common::async::Task<BackendResult<Operation>> commandAsync(uint32_t camera_id, Args... args) const;
+
+        /**
+         * Keep the camera state a successful call tells about, see StateEffect
+         */
+        template<const auto& Operation, typename T, typename... Args>
+        void record(uint32_t camera_id, const Result<T>& result, const Args&... args) const;
+
+        /**
+         * Send an absolute position to the backend without stopping a running motion
+         */
+        Result<common::types::zoom> applyZoom(uint32_t camera_id, common::types::zoom zoom_level) const;
+        Result<common::types::focus> applyFocus(uint32_t camera_id, common::types::focus focus_value) const;
+
+        /**
+         * Start, update or stop (velocity 0) the motion of one axis of a camera
+         */
+        Result<void> setVelocity(uint32_t camera_id, MotionScheduler::Axis axis, double velocity,
+                                 std::chrono::milliseconds duration) const;
+
+        /**
+         * Stop a motion so an absolute command is not overwritten by the next tick
+         */
+        void stopMotion(uint32_t camera_id, MotionScheduler::Axis axis) const;
+
+        /**
+         * stopMotion() without waiting for a running tick, stopped is called once no tick can overwrite a command
+         */
+        void stopMotion(uint32_t camera_id, MotionScheduler::Axis axis, std::function<void()> stopped) const;
+
+        /**
+         * Set an axis and wait on the shared convergence poll of its camera, the task resumes on the watcher thread
+         */
+        common::async::Task<Result<common::types::Convergence>> setAndWait(
+            uint32_t camera_id, MotionScheduler::Axis axis, uint32_t value, uint32_t tolerance,
+            std::chrono::milliseconds timeout) const;
+
+        /**
+         * @return convergence poll of a camera, created on first use
+         */
+        ConvergenceWatcher& convergenceWatcher(uint32_t camera_id) const;
+
+        /**
+         * Run one batch operation through the matching business method
+         */
+        common::types::OperationResult execute(const common::types::Operation& operation) const;
+
+        /**
+         * Run the lanes of a batch concurrently, results in operation order
+         * The awaiting thread runs the first lane and every lane no pool worker has picked up yet, the task ends on
+         * the thread that finished the last lane. Arguments must outlive the task
+         * With start set, every lane holds until then and the send time of each operation goes to dispatched
+         * @param call context the lanes act under
+         */
+        common::async::Task<std::vector<common::types::OperationResult>> runLanes(
+            const std::vector<common::types::Operation>& operations,
+            const std::vector<std::vector<std::size_t>>& lanes,
+            common::state::CallContext call,
+            std::optional<CommandScheduler::Clock::time_point> start,
+            std::vector<CommandScheduler::Clock::time_point>* dispatched) const;
+
+        /**
+         * Read every state field of a camera through call(), unreadable fields are left unset
+         */
+        common::types::CameraState readCameraState(uint32_t camera_id) const;
+
+        /**
+         * Feed a value confirmed by the backend to the state hub
+         */
+        void observe(uint32_t camera_id, const common::types::CameraState& state) const;
+
+        void observeVideo(uint32_t camera_id, const std::string& capability, bool enable) const;
+
+        /**
+         * Feed a value a command applied to the state hub, and in desired-state mode to the desired state
+         */
+        void commanded(uint32_t camera_id, const common::types::CameraState& state) const;
+
+        void commandedVideo(uint32_t camera_id, const std::string& capability, bool enable) const;
+
+        /**
+         * Read the fields set in desired from the backend, unreadable fields are left unset
+         */
+        common::types::DesiredState readDesired(uint32_t camera_id, const common::types::DesiredState& desired) const;
+
+        /**
+         * Read a field from its backend, the read reaches the state hub like any other
+         */
+        Result<void> readField(uint32_t camera_id, const common::types::StateField& field) const;
+
+        /**
+         * Wait until the generation of a field moves away from generation or wait elapses, the task resumes on the
+         * thread that published the change, on the hub poller or on a snapshot reader
+         * Video capability states are read on the readers pool, a backend call never runs on the hub poller
+         */
+        common::async::Task<Result<void>> waitForChange(uint32_t camera_id, common::types::StateField field,
+                                                        common::types::Generation generation,
+                                                        std::chrono::milliseconds wait) const;
+
+        /**
+         * Await CameraStateHub::onChange()
+         */
+        common::async::Task<std::optional<common::types::Generation>> changeOf(
+            uint32_t camera_id, common::types::StateField field, common::types::Generation generation,
+            std::chrono::steady_clock::time_point deadline) const;
+
+        /**
+         * @return ids of every configured camera_service and video_service instance, ascending
+         */
+        std::vector<uint32_t> configuredCameraIds() const;
+
+        /**
+         * Read one snapshot section of a camera into part, static sections go through the cache
+         */
+        Result<void> readSnapshotSection(uint32_t camera_id, common::types::SnapshotField field,
+                                         common::types::CameraSnapshot& part) const;
+
+        /**
+         * Queue a snapshot or long-polled read on the readers pool, stop() waits for readers that outlived their
+         * request
+         * @param call context the read acts for
+         */
+        void submitSnapshotReader(const common::state::CallContext& call, std::function<void()> read) const;
+
+        common::CoreConfig core_config_;
         common::InfrastructureConfig infrastructure_config_;
         std::unique_ptr<infrastructure::GrpcClientManager> client_manager_;
-        bool is_running_;
+        std::unique_ptr<CameraStateHub> state_hub_;
+        std::unique_ptr<PresetStore> preset_store_;
+        std::unique_ptr<CommandScheduler> command_scheduler_;
+        std::unique_ptr<WorkerPool> lanes_pool_; // runs the lanes of batches beyond the first
+        std::unique_ptr<WorkerPool> snapshot_readers_; // section reads of GetSystemSnapshot, long-polled reads
+        std::unique_ptr<LeaseTable> lease_table_;
+        std::unique_ptr<CameraDispatcher> dispatcher_;
+        std::unique_ptr<IdempotencyTable> idempotency_table_; // unset while idempotency keys are off
+        std::unique_ptr<Reconciler> reconciler_; // unset outside desired-state mode
+
+        mutable ExpiringCache<uint32_t, common::types::info> info_cache_;
+        mutable ExpiringCache<uint32_t, common::capabilities::CapabilityList> capabilities_cache_;
+        mutable ExpiringCache<uint32_t, std::vector<std::string>> video_capabilities_cache_;
+
+        mutable std::mutex motion_mutex_;
+        mutable std::unordered_map<uint32_t, std::unique_ptr<MotionScheduler>> motion_schedulers_; // by camera_id
+
+        mutable std::mutex convergence_mutex_;
+        mutable std::unordered_map<uint32_t, std::unique_ptr<ConvergenceWatcher>> convergence_watchers_; // by camera_id
+
+        mutable std::mutex macro_mutex_;
+        mutable std::unordered_map<uint32_t, std::unique_ptr<MacroRunner>> macro_runners_; // by camera_id
+        std::atomic<bool> is_running_; // read from the motion, watcher, pool and completion threads
     };
 } // namespace service::core
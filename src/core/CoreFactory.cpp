@@ -7,4 +7,9 @@ namespace service::core {
     std::unique_ptr<ICore> CoreFactory::createCore(const common::InfrastructureConfig& config) {
         return std::make_unique<Core>(config);
     }
+
+    std::unique_ptr<ICore> CoreFactory::createCore(const common::CoreConfig& core_config,
+                                                   const common::InfrastructureConfig& infrastructure_config) {
+        return std::make_unique<Core>(infrastructure_config, core_config);
+    }
 } // namespace service::core
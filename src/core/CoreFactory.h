@@ -3,6 +3,7 @@
 #include <memory>
 
 namespace service::common {
+    struct CoreConfig;
     struct InfrastructureConfig;
 } // namespace service::common
 
@@ -12,5 +13,7 @@ namespace service::core {
     class CoreFactory {
     public:
         static std::unique_ptr<ICore> createCore(const common::InfrastructureConfig& config);
+        static std::unique_ptr<ICore> createCore(const common::CoreConfig& core_config,
+                                                 const common::InfrastructureConfig& infrastructure_config);
     };
 } // namespace service::core
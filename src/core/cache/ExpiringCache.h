@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace service::core {
+    /**
+     * Thread-safe map whose entries expire a fixed time after they were stored
+     * A zero TTL disables the cache, nothing is stored
+     */
+    template<typename Key, typename Value>
+    class ExpiringCache {
+    public:
+        explicit ExpiringCache(const std::chrono::milliseconds ttl) : ttl_(ttl) {
+        }
+
+        /**
+         * @return the stored value, or nothing if it is missing or expired
+         */
+        std::optional<Value> get(const Key& key) const {
+            std::lock_guard lock(mutex_);
+            const auto it = entries_.find(key);
+            if (it == entries_.end() || Clock::now() >= it->second.expires_at) {
+                return std::nullopt;
+            }
+            return it->second.value;
+        }
+
+        void put(const Key& key, Value value) {
+            if (ttl_ <= std::chrono::milliseconds::zero()) {
+                return;
+            }
+            std::lock_guard lock(mutex_);
+            entries_.insert_or_assign(key, Entry{std::move(value), Clock::now() + ttl_});
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Entry {
+            Value value;
+            Clock::time_point expires_at;
+        };
+
+        const std::chrono::milliseconds ttl_;
+        mutable std::mutex mutex_;
+        std::unordered_map<Key, Entry> entries_;
+    };
+} // namespace service::core
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "common/config/ConfigManager.h"
+
+namespace service::core {
+    /**
+     * Concurrency limit of one backend adapted to the latency it answers in
+     * The no-load baseline is the lowest smoothed latency seen, drifting up slowly so a backend that became slower
+     * for good is eventually taken as it is. While latency stays within tolerance of the baseline the limit grows by
+     * one call per sample, as long as it is in use. Latency above it shrinks the limit by the ratio of the two, at most
+     * by half. Not thread-safe, the owner serialises samples
+     */
+    class AdaptiveLimit {
+    public:
+        AdaptiveLimit(const common::AdaptiveConcurrencyConfig& config, const std::size_t initial)
+            : config_(config),
+              limit_(static_cast<double>(std::clamp(initial, config.min_limit, config.max_limit))) {
+        }
+
+        /**
+         * Take the latency of a finished call into the limit
+         * @param in_flight calls running when it finished, itself included
+         */
+        void sample(const std::chrono::microseconds latency, const std::size_t in_flight) {
+            const auto observed = static_cast<double>(std::max<int64_t>(latency.count(), 1));
+            if (samples_++ == 0) {
+                latency_ = observed;
+                baseline_ = observed;
+            } else {
+                latency_ += (observed - latency_) * LATENCY_SMOOTHING;
+                baseline_ = latency_ < baseline_ ? latency_ : baseline_ + (latency_ - baseline_) * BASELINE_DRIFT;
+            }
+
+            const auto gradient = std::clamp(baseline_ * config_.tolerance / latency_, 0.5, 1.0);
+            double target = limit_ * gradient;
+            if (gradient >= 1.0) {
+                // A limit that is not in use says nothing about the capacity of the backend
+                if (static_cast<double>(in_flight) * 2 < limit_) {
+                    return;
+                }
+                target = limit_ + 1;
+            }
+            limit_ = std::clamp(limit_ + (target - limit_) * config_.smoothing,
+                                static_cast<double>(config_.min_limit), static_cast<double>(config_.max_limit));
+        }
+
+        /**
+         * @return calls allowed at once
+         */
+        std::size_t limit() const {
+            return static_cast<std::size_t>(limit_);
+        }
+
+        /**
+         * @return no-load latency the limit is kept near, zero before the first sample
+         */
+        std::chrono::microseconds baseline() const {
+            return std::chrono::microseconds(static_cast<int64_t>(baseline_));
+        }
+
+        /**
+         * @return smoothed latency of recent calls, zero before the first sample
+         */
+        std::chrono::microseconds latency() const {
+            return std::chrono::microseconds(static_cast<int64_t>(latency_));
+        }
+
+    private:
+        static constexpr double LATENCY_SMOOTHING = 0.25; // weight of a sample in the recent latency
+        static constexpr double BASELINE_DRIFT = 0.001; // share of the gap the baseline rises by per sample
+
+        const common::AdaptiveConcurrencyConfig config_;
+        double limit_;
+        double latency_{0};
+        double baseline_{0};
+        uint64_t samples_{0};
+    };
+} // namespace service::core
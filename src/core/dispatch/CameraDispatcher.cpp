@@ -0,0 +1,381 @@
+#include "CameraDispatcher.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "common/logger/Logger.h"
+
+namespace service::core {
+    namespace {
+        std::size_t indexOf(const common::types::Priority priority) {
+            return static_cast<std::size_t>(priority);
+        }
+
+        std::chrono::microseconds since(const CameraDispatcher::Clock::time_point time) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(CameraDispatcher::Clock::now() - time);
+        }
+    } // unnamed namespace
+
+    CameraDispatcher::Ticket::Ticket(CameraDispatcher* dispatcher, Gate* gate, const common::types::Priority priority,
+                                     const Clock::time_point arrived, common::types::Error error)
+        : dispatcher_(dispatcher), gate_(gate), priority_(priority), arrived_(arrived), error_(std::move(error)) {
+    }
+
+    CameraDispatcher::Ticket::Ticket(Ticket&& other) noexcept
+        : dispatcher_(other.dispatcher_), gate_(other.gate_), priority_(other.priority_), arrived_(other.arrived_),
+          error_(std::move(other.error_)) {
+        other.dispatcher_ = nullptr;
+        other.gate_ = nullptr;
+    }
+
+    CameraDispatcher::Ticket::~Ticket() {
+        if (!dispatcher_ || !admitted()) {
+            return;
+        }
+        dispatcher_->counters(priority_).latency.record(since(arrived_));
+        if (gate_) {
+            dispatcher_->release(*gate_);
+        }
+    }
+
+    bool CameraDispatcher::Ticket::admitted() const {
+        return error_.message.empty();
+    }
+
+    const common::types::Error& CameraDispatcher::Ticket::error() const {
+        return error_;
+    }
+
+    CameraDispatcher::Gate::Gate(const std::function<uint32_t(const std::string&)>& quantum, const bool gated)
+        : gated(gated), waiters{DeficitRoundRobin<Waiter*>(quantum), DeficitRoundRobin<Waiter*>(quantum),
+                  DeficitRoundRobin<Waiter*>(quantum)} {
+    }
+
+    CameraDispatcher::CameraDispatcher(const std::vector<uint32_t>& camera_ids, const common::DispatchConfig& config)
+        : config_(config) {
+        const auto caller_quantum = [this](const std::string& caller) { return quantum(caller); };
+        // Cameras get a gate even without max_in_flight, it keeps the counters of their callers
+        const auto gated = config_.max_in_flight != 0;
+        unknown_ = std::make_unique<Gate>(caller_quantum, false);
+        for (const auto camera_id : camera_ids) {
+            const auto [it, inserted] = gates_.try_emplace(camera_id, std::make_unique<Gate>(caller_quantum, gated));
+            if (inserted && gated && config_.adaptive.enabled) {
+                it->second->adaptive.emplace(config_.adaptive, config_.max_in_flight);
+            }
+        }
+    }
+
+    CameraDispatcher::Ticket CameraDispatcher::admit(const uint32_t camera_id,
+                                                     const common::state::CallContext& call) {
+        const auto arrived = Clock::now();
+        const auto it = gates_.find(camera_id);
+        auto& gate = it != gates_.end() ? *it->second : *unknown_;
+        Wakes wakes;
+        std::unique_lock lock(gate.mutex);
+        if (auto ticket = enter(camera_id, gate, call, arrived, lock, wakes)) {
+            return std::move(*ticket);
+        }
+
+        Waiter waiter;
+        auto& queue = gate.waiters[indexOf(call.priority)];
+        queue.push(call.caller, &waiter);
+        ++gate.queued;
+        if (!wakes.empty()) {
+            // An evicted call resumes by taking the gate mutex
+            lock.unlock();
+            wakeAll(wakes);
+            lock.lock();
+        }
+        if (!waiter.cv.wait_until(lock, call.deadline, [&waiter] { return waiter.state != WaiterState::Waiting; })) {
+            // The caller has given up, a slot handed to it now would only be wasted
+            queue.remove(call.caller, &waiter);
+            --gate.queued;
+            return shed(camera_id, gate, call, arrived, lock, "the call deadline passed while it was queued");
+        }
+        if (waiter.state == WaiterState::Shed) {
+            return shed(camera_id, gate, call, arrived, lock, "a higher priority call took its place");
+        }
+        return admitted(gate, call, arrived, lock);
+    }
+
+    common::async::Task<CameraDispatcher::Ticket> CameraDispatcher::admitAsync(const uint32_t camera_id,
+                                                                              const common::state::CallContext call,
+                                                                              CommandScheduler& scheduler) {
+        const auto arrived = Clock::now();
+        const auto it = gates_.find(camera_id);
+        auto& gate = it != gates_.end() ? *it->second : *unknown_;
+        Wakes wakes;
+        std::unique_lock lock(gate.mutex);
+        if (auto ticket = enter(camera_id, gate, call, arrived, lock, wakes)) {
+            co_return std::move(*ticket);
+        }
+
+        // The deadline timer may outlive the wait, it shares the waiter
+        const auto waiter = std::make_shared<Waiter>();
+        co_await common::async::fromCallback<bool>([&](auto complete) {
+            waiter->wake = [complete = std::move(complete)] { complete(true); };
+            gate.waiters[indexOf(call.priority)].push(call.caller, waiter.get());
+            ++gate.queued;
+            lock.unlock();
+            wakeAll(wakes);
+
+            if (call.deadline == Clock::time_point::max()) {
+                return;
+            }
+            scheduler.schedule(call.deadline, [&gate, waiter, priority = call.priority, caller = call.caller](bool) {
+                Wakes expired;
+                {
+                    std::lock_guard expire_lock(gate.mutex);
+                    if (waiter->state != WaiterState::Waiting) {
+                        return;
+                    }
+                    gate.waiters[indexOf(priority)].remove(caller, waiter.get());
+                    --gate.queued;
+                    waiter->state = WaiterState::Expired;
+                    notify(*waiter, expired);
+                }
+                wakeAll(expired);
+            });
+        });
+
+        lock.lock();
+        switch (waiter->state) {
+        case WaiterState::Expired:
+            co_return shed(camera_id, gate, call, arrived, lock, "the call deadline passed while it was queued");
+        case WaiterState::Shed:
+            co_return shed(camera_id, gate, call, arrived, lock, "a higher priority call took its place");
+        default:
+            co_return admitted(gate, call, arrived, lock);
+        }
+    }
+
+    std::optional<CameraDispatcher::Ticket> CameraDispatcher::enter(const uint32_t camera_id, Gate& gate,
+                                                                    const common::state::CallContext& call,
+                                                                    const Clock::time_point arrived,
+                                                                    std::unique_lock<std::mutex>& lock,
+                                                                    Wakes& wakes) {
+        if (!gate.gated) {
+            auto& caller_counters = callerCounters(gate, call.caller);
+            ++caller_counters.admitted;
+            caller_counters.queue_wait.record(std::chrono::microseconds::zero());
+            lock.unlock();
+            auto& class_counters = counters(call.priority);
+            class_counters.admitted.fetch_add(1, std::memory_order_relaxed);
+            class_counters.queue_wait.record(std::chrono::microseconds::zero());
+            return Ticket(this, nullptr, call.priority, arrived, {});
+        }
+
+        if (gate.in_flight < limitOf(gate)) {
+            ++gate.in_flight;
+            return admitted(gate, call, arrived, lock);
+        }
+        if (call.priority == common::types::Priority::Background &&
+            gate.waiters[indexOf(call.priority)].size() >= config_.background_max_queued) {
+            return shed(camera_id, gate, call, arrived, lock, "background queue is full");
+        }
+        if (gate.queued >= queueBoundOf(gate) && !evictBelow(gate, call.priority, wakes)) {
+            return shed(camera_id, gate, call, arrived, lock, "queue is full");
+        }
+        return std::nullopt;
+    }
+
+    CameraDispatcher::Ticket CameraDispatcher::admitted(Gate& gate, const common::state::CallContext& call,
+                                                        const Clock::time_point arrived,
+                                                        std::unique_lock<std::mutex>& lock) {
+        const auto waited = since(arrived);
+        auto& caller_counters = callerCounters(gate, call.caller);
+        ++caller_counters.admitted;
+        caller_counters.queue_wait.record(waited);
+        lock.unlock();
+        auto& class_counters = counters(call.priority);
+        class_counters.admitted.fetch_add(1, std::memory_order_relaxed);
+        class_counters.queue_wait.record(waited);
+        return {this, &gate, call.priority, arrived, {}};
+    }
+
+    common::types::DispatchMetrics CameraDispatcher::metrics() const {
+        common::types::DispatchMetrics metrics;
+        for (std::size_t index = 0; index < common::types::PRIORITY_COUNT; ++index) {
+            const auto& class_counters = counters_[index];
+            metrics.classes[index] = {.priority = static_cast<common::types::Priority>(index),
+                              .admitted = class_counters.admitted.load(std::memory_order_relaxed),
+                              .shed = class_counters.shed.load(std::memory_order_relaxed),
+                              .queue_wait = class_counters.queue_wait.summary(),
+                              .latency = class_counters.latency.summary()};
+        }
+
+        // Caller counters are kept per camera and reported summed up, in the order of their names
+        std::map<std::string, CallerCounters> callers;
+        const auto add_callers = [&callers](const Gate& gate) {
+            for (const auto& [caller, caller_counters] : gate.callers) {
+                auto& total = callers[caller];
+                total.admitted += caller_counters.admitted;
+                total.shed += caller_counters.shed;
+                total.queue_wait.add(caller_counters.queue_wait);
+            }
+        };
+
+        metrics.cameras.reserve(gates_.size());
+        for (const auto& [camera_id, gate] : gates_) {
+            std::lock_guard gate_lock(gate->mutex);
+            add_callers(*gate);
+            if (!gate->gated) {
+                continue;
+            }
+            metrics.cameras.push_back({.camera_id = camera_id,
+                                       .limit = limitOf(*gate),
+                                       .in_flight = gate->in_flight,
+                                       .queued = gate->queued,
+                                       .adaptive = gate->adaptive.has_value(),
+                                       .increases = gate->increases,
+                                       .decreases = gate->decreases,
+                                       .baseline = gate->adaptive ? gate->adaptive->baseline()
+                                                                  : std::chrono::microseconds::zero(),
+                                       .latency = gate->adaptive ? gate->adaptive->latency()
+                                                                 : std::chrono::microseconds::zero()});
+        }
+        std::sort(metrics.cameras.begin(), metrics.cameras.end(),
+                  [](const auto& left, const auto& right) { return left.camera_id < right.camera_id; });
+
+        {
+            std::lock_guard unknown_lock(unknown_->mutex);
+            add_callers(*unknown_);
+        }
+        metrics.callers.reserve(callers.size());
+        for (const auto& [caller, total] : callers) {
+            metrics.callers.push_back({.caller = caller,
+                                       .admitted = total.admitted,
+                                       .shed = total.shed,
+                                       .queue_wait = total.queue_wait.summary()});
+        }
+        return metrics;
+    }
+
+    void CameraDispatcher::sample(const uint32_t camera_id, const std::chrono::microseconds round_trip) {
+        const auto it = gates_.find(camera_id);
+        if (it == gates_.end() || !it->second->adaptive) {
+            return;
+        }
+
+        auto& gate = *it->second;
+        Wakes wakes;
+        {
+            std::lock_guard lock(gate.mutex);
+            const auto before = gate.adaptive->limit();
+            gate.adaptive->sample(round_trip, std::max<std::size_t>(gate.in_flight, 1));
+            if (const auto after = gate.adaptive->limit(); after != before) {
+                ++(after > before ? gate.increases : gate.decreases);
+                LOG_DEBUG("Concurrency limit of camera {} {} -> {} at {} us latency, baseline {} us", camera_id,
+                          before, after, gate.adaptive->latency().count(), gate.adaptive->baseline().count());
+                admitWaiters(gate, wakes);
+            }
+        }
+        wakeAll(wakes);
+    }
+
+    void CameraDispatcher::release(Gate& gate) {
+        Wakes wakes;
+        {
+            std::lock_guard lock(gate.mutex);
+            --gate.in_flight;
+            admitWaiters(gate, wakes);
+        }
+        wakeAll(wakes);
+    }
+
+    void CameraDispatcher::admitWaiters(Gate& gate, Wakes& wakes) {
+        // Once the limit has room, each slot passes to the next waiter and in_flight counts it back
+        while (gate.in_flight < limitOf(gate)) {
+            Waiter* next = nullptr;
+            for (auto& queue : gate.waiters) {
+                if (const auto waiting = queue.pop()) {
+                    next = *waiting;
+                    break;
+                }
+            }
+            if (!next) {
+                return;
+            }
+            --gate.queued;
+            ++gate.in_flight;
+            next->state = WaiterState::Admitted;
+            notify(*next, wakes);
+        }
+    }
+
+    void CameraDispatcher::notify(Waiter& waiter, Wakes& wakes) {
+        if (waiter.wake) {
+            wakes.push_back(std::exchange(waiter.wake, nullptr));
+        } else {
+            waiter.cv.notify_one();
+        }
+    }
+
+    void CameraDispatcher::wakeAll(Wakes& wakes) {
+        for (const auto& wake : std::exchange(wakes, {})) {
+            wake();
+        }
+    }
+
+    std::size_t CameraDispatcher::limitOf(const Gate& gate) const {
+        return gate.adaptive ? gate.adaptive->limit() : config_.max_in_flight;
+    }
+
+    std::size_t CameraDispatcher::queueBoundOf(const Gate& gate) const {
+        if (!gate.adaptive) {
+            return config_.max_queued;
+        }
+        return std::min(config_.max_queued, gate.adaptive->limit() * config_.adaptive.queue_per_limit);
+    }
+
+    bool CameraDispatcher::evictBelow(Gate& gate, const common::types::Priority priority, Wakes& wakes) {
+        for (auto index = common::types::PRIORITY_COUNT; index-- > indexOf(priority) + 1;) {
+            if (const auto evicted = gate.waiters[index].evictFromLongest()) {
+                auto* const victim = *evicted;
+                --gate.queued;
+                victim->state = WaiterState::Shed;
+                notify(*victim, wakes);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    CameraDispatcher::Ticket CameraDispatcher::shed(const uint32_t camera_id, const common::state::CallContext& call,
+                                                    const Clock::time_point arrived, const char* reason) {
+        counters(call.priority).shed.fetch_add(1, std::memory_order_relaxed);
+        LOG_DEBUG("Shed {} call of {} to camera {}: {}", common::types::toString(call.priority), call.caller,
+                  camera_id, reason);
+        return {this, nullptr, call.priority, arrived,
+                {common::types::ErrorCode::CallShed, "Camera " + std::to_string(camera_id) + " is overloaded, " +
+                                                         common::types::toString(call.priority) +
+                                                         " call was shed: " + reason}};
+    }
+
+    CameraDispatcher::Ticket CameraDispatcher::shed(const uint32_t camera_id, Gate& gate,
+                                                    const common::state::CallContext& call,
+                                                    const Clock::time_point arrived,
+                                                    std::unique_lock<std::mutex>& lock, const char* reason) {
+        ++callerCounters(gate, call.caller).shed;
+        lock.unlock();
+        return shed(camera_id, call, arrived, reason);
+    }
+
+    CameraDispatcher::ClassCounters& CameraDispatcher::counters(const common::types::Priority priority) {
+        return counters_[indexOf(priority)];
+    }
+
+    CameraDispatcher::CallerCounters& CameraDispatcher::callerCounters(Gate& gate, const std::string& caller) const {
+        if (const auto it = gate.callers.find(caller); it != gate.callers.end()) {
+            return it->second;
+        }
+        // Callers name themselves in metadata, so the table is capped rather than grown for every new name
+        return gate.callers[gate.callers.size() < config_.max_callers ? caller : std::string(OTHER_CALLERS)];
+    }
+
+    uint32_t CameraDispatcher::quantum(const std::string& caller) const {
+        const auto it = config_.caller_weights.find(caller);
+        return it == config_.caller_weights.end() ? 1 : it->second;
+    }
+} // namespace service::core
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/async/Task.h"
+#include "common/config/ConfigManager.h"
+#include "common/state/CallContext.h"
+#include "common/types/DispatchMetrics.h"
+#include "common/types/Error.h"
+#include "common/types/Priority.h"
+#include "core/dispatch/AdaptiveLimit.h"
+#include "core/dispatch/DeficitRoundRobin.h"
+#include "core/dispatch/LatencyHistogram.h"
+#include "core/schedule/CommandScheduler.h"
+
+namespace service::core {
+    /**
+     * Admission of backend calls per camera by priority class and caller
+     * At most max_in_flight calls of a camera run at once. Waiting calls are admitted highest class first,
+     * and within a class by deficit round-robin across callers so one busy caller cannot starve the others.
+     * Under load background calls are shed first: their own queue is bounded, and a full queue evicts the
+     * newest waiter of the busiest caller in the lowest class below an arriving call.
+     * A running call is never interrupted, preemption happens in the queue, and a waiter whose call deadline passes
+     * leaves it. Without max_in_flight no camera is gated. Caller metrics are kept per camera under the lock of its
+     * gate, so admission takes no lock shared by all cameras.
+     * With adaptive concurrency the limit of each camera follows the round trips of its backend calls, as measured
+     * by the clients around the stub call, so a backend that slows down under load gets fewer calls at once. Its
+     * queue shrinks with the limit, excess calls are shed on arrival rather than waiting for a slot that will not come
+     * in time
+     */
+    class CameraDispatcher {
+        struct Gate;
+
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Metrics of the callers past max_callers are reported under this name
+        static constexpr std::string_view OTHER_CALLERS = common::types::OTHER_CALLERS;
+
+        /**
+         * Admission of one call, the slot is held until the ticket is destroyed
+         */
+        class Ticket {
+        public:
+            Ticket(Ticket&& other) noexcept;
+            Ticket& operator=(Ticket&&) = delete;
+            ~Ticket();
+
+            bool admitted() const;
+
+            /**
+             * @return why the call was shed with the CallShed code, an empty message if it was admitted
+             */
+            const common::types::Error& error() const;
+
+        private:
+            friend class CameraDispatcher;
+
+            Ticket(CameraDispatcher* dispatcher, Gate* gate, common::types::Priority priority,
+                   Clock::time_point arrived, common::types::Error error);
+
+            CameraDispatcher* dispatcher_;
+            Gate* gate_; // null if the call was shed or its camera is not gated
+            common::types::Priority priority_;
+            Clock::time_point arrived_;
+            common::types::Error error_;
+        };
+
+        /**
+         * @param camera_ids cameras whose calls are gated, fixed for the lifetime of the dispatcher
+         */
+        CameraDispatcher(const std::vector<uint32_t>& camera_ids, const common::DispatchConfig& config);
+
+        CameraDispatcher(const CameraDispatcher&) = delete;
+        CameraDispatcher& operator=(const CameraDispatcher&) = delete;
+
+        /**
+         * Wait until a call to a camera may run, calls to cameras without a gate are admitted at once
+         * @param call priority, caller and deadline of the call
+         * @return ticket to hold for the duration of the backend call, not admitted if the call was shed
+         */
+        Ticket admit(uint32_t camera_id, const common::state::CallContext& call);
+
+        /**
+         * Await a slot for a call to a camera without holding the thread, admission is the same as admit()
+         * A queued call resumes on the thread that freed its slot or evicted it, or on the scheduler thread at its
+         * deadline
+         * @param call priority, caller and deadline of the call
+         * @param scheduler times out the wait at the call deadline
+         * @return ticket to hold for the duration of the backend call, not admitted if the call was shed
+         */
+        common::async::Task<Ticket> admitAsync(uint32_t camera_id, common::state::CallContext call,
+                                               CommandScheduler& scheduler);
+
+        /**
+         * Take the round trip of a backend call to a camera into its adaptive limit, no-op without one
+         * @param round_trip from sending the request to its reply, without any wait for admission or batching
+         */
+        void sample(uint32_t camera_id, std::chrono::microseconds round_trip);
+
+        common::types::DispatchMetrics metrics() const;
+
+    private:
+        enum class WaiterState {
+            Waiting,
+            Admitted,
+            Shed,
+            Expired // the deadline of an awaiting call passed
+        };
+
+        struct Waiter {
+            std::condition_variable cv;
+            WaiterState state{WaiterState::Waiting};
+            std::function<void()> wake; // resumes an awaiting call, unset for a blocked one, which is notified
+        };
+
+        // Wakes of awaiting calls whose state changed, run once the gate mutex is released
+        using Wakes = std::vector<std::function<void()>>;
+
+        struct CallerCounters {
+            uint64_t admitted{0};
+            uint64_t shed{0};
+            LatencyHistogram queue_wait;
+        };
+
+        struct Gate {
+            Gate(const std::function<uint32_t(const std::string&)>& quantum, bool gated);
+
+            const bool gated; // false if calls are admitted at once, the gate then only keeps caller counters
+            std::mutex mutex;
+            std::size_t in_flight{0};
+            std::size_t queued{0};
+            std::array<DeficitRoundRobin<Waiter*>, common::types::PRIORITY_COUNT> waiters; // by Priority, by caller
+            std::optional<AdaptiveLimit> adaptive; // unset if the limit is max_in_flight
+            uint64_t increases{0};
+            uint64_t decreases{0};
+            std::unordered_map<std::string, CallerCounters> callers; // never removed, bounded by max_callers
+        };
+
+        struct ClassCounters {
+            std::atomic<uint64_t> admitted{0};
+            std::atomic<uint64_t> shed{0};
+            LatencyHistogram queue_wait;
+            LatencyHistogram latency;
+        };
+
+        /**
+         * Admit the call at once if the limit has room, or shed it if it may not wait
+         * @return ticket of the call with lock released, nothing with lock held if the call has to wait
+         */
+        std::optional<Ticket> enter(uint32_t camera_id, Gate& gate, const common::state::CallContext& call,
+                                    Clock::time_point arrived, std::unique_lock<std::mutex>& lock, Wakes& wakes);
+
+        /**
+         * Ticket of a call given a slot of gate after waiting since arrived, releases lock
+         */
+        Ticket admitted(Gate& gate, const common::state::CallContext& call, Clock::time_point arrived,
+                        std::unique_lock<std::mutex>& lock);
+
+        /**
+         * Hand the slot of a finished call to the next waiter, or free it
+         * A limit lowered by sample() frees the slot instead of handing it on
+         */
+        void release(Gate& gate);
+
+        /**
+         * Admit waiters while the limit has room, gate mutex held
+         */
+        void admitWaiters(Gate& gate, Wakes& wakes);
+
+        /**
+         * Tell a waiter its state changed, gate mutex held
+         */
+        static void notify(Waiter& waiter, Wakes& wakes);
+
+        static void wakeAll(Wakes& wakes);
+
+        /**
+         * @return calls of a camera allowed at once, gate mutex held
+         */
+        std::size_t limitOf(const Gate& gate) const;
+
+        /**
+         * @return calls that may wait for a camera, gate mutex held
+         */
+        std::size_t queueBoundOf(const Gate& gate) const;
+
+        /**
+         * Evict the newest waiter of the busiest caller in the lowest class below priority
+         * @return false if every waiter is of priority or above
+         */
+        static bool evictBelow(Gate& gate, common::types::Priority priority, Wakes& wakes);
+
+        Ticket shed(uint32_t camera_id, const common::state::CallContext& call, Clock::time_point arrived,
+                    const char* reason);
+
+        /**
+         * Shed a call that reached gate, counted against its caller, releases lock
+         */
+        Ticket shed(uint32_t camera_id, Gate& gate, const common::state::CallContext& call, Clock::time_point arrived,
+                    std::unique_lock<std::mutex>& lock, const char* reason);
+
+        ClassCounters& counters(common::types::Priority priority);
+
+        /**
+         * @return counters of a caller at a gate, created on its first call, shared as OTHER_CALLERS past max_callers,
+         *         gate mutex held
+         */
+        CallerCounters& callerCounters(Gate& gate, const std::string& caller) const;
+
+        uint32_t quantum(const std::string& caller) const;
+
+        const common::DispatchConfig config_;
+        std::unordered_map<uint32_t, std::unique_ptr<Gate>> gates_; // by camera_id, never changes after construction
+        std::unique_ptr<Gate> unknown_; // counts the calls to cameras without a gate, never gated
+        std::array<ClassCounters, common::types::PRIORITY_COUNT> counters_; // by Priority
+    };
+} // namespace service::core
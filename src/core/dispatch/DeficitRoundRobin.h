@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace service::core {
+    /**
+     * Queues of several flows served by deficit round-robin, every item costs one unit
+     * A flow visited by the round gains its quantum and is served while its deficit covers an item, so
+     * over time each backlogged flow gets a share proportional to its quantum however much it queues.
+     * Not thread-safe
+     */
+    template<typename T>
+    class DeficitRoundRobin {
+    public:
+        /**
+         * @param quantum units a flow gains per round, at least 1
+         */
+        explicit DeficitRoundRobin(std::function<uint32_t(const std::string& flow)> quantum)
+            : quantum_(std::move(quantum)) {
+        }
+
+        void push(const std::string& flow, T item) {
+            auto [it, inserted] = flows_.try_emplace(flow);
+            if (it->second.items.empty()) {
+                active_.push_back(flow);
+            }
+            it->second.items.push_back(std::move(item));
+            ++size_;
+        }
+
+        /**
+         * @return next item in round-robin order, nothing if every queue is empty
+         */
+        std::optional<T> pop() {
+            while (!active_.empty()) {
+                const auto it = flows_.find(active_.front());
+                auto& flow = it->second;
+                if (!flow.visited) {
+                    flow.deficit += std::max<uint32_t>(quantum_(it->first), 1);
+                    flow.visited = true;
+                }
+                if (flow.deficit == 0) {
+                    // Quantum used up, the next flow's turn
+                    flow.visited = false;
+                    active_.push_back(std::move(active_.front()));
+                    active_.pop_front();
+                    continue;
+                }
+
+                --flow.deficit;
+                auto item = std::move(flow.items.front());
+                flow.items.pop_front();
+                --size_;
+                if (flow.items.empty()) {
+                    // An idle flow does not bank its deficit
+                    active_.pop_front();
+                    flows_.erase(it);
+                }
+                return item;
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * Remove the newest item of the flow with the most items queued
+         * @return the removed item, nothing if every queue is empty
+         */
+        std::optional<T> evictFromLongest() {
+            const auto longest = std::max_element(active_.begin(), active_.end(),
+                                                  [this](const std::string& left, const std::string& right) {
+                                                      return flows_.at(left).items.size() <
+                                                             flows_.at(right).items.size();
+                                                  });
+            if (longest == active_.end()) {
+                return std::nullopt;
+            }
+
+            const auto it = flows_.find(*longest);
+            auto item = std::move(it->second.items.back());
+            it->second.items.pop_back();
+            --size_;
+            if (it->second.items.empty()) {
+                active_.erase(longest);
+                flows_.erase(it);
+            }
+            return item;
+        }
+
+        /**
+         * Remove an item of a flow wherever it is queued
+         * @return false if the flow has no such item
+         */
+        bool remove(const std::string& flow, const T& item) {
+            const auto it = flows_.find(flow);
+            if (it == flows_.end()) {
+                return false;
+            }
+            auto& items = it->second.items;
+            const auto position = std::find(items.begin(), items.end(), item);
+            if (position == items.end()) {
+                return false;
+            }
+
+            items.erase(position);
+            --size_;
+            if (items.empty()) {
+                active_.erase(std::find(active_.begin(), active_.end(), flow));
+                flows_.erase(it);
+            }
+            return true;
+        }
+
+        std::size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+    private:
+        struct Flow {
+            std::deque<T> items; // oldest first
+            uint32_t deficit{0};
+            bool visited{false}; // the flow has had its quantum for the current turn
+        };
+
+        std::function<uint32_t(const std::string& flow)> quantum_;
+        std::unordered_map<std::string, Flow> flows_; // only flows with queued items
+        std::deque<std::string> active_; // round-robin order of flows with queued items
+        std::size_t size_{0};
+    };
+} // namespace service::core
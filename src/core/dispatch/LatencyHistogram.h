@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+#include "common/types/DispatchMetrics.h"
+
+namespace service::core {
+    /**
+     * Lock-free histogram of durations in power of two microsecond buckets
+     * Percentiles are accurate to within a factor of two, which is enough to tell classes apart
+     */
+    class LatencyHistogram {
+    public:
+        void record(const std::chrono::microseconds duration) {
+            const auto micros = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+            const auto bucket = std::min<std::size_t>(std::bit_width(micros), BUCKETS - 1);
+            buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+
+            auto max = max_.load(std::memory_order_relaxed);
+            while (micros > max && !max_.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+            }
+        }
+
+        /**
+         * Add the durations another histogram recorded, e.g. to report shards as one
+         */
+        void add(const LatencyHistogram& other) {
+            for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                buckets_[bucket].fetch_add(other.buckets_[bucket].load(std::memory_order_relaxed),
+                                           std::memory_order_relaxed);
+            }
+            const auto micros = other.max_.load(std::memory_order_relaxed);
+            auto max = max_.load(std::memory_order_relaxed);
+            while (micros > max && !max_.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+            }
+        }
+
+        common::types::LatencySummary summary() const {
+            std::array<uint64_t, BUCKETS> counts{};
+            common::types::LatencySummary summary;
+            for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                counts[bucket] = buckets_[bucket].load(std::memory_order_relaxed);
+                summary.count += counts[bucket];
+            }
+            summary.max = std::chrono::microseconds(max_.load(std::memory_order_relaxed));
+            summary.p50 = percentile(counts, summary.count, 50, summary.max);
+            summary.p99 = percentile(counts, summary.count, 99, summary.max);
+            return summary;
+        }
+
+    private:
+        // Bucket i holds durations below 2^i microseconds and at least half that, the last one everything longer
+        static constexpr std::size_t BUCKETS = 40;
+
+        static std::chrono::microseconds percentile(const std::array<uint64_t, BUCKETS>& counts, const uint64_t total,
+                                                    const uint64_t percent, const std::chrono::microseconds max) {
+            if (total == 0) {
+                return std::chrono::microseconds::zero();
+            }
+            const auto rank = (total * percent + 99) / 100;
+            uint64_t seen = 0;
+            for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                seen += counts[bucket];
+                if (seen >= rank) {
+                    return std::min(std::chrono::microseconds((int64_t{1} << bucket) - 1), max);
+                }
+            }
+            return max;
+        }
+
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+        std::atomic<uint64_t> max_{0};
+    };
+} // namespace service::core
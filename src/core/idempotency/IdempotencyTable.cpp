@@ -0,0 +1,227 @@
+#include "IdempotencyTable.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <vector>
+
+#include "common/logger/Logger.h"
+
+namespace service::core {
+    namespace {
+        bool sameOperation(const common::types::Operation& left, const common::types::Operation& right) {
+            return left.type == right.type && left.camera_id == right.camera_id && left.value == right.value &&
+                   left.enable == right.enable && left.capability == right.capability;
+        }
+
+        // The separator cannot appear in metadata values, so callers never share an id
+        std::string idOf(const std::string& caller, const std::string& key) {
+            return caller + '\n' + key;
+        }
+    } // unnamed namespace
+
+    /**
+     * Result of the call holding a key, waited for by its retries until their deadline
+     */
+    struct IdempotencyTable::Outcome {
+        /**
+         * Completion of an awaited retry, by the outcome or by its deadline whichever comes first
+         */
+        struct Waiter {
+            void operator()(common::types::OperationResult result) {
+                if (!done.exchange(true)) {
+                    complete(std::move(result));
+                }
+            }
+
+            std::atomic<bool> done{false};
+            std::function<void(common::types::OperationResult)> complete;
+        };
+
+        void complete(const common::types::OperationResult& value) {
+            std::vector<std::shared_ptr<Waiter>> waiting;
+            {
+                std::lock_guard lock(mutex);
+                result = value;
+                waiting.swap(waiters);
+            }
+            cv.notify_all();
+            for (const auto& waiter : waiting) {
+                (*waiter)(value);
+            }
+        }
+
+        common::types::OperationResult get(const std::string& key, const Clock::time_point deadline) {
+            std::unique_lock lock(mutex);
+            const auto completed = [this] { return result.has_value(); };
+            if (deadline == Clock::time_point::max()) {
+                cv.wait(lock, completed);
+            } else if (!cv.wait_until(lock, deadline, completed)) {
+                return stillRunning(key);
+            }
+            return *result;
+        }
+
+        static common::async::Task<common::types::OperationResult> wait(std::shared_ptr<Outcome> outcome,
+                                                                         std::string key,
+                                                                         const Clock::time_point deadline,
+                                                                         CommandScheduler& scheduler) {
+            return common::async::fromCallback<common::types::OperationResult>(
+                [outcome, key = std::move(key), deadline, &scheduler](auto complete) {
+                    std::unique_lock lock(outcome->mutex);
+                    if (outcome->result) {
+                        const auto result = *outcome->result;
+                        lock.unlock();
+                        complete(result);
+                        return;
+                    }
+                    auto waiter = std::make_shared<Waiter>();
+                    waiter->complete = std::move(complete);
+                    outcome->waiters.push_back(waiter);
+                    lock.unlock();
+
+                    if (deadline != Clock::time_point::max()) {
+                        scheduler.schedule(deadline, [waiter, key](bool) { (*waiter)(stillRunning(key)); });
+                    }
+                });
+        }
+
+        static common::types::OperationResult stillRunning(const std::string& key) {
+            return common::types::OperationResult::error(
+                {common::types::ErrorCode::DeadlineExceeded,
+                 "Call with idempotency key " + key + " is still running at the deadline"});
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::optional<common::types::OperationResult> result;
+        std::vector<std::shared_ptr<Waiter>> waiters; // awaited retries
+    };
+
+    IdempotencyTable::IdempotencyTable(const common::IdempotencyConfig& config, CommandScheduler& scheduler)
+        : config_(config), scheduler_(scheduler) {
+    }
+
+    common::types::OperationResult IdempotencyTable::run(
+        const std::string& caller, const std::string& key, const common::types::Operation& operation,
+        const Clock::time_point deadline, const std::function<common::types::OperationResult()>& execute) {
+        const auto id = idOf(caller, key);
+        const auto claimed = claim(id, caller, key, operation);
+        if (claimed.rejection) {
+            return *claimed.rejection;
+        }
+        if (!claimed.owner) {
+            return claimed.outcome ? claimed.outcome->get(key, deadline) : execute();
+        }
+
+        auto result = common::types::OperationResult::error("Call did not complete");
+        try {
+            result = execute();
+        } catch (const std::exception& e) {
+            result = common::types::OperationResult::error(e.what());
+        }
+        finish(id, *claimed.outcome, result);
+        return result;
+    }
+
+    common::async::Task<common::types::OperationResult> IdempotencyTable::runAsync(
+        const std::string caller, const std::string key, const common::types::Operation operation,
+        const Clock::time_point deadline, common::async::Task<common::types::OperationResult> execute) {
+        const auto id = idOf(caller, key);
+        const auto claimed = claim(id, caller, key, operation);
+        if (claimed.rejection) {
+            co_return *claimed.rejection;
+        }
+        if (claimed.outcome && !claimed.owner) {
+            co_return co_await Outcome::wait(claimed.outcome, key, deadline, scheduler_);
+        }
+        if (!claimed.owner) {
+            co_return co_await std::move(execute);
+        }
+
+        auto result = common::types::OperationResult::error("Call did not complete");
+        try {
+            result = co_await std::move(execute);
+        } catch (const std::exception& e) {
+            result = common::types::OperationResult::error(e.what());
+        }
+        finish(id, *claimed.outcome, result);
+        co_return result;
+    }
+
+    IdempotencyTable::Claim IdempotencyTable::claim(const std::string& id, const std::string& caller,
+                                                    const std::string& key,
+                                                    const common::types::Operation& operation) {
+        std::lock_guard lock(mutex_);
+        const auto now = Clock::now();
+        purge(now);
+
+        if (auto entry = entries_.find(id); entry != entries_.end()) {
+            if (entry->second.expires && *entry->second.expires <= now) {
+                erase(entry);
+            } else if (!sameOperation(entry->second.operation, operation)) {
+                return {.rejection = common::types::OperationResult::error("Idempotency key " + key +
+                                                                           " was used for a different operation")};
+            } else {
+                LOG_DEBUG("Replaying call of {} with idempotency key {}", caller, key);
+                return {.outcome = entry->second.outcome};
+            }
+        }
+
+        if (entries_.size() >= config_.max_entries && !evictOldest()) {
+            LOG_WARN("Idempotency table is full of running calls, key {} of {} is not remembered", key, caller);
+            return {};
+        }
+        auto outcome = std::make_shared<Outcome>();
+        order_.push_back(id);
+        entries_.emplace(id, Entry{.operation = operation,
+                                   .outcome = outcome,
+                                   .expires = std::nullopt,
+                                   .position = std::prev(order_.end())});
+        return {.outcome = std::move(outcome), .owner = true};
+    }
+
+    void IdempotencyTable::finish(const std::string& id, Outcome& outcome,
+                                  const common::types::OperationResult& result) {
+        {
+            // Running entries are never dropped by others, the entry is still ours
+            std::lock_guard lock(mutex_);
+            const auto entry = entries_.find(id);
+            if (result.isSuccess()) {
+                entry->second.expires = Clock::now() + config_.ttl;
+            } else {
+                erase(entry);
+            }
+        }
+        outcome.complete(result);
+    }
+
+    std::size_t IdempotencyTable::size() const {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+    void IdempotencyTable::purge(const Clock::time_point now) {
+        while (!order_.empty()) {
+            const auto entry = entries_.find(order_.front());
+            if (!entry->second.expires || *entry->second.expires > now) {
+                return;
+            }
+            erase(entry);
+        }
+    }
+
+    bool IdempotencyTable::evictOldest() {
+        for (const auto& id : order_) {
+            if (const auto entry = entries_.find(id); entry->second.expires) {
+                erase(entry);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void IdempotencyTable::erase(const std::unordered_map<std::string, Entry>::iterator entry) {
+        order_.erase(entry->second.position);
+        entries_.erase(entry);
+    }
+} // namespace service::core
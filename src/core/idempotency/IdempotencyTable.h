@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "common/async/Task.h"
+#include "common/config/ConfigManager.h"
+#include "common/types/BatchOperation.h"
+#include "core/schedule/CommandScheduler.h"
+
+namespace service::core {
+    /**
+     * Outcomes of keyed Set calls, so a call retried with its key reaches the camera at most once
+     * A retry of a call that is still running waits for its outcome, a retry of one that succeeded gets the
+     * same result until it expires, or fails with DeadlineExceeded at its own deadline. A failed call is forgotten
+     * and its retry runs again. Keys belong to a caller
+     */
+    class IdempotencyTable {
+    public:
+        using Clock = CommandScheduler::Clock;
+
+        /**
+         * @param scheduler ends awaited retries at their deadline, must outlive the table
+         */
+        IdempotencyTable(const common::IdempotencyConfig& config, CommandScheduler& scheduler);
+
+        IdempotencyTable(const IdempotencyTable&) = delete;
+        IdempotencyTable& operator=(const IdempotencyTable&) = delete;
+
+        /**
+         * Run a call unless its key already has one running or remembered
+         * A full table whose entries are all running runs the call without remembering it
+         * @param operation what the call does, a key reused for a different operation is rejected
+         * @param deadline of the call, the latest a retry waits for the call holding its key
+         * @param execute runs the call on this thread, at most once
+         */
+        common::types::OperationResult run(const std::string& caller, const std::string& key,
+                                           const common::types::Operation& operation, Clock::time_point deadline,
+                                           const std::function<common::types::OperationResult()>& execute);
+
+        /**
+         * run() for a call that responds through a task, a retry of a running call awaits it without a thread
+         * @param execute started at most once, dropped unstarted when the call is replayed
+         */
+        common::async::Task<common::types::OperationResult> runAsync(
+            std::string caller, std::string key, common::types::Operation operation, Clock::time_point deadline,
+            common::async::Task<common::types::OperationResult> execute);
+
+        /**
+         * @return keys running or remembered, expired ones may still be counted
+         */
+        std::size_t size() const;
+
+    private:
+        struct Outcome;
+
+        struct Entry {
+            common::types::Operation operation;
+            std::shared_ptr<Outcome> outcome; // completed once the call ran
+            std::optional<Clock::time_point> expires; // set once the call succeeded
+            std::list<std::string>::iterator position; // in order_
+        };
+
+        /**
+         * Key of a call taken by it, or by the call whose outcome it replays
+         */
+        struct Claim {
+            std::optional<common::types::OperationResult> rejection; // set if the key belongs to another operation
+            std::shared_ptr<Outcome> outcome; // of the call holding the key, unset if the call is not remembered
+            bool owner{false};                // the call holds the key and completes outcome
+        };
+
+        /**
+         * Take the key for a call unless another call holds it
+         */
+        Claim claim(const std::string& id, const std::string& caller, const std::string& key,
+                    const common::types::Operation& operation);
+
+        /**
+         * Remember the result of a call holding its key, or forget the key if it failed, then complete its outcome
+         */
+        void finish(const std::string& id, Outcome& outcome, const common::types::OperationResult& result);
+
+        /**
+         * Drop expired entries from the front of the insertion order, under mutex_
+         */
+        void purge(Clock::time_point now);
+
+        /**
+         * Drop the oldest completed entry, under mutex_
+         * @return false if every entry is still running
+         */
+        bool evictOldest();
+
+        void erase(std::unordered_map<std::string, Entry>::iterator entry);
+
+        const common::IdempotencyConfig config_;
+        CommandScheduler& scheduler_;
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_; // by caller and key
+        std::list<std::string> order_; // entry ids, oldest first
+    };
+} // namespace service::core
@@ -0,0 +1,141 @@
+#include "LeaseTable.h"
+
+#include "common/logger/Logger.h"
+
+namespace service::core {
+    LeaseTable::LeaseTable(const std::vector<uint32_t>& camera_ids, const common::LeasesConfig& config,
+                           CommandScheduler& scheduler)
+        : config_(config), scheduler_(scheduler), random_(std::random_device{}()) {
+        for (const auto camera_id : camera_ids) {
+            slots_.emplace(camera_id, std::make_unique<Slot>());
+        }
+    }
+
+    Result<common::types::ControlLease> LeaseTable::acquire(const uint32_t camera_id,
+                                                            const std::chrono::milliseconds ttl) {
+        using ResultType = Result<common::types::ControlLease>;
+        auto* const camera = slot(camera_id);
+        if (!camera) {
+            return ResultType::error("Unknown camera " + std::to_string(camera_id));
+        }
+
+        uint64_t lease_id = 0;
+        {
+            // Unguessable, so another client cannot present it by accident
+            std::lock_guard lock(random_mutex_);
+            while (lease_id == 0) {
+                lease_id = random_();
+            }
+        }
+
+        const auto granted = grantedTtl(ttl);
+        const auto now = Clock::now();
+        {
+            std::lock_guard lock(camera->mutex);
+            if (camera->lease_id.load() != 0 && !expired(*camera, now)) {
+                return ResultType::error(common::types::controlledByAnotherClient(camera_id));
+            }
+            camera->expires.store((now + granted).time_since_epoch().count());
+            camera->lease_id.store(lease_id, std::memory_order_release);
+        }
+        scheduleExpiry(camera_id, *camera, lease_id, now + granted);
+
+        LOG_DEBUG("Camera {} leased for {} ms", camera_id, granted.count());
+        return ResultType::success({.camera_id = camera_id, .lease_id = lease_id, .ttl = granted});
+    }
+
+    Result<common::types::ControlLease> LeaseTable::renew(const uint32_t camera_id, const uint64_t lease_id,
+                                                          const std::chrono::milliseconds ttl) {
+        using ResultType = Result<common::types::ControlLease>;
+        auto* const camera = slot(camera_id);
+        if (!camera) {
+            return ResultType::error("Unknown camera " + std::to_string(camera_id));
+        }
+
+        const auto granted = grantedTtl(ttl);
+        const auto now = Clock::now();
+        {
+            std::lock_guard lock(camera->mutex);
+            if (lease_id == 0 || camera->lease_id.load() != lease_id || expired(*camera, now)) {
+                return ResultType::error("Lease on camera " + std::to_string(camera_id) + " is not held");
+            }
+            // The pending expiry timer finds the later time and waits again
+            camera->expires.store((now + granted).time_since_epoch().count());
+        }
+        return ResultType::success({.camera_id = camera_id, .lease_id = lease_id, .ttl = granted});
+    }
+
+    Result<void> LeaseTable::release(const uint32_t camera_id, const uint64_t lease_id) {
+        auto* const camera = slot(camera_id);
+        if (!camera) {
+            return Result<void>::error("Unknown camera " + std::to_string(camera_id));
+        }
+
+        std::lock_guard lock(camera->mutex);
+        if (lease_id == 0 || camera->lease_id.load() != lease_id) {
+            return Result<void>::error("Lease on camera " + std::to_string(camera_id) + " is not held");
+        }
+        camera->lease_id.store(0, std::memory_order_release);
+        LOG_DEBUG("Camera {} lease released", camera_id);
+        return Result<void>::success();
+    }
+
+    bool LeaseTable::permits(const uint32_t camera_id, const uint64_t lease_id) const {
+        const auto* const camera = slot(camera_id);
+        if (!camera) {
+            return true;
+        }
+        const auto holder = camera->lease_id.load(std::memory_order_acquire);
+        return holder == 0 || holder == lease_id || expired(*camera, Clock::now());
+    }
+
+    uint64_t LeaseTable::holder(const uint32_t camera_id) const {
+        const auto* const camera = slot(camera_id);
+        if (!camera) {
+            return 0;
+        }
+        const auto holder = camera->lease_id.load(std::memory_order_acquire);
+        return expired(*camera, Clock::now()) ? 0 : holder;
+    }
+
+    LeaseTable::Slot* LeaseTable::slot(const uint32_t camera_id) const {
+        const auto entry = slots_.find(camera_id);
+        return entry == slots_.end() ? nullptr : entry->second.get();
+    }
+
+    std::chrono::milliseconds LeaseTable::grantedTtl(const std::chrono::milliseconds ttl) const {
+        if (ttl <= std::chrono::milliseconds::zero()) {
+            return config_.default_ttl;
+        }
+        return std::min(ttl, config_.max_ttl);
+    }
+
+    void LeaseTable::scheduleExpiry(const uint32_t camera_id, Slot& slot, const uint64_t lease_id,
+                                    const Clock::time_point expires) {
+        scheduler_.schedule(expires, [this, camera_id, &slot, lease_id](const bool fired) {
+            if (!fired) {
+                return;
+            }
+
+            Clock::time_point renewed_until;
+            {
+                std::lock_guard lock(slot.mutex);
+                if (slot.lease_id.load() != lease_id) {
+                    // Released, or expired and granted again with its own timer
+                    return;
+                }
+                if (expired(slot, Clock::now())) {
+                    slot.lease_id.store(0, std::memory_order_release);
+                    LOG_INFO("Camera {} lease expired", camera_id);
+                    return;
+                }
+                renewed_until = Clock::time_point(Clock::duration(slot.expires.load()));
+            }
+            scheduleExpiry(camera_id, slot, lease_id, renewed_until);
+        });
+    }
+
+    bool LeaseTable::expired(const Slot& slot, const Clock::time_point now) {
+        return now.time_since_epoch().count() >= slot.expires.load(std::memory_order_relaxed);
+    }
+} // namespace service::core
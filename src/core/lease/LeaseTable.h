@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config/ConfigManager.h"
+#include "common/types/ControlLease.h"
+#include "common/types/Result.h"
+#include "core/schedule/CommandScheduler.h"
+
+namespace service::core {
+    /**
+     * Control leases of the configured cameras, at most one holder per camera
+     * Checking a lease takes no lock, granting, renewing and releasing one are serialized per camera.
+     * Expired leases are cleared by a timer, until then the check already treats them as free
+     */
+    class LeaseTable {
+    public:
+        using Clock = CommandScheduler::Clock;
+
+        /**
+         * @param camera_ids cameras that can be leased, fixed for the lifetime of the table
+         * @param scheduler runs the expiry timers, must outlive the table
+         */
+        LeaseTable(const std::vector<uint32_t>& camera_ids, const common::LeasesConfig& config,
+                   CommandScheduler& scheduler);
+
+        LeaseTable(const LeaseTable&) = delete;
+        LeaseTable& operator=(const LeaseTable&) = delete;
+
+        /**
+         * Grant a new lease on a camera nobody holds
+         * @param ttl 0 for the default lifetime, capped at the maximum
+         */
+        Result<common::types::ControlLease> acquire(uint32_t camera_id, std::chrono::milliseconds ttl);
+
+        /**
+         * Restart the lifetime of a lease that has not expired
+         */
+        Result<common::types::ControlLease> renew(uint32_t camera_id, uint64_t lease_id,
+                                                  std::chrono::milliseconds ttl);
+
+        Result<void> release(uint32_t camera_id, uint64_t lease_id);
+
+        /**
+         * @return true if nobody holds the camera or lease_id holds it, cameras without a slot are free
+         */
+        bool permits(uint32_t camera_id, uint64_t lease_id) const;
+
+        /**
+         * @return lease holding a camera, 0 if nobody holds it
+         */
+        uint64_t holder(uint32_t camera_id) const;
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> lease_id{0};    // 0 while nobody holds the camera
+            std::atomic<Clock::rep> expires{0};   // steady clock ticks, stored before lease_id is published
+            std::mutex mutex;                     // serializes writers of the slot
+        };
+
+        Slot* slot(uint32_t camera_id) const;
+
+        std::chrono::milliseconds grantedTtl(std::chrono::milliseconds ttl) const;
+
+        /**
+         * Clear the lease at its expiry, a lease renewed meanwhile is checked again at its new expiry
+         */
+        void scheduleExpiry(uint32_t camera_id, Slot& slot, uint64_t lease_id, Clock::time_point expires);
+
+        static bool expired(const Slot& slot, Clock::time_point now);
+
+        const common::LeasesConfig config_;
+        CommandScheduler& scheduler_;
+        std::unordered_map<uint32_t, std::unique_ptr<Slot>> slots_; // by camera_id, never changes after construction
+
+        std::mutex random_mutex_;
+        std::mt19937_64 random_;
+    };
+} // namespace service::core
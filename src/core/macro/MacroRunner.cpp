@@ -0,0 +1,207 @@
+#include "MacroRunner.h"
+
+#include <variant>
+
+#include "common/logger/Logger.h"
+#include "core/schedule/PreciseWait.h"
+
+namespace service::core {
+    namespace {
+        const char* toString(const MacroRunner::Axis axis) {
+            return axis == MacroRunner::Axis::Zoom ? "zoom" : "focus";
+        }
+
+        const char* toString(const common::types::MacroStatus status) {
+            switch (status) {
+            case common::types::MacroStatus::Running:
+                return "running";
+            case common::types::MacroStatus::Completed:
+                return "completed";
+            case common::types::MacroStatus::Failed:
+                return "failed";
+            case common::types::MacroStatus::Cancelled:
+                return "cancelled";
+            }
+            return "unknown";
+        }
+
+        /**
+         * @return axis whose position an operation sets, nothing for other operations
+         */
+        std::optional<MacroRunner::Axis> positionedAxis(const common::types::OperationType type) {
+            switch (type) {
+            case common::types::OperationType::SetZoom:
+            case common::types::OperationType::GoToMinZoom:
+            case common::types::OperationType::GoToMaxZoom:
+                return MacroRunner::Axis::Zoom;
+            case common::types::OperationType::SetFocus:
+                return MacroRunner::Axis::Focus;
+            default:
+                return std::nullopt;
+            }
+        }
+    } // unnamed namespace
+
+    MacroRunner::MacroRunner(const uint32_t camera_id, common::types::Macro macro, Actions actions,
+                             const std::chrono::milliseconds max_await,
+                             std::shared_ptr<common::state::MacroExecution> execution)
+        : camera_id_(camera_id), macro_(std::move(macro)), actions_(std::move(actions)), max_await_(max_await),
+          execution_(std::move(execution)) {
+        worker_ = std::jthread([this] { run(); });
+    }
+
+    MacroRunner::~MacroRunner() {
+        stop();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void MacroRunner::stop() {
+        execution_->stop();
+    }
+
+    bool MacroRunner::isRunning() const {
+        return running_;
+    }
+
+    const std::string& MacroRunner::name() const {
+        return macro_.name;
+    }
+
+    void MacroRunner::run() {
+        LOG_DEBUG("Macro {} started on camera {}", macro_.name, camera_id_);
+        started_ = Clock::now();
+
+        auto status = common::types::MacroStatus::Completed;
+        switch (runSteps(macro_.steps)) {
+        case Outcome::Completed:
+            break;
+        case Outcome::Failed:
+            status = common::types::MacroStatus::Failed;
+            break;
+        case Outcome::Cancelled:
+            status = common::types::MacroStatus::Cancelled;
+            break;
+        }
+        // A caller that saw the final report may start the next macro on this camera right away
+        running_ = false;
+        report(status, std::nullopt, error_);
+        execution_->close();
+
+        LOG_DEBUG("Macro {} on camera {} {} after {} steps", macro_.name, camera_id_, toString(status), sequence_);
+    }
+
+    MacroRunner::Outcome MacroRunner::runSteps(const std::vector<common::types::MacroStep>& steps) {
+        // A sequence that does not complete leaves path and iterations at the step where it ended
+        for (std::size_t index = 0; index < steps.size(); ++index) {
+            if (execution_->stopRequested()) {
+                return Outcome::Cancelled;
+            }
+
+            const auto& step = steps[index];
+            path_.push_back(static_cast<uint32_t>(index));
+            if (step.type == common::types::MacroStepType::Repeat) {
+                iterations_.push_back(0);
+                for (uint32_t iteration = 0; iteration < step.count; ++iteration) {
+                    iterations_.back() = iteration;
+                    if (const auto outcome = runSteps(step.steps); outcome != Outcome::Completed) {
+                        return outcome;
+                    }
+                }
+                iterations_.pop_back();
+            } else {
+                const auto result = runStep(step);
+                ++sequence_;
+                if (result.isError()) {
+                    if (execution_->stopRequested()) {
+                        return Outcome::Cancelled;
+                    }
+                    error_ = result.error().message;
+                    return Outcome::Failed;
+                }
+                report(common::types::MacroStatus::Running, result.value());
+            }
+            path_.pop_back();
+        }
+        return Outcome::Completed;
+    }
+
+    Result<std::optional<uint32_t>> MacroRunner::runStep(const common::types::MacroStep& step) {
+        using common::types::MacroStepType;
+        using ResultType = Result<std::optional<uint32_t>>;
+
+        switch (step.type) {
+        case MacroStepType::Operation: {
+            auto operation = step.operation;
+            operation.camera_id = camera_id_;
+            const auto result = actions_.execute(operation);
+            if (result.isError()) {
+                return ResultType::error(result.error());
+            }
+            const auto* const position = std::get_if<uint32_t>(&result.value());
+            if (!position) {
+                return ResultType::success(std::optional<uint32_t>{});
+            }
+            if (const auto axis = positionedAxis(operation.type)) {
+                applied_[static_cast<std::size_t>(*axis)] = *position;
+            }
+            return ResultType::success(std::optional<uint32_t>{*position});
+        }
+        case MacroStepType::ZoomStep:
+        case MacroStepType::FocusStep: {
+            const auto axis = step.type == MacroStepType::ZoomStep ? Axis::Zoom : Axis::Focus;
+            const auto result = actions_.step(axis, step.delta);
+            if (result.isError()) {
+                return ResultType::error(result.error());
+            }
+            applied_[static_cast<std::size_t>(axis)] = result.value();
+            return ResultType::success(std::optional<uint32_t>{result.value()});
+        }
+        case MacroStepType::Wait: {
+            const auto waited = preciseWaitUntil(Clock::now() + step.duration, [this](const auto time) {
+                return !execution_->waitForStop(time);
+            });
+            if (!waited) {
+                return ResultType::error("Macro was stopped");
+            }
+            return ResultType::success(std::optional<uint32_t>{});
+        }
+        case MacroStepType::AwaitZoom:
+        case MacroStepType::AwaitFocus: {
+            const auto axis = step.type == MacroStepType::AwaitZoom ? Axis::Zoom : Axis::Focus;
+            const auto target = applied_[static_cast<std::size_t>(axis)];
+            if (!target) {
+                return ResultType::error(std::string("No ") + toString(axis) + " was set before awaiting it");
+            }
+
+            const auto timeout = step.timeout <= std::chrono::milliseconds::zero()
+                                     ? max_await_
+                                     : std::min(step.timeout, max_await_);
+            const auto result = actions_.await(axis, *target, step.tolerance, Clock::now() + timeout);
+            if (result.isError()) {
+                return ResultType::error(result.error());
+            }
+            if (result.value().status == common::types::ConvergenceStatus::TimedOut) {
+                return ResultType::error(std::string(toString(axis)) + " did not converge within " +
+                                         std::to_string(timeout.count()) + " ms");
+            }
+            return ResultType::success(std::optional<uint32_t>{result.value().value});
+        }
+        case MacroStepType::Repeat:
+            break;
+        }
+        return ResultType::error("Unknown macro step");
+    }
+
+    void MacroRunner::report(const common::types::MacroStatus status, const std::optional<uint32_t> value,
+                             std::string error) {
+        execution_->push({.status = status,
+                          .sequence = sequence_,
+                          .path = path_,
+                          .iterations = iterations_,
+                          .elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started_),
+                          .value = value,
+                          .error = std::move(error)});
+    }
+} // namespace service::core
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/state/MacroExecution.h"
+#include "common/types/BatchOperation.h"
+#include "common/types/Convergence.h"
+#include "common/types/Macro.h"
+#include "common/types/Result.h"
+#include "core/motion/MotionScheduler.h"
+
+namespace service::core {
+    /**
+     * Runs one macro on one camera on its own thread, reporting every step to its execution
+     * Waits are timed to within a few microseconds and end early when the run is stopped. An await checks
+     * for a stop only once it ends, which is bounded by its timeout
+     */
+    class MacroRunner {
+    public:
+        using Axis = MotionScheduler::Axis;
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Commands a macro sends to its camera, called from the runner thread
+         */
+        struct Actions {
+            std::function<common::types::OperationResult(const common::types::Operation& operation)> execute;
+            std::function<Result<uint32_t>(Axis axis, int32_t delta)> step;
+            std::function<Result<common::types::Convergence>(Axis axis, uint32_t target, uint32_t tolerance,
+                                                             Clock::time_point deadline)> await;
+        };
+
+        /**
+         * @param camera_id camera every step runs on
+         * @param macro steps to run, assumed valid
+         * @param actions commands of the steps
+         * @param max_await timeout of awaits that set none, and the upper bound of those that do
+         * @param execution receives the reports, stopping it stops the run
+         */
+        MacroRunner(uint32_t camera_id, common::types::Macro macro, Actions actions,
+                    std::chrono::milliseconds max_await, std::shared_ptr<common::state::MacroExecution> execution);
+
+        /**
+         * Stop the run and wait for its thread, the run is reported as cancelled if it had not ended
+         */
+        ~MacroRunner();
+
+        MacroRunner(const MacroRunner&) = delete;
+        MacroRunner& operator=(const MacroRunner&) = delete;
+
+        /**
+         * Ask the run to stop, returns at once
+         */
+        void stop();
+
+        /**
+         * @return false once the run is about to queue its final report
+         */
+        bool isRunning() const;
+
+        const std::string& name() const;
+
+    private:
+        enum class Outcome {
+            Completed,
+            Failed,
+            Cancelled
+        };
+
+        void run();
+
+        /**
+         * Run a sequence of steps, recursing into repeats
+         */
+        Outcome runSteps(const std::vector<common::types::MacroStep>& steps);
+
+        /**
+         * Run one step other than a repeat
+         * @return value after the step if it has one, an error if the step failed
+         */
+        Result<std::optional<uint32_t>> runStep(const common::types::MacroStep& step);
+
+        /**
+         * Queue a report for the step or the run, path and iterations are taken as they are now
+         */
+        void report(common::types::MacroStatus status, std::optional<uint32_t> value, std::string error = {});
+
+        const uint32_t camera_id_;
+        const common::types::Macro macro_;
+        const Actions actions_;
+        const std::chrono::milliseconds max_await_;
+        const std::shared_ptr<common::state::MacroExecution> execution_;
+
+        // Runner thread only
+        Clock::time_point started_;
+        uint64_t sequence_{0};
+        std::vector<uint32_t> path_;
+        std::vector<uint32_t> iterations_;
+        std::string error_;
+        std::array<std::optional<uint32_t>, 2> applied_; // last position set by the macro, indexed by Axis
+
+        std::atomic<bool> running_{true};
+        std::jthread worker_;
+    };
+} // namespace service::core
@@ -0,0 +1,215 @@
+#include "ConvergenceWatcher.h"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+
+#include "common/logger/Logger.h"
+
+namespace service::core {
+    namespace {
+        constexpr ConvergenceWatcher::Axis AXES[] = {ConvergenceWatcher::Axis::Zoom, ConvergenceWatcher::Axis::Focus};
+
+        uint32_t distance(const uint32_t a, const uint32_t b) {
+            return a > b ? a - b : b - a;
+        }
+    } // unnamed namespace
+
+    ConvergenceWatcher::ConvergenceWatcher(const common::ConvergenceConfig& config, ReadFunction read)
+        : config_(config), read_(std::move(read)) {
+        worker_ = std::jthread([this](const std::stop_token& stop_token) { run(stop_token); });
+    }
+
+    ConvergenceWatcher::~ConvergenceWatcher() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        worker_.request_stop();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+
+        for (auto& waiter : waiters_) {
+            waiter.done(Result<common::types::Convergence>::error("Convergence watcher is stopping"));
+        }
+    }
+
+    void ConvergenceWatcher::watch(const Axis axis, const uint32_t target, const uint32_t tolerance,
+                                   const Clock::time_point deadline, Done done) {
+        const auto started = Clock::now();
+        {
+            std::lock_guard lock(mutex_);
+            if (!stopping_) {
+                auto& poll = polls_[static_cast<std::size_t>(axis)];
+                if (poll.targets.empty()) {
+                    // Samples of an earlier wait say nothing about the lens speed now
+                    poll.value.reset();
+                    poll.error.reset();
+                    poll.next_poll = started;
+                } else {
+                    poll.next_poll = std::min(poll.next_poll, started + config_.min_poll_interval);
+                }
+                poll.interval = config_.min_poll_interval;
+                poll.targets.insert(target);
+                waiters_.push_back({.axis = axis,
+                                    .target = target,
+                                    .tolerance = tolerance,
+                                    .started = started,
+                                    .deadline = deadline,
+                                    .samples = poll.samples,
+                                    .done = std::move(done)});
+                poll_cv_.notify_all();
+                return;
+            }
+        }
+        done(Result<common::types::Convergence>::error("Convergence watcher is stopping"));
+    }
+
+    Result<common::types::Convergence> ConvergenceWatcher::waitFor(const Axis axis, const uint32_t target,
+                                                                   const uint32_t tolerance,
+                                                                   const Clock::time_point deadline) {
+        const auto outcome = std::make_shared<std::promise<Result<common::types::Convergence>>>();
+        auto result = outcome->get_future();
+        watch(axis, target, tolerance, deadline, [outcome](Result<common::types::Convergence> convergence) {
+            outcome->set_value(std::move(convergence));
+        });
+        return result.get();
+    }
+
+    void ConvergenceWatcher::run(const std::stop_token& stop_token) {
+        std::unique_lock lock(mutex_);
+        while (!stop_token.stop_requested()) {
+            if (!poll_cv_.wait(lock, stop_token, [this] { return nextWake() != Clock::time_point::max(); })) {
+                return;
+            }
+
+            // A new waiter may move the next read or deadline forward
+            const auto due = nextWake();
+            if (poll_cv_.wait_until(lock, stop_token, due, [this, due] { return nextWake() < due; })) {
+                continue;
+            }
+            if (stop_token.stop_requested()) {
+                return;
+            }
+
+            for (const auto axis : AXES) {
+                auto& poll = polls_[static_cast<std::size_t>(axis)];
+                if (poll.targets.empty() || poll.next_poll > Clock::now()) {
+                    continue;
+                }
+
+                lock.unlock();
+                const auto result = read_(axis);
+                lock.lock();
+                record(poll, result, Clock::now());
+            }
+
+            auto finished = settle(Clock::now());
+            if (!finished.empty()) {
+                lock.unlock();
+                for (auto& [done, result] : finished) {
+                    done(std::move(result));
+                }
+                lock.lock();
+            }
+        }
+    }
+
+    ConvergenceWatcher::Finished ConvergenceWatcher::settle(const Clock::time_point now) {
+        Finished finished;
+        for (auto waiter = waiters_.begin(); waiter != waiters_.end();) {
+            auto result = check(*waiter, now);
+            if (!result) {
+                ++waiter;
+                continue;
+            }
+
+            auto& poll = polls_[static_cast<std::size_t>(waiter->axis)];
+            poll.targets.erase(poll.targets.find(waiter->target));
+            finished.emplace_back(std::move(waiter->done), std::move(*result));
+            waiter = waiters_.erase(waiter);
+        }
+        return finished;
+    }
+
+    std::optional<Result<common::types::Convergence>> ConvergenceWatcher::check(Waiter& waiter,
+                                                                                const Clock::time_point now) const {
+        using ResultType = Result<common::types::Convergence>;
+        const auto& poll = polls_[static_cast<std::size_t>(waiter.axis)];
+        const auto finish = [&](const common::types::ConvergenceStatus status) {
+            return ResultType::success(
+                {.value = *poll.value,
+                 .elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - waiter.started),
+                 .status = status});
+        };
+
+        if (poll.samples != waiter.samples) {
+            waiter.samples = poll.samples;
+            if (poll.error) {
+                return ResultType::error(*poll.error);
+            }
+            if (distance(*poll.value, waiter.target) <= waiter.tolerance) {
+                return finish(common::types::ConvergenceStatus::Reached);
+            }
+            // Changes from before this wait started do not count, the Set may not have reached the lens yet
+            if (poll.sampled_at - std::max(poll.changed_at, waiter.started) >= config_.settle_time) {
+                return finish(common::types::ConvergenceStatus::Settled);
+            }
+        }
+
+        if (now < waiter.deadline) {
+            return std::nullopt;
+        }
+        if (!poll.value || poll.sampled_at < waiter.started) {
+            return ResultType::error("No position read before the deadline");
+        }
+        return finish(common::types::ConvergenceStatus::TimedOut);
+    }
+
+    void ConvergenceWatcher::record(Poll& poll, const Result<uint32_t>& result, const Clock::time_point now) const {
+        ++poll.samples;
+        if (result.isError()) {
+            LOG_WARN("Convergence poll failed: {}", result.error().message);
+            poll.error = result.error().message;
+            poll.next_poll = now + config_.max_poll_interval;
+            return;
+        }
+        poll.error.reset();
+
+        const auto value = result.value();
+        Clock::duration interval = config_.min_poll_interval;
+        if (!poll.value || *poll.value != value) {
+            if (poll.value && !poll.targets.empty()) {
+                // Half the time to the nearest target at the speed seen since the last read
+                auto remaining = distance(*poll.targets.begin(), value);
+                for (const auto target : poll.targets) {
+                    remaining = std::min(remaining, distance(target, value));
+                }
+                interval = (now - poll.sampled_at) * remaining / (2 * distance(*poll.value, value));
+            }
+            poll.changed_at = now;
+        } else {
+            // Standing still, back off but keep reading often enough to notice it has settled
+            interval = std::min<Clock::duration>(2 * poll.interval, config_.settle_time / 2);
+        }
+
+        poll.interval = std::clamp<Clock::duration>(interval, config_.min_poll_interval, config_.max_poll_interval);
+        poll.value = value;
+        poll.sampled_at = now;
+        poll.next_poll = now + poll.interval;
+    }
+
+    ConvergenceWatcher::Clock::time_point ConvergenceWatcher::nextWake() const {
+        auto next = Clock::time_point::max();
+        for (const auto& poll : polls_) {
+            if (!poll.targets.empty()) {
+                next = std::min(next, poll.next_poll);
+            }
+        }
+        for (const auto& waiter : waiters_) {
+            next = std::min(next, waiter.deadline);
+        }
+        return next;
+    }
+} // namespace service::core
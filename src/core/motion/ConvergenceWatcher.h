@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/config/ConfigManager.h"
+#include "common/types/Convergence.h"
+#include "common/types/Result.h"
+#include "core/motion/MotionScheduler.h"
+
+namespace service::core {
+    /**
+     * Waits for the zoom and focus axes of one camera to stop moving after a Set command
+     * One polling loop per axis is shared by every waiter of that axis. The poll interval adapts to the
+     * lens: while it moves it is about half the estimated time to the nearest target, while it stands still
+     * it backs off towards the settle time, always within [min_poll_interval, max_poll_interval]
+     * Waits hold no thread, the watcher thread checks them after every read and at their deadlines
+     */
+    class ConvergenceWatcher {
+    public:
+        using Axis = MotionScheduler::Axis;
+        using ReadFunction = MotionScheduler::ReadFunction;
+
+        /**
+         * Called once with the outcome of a wait, on the watcher thread or on the caller of watch() if the watcher
+         * is stopping. It should return quickly, it delays the waits that end after it
+         */
+        using Done = std::function<void(Result<common::types::Convergence>)>;
+
+        /**
+         * @param config poll intervals and settle time
+         * @param read reads the current position of an axis, called from the watcher thread
+         */
+        ConvergenceWatcher(const common::ConvergenceConfig& config, ReadFunction read);
+
+        /**
+         * Stop the thread and end every pending wait with an error
+         */
+        ~ConvergenceWatcher();
+
+        ConvergenceWatcher(const ConvergenceWatcher&) = delete;
+        ConvergenceWatcher& operator=(const ConvergenceWatcher&) = delete;
+
+        /**
+         * Wait until the axis is within tolerance of target, stops changing, or the deadline passes
+         * @param done called with the last polled value, time spent waiting and why the wait ended;
+         *             an error if a read failed
+         */
+        void watch(Axis axis, uint32_t target, uint32_t tolerance, std::chrono::steady_clock::time_point deadline,
+                   Done done);
+
+        /**
+         * Block until the wait of watch() ends
+         * @return last polled value, time spent waiting and why the wait ended; an error if a read failed
+         */
+        Result<common::types::Convergence> waitFor(Axis axis, uint32_t target, uint32_t tolerance,
+                                                   std::chrono::steady_clock::time_point deadline);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Poll {
+            std::multiset<uint32_t> targets; // one entry per waiter
+            std::optional<uint32_t> value;
+            std::optional<std::string> error; // failure of the last read
+            Clock::time_point sampled_at;
+            Clock::time_point changed_at;
+            Clock::duration interval{};
+            Clock::time_point next_poll;
+            uint64_t samples{0};
+        };
+
+        struct Waiter {
+            Axis axis;
+            uint32_t target;
+            uint32_t tolerance;
+            Clock::time_point started;
+            Clock::time_point deadline;
+            uint64_t samples; // of the axis when the wait was last checked
+            Done done;
+        };
+
+        using Finished = std::vector<std::pair<Done, Result<common::types::Convergence>>>;
+
+        void run(const std::stop_token& stop_token);
+
+        /**
+         * Take the waits that a new sample or their deadline ended off the list
+         */
+        Finished settle(Clock::time_point now);
+
+        /**
+         * @return outcome of a wait, std::nullopt while it goes on
+         */
+        std::optional<Result<common::types::Convergence>> check(Waiter& waiter, Clock::time_point now) const;
+
+        /**
+         * Store a read and schedule the next one
+         */
+        void record(Poll& poll, const Result<uint32_t>& result, Clock::time_point now) const;
+
+        /**
+         * @return earliest scheduled read of an axis with waiters or deadline of a wait, max() if there is none
+         */
+        Clock::time_point nextWake() const;
+
+        const common::ConvergenceConfig config_;
+        ReadFunction read_;
+
+        std::mutex mutex_;
+        std::condition_variable_any poll_cv_; // wakes the watcher thread
+        std::array<Poll, 2> polls_; // indexed by Axis
+        std::list<Waiter> waiters_;
+        bool stopping_{false};
+        std::jthread worker_;
+    };
+} // namespace service::core
@@ -0,0 +1,198 @@
+#include "MotionScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "common/logger/Logger.h"
+#include "common/types/CameraTypes.h"
+
+namespace service::core {
+    namespace {
+        std::pair<double, double> rangeOf(const MotionScheduler::Axis axis) {
+            if (axis == MotionScheduler::Axis::Zoom) {
+                return {common::types::NORMALIZED_ZOOM_RANGE.min, common::types::NORMALIZED_ZOOM_RANGE.max};
+            }
+            return {common::types::NORMALIZED_FOCUS_RANGE.min, common::types::NORMALIZED_FOCUS_RANGE.max};
+        }
+
+        const char* toString(const MotionScheduler::Axis axis) {
+            return axis == MotionScheduler::Axis::Zoom ? "zoom" : "focus";
+        }
+
+        constexpr MotionScheduler::Axis AXES[] = {MotionScheduler::Axis::Zoom, MotionScheduler::Axis::Focus};
+    } // unnamed namespace
+
+    MotionScheduler::MotionScheduler(const std::chrono::microseconds tick, ReadFunction read, ApplyFunction apply)
+        : tick_(tick), read_(std::move(read)), apply_(std::move(apply)) {
+        worker_ = std::jthread([this](const std::stop_token& stop_token) { run(stop_token); });
+    }
+
+    MotionScheduler::~MotionScheduler() {
+        worker_.request_stop();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    Result<void> MotionScheduler::move(const Axis axis, const double velocity,
+                                       const std::chrono::milliseconds duration) {
+        if (velocity == 0.0) {
+            stop(axis);
+            return Result<void>::success();
+        }
+
+        const auto index = static_cast<std::size_t>(axis);
+        std::optional<uint32_t> start;
+        {
+            std::lock_guard lock(mutex_);
+            if (auto& motion = motions_[index]) {
+                motion->velocity = velocity;
+                motion->deadline = Clock::now() + duration;
+                return Result<void>::success();
+            }
+        }
+
+        // A new motion starts from where the axis is now
+        auto position = read_(axis);
+        if (position.isError()) {
+            return Result<void>::error(position.error());
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            const auto now = Clock::now();
+            auto& motion = motions_[index];
+            if (!motion) {
+                motion = Motion{.position = static_cast<double>(position.value()),
+                                .last_tick = now,
+                                .applied = position.value()};
+            }
+            motion->velocity = velocity;
+            motion->deadline = now + duration;
+        }
+        motion_cv_.notify_all();
+        return Result<void>::success();
+    }
+
+    void MotionScheduler::stop(const Axis axis) {
+        {
+            std::lock_guard lock(mutex_);
+            motions_[static_cast<std::size_t>(axis)].reset();
+        }
+        // Wait out a tick that may still be sending a command of the stopped motion
+        std::lock_guard apply_lock(apply_mutex_);
+    }
+
+    void MotionScheduler::stop(const Axis axis, std::function<void()> stopped) {
+        {
+            std::lock_guard lock(mutex_);
+            motions_[static_cast<std::size_t>(axis)].reset();
+            if (applying_) {
+                stopped_.push_back(std::move(stopped));
+                return;
+            }
+        }
+        stopped();
+    }
+
+    bool MotionScheduler::isMoving(const Axis axis) const {
+        std::lock_guard lock(mutex_);
+        return motions_[static_cast<std::size_t>(axis)].has_value();
+    }
+
+    void MotionScheduler::run(const std::stop_token& stop_token) {
+        std::unique_lock lock(mutex_);
+        auto next_tick = Clock::now();
+        while (!stop_token.stop_requested()) {
+            if (!motion_cv_.wait(lock, stop_token, [this] { return motions_[0] || motions_[1]; })) {
+                return;
+            }
+            motion_cv_.wait_until(lock, stop_token, next_tick, [] { return false; });
+            if (stop_token.stop_requested()) {
+                return;
+            }
+
+            const auto now = Clock::now();
+            next_tick = now + tick_;
+
+            std::array<std::optional<uint32_t>, 2> commands;
+            for (const auto axis : AXES) {
+                const auto index = static_cast<std::size_t>(axis);
+                if (!motions_[index]) {
+                    continue;
+                }
+
+                auto& motion = *motions_[index];
+                const auto [min, max] = rangeOf(axis);
+                const std::chrono::duration<double> elapsed = std::min(now, motion.deadline) - motion.last_tick;
+                motion.position = std::clamp(motion.position + motion.velocity * elapsed.count(), min, max);
+                motion.last_tick = now;
+
+                if (const auto target = static_cast<uint32_t>(std::lround(motion.position)); target != motion.applied) {
+                    commands[index] = target;
+                }
+
+                const auto at_limit = motion.velocity > 0 ? motion.position >= max : motion.position <= min;
+                if (now >= motion.deadline || at_limit) {
+                    LOG_DEBUG("{} motion finished at {}", toString(axis), motion.position);
+                    motions_[index].reset();
+                }
+            }
+
+            if (!commands[0] && !commands[1]) {
+                continue;
+            }
+
+            // Taken before the state lock is released so stop() can wait for this tick
+            std::unique_lock apply_lock(apply_mutex_);
+            applying_ = true;
+            lock.unlock();
+            std::array<std::optional<Result<uint32_t>>, 2> results;
+            for (const auto axis : AXES) {
+                const auto index = static_cast<std::size_t>(axis);
+                if (commands[index]) {
+                    results[index] = apply_(axis, *commands[index]);
+                }
+            }
+            apply_lock.unlock();
+            lock.lock();
+            applying_ = false;
+
+            for (const auto axis : AXES) {
+                const auto index = static_cast<std::size_t>(axis);
+                auto& motion = motions_[index];
+                if (!results[index] || !motion) {
+                    continue;
+                }
+
+                const auto& result = *results[index];
+                if (result.isError()) {
+                    LOG_WARN("{} motion stopped: {}", toString(axis), result.error().message);
+                    motion.reset();
+                    continue;
+                }
+
+                // The backend stopped short of the command, a tighter limit than the normalized range
+                const auto applied = result.value();
+                if ((motion->velocity > 0 && applied < *commands[index]) ||
+                    (motion->velocity < 0 && applied > *commands[index])) {
+                    LOG_DEBUG("{} motion reached the backend limit at {}", toString(axis), applied);
+                    motion.reset();
+                    continue;
+                }
+                motion->applied = applied;
+            }
+
+            // Called last, a stopped call may start the next motion
+            if (!stopped_.empty()) {
+                const auto stopped = std::exchange(stopped_, {});
+                lock.unlock();
+                for (const auto& callback : stopped) {
+                    callback();
+                }
+                lock.lock();
+            }
+        }
+    }
+} // namespace service::core
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "common/types/Result.h"
+
+namespace service::core {
+    /**
+     * Moves the zoom and focus axes of one camera at a set velocity
+     * Every tick the position advances by velocity times the elapsed time, is clamped to the axis range
+     * and sent to the backend if its rounded value changed. A motion stops at its deadline, at the end
+     * of the range, or once the backend applies less than was asked (a tighter hardware limit)
+     */
+    class MotionScheduler {
+    public:
+        enum class Axis : std::size_t {
+            Zoom,
+            Focus
+        };
+
+        /**
+         * Read the current position of an axis
+         */
+        using ReadFunction = std::function<Result<uint32_t>(Axis axis)>;
+
+        /**
+         * Send a position to the backend, returns the applied position
+         */
+        using ApplyFunction = std::function<Result<uint32_t>(Axis axis, uint32_t position)>;
+
+        /**
+         * @param tick interval between two backend commands of a moving axis
+         * @param read reads the starting position of an axis
+         * @param apply sends positions to the backend, called from the scheduler thread
+         */
+        MotionScheduler(std::chrono::microseconds tick, ReadFunction read, ApplyFunction apply);
+        ~MotionScheduler();
+
+        MotionScheduler(const MotionScheduler&) = delete;
+        MotionScheduler& operator=(const MotionScheduler&) = delete;
+
+        /**
+         * Start or update the motion of an axis, a running motion keeps its position and restarts its deadline
+         * @param axis axis to move
+         * @param velocity normalized units per second, negative moves towards the minimum, 0 stops
+         * @param duration time after which the motion stops on its own
+         */
+        Result<void> move(Axis axis, double velocity, std::chrono::milliseconds duration);
+
+        /**
+         * Stop an axis, no command of the stopped motion is sent once this returns
+         */
+        void stop(Axis axis);
+
+        /**
+         * Stop an axis without waiting, no command of the stopped motion is sent once stopped is called
+         * @param stopped called at once if no tick is sending, otherwise on the scheduler thread once the tick ends
+         */
+        void stop(Axis axis, std::function<void()> stopped);
+
+        bool isMoving(Axis axis) const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Motion {
+            double position{0.0};
+            double velocity{0.0};
+            Clock::time_point last_tick;
+            Clock::time_point deadline;
+            uint32_t applied{0};
+        };
+
+        void run(const std::stop_token& stop_token);
+
+        const std::chrono::microseconds tick_;
+        ReadFunction read_;
+        ApplyFunction apply_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable_any motion_cv_;
+        std::array<std::optional<Motion>, 2> motions_; // indexed by Axis
+        bool applying_{false}; // a tick is sending commands
+        std::vector<std::function<void()>> stopped_; // callbacks of stop() waiting for the sending tick
+
+        std::mutex apply_mutex_; // held while commands of a tick are sent
+        std::jthread worker_;
+    };
+} // namespace service::core
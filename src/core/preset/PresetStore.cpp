@@ -0,0 +1,109 @@
+#include "PresetStore.h"
+
+#include <fstream>
+
+#include "common/config/PresetYaml.h"
+#include "common/logger/Logger.h"
+
+namespace service::core {
+    PresetStore::PresetStore(const common::PresetsConfig& config) : file_(config.file) {
+        auto presets = config.definitions;
+        if (!file_.empty() && std::filesystem::exists(file_)) {
+            try {
+                const auto root = YAML::LoadFile(file_.string());
+                presets = root["presets"] ? root["presets"].as<std::vector<common::types::Preset>>()
+                                          : std::vector<common::types::Preset>{};
+            } catch (const YAML::Exception& e) {
+                throw std::runtime_error("Failed to load presets from " + file_.string() + ": " + e.what());
+            }
+        }
+
+        for (auto& preset : presets) {
+            if (const auto reason = preset.invalidReason(); !reason.empty()) {
+                throw std::runtime_error(reason);
+            }
+            auto name = preset.name;
+            presets_.insert_or_assign(std::move(name), std::move(preset));
+        }
+        LOG_DEBUG("Loaded {} presets", presets_.size());
+    }
+
+    std::optional<common::types::Preset> PresetStore::find(const std::string& name) const {
+        std::lock_guard lock(mutex_);
+        const auto it = presets_.find(name);
+        if (it == presets_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::vector<common::types::Preset> PresetStore::list() const {
+        std::lock_guard lock(mutex_);
+        std::vector<common::types::Preset> presets;
+        presets.reserve(presets_.size());
+        for (const auto& [name, preset] : presets_) {
+            presets.push_back(preset);
+        }
+        return presets;
+    }
+
+    Result<void> PresetStore::save(const common::types::Preset& preset) {
+        if (const auto reason = preset.invalidReason(); !reason.empty()) {
+            return Result<void>::error(reason);
+        }
+
+        std::lock_guard lock(mutex_);
+        auto presets = presets_;
+        presets.insert_or_assign(preset.name, preset);
+        if (auto persisted = persist(presets); persisted.isError()) {
+            return persisted;
+        }
+        presets_ = std::move(presets);
+        return Result<void>::success();
+    }
+
+    Result<void> PresetStore::remove(const std::string& name) {
+        std::lock_guard lock(mutex_);
+        if (!presets_.contains(name)) {
+            return Result<void>::error("Unknown preset: " + name);
+        }
+
+        auto presets = presets_;
+        presets.erase(name);
+        if (auto persisted = persist(presets); persisted.isError()) {
+            return persisted;
+        }
+        presets_ = std::move(presets);
+        return Result<void>::success();
+    }
+
+    Result<void> PresetStore::persist(const std::map<std::string, common::types::Preset>& presets) const {
+        if (file_.empty()) {
+            return Result<void>::success();
+        }
+
+        YAML::Node root;
+        root["presets"] = YAML::Node(YAML::NodeType::Sequence);
+        for (const auto& [name, preset] : presets) {
+            root["presets"].push_back(preset);
+        }
+
+        // A crash mid-write leaves the previous file in place
+        auto temporary = file_;
+        temporary += ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::trunc);
+            out << YAML::Dump(root) << '\n';
+            if (!out.flush()) {
+                return Result<void>::error("Failed to write presets to " + temporary.string());
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, file_, error);
+        if (error) {
+            return Result<void>::error("Failed to replace " + file_.string() + ": " + error.message());
+        }
+        return Result<void>::success();
+    }
+} // namespace service::core
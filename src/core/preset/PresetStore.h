@@ -0,0 +1,53 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/config/ConfigManager.h"
+#include "common/types/Preset.h"
+#include "common/types/Result.h"
+
+namespace service::core {
+    /**
+     * Named presets, persisted to a YAML file so runtime changes survive a restart
+     * The file holds the complete set, presets of config.yaml only seed it while it does not exist
+     */
+    class PresetStore {
+    public:
+        /**
+         * @throws std::runtime_error if the preset file cannot be read or holds an invalid preset
+         */
+        explicit PresetStore(const common::PresetsConfig& config);
+
+        PresetStore(const PresetStore&) = delete;
+        PresetStore& operator=(const PresetStore&) = delete;
+
+        std::optional<common::types::Preset> find(const std::string& name) const;
+
+        /**
+         * @return every preset, ordered by name
+         */
+        std::vector<common::types::Preset> list() const;
+
+        /**
+         * Add a preset or replace the one of the same name, it is visible once it is persisted
+         */
+        Result<void> save(const common::types::Preset& preset);
+
+        Result<void> remove(const std::string& name);
+
+    private:
+        /**
+         * Write presets to a temporary file and rename it over the preset file, no-op without a file
+         */
+        Result<void> persist(const std::map<std::string, common::types::Preset>& presets) const;
+
+        std::filesystem::path file_;
+        mutable std::mutex mutex_;
+        std::map<std::string, common::types::Preset> presets_; // by name
+    };
+} // namespace service::core
@@ -0,0 +1,253 @@
+#include "Reconciler.h"
+
+#include <latch>
+
+#include "common/logger/Logger.h"
+
+namespace service::core {
+    namespace {
+        const char* onOff(const bool enable) {
+            return enable ? "on" : "off";
+        }
+
+        /**
+         * @return fields of a desired state for the log, e.g. "zoom 40, stabilization on, video hdr off"
+         */
+        std::string describe(const common::types::DesiredState& desired) {
+            std::string text;
+            const auto add = [&text](const std::string& field) {
+                text += text.empty() ? field : ", " + field;
+            };
+            const auto& state = desired.state;
+            if (state.zoom_level) { add("zoom " + std::to_string(*state.zoom_level)); }
+            if (state.focus_value) { add("focus " + std::to_string(*state.focus_value)); }
+            if (state.auto_focus) { add(std::string("auto focus ") + onOff(*state.auto_focus)); }
+            if (state.stabilization) { add(std::string("stabilization ") + onOff(*state.stabilization)); }
+            for (const auto& [capability, enable] : desired.video) {
+                add("video " + capability + " " + onOff(enable));
+            }
+            return text;
+        }
+
+        const char* toString(const common::types::DriftCause cause) {
+            return cause == common::types::DriftCause::Reconnect ? "after a reconnect" : "by a check";
+        }
+    } // unnamed namespace
+
+    Reconciler::Reconciler(const common::ReconcileConfig& config, Actions actions)
+        : config_(config), actions_(std::move(actions)), checkers_(config.max_checks) {
+        worker_ = std::jthread([this](const std::stop_token& stop_token) { run(stop_token); });
+    }
+
+    Reconciler::~Reconciler() {
+        worker_.request_stop();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void Reconciler::desire(const uint32_t camera_id, const common::types::CameraState& state) {
+        std::lock_guard lock(mutex_);
+        auto& camera = cameras_[camera_id];
+        camera.desired.state.merge(state);
+        camera.commanded = Clock::now();
+    }
+
+    void Reconciler::desireVideo(const uint32_t camera_id, const std::string& capability, const bool enable) {
+        std::lock_guard lock(mutex_);
+        auto& camera = cameras_[camera_id];
+        camera.desired.video[capability] = enable;
+        camera.commanded = Clock::now();
+    }
+
+    common::types::ReconcileMetrics Reconciler::metrics() const {
+        common::types::ReconcileMetrics metrics{.enabled = true};
+        std::lock_guard lock(mutex_);
+        for (const auto& [camera_id, camera] : cameras_) {
+            metrics.cameras.push_back({.camera_id = camera_id,
+                                       .desired = camera.desired,
+                                       .checks = camera.checks,
+                                       .drifts = camera.drifts,
+                                       .restored = camera.restored});
+        }
+        metrics.recent_drifts.assign(drifts_.begin(), drifts_.end());
+        metrics.latency = latency_.summary();
+        return metrics;
+    }
+
+    void Reconciler::run(const std::stop_token& stop_token) {
+        while (!stop_token.stop_requested()) {
+            const auto due = dueCameras();
+
+            // A slow camera only holds back the cameras queued behind it, the round ends once all were checked
+            std::latch checked(static_cast<std::ptrdiff_t>(due.size()));
+            for (const auto& camera : due) {
+                checkers_.submit([this, &camera, &checked] {
+                    reconcile(camera);
+                    checked.count_down();
+                });
+            }
+            checked.wait();
+
+            std::unique_lock lock(mutex_);
+            wake_cv_.wait_for(lock, stop_token, config_.connection_poll, [] { return false; });
+        }
+    }
+
+    std::vector<Reconciler::Due> Reconciler::dueCameras() {
+        std::vector<uint32_t> camera_ids;
+        {
+            std::lock_guard lock(mutex_);
+            for (const auto& [camera_id, camera] : cameras_) {
+                camera_ids.push_back(camera_id);
+            }
+        }
+
+        // Sampled without the lock, commands keep recording their values meanwhile
+        std::vector<bool> connected;
+        connected.reserve(camera_ids.size());
+        for (const auto camera_id : camera_ids) {
+            connected.push_back(actions_.connected(camera_id));
+        }
+
+        std::vector<Due> due;
+        const auto now = Clock::now();
+        std::lock_guard lock(mutex_);
+        for (std::size_t index = 0; index < camera_ids.size(); ++index) {
+            auto& camera = cameras_.at(camera_ids[index]);
+            if (camera.connected == false && connected[index]) {
+                LOG_INFO("Camera {} reconnected, checking its desired state", camera_ids[index]);
+                camera.reconnected = now;
+            }
+            camera.connected = connected[index];
+            if (!connected[index]) {
+                continue;
+            }
+
+            if (camera.reconnected) {
+                due.push_back({.camera_id = camera_ids[index],
+                               .cause = common::types::DriftCause::Reconnect,
+                               .since = *camera.reconnected,
+                               .desired = camera.desired});
+                camera.reconnected.reset();
+            } else if (now >= camera.next_check && now - camera.commanded >= config_.settle_time) {
+                due.push_back({.camera_id = camera_ids[index],
+                               .cause = common::types::DriftCause::Check,
+                               .since = now,
+                               .desired = camera.desired});
+            } else {
+                continue;
+            }
+            camera.next_check = now + config_.check_interval;
+        }
+        return due;
+    }
+
+    void Reconciler::reconcile(const Due& due) {
+        const auto observed = actions_.read(due.camera_id, due.desired);
+        const auto found = driftOf(due.desired, observed);
+
+        common::types::DriftEvent event{.camera_id = due.camera_id,
+                                        .cause = due.cause,
+                                        .detected = std::chrono::system_clock::now()};
+        {
+            std::lock_guard lock(mutex_);
+            auto& camera = cameras_.at(due.camera_id);
+            ++camera.checks;
+            if (found.empty()) {
+                return;
+            }
+            ++camera.drifts;
+
+            // Values commanded since the read replace the ones found drifted, only the newest intent is restored
+            event.drifted.state = camera.desired.state.masked(found.state.fields());
+            for (const auto& [capability, enable] : found.video) {
+                event.drifted.video[capability] = camera.desired.video.at(capability);
+            }
+        }
+        LOG_WARN("Camera {} drifted from its desired state {}: restoring {}", due.camera_id, toString(due.cause),
+                 describe(event.drifted));
+
+        const auto results = actions_.apply(due.camera_id, toOperations(due.camera_id, event.drifted));
+        for (const auto& result : results) {
+            if (result.isError()) {
+                event.error = result.error().message;
+                break;
+            }
+        }
+        event.restored = event.error.empty();
+        if (event.restored) {
+            latency_.record(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - due.since));
+            LOG_INFO("Camera {} restored to its desired state", due.camera_id);
+        } else {
+            LOG_ERROR("Failed to restore camera {}: {}", due.camera_id, event.error);
+        }
+        record(std::move(event));
+    }
+
+    common::types::DesiredState Reconciler::driftOf(const common::types::DesiredState& desired,
+                                                    const common::types::DesiredState& observed) {
+        common::types::DesiredState drifted;
+        const auto& want = desired.state;
+        const auto& have = observed.state;
+        if (want.zoom_level && have.zoom_level && want.zoom_level != have.zoom_level) {
+            drifted.state.zoom_level = want.zoom_level;
+        }
+        if (want.auto_focus && have.auto_focus && want.auto_focus != have.auto_focus) {
+            drifted.state.auto_focus = want.auto_focus;
+        }
+        // Auto focus moves the focus on its own, a focus is only held while auto focus is meant to be off
+        if (want.focus_value && have.focus_value && want.focus_value != have.focus_value && want.auto_focus != true) {
+            drifted.state.focus_value = want.focus_value;
+        }
+        if (want.stabilization && have.stabilization && want.stabilization != have.stabilization) {
+            drifted.state.stabilization = want.stabilization;
+        }
+        for (const auto& [capability, enable] : desired.video) {
+            if (const auto it = observed.video.find(capability); it != observed.video.end() && it->second != enable) {
+                drifted.video[capability] = enable;
+            }
+        }
+        return drifted;
+    }
+
+    std::vector<common::types::Operation> Reconciler::toOperations(const uint32_t camera_id,
+                                                                   const common::types::DesiredState& drifted) {
+        using common::types::OperationType;
+        std::vector<common::types::Operation> operations;
+        const auto& state = drifted.state;
+        if (state.zoom_level) {
+            operations.push_back({.type = OperationType::SetZoom, .camera_id = camera_id, .value = *state.zoom_level});
+        }
+        if (state.auto_focus) {
+            operations.push_back(
+                {.type = OperationType::SetAutoFocus, .camera_id = camera_id, .enable = *state.auto_focus});
+        }
+        if (state.focus_value) {
+            operations.push_back(
+                {.type = OperationType::SetFocus, .camera_id = camera_id, .value = *state.focus_value});
+        }
+        if (state.stabilization) {
+            operations.push_back(
+                {.type = OperationType::SetStabilization, .camera_id = camera_id, .enable = *state.stabilization});
+        }
+        for (const auto& [capability, enable] : drifted.video) {
+            operations.push_back({.type = OperationType::SetVideoCapabilityState,
+                                  .camera_id = camera_id,
+                                  .enable = enable,
+                                  .capability = capability});
+        }
+        return operations;
+    }
+
+    void Reconciler::record(common::types::DriftEvent event) {
+        std::lock_guard lock(mutex_);
+        if (event.restored) {
+            ++cameras_.at(event.camera_id).restored;
+        }
+        drifts_.push_back(std::move(event));
+        while (drifts_.size() > config_.history) {
+            drifts_.pop_front();
+        }
+    }
+} // namespace service::core
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/config/ConfigManager.h"
+#include "common/types/BatchOperation.h"
+#include "common/types/Reconcile.h"
+#include "core/dispatch/LatencyHistogram.h"
+#include "core/schedule/WorkerPool.h"
+
+namespace service::core {
+    /**
+     * Desired state of the cameras, and a loop that restores a camera that drifted away from it
+     * Every successful command sets the desired value of its field, so only the latest intent is ever restored.
+     * A camera is checked as soon as its backend reconnects, and every check interval once its last command
+     * had the settle time to take effect. Only the fields found different are sent again, cameras in parallel on a
+     * fixed pool of checkers
+     */
+    class Reconciler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Camera access of the loop, called from its thread and the checkers
+         */
+        struct Actions {
+            // Read the fields set in desired from the backend, unreadable ones are left unset
+            std::function<common::types::DesiredState(uint32_t camera_id, const common::types::DesiredState& desired)>
+                read;
+            // Send the operations of a restore to one camera in order, results in operation order
+            std::function<std::vector<common::types::OperationResult>(
+                uint32_t camera_id, const std::vector<common::types::Operation>& operations)> apply;
+            // Whether the backend connection of a camera is up, without calling the backend
+            std::function<bool(uint32_t camera_id)> connected;
+        };
+
+        Reconciler(const common::ReconcileConfig& config, Actions actions);
+
+        /**
+         * Stop the loop and wait for a restore in progress
+         */
+        ~Reconciler();
+
+        Reconciler(const Reconciler&) = delete;
+        Reconciler& operator=(const Reconciler&) = delete;
+
+        /**
+         * Record the values a command applied as the desired state of their fields
+         */
+        void desire(uint32_t camera_id, const common::types::CameraState& state);
+
+        void desireVideo(uint32_t camera_id, const std::string& capability, bool enable);
+
+        common::types::ReconcileMetrics metrics() const;
+
+    private:
+        struct Camera {
+            common::types::DesiredState desired;
+            Clock::time_point commanded{}; // last change of desired
+            Clock::time_point next_check{};
+            std::optional<bool> connected; // last sample, unknown before the first
+            std::optional<Clock::time_point> reconnected; // when a reconnect was seen that was not checked yet
+            uint64_t checks{0};
+            uint64_t drifts{0};
+            uint64_t restored{0};
+        };
+
+        /**
+         * A camera the loop checks in this round
+         */
+        struct Due {
+            uint32_t camera_id{0};
+            common::types::DriftCause cause{common::types::DriftCause::Check};
+            Clock::time_point since; // reconnect seen or check started, drift latency counts from here
+            common::types::DesiredState desired;
+        };
+
+        void run(const std::stop_token& stop_token);
+
+        /**
+         * Sample the connections and pick the cameras to check now
+         */
+        std::vector<Due> dueCameras();
+
+        /**
+         * Read a camera, and restore the fields that drifted
+         */
+        void reconcile(const Due& due);
+
+        /**
+         * @return desired values of the fields observed with another value, focus is left to auto focus
+         */
+        static common::types::DesiredState driftOf(const common::types::DesiredState& desired,
+                                                   const common::types::DesiredState& observed);
+
+        /**
+         * @return commands restoring the drifted fields, auto focus before focus
+         */
+        static std::vector<common::types::Operation> toOperations(uint32_t camera_id,
+                                                                  const common::types::DesiredState& drifted);
+
+        void record(common::types::DriftEvent event);
+
+        const common::ReconcileConfig config_;
+        const Actions actions_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable_any wake_cv_;
+        std::map<uint32_t, Camera> cameras_; // by camera_id, cameras that were commanded at least once
+        std::deque<common::types::DriftEvent> drifts_; // oldest first, at most config_.history
+        LatencyHistogram latency_;
+
+        WorkerPool checkers_; // runs the checks of a round, at most config_.max_checks at once
+        std::jthread worker_;
+    };
+} // namespace service::core
@@ -0,0 +1,71 @@
+#include "CommandScheduler.h"
+
+#include <utility>
+
+namespace service::core {
+    CommandScheduler::CommandScheduler(const std::chrono::microseconds resolution)
+        : wheel_(resolution, Clock::now()) {
+        worker_ = std::jthread([this](const std::stop_token& stop_token) { run(stop_token); });
+    }
+
+    CommandScheduler::~CommandScheduler() {
+        stop();
+    }
+
+    void CommandScheduler::schedule(const Clock::time_point due, Callback callback) {
+        bool stopped = false;
+        {
+            std::lock_guard lock(mutex_);
+            stopped = stopped_;
+            if (!stopped) {
+                wheel_.add(due, std::move(callback));
+                changed_ = true;
+            }
+        }
+        if (stopped) {
+            callback(false);
+            return;
+        }
+        cv_.notify_one();
+    }
+
+    void CommandScheduler::stop() {
+        worker_.request_stop();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+
+        std::vector<Callback> pending;
+        {
+            std::lock_guard lock(mutex_);
+            stopped_ = true;
+            pending = wheel_.drain();
+        }
+        for (const auto& callback : pending) {
+            callback(false);
+        }
+    }
+
+    void CommandScheduler::run(const std::stop_token& stop_token) {
+        while (!stop_token.stop_requested()) {
+            std::vector<Callback> due;
+            {
+                std::unique_lock lock(mutex_);
+                const auto changed = [this] { return std::exchange(changed_, false); };
+                if (const auto next = wheel_.nextExpiry()) {
+                    cv_.wait_until(lock, stop_token, *next, changed);
+                } else {
+                    cv_.wait(lock, stop_token, changed);
+                }
+                if (stop_token.stop_requested()) {
+                    return;
+                }
+                due = wheel_.advance(Clock::now());
+            }
+
+            for (const auto& callback : due) {
+                callback(true);
+            }
+        }
+    }
+} // namespace service::core
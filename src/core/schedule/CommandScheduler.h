@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "core/schedule/TimerWheel.h"
+
+namespace service::core {
+    /**
+     * Runs callbacks at a set time from one thread, however many are pending
+     * Pending callbacks are kept in a timer wheel, the thread sleeps until the next tick that has work
+     */
+    class CommandScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Called once on the scheduler thread, fired is false if the scheduler stopped before the due time
+         * Callbacks should return quickly, they delay every callback due after them
+         */
+        using Callback = std::function<void(bool fired)>;
+
+        /**
+         * @param resolution tick of the timer wheel, callbacks run up to this long after their due time
+         */
+        explicit CommandScheduler(std::chrono::microseconds resolution);
+
+        /**
+         * Stop the thread and run every pending callback with fired false
+         */
+        ~CommandScheduler();
+
+        CommandScheduler(const CommandScheduler&) = delete;
+        CommandScheduler& operator=(const CommandScheduler&) = delete;
+
+        /**
+         * Run callback at due, at once with fired false if the scheduler is stopped
+         */
+        void schedule(Clock::time_point due, Callback callback);
+
+        /**
+         * Stop the thread and run every pending callback with fired false
+         * Callbacks scheduled afterwards run at once with fired false, the scheduler stays usable for them
+         */
+        void stop();
+
+    private:
+        void run(const std::stop_token& stop_token);
+
+        std::mutex mutex_;
+        std::condition_variable_any cv_;
+        TimerWheel<Callback> wheel_;
+        bool changed_{false}; // an entry was added since the thread last looked at the wheel
+        bool stopped_{false};
+
+        std::jthread worker_;
+    };
+} // namespace service::core
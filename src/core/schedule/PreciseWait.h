@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+namespace service::core {
+    // Precise waits sleep until this close to their deadline and yield the rest of the way
+    constexpr auto PRECISE_WAIT_SPIN = std::chrono::microseconds(500);
+
+    /**
+     * Wait until time to within a few microseconds, a plain sleep overshoots by the timer slack
+     * @param sleep_until coarse wait up to the time point it is given, returns false to give up early
+     * @return false if sleep_until gave up
+     */
+    template<typename SleepUntil>
+    bool preciseWaitUntil(const std::chrono::steady_clock::time_point time, SleepUntil sleep_until) {
+        if (!sleep_until(time - PRECISE_WAIT_SPIN)) {
+            return false;
+        }
+        while (std::chrono::steady_clock::now() < time) {
+            std::this_thread::yield();
+        }
+        return true;
+    }
+} // namespace service::core
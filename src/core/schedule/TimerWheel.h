@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace service::core {
+    /**
+     * Hierarchical timer wheel, not thread-safe
+     * Level 0 has one slot per tick, each higher level one slot per full turn of the level below. An entry
+     * sits in the lowest level whose turn covers its due tick and is handed down a level each time the
+     * level below wraps around onto its slot, so adding is O(1) and a tick touches at most one slot per level.
+     * Entries beyond the range of the top level wait in its farthest slot and are placed again from there
+     */
+    template<typename T>
+    class TimerWheel {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @param resolution length of a tick, entries never expire before their due time but up to a tick after it
+         * @param start time of tick 0
+         */
+        TimerWheel(const std::chrono::microseconds resolution, const Clock::time_point start)
+            : resolution_(std::chrono::duration_cast<Clock::duration>(resolution)), start_(start) {
+        }
+
+        /**
+         * Add a value, a due time that already passed expires on the next advance
+         */
+        void add(const Clock::time_point due, T value) {
+            place({std::max(ceilTick(due), now_ + 1), std::move(value)});
+            ++size_;
+        }
+
+        /**
+         * Move the wheel up to now
+         * @return values whose due time passed, in due order at tick resolution
+         */
+        std::vector<T> advance(const Clock::time_point now) {
+            std::vector<T> expired;
+            const auto target = floorTick(now);
+            while (now_ < target && size_ > 0) {
+                ++now_;
+                // Higher levels go first, what they hand down may land in a lower slot wrapping on the same tick
+                std::size_t top = 0;
+                while (top + 1 < LEVELS && (now_ & ((uint64_t{1} << (BITS * (top + 1))) - 1)) == 0) {
+                    ++top;
+                }
+                for (auto level = top; level > 0; --level) {
+                    cascade(level);
+                }
+
+                auto& slot = levels_[0][now_ & MASK];
+                for (auto& entry : slot) {
+                    expired.push_back(std::move(entry.value));
+                }
+                size_ -= slot.size();
+                slot.clear();
+            }
+            // An empty wheel has nothing to hand down, it jumps straight to the target
+            now_ = std::max(now_, target);
+            return expired;
+        }
+
+        /**
+         * @return time of the next tick at which an entry expires or moves down a level, nothing if empty
+         */
+        std::optional<Clock::time_point> nextExpiry() const {
+            if (size_ == 0) {
+                return std::nullopt;
+            }
+            auto next = std::numeric_limits<uint64_t>::max();
+            for (std::size_t level = 0; level < LEVELS; ++level) {
+                const auto shift = BITS * level;
+                for (uint64_t turn = 1; turn <= SLOTS; ++turn) {
+                    const auto tick = level == 0 ? now_ + turn : ((now_ >> shift) + turn) << shift;
+                    if (!levels_[level][(tick >> shift) & MASK].empty()) {
+                        next = std::min(next, tick);
+                        break;
+                    }
+                }
+            }
+            return start_ + resolution_ * next;
+        }
+
+        /**
+         * Remove every entry
+         * @return the removed values, in no particular order
+         */
+        std::vector<T> drain() {
+            std::vector<T> values;
+            values.reserve(size_);
+            for (auto& level : levels_) {
+                for (auto& slot : level) {
+                    for (auto& entry : slot) {
+                        values.push_back(std::move(entry.value));
+                    }
+                    slot.clear();
+                }
+            }
+            size_ = 0;
+            return values;
+        }
+
+        std::size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+    private:
+        static constexpr std::size_t BITS = 6;
+        static constexpr std::size_t LEVELS = 4;
+        static constexpr uint64_t SLOTS = uint64_t{1} << BITS;
+        static constexpr uint64_t MASK = SLOTS - 1;
+        static constexpr uint64_t RANGE = uint64_t{1} << (BITS * LEVELS); // ticks covered by the top level
+
+        struct Entry {
+            uint64_t tick;
+            T value;
+        };
+
+        uint64_t floorTick(const Clock::time_point time) const {
+            if (time <= start_) {
+                return 0;
+            }
+            return static_cast<uint64_t>((time - start_) / resolution_);
+        }
+
+        uint64_t ceilTick(const Clock::time_point time) const {
+            const auto tick = floorTick(time);
+            return start_ + resolution_ * tick < time ? tick + 1 : tick;
+        }
+
+        void place(Entry entry) {
+            const auto delta = std::min(entry.tick - now_, RANGE - 1);
+            std::size_t level = 0;
+            while (level + 1 < LEVELS && delta >= (uint64_t{1} << (BITS * (level + 1)))) {
+                ++level;
+            }
+            const auto slot_tick = now_ + delta;
+            levels_[level][(slot_tick >> (BITS * level)) & MASK].push_back(std::move(entry));
+        }
+
+        void cascade(const std::size_t level) {
+            auto& slot = levels_[level][(now_ >> (BITS * level)) & MASK];
+            auto entries = std::move(slot);
+            slot.clear();
+            for (auto& entry : entries) {
+                place(std::move(entry));
+            }
+        }
+
+        const Clock::duration resolution_;
+        const Clock::time_point start_;
+        uint64_t now_{0}; // last tick advanced to
+        std::size_t size_{0};
+        std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> levels_;
+    };
+} // namespace service::core
@@ -0,0 +1,50 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace service::core {
+    WorkerPool::WorkerPool(const std::size_t threads) {
+        const auto count = std::max<std::size_t>(threads, 1);
+        workers_.reserve(count);
+        for (std::size_t index = 0; index < count; ++index) {
+            workers_.emplace_back([this](const std::stop_token& stop_token) { run(stop_token); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        for (auto& worker : workers_) {
+            worker.request_stop();
+        }
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    void WorkerPool::submit(Job job) {
+        {
+            std::lock_guard lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        cv_.notify_one();
+    }
+
+    void WorkerPool::run(const std::stop_token& stop_token) {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock lock(mutex_);
+                // A stopping pool still drains its queue, submitters may be waiting on the jobs
+                cv_.wait(lock, stop_token, [this] { return !jobs_.empty(); });
+                if (jobs_.empty()) {
+                    return;
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+} // namespace service::core
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace service::core {
+    /**
+     * Fixed set of threads running submitted jobs in submission order
+     * Jobs beyond the thread count wait in the queue instead of starting threads of their own
+     */
+    class WorkerPool {
+    public:
+        using Job = std::function<void()>;
+
+        /**
+         * @param threads number of jobs running at once
+         */
+        explicit WorkerPool(std::size_t threads);
+
+        /**
+         * Run the jobs still queued, then join the threads
+         */
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        void submit(Job job);
+
+    private:
+        void run(const std::stop_token& stop_token);
+
+        std::mutex mutex_;
+        std::condition_variable_any cv_;
+        std::deque<Job> jobs_;
+
+        std::vector<std::jthread> workers_;
+    };
+} // namespace service::core
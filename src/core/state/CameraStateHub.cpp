@@ -0,0 +1,349 @@
+#include "CameraStateHub.h"
+
+#include <algorithm>
+#include <bit>
+#include <future>
+#include <utility>
+
+#include "common/logger/Logger.h"
+
+namespace service::core {
+    CameraStateHub::CameraStateHub(const common::StateHubConfig& config, RefreshFunction refresh)
+        : queue_size_(config.queue_size), poll_min_(config.poll_min), poll_max_(config.poll_max),
+          refresh_(std::move(refresh)) {
+        poller_ = std::jthread([this](const std::stop_token& stop_token) { run(stop_token); });
+    }
+
+    namespace {
+        std::size_t indexOf(const common::types::CameraStateField field) {
+            return static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(field)));
+        }
+
+        std::optional<common::types::StateValue> valueOf(const common::types::CameraState& state,
+                                                         const common::types::CameraStateField field) {
+            switch (field) {
+            case common::types::CameraStateField::Zoom:
+                if (state.zoom_level) { return *state.zoom_level; }
+                break;
+            case common::types::CameraStateField::Focus:
+                if (state.focus_value) { return *state.focus_value; }
+                break;
+            case common::types::CameraStateField::AutoFocus:
+                if (state.auto_focus) { return *state.auto_focus; }
+                break;
+            case common::types::CameraStateField::Stabilization:
+                if (state.stabilization) { return *state.stabilization; }
+                break;
+            }
+            return std::nullopt;
+        }
+    } // unnamed namespace
+
+    CameraStateHub::~CameraStateHub() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+
+        poller_.request_stop();
+        if (poller_.joinable()) {
+            poller_.join();
+        }
+
+        Notifications stopped;
+        {
+            std::lock_guard publish_lock(publish_mutex_);
+            std::lock_guard lock(mutex_);
+            for (auto& [camera_id, entry] : cameras_) {
+                for (const auto& weak_subscriber : entry.subscribers) {
+                    if (const auto subscriber = weak_subscriber.lock()) {
+                        subscriber->close();
+                    }
+                }
+            }
+            for (auto& wait : change_waits_) {
+                stopped.emplace_back(std::move(wait.listener), std::nullopt);
+            }
+            change_waits_.clear();
+        }
+        notify(stopped);
+    }
+
+    std::shared_ptr<common::state::CameraStateSubscription> CameraStateHub::subscribe(
+        const uint32_t camera_id, const common::types::CameraStateFields fields) {
+        auto subscription =
+            std::make_shared<common::state::CameraStateSubscription>(camera_id, fields, queue_size_);
+
+        // Snapshot and deltas are ordered by the publish lock
+        std::lock_guard publish_lock(publish_mutex_);
+        {
+            std::lock_guard lock(mutex_);
+            auto& entry = cameras_[camera_id];
+            pruneSubscribers(entry);
+            if (entry.subscribers.empty()) {
+                entry.poll_interval = poll_min_;
+                entry.next_poll = entry.observed ? Clock::now() + poll_min_ : Clock::now();
+            }
+            entry.subscribers.push_back(subscription);
+            subscription->push(entry.state, true);
+            wake_ = true;
+        }
+        poll_cv_.notify_all();
+
+        LOG_DEBUG("New state subscriber for camera {}", camera_id);
+        return subscription;
+    }
+
+    bool CameraStateHub::publish(const uint32_t camera_id, const common::types::CameraState& observed) {
+        Notifications changed_waits;
+        {
+            std::lock_guard publish_lock(publish_mutex_);
+            common::types::CameraState delta;
+            std::vector<std::shared_ptr<common::state::CameraStateSubscription>> subscribers;
+            {
+                std::lock_guard lock(mutex_);
+                auto& entry = cameras_[camera_id];
+                delta = entry.state.changesIn(observed);
+                entry.state.merge(observed);
+                entry.observed = true;
+                if (delta.empty()) {
+                    return false;
+                }
+
+                const auto changed = delta.fields();
+                for (std::size_t index = 0; index < entry.generations.size(); ++index) {
+                    if ((changed & (1u << index)) != 0) {
+                        entry.generations[index] = ++last_generation_;
+                    }
+                }
+                changed_waits = takeEndedWaits(Clock::now());
+
+                // Something moves, keep a close eye on it
+                entry.poll_interval = poll_min_;
+                entry.next_poll = Clock::now() + poll_min_;
+                for (const auto& weak_subscriber : entry.subscribers) {
+                    if (auto subscriber = weak_subscriber.lock()) {
+                        subscribers.push_back(std::move(subscriber));
+                    }
+                }
+            }
+
+            for (const auto& subscriber : subscribers) {
+                subscriber->push(delta, false);
+            }
+        }
+
+        // Listeners may publish in turn, they run without the hub locks
+        notify(changed_waits);
+        return true;
+    }
+
+    bool CameraStateHub::publishVideoState(const uint32_t camera_id, const std::string& capability,
+                                           const bool enable) {
+        Notifications changed_waits;
+        {
+            std::lock_guard lock(mutex_);
+            auto& video_state = cameras_[camera_id].video_states[capability];
+            if (video_state.generation != 0 && video_state.enable == enable) {
+                return false;
+            }
+            video_state.enable = enable;
+            video_state.generation = ++last_generation_;
+            changed_waits = takeEndedWaits(Clock::now());
+        }
+        notify(changed_waits);
+        return true;
+    }
+
+    common::types::VersionedValue CameraStateHub::versioned(const uint32_t camera_id,
+                                                            const common::types::StateField& field) const {
+        std::lock_guard lock(mutex_);
+        return versionedLocked(camera_id, field);
+    }
+
+    void CameraStateHub::onChange(const uint32_t camera_id, const common::types::StateField& field,
+                                  const common::types::Generation generation,
+                                  const std::chrono::steady_clock::time_point deadline, ChangeListener listener) {
+        std::optional<common::types::Generation> current;
+        {
+            std::lock_guard lock(mutex_);
+            if (!stopping_) {
+                current = versionedLocked(camera_id, field).generation;
+                if (*current == generation && deadline > Clock::now()) {
+                    change_waits_.push_back({.camera_id = camera_id,
+                                             .field = field,
+                                             .generation = generation,
+                                             .deadline = deadline,
+                                             .listener = std::move(listener)});
+                    // The poller ends the wait at its deadline
+                    wake_ = true;
+                    poll_cv_.notify_all();
+                    return;
+                }
+            }
+        }
+        listener(current);
+    }
+
+    std::optional<common::types::Generation> CameraStateHub::waitForChange(
+        const uint32_t camera_id,
+        const common::types::StateField& field,
+        const common::types::Generation generation,
+        const std::chrono::steady_clock::time_point deadline) {
+        const auto changed = std::make_shared<std::promise<std::optional<common::types::Generation>>>();
+        auto current = changed->get_future();
+        onChange(camera_id, field, generation, deadline,
+                 [changed](const std::optional<common::types::Generation> generation_now) {
+                     changed->set_value(generation_now);
+                 });
+        return current.get();
+    }
+
+    CameraStateHub::Notifications CameraStateHub::takeEndedWaits(const Clock::time_point now) {
+        Notifications ended;
+        for (auto wait = change_waits_.begin(); wait != change_waits_.end();) {
+            const auto current = versionedLocked(wait->camera_id, wait->field).generation;
+            if (current == wait->generation && wait->deadline > now) {
+                ++wait;
+                continue;
+            }
+            ended.emplace_back(std::move(wait->listener), current);
+            wait = change_waits_.erase(wait);
+        }
+        return ended;
+    }
+
+    void CameraStateHub::notify(Notifications& notifications) {
+        for (auto& [listener, generation] : notifications) {
+            listener(generation);
+        }
+    }
+
+    common::types::VersionedValue CameraStateHub::versionedLocked(const uint32_t camera_id,
+                                                                  const common::types::StateField& field) const {
+        const auto it = cameras_.find(camera_id);
+        if (it == cameras_.end()) {
+            return {};
+        }
+
+        const auto& entry = it->second;
+        if (const auto* const camera_field = std::get_if<common::types::CameraStateField>(&field)) {
+            return {.value = valueOf(entry.state, *camera_field),
+                    .generation = entry.generations[indexOf(*camera_field)]};
+        }
+
+        const auto video_it = entry.video_states.find(std::get<std::string>(field));
+        if (video_it == entry.video_states.end()) {
+            return {};
+        }
+        return {.value = video_it->second.enable, .generation = video_it->second.generation};
+    }
+
+    void CameraStateHub::requestRefresh(const uint32_t camera_id) {
+        {
+            std::lock_guard lock(mutex_);
+            auto& entry = cameras_[camera_id];
+            entry.poll_interval = poll_min_;
+            entry.next_poll = Clock::now();
+            wake_ = true;
+        }
+        poll_cv_.notify_all();
+    }
+
+    bool CameraStateHub::hasState(const uint32_t camera_id) const {
+        std::lock_guard lock(mutex_);
+        const auto it = cameras_.find(camera_id);
+        return it != cameras_.end() && it->second.observed;
+    }
+
+    std::optional<common::types::CameraState> CameraStateHub::watchedState(const uint32_t camera_id) const {
+        std::lock_guard lock(mutex_);
+        const auto it = cameras_.find(camera_id);
+        if (it == cameras_.end() || !it->second.observed) {
+            return std::nullopt;
+        }
+        const auto watched = std::any_of(it->second.subscribers.begin(), it->second.subscribers.end(),
+                                         [](const auto& weak_subscriber) {
+                                             const auto subscriber = weak_subscriber.lock();
+                                             return subscriber && !subscriber->isClosed();
+                                         });
+        if (!watched) {
+            return std::nullopt;
+        }
+        return it->second.state;
+    }
+
+    std::size_t CameraStateHub::subscriberCount(const uint32_t camera_id) const {
+        std::lock_guard lock(mutex_);
+        const auto it = cameras_.find(camera_id);
+        if (it == cameras_.end()) {
+            return 0;
+        }
+        return std::count_if(it->second.subscribers.begin(), it->second.subscribers.end(),
+                             [](const auto& weak_subscriber) {
+                                 const auto subscriber = weak_subscriber.lock();
+                                 return subscriber && !subscriber->isClosed();
+                             });
+    }
+
+    bool CameraStateHub::pruneSubscribers(CameraEntry& entry) {
+        std::erase_if(entry.subscribers, [](const auto& weak_subscriber) {
+            const auto subscriber = weak_subscriber.lock();
+            return !subscriber || subscriber->isClosed();
+        });
+        return !entry.subscribers.empty();
+    }
+
+    void CameraStateHub::run(const std::stop_token& stop_token) {
+        std::unique_lock lock(mutex_);
+        while (!stop_token.stop_requested()) {
+            const auto now = Clock::now();
+            if (auto expired = takeEndedWaits(now); !expired.empty()) {
+                lock.unlock();
+                notify(expired);
+                lock.lock();
+                continue;
+            }
+
+            // Only watched cameras are polled
+            std::optional<uint32_t> due_camera;
+            auto next_wake = Clock::time_point::max();
+            for (const auto& wait : change_waits_) {
+                next_wake = std::min(next_wake, wait.deadline);
+            }
+            for (auto& [camera_id, entry] : cameras_) {
+                if (!pruneSubscribers(entry)) {
+                    continue;
+                }
+                if (entry.next_poll <= now) {
+                    due_camera = camera_id;
+                    break;
+                }
+                next_wake = std::min(next_wake, entry.next_poll);
+            }
+
+            if (!due_camera) {
+                const auto woken = [this] { return std::exchange(wake_, false); };
+                if (next_wake == Clock::time_point::max()) {
+                    poll_cv_.wait(lock, stop_token, woken);
+                } else {
+                    poll_cv_.wait_until(lock, stop_token, next_wake, woken);
+                }
+                continue;
+            }
+
+            // The refresh may publish what it reads on its own, any generation it advanced counts as a change
+            const auto camera_id = *due_camera;
+            const auto generations = cameras_[camera_id].generations;
+            lock.unlock();
+            publish(camera_id, refresh_(camera_id));
+            lock.lock();
+
+            auto& entry = cameras_[camera_id];
+            if (entry.generations == generations) {
+                entry.poll_interval = std::min(std::max(entry.poll_interval * 2, poll_min_), poll_max_);
+                entry.next_poll = Clock::now() + entry.poll_interval;
+            }
+        }
+    }
+} // namespace service::core
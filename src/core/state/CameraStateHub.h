@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/config/ConfigManager.h"
+#include "common/types/CameraState.h"
+#include "common/types/StateGeneration.h"
+#include "common/state/CameraStateSubscription.h"
+
+namespace service::core {
+    /**
+     * Shared per-camera state feeding every WatchCameraState subscriber of a camera
+     * The state is refreshed from observed Sets/Gets and by polling the backend of watched cameras;
+     * the poll interval backs off while nothing changes and snaps back on any observed change.
+     * Every field, and every observed video capability state, carries a generation that is bumped
+     * from a hub-wide counter whenever its value changes
+     */
+    class CameraStateHub {
+    public:
+        /**
+         * Read the current state of a camera from its backend, unreadable fields are left unset
+         */
+        using RefreshFunction = std::function<common::types::CameraState(uint32_t camera_id)>;
+
+        /**
+         * Called once with the generation of the field when it changed or the deadline passed, nothing if the hub is
+         * stopping. Runs on the thread that published the change, on the poller thread at the deadline, or on the
+         * caller of onChange() if the field already moved on. It should return quickly
+         */
+        using ChangeListener = std::function<void(std::optional<common::types::Generation>)>;
+
+        CameraStateHub(const common::StateHubConfig& config, RefreshFunction refresh);
+
+        /**
+         * Stop the poller and call every pending change listener with nothing
+         */
+        ~CameraStateHub();
+
+        CameraStateHub(const CameraStateHub&) = delete;
+        CameraStateHub& operator=(const CameraStateHub&) = delete;
+
+        /**
+         * Subscribe to a camera, the subscription starts with a snapshot of the known state
+         * @param camera_id camera to watch
+         * @param fields fields to watch
+         */
+        std::shared_ptr<common::state::CameraStateSubscription> subscribe(uint32_t camera_id,
+                                                           common::types::CameraStateFields fields);
+
+        /**
+         * Record observed values and fan the changed fields out to the subscribers
+         * @return true if any field changed
+         */
+        bool publish(uint32_t camera_id, const common::types::CameraState& observed);
+
+        /**
+         * Record an observed video capability state
+         * @return true if it changed
+         */
+        bool publishVideoState(uint32_t camera_id, const std::string& capability, bool enable);
+
+        /**
+         * @return last observed value of a field and its generation, generation 0 if it was never observed
+         */
+        common::types::VersionedValue versioned(uint32_t camera_id, const common::types::StateField& field) const;
+
+        /**
+         * Wait for the generation of a field to differ from generation or the deadline to pass, without a thread
+         * @param listener called with the generation of the field once the wait ends
+         */
+        void onChange(uint32_t camera_id, const common::types::StateField& field,
+                      common::types::Generation generation, std::chrono::steady_clock::time_point deadline,
+                      ChangeListener listener);
+
+        /**
+         * Block until the wait of onChange() ends
+         * @return generation of the field on return, nothing if the hub is stopping
+         */
+        std::optional<common::types::Generation> waitForChange(
+            uint32_t camera_id, const common::types::StateField& field, common::types::Generation generation,
+            std::chrono::steady_clock::time_point deadline);
+
+        /**
+         * Poll the camera as soon as possible, for commands whose resulting state is not known upfront
+         */
+        void requestRefresh(uint32_t camera_id);
+
+        /**
+         * @return true if the state of the camera was observed at least once
+         */
+        bool hasState(uint32_t camera_id) const;
+
+        /**
+         * @return state of a camera that is being watched, which the poller keeps current, nothing otherwise
+         */
+        std::optional<common::types::CameraState> watchedState(uint32_t camera_id) const;
+
+        /**
+         * @return number of live subscriptions of the camera
+         */
+        std::size_t subscriberCount(uint32_t camera_id) const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct VideoState {
+            bool enable{false};
+            common::types::Generation generation{0};
+        };
+
+        struct CameraEntry {
+            common::types::CameraState state;
+            std::array<common::types::Generation, 4> generations{}; // indexed by CameraStateField bit
+            std::unordered_map<std::string, VideoState> video_states; // by capability name
+            bool observed{false};
+            std::vector<std::weak_ptr<common::state::CameraStateSubscription>> subscribers;
+            std::chrono::milliseconds poll_interval{0};
+            Clock::time_point next_poll{};
+        };
+
+        struct ChangeWait {
+            uint32_t camera_id;
+            common::types::StateField field;
+            common::types::Generation generation;
+            Clock::time_point deadline;
+            ChangeListener listener;
+        };
+
+        using Notifications = std::vector<std::pair<ChangeListener, std::optional<common::types::Generation>>>;
+
+        void run(const std::stop_token& stop_token);
+
+        /**
+         * Take the waits whose field moved on or whose deadline passed by now
+         */
+        Notifications takeEndedWaits(Clock::time_point now);
+        static void notify(Notifications& notifications);
+        static bool pruneSubscribers(CameraEntry& entry);
+        common::types::VersionedValue versionedLocked(uint32_t camera_id, const common::types::StateField& field) const;
+
+        const std::size_t queue_size_;
+        const std::chrono::milliseconds poll_min_;
+        const std::chrono::milliseconds poll_max_;
+        RefreshFunction refresh_;
+
+        std::mutex publish_mutex_; // orders deliveries so subscribers see deltas in state order
+        mutable std::mutex mutex_;
+        std::condition_variable_any poll_cv_;
+        bool wake_{false};
+        std::unordered_map<uint32_t, CameraEntry> cameras_;
+        common::types::Generation last_generation_{0};
+        std::list<ChangeWait> change_waits_;
+        bool stopping_{false};
+        std::jthread poller_;
+    };
+} // namespace service::core
@@ -0,0 +1,117 @@
+#include "infrastructure/clients/AddressResolver.h"
+
+#include <vector>
+
+#include "common/logger/Logger.h"
+#include "common/network/NetworkUtils.h"
+
+namespace service::infrastructure {
+    AddressResolver::AddressResolver(const std::chrono::seconds ttl, ResolveFunction resolve_function,
+                                     ChangeFunction on_change)
+        : ttl_(ttl),
+          resolve_function_(resolve_function ? std::move(resolve_function)
+                                             : ResolveFunction(common::network::resolveIpv4Address)),
+          on_change_(std::move(on_change)) {
+        if (ttl_ <= std::chrono::seconds::zero()) {
+            throw std::invalid_argument("Resolver TTL must be positive");
+        }
+
+        refresher_ = std::jthread([this](const std::stop_token& stop_token) { refreshLoop(stop_token); });
+    }
+
+    AddressResolver::~AddressResolver() {
+        refresher_.request_stop();
+    }
+
+    Result<std::string> AddressResolver::resolve(const std::string& host) {
+        if (common::network::isIpv4Address(host)) {
+            return Result<std::string>::success(host);
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            if (const auto it = cache_.find(host);
+                it != cache_.end() && it->second.expires_at > std::chrono::steady_clock::now()) {
+                return Result<std::string>::success(it->second.ip_address);
+            }
+        }
+
+        refresh(host);
+
+        std::lock_guard lock(mutex_);
+        if (const auto it = cache_.find(host); it != cache_.end()) {
+            return Result<std::string>::success(it->second.ip_address);
+        }
+        return Result<std::string>::error("No address known for " + host);
+    }
+
+    Result<std::string> AddressResolver::toChannelTarget(const std::string& address) {
+        const auto separator = address.rfind(':');
+        if (separator == std::string::npos) {
+            return Result<std::string>::error("Address must include port (format: host:port): " + address);
+        }
+
+        const auto ip_result = resolve(address.substr(0, separator));
+        if (ip_result.isError()) {
+            return Result<std::string>::error(ip_result.error());
+        }
+
+        return Result<std::string>::success("ipv4:" + ip_result.value() + address.substr(separator));
+    }
+
+    void AddressResolver::refreshLoop(const std::stop_token& stop_token) {
+        // Refresh at half the TTL so entries are renewed before they expire
+        const auto interval = std::chrono::duration_cast<std::chrono::milliseconds>(ttl_) / 2;
+
+        while (!stop_token.stop_requested()) {
+            std::vector<std::string> hosts;
+            {
+                std::unique_lock lock(mutex_);
+                refresh_cv_.wait_for(lock, stop_token, interval, [] { return false; });
+                if (stop_token.stop_requested()) {
+                    return;
+                }
+                hosts.reserve(cache_.size());
+                for (const auto& [host, _] : cache_) {
+                    hosts.push_back(host);
+                }
+            }
+
+            for (const auto& host : hosts) {
+                if (stop_token.stop_requested()) {
+                    return;
+                }
+                if (refresh(host) && on_change_) {
+                    on_change_(host);
+                }
+            }
+        }
+    }
+
+    bool AddressResolver::refresh(const std::string& host) {
+        const auto result = resolve_function_(host);
+
+        std::lock_guard lock(mutex_);
+        const auto it = cache_.find(host);
+
+        if (result.isError()) {
+            if (it != cache_.end()) {
+                LOG_WARN("Failed to refresh {} ({}), keeping last known address {}", host, result.error().message,
+                         it->second.ip_address);
+            } else {
+                LOG_WARN("{}", result.error().message);
+            }
+            return false;
+        }
+
+        const auto changed = it != cache_.end() && it->second.ip_address != result.value();
+        if (it == cache_.end()) {
+            LOG_DEBUG("Resolved {} to {}", host, result.value());
+        } else if (changed) {
+            LOG_INFO("Address of {} changed from {} to {}", host, it->second.ip_address, result.value());
+        }
+
+        cache_[host] = Entry{result.value(), std::chrono::steady_clock::now() + ttl_};
+        return changed;
+    }
+} // namespace service::infrastructure
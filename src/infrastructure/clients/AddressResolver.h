@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "common/types/Result.h"
+
+namespace service::infrastructure {
+    /**
+     * Caches IPv4 addresses of backend hosts
+     * Entries are refreshed in the background before they expire, and the last known
+     * good address is kept when resolution fails so channels can always be built
+     * with ipv4: targets that never block on name resolution
+     */
+    class AddressResolver {
+    public:
+        using ResolveFunction = std::function<Result<std::string>(const std::string& host)>;
+        using ChangeFunction = std::function<void(const std::string& host)>;
+
+        /**
+         * @param ttl time an address is considered fresh
+         * @param resolve_function blocking host -> IPv4 lookup, getaddrinfo by default
+         * @param on_change called on the refresh thread once a background refresh finds a new address for a host,
+         *        the new address is already served
+         */
+        explicit AddressResolver(std::chrono::seconds ttl, ResolveFunction resolve_function = {},
+                                 ChangeFunction on_change = {});
+        ~AddressResolver();
+
+        AddressResolver(const AddressResolver&) = delete;
+        AddressResolver& operator=(const AddressResolver&) = delete;
+
+        /**
+         * Resolve a host, serving from cache while the entry is fresh
+         * @param host host name or IPv4 literal
+         * @return IPv4 address, the last known good one if resolution fails,
+         *         error if the host was never resolved
+         */
+        Result<std::string> resolve(const std::string& host);
+
+        /**
+         * Build an ipv4: channel target for a host:port address
+         * @param address backend address (format: host:port)
+         * @return ipv4:<ip>:<port>, error if the host cannot be resolved
+         */
+        Result<std::string> toChannelTarget(const std::string& address);
+
+    private:
+        struct Entry {
+            std::string ip_address;
+            std::chrono::steady_clock::time_point expires_at;
+        };
+
+        void refreshLoop(const std::stop_token& stop_token);
+        /**
+         * @return true if the host had an address and it changed
+         */
+        bool refresh(const std::string& host);
+
+        std::chrono::seconds ttl_;
+        ResolveFunction resolve_function_;
+        ChangeFunction on_change_;
+
+        std::mutex mutex_;
+        std::condition_variable_any refresh_cv_;
+        std::unordered_map<std::string, Entry> cache_;
+
+        std::jthread refresher_;
+    };
+} // namespace service::infrastructure
@@ -0,0 +1,58 @@
+#include "infrastructure/clients/AdmissionLimiter.h"
+
+#include "common/logger/Logger.h"
+
+namespace service::infrastructure {
+    AdmissionLimiter::AdmissionLimiter(std::string target, const common::AdmissionConfig& config, Timer timer)
+        : target_(std::move(target)), config_(config), timer_(std::move(timer)) {
+        if (config_.set.rate_hz > 0) {
+            set_.emplace(config_.set.rate_hz, config_.set.burst);
+        }
+        if (config_.get.rate_hz > 0) {
+            get_.emplace(config_.get.rate_hz, config_.get.burst);
+        }
+    }
+
+    bool AdmissionLimiter::isNewestOf(const std::string& axis, const uint64_t order) const {
+        const auto it = waiting_.find(axis);
+        return it != waiting_.end() && !it->second.empty() && *it->second.rbegin() == order;
+    }
+
+    void AdmissionLimiter::stopWaiting(const std::string& axis, const uint64_t order) {
+        conflating_.fetch_sub(1, std::memory_order_release);
+        if (const auto it = waiting_.find(axis); it != waiting_.end()) {
+            it->second.erase(order);
+            if (it->second.empty()) {
+                waiting_.erase(it);
+            }
+        }
+    }
+
+    void AdmissionLimiter::wakeAt(const Clock::time_point due, std::function<void(bool fired)> wake) {
+        if (due <= Clock::now()) {
+            wake(true);
+            return;
+        }
+        if (timer_) {
+            timer_(due, std::move(wake));
+            return;
+        }
+        std::this_thread::sleep_until(due);
+        wake(true);
+    }
+
+    common::types::Error AdmissionLimiter::rejection(const char* operation_class,
+                                                     const Clock::duration retry_after) const {
+        const auto retry_ms = std::max<int64_t>(
+            std::chrono::ceil<std::chrono::milliseconds>(retry_after).count(), 1);
+        LOG_DEBUG("Rejected {} command to {}, next token in {} ms", operation_class, target_, retry_ms);
+        return {common::types::ErrorCode::AdmissionRejected,
+                std::string("Backend admission limit reached for ") + operation_class + " commands to " + target_ +
+                    ", retry in " + std::to_string(retry_ms) + " ms"};
+    }
+
+    common::types::Error AdmissionLimiter::stopped() const {
+        return {common::types::ErrorCode::Internal,
+                "Backend admission to " + target_ + " stopped while the command waited for its token"};
+    }
+} // namespace service::infrastructure
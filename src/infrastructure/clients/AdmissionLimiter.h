@@ -0,0 +1,349 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/async/Task.h"
+#include "common/config/ConfigManager.h"
+#include "common/types/Result.h"
+#include "infrastructure/clients/TokenBucket.h"
+
+namespace service::infrastructure {
+    /**
+     * Token-bucket admission of the commands to one backend instance, sets and gets limited apart
+     * A command with a token at hand goes straight through, only checking its bucket. Past the limit a command
+     * queues until its reserved token is ready, is rejected, or for sets is conflated: one command per kind waits
+     * for its token and is sent with the newest value of its kind, every caller it absorbed gets its result
+     * Asynchronous commands wait for their token on the timer instead of a thread
+     */
+    class AdmissionLimiter {
+    public:
+        using Clock = TokenBucket::Clock;
+        /**
+         * Calls wake at due, or with false once it stopped and never will
+         */
+        using Timer = std::function<void(Clock::time_point due, std::function<void(bool fired)> wake)>;
+
+        // Starts an asynchronous command, called once it may be sent
+        template<typename T>
+        using AsyncSend = std::function<common::async::Task<Result<T>>()>;
+
+        /**
+         * @param target service and instance named in rejections, e.g. camera_service instance 0
+         * @param timer wakes the asynchronous commands, unset they wait on the thread that awaits them
+         */
+        AdmissionLimiter(std::string target, const common::AdmissionConfig& config, Timer timer = {});
+
+        AdmissionLimiter(const AdmissionLimiter&) = delete;
+        AdmissionLimiter& operator=(const AdmissionLimiter&) = delete;
+
+        /**
+         * Send a read once the get limit allows it
+         * @return result of send, or an admission rejection without calling it
+         */
+        template<typename T>
+        Result<T> read(const std::function<Result<T>()>& send) {
+            if (!get_) {
+                return send();
+            }
+            return admit(*get_, config_.get, "get", send);
+        }
+
+        /**
+         * Send a command that changes the camera once the set limit allows it
+         * @param kind commands of the same kind conflate, they must share T, e.g. every zoom command
+         * @param axis kinds driving the same axis, e.g. setpoints and end stops of the zoom. A command never conflates
+         *        into one that waits ahead of another kind of its axis, it queues behind instead. Empty for the kind
+         *        alone
+         * @return result of send, of a newer command of the kind it was conflated into, or an admission rejection
+         */
+        template<typename T>
+        Result<T> command(const std::string& kind, std::function<Result<T>()> send, const std::string& axis = {}) {
+            if (!set_) {
+                return send();
+            }
+            if (config_.set.on_limit != common::AdmissionMode::Conflate) {
+                return admit(*set_, config_.set, "set", send);
+            }
+            // A waiting command of the kind goes first, or this one would overtake it
+            if (conflating_.load(std::memory_order_acquire) == 0 && set_->reserve(Clock::now()).granted) {
+                return send();
+            }
+            return conflate<T>(kind, axis.empty() ? kind : axis, std::move(send));
+        }
+
+        /**
+         * command() for an asynchronous send, it conflates with the synchronous commands of its kind
+         * @return task resuming on the timer past the limit, else on the thread that completed send
+         */
+        template<typename T>
+        common::async::Task<Result<T>> commandAsync(std::string kind, AsyncSend<T> send, std::string axis = {}) {
+            if (!set_) {
+                co_return co_await send();
+            }
+            if (config_.set.on_limit != common::AdmissionMode::Conflate) {
+                const auto admitted = co_await common::async::fromCallback<Result<void>>([this](auto complete) {
+                    wait(*set_, config_.set, "set", std::move(complete));
+                });
+                if (admitted.isError()) {
+                    co_return Result<T>::error(admitted.error());
+                }
+                co_return co_await send();
+            }
+            if (conflating_.load(std::memory_order_acquire) == 0 && set_->reserve(Clock::now()).granted) {
+                co_return co_await send();
+            }
+            co_return co_await common::async::fromCallback<Result<T>>([&](auto complete) {
+                conflate<T>(kind, axis.empty() ? kind : axis, std::move(send), std::move(complete));
+            });
+        }
+
+        /**
+         * Take a token for a call the limiter does not send, e.g. a passthrough call relayed as bytes
+         * It waits like a queued command, on the timer. A conflating set limit queues it too, its bytes carry no value
+         * to merge
+         * @param command true for a command that changes the camera, false for a read
+         * @return an admission rejection if no token is ready within max_wait
+         */
+        common::async::Task<Result<void>> acquireAsync(const bool command) {
+            auto* const bucket = command ? &set_ : &get_;
+            if (!*bucket) {
+                co_return Result<void>::success();
+            }
+            co_return co_await common::async::fromCallback<Result<void>>([&](auto complete) {
+                wait(**bucket, command ? config_.set : config_.get, command ? "set" : "get", std::move(complete));
+            });
+        }
+
+    private:
+        template<typename T>
+        using Done = std::function<void(Result<T>)>;
+
+        template<typename T>
+        struct Pending {
+            AsyncSend<T> send; // newest command of the kind
+            std::vector<Done<T>> absorbed; // callers of the commands it replaced
+        };
+
+        template<typename T>
+        Result<T> admit(TokenBucket& bucket, const common::AdmissionLimit& limit, const char* operation_class,
+                        const std::function<Result<T>()>& send) {
+            const auto now = Clock::now();
+            const auto max_wait = limit.on_limit == common::AdmissionMode::Reject
+                                      ? Clock::duration::zero()
+                                      : std::chrono::duration_cast<Clock::duration>(limit.max_wait);
+            const auto reservation = bucket.reserve(now, max_wait);
+            if (!reservation.granted) {
+                return Result<T>::error(rejection(operation_class, reservation.ready - now));
+            }
+            std::this_thread::sleep_until(reservation.ready);
+            return send();
+        }
+
+        /**
+         * Reserve a token and call ready once it may be used, or at once with the rejection
+         */
+        void wait(TokenBucket& bucket, const common::AdmissionLimit& limit, const char* operation_class,
+                  std::function<void(Result<void>)> ready) {
+            const auto now = Clock::now();
+            const auto max_wait = limit.on_limit == common::AdmissionMode::Reject
+                                      ? Clock::duration::zero()
+                                      : std::chrono::duration_cast<Clock::duration>(limit.max_wait);
+            const auto reservation = bucket.reserve(now, max_wait);
+            if (!reservation.granted) {
+                ready(Result<void>::error(rejection(operation_class, reservation.ready - now)));
+                return;
+            }
+            wakeAt(reservation.ready, [this, ready = std::move(ready)](const bool fired) {
+                ready(fired ? Result<void>::success() : Result<void>::error(stopped()));
+            });
+        }
+
+        template<typename T>
+        static common::async::Task<Result<T>> sendNow(const std::function<Result<T>()> send) {
+            co_return send();
+        }
+
+        template<typename T>
+        Result<T> conflate(const std::string& kind, const std::string& axis, std::function<Result<T>()> send) {
+            AsyncSend<T> send_async = [send = std::move(send)] { return sendNow<T>(send); };
+            std::unique_lock lock(mutex_);
+            if (const auto it = pending_.find(kind); it != pending_.end() && isNewestOf(axis, it->second.order)) {
+                auto& pending = *std::static_pointer_cast<Pending<T>>(it->second.pending);
+                pending.send = std::move(send_async);
+                auto absorbed = std::make_shared<std::promise<Result<T>>>();
+                auto result = absorbed->get_future();
+                pending.absorbed.emplace_back([absorbed](Result<T> latest) { absorbed->set_value(std::move(latest)); });
+                lock.unlock();
+                return result.get();
+            }
+
+            const auto now = Clock::now();
+            const auto reservation =
+                set_->reserve(now, std::chrono::duration_cast<Clock::duration>(config_.set.max_wait));
+            if (!reservation.granted) {
+                return Result<T>::error(rejection("set", reservation.ready - now));
+            }
+
+            const auto order = next_order_++;
+            waiting_[axis].insert(order);
+            conflating_.fetch_add(1, std::memory_order_release);
+            // The kind already waits ahead of another kind of the axis, this command is sent on its own behind both
+            if (pending_.contains(kind)) {
+                lock.unlock();
+                std::this_thread::sleep_until(reservation.ready);
+                lock.lock();
+                stopWaiting(axis, order);
+                lock.unlock();
+                return common::async::syncWait(send_async());
+            }
+
+            const auto pending = std::make_shared<Pending<T>>(Pending<T>{std::move(send_async), {}});
+            pending_.emplace(kind, Entry{order, pending});
+            lock.unlock();
+
+            std::this_thread::sleep_until(reservation.ready);
+
+            lock.lock();
+            pending_.erase(kind);
+            stopWaiting(axis, order);
+            const auto latest = std::move(pending->send);
+            const auto absorbed = std::move(pending->absorbed);
+            lock.unlock();
+
+            try {
+                auto result = common::async::syncWait(latest());
+                for (const auto& done : absorbed) {
+                    done(result);
+                }
+                return result;
+            } catch (...) {
+                for (const auto& done : absorbed) {
+                    done(Result<T>::error("The " + kind + " command it was conflated into failed"));
+                }
+                throw;
+            }
+        }
+
+        /**
+         * conflate() for an asynchronous send, done runs on the timer or on the thread that completed the send
+         */
+        template<typename T>
+        void conflate(const std::string& kind, const std::string& axis, AsyncSend<T> send, Done<T> done) {
+            std::unique_lock lock(mutex_);
+            if (const auto it = pending_.find(kind); it != pending_.end() && isNewestOf(axis, it->second.order)) {
+                auto& pending = *std::static_pointer_cast<Pending<T>>(it->second.pending);
+                pending.send = std::move(send);
+                pending.absorbed.emplace_back(std::move(done));
+                return;
+            }
+
+            const auto now = Clock::now();
+            const auto reservation =
+                set_->reserve(now, std::chrono::duration_cast<Clock::duration>(config_.set.max_wait));
+            if (!reservation.granted) {
+                lock.unlock();
+                done(Result<T>::error(rejection("set", reservation.ready - now)));
+                return;
+            }
+
+            const auto order = next_order_++;
+            waiting_[axis].insert(order);
+            conflating_.fetch_add(1, std::memory_order_release);
+            if (pending_.contains(kind)) {
+                lock.unlock();
+                wakeAt(reservation.ready, [this, axis, order, send = std::move(send), done = std::move(done)](
+                                              const bool fired) {
+                    {
+                        std::lock_guard wake_lock(mutex_);
+                        stopWaiting(axis, order);
+                    }
+                    if (!fired) {
+                        done(Result<T>::error(stopped()));
+                        return;
+                    }
+                    common::async::start(send(), done);
+                });
+                return;
+            }
+
+            const auto pending = std::make_shared<Pending<T>>(Pending<T>{std::move(send), {}});
+            pending_.emplace(kind, Entry{order, pending});
+            lock.unlock();
+
+            wakeAt(reservation.ready, [this, kind, axis, order, pending, done = std::move(done)](const bool fired) {
+                std::unique_lock wake_lock(mutex_);
+                pending_.erase(kind);
+                stopWaiting(axis, order);
+                const auto latest = std::move(pending->send);
+                auto absorbed = std::move(pending->absorbed);
+                wake_lock.unlock();
+
+                absorbed.push_back(done);
+                if (!fired) {
+                    for (const auto& waiting : absorbed) {
+                        waiting(Result<T>::error(stopped()));
+                    }
+                    return;
+                }
+                common::async::start(latest(), [absorbed = std::move(absorbed)](const Result<T>& result) {
+                    for (const auto& waiting : absorbed) {
+                        waiting(result);
+                    }
+                });
+            });
+        }
+
+        /**
+         * Run wake at due on the timer, or sleep until due and run it here without one
+         */
+        void wakeAt(Clock::time_point due, std::function<void(bool fired)> wake);
+
+        /**
+         * @return true if the command reserved at order is the newest waiting on axis, mutex held
+         */
+        bool isNewestOf(const std::string& axis, uint64_t order) const;
+
+        /**
+         * Forget a command of axis that got its token, mutex held
+         */
+        void stopWaiting(const std::string& axis, uint64_t order);
+
+        /**
+         * @return error of a command refused by the limit, with the AdmissionRejected code
+         */
+        common::types::Error rejection(const char* operation_class, Clock::duration retry_after) const;
+
+        /**
+         * @return error of a command whose timer stopped before its token was ready
+         */
+        common::types::Error stopped() const;
+
+        const std::string target_;
+        const common::AdmissionConfig config_;
+        std::optional<TokenBucket> set_; // unset if sets are unlimited
+        std::optional<TokenBucket> get_; // unset if gets are unlimited
+        const Timer timer_;
+
+        // Conflation only, commands within the limit never take the lock
+        std::atomic<uint32_t> conflating_{0}; // commands waiting for their token
+        std::mutex mutex_;
+        struct Entry {
+            uint64_t order; // when the command reserved its token among the waiting ones
+            std::shared_ptr<void> pending; // a Pending of the kind's T
+        };
+        std::unordered_map<std::string, Entry> pending_; // by kind
+        std::unordered_map<std::string, std::set<uint64_t>> waiting_; // by axis, orders of its commands still waiting
+        uint64_t next_order_{0};
+    };
+} // namespace service::infrastructure
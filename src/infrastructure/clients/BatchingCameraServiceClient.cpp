@@ -0,0 +1,207 @@
+#include "infrastructure/clients/BatchingCameraServiceClient.h"
+
+#include "infrastructure/clients/CameraServiceClient.h"
+
+namespace service::infrastructure {
+    namespace {
+        template<typename T, typename Convert>
+        Result<T> fromBatchResult(const camera::v1::BatchResult& result, const std::string& method,
+                                  Convert convert) {
+            if (result.status_code() != grpc::StatusCode::OK) {
+                return Result<T>::error(std::string("camera_service.") + method + ": " + result.error_message());
+            }
+            if constexpr (std::is_void_v<T>) {
+                return Result<void>::success();
+            } else {
+                return Result<T>::success(convert(result));
+            }
+        }
+
+        // Conversion of commands that answer without a value
+        constexpr auto NO_VALUE = [](const camera::v1::BatchResult&) {};
+    } // unnamed namespace
+
+    BatchingCameraServiceClient::BatchingCameraServiceClient(std::unique_ptr<ICameraServiceClient> client,
+                                                             std::shared_ptr<HostBatcher> batcher,
+                                                             const uint32_t port)
+        : client_(std::move(client)), batcher_(std::move(batcher)), port_(port) {
+        if (!client_) {
+            throw std::invalid_argument("Batched camera_service client cannot be null");
+        }
+        if (!batcher_) {
+            throw std::invalid_argument("Host batcher cannot be null");
+        }
+    }
+
+    std::optional<camera::v1::BatchResult> BatchingCameraServiceClient::submit(
+        camera::v1::BatchCommand command) const {
+        if (!batcher_->isSupported()) {
+            return std::nullopt;
+        }
+        command.set_port(port_);
+        return batcher_->execute(std::move(command));
+    }
+
+    common::async::Task<std::optional<camera::v1::BatchResult>> BatchingCameraServiceClient::submitAsync(
+        camera::v1::BatchCommand command, const common::state::CallContext call) const {
+        if (!batcher_->isSupported()) {
+            co_return std::nullopt;
+        }
+        command.set_port(port_);
+        co_return co_await batcher_->executeAsync(std::move(command), call);
+    }
+
+    template<typename T, typename Fallback, typename Convert>
+    Result<T> BatchingCameraServiceClient::batched(camera::v1::BatchCommand command, const std::string& method,
+                                                   Fallback fallback, Convert convert) const {
+        const auto active_call = batcher_->track(port_);
+
+        const auto result = submit(std::move(command));
+        if (!result) {
+            return fallback();
+        }
+        return fromBatchResult<T>(*result, method, convert);
+    }
+
+    template<typename T, typename Fallback, typename Convert>
+    common::async::Task<Result<T>> BatchingCameraServiceClient::batchedAsync(camera::v1::BatchCommand command,
+                                                                            const common::state::CallContext call,
+                                                                            std::string method, Fallback fallback,
+                                                                            Convert convert) const {
+        const auto active_call = batcher_->track(port_);
+
+        const auto result = co_await submitAsync(std::move(command), call);
+        if (!result) {
+            co_return co_await fallback();
+        }
+        co_return fromBatchResult<T>(*result, method, convert);
+    }
+
+    // Zoom operations
+    Result<common::types::zoom> BatchingCameraServiceClient::setZoom(const common::types::zoom zoom_level) {
+        camera::v1::BatchCommand command;
+        command.mutable_set_zoom()->set_zoom(zoom_level);
+        return batched<common::types::zoom>(
+            std::move(command), "SetZoom", [this, zoom_level] { return client_->setZoom(zoom_level); },
+            [zoom_level](const camera::v1::BatchResult& r) {
+                return r.set_zoom().has_zoom() ? r.set_zoom().zoom() : zoom_level;
+            });
+    }
+
+    common::async::Task<Result<common::types::zoom>> BatchingCameraServiceClient::setZoomAsync(
+        const common::state::CallContext call, const common::types::zoom zoom_level) {
+        camera::v1::BatchCommand command;
+        command.mutable_set_zoom()->set_zoom(zoom_level);
+        return batchedAsync<common::types::zoom>(
+            std::move(command), call, "SetZoom",
+            [this, zoom_level, call] { return client_->setZoomAsync(call, zoom_level); },
+            [zoom_level](const camera::v1::BatchResult& r) {
+                return r.set_zoom().has_zoom() ? r.set_zoom().zoom() : zoom_level;
+            });
+    }
+
+    Result<common::types::zoom> BatchingCameraServiceClient::getZoom() {
+        camera::v1::BatchCommand command;
+        command.mutable_get_zoom();
+        return batched<common::types::zoom>(
+            std::move(command), "GetZoom", [this] { return client_->getZoom(); },
+            [](const camera::v1::BatchResult& r) { return static_cast<common::types::zoom>(r.get_zoom().zoom()); });
+    }
+
+    Result<common::types::zoom> BatchingCameraServiceClient::goToMinZoom() {
+        camera::v1::BatchCommand command;
+        command.mutable_go_to_min_zoom();
+        return batched<common::types::zoom>(
+            std::move(command), "GoToMinZoom", [this] { return client_->goToMinZoom(); },
+            [](const camera::v1::BatchResult& r) {
+                return r.go_to_min_zoom().has_zoom() ? r.go_to_min_zoom().zoom() : common::types::MIN_NORMALIZED_ZOOM;
+            });
+    }
+
+    Result<common::types::zoom> BatchingCameraServiceClient::goToMaxZoom() {
+        camera::v1::BatchCommand command;
+        command.mutable_go_to_max_zoom();
+        return batched<common::types::zoom>(
+            std::move(command), "GoToMaxZoom", [this] { return client_->goToMaxZoom(); },
+            [](const camera::v1::BatchResult& r) {
+                return r.go_to_max_zoom().has_zoom() ? r.go_to_max_zoom().zoom() : common::types::MAX_NORMALIZED_ZOOM;
+            });
+    }
+
+    // Focus operations
+    Result<common::types::focus> BatchingCameraServiceClient::setFocus(const common::types::focus focus_value) {
+        camera::v1::BatchCommand command;
+        command.mutable_set_focus()->set_focus(focus_value);
+        return batched<common::types::focus>(
+            std::move(command), "SetFocus", [this, focus_value] { return client_->setFocus(focus_value); },
+            [focus_value](const camera::v1::BatchResult& r) {
+                return r.set_focus().has_focus() ? r.set_focus().focus() : focus_value;
+            });
+    }
+
+    common::async::Task<Result<common::types::focus>> BatchingCameraServiceClient::setFocusAsync(
+        const common::state::CallContext call, const common::types::focus focus_value) {
+        camera::v1::BatchCommand command;
+        command.mutable_set_focus()->set_focus(focus_value);
+        return batchedAsync<common::types::focus>(
+            std::move(command), call, "SetFocus",
+            [this, focus_value, call] { return client_->setFocusAsync(call, focus_value); },
+            [focus_value](const camera::v1::BatchResult& r) {
+                return r.set_focus().has_focus() ? r.set_focus().focus() : focus_value;
+            });
+    }
+
+    Result<common::types::focus> BatchingCameraServiceClient::getFocus() {
+        camera::v1::BatchCommand command;
+        command.mutable_get_focus();
+        return batched<common::types::focus>(
+            std::move(command), "GetFocus", [this] { return client_->getFocus(); },
+            [](const camera::v1::BatchResult& r) { return static_cast<common::types::focus>(r.get_focus().focus()); });
+    }
+
+    Result<void> BatchingCameraServiceClient::enableAutoFocus(const bool on) {
+        camera::v1::BatchCommand command;
+        command.mutable_set_auto_focus()->set_enable(on);
+        return batched<void>(std::move(command), "SetAutoFocus", [this, on] { return client_->enableAutoFocus(on); },
+                             NO_VALUE);
+    }
+
+    Result<bool> BatchingCameraServiceClient::getAutoFocus() {
+        camera::v1::BatchCommand command;
+        command.mutable_get_auto_focus();
+        return batched<bool>(std::move(command), "GetAutoFocus", [this] { return client_->getAutoFocus(); },
+                             [](const camera::v1::BatchResult& r) { return r.get_auto_focus().enable(); });
+    }
+
+    // Device info
+    Result<common::types::info> BatchingCameraServiceClient::getInfo() {
+        camera::v1::BatchCommand command;
+        command.mutable_get_info();
+        return batched<common::types::info>(std::move(command), "GetInfo", [this] { return client_->getInfo(); },
+                                            [](const camera::v1::BatchResult& r) { return r.get_info().info(); });
+    }
+
+    // Advanced operations
+    Result<void> BatchingCameraServiceClient::stabilize(const bool on) {
+        camera::v1::BatchCommand command;
+        command.mutable_set_stabilization()->set_enable(on);
+        return batched<void>(std::move(command), "SetStabilization", [this, on] { return client_->stabilize(on); },
+                             NO_VALUE);
+    }
+
+    Result<bool> BatchingCameraServiceClient::getStabilization() {
+        camera::v1::BatchCommand command;
+        command.mutable_get_stabilization();
+        return batched<bool>(std::move(command), "GetStabilization", [this] { return client_->getStabilization(); },
+                             [](const camera::v1::BatchResult& r) { return r.get_stabilization().enable(); });
+    }
+
+    // Capabilities
+    Result<common::capabilities::CapabilityList> BatchingCameraServiceClient::getCapabilities() {
+        camera::v1::BatchCommand command;
+        command.mutable_get_capabilities();
+        return batched<common::capabilities::CapabilityList>(
+            std::move(command), "GetCapabilities", [this] { return client_->getCapabilities(); },
+            [](const camera::v1::BatchResult& r) { return toCapabilityList(r.get_capabilities()); });
+    }
+} // namespace service::infrastructure
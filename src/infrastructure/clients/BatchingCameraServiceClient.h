@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "infrastructure/clients/HostBatcher.h"
+#include "infrastructure/clients/ICameraServiceClient.h"
+
+namespace service::infrastructure {
+    /**
+     * Decorates a camera_service client with host-aware batching
+     * Commands go through the HostBatcher of the instance's host and fall back to
+     * the wrapped client when they cannot be batched, both count as in flight for the host batching window
+     */
+    class BatchingCameraServiceClient : public ICameraServiceClient {
+    public:
+        BatchingCameraServiceClient(std::unique_ptr<ICameraServiceClient> client,
+                                    std::shared_ptr<HostBatcher> batcher, uint32_t port);
+        ~BatchingCameraServiceClient() override = default;
+
+        // Zoom operations
+        Result<common::types::zoom> setZoom(common::types::zoom zoom_level) override;
+        Result<common::types::zoom> getZoom() override;
+        Result<common::types::zoom> goToMinZoom() override;
+        Result<common::types::zoom> goToMaxZoom() override;
+
+        // Focus operations
+        Result<common::types::focus> setFocus(common::types::focus focus_value) override;
+        Result<common::types::focus> getFocus() override;
+        Result<void> enableAutoFocus(bool on) override;
+        Result<bool> getAutoFocus() override;
+
+        // Device info
+        Result<common::types::info> getInfo() override;
+
+        // Advanced operations
+        Result<void> stabilize(bool on) override;
+        Result<bool> getStabilization() override;
+
+        // Capabilities
+        Result<common::capabilities::CapabilityList> getCapabilities() override;
+
+        // Asynchronous operations, batched or sent individually without blocking
+        common::async::Task<Result<common::types::zoom>> setZoomAsync(common::state::CallContext call,
+                                                                      common::types::zoom zoom_level) override;
+        common::async::Task<Result<common::types::focus>> setFocusAsync(common::state::CallContext call,
+                                                                        common::types::focus focus_value) override;
+
+    private:
+        std::optional<camera::v1::BatchResult> submit(camera::v1::BatchCommand command) const;
+        common::async::Task<std::optional<camera::v1::BatchResult>> submitAsync(
+            camera::v1::BatchCommand command, common::state::CallContext call) const;
+
+        /**
+         * Send a command through the batcher, counted as in flight for the host batching window
+         * @param method camera_service method named in errors
+         * @param fallback makes the call on the wrapped client when the command cannot be batched
+         * @param convert takes the value out of the command's BatchResult
+         */
+        template<typename T, typename Fallback, typename Convert>
+        Result<T> batched(camera::v1::BatchCommand command, const std::string& method, Fallback fallback,
+                          Convert convert) const;
+
+        /**
+         * batched() on the asynchronous paths for call, fallback returns the task of the wrapped client
+         */
+        template<typename T, typename Fallback, typename Convert>
+        common::async::Task<Result<T>> batchedAsync(camera::v1::BatchCommand command, common::state::CallContext call,
+                                                    std::string method, Fallback fallback, Convert convert) const;
+
+        std::unique_ptr<ICameraServiceClient> client_;
+        std::shared_ptr<HostBatcher> batcher_;
+        uint32_t port_;
+    };
+} // namespace service::infrastructure
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <grpcpp/client_context.h>
+
+#include "common/state/CallContext.h"
+
+namespace service::infrastructure {
+    /**
+     * Bound a backend call by the deadline of the call it runs for, no-op if that call has none
+     */
+    inline void applyCallDeadline(grpc::ClientContext& context, const std::chrono::steady_clock::time_point deadline) {
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            return;
+        }
+        context.set_deadline(std::chrono::system_clock::now() +
+                             std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                 deadline - std::chrono::steady_clock::now()));
+    }
+
+    /**
+     * applyCallDeadline() for the context current on this thread, call it where a synchronous backend call is made
+     */
+    inline void applyCallDeadline(grpc::ClientContext& context) {
+        applyCallDeadline(context, common::state::CallContext::current().deadline);
+    }
+} // namespace service::infrastructure
@@ -0,0 +1,62 @@
+#include "infrastructure/clients/CameraPassthroughClient.h"
+
+#include <grpcpp/client_context.h>
+
+namespace service::infrastructure {
+    namespace {
+        constexpr auto CAMERA_SERVICE_PREFIX = "/camera.v1.CameraService/";
+
+        struct PendingCall {
+            grpc::ClientContext context;
+            infrastructure::RawCall call;
+            RoundTripObserver on_round_trip; // copied, the call may outlive the client
+            std::chrono::steady_clock::time_point sent;
+        };
+    } // unnamed namespace
+
+    CameraPassthroughClient::CameraPassthroughClient(std::shared_ptr<grpc::ChannelInterface> channel,
+                                                     std::shared_ptr<AdmissionLimiter> limiter,
+                                                     RoundTripObserver on_round_trip)
+        : stub_(std::make_shared<grpc::GenericStub>(std::move(channel))), limiter_(std::move(limiter)),
+          on_round_trip_(std::move(on_round_trip)) {
+    }
+
+    void CameraPassthroughClient::rebind(std::shared_ptr<grpc::ChannelInterface> channel) {
+        stub_.store(std::make_shared<grpc::GenericStub>(std::move(channel)), std::memory_order_release);
+    }
+
+    void CameraPassthroughClient::forward(infrastructure::RawCall call) {
+        if (!limiter_) {
+            send(std::move(call));
+            return;
+        }
+        const auto command = call.isCommand();
+        common::async::start(limiter_->acquireAsync(command),
+                             [this, call = std::move(call)](const Result<void>& admitted) mutable {
+                                 if (admitted.isError()) {
+                                     call.on_done(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                                                               admitted.error().message));
+                                     return;
+                                 }
+                                 send(std::move(call));
+                             });
+    }
+
+    void CameraPassthroughClient::send(infrastructure::RawCall call) const {
+        auto pending = std::make_unique<PendingCall>();
+        pending->call = std::move(call);
+        pending->context.set_deadline(pending->call.deadline);
+        pending->on_round_trip = on_round_trip_;
+        pending->sent = std::chrono::steady_clock::now();
+
+        const auto stub = stub_.load(std::memory_order_acquire);
+        auto* const in_flight = pending.release();
+        stub->UnaryCall(&in_flight->context, CAMERA_SERVICE_PREFIX + in_flight->call.method, grpc::StubOptions(),
+                        in_flight->call.request, in_flight->call.response,
+                        [in_flight](const grpc::Status& status) {
+                            const std::unique_ptr<PendingCall> completed(in_flight);
+                            reportRoundTrip(completed->on_round_trip, completed->sent);
+                            completed->call.on_done(status);
+                        });
+    }
+} // namespace service::infrastructure
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <grpcpp/channel.h>
+#include <grpcpp/generic/generic_stub.h>
+
+#include "infrastructure/clients/AdmissionLimiter.h"
+#include "infrastructure/clients/RawCall.h"
+#include "infrastructure/clients/RoundTrip.h"
+
+namespace service::infrastructure {
+    /**
+     * Forwards serialized camera_service calls through a generic stub
+     * Request and response bytes are relayed as is, no protobuf message is built. With a limiter each call takes a
+     * token of its class first, from the same buckets as the decoded calls to the instance
+     */
+    class CameraPassthroughClient {
+    public:
+        /**
+         * @param limiter admission of the instance, nullptr if its commands are unlimited
+         * @param on_round_trip told the round trip of every forwarded call, the admission wait excluded
+         */
+        explicit CameraPassthroughClient(std::shared_ptr<grpc::ChannelInterface> channel,
+                                         std::shared_ptr<AdmissionLimiter> limiter = nullptr,
+                                         RoundTripObserver on_round_trip = {});
+
+        /**
+         * Start the call asynchronously, call.on_done runs on a gRPC thread once it completes
+         * Past the limit the call waits for its admission token on the limiter's timer, a rejection completes it
+         * at once
+         * @param call serialized camera_service call, buffers must stay valid until on_done
+         */
+        void forward(infrastructure::RawCall call);
+
+        /**
+         * Forward later calls over another channel, calls already started finish on the old one
+         */
+        void rebind(std::shared_ptr<grpc::ChannelInterface> channel);
+
+    private:
+        /**
+         * Send an admitted call
+         */
+        void send(infrastructure::RawCall call) const;
+
+        std::atomic<std::shared_ptr<grpc::GenericStub>> stub_; // replaced by rebind()
+        std::shared_ptr<AdmissionLimiter> limiter_;
+        RoundTripObserver on_round_trip_;
+    };
+} // namespace service::infrastructure
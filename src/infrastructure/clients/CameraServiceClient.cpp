@@ -2,33 +2,99 @@
 
 #include <google/protobuf/empty.pb.h>
 #include "common/logger/Logger.h"
+#include "common/memory/ReusableArena.h"
+#include "infrastructure/clients/CallDeadline.h"
+#include "infrastructure/clients/GrpcUnaryCall.h"
 
 namespace service::infrastructure {
-    CameraServiceClient::CameraServiceClient(std::shared_ptr<grpc::ChannelInterface> channel)
-        : stub_(camera::v1::CameraService::NewStub(channel)) {
-        if (!stub_) {
+    common::capabilities::CapabilityList toCapabilityList(const camera::v1::GetCapabilitiesResponse& response) {
+        common::capabilities::CapabilityList capabilities;
+        for (const auto& proto_cap : response.capabilities()) {
+            switch (proto_cap) {
+                case camera::v1::CAPABILITY_ZOOM:
+                    capabilities.push_back(common::capabilities::Capability::Zoom);
+                    break;
+                case camera::v1::CAPABILITY_FOCUS:
+                    capabilities.push_back(common::capabilities::Capability::Focus);
+                    break;
+                case camera::v1::CAPABILITY_AUTO_FOCUS:
+                    capabilities.push_back(common::capabilities::Capability::AutoFocus);
+                    break;
+                case camera::v1::CAPABILITY_INFO:
+                    capabilities.push_back(common::capabilities::Capability::Info);
+                    break;
+                case camera::v1::CAPABILITY_STABILIZATION:
+                    capabilities.push_back(common::capabilities::Capability::Stabilization);
+                    break;
+                default:
+                    LOG_WARN("Unknown camera capability: {}", proto_cap);
+                    break;
+            }
+        }
+        return capabilities;
+    }
+
+    CameraServiceClient::CameraServiceClient(std::shared_ptr<grpc::ChannelInterface> channel,
+                                             RoundTripObserver on_round_trip)
+        : on_round_trip_(std::move(on_round_trip)) {
+        rebind(std::move(channel));
+    }
+
+    void CameraServiceClient::rebind(std::shared_ptr<grpc::ChannelInterface> channel) {
+        std::shared_ptr<camera::v1::CameraService::Stub> stub = camera::v1::CameraService::NewStub(channel);
+        if (!stub) {
             throw std::runtime_error("Failed to create camera_service stub");
         }
+        stub_.store(std::move(stub), std::memory_order_release);
     }
 
     // Zoom operations
-    Result<void> CameraServiceClient::setZoom(common::types::zoom zoom_level) {
+    Result<common::types::zoom> CameraServiceClient::setZoom(common::types::zoom zoom_level) {
+        camera::v1::SetZoomRequest request;
+        request.set_zoom(zoom_level);
+
+        camera::v1::SetZoomResponse response;
+        grpc::ClientContext context;
+        applyCallDeadline(context);
+
+        const auto status = timed([&] { return stub()->SetZoom(&context, request, &response); });
+        if (!status.ok()) {
+            return Result<common::types::zoom>::error(
+                std::string("camera_service.SetZoom: ") + status.error_message()
+            );
+        }
+        return Result<common::types::zoom>::success(response.has_zoom() ? response.zoom() : zoom_level);
+    }
+
+    common::async::Task<Result<common::types::zoom>> CameraServiceClient::setZoomAsync(
+        const common::state::CallContext call, const common::types::zoom zoom_level) {
         camera::v1::SetZoomRequest request;
         request.set_zoom(zoom_level);
 
         camera::v1::SetZoomResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context, call.deadline);
 
-        const auto status = stub_->SetZoom(&context, request, &response);
-        return handleGrpcVoidError(status, "SetZoom");
+        GrpcUnaryCall unary;
+        const auto sent = std::chrono::steady_clock::now();
+        stub()->async()->SetZoom(&context, &request, &response, unary.done());
+        const auto status = co_await unary;
+        reportRoundTrip(on_round_trip_, sent);
+        if (!status.ok()) {
+            co_return Result<common::types::zoom>::error(
+                std::string("camera_service.SetZoom: ") + status.error_message()
+            );
+        }
+        co_return Result<common::types::zoom>::success(response.has_zoom() ? response.zoom() : zoom_level);
     }
 
     Result<common::types::zoom> CameraServiceClient::getZoom() {
         google::protobuf::Empty request;
         camera::v1::GetZoomResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GetZoom(&context, request, &response);
+        const auto status = timed([&] { return stub()->GetZoom(&context, request, &response); });
         if (!status.ok()) {
             return Result<common::types::zoom>::error(
                 std::string("camera_service.GetZoom: ") + status.error_message()
@@ -37,42 +103,85 @@ namespace service::infrastructure {
         return Result<common::types::zoom>::success(static_cast<common::types::zoom>(response.zoom()));
     }
 
-    Result<void> CameraServiceClient::goToMinZoom() {
+    Result<common::types::zoom> CameraServiceClient::goToMinZoom() {
         google::protobuf::Empty request;
         camera::v1::GoToMinZoomResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GoToMinZoom(&context, request, &response);
-        return handleGrpcVoidError(status, "GoToMinZoom");
+        const auto status = timed([&] { return stub()->GoToMinZoom(&context, request, &response); });
+        if (!status.ok()) {
+            return Result<common::types::zoom>::error(
+                std::string("camera_service.GoToMinZoom: ") + status.error_message()
+            );
+        }
+        return Result<common::types::zoom>::success(
+            response.has_zoom() ? response.zoom() : common::types::MIN_NORMALIZED_ZOOM);
     }
 
-    Result<void> CameraServiceClient::goToMaxZoom() {
+    Result<common::types::zoom> CameraServiceClient::goToMaxZoom() {
         google::protobuf::Empty request;
         camera::v1::GoToMaxZoomResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GoToMaxZoom(&context, request, &response);
-        return handleGrpcVoidError(status, "GoToMaxZoom");
+        const auto status = timed([&] { return stub()->GoToMaxZoom(&context, request, &response); });
+        if (!status.ok()) {
+            return Result<common::types::zoom>::error(
+                std::string("camera_service.GoToMaxZoom: ") + status.error_message()
+            );
+        }
+        return Result<common::types::zoom>::success(
+            response.has_zoom() ? response.zoom() : common::types::MAX_NORMALIZED_ZOOM);
     }
 
     // Focus operations
-    Result<void> CameraServiceClient::setFocus(common::types::focus focus_value) {
+    Result<common::types::focus> CameraServiceClient::setFocus(common::types::focus focus_value) {
+        camera::v1::SetFocusRequest request;
+        request.set_focus(focus_value);
+
+        camera::v1::SetFocusResponse response;
+        grpc::ClientContext context;
+        applyCallDeadline(context);
+
+        const auto status = timed([&] { return stub()->SetFocus(&context, request, &response); });
+        if (!status.ok()) {
+            return Result<common::types::focus>::error(
+                std::string("camera_service.SetFocus: ") + status.error_message()
+            );
+        }
+        return Result<common::types::focus>::success(response.has_focus() ? response.focus() : focus_value);
+    }
+
+    common::async::Task<Result<common::types::focus>> CameraServiceClient::setFocusAsync(
+        const common::state::CallContext call, const common::types::focus focus_value) {
         camera::v1::SetFocusRequest request;
         request.set_focus(focus_value);
 
         camera::v1::SetFocusResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context, call.deadline);
 
-        const auto status = stub_->SetFocus(&context, request, &response);
-        return handleGrpcVoidError(status, "SetFocus");
+        GrpcUnaryCall unary;
+        const auto sent = std::chrono::steady_clock::now();
+        stub()->async()->SetFocus(&context, &request, &response, unary.done());
+        const auto status = co_await unary;
+        reportRoundTrip(on_round_trip_, sent);
+        if (!status.ok()) {
+            co_return Result<common::types::focus>::error(
+                std::string("camera_service.SetFocus: ") + status.error_message()
+            );
+        }
+        co_return Result<common::types::focus>::success(response.has_focus() ? response.focus() : focus_value);
     }
 
     Result<common::types::focus> CameraServiceClient::getFocus() {
         google::protobuf::Empty request;
         camera::v1::GetFocusResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GetFocus(&context, request, &response);
+        const auto status = timed([&] { return stub()->GetFocus(&context, request, &response); });
         if (!status.ok()) {
             return Result<common::types::focus>::error(
                 std::string("camera_service.GetFocus: ") + status.error_message()
@@ -87,8 +196,9 @@ namespace service::infrastructure {
 
         google::protobuf::Empty response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->SetAutoFocus(&context, request, &response);
+        const auto status = timed([&] { return stub()->SetAutoFocus(&context, request, &response); });
         return handleGrpcVoidError(status, "SetAutoFocus");
     }
 
@@ -96,8 +206,9 @@ namespace service::infrastructure {
         google::protobuf::Empty request;
         camera::v1::GetAutoFocusResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GetAutoFocus(&context, request, &response);
+        const auto status = timed([&] { return stub()->GetAutoFocus(&context, request, &response); });
         if (!status.ok()) {
             return Result<bool>::error(
                 std::string("camera_service.GetAutoFocus: ") + status.error_message()
@@ -110,16 +221,17 @@ namespace service::infrastructure {
     // Device info
     Result<common::types::info> CameraServiceClient::getInfo() {
         google::protobuf::Empty request;
-        camera::v1::GetInfoResponse response;
+        auto* const response = common::memory::threadLocalArena().create<camera::v1::GetInfoResponse>();
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GetInfo(&context, request, &response);
+        const auto status = timed([&] { return stub()->GetInfo(&context, request, response); });
         if (!status.ok()) {
             return Result<common::types::info>::error(
                 std::string("camera_service.GetInfo: ") + status.error_message()
             );
         }
-        return Result<common::types::info>::success(response.info());
+        return Result<common::types::info>::success(response->info());
     }
 
     // Advanced operations
@@ -129,8 +241,9 @@ namespace service::infrastructure {
 
         google::protobuf::Empty response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->SetStabilization(&context, request, &response);
+        const auto status = timed([&] { return stub()->SetStabilization(&context, request, &response); });
         return handleGrpcVoidError(status, "SetStabilization");
     }
 
@@ -138,8 +251,9 @@ namespace service::infrastructure {
         google::protobuf::Empty request;
         camera::v1::GetStabilizationResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GetStabilization(&context, request, &response);
+        const auto status = timed([&] { return stub()->GetStabilization(&context, request, &response); });
         if (!status.ok()) {
             return Result<bool>::error(
                 std::string("camera_service.GetStabilization: ") + status.error_message()
@@ -152,40 +266,17 @@ namespace service::infrastructure {
     // Capabilities
     Result<common::capabilities::CapabilityList> CameraServiceClient::getCapabilities() {
         google::protobuf::Empty request;
-        camera::v1::GetCapabilitiesResponse response;
+        auto* const response = common::memory::threadLocalArena().create<camera::v1::GetCapabilitiesResponse>();
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GetCapabilities(&context, request, &response);
+        const auto status = timed([&] { return stub()->GetCapabilities(&context, request, response); });
         if (!status.ok()) {
             return Result<common::capabilities::CapabilityList>::error(
                 std::string("camera_service.GetCapabilities: ") + status.error_message()
             );
         }
 
-        // Convert protobuf capabilities to domain capabilities
-        common::capabilities::CapabilityList capabilities;
-        for (const auto& proto_cap : response.capabilities()) {
-            switch (proto_cap) {
-                case camera::v1::CAPABILITY_ZOOM:
-                    capabilities.push_back(common::capabilities::Capability::Zoom);
-                    break;
-                case camera::v1::CAPABILITY_FOCUS:
-                    capabilities.push_back(common::capabilities::Capability::Focus);
-                    break;
-                case camera::v1::CAPABILITY_AUTO_FOCUS:
-                    capabilities.push_back(common::capabilities::Capability::AutoFocus);
-                    break;
-                case camera::v1::CAPABILITY_INFO:
-                    capabilities.push_back(common::capabilities::Capability::Info);
-                    break;
-                case camera::v1::CAPABILITY_STABILIZATION:
-                    capabilities.push_back(common::capabilities::Capability::Stabilization);
-                    break;
-                default:
-                    LOG_WARN("Unknown camera capability: {}", proto_cap);
-                    break;
-            }
-        }
-        return Result<common::capabilities::CapabilityList>::success(capabilities);
+        return Result<common::capabilities::CapabilityList>::success(toCapabilityList(*response));
     }
 } // namespace service::infrastructure
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <grpcpp/client_context.h>
 #include <grpcpp/channel.h>
@@ -7,21 +8,37 @@
 #include "api/proto/camera_service.grpc.pb.h"
 #include "common/types/CameraCapabilities.h"
 #include "infrastructure/clients/ICameraServiceClient.h"
+#include "infrastructure/clients/RoundTrip.h"
 
 namespace service::infrastructure {
+    /**
+     * Convert camera_service capabilities to domain capabilities
+     * Unknown capabilities are logged and skipped
+     */
+    common::capabilities::CapabilityList toCapabilityList(const camera::v1::GetCapabilitiesResponse& response);
+
     class CameraServiceClient : public ICameraServiceClient {
     public:
-        explicit CameraServiceClient(std::shared_ptr<grpc::ChannelInterface> channel);
+        /**
+         * @param on_round_trip told the round trip of every stub call, unset if nobody measures the backend
+         */
+        explicit CameraServiceClient(std::shared_ptr<grpc::ChannelInterface> channel,
+                                     RoundTripObserver on_round_trip = {});
         ~CameraServiceClient() override = default;
 
+        /**
+         * Send later calls over another channel, calls already started finish on the old one
+         */
+        void rebind(std::shared_ptr<grpc::ChannelInterface> channel);
+
         // Zoom operations
-        Result<void> setZoom(common::types::zoom zoom_level) override;
+        Result<common::types::zoom> setZoom(common::types::zoom zoom_level) override;
         Result<common::types::zoom> getZoom() override;
-        Result<void> goToMinZoom() override;
-        Result<void> goToMaxZoom() override;
+        Result<common::types::zoom> goToMinZoom() override;
+        Result<common::types::zoom> goToMaxZoom() override;
 
         // Focus operations
-        Result<void> setFocus(common::types::focus focus_value) override;
+        Result<common::types::focus> setFocus(common::types::focus focus_value) override;
         Result<common::types::focus> getFocus() override;
         Result<void> enableAutoFocus(bool on) override;
         Result<bool> getAutoFocus() override;
@@ -36,8 +53,30 @@ namespace service::infrastructure {
         // Capabilities
         Result<common::capabilities::CapabilityList> getCapabilities() override;
 
+        // Asynchronous operations on the callback stub
+        common::async::Task<Result<common::types::zoom>> setZoomAsync(common::state::CallContext call,
+                                                                      common::types::zoom zoom_level) override;
+        common::async::Task<Result<common::types::focus>> setFocusAsync(common::state::CallContext call,
+                                                                        common::types::focus focus_value) override;
+
     private:
-        std::unique_ptr<camera::v1::CameraService::Stub> stub_;
+        std::atomic<std::shared_ptr<camera::v1::CameraService::Stub>> stub_; // replaced by rebind()
+
+        std::shared_ptr<camera::v1::CameraService::Stub> stub() const {
+            return stub_.load(std::memory_order_acquire);
+        }
+        RoundTripObserver on_round_trip_;
+
+        /**
+         * Make one blocking stub call and report its round trip
+         */
+        template<typename Call>
+        grpc::Status timed(const Call& call) {
+            const auto sent = std::chrono::steady_clock::now();
+            auto status = call();
+            reportRoundTrip(on_round_trip_, sent);
+            return status;
+        }
 
         /**
          * Helper to handle gRPC call results
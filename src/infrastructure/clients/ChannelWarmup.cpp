@@ -0,0 +1,109 @@
+#include "infrastructure/clients/ChannelWarmup.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/logger/Logger.h"
+
+namespace service::infrastructure {
+    namespace {
+        // Upper bound on a single wait so cancellation is noticed promptly
+        constexpr auto STATE_WAIT_SLICE = std::chrono::milliseconds(50);
+
+        int64_t elapsedMs(const std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+    } // unnamed namespace
+
+    ChannelWarmup::ChannelWarmup(std::vector<Target> targets, const std::chrono::milliseconds budget)
+        : targets_(std::move(targets)),
+          start_(std::chrono::steady_clock::now()),
+          deadline_(start_ + budget) {
+        LOG_DEBUG("Warming up {} backend channel(s) within {} ms", targets_.size(), budget.count());
+
+        workers_.reserve(targets_.size());
+        for (const auto& target : targets_) {
+            workers_.emplace_back([this, &target](const std::stop_token& stop_token) {
+                connect(target, stop_token);
+            });
+        }
+    }
+
+    ChannelWarmup::~ChannelWarmup() {
+        cancel();
+    }
+
+    bool ChannelWarmup::waitForReady(const double fraction) {
+        const auto required = static_cast<std::size_t>(
+            std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(targets_.size())));
+
+        std::unique_lock lock(mutex_);
+        progress_cv_.wait(lock, [this, required] {
+            return ready_ >= required || finished_ == targets_.size();
+        });
+        return ready_ >= required;
+    }
+
+    void ChannelWarmup::cancel() {
+        for (auto& worker : workers_) {
+            worker.request_stop();
+        }
+        workers_.clear();
+    }
+
+    std::size_t ChannelWarmup::readyCount() const {
+        std::lock_guard lock(mutex_);
+        return ready_;
+    }
+
+    std::size_t ChannelWarmup::totalCount() const {
+        return targets_.size();
+    }
+
+    bool ChannelWarmup::isComplete() const {
+        std::lock_guard lock(mutex_);
+        return finished_ == targets_.size();
+    }
+
+    void ChannelWarmup::connect(const Target& target, const std::stop_token& stop_token) {
+        const auto deadline = std::chrono::system_clock::now() +
+                              std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                  deadline_ - std::chrono::steady_clock::now());
+
+        auto state = target.channel->GetState(true);
+        while (state != GRPC_CHANNEL_READY && !stop_token.stop_requested()) {
+            const auto now = std::chrono::system_clock::now();
+            if (now >= deadline) {
+                break;
+            }
+            if (target.channel->WaitForStateChange(state, std::min(deadline, now + STATE_WAIT_SLICE))) {
+                state = target.channel->GetState(true);
+            }
+        }
+
+        const bool connected = state == GRPC_CHANNEL_READY;
+        if (connected) {
+            LOG_DEBUG("{} instance {} connected in {} ms", target.service_name, target.instance_id, elapsedMs(start_));
+        } else if (!stop_token.stop_requested()) {
+            LOG_WARN("{} instance {} not ready after {} ms warm-up", target.service_name, target.instance_id,
+                     elapsedMs(start_));
+        }
+        onFinished(connected);
+    }
+
+    void ChannelWarmup::onFinished(const bool connected) {
+        {
+            std::lock_guard lock(mutex_);
+            ++finished_;
+            if (connected) {
+                ++ready_;
+            }
+            if (finished_ == targets_.size()) {
+                LOG_INFO("Backend warm-up finished: {}/{} channel(s) ready in {} ms", ready_, targets_.size(),
+                         elapsedMs(start_));
+            }
+        }
+        progress_cv_.notify_all();
+    }
+} // namespace service::infrastructure
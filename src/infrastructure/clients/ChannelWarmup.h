@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <grpcpp/channel.h>
+
+namespace service::infrastructure {
+    /**
+     * Connects a set of backend channels in parallel under one global deadline
+     * Each channel is driven to READY on its own thread so DNS resolution and
+     * TCP/HTTP2 setup overlap instead of being paid by the first request
+     */
+    class ChannelWarmup {
+    public:
+        struct Target {
+            std::string service_name;
+            uint32_t instance_id;
+            std::shared_ptr<grpc::Channel> channel;
+        };
+
+        /**
+         * Start connecting all targets
+         * @param targets channels to warm up
+         * @param budget deadline for all channels, counted from construction
+         */
+        ChannelWarmup(std::vector<Target> targets, std::chrono::milliseconds budget);
+        ~ChannelWarmup();
+
+        ChannelWarmup(const ChannelWarmup&) = delete;
+        ChannelWarmup& operator=(const ChannelWarmup&) = delete;
+
+        /**
+         * Block until the given fraction of channels is ready or the budget is spent
+         * @param fraction required fraction of ready channels [0, 1]
+         * @return true if the fraction was reached
+         */
+        bool waitForReady(double fraction);
+
+        /**
+         * Stop connecting and wait for the warm-up threads to exit
+         */
+        void cancel();
+
+        std::size_t readyCount() const;
+        std::size_t totalCount() const;
+
+        /**
+         * @return true once every channel either connected or ran out of budget
+         */
+        bool isComplete() const;
+
+    private:
+        void connect(const Target& target, const std::stop_token& stop_token);
+        void onFinished(bool connected);
+
+        std::vector<Target> targets_;
+        std::chrono::steady_clock::time_point start_;
+        std::chrono::steady_clock::time_point deadline_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable progress_cv_;
+        std::size_t ready_{0};
+        std::size_t finished_{0};
+
+        std::vector<std::jthread> workers_;
+    };
+} // namespace service::infrastructure
@@ -1,16 +1,39 @@
 #include "infrastructure/clients/GrpcClientManager.h"
 
+#include "infrastructure/clients/BatchingCameraServiceClient.h"
 #include "infrastructure/clients/CameraServiceClient.h"
+#include "infrastructure/clients/HostBatcher.h"
 #include "infrastructure/clients/VideoServiceClient.h"
 #include "infrastructure/clients/InstanceRouter.h"
+#include "infrastructure/clients/RateLimitedCameraServiceClient.h"
+#include "infrastructure/clients/RateLimitedVideoServiceClient.h"
 #include "common/logger/Logger.h"
 
 namespace service::infrastructure {
-    GrpcClientManager::GrpcClientManager(const common::InfrastructureConfig& config)
-        : config_(config) {
+    namespace {
+        std::string hostOf(const std::string& address) {
+            return address.substr(0, address.rfind(':'));
+        }
+
+        uint32_t portOf(const std::string& address) {
+            return static_cast<uint32_t>(std::stoul(address.substr(address.rfind(':') + 1)));
+        }
+    } // unnamed namespace
+
+    GrpcClientManager::GrpcClientManager(const common::InfrastructureConfig& config,
+                                         InstanceRoundTripObserver on_round_trip,
+                                         AdmissionLimiter::Timer admission_timer)
+        : config_(config), on_round_trip_(std::move(on_round_trip)), admission_timer_(std::move(admission_timer)) {
+        // The resolver outlives re-initialization, its cache keeps serving the last known good addresses
+        if (config_.resolver.enabled) {
+            resolver_ = std::make_unique<AddressResolver>(
+                config_.resolver.ttl, AddressResolver::ResolveFunction{},
+                [this](const std::string& host) { rebuildChannels(host); });
+        }
     }
 
     GrpcClientManager::~GrpcClientManager() {
+        resolver_.reset();
         shutdown();
     }
 
@@ -18,25 +41,43 @@ namespace service::infrastructure {
         LOG_DEBUG("Initializing gRPC clients from configuration");
 
         try {
-            // Initialize camera_service if configured
-            initializeService<ICameraServiceClient>(
-                "camera_service",
-                camera_channels_,
-                camera_clients_,
-                [](std::shared_ptr<grpc::ChannelInterface> ch) {
-                    return std::make_unique<CameraServiceClient>(ch);
-                }
-            );
-
-            // Initialize video_service if configured
-            initializeService<IVideoServiceClient>(
-                "video_service",
-                video_channels_,
-                video_clients_,
-                [](std::shared_ptr<grpc::ChannelInterface> ch) {
-                    return std::make_unique<VideoServiceClient>(ch);
+            {
+                std::lock_guard lock(channels_mutex_);
+
+                // Initialize camera_service if configured
+                initializeService<ICameraServiceClient>(
+                    "camera_service",
+                    camera_channels_,
+                    camera_clients_,
+                    [this](const uint32_t instance_id, std::shared_ptr<grpc::ChannelInterface> ch) {
+                        auto client = std::make_unique<CameraServiceClient>(ch, roundTripOf(instance_id));
+                        camera_service_clients_[instance_id] = client.get();
+                        return client;
+                    }
+                );
+                initializeCameraBatching();
+
+                // Generic stubs for passthrough share the camera channels
+                for (const auto& [instance_id, channel] : camera_channels_) {
+                    camera_passthrough_clients_[instance_id] =
+                        std::make_unique<CameraPassthroughClient>(channel, nullptr, roundTripOf(instance_id));
                 }
-            );
+
+                // Initialize video_service if configured
+                initializeService<IVideoServiceClient>(
+                    "video_service",
+                    video_channels_,
+                    video_clients_,
+                    [this](const uint32_t instance_id, std::shared_ptr<grpc::ChannelInterface> ch) {
+                        auto client = std::make_unique<VideoServiceClient>(ch);
+                        video_service_clients_[instance_id] = client.get();
+                        return client;
+                    }
+                );
+                initializeAdmission();
+            }
+
+            warmUpChannels();
         } catch (const std::exception& e) {
             LOG_ERROR("Failed to initialize gRPC clients: {}", e.what());
             // Clean up any partially initialized instances
@@ -48,6 +89,13 @@ namespace service::infrastructure {
     void GrpcClientManager::shutdown() {
         LOG_DEBUG("Shutting down gRPC clients");
 
+        warmup_.reset();
+
+        std::lock_guard lock(channels_mutex_);
+        host_batchers_.clear();
+        camera_service_clients_.clear();
+        video_service_clients_.clear();
+        camera_passthrough_clients_.clear();
         shutdownService<ICameraServiceClient>("camera_service", camera_channels_, camera_clients_);
         shutdownService<IVideoServiceClient>("video_service", video_channels_, video_clients_);
     }
@@ -60,6 +108,15 @@ namespace service::infrastructure {
         return InstanceRouter<ICameraServiceClient>::getClient("camera_service", instance_id, camera_clients_);
     }
 
+    CameraPassthroughClient* GrpcClientManager::getCameraPassthroughClient(uint32_t instance_id) const {
+        if (!InstanceRouter<CameraPassthroughClient>::isConfigured(camera_passthrough_clients_)) {
+            throw std::invalid_argument("camera_service not configured");
+        }
+
+        return InstanceRouter<CameraPassthroughClient>::getClient(
+            "camera_service", instance_id, camera_passthrough_clients_);
+    }
+
     IVideoServiceClient* GrpcClientManager::getVideoServiceClient(uint32_t instance_id) const {
         if (!InstanceRouter<IVideoServiceClient>::isConfigured(video_clients_)) {
             throw std::invalid_argument("video_service not configured");
@@ -68,12 +125,28 @@ namespace service::infrastructure {
         return InstanceRouter<IVideoServiceClient>::getClient("video_service", instance_id, video_clients_);
     }
 
+    void GrpcClientManager::connectInstance(const uint32_t instance_id) const {
+        std::lock_guard lock(channels_mutex_);
+        for (const auto* const channels : {&camera_channels_, &video_channels_}) {
+            if (const auto it = channels->find(instance_id); it != channels->end() && it->second) {
+                it->second->GetState(true);
+            }
+        }
+    }
+
+    bool GrpcClientManager::isCameraConnected(const uint32_t instance_id) const {
+        std::lock_guard lock(channels_mutex_);
+        const auto it = camera_channels_.find(instance_id);
+        return it != camera_channels_.end() && it->second && it->second->GetState(true) == GRPC_CHANNEL_READY;
+    }
+
     template<typename ClientType>
     void GrpcClientManager::initializeService(
         const std::string& service_name,
         std::unordered_map<uint32_t, std::shared_ptr<grpc::Channel>>& channels,
         std::unordered_map<uint32_t, std::unique_ptr<ClientType>>& clients,
-        std::function<std::unique_ptr<ClientType>(std::shared_ptr<grpc::ChannelInterface>)> client_factory) {
+        std::function<std::unique_ptr<ClientType>(uint32_t, std::shared_ptr<grpc::ChannelInterface>)>
+            client_factory) {
 
         if (config_.clients.count(service_name) == 0) {
             LOG_WARN("{} not found in configuration (optional)", service_name);
@@ -92,17 +165,188 @@ namespace service::infrastructure {
         for (const auto& instance : service_config.instances) {
             LOG_DEBUG("Creating {} client for instance {} at {}", service_name, instance.id, instance.address);
 
-            auto channel = createChannel(instance.address);
+            auto channel = createChannel(channelTarget(instance));
             std::shared_ptr<grpc::ChannelInterface> channel_interface =
                 std::static_pointer_cast<grpc::ChannelInterface>(channel);
 
             channels[instance.id] = channel;
-            clients[instance.id] = client_factory(channel_interface);
+            clients[instance.id] = client_factory(instance.id, channel_interface);
 
             LOG_DEBUG("{} instance {} initialized successfully", service_name, instance.id);
         }
     }
 
+    void GrpcClientManager::warmUpChannels() {
+        const auto& warmup_config = config_.warmup;
+        if (!warmup_config.enabled) {
+            return;
+        }
+
+        std::vector<ChannelWarmup::Target> targets;
+        {
+            std::lock_guard lock(channels_mutex_);
+            targets.reserve(camera_channels_.size() + video_channels_.size());
+            for (const auto& [instance_id, channel] : camera_channels_) {
+                targets.push_back({"camera_service", instance_id, channel});
+            }
+            for (const auto& [instance_id, channel] : video_channels_) {
+                targets.push_back({"video_service", instance_id, channel});
+            }
+        }
+
+        warmup_ = std::make_unique<ChannelWarmup>(std::move(targets), warmup_config.budget);
+
+        if (warmup_config.min_ready_fraction > 0.0 && !warmup_->waitForReady(warmup_config.min_ready_fraction)) {
+            LOG_WARN("Only {}/{} backend channel(s) ready after {} ms warm-up, continuing degraded",
+                     warmup_->readyCount(), warmup_->totalCount(), warmup_config.budget.count());
+        }
+    }
+
+    common::types::WarmupMetrics GrpcClientManager::warmupState() const {
+        if (!warmup_) {
+            return {};
+        }
+        return {.enabled = true,
+                .ready = warmup_->readyCount(),
+                .total = warmup_->totalCount(),
+                .complete = warmup_->isComplete()};
+    }
+
+    void GrpcClientManager::initializeCameraBatching() {
+        const auto service_it = config_.clients.find("camera_service");
+        if (service_it == config_.clients.end() || !service_it->second.batching.enabled) {
+            return;
+        }
+
+        std::unordered_map<std::string, std::vector<const common::ServiceInstance*>> instances_by_host;
+        for (const auto& instance : service_it->second.instances) {
+            instances_by_host[hostOf(instance.address)].push_back(&instance);
+        }
+
+        for (const auto& [host, instances] : instances_by_host) {
+            if (instances.size() < 2) {
+                LOG_DEBUG("camera_service host {} serves a single instance, batching skipped", host);
+                continue;
+            }
+
+            LOG_DEBUG("Batching camera_service commands to {} instance(s) on {} within {} us",
+                      instances.size(), host, service_it->second.batching.window.count());
+
+            // Each batched command reports the round trip of its batch to the instance it was addressed to
+            std::function<void(uint32_t, std::chrono::microseconds)> on_round_trip;
+            if (on_round_trip_) {
+                std::unordered_map<uint32_t, uint32_t> instance_by_port;
+                for (const auto* instance : instances) {
+                    instance_by_port.emplace(portOf(instance->address), instance->id);
+                }
+                on_round_trip = [observer = on_round_trip_, instance_by_port = std::move(instance_by_port)](
+                                    const uint32_t port, const std::chrono::microseconds round_trip) {
+                    if (const auto it = instance_by_port.find(port); it != instance_by_port.end()) {
+                        observer(it->second, round_trip);
+                    }
+                };
+            }
+            const auto batcher = std::make_shared<HostBatcher>(
+                host, camera_channels_.at(instances.front()->id), service_it->second.batching,
+                std::move(on_round_trip));
+            host_batchers_[host] = {instances.front()->id, batcher};
+            for (const auto* instance : instances) {
+                auto& client = camera_clients_.at(instance->id);
+                client = std::make_unique<BatchingCameraServiceClient>(
+                    std::move(client), batcher, portOf(instance->address));
+            }
+        }
+    }
+
+    void GrpcClientManager::initializeAdmission() {
+        const auto limited = [this](const std::string& service_name) -> const common::AdmissionConfig* {
+            const auto it = config_.clients.find(service_name);
+            if (it == config_.clients.end()) {
+                return nullptr;
+            }
+            const auto& admission = it->second.admission;
+            return admission.set.rate_hz > 0 || admission.get.rate_hz > 0 ? &admission : nullptr;
+        };
+        const auto limiter = [this](const std::string& service_name, const uint32_t instance_id,
+                                    const common::AdmissionConfig& admission) {
+            return std::make_unique<AdmissionLimiter>(service_name + " instance " + std::to_string(instance_id),
+                                                      admission, admission_timer_);
+        };
+
+        if (const auto* admission = limited("camera_service")) {
+            LOG_DEBUG("Limiting camera_service commands to {} sets/s and {} gets/s per instance",
+                      admission->set.rate_hz, admission->get.rate_hz);
+            // Passthrough calls to an instance take their tokens from the same limiter as its decoded calls
+            for (auto& [instance_id, client] : camera_clients_) {
+                std::shared_ptr<AdmissionLimiter> instance_limiter =
+                    limiter("camera_service", instance_id, *admission);
+                client = std::make_unique<RateLimitedCameraServiceClient>(std::move(client), instance_limiter);
+                if (camera_passthrough_clients_.contains(instance_id)) {
+                    camera_passthrough_clients_[instance_id] = std::make_unique<CameraPassthroughClient>(
+                        camera_channels_.at(instance_id), std::move(instance_limiter), roundTripOf(instance_id));
+                }
+            }
+        }
+
+        if (const auto* admission = limited("video_service")) {
+            LOG_DEBUG("Limiting video_service commands to {} sets/s and {} gets/s per instance",
+                      admission->set.rate_hz, admission->get.rate_hz);
+            for (auto& [instance_id, client] : video_clients_) {
+                client = std::make_unique<RateLimitedVideoServiceClient>(
+                    std::move(client), limiter("video_service", instance_id, *admission));
+            }
+        }
+    }
+
+    void GrpcClientManager::rebuildChannels(const std::string& host) {
+        std::lock_guard lock(channels_mutex_);
+        for (const auto* const service_name : {"camera_service", "video_service"}) {
+            const auto service_it = config_.clients.find(service_name);
+            if (service_it == config_.clients.end()) {
+                continue;
+            }
+
+            const bool camera = service_it->first == "camera_service";
+            auto& channels = camera ? camera_channels_ : video_channels_;
+            for (const auto& instance : service_it->second.instances) {
+                if (!instance.pinned_ip.empty() || hostOf(instance.address) != host ||
+                    !channels.contains(instance.id)) {
+                    continue;
+                }
+
+                try {
+                    const auto target = channelTarget(instance);
+                    LOG_INFO("Rebuilding {} channel {} to {}", service_name, instance.id, target);
+                    auto channel = createChannel(target);
+                    channels[instance.id] = channel;
+
+                    // Calls already started finish on the old channel, it closes once the last of them is done
+                    if (!camera) {
+                        video_service_clients_.at(instance.id)->rebind(channel);
+                        continue;
+                    }
+                    camera_service_clients_.at(instance.id)->rebind(channel);
+                    camera_passthrough_clients_.at(instance.id)->rebind(channel);
+                    if (const auto it = host_batchers_.find(host);
+                        it != host_batchers_.end() && it->second.instance_id == instance.id) {
+                        it->second.batcher->rebind(channel);
+                    }
+                } catch (const std::exception& e) {
+                    LOG_ERROR("Failed to rebuild {} channel {}: {}", service_name, instance.id, e.what());
+                }
+            }
+        }
+    }
+
+    RoundTripObserver GrpcClientManager::roundTripOf(const uint32_t instance_id) const {
+        if (!on_round_trip_) {
+            return {};
+        }
+        return [observer = on_round_trip_, instance_id](const std::chrono::microseconds round_trip) {
+            observer(instance_id, round_trip);
+        };
+    }
+
     template<typename ClientType>
     void GrpcClientManager::shutdownService(
         const std::string& service_name,
@@ -123,6 +367,23 @@ namespace service::infrastructure {
         channels.clear();
     }
 
+    std::string GrpcClientManager::channelTarget(const common::ServiceInstance& instance) const {
+        if (!instance.pinned_ip.empty()) {
+            return "ipv4:" + instance.pinned_ip + ":" + std::to_string(portOf(instance.address));
+        }
+
+        if (!resolver_) {
+            return instance.address;
+        }
+
+        const auto target = resolver_->toChannelTarget(instance.address);
+        if (target.isError()) {
+            LOG_WARN("Falling back to name resolution by the channel for {}: {}", instance.address, target.error().message);
+            return instance.address;
+        }
+        return target.value();
+    }
+
     std::shared_ptr<grpc::Channel> GrpcClientManager::createChannel(const std::string& address) {
         if (address.empty()) {
             throw std::invalid_argument("Service address cannot be empty");
@@ -1,15 +1,26 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <grpcpp/grpcpp.h>
 
 #include "common/config/ConfigManager.h"
+#include "common/types/DispatchMetrics.h"
+#include "infrastructure/clients/AddressResolver.h"
+#include "infrastructure/clients/AdmissionLimiter.h"
+#include "infrastructure/clients/CameraPassthroughClient.h"
+#include "infrastructure/clients/ChannelWarmup.h"
 #include "infrastructure/clients/ICameraServiceClient.h"
 #include "infrastructure/clients/IVideoServiceClient.h"
+#include "infrastructure/clients/RoundTrip.h"
 
 namespace service::infrastructure {
+    class CameraServiceClient;
+    class HostBatcher;
+    class VideoServiceClient;
+
     /**
      * Manages gRPC client connections and lifecycle
      * Creates channels and stubs based on InfrastructureConfig
@@ -17,7 +28,13 @@ namespace service::infrastructure {
      */
     class GrpcClientManager {
     public:
-        explicit GrpcClientManager(const common::InfrastructureConfig& config);
+        /**
+         * @param on_round_trip told the round trip of every camera_service call by instance, unset if not measured
+         * @param admission_timer wakes asynchronous commands waiting for an admission token, it must outlive the clients
+         */
+        explicit GrpcClientManager(const common::InfrastructureConfig& config,
+                                   InstanceRoundTripObserver on_round_trip = {},
+                                   AdmissionLimiter::Timer admission_timer = {});
         ~GrpcClientManager();
 
         GrpcClientManager(const GrpcClientManager&) = delete;
@@ -26,6 +43,8 @@ namespace service::infrastructure {
         /**
          * Initialize all clients from configuration
          * Creates gRPC channels for each configured service
+         * With warm-up enabled, connects all channels in parallel and blocks until
+         * the configured fraction of backends is ready or the warm-up budget is spent
          */
         void initialize();
 
@@ -43,6 +62,14 @@ namespace service::infrastructure {
          */
         ICameraServiceClient* getCameraServiceClient(uint32_t instance_id) const;
 
+        /**
+         * Get camera service passthrough client by instance ID
+         * @param instance_id instance ID [0-3]
+         * @return pointer to CameraPassthroughClient, nullptr if not initialized
+         * @throws std::invalid_argument if camera_service not configured
+         */
+        CameraPassthroughClient* getCameraPassthroughClient(uint32_t instance_id) const;
+
         /**
          * Get video service client by instance ID
          * @param instance_id instance ID [0-3]
@@ -51,35 +78,109 @@ namespace service::infrastructure {
          */
         IVideoServiceClient* getVideoServiceClient(uint32_t instance_id) const;
 
+        /**
+         * Start connecting the camera_service and video_service channels of an instance if they are idle
+         * Returns at once, a call shortly after finds the channels connected
+         * @param instance_id instance ID [0-3], unknown instances are ignored
+         */
+        void connectInstance(uint32_t instance_id) const;
+
+        /**
+         * Check the camera_service channel of an instance without calling the backend, an idle one starts connecting
+         * @param instance_id instance ID [0-3]
+         * @return true if the channel is ready, false if it is not or the instance is unknown
+         */
+        bool isCameraConnected(uint32_t instance_id) const;
+
+        /**
+         * @return readiness of the channel warm-up, not enabled if warm-up is off or the clients are shut down
+         */
+        common::types::WarmupMetrics warmupState() const;
+
     private:
         const common::InfrastructureConfig& config_;
+        const InstanceRoundTripObserver on_round_trip_;
+        const AdmissionLimiter::Timer admission_timer_;
+
+        struct HostBatch {
+            uint32_t instance_id; // instance whose channel carries the batches
+            std::shared_ptr<HostBatcher> batcher;
+        };
+
+        std::unique_ptr<AddressResolver> resolver_; // kept across re-initialization
+
+        // Guards the channels and their stubs against a rebuild from the resolver thread
+        mutable std::mutex channels_mutex_;
 
         // Camera service clients
         std::unordered_map<uint32_t, std::shared_ptr<grpc::Channel>> camera_channels_;
         std::unordered_map<uint32_t, std::unique_ptr<ICameraServiceClient>> camera_clients_;
+        std::unordered_map<uint32_t, std::unique_ptr<CameraPassthroughClient>> camera_passthrough_clients_;
+        std::unordered_map<uint32_t, CameraServiceClient*> camera_service_clients_; // innermost, owned above
+        std::unordered_map<std::string, HostBatch> host_batchers_;
 
         // Video service clients
         std::unordered_map<uint32_t, std::shared_ptr<grpc::Channel>> video_channels_;
         std::unordered_map<uint32_t, std::unique_ptr<IVideoServiceClient>> video_clients_;
+        std::unordered_map<uint32_t, VideoServiceClient*> video_service_clients_; // innermost, owned above
+
+        std::unique_ptr<ChannelWarmup> warmup_;
 
         /**
          * Create a gRPC channel to the specified address
          */
         std::shared_ptr<grpc::Channel> createChannel(const std::string& address);
 
+        /**
+         * Select the channel target for a service instance
+         * Pinned IPs are used as is, other hosts go through the resolver cache when enabled
+         * @return ipv4:<ip>:<port> target, or the configured address if it cannot be resolved
+         */
+        std::string channelTarget(const common::ServiceInstance& instance) const;
+
+        /**
+         * Start connecting all channels in parallel under the warm-up budget
+         * Only active when warm-up is enabled
+         */
+        void warmUpChannels();
+
+        /**
+         * Wrap camera_service clients sharing a host with a common HostBatcher
+         * Only active when batching is enabled for camera_service
+         */
+        void initializeCameraBatching();
+
+        /**
+         * Wrap the clients of services with an admission limit in a rate limited client per instance
+         * Applied on top of batching, so limits count the commands of each camera
+         */
+        void initializeAdmission();
+
+        /**
+         * Point the channels of a host whose address changed at its new address
+         * Called by the resolver, the clients keep their decorators and only swap their stubs
+         */
+        void rebuildChannels(const std::string& host);
+
+        /**
+         * @return observer reporting the round trips of one camera_service instance, unset if none are measured
+         */
+        RoundTripObserver roundTripOf(uint32_t instance_id) const;
+
         /**
          * Initialize service clients from configuration
          * @param service_name Name of the service to initialize
          * @param channels Map to store channels
          * @param clients Map to store clients
-         * @param client_factory Function to create client from channel
+         * @param client_factory Function to create client of an instance from its channel
          */
         template<typename ClientType>
         void initializeService(
             const std::string& service_name,
             std::unordered_map<uint32_t, std::shared_ptr<grpc::Channel>>& channels,
             std::unordered_map<uint32_t, std::unique_ptr<ClientType>>& clients,
-            std::function<std::unique_ptr<ClientType>(std::shared_ptr<grpc::ChannelInterface>)> client_factory);
+            std::function<std::unique_ptr<ClientType>(uint32_t, std::shared_ptr<grpc::ChannelInterface>)>
+                client_factory);
 
         /**
          * Shutdown service clients
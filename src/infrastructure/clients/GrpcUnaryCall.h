@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <utility>
+#include <grpcpp/support/status.h>
+
+namespace service::infrastructure {
+    /**
+     * Completion of one unary call on a gRPC callback stub, awaiting it yields the call status
+     * Pass done() to the stub, then co_await the call as a named object. The call may complete before the coroutine
+     * suspends, otherwise the coroutine resumes on the gRPC thread that completed it
+     */
+    class GrpcUnaryCall {
+    public:
+        GrpcUnaryCall() = default;
+
+        GrpcUnaryCall(const GrpcUnaryCall&) = delete;
+        GrpcUnaryCall& operator=(const GrpcUnaryCall&) = delete;
+
+        std::function<void(grpc::Status)> done() {
+            return [this](grpc::Status status) {
+                status_ = std::move(status);
+                if (completed_.exchange(true, std::memory_order_acq_rel)) {
+                    awaiting_.resume();
+                }
+            };
+        }
+
+        bool await_ready() const noexcept {
+            return completed_.load(std::memory_order_acquire);
+        }
+
+        bool await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+            awaiting_ = awaiting;
+            // Whichever of the two comes second goes on, the call may have completed in the meantime
+            return !completed_.exchange(true, std::memory_order_acq_rel);
+        }
+
+        grpc::Status await_resume() {
+            return std::move(status_);
+        }
+
+    private:
+        std::atomic<bool> completed_{false};
+        std::coroutine_handle<> awaiting_;
+        grpc::Status status_;
+    };
+} // namespace service::infrastructure
@@ -0,0 +1,239 @@
+#include "infrastructure/clients/HostBatcher.h"
+
+#include <algorithm>
+#include <future>
+#include <iterator>
+
+#include "common/logger/Logger.h"
+#include "common/state/CallContext.h"
+#include "infrastructure/clients/CallDeadline.h"
+
+namespace service::infrastructure {
+    HostBatcher::HostBatcher(std::string host, const std::shared_ptr<grpc::ChannelInterface>& channel,
+                             const common::BatchingConfig& config,
+                             std::function<void(uint32_t port, std::chrono::microseconds round_trip)> on_round_trip)
+        : host_(std::move(host)),
+          window_(config.window),
+          max_batch_size_(config.max_batch_size),
+          on_round_trip_(std::move(on_round_trip)) {
+        rebind(channel);
+
+        worker_ = std::jthread([this](const std::stop_token& stop_token) { run(stop_token); });
+    }
+
+    HostBatcher::~HostBatcher() {
+        worker_.request_stop();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+
+        std::vector<std::unique_ptr<PendingCommand>> abandoned;
+        {
+            std::lock_guard lock(mutex_);
+            abandoned.swap(pending_);
+        }
+        for (const auto& pending : abandoned) {
+            pending->done(std::nullopt);
+        }
+
+        std::unique_lock lock(in_flight_mutex_);
+        for (auto* const batch : in_flight_) {
+            batch->context.TryCancel();
+        }
+        in_flight_cv_.wait(lock, [this] { return in_flight_.empty(); });
+    }
+
+    HostBatcher::ActiveCall::ActiveCall(HostBatcher& batcher, const uint32_t port) : batcher_(batcher), port_(port) {
+        std::lock_guard lock(batcher_.mutex_);
+        ++batcher_.active_calls_[port_];
+    }
+
+    HostBatcher::ActiveCall::~ActiveCall() {
+        std::lock_guard lock(batcher_.mutex_);
+        const auto it = batcher_.active_calls_.find(port_);
+        if (it != batcher_.active_calls_.end() && --it->second == 0) {
+            batcher_.active_calls_.erase(it);
+        }
+    }
+
+    std::optional<camera::v1::BatchResult> HostBatcher::execute(camera::v1::BatchCommand command) {
+        const ActiveCall active_call(*this, command.port());
+        const auto outcome = std::make_shared<std::promise<std::optional<camera::v1::BatchResult>>>();
+        auto result = outcome->get_future();
+        enqueue(std::move(command), common::state::CallContext::current(),
+                [outcome](std::optional<camera::v1::BatchResult> batch_result) {
+                    outcome->set_value(std::move(batch_result));
+                });
+        return result.get();
+    }
+
+    common::async::Task<std::optional<camera::v1::BatchResult>> HostBatcher::executeAsync(
+        camera::v1::BatchCommand command, const common::state::CallContext call) {
+        const ActiveCall active_call(*this, command.port());
+        co_return co_await common::async::fromCallback<std::optional<camera::v1::BatchResult>>(
+            [this, &command, &call](auto complete) { enqueue(std::move(command), call, std::move(complete)); });
+    }
+
+    void HostBatcher::enqueue(camera::v1::BatchCommand command, const common::state::CallContext& call, Done done) {
+        if (!isSupported()) {
+            done(std::nullopt);
+            return;
+        }
+
+        auto pending = std::make_unique<PendingCommand>();
+        pending->command = std::move(command);
+        pending->priority = call.priority;
+        pending->deadline = call.deadline;
+        pending->done = std::move(done);
+
+        {
+            std::lock_guard lock(mutex_);
+            if (!worker_.get_stop_token().stop_requested()) {
+                pending_.emplace_back(std::move(pending));
+            }
+        }
+        if (pending) {
+            pending->done(std::nullopt);
+            return;
+        }
+        pending_cv_.notify_one();
+    }
+
+    void HostBatcher::rebind(const std::shared_ptr<grpc::ChannelInterface>& channel) {
+        std::shared_ptr<camera::v1::CameraService::Stub> stub = camera::v1::CameraService::NewStub(channel);
+        if (!stub) {
+            throw std::runtime_error("Failed to create camera_service batch stub for " + host_);
+        }
+        stub_.store(std::move(stub), std::memory_order_release);
+    }
+
+    bool HostBatcher::isSupported() const {
+        return supported_.load();
+    }
+
+    HostBatcher::ActiveCall HostBatcher::track(const uint32_t port) {
+        return {*this, port};
+    }
+
+    const std::string& HostBatcher::host() const {
+        return host_;
+    }
+
+    bool HostBatcher::hasBusySibling(const uint32_t port) const {
+        return std::any_of(active_calls_.begin(), active_calls_.end(),
+                           [port](const auto& active) { return active.first != port; });
+    }
+
+    void HostBatcher::run(const std::stop_token& stop_token) {
+        while (!stop_token.stop_requested()) {
+            std::vector<std::unique_ptr<PendingCommand>> commands;
+            {
+                std::unique_lock lock(mutex_);
+                if (!pending_cv_.wait(lock, stop_token, [this] { return !pending_.empty(); })) {
+                    return;
+                }
+
+                // Hold the first command for the window so commands to sibling instances can join it,
+                // unless an interactive command is waiting or no sibling is busy to send one
+                const auto window_end = hasBusySibling(pending_.front()->command.port())
+                                            ? std::chrono::steady_clock::now() + window_
+                                            : std::chrono::steady_clock::now();
+                pending_cv_.wait_until(lock, stop_token, window_end, [this] {
+                    return pending_.size() >= max_batch_size_ ||
+                           std::any_of(pending_.begin(), pending_.end(), [](const auto& pending) {
+                               return pending->priority == common::types::Priority::Interactive;
+                           });
+                });
+
+                // Higher classes go first, arrival order is kept within a class
+                std::stable_sort(pending_.begin(), pending_.end(), [](const auto& left, const auto& right) {
+                    return left->priority < right->priority;
+                });
+
+                const auto count = std::min(pending_.size(), max_batch_size_);
+                commands.assign(std::make_move_iterator(pending_.begin()),
+                                std::make_move_iterator(pending_.begin() + static_cast<std::ptrdiff_t>(count)));
+                pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(count));
+            }
+
+            dispatch(std::move(commands));
+        }
+    }
+
+    void HostBatcher::dispatch(std::vector<std::unique_ptr<PendingCommand>> commands) {
+        if (commands.size() < 2 || !isSupported()) {
+            for (const auto& command : commands) {
+                command->done(std::nullopt);
+            }
+            return;
+        }
+
+        auto batch = std::make_unique<InFlightBatch>();
+        batch->request.mutable_commands()->Reserve(static_cast<int>(commands.size()));
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        for (const auto& command : commands) {
+            *batch->request.add_commands() = command->command;
+            deadline = std::min(deadline, command->deadline);
+        }
+        batch->commands = std::move(commands);
+        // A batch may not outlive the most urgent of its commands
+        applyCallDeadline(batch->context, deadline);
+
+        LOG_TRACE("Sending batch of {} commands to {}", batch->commands.size(), host_);
+
+        auto* const in_flight = batch.release();
+        in_flight->sent = std::chrono::steady_clock::now();
+        {
+            std::lock_guard lock(in_flight_mutex_);
+            in_flight_.insert(in_flight);
+        }
+
+        const auto stub = stub_.load(std::memory_order_acquire);
+        stub->async()->ExecuteBatch(&in_flight->context, &in_flight->request, &in_flight->response,
+                                    [this, in_flight](const grpc::Status& status) { complete(in_flight, status); });
+    }
+
+    void HostBatcher::complete(InFlightBatch* batch, const grpc::Status& status) {
+        const std::unique_ptr<InFlightBatch> owned(batch);
+        auto& commands = owned->commands;
+
+        if (on_round_trip_ && status.error_code() != grpc::StatusCode::UNIMPLEMENTED) {
+            const auto round_trip = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - owned->sent);
+            for (const auto& command : commands) {
+                on_round_trip_(command->command.port(), round_trip);
+            }
+        }
+
+        if (status.error_code() == grpc::StatusCode::UNIMPLEMENTED) {
+            if (supported_.exchange(false)) {
+                LOG_WARN("camera_service on {} does not support ExecuteBatch, falling back to individual calls",
+                         host_);
+            }
+            for (const auto& command : commands) {
+                command->done(std::nullopt);
+            }
+        } else if (!status.ok() || owned->response.results_size() != static_cast<int>(commands.size())) {
+            camera::v1::BatchResult failure;
+            if (status.ok()) {
+                failure.set_status_code(grpc::StatusCode::INTERNAL);
+                failure.set_error_message("ExecuteBatch returned " + std::to_string(owned->response.results_size()) +
+                                          " results for " + std::to_string(commands.size()) + " commands");
+            } else {
+                failure.set_status_code(status.error_code());
+                failure.set_error_message(status.error_message());
+            }
+            for (const auto& command : commands) {
+                command->done(failure);
+            }
+        } else {
+            for (std::size_t i = 0; i < commands.size(); ++i) {
+                commands[i]->done(std::move(*owned->response.mutable_results(static_cast<int>(i))));
+            }
+        }
+
+        std::lock_guard lock(in_flight_mutex_);
+        in_flight_.erase(batch);
+        in_flight_cv_.notify_all();
+    }
+} // namespace service::infrastructure
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+
+#include "api/proto/camera_service.grpc.pb.h"
+#include "common/async/Task.h"
+#include "common/config/ConfigManager.h"
+#include "common/state/CallContext.h"
+#include "common/types/Priority.h"
+
+namespace service::infrastructure {
+    /**
+     * Groups camera_service commands addressed to instances on the same host
+     * Commands queued within the batching window are sent as one ExecuteBatch call
+     * and the results are demultiplexed back to the waiting callers
+     * A batch takes the highest priority commands first, an interactive command closes the window at once
+     * The window is only held while a sibling instance on the host has a command in flight,
+     * a command to an otherwise idle host is sent at once
+     */
+    class HostBatcher {
+    public:
+        /**
+         * Marks a command to one instance as in flight for as long as it lives,
+         * including the individual call made when the command could not be batched
+         */
+        class ActiveCall {
+        public:
+            ActiveCall(HostBatcher& batcher, uint32_t port);
+            ~ActiveCall();
+
+            ActiveCall(const ActiveCall&) = delete;
+            ActiveCall& operator=(const ActiveCall&) = delete;
+
+        private:
+            HostBatcher& batcher_;
+            uint32_t port_;
+        };
+
+        /**
+         * @param on_round_trip told the port of each batched command and the round trip of its ExecuteBatch call,
+         *        the batching window excluded
+         */
+        HostBatcher(std::string host, const std::shared_ptr<grpc::ChannelInterface>& channel,
+                    const common::BatchingConfig& config,
+                    std::function<void(uint32_t port, std::chrono::microseconds round_trip)> on_round_trip = {});
+        ~HostBatcher();
+
+        HostBatcher(const HostBatcher&) = delete;
+        HostBatcher& operator=(const HostBatcher&) = delete;
+
+        /**
+         * Queue a command for the next batch of this host and wait for its result
+         * The command is queued at the priority and deadline of the current call
+         * @param command command addressed to one camera_service instance on this host
+         * @return result of the command, std::nullopt if the command must be sent individually
+         *         (batch of one, backend without ExecuteBatch support or batcher shutting down)
+         */
+        std::optional<camera::v1::BatchResult> execute(camera::v1::BatchCommand command);
+
+        /**
+         * execute() without blocking, the task resumes on the thread that completed the batch
+         * or on the batcher thread when the command must be sent individually
+         * @param call call the command runs for, it sets the priority and deadline of the command
+         */
+        common::async::Task<std::optional<camera::v1::BatchResult>> executeAsync(camera::v1::BatchCommand command,
+                                                                                 common::state::CallContext call);
+
+        /**
+         * Send later batches over another channel to the host, batches already sent finish on the old one
+         */
+        void rebind(const std::shared_ptr<grpc::ChannelInterface>& channel);
+
+        /**
+         * @return false once the backend answered ExecuteBatch with UNIMPLEMENTED
+         */
+        bool isSupported() const;
+
+        /**
+         * @param port instance the command is addressed to
+         * @return guard keeping the command in flight until it is destroyed
+         */
+        [[nodiscard]] ActiveCall track(uint32_t port);
+
+        const std::string& host() const;
+
+    private:
+        using Done = std::function<void(std::optional<camera::v1::BatchResult>)>;
+
+        struct PendingCommand {
+            camera::v1::BatchCommand command;
+            common::types::Priority priority{common::types::Priority::Normal};
+            std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+            Done done; // called once with the result
+        };
+
+        struct InFlightBatch {
+            std::chrono::steady_clock::time_point sent;
+            grpc::ClientContext context;
+            camera::v1::BatchRequest request;
+            camera::v1::BatchResponse response;
+            std::vector<std::unique_ptr<PendingCommand>> commands;
+        };
+
+        /**
+         * Queue a command at the priority and deadline of call, done may run before enqueue returns
+         */
+        void enqueue(camera::v1::BatchCommand command, const common::state::CallContext& call, Done done);
+        void run(const std::stop_token& stop_token);
+        bool hasBusySibling(uint32_t port) const;
+        void dispatch(std::vector<std::unique_ptr<PendingCommand>> commands);
+        void complete(InFlightBatch* batch, const grpc::Status& status);
+
+        std::string host_;
+        std::atomic<std::shared_ptr<camera::v1::CameraService::Stub>> stub_; // replaced by rebind()
+        std::chrono::microseconds window_;
+        std::size_t max_batch_size_;
+        std::atomic<bool> supported_{true};
+        std::function<void(uint32_t port, std::chrono::microseconds round_trip)> on_round_trip_;
+
+        std::mutex mutex_;
+        std::condition_variable_any pending_cv_;
+        std::vector<std::unique_ptr<PendingCommand>> pending_;
+        std::unordered_map<uint32_t, std::size_t> active_calls_; // in flight commands per instance port
+
+        std::mutex in_flight_mutex_;
+        std::condition_variable in_flight_cv_;
+        std::unordered_set<InFlightBatch*> in_flight_;
+
+        std::jthread worker_;
+    };
+} // namespace service::infrastructure
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "common/async/Task.h"
+#include "common/state/CallContext.h"
 #include "common/types/CameraTypes.h"
 #include "common/types/CameraCapabilities.h"
 #include "common/types/Result.h"
@@ -14,13 +16,13 @@ namespace service::infrastructure {
         virtual ~ICameraServiceClient() = default;
 
         // Zoom operations
-        virtual Result<void> setZoom(common::types::zoom zoom_level) = 0;
+        virtual Result<common::types::zoom> setZoom(common::types::zoom zoom_level) = 0;
         virtual Result<common::types::zoom> getZoom() = 0;
-        virtual Result<void> goToMinZoom() = 0;
-        virtual Result<void> goToMaxZoom() = 0;
+        virtual Result<common::types::zoom> goToMinZoom() = 0;
+        virtual Result<common::types::zoom> goToMaxZoom() = 0;
 
         // Focus operations
-        virtual Result<void> setFocus(common::types::focus focus_value) = 0;
+        virtual Result<common::types::focus> setFocus(common::types::focus focus_value) = 0;
         virtual Result<common::types::focus> getFocus() = 0;
         virtual Result<void> enableAutoFocus(bool on) = 0;
         virtual Result<bool> getAutoFocus() = 0;
@@ -34,5 +36,19 @@ namespace service::infrastructure {
 
         // Capabilities
         virtual Result<common::capabilities::CapabilityList> getCapabilities() = 0;
+
+        // Asynchronous absolute commands, the defaults make the synchronous call when awaited
+        // They take the context of the call they run for, the thread that resumes them has another one
+        virtual common::async::Task<Result<common::types::zoom>> setZoomAsync(common::state::CallContext call,
+                                                                              common::types::zoom zoom_level) {
+            common::state::CallContext::Scope scope(call);
+            co_return setZoom(zoom_level);
+        }
+
+        virtual common::async::Task<Result<common::types::focus>> setFocusAsync(common::state::CallContext call,
+                                                                                common::types::focus focus_value) {
+            common::state::CallContext::Scope scope(call);
+            co_return setFocus(focus_value);
+        }
     };
 } // namespace service::infrastructure
@@ -0,0 +1,91 @@
+#include "infrastructure/clients/RateLimitedCameraServiceClient.h"
+
+namespace service::infrastructure {
+    namespace {
+        constexpr auto ZOOM_AXIS = "zoom";
+    } // unnamed namespace
+
+    RateLimitedCameraServiceClient::RateLimitedCameraServiceClient(std::unique_ptr<ICameraServiceClient> client,
+                                                                   std::shared_ptr<AdmissionLimiter> limiter)
+        : client_(std::move(client)), limiter_(std::move(limiter)) {
+        if (!client_) {
+            throw std::invalid_argument("Rate limited camera_service client cannot be null");
+        }
+        if (!limiter_) {
+            throw std::invalid_argument("Admission limiter cannot be null");
+        }
+    }
+
+    // Zoom operations
+    Result<common::types::zoom> RateLimitedCameraServiceClient::setZoom(const common::types::zoom zoom_level) {
+        return limiter_->command<common::types::zoom>("zoom", [this, zoom_level] {
+            return client_->setZoom(zoom_level);
+        }, ZOOM_AXIS);
+    }
+
+    common::async::Task<Result<common::types::zoom>> RateLimitedCameraServiceClient::setZoomAsync(
+        const common::state::CallContext call, const common::types::zoom zoom_level) {
+        return limiter_->commandAsync<common::types::zoom>("zoom", [this, call, zoom_level] {
+            return client_->setZoomAsync(call, zoom_level);
+        }, ZOOM_AXIS);
+    }
+
+    Result<common::types::zoom> RateLimitedCameraServiceClient::getZoom() {
+        return limiter_->read<common::types::zoom>([this] { return client_->getZoom(); });
+    }
+
+    Result<common::types::zoom> RateLimitedCameraServiceClient::goToMinZoom() {
+        return limiter_->command<common::types::zoom>("min_zoom", [this] { return client_->goToMinZoom(); },
+                                                      ZOOM_AXIS);
+    }
+
+    Result<common::types::zoom> RateLimitedCameraServiceClient::goToMaxZoom() {
+        return limiter_->command<common::types::zoom>("max_zoom", [this] { return client_->goToMaxZoom(); },
+                                                      ZOOM_AXIS);
+    }
+
+    // Focus operations
+    Result<common::types::focus> RateLimitedCameraServiceClient::setFocus(const common::types::focus focus_value) {
+        return limiter_->command<common::types::focus>("focus", [this, focus_value] {
+            return client_->setFocus(focus_value);
+        });
+    }
+
+    common::async::Task<Result<common::types::focus>> RateLimitedCameraServiceClient::setFocusAsync(
+        const common::state::CallContext call, const common::types::focus focus_value) {
+        return limiter_->commandAsync<common::types::focus>("focus", [this, call, focus_value] {
+            return client_->setFocusAsync(call, focus_value);
+        });
+    }
+
+    Result<common::types::focus> RateLimitedCameraServiceClient::getFocus() {
+        return limiter_->read<common::types::focus>([this] { return client_->getFocus(); });
+    }
+
+    Result<void> RateLimitedCameraServiceClient::enableAutoFocus(const bool on) {
+        return limiter_->command<void>("auto_focus", [this, on] { return client_->enableAutoFocus(on); });
+    }
+
+    Result<bool> RateLimitedCameraServiceClient::getAutoFocus() {
+        return limiter_->read<bool>([this] { return client_->getAutoFocus(); });
+    }
+
+    // Device info
+    Result<common::types::info> RateLimitedCameraServiceClient::getInfo() {
+        return limiter_->read<common::types::info>([this] { return client_->getInfo(); });
+    }
+
+    // Advanced operations
+    Result<void> RateLimitedCameraServiceClient::stabilize(const bool on) {
+        return limiter_->command<void>("stabilization", [this, on] { return client_->stabilize(on); });
+    }
+
+    Result<bool> RateLimitedCameraServiceClient::getStabilization() {
+        return limiter_->read<bool>([this] { return client_->getStabilization(); });
+    }
+
+    // Capabilities
+    Result<common::capabilities::CapabilityList> RateLimitedCameraServiceClient::getCapabilities() {
+        return limiter_->read<common::capabilities::CapabilityList>([this] { return client_->getCapabilities(); });
+    }
+} // namespace service::infrastructure
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+
+#include "infrastructure/clients/AdmissionLimiter.h"
+#include "infrastructure/clients/ICameraServiceClient.h"
+
+namespace service::infrastructure {
+    /**
+     * Decorates a camera_service client with token-bucket admission of its commands
+     * Zoom commands conflate with each other, as do focus commands. Min and max zoom only conflate with themselves,
+     * an end stop the client asked for is never swapped for a setpoint or the opposite end. They share the zoom axis
+     * with the setpoints: a zoom command queued behind another kind is sent after it, the newest one last
+     */
+    class RateLimitedCameraServiceClient : public ICameraServiceClient {
+    public:
+        RateLimitedCameraServiceClient(std::unique_ptr<ICameraServiceClient> client,
+                                       std::shared_ptr<AdmissionLimiter> limiter);
+        ~RateLimitedCameraServiceClient() override = default;
+
+        // Zoom operations
+        Result<common::types::zoom> setZoom(common::types::zoom zoom_level) override;
+        Result<common::types::zoom> getZoom() override;
+        Result<common::types::zoom> goToMinZoom() override;
+        Result<common::types::zoom> goToMaxZoom() override;
+
+        // Focus operations
+        Result<common::types::focus> setFocus(common::types::focus focus_value) override;
+        Result<common::types::focus> getFocus() override;
+        Result<void> enableAutoFocus(bool on) override;
+        Result<bool> getAutoFocus() override;
+
+        // Device info
+        Result<common::types::info> getInfo() override;
+
+        // Advanced operations
+        Result<void> stabilize(bool on) override;
+        Result<bool> getStabilization() override;
+
+        // Capabilities
+        Result<common::capabilities::CapabilityList> getCapabilities() override;
+
+        // Asynchronous operations, past the limit they await their token on the limiter's timer and conflate with
+        // the synchronous commands of their kind
+        common::async::Task<Result<common::types::zoom>> setZoomAsync(common::state::CallContext call,
+                                                                      common::types::zoom zoom_level) override;
+        common::async::Task<Result<common::types::focus>> setFocusAsync(common::state::CallContext call,
+                                                                        common::types::focus focus_value) override;
+
+    private:
+        std::unique_ptr<ICameraServiceClient> client_;
+        std::shared_ptr<AdmissionLimiter> limiter_; // shared with the instance's passthrough client
+    };
+} // namespace service::infrastructure
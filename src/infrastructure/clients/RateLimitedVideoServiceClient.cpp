@@ -0,0 +1,29 @@
+#include "infrastructure/clients/RateLimitedVideoServiceClient.h"
+
+namespace service::infrastructure {
+    RateLimitedVideoServiceClient::RateLimitedVideoServiceClient(std::unique_ptr<IVideoServiceClient> client,
+                                                                 std::unique_ptr<AdmissionLimiter> limiter)
+        : client_(std::move(client)), limiter_(std::move(limiter)) {
+        if (!client_) {
+            throw std::invalid_argument("Rate limited video_service client cannot be null");
+        }
+        if (!limiter_) {
+            throw std::invalid_argument("Admission limiter cannot be null");
+        }
+    }
+
+    Result<void> RateLimitedVideoServiceClient::SetVideoCapabilityState(const std::string& capability,
+                                                                        const bool enable) {
+        return limiter_->command<void>("capability:" + capability, [this, capability, enable] {
+            return client_->SetVideoCapabilityState(capability, enable);
+        });
+    }
+
+    Result<bool> RateLimitedVideoServiceClient::getVideoCapabilityState(const std::string& capability) {
+        return limiter_->read<bool>([this, &capability] { return client_->getVideoCapabilityState(capability); });
+    }
+
+    Result<std::vector<std::string>> RateLimitedVideoServiceClient::getVideoCapabilities() {
+        return limiter_->read<std::vector<std::string>>([this] { return client_->getVideoCapabilities(); });
+    }
+} // namespace service::infrastructure
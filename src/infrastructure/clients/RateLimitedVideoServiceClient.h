@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "infrastructure/clients/AdmissionLimiter.h"
+#include "infrastructure/clients/IVideoServiceClient.h"
+
+namespace service::infrastructure {
+    /**
+     * Decorates a video_service client with token-bucket admission of its commands
+     * Capability state commands conflate per capability
+     */
+    class RateLimitedVideoServiceClient : public IVideoServiceClient {
+    public:
+        RateLimitedVideoServiceClient(std::unique_ptr<IVideoServiceClient> client,
+                                      std::unique_ptr<AdmissionLimiter> limiter);
+        ~RateLimitedVideoServiceClient() override = default;
+
+        // Video operations
+        Result<void> SetVideoCapabilityState(const std::string& capability, bool enable) override;
+        Result<bool> getVideoCapabilityState(const std::string& capability) override;
+        Result<std::vector<std::string>> getVideoCapabilities() override;
+
+    private:
+        std::unique_ptr<IVideoServiceClient> client_;
+        std::unique_ptr<AdmissionLimiter> limiter_;
+    };
+} // namespace service::infrastructure
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/status.h>
+
+namespace service::infrastructure {
+    /**
+     * Serialized backend call forwarded without decoding its messages
+     */
+    struct RawCall {
+        std::string method;                                // backend method name (e.g., "SetZoom")
+        const grpc::ByteBuffer* request{nullptr};          // serialized backend request, owned by the caller
+        grpc::ByteBuffer* response{nullptr};               // receives the serialized backend response
+        std::chrono::system_clock::time_point deadline;    // deadline of the originating call
+        std::function<void(const grpc::Status&)> on_done;  // invoked once with the backend status
+
+        /**
+         * @return true if the method changes the camera, false for a read
+         */
+        bool isCommand() const {
+            return method.starts_with("Set") || method.starts_with("GoTo");
+        }
+    };
+} // namespace service::infrastructure
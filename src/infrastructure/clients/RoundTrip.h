@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace service::infrastructure {
+    /**
+     * Told the round trip of each backend call, from sending its request to the reply
+     */
+    using RoundTripObserver = std::function<void(std::chrono::microseconds round_trip)>;
+
+    /**
+     * Told the instance and round trip of each camera_service call
+     */
+    using InstanceRoundTripObserver = std::function<void(uint32_t instance_id, std::chrono::microseconds round_trip)>;
+
+    /**
+     * Report the round trip of a call sent at sent, no-op without an observer
+     */
+    inline void reportRoundTrip(const RoundTripObserver& observer, const std::chrono::steady_clock::time_point sent) {
+        if (observer) {
+            observer(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sent));
+        }
+    }
+} // namespace service::infrastructure
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace service::infrastructure {
+    /**
+     * Lock-free token bucket refilled at rate_hz up to burst tokens
+     * Kept as the time the bucket would be full again (GCRA), so taking a token is a single compare-and-swap.
+     * A token may be reserved ahead of time: the bucket then runs into debt and later callers wait behind it
+     */
+    class TokenBucket {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Reservation {
+            bool granted{false};
+            Clock::time_point ready; // when the token may be used, or would have been if it was not granted
+        };
+
+        /**
+         * @param rate_hz tokens per second, must be positive
+         * @param burst tokens available at once after the bucket was idle, at least 1
+         */
+        TokenBucket(const double rate_hz, const uint32_t burst)
+            : interval_(std::max<int64_t>(static_cast<int64_t>(1e9 / rate_hz), 1)),
+              tolerance_(interval_ * (std::max<uint32_t>(burst, 1) - 1)) {
+        }
+
+        TokenBucket(const TokenBucket&) = delete;
+        TokenBucket& operator=(const TokenBucket&) = delete;
+
+        /**
+         * Reserve the next token if it is available within max_wait of now
+         * @return granted with the time to use the token, or not granted with the time the next one would be ready
+         */
+        Reservation reserve(const Clock::time_point now, const Clock::duration max_wait = Clock::duration::zero()) {
+            const auto now_ns = toNanos(now);
+            const auto max_wait_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(max_wait).count();
+
+            auto full_at = full_at_.load(std::memory_order_relaxed);
+            while (true) {
+                const auto start = std::max(full_at, now_ns);
+                const auto ready = std::max(start - tolerance_, now_ns);
+                if (ready - now_ns > max_wait_ns) {
+                    return {.granted = false, .ready = fromNanos(ready)};
+                }
+                if (full_at_.compare_exchange_weak(full_at, start + interval_, std::memory_order_relaxed)) {
+                    return {.granted = true, .ready = fromNanos(ready)};
+                }
+            }
+        }
+
+    private:
+        static int64_t toNanos(const Clock::time_point time) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+
+        static Clock::time_point fromNanos(const int64_t nanos) {
+            return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(nanos)));
+        }
+
+        const int64_t interval_; // nanoseconds per token
+        const int64_t tolerance_; // nanoseconds of tokens held beyond the next one, burst - 1 intervals
+        std::atomic<int64_t> full_at_{0}; // nanoseconds since the clock epoch when all tokens are back
+    };
+} // namespace service::infrastructure
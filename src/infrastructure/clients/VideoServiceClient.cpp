@@ -3,35 +3,44 @@
 #include <google/protobuf/empty.pb.h>
 
 #include "common/logger/Logger.h"
+#include "common/memory/ReusableArena.h"
+#include "infrastructure/clients/CallDeadline.h"
 
 namespace service::infrastructure {
-    VideoServiceClient::VideoServiceClient(std::shared_ptr<grpc::ChannelInterface> channel)
-        : stub_(video::v1::VideoService::NewStub(channel)) {
-        if (!stub_) {
+    VideoServiceClient::VideoServiceClient(std::shared_ptr<grpc::ChannelInterface> channel) {
+        rebind(std::move(channel));
+    }
+
+    void VideoServiceClient::rebind(std::shared_ptr<grpc::ChannelInterface> channel) {
+        std::shared_ptr<video::v1::VideoService::Stub> stub = video::v1::VideoService::NewStub(channel);
+        if (!stub) {
             throw std::runtime_error("Failed to create video_service stub");
         }
+        stub_.store(std::move(stub), std::memory_order_release);
     }
 
     // Video operations
     Result<void> VideoServiceClient::SetVideoCapabilityState(const std::string& capability, const bool enable) {
-        video::v1::SetVideoCapabilityStateRequest request;
-        request.set_capability(capability);
-        request.set_enable(enable);
+        auto* const request = common::memory::threadLocalArena().create<video::v1::SetVideoCapabilityStateRequest>();
+        request->set_capability(capability);
+        request->set_enable(enable);
 
         google::protobuf::Empty response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->SetVideoCapabilityState(&context, request, &response);
+        const auto status = stub()->SetVideoCapabilityState(&context, *request, &response);
         return handleGrpcVoidError(status, "SetVideoCapabilityState");
     }
 
     Result<bool> VideoServiceClient::getVideoCapabilityState(const std::string& capability) {
-        video::v1::GetVideoCapabilityStateRequest request;
-        request.set_capability(capability);
+        auto* const request = common::memory::threadLocalArena().create<video::v1::GetVideoCapabilityStateRequest>();
+        request->set_capability(capability);
         video::v1::GetVideoCapabilityStateResponse response;
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GetVideoCapabilityState(&context, request, &response);
+        const auto status = stub()->GetVideoCapabilityState(&context, *request, &response);
         if (!status.ok()) {
             return Result<bool>::error(
                 std::string("video_service.GetVideoCapabilityState: ") + status.error_message()
@@ -43,10 +52,11 @@ namespace service::infrastructure {
 
     Result<std::vector<std::string>> VideoServiceClient::getVideoCapabilities() {
         google::protobuf::Empty request;
-        video::v1::GetVideoCapabilitiesResponse response;
+        auto* const response = common::memory::threadLocalArena().create<video::v1::GetVideoCapabilitiesResponse>();
         grpc::ClientContext context;
+        applyCallDeadline(context);
 
-        const auto status = stub_->GetVideoCapabilities(&context, request, &response);
+        const auto status = stub()->GetVideoCapabilities(&context, request, response);
         if (!status.ok()) {
             return Result<std::vector<std::string>>::error(
                 std::string("video_service.GetVideoCapabilities: ") + status.error_message()
@@ -54,8 +64,8 @@ namespace service::infrastructure {
         }
 
         std::vector<std::string> capabilities;
-        capabilities.reserve(response.capabilities_size());
-        for (const auto& capability : response.capabilities()) {
+        capabilities.reserve(response->capabilities_size());
+        for (const auto& capability : response->capabilities()) {
             capabilities.push_back(capability);
         }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <grpcpp/client_context.h>
@@ -14,13 +15,22 @@ namespace service::infrastructure {
         explicit VideoServiceClient(std::shared_ptr<grpc::ChannelInterface> channel);
         ~VideoServiceClient() override = default;
 
+        /**
+         * Send later calls over another channel, calls already started finish on the old one
+         */
+        void rebind(std::shared_ptr<grpc::ChannelInterface> channel);
+
         // Video operations
         Result<void> SetVideoCapabilityState(const std::string& capability, bool enable) override;
         Result<bool> getVideoCapabilityState(const std::string& capability) override;
         Result<std::vector<std::string>> getVideoCapabilities() override;
 
     private:
-        std::unique_ptr<video::v1::VideoService::Stub> stub_;
+        std::atomic<std::shared_ptr<video::v1::VideoService::Stub>> stub_; // replaced by rebind()
+
+        std::shared_ptr<video::v1::VideoService::Stub> stub() const {
+            return stub_.load(std::memory_order_acquire);
+        }
 
         /**
          * Helper to handle gRPC call results
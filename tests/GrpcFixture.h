@@ -0,0 +1,205 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+/* Add your project include files here */
+#include "api/GrpcTransport.h"
+#include "api/RequestHandler.h"
+#include "api/proto/camera_service.grpc.pb.h"
+#include "api/proto/core_service.grpc.pb.h"
+#include "api/proto/video_service.grpc.pb.h"
+#include "core/Core.h"
+
+using namespace service;
+using namespace testing;
+
+/**
+ * camera_service backend keeping the lens state in memory and reporting every set value as applied
+ * Every Set is held for command_delay and logged, tests override the methods their backend does differently
+ */
+class FakeCameraService : public camera::v1::CameraService::Service {
+public:
+    grpc::Status SetZoom(grpc::ServerContext*, const camera::v1::SetZoomRequest* request,
+                         camera::v1::SetZoomResponse* response) override {
+        ++set_zoom_calls;
+        record("zoom");
+        zoom = request->zoom();
+        response->set_zoom(request->zoom());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status GetZoom(grpc::ServerContext*, const google::protobuf::Empty*,
+                         camera::v1::GetZoomResponse* response) override {
+        ++get_zoom_calls;
+        response->set_zoom(zoom);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status SetFocus(grpc::ServerContext*, const camera::v1::SetFocusRequest* request,
+                          camera::v1::SetFocusResponse* response) override {
+        record("focus");
+        focus = request->focus();
+        response->set_focus(request->focus());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status GetFocus(grpc::ServerContext*, const google::protobuf::Empty*,
+                          camera::v1::GetFocusResponse* response) override {
+        response->set_focus(focus);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status SetAutoFocus(grpc::ServerContext*, const camera::v1::SetAutoFocusRequest* request,
+                              google::protobuf::Empty*) override {
+        record("auto_focus");
+        auto_focus = request->enable();
+        return grpc::Status::OK;
+    }
+
+    grpc::Status GetAutoFocus(grpc::ServerContext*, const google::protobuf::Empty*,
+                              camera::v1::GetAutoFocusResponse* response) override {
+        response->set_enable(auto_focus);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status SetStabilization(grpc::ServerContext*, const camera::v1::SetStabilizationRequest* request,
+                                  google::protobuf::Empty*) override {
+        record("stabilization");
+        stabilization = request->enable();
+        return grpc::Status::OK;
+    }
+
+    grpc::Status GetStabilization(grpc::ServerContext*, const google::protobuf::Empty*,
+                                  camera::v1::GetStabilizationResponse* response) override {
+        response->set_enable(stabilization);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status GetInfo(grpc::ServerContext*, const google::protobuf::Empty*,
+                         camera::v1::GetInfoResponse* response) override {
+        ++get_info_calls;
+        response->set_info("camera");
+        return grpc::Status::OK;
+    }
+
+    /**
+     * Sets received so far, in order
+     */
+    std::vector<std::string> commands() {
+        std::lock_guard lock(mutex_);
+        return commands_;
+    }
+
+    std::chrono::milliseconds command_delay{0}; // set before the backend starts
+    std::atomic<uint32_t> zoom{0};
+    std::atomic<uint32_t> focus{0};
+    std::atomic<bool> auto_focus{false};
+    std::atomic<bool> stabilization{false};
+    std::atomic<int> set_zoom_calls{0};
+    std::atomic<int> get_zoom_calls{0};
+    std::atomic<int> get_info_calls{0};
+
+private:
+    void record(const std::string& command) {
+        std::this_thread::sleep_for(command_delay);
+        std::lock_guard lock(mutex_);
+        commands_.push_back(command);
+    }
+
+    std::mutex mutex_;
+    std::vector<std::string> commands_;
+};
+
+/**
+ * video_service backend offering hdr and osd, osd is always off
+ */
+class FakeVideoService : public video::v1::VideoService::Service {
+public:
+    grpc::Status GetVideoCapabilities(grpc::ServerContext*, const google::protobuf::Empty*,
+                                      video::v1::GetVideoCapabilitiesResponse* response) override {
+        response->add_capabilities("hdr");
+        response->add_capabilities("osd");
+        return grpc::Status::OK;
+    }
+
+    grpc::Status GetVideoCapabilityState(grpc::ServerContext*, const video::v1::GetVideoCapabilityStateRequest* request,
+                                         video::v1::GetVideoCapabilityStateResponse* response) override {
+        response->set_enable(request->capability() == "hdr" && hdr);
+        return grpc::Status::OK;
+    }
+
+    std::atomic<bool> hdr{false};
+};
+
+/**
+ * Runs the service end to end: fake backends, the core behind a RequestHandler and the gRPC front-end
+ * The front-end listens on a port picked by the system, stub_ is connected to it
+ */
+class GrpcFixture : public Test {
+protected:
+    /**
+     * Serve a camera from a new backend
+     * @param video_service also serves the camera's video_service if set
+     */
+    void addBackend(const uint32_t camera_id, camera::v1::CameraService::Service& camera_service,
+                    video::v1::VideoService::Service* video_service = nullptr) {
+        grpc::ServerBuilder builder;
+        int backend_port = 0;
+        builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &backend_port);
+        builder.RegisterService(&camera_service);
+        if (video_service) {
+            builder.RegisterService(video_service);
+        }
+        auto backend = builder.BuildAndStart();
+        ASSERT_NE(nullptr, backend);
+        backends_.push_back(std::move(backend));
+
+        common::ServiceInstance instance;
+        instance.id = camera_id;
+        instance.address = "127.0.0.1:" + std::to_string(backend_port);
+        config_.clients["camera_service"].instances.push_back(instance);
+        if (video_service) {
+            config_.clients["video_service"].instances.push_back(instance);
+        }
+    }
+
+    /**
+     * Start the core over the backends added so far and the front-end in front of it
+     * The transport options are the ones of GrpcTransport
+     */
+    void startFrontEnd(const common::CoreConfig& core_config = {}, const bool passthrough = false,
+                       const common::ControlStreamConfig& control_stream = {},
+                       const common::QuotasConfig& quotas = {}) {
+        request_handler_ = std::make_unique<api::RequestHandler>(
+            std::make_unique<service::core::Core>(config_, core_config));
+        ASSERT_TRUE(request_handler_->start().isSuccess());
+        transport_ = std::make_unique<api::GrpcTransport>(*request_handler_, passthrough, control_stream, quotas);
+        ASSERT_TRUE(transport_->start("127.0.0.1:0").isSuccess());
+
+        stub_ = ::core::v1::CoreService::NewStub(grpc::CreateChannel(
+            "127.0.0.1:" + std::to_string(transport_->port()), grpc::InsecureChannelCredentials()));
+    }
+
+    void TearDown() override {
+        transport_.reset();
+        request_handler_.reset();
+        for (const auto& backend : backends_) {
+            backend->Shutdown();
+        }
+        // The fake services are members of the test and go first
+        backends_.clear();
+    }
+
+    common::InfrastructureConfig config_;
+    std::vector<std::unique_ptr<grpc::Server>> backends_;
+    std::unique_ptr<api::RequestHandler> request_handler_;
+    std::unique_ptr<api::GrpcTransport> transport_;
+    std::unique_ptr<::core::v1::CoreService::Stub> stub_;
+};
@@ -9,6 +9,7 @@
 #include "api/IRequestHandler.h"
 #include "core/ICore.h"
 #include "common/types/CameraCapabilities.h"
+#include "infrastructure/clients/RawCall.h"
 
 using namespace service;
 using namespace testing;
@@ -25,21 +26,58 @@ public:
     MOCK_METHOD(Result<void>, start, (), (override));
     MOCK_METHOD(Result<void>, stop, (), (override));
     MOCK_METHOD(bool, isRunning, (), (const, override));
-    MOCK_METHOD(Result<void>, setZoom, (uint32_t, common::types::zoom), (const, override));
+    MOCK_METHOD(Result<common::types::zoom>, setZoom, (uint32_t, common::types::zoom), (const, override));
     MOCK_METHOD(Result<common::types::zoom>, getZoom, (uint32_t), (const, override));
-    MOCK_METHOD(Result<void>, setFocus, (uint32_t, common::types::focus), (const, override));
+    MOCK_METHOD(Result<common::types::focus>, setFocus, (uint32_t, common::types::focus), (const, override));
     MOCK_METHOD(Result<common::types::focus>, getFocus, (uint32_t), (const, override));
     MOCK_METHOD(Result<void>, enableAutoFocus, (uint32_t, bool), (const, override));
     MOCK_METHOD(Result<bool>, getAutoFocus, (uint32_t), (const, override));
+    MOCK_METHOD(Result<common::types::zoom>, stepZoom, (uint32_t, int32_t), (const, override));
+    MOCK_METHOD(Result<common::types::focus>, stepFocus, (uint32_t, int32_t), (const, override));
+    MOCK_METHOD(Result<void>, setZoomVelocity, (uint32_t, double, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<void>, setFocusVelocity, (uint32_t, double, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<common::types::Convergence>, setZoomAndWait,
+                (uint32_t, common::types::zoom, uint32_t, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<common::types::Convergence>, setFocusAndWait,
+                (uint32_t, common::types::focus, uint32_t, std::chrono::milliseconds), (const, override));
     MOCK_METHOD(Result<common::types::info>, getInfo, (uint32_t), (const, override));
-    MOCK_METHOD(Result<void>, goToMinZoom, (uint32_t), (const, override));
-    MOCK_METHOD(Result<void>, goToMaxZoom, (uint32_t), (const, override));
+    MOCK_METHOD(Result<common::types::zoom>, goToMinZoom, (uint32_t), (const, override));
+    MOCK_METHOD(Result<common::types::zoom>, goToMaxZoom, (uint32_t), (const, override));
     MOCK_METHOD(Result<void>, stabilize, (uint32_t, bool), (const, override));
     MOCK_METHOD(Result<bool>, getStabilization, (uint32_t), (const, override));
     MOCK_METHOD(Result<common::capabilities::CapabilityList>, getCapabilities, (uint32_t), (const, override));
     MOCK_METHOD(Result<void>, SetVideoCapabilityState, (uint32_t, const std::string&, bool), (const, override));
     MOCK_METHOD(Result<std::vector<std::string>>, getVideoCapabilities, (uint32_t), (const, override));
     MOCK_METHOD(Result<bool>, getVideoCapabilityState, (uint32_t, const std::string&), (const, override));
+    MOCK_METHOD(void, forwardCameraCall, (uint32_t, infrastructure::RawCall), (const, override));
+    MOCK_METHOD(Result<std::shared_ptr<common::state::CameraStateSubscription>>, watchCameraState,
+                (uint32_t, common::types::CameraStateFields), (const, override));
+    MOCK_METHOD(std::vector<common::types::OperationResult>, executeBatch,
+                (const std::vector<common::types::Operation>&, common::types::BatchOrdering), (const, override));
+    MOCK_METHOD(Result<common::types::ScheduledBatch>, executeBatchAt,
+                (const std::vector<common::types::Operation>&, common::types::BatchOrdering,
+                 const common::types::ExecuteAt&), (const, override));
+    MOCK_METHOD(Result<std::vector<common::types::CameraSnapshot>>, getSystemSnapshot,
+                (const std::vector<uint32_t>&, common::types::SnapshotFields), (const, override));
+    MOCK_METHOD(Result<common::types::VersionedValue>, getIfChanged,
+                (uint32_t, const common::types::StateField&, const common::types::ReadCondition&), (const, override));
+    MOCK_METHOD(Result<void>, savePreset, (const common::types::Preset&), (const, override));
+    MOCK_METHOD(Result<void>, deletePreset, (const std::string&), (const, override));
+    MOCK_METHOD(Result<std::vector<common::types::Preset>>, listPresets, (), (const, override));
+    MOCK_METHOD(Result<common::types::PresetRecall>, recallPreset,
+                (const std::vector<uint32_t>&, const std::string&), (const, override));
+    MOCK_METHOD(Result<std::shared_ptr<common::state::MacroExecution>>, runMacro,
+                (uint32_t, const common::types::Macro&), (const, override));
+    MOCK_METHOD(Result<std::shared_ptr<common::state::MacroExecution>>, runNamedMacro,
+                (uint32_t, const std::string&), (const, override));
+    MOCK_METHOD(Result<void>, cancelMacro, (uint32_t), (const, override));
+    MOCK_METHOD(Result<common::types::ControlLease>, acquireControl,
+                (uint32_t, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<common::types::ControlLease>, renewControl,
+                (uint32_t, uint64_t, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<void>, releaseControl, (uint32_t, uint64_t), (const, override));
+    MOCK_METHOD(Result<common::types::DispatchMetrics>, getDispatchMetrics, (), (const, override));
+    MOCK_METHOD(Result<common::types::ReconcileMetrics>, getReconcileStatus, (), (const, override));
 };
 
 class CoreMock: public core::ICore {
@@ -47,20 +85,56 @@ public:
     MOCK_METHOD(Result<void>, start, (), (override));
     MOCK_METHOD(Result<void>, stop, (), (override));
 
-    MOCK_METHOD(Result<void>, setZoom, (uint32_t, common::types::zoom), (const, override));
+    MOCK_METHOD(Result<common::types::zoom>, setZoom, (uint32_t, common::types::zoom), (const, override));
     MOCK_METHOD(Result<common::types::zoom>, getZoom, (uint32_t), (const, override));
-    MOCK_METHOD(Result<void>, goToMinZoom, (uint32_t), (const, override));
-    MOCK_METHOD(Result<void>, goToMaxZoom, (uint32_t), (const, override));
-    MOCK_METHOD(Result<void>, setFocus, (uint32_t, common::types::focus), (const, override));
+    MOCK_METHOD(Result<common::types::zoom>, goToMinZoom, (uint32_t), (const, override));
+    MOCK_METHOD(Result<common::types::zoom>, goToMaxZoom, (uint32_t), (const, override));
+    MOCK_METHOD(Result<common::types::focus>, setFocus, (uint32_t, common::types::focus), (const, override));
     MOCK_METHOD(Result<common::types::focus>, getFocus, (uint32_t), (const, override));
     MOCK_METHOD(Result<common::types::info>, getInfo, (uint32_t), (const, override));
     MOCK_METHOD(Result<void>, enableAutoFocus, (uint32_t, bool), (const, override));
     MOCK_METHOD(Result<bool>, getAutoFocus, (uint32_t), (const, override));
+    MOCK_METHOD(Result<common::types::zoom>, stepZoom, (uint32_t, int32_t), (const, override));
+    MOCK_METHOD(Result<common::types::focus>, stepFocus, (uint32_t, int32_t), (const, override));
+    MOCK_METHOD(Result<void>, setZoomVelocity, (uint32_t, double, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<void>, setFocusVelocity, (uint32_t, double, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<common::types::Convergence>, setZoomAndWait,
+                (uint32_t, common::types::zoom, uint32_t, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<common::types::Convergence>, setFocusAndWait,
+                (uint32_t, common::types::focus, uint32_t, std::chrono::milliseconds), (const, override));
     MOCK_METHOD(Result<void>, stabilize, (uint32_t, bool), (const, override));
     MOCK_METHOD(Result<bool>, getStabilization, (uint32_t), (const, override));
     MOCK_METHOD(Result<common::capabilities::CapabilityList>, getCapabilities, (uint32_t), (const, override));
     MOCK_METHOD(Result<void>, SetVideoCapabilityState, (uint32_t, const std::string&, bool), (const, override));
     MOCK_METHOD(Result<std::vector<std::string>>, getVideoCapabilities, (uint32_t), (const, override));
     MOCK_METHOD(Result<bool>, getVideoCapabilityState, (uint32_t, const std::string&), (const, override));
-
+    MOCK_METHOD(void, forwardCameraCall, (uint32_t, infrastructure::RawCall), (const, override));
+    MOCK_METHOD(Result<std::shared_ptr<common::state::CameraStateSubscription>>, watchCameraState,
+                (uint32_t, common::types::CameraStateFields), (const, override));
+    MOCK_METHOD(std::vector<common::types::OperationResult>, executeBatch,
+                (const std::vector<common::types::Operation>&, common::types::BatchOrdering), (const, override));
+    MOCK_METHOD(Result<common::types::ScheduledBatch>, executeBatchAt,
+                (const std::vector<common::types::Operation>&, common::types::BatchOrdering,
+                 const common::types::ExecuteAt&), (const, override));
+    MOCK_METHOD(Result<std::vector<common::types::CameraSnapshot>>, getSystemSnapshot,
+                (const std::vector<uint32_t>&, common::types::SnapshotFields), (const, override));
+    MOCK_METHOD(Result<common::types::VersionedValue>, getIfChanged,
+                (uint32_t, const common::types::StateField&, const common::types::ReadCondition&), (const, override));
+    MOCK_METHOD(Result<void>, savePreset, (const common::types::Preset&), (const, override));
+    MOCK_METHOD(Result<void>, deletePreset, (const std::string&), (const, override));
+    MOCK_METHOD(Result<std::vector<common::types::Preset>>, listPresets, (), (const, override));
+    MOCK_METHOD(Result<common::types::PresetRecall>, recallPreset,
+                (const std::vector<uint32_t>&, const std::string&), (const, override));
+    MOCK_METHOD(Result<std::shared_ptr<common::state::MacroExecution>>, runMacro,
+                (uint32_t, const common::types::Macro&), (const, override));
+    MOCK_METHOD(Result<std::shared_ptr<common::state::MacroExecution>>, runNamedMacro,
+                (uint32_t, const std::string&), (const, override));
+    MOCK_METHOD(Result<void>, cancelMacro, (uint32_t), (const, override));
+    MOCK_METHOD(Result<common::types::ControlLease>, acquireControl,
+                (uint32_t, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<common::types::ControlLease>, renewControl,
+                (uint32_t, uint64_t, std::chrono::milliseconds), (const, override));
+    MOCK_METHOD(Result<void>, releaseControl, (uint32_t, uint64_t), (const, override));
+    MOCK_METHOD(Result<common::types::DispatchMetrics>, getDispatchMetrics, (), (const, override));
+    MOCK_METHOD(Result<common::types::ReconcileMetrics>, getReconcileStatus, (), (const, override));
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <grpcpp/grpcpp.h>
+/* Add your project include files here */
+#include "api/ArenaMessageAllocator.h"
+#include "api/proto/camera_service.pb.h"
+#include "api/proto/core_service.grpc.pb.h"
+#include "common/memory/ReusableArena.h"
+
+using namespace testing;
+using namespace service;
+
+namespace {
+    std::atomic<std::size_t> g_allocations{0};
+
+    class InfoService final : public core::v1::CoreService::CallbackService {
+    public:
+        InfoService(std::string info, const bool arena) : info_(std::move(info)) {
+            if (arena) {
+                SetMessageAllocatorFor_GetInfo(&allocator_);
+            }
+        }
+
+        grpc::ServerUnaryReactor* GetInfo(grpc::CallbackServerContext* context, const core::v1::GetInfoRequest*,
+                                          core::v1::GetInfoResponse* response) override {
+            response->set_info(info_);
+            auto* const reactor = context->DefaultReactor();
+            reactor->Finish(grpc::Status::OK);
+            return reactor;
+        }
+
+    private:
+        std::string info_;
+        api::ArenaMessageAllocator<core::v1::GetInfoRequest, core::v1::GetInfoResponse> allocator_;
+    };
+} // unnamed namespace
+
+void* operator new(const std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* const memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+/**
+ * Counts heap allocations per request, comparing plain heap messages with the arena-backed paths,
+ * both for the message handling alone and for a whole unary call through an in-process server
+ * Only the message handling is asserted on, it runs on the test thread alone
+ */
+class ArenaAllocationBenchmark : public Test {
+protected:
+    static constexpr int ITERATIONS = 1000;
+    static constexpr auto INFO = "frontier camera module, firmware 4.2.1, serial FR-000000000042, build 2024-05-01";
+
+    void SetUp() override {
+        core::v1::GetInfoRequest request;
+        request.set_camera_id(2);
+        wire_request_ = request.SerializeAsString();
+
+        camera::v1::GetInfoResponse backend_response;
+        backend_response.set_info(INFO);
+        wire_backend_response_ = backend_response.SerializeAsString();
+    }
+
+    template<typename Body>
+    static double allocationsPerRequest(Body body) {
+        body(); // warm-up, fills free lists and thread-local arenas
+        const auto before = g_allocations.load();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            body();
+        }
+        return static_cast<double>(g_allocations.load() - before) / ITERATIONS;
+    }
+
+    static void report(const std::string& path, const double heap, const double arena) {
+        std::cout << "[ALLOCATIONS] " << path << ": heap " << heap << " -> arena " << arena << " per request\n";
+    }
+
+    std::string wire_request_;
+    std::string wire_backend_response_;
+    char output_[256]{};
+};
+
+TEST_F(ArenaAllocationBenchmark, ServerMessages) {
+    const auto heap = allocationsPerRequest([this] {
+        const auto request = std::make_unique<core::v1::GetInfoRequest>();
+        const auto response = std::make_unique<core::v1::GetInfoResponse>();
+        ASSERT_TRUE(request->ParseFromString(wire_request_));
+        response->set_info(INFO);
+        ASSERT_TRUE(response->SerializeToArray(output_, sizeof(output_)));
+    });
+
+    api::ArenaMessageAllocator<core::v1::GetInfoRequest, core::v1::GetInfoResponse> allocator;
+    const auto arena = allocationsPerRequest([this, &allocator] {
+        auto* const holder = allocator.AllocateMessages();
+        ASSERT_TRUE(holder->request()->ParseFromString(wire_request_));
+        holder->response()->set_info(INFO);
+        ASSERT_TRUE(holder->response()->SerializeToArray(output_, sizeof(output_)));
+        holder->Release();
+    });
+
+    report("CoreService.GetInfo", heap, arena);
+    EXPECT_LT(arena, heap);
+}
+
+TEST_F(ArenaAllocationBenchmark, BackendClientMessages) {
+    const auto heap = allocationsPerRequest([this] {
+        camera::v1::GetInfoResponse response;
+        ASSERT_TRUE(response.ParseFromString(wire_backend_response_));
+        ASSERT_FALSE(response.info().empty());
+    });
+
+    const auto arena = allocationsPerRequest([this] {
+        auto* const response = common::memory::threadLocalArena().create<camera::v1::GetInfoResponse>();
+        ASSERT_TRUE(response->ParseFromString(wire_backend_response_));
+        ASSERT_FALSE(response->info().empty());
+    });
+
+    report("camera_service.GetInfo", heap, arena);
+    EXPECT_LT(arena, heap);
+}
+
+TEST_F(ArenaAllocationBenchmark, UnaryRoundTrip) {
+    const auto allocationsPerCall = [](const bool arena) {
+        InfoService service(INFO, arena);
+        grpc::ServerBuilder builder;
+        int port = 0;
+        builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+        builder.RegisterService(&service);
+        const auto server = builder.BuildAndStart();
+        EXPECT_NE(nullptr, server);
+
+        const auto stub = core::v1::CoreService::NewStub(
+            grpc::CreateChannel("127.0.0.1:" + std::to_string(port), grpc::InsecureChannelCredentials()));
+        core::v1::GetInfoRequest request;
+        request.set_camera_id(2);
+        const auto per_call = allocationsPerRequest([&stub, &request] {
+            grpc::ClientContext context;
+            core::v1::GetInfoResponse response;
+            ASSERT_TRUE(stub->GetInfo(&context, request, &response).ok());
+        });
+
+        server->Shutdown();
+        return per_call;
+    };
+
+    const auto heap = allocationsPerCall(false);
+    const auto arena = allocationsPerCall(true);
+
+    // Reported only, the counter also sees the gRPC server, client and timer threads, whose allocations outweigh
+    // the messages and vary from run to run
+    report("CoreService.GetInfo round trip", heap, arena);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <iostream>
+#include <streambuf>
+#include <string_view>
+/* Add your project include files here */
+#include "api/RequestHandler.h"
+#include "common/logger/Logger.h"
+#include "../Mocks.h"
+
+namespace {
+    /**
+     * Swallows the log lines, the benchmark measures formatting them, not the terminal
+     */
+    class NullBuffer final : public std::streambuf {
+    protected:
+        int overflow(const int character) override {
+            return character;
+        }
+    };
+
+    /**
+     * Core answering at once, so a call costs only what RequestHandler adds
+     */
+    class StubCore : public CoreMock {
+    public:
+        Result<common::types::zoom> setZoom(uint32_t, const common::types::zoom zoom_level) const override {
+            return Result<common::types::zoom>::success(zoom_level);
+        }
+
+        Result<common::types::zoom> getZoom(uint32_t) const override {
+            return Result<common::types::zoom>::success(40u);
+        }
+    };
+
+    /**
+     * A request written out by hand the way RequestHandler did before its operation table, logging the same lines
+     * at the same level, the reference the table is measured against
+     */
+    template<typename T, typename... Args>
+    Result<T> handWritten(const core::ICore& core, const bool running, Result<T> (core::ICore::*call)(Args...) const,
+                          const LoggerInterface::LogLevel level, const std::string_view request, Args... args) {
+        if (!running) {
+            return Result<T>::error("RequestHandler is not running");
+        }
+
+        if (level == LoggerInterface::LogLevel::Debug) {
+            LOG_DEBUG(request, args...);
+        } else {
+            LOG_INFO(request, args...);
+        }
+
+        auto operation = (core.*call)(args...);
+
+        if (operation.isError()) {
+            LOG_ERROR("Response: {}", operation.error().message);
+        } else if (level == LoggerInterface::LogLevel::Debug) {
+            LOG_DEBUG("Response: {}", operation.value());
+        } else {
+            LOG_INFO("Response: {}", operation.value());
+        }
+        return operation;
+    }
+} // unnamed namespace
+
+/**
+ * Time per call through RequestHandler over a core that answers at once, at the default info level
+ * Each call is also timed through a hand-written copy of the request, as RequestHandler wrote them before the
+ * operation table, so the table is measured against the code it replaced
+ */
+class RequestHandlerBenchmark : public Test {
+protected:
+    static constexpr int ITERATIONS = 100000;
+
+    void SetUp() override {
+        request_handler_ = std::make_unique<api::RequestHandler>(std::make_unique<NiceMock<StubCore>>());
+        ASSERT_TRUE(request_handler_->start().isSuccess());
+        console_ = std::cout.rdbuf(&null_buffer_);
+    }
+
+    void TearDown() override {
+        std::cout.rdbuf(console_);
+    }
+
+    template<typename Body>
+    static double nanosecondsPerCall(Body body) {
+        body(); // warm-up
+        const auto started = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            body();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - started;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / ITERATIONS;
+    }
+
+    static void report(const std::string& call, const double hand_written, const double table) {
+        std::cerr << "[LATENCY] " << call << ": hand-written " << hand_written << " -> operation table " << table
+                  << " ns per call\n";
+    }
+
+    std::unique_ptr<api::RequestHandler> request_handler_;
+    std::unique_ptr<core::ICore> reference_core_ = std::make_unique<NiceMock<StubCore>>(); // held as the handler holds it
+    NullBuffer null_buffer_;
+    std::streambuf* console_{nullptr};
+};
+
+TEST_F(RequestHandlerBenchmark, PolledRead) {
+    const auto hand_written = nanosecondsPerCall([this] {
+        ASSERT_TRUE(handWritten(*reference_core_, true, &core::ICore::getZoom, LoggerInterface::LogLevel::Debug,
+                                "Request: getZoom camera_id={}", 2u)
+                        .isSuccess());
+    });
+    const auto table = nanosecondsPerCall([this] {
+        ASSERT_TRUE(request_handler_->getZoom(2).isSuccess());
+    });
+
+    report("getZoom", hand_written, table);
+}
+
+TEST_F(RequestHandlerBenchmark, Command) {
+    const auto hand_written = nanosecondsPerCall([this] {
+        ASSERT_TRUE(handWritten(*reference_core_, true, &core::ICore::setZoom, LoggerInterface::LogLevel::Info,
+                                "Request: setZoom camera_id={} zoom={}", 2u, common::types::zoom{40})
+                        .isSuccess());
+    });
+    const auto table = nanosecondsPerCall([this] {
+        ASSERT_TRUE(request_handler_->setZoom(2, 40).isSuccess());
+    });
+
+    report("setZoom", hand_written, table);
+}
@@ -17,7 +17,7 @@ protected:
 TEST_F(NetworkUtilsTest, GetNetworkInterfaces_ReturnsNonEmptyList) {
     auto result = getNetworkInterfaces();
 
-    ASSERT_TRUE(result.isSuccess()) << "Failed to get network interfaces: " << result.error();
+    ASSERT_TRUE(result.isSuccess()) << "Failed to get network interfaces: " << result.error().message;
     EXPECT_FALSE(result.value().empty()) << "Expected at least one network interface";
 }
 
@@ -59,7 +59,7 @@ TEST_F(NetworkUtilsTest, GetNetworkInterfaces_ValidIpAddresses) {
 TEST_F(NetworkUtilsTest, GetPrimaryIpAddress_ReturnsValidIp) {
     auto result = getPrimaryIpAddress();
 
-    ASSERT_TRUE(result.isSuccess()) << "Failed to get primary IP: " << result.error();
+    ASSERT_TRUE(result.isSuccess()) << "Failed to get primary IP: " << result.error().message;
 
     const auto& ip = result.value();
     EXPECT_FALSE(ip.empty());
@@ -132,14 +132,14 @@ TEST_F(NetworkUtilsTest, GetIpAddress_WithInvalidInterface) {
     auto result = getIpAddress("nonexistent_interface_xyz");
 
     ASSERT_TRUE(result.isError());
-    EXPECT_NE(result.error().find("not found"), std::string::npos);
+    EXPECT_NE(result.error().message.find("not found"), std::string::npos);
 }
 
 TEST_F(NetworkUtilsTest, GetIpAddress_WithEmptyInterfaceName) {
     auto result = getIpAddress("");
 
     ASSERT_TRUE(result.isError());
-    EXPECT_NE(result.error().find("empty"), std::string::npos);
+    EXPECT_NE(result.error().message.find("empty"), std::string::npos);
 }
 
 TEST_F(NetworkUtilsTest, NetworkInterface_HasAllFields) {
@@ -206,3 +206,23 @@ TEST_F(NetworkUtilsTest, InterfacePriority_EthBeforeWlan) {
     }
 }
 
+
+TEST_F(NetworkUtilsTest, ResolveIpv4Address_Localhost) {
+    auto result = resolveIpv4Address("localhost");
+
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_TRUE(isIpv4Address(result.value()));
+}
+
+TEST_F(NetworkUtilsTest, ResolveIpv4Address_WithEmptyHost) {
+    auto result = resolveIpv4Address("");
+
+    ASSERT_TRUE(result.isError());
+    EXPECT_NE(result.error().message.find("empty"), std::string::npos);
+}
+
+TEST_F(NetworkUtilsTest, IsIpv4Address_RejectsHostNames) {
+    EXPECT_TRUE(isIpv4Address("192.168.1.10"));
+    EXPECT_FALSE(isIpv4Address("camera.local"));
+    EXPECT_FALSE(isIpv4Address("192.168.1"));
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <thread>
+/* Add your project include files here */
+#include "api/CallerQuotas.h"
+
+using namespace testing;
+using namespace service;
+
+class CallerQuotasTests : public Test {
+protected:
+    void SetUp() override {
+        config_.defaults = {.rate_hz = 0};
+        config_.callers.push_back({.caller = "poller", .rate_hz = 100, .burst = 3});
+    }
+
+    common::QuotasConfig config_;
+};
+
+TEST_F(CallerQuotasTests, CallersWithoutAQuotaAreUnlimited) {
+    api::CallerQuotas quotas(config_);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_FALSE(quotas.acquire("hmi"));
+    }
+    EXPECT_TRUE(quotas.throttled().empty());
+}
+
+TEST_F(CallerQuotasTests, BurstIsAllowedThenCallsAreThrottled) {
+    api::CallerQuotas quotas(config_);
+
+    EXPECT_FALSE(quotas.acquire("poller"));
+    EXPECT_FALSE(quotas.acquire("poller"));
+    EXPECT_FALSE(quotas.acquire("poller"));
+    const auto retry_after = quotas.acquire("poller");
+
+    ASSERT_TRUE(retry_after);
+    EXPECT_GE(*retry_after, std::chrono::milliseconds(1));
+    EXPECT_LE(*retry_after, std::chrono::milliseconds(10));
+    EXPECT_THAT(quotas.throttled(), ElementsAre(Pair("poller", 1u)));
+}
+
+TEST_F(CallerQuotasTests, QuotaRefillsAtItsRate) {
+    api::CallerQuotas quotas(config_);
+    for (int i = 0; i < 3; ++i) {
+        quotas.acquire("poller");
+    }
+    ASSERT_TRUE(quotas.acquire("poller"));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+
+    EXPECT_FALSE(quotas.acquire("poller"));
+    EXPECT_FALSE(quotas.acquire("poller"));
+}
+
+TEST_F(CallerQuotasTests, EveryCallerHasItsOwnDefaultBucket) {
+    config_.defaults = {.rate_hz = 1, .burst = 1};
+    api::CallerQuotas quotas(config_);
+
+    EXPECT_FALSE(quotas.acquire("ipv4:10.0.0.5"));
+    EXPECT_FALSE(quotas.acquire("ipv4:10.0.0.6"));
+    EXPECT_TRUE(quotas.acquire("ipv4:10.0.0.5"));
+}
+
+TEST_F(CallerQuotasTests, NewClientIdsInheritTheBucketOfTheirHost) {
+    config_.defaults = {.rate_hz = 1, .burst = 2};
+    api::CallerQuotas quotas(config_);
+
+    EXPECT_FALSE(quotas.acquire("client-1", "ipv4:10.0.0.5"));
+    EXPECT_FALSE(quotas.acquire("client-2", "ipv4:10.0.0.5"));
+    EXPECT_TRUE(quotas.acquire("client-3", "ipv4:10.0.0.5"));
+    EXPECT_FALSE(quotas.acquire("client-4", "ipv4:10.0.0.6"));
+}
+
+TEST_F(CallerQuotasTests, CallersPastTheCapShareOneBucket) {
+    config_.defaults = {.rate_hz = 1, .burst = 1};
+    config_.max_callers = 2;
+    api::CallerQuotas quotas(config_);
+
+    EXPECT_FALSE(quotas.acquire("ipv4:10.0.0.5"));
+    EXPECT_FALSE(quotas.acquire("ipv4:10.0.0.6"));
+    EXPECT_FALSE(quotas.acquire("ipv4:10.0.0.7"));
+    EXPECT_TRUE(quotas.acquire("ipv4:10.0.0.8"));
+
+    EXPECT_THAT(quotas.throttled(), ElementsAre(Pair("(other)", 1u)));
+}
+
+TEST_F(CallerQuotasTests, IdleBucketsAreDropped) {
+    config_.defaults = {.rate_hz = 1, .burst = 1};
+    config_.max_callers = 1;
+    config_.idle_timeout = std::chrono::milliseconds(20);
+    api::CallerQuotas quotas(config_);
+    EXPECT_FALSE(quotas.acquire("ipv4:10.0.0.5"));
+    ASSERT_TRUE(quotas.acquire("ipv4:10.0.0.5"));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    EXPECT_FALSE(quotas.acquire("ipv4:10.0.0.6"));
+    EXPECT_TRUE(quotas.throttled().empty());
+}
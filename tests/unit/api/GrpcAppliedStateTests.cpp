@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+namespace {
+    constexpr uint32_t MAX_OPTICAL_ZOOM = 80;
+
+    /**
+     * Camera 0 reports applied values and clamps zoom, camera 1 is a backend that reports nothing
+     */
+    class AppliedStateCameraService final : public FakeCameraService {
+    public:
+        explicit AppliedStateCameraService(const bool reports_applied) : reports_applied_(reports_applied) {
+            zoom = 10;
+        }
+
+        grpc::Status SetZoom(grpc::ServerContext*, const camera::v1::SetZoomRequest* request,
+                             camera::v1::SetZoomResponse* response) override {
+            ++set_zoom_calls;
+            if (reports_applied_) {
+                response->set_zoom(std::min(request->zoom(), MAX_OPTICAL_ZOOM));
+            }
+            return grpc::Status::OK;
+        }
+
+        grpc::Status GoToMaxZoom(grpc::ServerContext*, const google::protobuf::Empty*,
+                                 camera::v1::GoToMaxZoomResponse* response) override {
+            ++go_to_max_zoom_calls;
+            if (reports_applied_) {
+                response->set_zoom(MAX_OPTICAL_ZOOM);
+            }
+            return grpc::Status::OK;
+        }
+
+        grpc::Status SetFocus(grpc::ServerContext*, const camera::v1::SetFocusRequest* request,
+                              camera::v1::SetFocusResponse* response) override {
+            if (reports_applied_) {
+                response->set_focus(request->focus() + 1);
+            }
+            return grpc::Status::OK;
+        }
+
+        std::atomic<int> go_to_max_zoom_calls{0};
+
+    private:
+        const bool reports_applied_;
+    };
+} // unnamed namespace
+
+class GrpcAppliedStateTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        for (uint32_t camera_id = 0; camera_id < 2; ++camera_id) {
+            ASSERT_NO_FATAL_FAILURE(addBackend(camera_id, camera_services_[camera_id]));
+        }
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd());
+    }
+
+    ::core::v1::SetZoomResponse setZoom(const uint32_t camera_id, const uint32_t zoom) const {
+        grpc::ClientContext context;
+        ::core::v1::SetZoomRequest request;
+        request.set_camera_id(camera_id);
+        request.set_zoom(zoom);
+        ::core::v1::SetZoomResponse response;
+        EXPECT_TRUE(stub_->SetZoom(&context, request, &response).ok());
+        return response;
+    }
+
+    AppliedStateCameraService camera_services_[2] = {AppliedStateCameraService(true),
+                                                     AppliedStateCameraService(false)};
+};
+
+TEST_F(GrpcAppliedStateTests, SetReturnsClampedValue) {
+    EXPECT_EQ(setZoom(0, 95).zoom(), MAX_OPTICAL_ZOOM);
+
+    grpc::ClientContext context;
+    ::core::v1::SetFocusRequest request;
+    request.set_camera_id(0);
+    request.set_focus(40);
+    ::core::v1::SetFocusResponse response;
+    ASSERT_TRUE(stub_->SetFocus(&context, request, &response).ok());
+    EXPECT_EQ(response.focus(), 41u);
+}
+
+TEST_F(GrpcAppliedStateTests, SetEchoesRequestWhenBackendReportsNothing) {
+    EXPECT_EQ(setZoom(1, 95).zoom(), 95u);
+}
+
+TEST_F(GrpcAppliedStateTests, GoToMaxZoomUsesNativeBackendCall) {
+    grpc::ClientContext context;
+    ::core::v1::GoToMaxZoomRequest request;
+    request.set_camera_id(0);
+    ::core::v1::GoToMaxZoomResponse response;
+    ASSERT_TRUE(stub_->GoToMaxZoom(&context, request, &response).ok());
+
+    EXPECT_EQ(response.zoom(), MAX_OPTICAL_ZOOM);
+    EXPECT_EQ(camera_services_[0].go_to_max_zoom_calls.load(), 1);
+    EXPECT_EQ(camera_services_[0].set_zoom_calls.load(), 0);
+}
+
+TEST_F(GrpcAppliedStateTests, AppliedValueFeedsWatchedState) {
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    ::core::v1::WatchCameraStateRequest request;
+    request.set_camera_id(0);
+    request.mutable_fields()->add_paths("zoom");
+    const auto reader = stub_->WatchCameraState(&context, request);
+
+    ::core::v1::CameraStateUpdate update;
+    ASSERT_TRUE(reader->Read(&update));
+    EXPECT_EQ(update.zoom(), 10u);
+
+    setZoom(0, 95);
+    ASSERT_TRUE(reader->Read(&update));
+    EXPECT_EQ(update.zoom(), MAX_OPTICAL_ZOOM);
+
+    context.TryCancel();
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <thread>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+class GrpcConditionalGetTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        camera_service_.zoom = 10;
+        camera_service_.focus = 30;
+        ASSERT_NO_FATAL_FAILURE(addBackend(0, camera_service_, &video_service_));
+
+        common::CoreConfig core_config;
+        core_config.state_hub.poll_min = std::chrono::milliseconds(20);
+        core_config.state_hub.poll_max = std::chrono::milliseconds(80);
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config));
+    }
+
+    ::core::v1::GetZoomResponse getZoom(const std::optional<uint64_t> if_generation_not = std::nullopt,
+                                        const uint32_t wait_ms = 0) const {
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+        ::core::v1::GetZoomRequest request;
+        request.set_camera_id(0);
+        if (if_generation_not) {
+            request.set_if_generation_not(*if_generation_not);
+        }
+        request.set_wait_ms(wait_ms);
+        ::core::v1::GetZoomResponse response;
+        EXPECT_TRUE(stub_->GetZoom(&context, request, &response).ok());
+        return response;
+    }
+
+    FakeCameraService camera_service_;
+    FakeVideoService video_service_;
+};
+
+TEST_F(GrpcConditionalGetTests, UnchangedGenerationIsNotModified) {
+    const auto first = getZoom();
+    EXPECT_EQ(first.zoom(), 10u);
+    EXPECT_FALSE(first.not_modified());
+    EXPECT_GT(first.generation(), 0u);
+
+    const auto second = getZoom(first.generation());
+    EXPECT_TRUE(second.not_modified());
+    EXPECT_EQ(second.generation(), first.generation());
+
+    camera_service_.zoom = 40;
+    const auto third = getZoom(first.generation());
+    EXPECT_FALSE(third.not_modified());
+    EXPECT_EQ(third.zoom(), 40u);
+    EXPECT_NE(third.generation(), first.generation());
+}
+
+TEST_F(GrpcConditionalGetTests, LongPollReturnsOnSet) {
+    const auto generation = getZoom().generation();
+
+    std::jthread setter([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        grpc::ClientContext context;
+        ::core::v1::SetZoomRequest request;
+        request.set_camera_id(0);
+        request.set_zoom(70);
+        ::core::v1::SetZoomResponse response;
+        EXPECT_TRUE(stub_->SetZoom(&context, request, &response).ok());
+    });
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto response = getZoom(generation, 3000);
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(1000));
+    EXPECT_FALSE(response.not_modified());
+    EXPECT_EQ(response.zoom(), 70u);
+}
+
+TEST_F(GrpcConditionalGetTests, LongPollSeesOutOfBandChange) {
+    const auto generation = getZoom().generation();
+
+    std::jthread changer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        camera_service_.zoom = 55;
+    });
+
+    const auto response = getZoom(generation, 3000);
+    EXPECT_FALSE(response.not_modified());
+    EXPECT_EQ(response.zoom(), 55u);
+}
+
+TEST_F(GrpcConditionalGetTests, LongPollTimesOutNotModified) {
+    const auto generation = getZoom().generation();
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto response = getZoom(generation, 150);
+
+    EXPECT_GE(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(150));
+    EXPECT_TRUE(response.not_modified());
+    EXPECT_EQ(response.generation(), generation);
+}
+
+TEST_F(GrpcConditionalGetTests, VideoCapabilityStateLongPoll) {
+    grpc::ClientContext first_context;
+    ::core::v1::GetVideoCapabilityStateRequest request;
+    request.set_camera_id(0);
+    request.set_capability("hdr");
+    ::core::v1::GetVideoCapabilityStateResponse first;
+    ASSERT_TRUE(stub_->GetVideoCapabilityState(&first_context, request, &first).ok());
+    EXPECT_FALSE(first.enable());
+
+    std::jthread changer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        video_service_.hdr = true;
+    });
+
+    grpc::ClientContext context;
+    request.set_if_generation_not(first.generation());
+    request.set_wait_ms(3000);
+    ::core::v1::GetVideoCapabilityStateResponse response;
+    ASSERT_TRUE(stub_->GetVideoCapabilityState(&context, request, &response).ok());
+    EXPECT_FALSE(response.not_modified());
+    EXPECT_TRUE(response.enable());
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <thread>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+class GrpcControlLeaseTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(addBackend(CAMERA_ID, camera_service_));
+
+        common::CoreConfig core_config;
+        core_config.leases.default_ttl = std::chrono::milliseconds(5000);
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config));
+    }
+
+    ::core::v1::ControlLease acquire(const uint32_t ttl_ms) const {
+        grpc::ClientContext context;
+        ::core::v1::AcquireControlRequest request;
+        request.set_camera_id(CAMERA_ID);
+        request.set_ttl_ms(ttl_ms);
+        ::core::v1::ControlLease lease;
+        EXPECT_TRUE(stub_->AcquireControl(&context, request, &lease).ok());
+        return lease;
+    }
+
+    grpc::Status setZoom(const uint32_t zoom, const uint64_t lease_id = 0) const {
+        grpc::ClientContext context;
+        if (lease_id != 0) {
+            context.AddMetadata("x-control-lease", std::to_string(lease_id));
+        }
+        ::core::v1::SetZoomRequest request;
+        request.set_camera_id(CAMERA_ID);
+        request.set_zoom(zoom);
+        ::core::v1::SetZoomResponse response;
+        return stub_->SetZoom(&context, request, &response);
+    }
+
+    /**
+     * SetZoom as the only operation of an ExecuteBatch
+     * @return status of the operation
+     */
+    grpc::StatusCode batchSetZoom(const uint32_t zoom, const uint64_t lease_id = 0) const {
+        grpc::ClientContext context;
+        if (lease_id != 0) {
+            context.AddMetadata("x-control-lease", std::to_string(lease_id));
+        }
+        ::core::v1::ExecuteBatchRequest request;
+        auto* const set_zoom = request.add_operations()->mutable_set_zoom();
+        set_zoom->set_camera_id(CAMERA_ID);
+        set_zoom->set_zoom(zoom);
+        ::core::v1::ExecuteBatchResponse response;
+        const auto status = stub_->ExecuteBatch(&context, request, &response);
+        EXPECT_TRUE(status.ok()) << status.error_message();
+        EXPECT_EQ(response.results_size(), 1);
+        return response.results_size() == 1 ? static_cast<grpc::StatusCode>(response.results(0).status_code())
+                                            : grpc::StatusCode::UNKNOWN;
+    }
+
+    static constexpr uint32_t CAMERA_ID = 0;
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcControlLeaseTests, RejectsCommandsOfOtherClientsWhileLeased) {
+    const auto lease = acquire(0);
+    ASSERT_NE(lease.lease_id(), 0u);
+    EXPECT_EQ(lease.ttl_ms(), 5000u);
+
+    EXPECT_EQ(setZoom(10).error_code(), grpc::StatusCode::FAILED_PRECONDITION);
+    EXPECT_EQ(setZoom(10, lease.lease_id() + 1).error_code(), grpc::StatusCode::FAILED_PRECONDITION);
+    EXPECT_EQ(camera_service_.set_zoom_calls.load(), 0);
+
+    EXPECT_TRUE(setZoom(20, lease.lease_id()).ok());
+    EXPECT_EQ(camera_service_.set_zoom_calls.load(), 1);
+}
+
+TEST_F(GrpcControlLeaseTests, ReleaseFreesTheCamera) {
+    const auto lease = acquire(0);
+
+    grpc::ClientContext context;
+    ::core::v1::ReleaseControlRequest request;
+    request.set_camera_id(CAMERA_ID);
+    request.set_lease_id(lease.lease_id());
+    google::protobuf::Empty response;
+    ASSERT_TRUE(stub_->ReleaseControl(&context, request, &response).ok());
+
+    EXPECT_TRUE(setZoom(10).ok());
+}
+
+TEST_F(GrpcControlLeaseTests, LeaseExpiresUnlessRenewed) {
+    const auto lease = acquire(100);
+
+    {
+        grpc::ClientContext context;
+        ::core::v1::RenewControlRequest request;
+        request.set_camera_id(CAMERA_ID);
+        request.set_lease_id(lease.lease_id());
+        request.set_ttl_ms(100);
+        ::core::v1::ControlLease renewed;
+        ASSERT_TRUE(stub_->RenewControl(&context, request, &renewed).ok());
+        EXPECT_EQ(renewed.lease_id(), lease.lease_id());
+    }
+    EXPECT_FALSE(setZoom(10).ok());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    EXPECT_TRUE(setZoom(10).ok());
+}
+
+TEST_F(GrpcControlLeaseTests, BatchOfTheHolderRunsUnderItsLease) {
+    const auto lease = acquire(0);
+
+    EXPECT_EQ(batchSetZoom(10), grpc::StatusCode::FAILED_PRECONDITION);
+    EXPECT_EQ(camera_service_.set_zoom_calls.load(), 0);
+
+    EXPECT_EQ(batchSetZoom(20, lease.lease_id()), grpc::StatusCode::OK);
+    EXPECT_EQ(camera_service_.set_zoom_calls.load(), 1);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+namespace {
+    class BusyFocusCameraService final : public FakeCameraService {
+    public:
+        grpc::Status SetFocus(grpc::ServerContext*, const camera::v1::SetFocusRequest*,
+                              camera::v1::SetFocusResponse*) override {
+            return {grpc::StatusCode::FAILED_PRECONDITION, "focus motor busy"};
+        }
+    };
+} // unnamed namespace
+
+class GrpcControlStreamTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(addBackend(0, camera_service_));
+
+        common::ControlStreamConfig control_stream;
+        control_stream.max_rate_hz = 10;
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd({}, false, control_stream));
+    }
+
+    static ::core::v1::ControlSetpoint zoomSetpoint(const uint32_t camera_id, const uint32_t zoom) {
+        ::core::v1::ControlSetpoint setpoint;
+        setpoint.set_camera_id(camera_id);
+        setpoint.set_zoom(zoom);
+        return setpoint;
+    }
+
+    BusyFocusCameraService camera_service_;
+};
+
+TEST_F(GrpcControlStreamTests, ConflatesSetpointsToNewestValue) {
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    const auto stream = stub_->ControlStream(&context);
+
+    for (uint32_t zoom = 1; zoom <= 50; ++zoom) {
+        ASSERT_TRUE(stream->Write(zoomSetpoint(0, zoom)));
+    }
+    ASSERT_TRUE(stream->WritesDone());
+
+    ::core::v1::ControlApplied applied;
+    ::core::v1::ControlApplied last_applied;
+    while (stream->Read(&applied)) {
+        last_applied = applied;
+    }
+
+    ASSERT_TRUE(stream->Finish().ok());
+    EXPECT_EQ(last_applied.zoom(), 50u);
+    EXPECT_EQ(camera_service_.zoom.load(), 50u);
+    EXPECT_LT(camera_service_.set_zoom_calls.load(), 50);
+}
+
+TEST_F(GrpcControlStreamTests, ForwardsAtMostConfiguredRate) {
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    const auto stream = stub_->ControlStream(&context);
+
+    // 10 Hz allows about 5 forwards within 500 ms of setpoints every 10 ms
+    for (uint32_t zoom = 1; zoom <= 50; ++zoom) {
+        ASSERT_TRUE(stream->Write(zoomSetpoint(0, zoom)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(stream->WritesDone());
+
+    ::core::v1::ControlApplied applied;
+    while (stream->Read(&applied)) {
+    }
+
+    ASSERT_TRUE(stream->Finish().ok());
+    EXPECT_GE(camera_service_.set_zoom_calls.load(), 3);
+    EXPECT_LE(camera_service_.set_zoom_calls.load(), 8);
+    EXPECT_EQ(camera_service_.zoom.load(), 50u);
+}
+
+TEST_F(GrpcControlStreamTests, ReportsRejectedSetpoint) {
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    const auto stream = stub_->ControlStream(&context);
+
+    ::core::v1::ControlSetpoint setpoint;
+    setpoint.set_camera_id(0);
+    setpoint.set_focus(40);
+    ASSERT_TRUE(stream->Write(setpoint));
+
+    ::core::v1::ControlApplied applied;
+    ASSERT_TRUE(stream->Read(&applied));
+    EXPECT_FALSE(applied.has_focus());
+    EXPECT_THAT(applied.error_message(), HasSubstr("focus motor busy"));
+
+    stream->WritesDone();
+    while (stream->Read(&applied)) {
+    }
+    EXPECT_TRUE(stream->Finish().ok());
+}
+
+TEST_F(GrpcControlStreamTests, RejectsSwitchingCamera) {
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    const auto stream = stub_->ControlStream(&context);
+
+    ASSERT_TRUE(stream->Write(zoomSetpoint(0, 10)));
+    stream->Write(zoomSetpoint(1, 20));
+    stream->WritesDone();
+
+    ::core::v1::ControlApplied applied;
+    while (stream->Read(&applied)) {
+    }
+    EXPECT_EQ(stream->Finish().error_code(), grpc::StatusCode::INVALID_ARGUMENT);
+}
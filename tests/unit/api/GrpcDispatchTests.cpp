@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <future>
+#include <thread>
+/* Add your project include files here */
+#include "api/CallMetadata.h"
+#include "../../GrpcFixture.h"
+
+class GrpcDispatchTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        camera_service_.zoom = 40;
+        ASSERT_NO_FATAL_FAILURE(addBackend(CAMERA_ID, camera_service_));
+
+        common::QuotasConfig quotas;
+        quotas.callers.push_back({.caller = LIMITED_CLIENT, .rate_hz = 1, .burst = 2});
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd({}, false, {}, quotas));
+    }
+
+    /**
+     * Admissions of a class, failing the test if GetDispatchMetrics fails
+     */
+    uint64_t admitted(const ::core::v1::PriorityClass priority) {
+        grpc::ClientContext context;
+        ::core::v1::DispatchMetricsResponse metrics;
+        const auto status = stub_->GetDispatchMetrics(&context, google::protobuf::Empty(), &metrics);
+        EXPECT_TRUE(status.ok()) << status.error_message();
+        for (const auto& entry : metrics.classes()) {
+            if (entry.priority() == priority) {
+                return entry.admitted();
+            }
+        }
+        ADD_FAILURE() << "No metrics for class " << priority;
+        return 0;
+    }
+
+    /**
+     * GetZoom as the given client
+     */
+    grpc::Status getZoomAs(grpc::ClientContext& context, const std::string& client_id) {
+        context.AddMetadata(api::CLIENT_ID_METADATA, client_id);
+        ::core::v1::GetZoomRequest request;
+        request.set_camera_id(CAMERA_ID);
+        ::core::v1::GetZoomResponse response;
+        return stub_->GetZoom(&context, request, &response);
+    }
+
+    static constexpr uint32_t CAMERA_ID = 0;
+    static constexpr auto LIMITED_CLIENT = "limited";
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcDispatchTests, CallsAreCountedUnderThePriorityOfTheirMetadata) {
+    const auto before = admitted(::core::v1::PRIORITY_CLASS_BACKGROUND);
+
+    grpc::ClientContext context;
+    context.AddMetadata(api::PRIORITY_METADATA, "background");
+    ::core::v1::GetZoomRequest request;
+    request.set_camera_id(CAMERA_ID);
+    ::core::v1::GetZoomResponse response;
+    ASSERT_TRUE(stub_->GetZoom(&context, request, &response).ok());
+
+    EXPECT_EQ(response.zoom(), 40u);
+    EXPECT_EQ(admitted(::core::v1::PRIORITY_CLASS_BACKGROUND), before + 1);
+}
+
+TEST_F(GrpcDispatchTests, BatchOperationsRunUnderThePriorityOfTheBatch) {
+    const auto before = admitted(::core::v1::PRIORITY_CLASS_BACKGROUND);
+
+    grpc::ClientContext context;
+    context.AddMetadata(api::PRIORITY_METADATA, "background");
+    ::core::v1::ExecuteBatchRequest request;
+    request.add_operations()->mutable_get_zoom()->set_camera_id(CAMERA_ID);
+    ::core::v1::ExecuteBatchResponse response;
+    ASSERT_TRUE(stub_->ExecuteBatch(&context, request, &response).ok());
+
+    ASSERT_EQ(response.results_size(), 1);
+    EXPECT_EQ(response.results(0).get_zoom().zoom(), 40u);
+    EXPECT_EQ(admitted(::core::v1::PRIORITY_CLASS_BACKGROUND), before + 1);
+}
+
+TEST_F(GrpcDispatchTests, ReportsEveryClass) {
+    grpc::ClientContext context;
+    ::core::v1::DispatchMetricsResponse metrics;
+    ASSERT_TRUE(stub_->GetDispatchMetrics(&context, google::protobuf::Empty(), &metrics).ok());
+
+    ASSERT_EQ(metrics.classes_size(), 3);
+    EXPECT_EQ(metrics.classes(0).priority(), ::core::v1::PRIORITY_CLASS_INTERACTIVE);
+    EXPECT_EQ(metrics.classes(2).priority(), ::core::v1::PRIORITY_CLASS_BACKGROUND);
+}
+
+TEST_F(GrpcDispatchTests, CallsOverTheCallerQuotaAreRejectedWithARetryHint) {
+    for (int i = 0; i < 2; ++i) {
+        grpc::ClientContext context;
+        ASSERT_TRUE(getZoomAs(context, LIMITED_CLIENT).ok());
+    }
+
+    grpc::ClientContext context;
+    const auto status = getZoomAs(context, LIMITED_CLIENT);
+
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::RESOURCE_EXHAUSTED);
+    const auto& trailers = context.GetServerTrailingMetadata();
+    const auto retry_after = trailers.find(api::RETRY_AFTER_METADATA);
+    ASSERT_NE(retry_after, trailers.end());
+    EXPECT_GT(std::stoi(std::string(retry_after->second.data(), retry_after->second.size())), 0);
+
+    grpc::ClientContext other_context;
+    EXPECT_TRUE(getZoomAs(other_context, "other").ok());
+}
+
+TEST_F(GrpcDispatchTests, BatchesAndSnapshotsCountAgainstTheCallerQuota) {
+    for (int i = 0; i < 2; ++i) {
+        grpc::ClientContext context;
+        context.AddMetadata(api::CLIENT_ID_METADATA, LIMITED_CLIENT);
+        ::core::v1::ExecuteBatchRequest request;
+        request.add_operations()->mutable_get_zoom()->set_camera_id(CAMERA_ID);
+        ::core::v1::ExecuteBatchResponse response;
+        ASSERT_TRUE(stub_->ExecuteBatch(&context, request, &response).ok());
+    }
+
+    grpc::ClientContext context;
+    context.AddMetadata(api::CLIENT_ID_METADATA, LIMITED_CLIENT);
+    ::core::v1::GetSystemSnapshotRequest request;
+    request.add_camera_ids(CAMERA_ID);
+    ::core::v1::GetSystemSnapshotResponse response;
+    const auto status = stub_->GetSystemSnapshot(&context, request, &response);
+
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::RESOURCE_EXHAUSTED);
+    const auto& trailers = context.GetServerTrailingMetadata();
+    EXPECT_NE(trailers.find(api::RETRY_AFTER_METADATA), trailers.end());
+}
+
+TEST_F(GrpcDispatchTests, ReportsCallsPerCaller) {
+    for (int i = 0; i < 3; ++i) {
+        grpc::ClientContext context;
+        getZoomAs(context, LIMITED_CLIENT);
+    }
+
+    grpc::ClientContext context;
+    ::core::v1::DispatchMetricsResponse metrics;
+    ASSERT_TRUE(stub_->GetDispatchMetrics(&context, google::protobuf::Empty(), &metrics).ok());
+
+    const auto limited = std::find_if(metrics.callers().begin(), metrics.callers().end(),
+                                      [](const auto& caller) { return caller.caller() == LIMITED_CLIENT; });
+    ASSERT_NE(limited, metrics.callers().end());
+    EXPECT_EQ(limited->admitted(), 2u);
+    EXPECT_EQ(limited->throttled(), 1u);
+}
+
+TEST_F(GrpcDispatchTests, WarmupIsReportedAsOffByDefault) {
+    grpc::ClientContext context;
+    ::core::v1::DispatchMetricsResponse metrics;
+    ASSERT_TRUE(stub_->GetDispatchMetrics(&context, google::protobuf::Empty(), &metrics).ok());
+
+    EXPECT_FALSE(metrics.warmup().enabled());
+}
+
+class GrpcWarmupMetricsTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(addBackend(0, camera_service_));
+        config_.warmup.enabled = true;
+        config_.warmup.min_ready_fraction = 1.0;
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd());
+    }
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcWarmupMetricsTests, ReportsBackendReadiness) {
+    grpc::ClientContext context;
+    ::core::v1::DispatchMetricsResponse metrics;
+    ASSERT_TRUE(stub_->GetDispatchMetrics(&context, google::protobuf::Empty(), &metrics).ok());
+
+    EXPECT_TRUE(metrics.warmup().enabled());
+    EXPECT_EQ(metrics.warmup().total(), 1u);
+    EXPECT_EQ(metrics.warmup().ready(), 1u);
+    EXPECT_TRUE(metrics.warmup().complete());
+}
+
+class GrpcLoadSheddingTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        camera_service_.command_delay = std::chrono::milliseconds(300);
+        ASSERT_NO_FATAL_FAILURE(addBackend(CAMERA_ID, camera_service_));
+
+        common::CoreConfig core_config;
+        core_config.dispatch.max_in_flight = 1;
+        core_config.dispatch.background_max_queued = 0;
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config));
+    }
+
+    static constexpr uint32_t CAMERA_ID = 0;
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcLoadSheddingTests, ShedCallsAreRejectedAsResourceExhausted) {
+    auto running = std::async(std::launch::async, [this] {
+        grpc::ClientContext context;
+        ::core::v1::SetZoomRequest request;
+        request.set_camera_id(CAMERA_ID);
+        request.set_zoom(10);
+        ::core::v1::SetZoomResponse response;
+        return stub_->SetZoom(&context, request, &response);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    grpc::ClientContext context;
+    context.AddMetadata(api::PRIORITY_METADATA, "background");
+    ::core::v1::GetZoomRequest request;
+    request.set_camera_id(CAMERA_ID);
+    ::core::v1::GetZoomResponse response;
+    const auto status = stub_->GetZoom(&context, request, &response);
+
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::RESOURCE_EXHAUSTED) << status.error_message();
+    EXPECT_TRUE(running.get().ok());
+}
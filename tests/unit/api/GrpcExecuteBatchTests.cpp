@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <future>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+namespace {
+    constexpr auto SET_ZOOM_DELAY = std::chrono::milliseconds(300);
+} // unnamed namespace
+
+class GrpcExecuteBatchTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        for (uint32_t camera_id = 0; camera_id < 2; ++camera_id) {
+            camera_services_[camera_id].command_delay = SET_ZOOM_DELAY;
+            ASSERT_NO_FATAL_FAILURE(addBackend(camera_id, camera_services_[camera_id]));
+        }
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd());
+    }
+
+    static void addSetZoom(::core::v1::ExecuteBatchRequest& request, const uint32_t camera_id, const uint32_t zoom) {
+        auto* const set_zoom = request.add_operations()->mutable_set_zoom();
+        set_zoom->set_camera_id(camera_id);
+        set_zoom->set_zoom(zoom);
+    }
+
+    static void addGetZoom(::core::v1::ExecuteBatchRequest& request, const uint32_t camera_id) {
+        request.add_operations()->mutable_get_zoom()->set_camera_id(camera_id);
+    }
+
+    FakeCameraService camera_services_[2];
+};
+
+TEST_F(GrpcExecuteBatchTests, RunsCamerasConcurrentlyAndKeepsOrderWithinCamera) {
+    ::core::v1::ExecuteBatchRequest request;
+    addSetZoom(request, 0, 20);
+    addSetZoom(request, 1, 30);
+    addGetZoom(request, 0);
+    addGetZoom(request, 1);
+
+    grpc::ClientContext context;
+    ::core::v1::ExecuteBatchResponse response;
+    const auto started = std::chrono::steady_clock::now();
+    ASSERT_TRUE(stub_->ExecuteBatch(&context, request, &response).ok());
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    // Both SetZoom calls overlap instead of adding up
+    EXPECT_LT(elapsed, 2 * SET_ZOOM_DELAY);
+    ASSERT_EQ(response.results_size(), 4);
+    for (const auto& result : response.results()) {
+        EXPECT_EQ(result.status_code(), grpc::StatusCode::OK);
+    }
+    EXPECT_TRUE(response.results(0).has_set_zoom());
+    EXPECT_EQ(response.results(2).get_zoom().zoom(), 20u);
+    EXPECT_EQ(response.results(3).get_zoom().zoom(), 30u);
+}
+
+TEST_F(GrpcExecuteBatchTests, SequentialOrderingRunsOneOperationAtATime) {
+    ::core::v1::ExecuteBatchRequest request;
+    request.set_ordering(::core::v1::BATCH_ORDERING_SEQUENTIAL);
+    addSetZoom(request, 0, 20);
+    addSetZoom(request, 1, 30);
+
+    grpc::ClientContext context;
+    ::core::v1::ExecuteBatchResponse response;
+    const auto started = std::chrono::steady_clock::now();
+    ASSERT_TRUE(stub_->ExecuteBatch(&context, request, &response).ok());
+
+    EXPECT_GE(std::chrono::steady_clock::now() - started, 2 * SET_ZOOM_DELAY);
+    EXPECT_EQ(response.results_size(), 2);
+}
+
+TEST_F(GrpcExecuteBatchTests, ReportsFailuresPerOperation) {
+    ::core::v1::ExecuteBatchRequest request;
+    addGetZoom(request, 7);
+    addGetZoom(request, 0);
+
+    grpc::ClientContext context;
+    ::core::v1::ExecuteBatchResponse response;
+    ASSERT_TRUE(stub_->ExecuteBatch(&context, request, &response).ok());
+
+    ASSERT_EQ(response.results_size(), 2);
+    EXPECT_EQ(response.results(0).status_code(), grpc::StatusCode::INTERNAL);
+    EXPECT_FALSE(response.results(0).error_message().empty());
+    EXPECT_EQ(response.results(1).status_code(), grpc::StatusCode::OK);
+    EXPECT_TRUE(response.results(1).has_get_zoom());
+}
+
+TEST_F(GrpcExecuteBatchTests, RejectsOperationWithoutCommand) {
+    ::core::v1::ExecuteBatchRequest request;
+    addGetZoom(request, 0);
+    request.add_operations();
+
+    grpc::ClientContext context;
+    ::core::v1::ExecuteBatchResponse response;
+    const auto status = stub_->ExecuteBatch(&context, request, &response);
+
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::INVALID_ARGUMENT);
+    EXPECT_THAT(status.error_message(), HasSubstr("Operation 1"));
+}
+
+TEST_F(GrpcExecuteBatchTests, ScheduledBatchStartsEveryCameraAtTheRequestedTime) {
+    ::core::v1::ExecuteBatchRequest request;
+    addGetZoom(request, 0);
+    addGetZoom(request, 1);
+    const auto execute_at = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    request.mutable_execute_at()->set_time_ns(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(execute_at.time_since_epoch()).count());
+
+    grpc::ClientContext context;
+    ::core::v1::ExecuteBatchResponse response;
+    ASSERT_TRUE(stub_->ExecuteBatch(&context, request, &response).ok());
+
+    EXPECT_GE(std::chrono::steady_clock::now(), execute_at);
+    ASSERT_EQ(response.results_size(), 2);
+    EXPECT_EQ(response.results(1).status_code(), grpc::StatusCode::OK);
+    ASSERT_EQ(response.dispatches_size(), 2);
+    for (const auto& dispatch : response.dispatches()) {
+        EXPECT_GE(dispatch.skew_us(), 0);
+        EXPECT_LT(dispatch.skew_us(), 5000);
+    }
+    EXPECT_EQ(response.dispatches(1).camera_id(), 1u);
+}
+
+TEST_F(GrpcExecuteBatchTests, ScheduledBatchHoldsNoThreadUntilItsTime) {
+    const auto execute_at = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    const common::types::ExecuteAt at{
+        .time = std::chrono::duration_cast<std::chrono::nanoseconds>(execute_at.time_since_epoch())};
+
+    std::promise<Result<common::types::ScheduledBatch>> done;
+    common::async::start(
+        request_handler_->executeBatchAtAsync({{.type = common::types::OperationType::GetZoom, .camera_id = 0}},
+                                              common::types::BatchOrdering::Parallel, at),
+        [&done](Result<common::types::ScheduledBatch> result) { done.set_value(std::move(result)); });
+
+    // Starting the batch returned while it waits for its time
+    EXPECT_LT(std::chrono::steady_clock::now(), execute_at);
+    auto batch = done.get_future();
+    ASSERT_EQ(batch.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_GE(std::chrono::steady_clock::now(), execute_at);
+    const auto result = batch.get();
+    ASSERT_TRUE(result.isSuccess());
+    ASSERT_EQ(result.value().results.size(), 1u);
+    EXPECT_TRUE(result.value().results[0].isSuccess());
+}
+
+TEST_F(GrpcExecuteBatchTests, RejectsDispatchTimeBeyondMaximumLead) {
+    ::core::v1::ExecuteBatchRequest request;
+    addGetZoom(request, 0);
+    const auto execute_at = std::chrono::system_clock::now() + std::chrono::minutes(10);
+    request.mutable_execute_at()->set_clock(::core::v1::SCHEDULE_CLOCK_REALTIME);
+    request.mutable_execute_at()->set_time_ns(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(execute_at.time_since_epoch()).count());
+
+    grpc::ClientContext context;
+    ::core::v1::ExecuteBatchResponse response;
+    const auto status = stub_->ExecuteBatch(&context, request, &response);
+
+    EXPECT_FALSE(status.ok());
+    EXPECT_THAT(status.error_message(), HasSubstr("ahead"));
+}
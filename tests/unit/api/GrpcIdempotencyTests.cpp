@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <future>
+#include <thread>
+/* Add your project include files here */
+#include "api/CallMetadata.h"
+#include "../../GrpcFixture.h"
+
+class GrpcIdempotencyTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        // A slow lens movement, long enough for a retry to arrive meanwhile
+        camera_service_.command_delay = std::chrono::milliseconds(100);
+        ASSERT_NO_FATAL_FAILURE(addBackend(CAMERA_ID, camera_service_));
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd());
+    }
+
+    /**
+     * SetZoom with an idempotency key, none if empty
+     */
+    grpc::Status setZoom(const uint32_t zoom, const std::string& key, ::core::v1::SetZoomResponse& response) {
+        grpc::ClientContext context;
+        if (!key.empty()) {
+            context.AddMetadata(api::IDEMPOTENCY_KEY_METADATA, key);
+        }
+        ::core::v1::SetZoomRequest request;
+        request.set_camera_id(CAMERA_ID);
+        request.set_zoom(zoom);
+        return stub_->SetZoom(&context, request, &response);
+    }
+
+    static constexpr uint32_t CAMERA_ID = 0;
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcIdempotencyTests, RetryOfACompletedSetIsNotSentAgain) {
+    ::core::v1::SetZoomResponse first;
+    ASSERT_TRUE(setZoom(40, "move-1", first).ok());
+
+    ::core::v1::SetZoomResponse retry;
+    const auto status = setZoom(40, "move-1", retry);
+
+    ASSERT_TRUE(status.ok()) << status.error_message();
+    EXPECT_EQ(retry.zoom(), first.zoom());
+    EXPECT_EQ(camera_service_.set_zoom_calls.load(), 1);
+}
+
+TEST_F(GrpcIdempotencyTests, RetryOfARunningSetAttachesToIt) {
+    auto first = std::async(std::launch::async, [this] {
+        ::core::v1::SetZoomResponse response;
+        return setZoom(40, "move-1", response).ok();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    ::core::v1::SetZoomResponse retry;
+    ASSERT_TRUE(setZoom(40, "move-1", retry).ok());
+
+    EXPECT_TRUE(first.get());
+    EXPECT_EQ(retry.zoom(), 40u);
+    EXPECT_EQ(camera_service_.set_zoom_calls.load(), 1);
+}
+
+TEST_F(GrpcIdempotencyTests, KeyReusedForAnotherZoomIsRejected) {
+    ::core::v1::SetZoomResponse response;
+    ASSERT_TRUE(setZoom(40, "move-1", response).ok());
+
+    const auto status = setZoom(60, "move-1", response);
+
+    EXPECT_FALSE(status.ok());
+    EXPECT_EQ(camera_service_.set_zoom_calls.load(), 1);
+}
+
+TEST_F(GrpcIdempotencyTests, SetsWithoutAKeyAlwaysRun) {
+    ::core::v1::SetZoomResponse response;
+    ASSERT_TRUE(setZoom(40, "", response).ok());
+    ASSERT_TRUE(setZoom(40, "", response).ok());
+
+    EXPECT_EQ(camera_service_.set_zoom_calls.load(), 2);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+class GrpcMacroTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(addBackend(CAMERA_ID, camera_service_));
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd());
+    }
+
+    /**
+     * Zoom to start, then count steps of delta each followed by a wait
+     */
+    static ::core::v1::RunMacroRequest sweep(const uint32_t start, const int32_t delta, const uint32_t count,
+                                             const std::chrono::microseconds wait) {
+        ::core::v1::RunMacroRequest request;
+        request.set_camera_id(CAMERA_ID);
+        auto* const macro = request.mutable_definition();
+        macro->set_name("sweep");
+        auto* const set_zoom = macro->add_steps()->mutable_operation()->mutable_set_zoom();
+        set_zoom->set_zoom(start);
+        auto* const repeat = macro->add_steps()->mutable_repeat();
+        repeat->set_count(count);
+        repeat->add_steps()->set_zoom_step(delta);
+        repeat->add_steps()->set_wait_us(static_cast<uint64_t>(wait.count()));
+        return request;
+    }
+
+    static constexpr uint32_t CAMERA_ID = 0;
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcMacroTests, StreamsEveryStepOfAnInlineMacro) {
+    grpc::ClientContext context;
+    auto reader = stub_->RunMacro(&context, sweep(10, 5, 3, std::chrono::milliseconds(10)));
+
+    std::vector<::core::v1::MacroProgress> progress;
+    ::core::v1::MacroProgress message;
+    while (reader->Read(&message)) {
+        progress.push_back(message);
+    }
+    const auto status = reader->Finish();
+
+    ASSERT_TRUE(status.ok()) << status.error_message();
+    ASSERT_EQ(progress.size(), 8u);
+    EXPECT_EQ(progress[0].value(), 10u);
+    EXPECT_THAT(progress[5].path(), ElementsAre(1u, 0u));
+    EXPECT_THAT(progress[5].iterations(), ElementsAre(2u));
+    EXPECT_EQ(progress[5].value(), 25u);
+    EXPECT_EQ(progress.back().status(), ::core::v1::MACRO_STATUS_COMPLETED);
+    EXPECT_GE(progress.back().elapsed_us(), 30000u);
+    EXPECT_EQ(camera_service_.zoom.load(), 25u);
+}
+
+TEST_F(GrpcMacroTests, CancelMacroStopsARunningMacro) {
+    grpc::ClientContext context;
+    auto reader = stub_->RunMacro(&context, sweep(10, 1, 100, std::chrono::seconds(1)));
+
+    ::core::v1::MacroProgress message;
+    ASSERT_TRUE(reader->Read(&message));
+
+    {
+        grpc::ClientContext second_context;
+        auto second = stub_->RunMacro(&second_context, sweep(50, 1, 1, std::chrono::microseconds(0)));
+        ::core::v1::MacroProgress second_message;
+        EXPECT_FALSE(second->Read(&second_message));
+        EXPECT_EQ(second->Finish().error_code(), grpc::StatusCode::INTERNAL);
+    }
+
+    grpc::ClientContext cancel_context;
+    ::core::v1::CancelMacroRequest cancel;
+    cancel.set_camera_id(CAMERA_ID);
+    google::protobuf::Empty empty;
+    ASSERT_TRUE(stub_->CancelMacro(&cancel_context, cancel, &empty).ok());
+
+    ::core::v1::MacroProgress last;
+    while (reader->Read(&message)) {
+        last = message;
+    }
+    EXPECT_TRUE(reader->Finish().ok());
+    EXPECT_EQ(last.status(), ::core::v1::MACRO_STATUS_CANCELLED);
+    EXPECT_LT(last.elapsed_us(), 1000000u);
+}
+
+TEST_F(GrpcMacroTests, RejectsUnknownNamedMacro) {
+    grpc::ClientContext context;
+    ::core::v1::RunMacroRequest request;
+    request.set_camera_id(CAMERA_ID);
+    request.set_name("missing");
+    auto reader = stub_->RunMacro(&context, request);
+
+    ::core::v1::MacroProgress message;
+    EXPECT_FALSE(reader->Read(&message));
+    EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::INTERNAL);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <thread>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+class GrpcMotionTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        camera_service_.zoom = 95;
+        camera_service_.focus = 3;
+        ASSERT_NO_FATAL_FAILURE(addBackend(0, camera_service_));
+
+        common::CoreConfig core_config;
+        core_config.motion.tick_hz = 50;
+        core_config.motion.max_duration = std::chrono::milliseconds(300);
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config));
+    }
+
+    grpc::Status zoomVelocity(const float velocity, const uint32_t duration_ms) const {
+        grpc::ClientContext context;
+        ::core::v1::ZoomVelocityRequest request;
+        request.set_camera_id(0);
+        request.set_velocity(velocity);
+        request.set_duration_ms(duration_ms);
+        google::protobuf::Empty response;
+        return stub_->ZoomVelocity(&context, request, &response);
+    }
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcMotionTests, StepsAreClampedToRange) {
+    grpc::ClientContext zoom_context;
+    ::core::v1::ZoomStepRequest zoom_request;
+    zoom_request.set_camera_id(0);
+    zoom_request.set_delta(10);
+    ::core::v1::ZoomStepResponse zoom_response;
+    ASSERT_TRUE(stub_->ZoomStep(&zoom_context, zoom_request, &zoom_response).ok());
+    EXPECT_EQ(zoom_response.zoom(), 100u);
+
+    grpc::ClientContext focus_context;
+    ::core::v1::FocusStepRequest focus_request;
+    focus_request.set_camera_id(0);
+    focus_request.set_delta(-5);
+    ::core::v1::FocusStepResponse focus_response;
+    ASSERT_TRUE(stub_->FocusStep(&focus_context, focus_request, &focus_response).ok());
+    EXPECT_EQ(focus_response.focus(), 0u);
+    EXPECT_EQ(camera_service_.focus.load(), 0u);
+}
+
+TEST_F(GrpcMotionTests, VelocityMovesUntilServerMaximumDuration) {
+    ASSERT_TRUE(zoomVelocity(-100.0f, 0).ok());
+
+    // Capped at the configured 300 ms, about 30 units down from 95
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    EXPECT_NEAR(camera_service_.zoom.load(), 65u, 5);
+    EXPECT_GT(camera_service_.set_zoom_calls.load(), 5);
+}
+
+TEST_F(GrpcMotionTests, AbsoluteSetStopsMotion) {
+    ASSERT_TRUE(zoomVelocity(-50.0f, 1000).ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    grpc::ClientContext context;
+    ::core::v1::SetZoomRequest request;
+    request.set_camera_id(0);
+    request.set_zoom(40);
+    ::core::v1::SetZoomResponse response;
+    ASSERT_TRUE(stub_->SetZoom(&context, request, &response).ok());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(camera_service_.zoom.load(), 40u);
+}
+
+TEST_F(GrpcMotionTests, RejectsUnknownCamera) {
+    grpc::ClientContext context;
+    ::core::v1::ZoomVelocityRequest request;
+    request.set_camera_id(7);
+    request.set_velocity(10.0f);
+    google::protobuf::Empty response;
+    EXPECT_FALSE(stub_->ZoomVelocity(&context, request, &response).ok());
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <thread>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+namespace {
+    class BusyFocusCameraService final : public FakeCameraService {
+    public:
+        grpc::Status GetFocus(grpc::ServerContext*, const google::protobuf::Empty*,
+                              camera::v1::GetFocusResponse*) override {
+            return {grpc::StatusCode::FAILED_PRECONDITION, "focus motor busy"};
+        }
+    };
+} // unnamed namespace
+
+class GrpcPassthroughTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        camera_service_.zoom = 42;
+        ASSERT_NO_FATAL_FAILURE(addBackend(2, camera_service_));
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd({}, true));
+    }
+
+    BusyFocusCameraService camera_service_;
+};
+
+TEST_F(GrpcPassthroughTests, SetRequestReachesBackend) {
+    ::core::v1::SetZoomRequest request;
+    request.set_camera_id(2);
+    request.set_zoom(37);
+    ::core::v1::SetZoomResponse response;
+    grpc::ClientContext context;
+
+    const auto status = stub_->SetZoom(&context, request, &response);
+
+    ASSERT_TRUE(status.ok()) << status.error_message();
+    EXPECT_EQ(camera_service_.zoom.load(), 37u);
+}
+
+TEST_F(GrpcPassthroughTests, BackendReplyIsRelayed) {
+    ::core::v1::GetZoomRequest request;
+    request.set_camera_id(2);
+    ::core::v1::GetZoomResponse response;
+    grpc::ClientContext context;
+
+    const auto status = stub_->GetZoom(&context, request, &response);
+
+    ASSERT_TRUE(status.ok()) << status.error_message();
+    EXPECT_EQ(response.zoom(), 42u);
+}
+
+TEST_F(GrpcPassthroughTests, BackendStatusIsRelayed) {
+    ::core::v1::GetFocusRequest request;
+    request.set_camera_id(2);
+    ::core::v1::GetFocusResponse response;
+    grpc::ClientContext context;
+
+    const auto status = stub_->GetFocus(&context, request, &response);
+
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::FAILED_PRECONDITION);
+    EXPECT_EQ(status.error_message(), "focus motor busy");
+}
+
+TEST_F(GrpcPassthroughTests, LeasedCameraRejectsOtherClientsLikeTheDecodedPath) {
+    {
+        grpc::ClientContext context;
+        ::core::v1::AcquireControlRequest request;
+        request.set_camera_id(2);
+        ::core::v1::ControlLease lease;
+        ASSERT_TRUE(stub_->AcquireControl(&context, request, &lease).ok());
+    }
+
+    ::core::v1::SetZoomRequest request;
+    request.set_camera_id(2);
+    request.set_zoom(37);
+    ::core::v1::SetZoomResponse response;
+    grpc::ClientContext context;
+
+    const auto status = stub_->SetZoom(&context, request, &response);
+
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::FAILED_PRECONDITION);
+    EXPECT_EQ(camera_service_.zoom.load(), 42u);
+}
+
+TEST_F(GrpcPassthroughTests, UnknownCameraIsRejected) {
+    ::core::v1::GetZoomRequest request;
+    request.set_camera_id(3);
+    ::core::v1::GetZoomResponse response;
+    grpc::ClientContext context;
+
+    const auto status = stub_->GetZoom(&context, request, &response);
+
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::UNAVAILABLE);
+}
+
+class GrpcPassthroughReconcileTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(addBackend(2, camera_service_));
+
+        common::CoreConfig core_config;
+        core_config.reconcile.enabled = true;
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config, true));
+    }
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcPassthroughReconcileTests, SetIsRecordedAsDesiredState) {
+    {
+        ::core::v1::SetZoomRequest request;
+        request.set_camera_id(2);
+        request.set_zoom(37);
+        ::core::v1::SetZoomResponse response;
+        grpc::ClientContext context;
+        ASSERT_TRUE(stub_->SetZoom(&context, request, &response).ok());
+    }
+    {
+        ::core::v1::SetStabilizationRequest request;
+        request.set_camera_id(2);
+        request.set_enable(true);
+        google::protobuf::Empty response;
+        grpc::ClientContext context;
+        ASSERT_TRUE(stub_->SetStabilization(&context, request, &response).ok());
+    }
+
+    grpc::ClientContext context;
+    ::core::v1::ReconcileStatusResponse reconcile;
+    ASSERT_TRUE(stub_->GetReconcileStatus(&context, google::protobuf::Empty(), &reconcile).ok());
+
+    ASSERT_EQ(reconcile.cameras_size(), 1);
+    EXPECT_EQ(reconcile.cameras(0).desired().zoom(), 37u);
+    EXPECT_TRUE(reconcile.cameras(0).desired().stabilization());
+}
+
+class GrpcPassthroughMotionTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        camera_service_.zoom = 95;
+        ASSERT_NO_FATAL_FAILURE(addBackend(0, camera_service_));
+
+        common::CoreConfig core_config;
+        core_config.motion.tick_hz = 50;
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config, true));
+    }
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcPassthroughMotionTests, SetStopsMotionLikeTheDecodedPath) {
+    {
+        grpc::ClientContext context;
+        ::core::v1::ZoomVelocityRequest request;
+        request.set_camera_id(0);
+        request.set_velocity(-50.0f);
+        request.set_duration_ms(1000);
+        google::protobuf::Empty response;
+        ASSERT_TRUE(stub_->ZoomVelocity(&context, request, &response).ok());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    ::core::v1::SetZoomRequest request;
+    request.set_camera_id(0);
+    request.set_zoom(40);
+    ::core::v1::SetZoomResponse response;
+    grpc::ClientContext context;
+    ASSERT_TRUE(stub_->SetZoom(&context, request, &response).ok());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(camera_service_.zoom.load(), 40u);
+}
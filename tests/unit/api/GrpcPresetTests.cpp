@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <array>
+#include <vector>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+namespace {
+    constexpr auto COMMAND_DELAY = std::chrono::milliseconds(200);
+} // unnamed namespace
+
+class GrpcPresetTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        for (uint32_t camera_id = 0; camera_id < 2; ++camera_id) {
+            camera_services_[camera_id].command_delay = COMMAND_DELAY;
+            ASSERT_NO_FATAL_FAILURE(addBackend(camera_id, camera_services_[camera_id]));
+        }
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd());
+    }
+
+    void savePreset(const std::string& name) const {
+        ::core::v1::SavePresetRequest request;
+        request.mutable_preset()->set_name(name);
+        for (uint32_t camera_id = 0; camera_id < 2; ++camera_id) {
+            auto* const camera = request.mutable_preset()->add_cameras();
+            camera->set_camera_id(camera_id);
+            camera->set_zoom(30 + camera_id);
+            camera->set_auto_focus(false);
+            camera->set_focus(60);
+            camera->set_stabilization(true);
+        }
+        grpc::ClientContext context;
+        google::protobuf::Empty response;
+        ASSERT_TRUE(stub_->SavePreset(&context, request, &response).ok());
+    }
+
+    ::core::v1::RecallPresetResponse recallPreset(const std::string& name, const std::vector<uint32_t>& camera_ids = {},
+                                                  grpc::Status* status = nullptr) const {
+        ::core::v1::RecallPresetRequest request;
+        request.set_name(name);
+        for (const auto camera_id : camera_ids) {
+            request.add_camera_ids(camera_id);
+        }
+        grpc::ClientContext context;
+        ::core::v1::RecallPresetResponse response;
+        const auto result = stub_->RecallPreset(&context, request, &response);
+        if (status) {
+            *status = result;
+        } else {
+            EXPECT_TRUE(result.ok()) << result.error_message();
+        }
+        return response;
+    }
+
+    std::array<FakeCameraService, 2> camera_services_;
+};
+
+TEST_F(GrpcPresetTests, RecallAppliesSettingsOfAllCamerasInParallel) {
+    savePreset("night");
+
+    const auto response = recallPreset("night");
+
+    EXPECT_EQ(response.applied(), 8u);
+    EXPECT_EQ(response.skipped(), 0u);
+    EXPECT_TRUE(response.errors().empty());
+    // Eight commands take 1600 ms one after the other, focus only waits for its auto focus change
+    EXPECT_LT(response.elapsed_ms(), 4 * COMMAND_DELAY.count());
+    for (auto& camera_service : camera_services_) {
+        const auto commands = camera_service.commands();
+        ASSERT_EQ(commands.size(), 4u);
+        EXPECT_EQ(commands.back(), "focus");
+    }
+}
+
+TEST_F(GrpcPresetTests, SettingsAlreadyInPlaceAreSkipped) {
+    savePreset("night");
+    recallPreset("night");
+
+    const auto response = recallPreset("night");
+
+    EXPECT_EQ(response.applied(), 0u);
+    EXPECT_EQ(response.skipped(), 8u);
+    EXPECT_EQ(camera_services_[0].commands().size(), 4u);
+}
+
+TEST_F(GrpcPresetTests, RecallIsLimitedToTheRequestedCameras) {
+    savePreset("night");
+
+    const auto response = recallPreset("night", {1, 3});
+
+    EXPECT_EQ(response.applied(), 4u);
+    ASSERT_EQ(response.errors_size(), 1);
+    EXPECT_THAT(response.errors(0), HasSubstr("camera 3"));
+    EXPECT_TRUE(camera_services_[0].commands().empty());
+    EXPECT_EQ(camera_services_[1].commands().size(), 4u);
+}
+
+TEST_F(GrpcPresetTests, PresetsCanBeListedAndDeleted) {
+    savePreset("night");
+    savePreset("day");
+
+    grpc::ClientContext list_context;
+    ::core::v1::ListPresetsResponse presets;
+    ASSERT_TRUE(stub_->ListPresets(&list_context, google::protobuf::Empty(), &presets).ok());
+    ASSERT_EQ(presets.presets_size(), 2);
+    EXPECT_EQ(presets.presets(0).name(), "day");
+    EXPECT_EQ(presets.presets(1).cameras(1).zoom(), 31u);
+
+    grpc::ClientContext delete_context;
+    ::core::v1::DeletePresetRequest request;
+    request.set_name("day");
+    google::protobuf::Empty empty;
+    ASSERT_TRUE(stub_->DeletePreset(&delete_context, request, &empty).ok());
+
+    grpc::Status status;
+    recallPreset("day", {}, &status);
+    EXPECT_FALSE(status.ok());
+}
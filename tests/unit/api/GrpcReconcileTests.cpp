@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <thread>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+class GrpcReconcileTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(addBackend(CAMERA_ID, camera_service_));
+
+        common::CoreConfig core_config;
+        core_config.reconcile.enabled = true;
+        core_config.reconcile.check_interval = std::chrono::milliseconds(50);
+        core_config.reconcile.settle_time = std::chrono::milliseconds(20);
+        core_config.reconcile.connection_poll = std::chrono::milliseconds(10);
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config));
+    }
+
+    ::core::v1::ReconcileStatusResponse status() {
+        grpc::ClientContext context;
+        ::core::v1::ReconcileStatusResponse response;
+        const auto result = stub_->GetReconcileStatus(&context, google::protobuf::Empty(), &response);
+        EXPECT_TRUE(result.ok()) << result.error_message();
+        return response;
+    }
+
+    static constexpr uint32_t CAMERA_ID = 0;
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcReconcileTests, DriftedZoomIsRestored) {
+    grpc::ClientContext context;
+    ::core::v1::SetZoomRequest request;
+    request.set_camera_id(CAMERA_ID);
+    request.set_zoom(40);
+    ::core::v1::SetZoomResponse response;
+    ASSERT_TRUE(stub_->SetZoom(&context, request, &response).ok());
+
+    // Come back from a reboot at the default zoom
+    camera_service_.zoom = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    auto reconcile = status();
+    while (reconcile.recent_drifts_size() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        reconcile = status();
+    }
+
+    EXPECT_EQ(camera_service_.zoom.load(), 40u);
+    EXPECT_TRUE(reconcile.enabled());
+    ASSERT_EQ(reconcile.cameras_size(), 1);
+    EXPECT_EQ(reconcile.cameras(0).desired().zoom(), 40u);
+    EXPECT_GE(reconcile.cameras(0).drifts(), 1u);
+    ASSERT_GE(reconcile.recent_drifts_size(), 1);
+    EXPECT_EQ(reconcile.recent_drifts(0).drifted().zoom(), 40u);
+    EXPECT_TRUE(reconcile.recent_drifts(0).restored());
+}
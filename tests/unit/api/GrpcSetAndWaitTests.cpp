@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <mutex>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+namespace {
+    constexpr uint32_t MAX_OPTICAL_ZOOM = 80;
+    constexpr double LENS_SPEED = 250.0; // normalized units per second
+
+    /**
+     * A lens that accepts any zoom and travels there at LENS_SPEED, stopping at MAX_OPTICAL_ZOOM
+     */
+    class TravellingLensCameraService final : public FakeCameraService {
+    public:
+        grpc::Status SetZoom(grpc::ServerContext*, const camera::v1::SetZoomRequest* request,
+                             camera::v1::SetZoomResponse* response) override {
+            std::lock_guard lock(mutex_);
+            start_ = position();
+            target_ = request->zoom();
+            commanded_at_ = std::chrono::steady_clock::now();
+            response->set_zoom(request->zoom());
+            return grpc::Status::OK;
+        }
+
+        grpc::Status GetZoom(grpc::ServerContext*, const google::protobuf::Empty*,
+                             camera::v1::GetZoomResponse* response) override {
+            std::lock_guard lock(mutex_);
+            response->set_zoom(position());
+            return grpc::Status::OK;
+        }
+
+    private:
+        uint32_t position() const {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - commanded_at_;
+            const auto travelled = static_cast<int64_t>(LENS_SPEED * elapsed.count());
+            const int64_t goal = std::min(target_, MAX_OPTICAL_ZOOM);
+            return static_cast<uint32_t>(start_ < goal ? std::min(start_ + travelled, goal)
+                                                       : std::max(start_ - travelled, goal));
+        }
+
+        std::mutex mutex_;
+        int64_t start_{0};
+        uint32_t target_{0};
+        std::chrono::steady_clock::time_point commanded_at_{std::chrono::steady_clock::now()};
+    };
+} // unnamed namespace
+
+class GrpcSetAndWaitTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(addBackend(0, camera_service_));
+
+        common::CoreConfig core_config;
+        core_config.convergence.min_poll_interval = std::chrono::milliseconds(10);
+        core_config.convergence.settle_time = std::chrono::milliseconds(60);
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config));
+    }
+
+    ::core::v1::SetZoomAndWaitResponse setZoomAndWait(const uint32_t zoom, const uint32_t timeout_ms) const {
+        grpc::ClientContext context;
+        ::core::v1::SetZoomAndWaitRequest request;
+        request.set_camera_id(0);
+        request.set_zoom(zoom);
+        request.set_timeout_ms(timeout_ms);
+        ::core::v1::SetZoomAndWaitResponse response;
+        EXPECT_TRUE(stub_->SetZoomAndWait(&context, request, &response).ok());
+        return response;
+    }
+
+    TravellingLensCameraService camera_service_;
+};
+
+TEST_F(GrpcSetAndWaitTests, RepliesOnceTheLensArrives) {
+    const auto response = setZoomAndWait(50, 0);
+
+    EXPECT_EQ(response.status(), ::core::v1::CONVERGENCE_STATUS_REACHED);
+    EXPECT_EQ(response.zoom(), 50u);
+    // 50 units at 250 units per second
+    EXPECT_GE(response.elapsed_ms(), 190u);
+}
+
+TEST_F(GrpcSetAndWaitTests, ReportsWhereTheLensStopped) {
+    const auto response = setZoomAndWait(95, 0);
+
+    EXPECT_EQ(response.status(), ::core::v1::CONVERGENCE_STATUS_SETTLED);
+    EXPECT_EQ(response.zoom(), MAX_OPTICAL_ZOOM);
+}
+
+TEST_F(GrpcSetAndWaitTests, TimesOutWithLastPosition) {
+    const auto response = setZoomAndWait(60, 100);
+
+    EXPECT_EQ(response.status(), ::core::v1::CONVERGENCE_STATUS_TIMED_OUT);
+    EXPECT_GT(response.zoom(), 0u);
+    EXPECT_LT(response.zoom(), 60u);
+}
+
+TEST_F(GrpcSetAndWaitTests, FocusOnUnknownCameraFails) {
+    grpc::ClientContext context;
+    ::core::v1::SetFocusAndWaitRequest request;
+    request.set_camera_id(7);
+    request.set_focus(10);
+    ::core::v1::SetFocusAndWaitResponse response;
+    EXPECT_EQ(stub_->SetFocusAndWait(&context, request, &response).error_code(), grpc::StatusCode::INTERNAL);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+namespace {
+    constexpr auto CAMERA_TIMEOUT = std::chrono::milliseconds(300);
+
+    class SnapshotCameraService final : public FakeCameraService {
+    public:
+        explicit SnapshotCameraService(const std::chrono::milliseconds zoom_delay) : zoom_delay_(zoom_delay) {
+            zoom = 25;
+            focus = 35;
+            auto_focus = true;
+        }
+
+        grpc::Status GetZoom(grpc::ServerContext* context, const google::protobuf::Empty* request,
+                             camera::v1::GetZoomResponse* response) override {
+            std::this_thread::sleep_for(zoom_delay_);
+            return FakeCameraService::GetZoom(context, request, response);
+        }
+
+        grpc::Status GetCapabilities(grpc::ServerContext*, const google::protobuf::Empty*,
+                                     camera::v1::GetCapabilitiesResponse* response) override {
+            response->add_capabilities(camera::v1::CAPABILITY_ZOOM);
+            return grpc::Status::OK;
+        }
+
+    private:
+        const std::chrono::milliseconds zoom_delay_;
+    };
+} // unnamed namespace
+
+class GrpcSystemSnapshotTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        video_service_.hdr = true;
+        for (uint32_t camera_id = 0; camera_id < 2; ++camera_id) {
+            ASSERT_NO_FATAL_FAILURE(addBackend(camera_id, camera_services_[camera_id], &video_service_));
+        }
+
+        common::CoreConfig core_config;
+        core_config.snapshot.camera_timeout = CAMERA_TIMEOUT;
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd(core_config));
+    }
+
+    // Camera 1 answers GetZoom well after the per-camera deadline
+    SnapshotCameraService camera_services_[2] = {SnapshotCameraService(std::chrono::milliseconds(0)),
+                                                 SnapshotCameraService(std::chrono::milliseconds(1000))};
+    FakeVideoService video_service_;
+};
+
+TEST_F(GrpcSystemSnapshotTests, ReturnsEverySectionOfEveryCamera) {
+    ::core::v1::GetSystemSnapshotRequest request;
+    request.add_camera_ids(0);
+
+    grpc::ClientContext context;
+    ::core::v1::GetSystemSnapshotResponse response;
+    ASSERT_TRUE(stub_->GetSystemSnapshot(&context, request, &response).ok());
+
+    ASSERT_EQ(response.cameras_size(), 1);
+    const auto& camera = response.cameras(0);
+    EXPECT_EQ(camera.camera_id(), 0u);
+    EXPECT_EQ(camera.zoom(), 25u);
+    EXPECT_EQ(camera.focus(), 35u);
+    EXPECT_TRUE(camera.auto_focus());
+    ASSERT_TRUE(camera.has_stabilization());
+    EXPECT_FALSE(camera.stabilization());
+    EXPECT_EQ(camera.info(), "camera");
+    ASSERT_EQ(camera.capabilities_size(), 1);
+    EXPECT_EQ(camera.capabilities(0), ::core::v1::CAPABILITY_ZOOM);
+    ASSERT_EQ(camera.video_capabilities_size(), 2);
+    EXPECT_EQ(camera.video_capabilities(0).capability(), "hdr");
+    EXPECT_TRUE(camera.video_capabilities(0).enable());
+    EXPECT_FALSE(camera.video_capabilities(1).enable());
+    EXPECT_TRUE(camera.errors().empty());
+}
+
+TEST_F(GrpcSystemSnapshotTests, SlowCameraOnlyBlanksItsOwnSection) {
+    ::core::v1::GetSystemSnapshotRequest request;
+
+    grpc::ClientContext context;
+    ::core::v1::GetSystemSnapshotResponse response;
+    const auto started = std::chrono::steady_clock::now();
+    ASSERT_TRUE(stub_->GetSystemSnapshot(&context, request, &response).ok());
+
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(900));
+    ASSERT_EQ(response.cameras_size(), 2);
+    EXPECT_TRUE(response.cameras(0).has_zoom());
+    EXPECT_TRUE(response.cameras(0).errors().empty());
+
+    const auto& slow_camera = response.cameras(1);
+    EXPECT_FALSE(slow_camera.has_zoom());
+    EXPECT_EQ(slow_camera.focus(), 35u);
+    EXPECT_EQ(slow_camera.info(), "camera");
+    ASSERT_EQ(slow_camera.errors_size(), 1);
+    EXPECT_THAT(slow_camera.errors(0), HasSubstr("zoom"));
+}
+
+TEST_F(GrpcSystemSnapshotTests, HungCameraReleasesReadersAtTheDeadline) {
+    // Every reader reads the slow camera, each read outlives its snapshot
+    std::vector<std::thread> snapshots;
+    for (std::size_t i = 0; i < common::SnapshotConfig{}.max_readers; ++i) {
+        snapshots.emplace_back([this] {
+            ::core::v1::GetSystemSnapshotRequest request;
+            request.add_camera_ids(1);
+            request.mutable_fields()->add_paths("zoom");
+            grpc::ClientContext context;
+            ::core::v1::GetSystemSnapshotResponse response;
+            EXPECT_TRUE(stub_->GetSystemSnapshot(&context, request, &response).ok());
+        });
+    }
+    for (auto& snapshot : snapshots) {
+        snapshot.join();
+    }
+
+    ::core::v1::GetSystemSnapshotRequest request;
+    request.add_camera_ids(0);
+    grpc::ClientContext context;
+    ::core::v1::GetSystemSnapshotResponse response;
+    ASSERT_TRUE(stub_->GetSystemSnapshot(&context, request, &response).ok());
+
+    ASSERT_EQ(response.cameras_size(), 1);
+    EXPECT_EQ(response.cameras(0).zoom(), 25u);
+    EXPECT_TRUE(response.cameras(0).errors().empty());
+}
+
+TEST_F(GrpcSystemSnapshotTests, FieldMaskLimitsSectionsAndInfoIsCached) {
+    ::core::v1::GetSystemSnapshotRequest request;
+    request.add_camera_ids(0);
+    request.mutable_fields()->add_paths("info");
+
+    for (int i = 0; i < 3; ++i) {
+        grpc::ClientContext context;
+        ::core::v1::GetSystemSnapshotResponse response;
+        ASSERT_TRUE(stub_->GetSystemSnapshot(&context, request, &response).ok());
+        ASSERT_EQ(response.cameras_size(), 1);
+        EXPECT_EQ(response.cameras(0).info(), "camera");
+        EXPECT_FALSE(response.cameras(0).has_zoom());
+        EXPECT_TRUE(response.cameras(0).video_capabilities().empty());
+    }
+
+    EXPECT_EQ(camera_services_[0].get_info_calls.load(), 1);
+}
+
+TEST_F(GrpcSystemSnapshotTests, RejectsUnknownField) {
+    ::core::v1::GetSystemSnapshotRequest request;
+    request.mutable_fields()->add_paths("brightness");
+
+    grpc::ClientContext context;
+    ::core::v1::GetSystemSnapshotResponse response;
+    EXPECT_EQ(stub_->GetSystemSnapshot(&context, request, &response).error_code(),
+              grpc::StatusCode::INVALID_ARGUMENT);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+/* Add your project include files here */
+#include "../../GrpcFixture.h"
+
+class GrpcWatchCameraStateTests : public GrpcFixture {
+protected:
+    void SetUp() override {
+        camera_service_.zoom = 10;
+        camera_service_.focus = 35;
+        camera_service_.auto_focus = true;
+        ASSERT_NO_FATAL_FAILURE(addBackend(1, camera_service_));
+        ASSERT_NO_FATAL_FAILURE(startFrontEnd());
+    }
+
+    FakeCameraService camera_service_;
+};
+
+TEST_F(GrpcWatchCameraStateTests, StreamsSnapshotThenChangesFromSets) {
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    ::core::v1::WatchCameraStateRequest request;
+    request.set_camera_id(1);
+    const auto reader = stub_->WatchCameraState(&context, request);
+
+    ::core::v1::CameraStateUpdate update;
+    ASSERT_TRUE(reader->Read(&update));
+    EXPECT_TRUE(update.snapshot());
+    EXPECT_EQ(update.zoom(), 10u);
+    EXPECT_EQ(update.focus(), 35u);
+    EXPECT_TRUE(update.auto_focus());
+    ASSERT_TRUE(update.has_stabilization());
+    EXPECT_FALSE(update.stabilization());
+
+    grpc::ClientContext set_context;
+    ::core::v1::SetZoomRequest set_request;
+    set_request.set_camera_id(1);
+    set_request.set_zoom(60);
+    ::core::v1::SetZoomResponse set_response;
+    ASSERT_TRUE(stub_->SetZoom(&set_context, set_request, &set_response).ok());
+
+    ASSERT_TRUE(reader->Read(&update));
+    EXPECT_FALSE(update.snapshot());
+    EXPECT_EQ(update.zoom(), 60u);
+    EXPECT_FALSE(update.has_focus());
+
+    context.TryCancel();
+}
+
+TEST_F(GrpcWatchCameraStateTests, FieldMaskLimitsStreamedFields) {
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    ::core::v1::WatchCameraStateRequest request;
+    request.set_camera_id(1);
+    request.mutable_fields()->add_paths("focus");
+    const auto reader = stub_->WatchCameraState(&context, request);
+
+    ::core::v1::CameraStateUpdate update;
+    ASSERT_TRUE(reader->Read(&update));
+    EXPECT_TRUE(update.has_focus());
+    EXPECT_FALSE(update.has_zoom());
+    EXPECT_FALSE(update.has_auto_focus());
+
+    context.TryCancel();
+}
+
+TEST_F(GrpcWatchCameraStateTests, RejectsUnknownField) {
+    grpc::ClientContext context;
+    ::core::v1::WatchCameraStateRequest request;
+    request.set_camera_id(1);
+    request.mutable_fields()->add_paths("brightness");
+    const auto reader = stub_->WatchCameraState(&context, request);
+
+    ::core::v1::CameraStateUpdate update;
+    EXPECT_FALSE(reader->Read(&update));
+    EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::INVALID_ARGUMENT);
+}
+
+TEST_F(GrpcWatchCameraStateTests, ServerStopFinishesOpenStreams) {
+    grpc::ClientContext context;
+    ::core::v1::WatchCameraStateRequest request;
+    request.set_camera_id(1);
+    const auto reader = stub_->WatchCameraState(&context, request);
+    ::core::v1::CameraStateUpdate update;
+    ASSERT_TRUE(reader->Read(&update));
+
+    const auto started = std::chrono::steady_clock::now();
+    ASSERT_TRUE(transport_->stop().isSuccess());
+
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(5));
+    while (reader->Read(&update)) {
+    }
+    EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::UNAVAILABLE);
+}
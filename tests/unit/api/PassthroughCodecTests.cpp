@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <grpcpp/support/byte_buffer.h>
+/* Add your project include files here */
+#include "api/PassthroughCodec.h"
+#include "api/proto/camera_service.pb.h"
+#include "api/proto/core_service.pb.h"
+
+using namespace testing;
+using namespace service;
+
+namespace {
+    grpc::ByteBuffer toByteBuffer(const std::string& bytes) {
+        grpc::Slice slice(bytes);
+        return grpc::ByteBuffer(&slice, 1);
+    }
+
+    std::string toString(const grpc::ByteBuffer& buffer) {
+        std::vector<grpc::Slice> slices;
+        EXPECT_TRUE(buffer.Dump(&slices).ok());
+        std::string bytes;
+        for (const auto& slice : slices) {
+            bytes.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+        }
+        return bytes;
+    }
+} // unnamed namespace
+
+TEST(PassthroughCodecTests, SetRequestIsRenumbered) {
+    ::core::v1::SetZoomRequest request;
+    request.set_camera_id(3);
+    request.set_zoom(42);
+
+    grpc::ByteBuffer camera_request;
+    const auto camera_id = api::passthrough::toCameraRequest(toByteBuffer(request.SerializeAsString()),
+                                                             &camera_request);
+
+    ASSERT_TRUE(camera_id.isSuccess());
+    EXPECT_EQ(camera_id.value(), 3u);
+
+    camera::v1::SetZoomRequest forwarded;
+    ASSERT_TRUE(forwarded.ParseFromString(toString(camera_request)));
+    EXPECT_EQ(forwarded.zoom(), 42u);
+}
+
+TEST(PassthroughCodecTests, GetRequestBecomesEmpty) {
+    ::core::v1::GetZoomRequest request;
+    request.set_camera_id(1);
+
+    grpc::ByteBuffer camera_request;
+    const auto camera_id = api::passthrough::toCameraRequest(toByteBuffer(request.SerializeAsString()),
+                                                             &camera_request);
+
+    ASSERT_TRUE(camera_id.isSuccess());
+    EXPECT_EQ(camera_id.value(), 1u);
+    EXPECT_TRUE(toString(camera_request).empty());
+}
+
+TEST(PassthroughCodecTests, MissingCameraIdDefaultsToZero) {
+    ::core::v1::SetAutoFocusRequest request;
+    request.set_enable(true);
+
+    grpc::ByteBuffer camera_request;
+    const auto camera_id = api::passthrough::toCameraRequest(toByteBuffer(request.SerializeAsString()),
+                                                             &camera_request);
+
+    ASSERT_TRUE(camera_id.isSuccess());
+    EXPECT_EQ(camera_id.value(), 0u);
+
+    camera::v1::SetAutoFocusRequest forwarded;
+    ASSERT_TRUE(forwarded.ParseFromString(toString(camera_request)));
+    EXPECT_TRUE(forwarded.enable());
+}
+
+TEST(PassthroughCodecTests, MalformedRequestIsRejected) {
+    grpc::ByteBuffer camera_request;
+    const auto camera_id = api::passthrough::toCameraRequest(toByteBuffer(std::string("\x08\xff", 2)),
+                                                             &camera_request);
+
+    EXPECT_TRUE(camera_id.isError());
+}
+
+TEST(PassthroughCodecTests, OnlyCameraMethodsArePassedThrough) {
+    EXPECT_EQ(api::passthrough::cameraMethodOf("/core.v1.CoreService/SetZoom"), "SetZoom");
+    EXPECT_EQ(api::passthrough::cameraMethodOf("/core.v1.CoreService/GetStabilization"), "GetStabilization");
+    EXPECT_TRUE(api::passthrough::cameraMethodOf("/core.v1.CoreService/GetVideoCapabilities").empty());
+    EXPECT_TRUE(api::passthrough::cameraMethodOf("/camera.v1.CameraService/SetZoom").empty());
+}
@@ -2,6 +2,7 @@
 #include <gmock/gmock.h>
 /* Add your project include files here */
 #include "api/RequestHandler.h"
+#include "common/async/Task.h"
 #include "common/types/Result.h"
 #include "common/types/CameraCapabilities.h"
 #include "../../Mocks.h"
@@ -77,7 +78,7 @@ TEST_F(RequestHandlerTests, ZoomOperations) {
 
     EXPECT_CALL(*core, setZoom(0, 2))
         .InSequence(s)
-        .WillOnce(Return(Result<void>::success()));
+        .WillOnce(Return(Result<common::types::zoom>::success(2u)));
     EXPECT_CALL(*core, getZoom(0))
         .InSequence(s)
         .WillOnce(Return(Result<common::types::zoom>::success(2u)));
@@ -86,17 +87,18 @@ TEST_F(RequestHandlerTests, ZoomOperations) {
         .WillOnce(Return(Result<void>::success()));
 
     const auto start_result = request_handler->start();
-    ASSERT_TRUE(start_result.isSuccess()) << "Failed to start: " << start_result.error();
+    ASSERT_TRUE(start_result.isSuccess()) << "Failed to start: " << start_result.error().message;
 
     const auto set_result = request_handler->setZoom(0, 2);
-    ASSERT_TRUE(set_result.isSuccess()) << "Failed to set zoom: " << set_result.error();
+    ASSERT_TRUE(set_result.isSuccess()) << "Failed to set zoom: " << set_result.error().message;
+    EXPECT_EQ(2, set_result.value());
 
     const auto get_result = request_handler->getZoom(0);
-    ASSERT_TRUE(get_result.isSuccess()) << "Failed to get zoom: " << get_result.error();
+    ASSERT_TRUE(get_result.isSuccess()) << "Failed to get zoom: " << get_result.error().message;
     EXPECT_EQ(2, get_result.value());
 
     const auto stop_result = request_handler->stop();
-    ASSERT_TRUE(stop_result.isSuccess()) << "Failed to stop: " << stop_result.error();
+    ASSERT_TRUE(stop_result.isSuccess()) << "Failed to stop: " << stop_result.error().message;
 }
 
 TEST_F(RequestHandlerTests, ZoomOperationsFailIfNotRunning) {
@@ -107,6 +109,50 @@ TEST_F(RequestHandlerTests, ZoomOperationsFailIfNotRunning) {
     ASSERT_TRUE(get_result.isError());
 }
 
+TEST_F(RequestHandlerTests, EveryCallReportsTheSameErrorIfNotRunning) {
+    constexpr auto NOT_RUNNING = "RequestHandler is not running";
+
+    EXPECT_EQ(request_handler->setZoom(0, 2).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->getZoom(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->goToMinZoom(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->goToMaxZoom(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->setFocus(0, 2).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->getFocus(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->enableAutoFocus(0, true).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->getAutoFocus(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->stepZoom(0, 1).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->stepFocus(0, 1).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->setZoomVelocity(0, 0.5, std::chrono::milliseconds(100)).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->setFocusVelocity(0, 0.5, std::chrono::milliseconds(100)).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->setZoomAndWait(0, 2, 1, std::chrono::milliseconds(100)).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->setFocusAndWait(0, 2, 1, std::chrono::milliseconds(100)).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->getInfo(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->stabilize(0, true).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->getStabilization(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->getCapabilities(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->SetVideoCapabilityState(0, "hdr", true).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->getVideoCapabilities(0).error().message, NOT_RUNNING);
+    EXPECT_EQ(request_handler->getVideoCapabilityState(0, "hdr").error().message, NOT_RUNNING);
+    EXPECT_EQ(common::async::syncWait(request_handler->setZoomAsync(0, 2)).error().message, NOT_RUNNING);
+}
+
+TEST_F(RequestHandlerTests, AsyncSetZoomFallsBackToTheSynchronousCore) {
+    EXPECT_CALL(*core, setZoom(0, 2))
+        .WillOnce(Return(Result<common::types::zoom>::success(2u)));
+    ASSERT_TRUE(request_handler->start().isSuccess());
+
+    const auto result = common::async::syncWait(request_handler->setZoomAsync(0, 2));
+    ASSERT_TRUE(result.isSuccess()) << "Failed to set zoom: " << result.error().message;
+    EXPECT_EQ(2, result.value());
+}
+
+TEST_F(RequestHandlerTests, AsyncSetFocusFailsIfNotRunning) {
+    EXPECT_CALL(*core, setFocus(_, _)).Times(0);
+
+    const auto result = common::async::syncWait(request_handler->setFocusAsync(0, 2));
+    ASSERT_TRUE(result.isError());
+}
+
 TEST_F(RequestHandlerTests, FocusOperations) {
     Sequence s;
     EXPECT_CALL(*core, start())
@@ -115,7 +161,7 @@ TEST_F(RequestHandlerTests, FocusOperations) {
 
     EXPECT_CALL(*core, setFocus(0, 1))
         .InSequence(s)
-        .WillOnce(Return(Result<void>::success()));
+        .WillOnce(Return(Result<common::types::focus>::success(1u)));
     EXPECT_CALL(*core, getFocus(0))
         .InSequence(s)
         .WillOnce(Return(Result<common::types::focus>::success(1u)));
@@ -124,17 +170,18 @@ TEST_F(RequestHandlerTests, FocusOperations) {
         .WillOnce(Return(Result<void>::success()));
 
     const auto start_result = request_handler->start();
-    ASSERT_TRUE(start_result.isSuccess()) << "Failed to start: " << start_result.error();
+    ASSERT_TRUE(start_result.isSuccess()) << "Failed to start: " << start_result.error().message;
 
     const auto set_result = request_handler->setFocus(0, 1);
-    ASSERT_TRUE(set_result.isSuccess()) << "Failed to set focus: " << set_result.error();
+    ASSERT_TRUE(set_result.isSuccess()) << "Failed to set focus: " << set_result.error().message;
+    EXPECT_EQ(1, set_result.value());
 
     const auto get_result = request_handler->getFocus(0);
-    ASSERT_TRUE(get_result.isSuccess()) << "Failed to get focus: " << get_result.error();
+    ASSERT_TRUE(get_result.isSuccess()) << "Failed to get focus: " << get_result.error().message;
     EXPECT_EQ(1, get_result.value());
 
     const auto stop_result = request_handler->stop();
-    ASSERT_TRUE(stop_result.isSuccess()) << "Failed to stop: " << stop_result.error();
+    ASSERT_TRUE(stop_result.isSuccess()) << "Failed to stop: " << stop_result.error().message;
 }
 
 TEST_F(RequestHandlerTests, FocusOperationsFailIfNotRunning) {
@@ -209,7 +256,7 @@ TEST_F(RequestHandlerTests, GoToMinZoomSuccess) {
     EXPECT_CALL(*core, start())
         .WillOnce(Return(Result<void>::success()));
     EXPECT_CALL(*core, goToMinZoom(0))
-        .WillOnce(Return(Result<void>::success()));
+        .WillOnce(Return(Result<common::types::zoom>::success(0u)));
     EXPECT_CALL(*core, stop())
         .WillOnce(Return(Result<void>::success()));
 
@@ -227,7 +274,7 @@ TEST_F(RequestHandlerTests, GoToMaxZoomSuccess) {
     EXPECT_CALL(*core, start())
         .WillOnce(Return(Result<void>::success()));
     EXPECT_CALL(*core, goToMaxZoom(0))
-        .WillOnce(Return(Result<void>::success()));
+        .WillOnce(Return(Result<common::types::zoom>::success(100u)));
     EXPECT_CALL(*core, stop())
         .WillOnce(Return(Result<void>::success()));
 
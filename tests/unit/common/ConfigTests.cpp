@@ -164,3 +164,381 @@ TEST_F(ConfigManagerTests, HandlesNoInfrastructureSection) {
     const auto& infrastructure_config = config.getInfrastructureConfig();
     EXPECT_EQ(infrastructure_config.clients.size(), 0);
 }
+
+TEST_F(ConfigManagerTests, LoadsBatchingConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    clients:\n      camera_service:\n        batching:\n          enabled: true\n          window_us: 750\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& batching = config.getInfrastructureConfig().clients.at("camera_service").batching;
+    EXPECT_TRUE(batching.enabled);
+    EXPECT_EQ(batching.window, std::chrono::microseconds(750));
+}
+
+TEST_F(ConfigManagerTests, BatchingDisabledByDefault) {
+    const common::ConfigManager config(test_config_path_);
+
+    EXPECT_FALSE(config.getInfrastructureConfig().clients.at("camera_service").batching.enabled);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnBatchingWindowAboveOneMillisecond) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    clients:\n      camera_service:\n        batching:\n          enabled: true\n          window_us: 1500\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsAdmissionConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    clients:\n      camera_service:\n        admission:\n          set: {rate_hz: 20, burst: 4, on_limit: conflate, max_wait_ms: 150}\n          get: {rate_hz: 30, on_limit: reject}\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& admission = config.getInfrastructureConfig().clients.at("camera_service").admission;
+    EXPECT_DOUBLE_EQ(admission.set.rate_hz, 20.0);
+    EXPECT_EQ(admission.set.burst, 4u);
+    EXPECT_EQ(admission.set.on_limit, common::AdmissionMode::Conflate);
+    EXPECT_EQ(admission.set.max_wait, std::chrono::milliseconds(150));
+    EXPECT_DOUBLE_EQ(admission.get.rate_hz, 30.0);
+    EXPECT_EQ(admission.get.on_limit, common::AdmissionMode::Reject);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnConflatedReads) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    clients:\n      camera_service:\n        admission:\n          get: {rate_hz: 30, on_limit: conflate}\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnUnknownAdmissionMode) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    clients:\n      camera_service:\n        admission:\n          set: {rate_hz: 30, on_limit: drop}\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsWarmupConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    warmup:\n      enabled: true\n      budget_ms: 1500\n      min_ready_fraction: 0.75\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& warmup = config.getInfrastructureConfig().warmup;
+    EXPECT_TRUE(warmup.enabled);
+    EXPECT_EQ(warmup.budget, std::chrono::milliseconds(1500));
+    EXPECT_DOUBLE_EQ(warmup.min_ready_fraction, 0.75);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnWarmupFractionAboveOne) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    warmup:\n      enabled: true\n      min_ready_fraction: 1.5\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsPinnedInstanceIp) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    resolver:\n      enabled: true\n      ttl_s: 30\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: camera.local:50052\n            pinned_ip: 192.168.1.20");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& infrastructure_config = config.getInfrastructureConfig();
+    EXPECT_TRUE(infrastructure_config.resolver.enabled);
+    EXPECT_EQ(infrastructure_config.resolver.ttl, std::chrono::seconds(30));
+    EXPECT_EQ(infrastructure_config.clients.at("camera_service").instances[0].pinned_ip, "192.168.1.20");
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnInvalidPinnedIp) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: camera.local:50052\n            pinned_ip: camera.local");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsStateHubConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    state_hub:\n      poll_min_ms: 50\n      poll_max_ms: 500\n      queue_size: 4\n      max_wait_ms: 1500\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& state_hub = config.getCoreConfig().state_hub;
+    EXPECT_EQ(state_hub.poll_min, std::chrono::milliseconds(50));
+    EXPECT_EQ(state_hub.poll_max, std::chrono::milliseconds(500));
+    EXPECT_EQ(state_hub.queue_size, 4u);
+    EXPECT_EQ(state_hub.max_wait, std::chrono::milliseconds(1500));
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnStateHubMaxPollBelowMin) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    state_hub:\n      poll_min_ms: 500\n      poll_max_ms: 50\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnZeroStateHubMaxWait) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    state_hub:\n      max_wait_ms: 0\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsSnapshotConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    snapshot:\n      camera_timeout_ms: 250\n      static_ttl_ms: 0\n      max_readers: 4\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& snapshot = config.getCoreConfig().snapshot;
+    EXPECT_EQ(snapshot.camera_timeout, std::chrono::milliseconds(250));
+    EXPECT_EQ(snapshot.static_ttl, std::chrono::milliseconds(0));
+    EXPECT_EQ(snapshot.max_readers, 4u);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnZeroSnapshotCameraTimeout) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    snapshot:\n      camera_timeout_ms: 0\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnZeroSnapshotMaxReaders) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    snapshot:\n      max_readers: 0\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsMotionConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    motion:\n      tick_hz: 50\n      max_duration_ms: 800\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& motion = config.getCoreConfig().motion;
+    EXPECT_EQ(motion.tick_hz, 50u);
+    EXPECT_EQ(motion.max_duration, std::chrono::milliseconds(800));
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnZeroMotionTickRate) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    motion:\n      tick_hz: 0\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsConvergenceConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    convergence:\n      min_poll_interval_ms: 10\n      max_poll_interval_ms: 100\n      settle_time_ms: 150\n      max_wait_ms: 3000\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& convergence = config.getCoreConfig().convergence;
+    EXPECT_EQ(convergence.min_poll_interval, std::chrono::milliseconds(10));
+    EXPECT_EQ(convergence.max_poll_interval, std::chrono::milliseconds(100));
+    EXPECT_EQ(convergence.settle_time, std::chrono::milliseconds(150));
+    EXPECT_EQ(convergence.max_wait, std::chrono::milliseconds(3000));
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnInvertedConvergencePollIntervals) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    convergence:\n      min_poll_interval_ms: 200\n      max_poll_interval_ms: 100\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsPresets) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    presets:\n      file: /tmp/presets.yaml\n      definitions:\n        - name: night\n          cameras:\n            - camera_id: 1\n              zoom: 20\n              auto_focus: false\n              focus: 70\n              video_capabilities:\n                hdr: true\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& presets = config.getCoreConfig().presets;
+    EXPECT_EQ(presets.file, "/tmp/presets.yaml");
+    ASSERT_EQ(presets.definitions.size(), 1u);
+    EXPECT_EQ(presets.definitions[0].name, "night");
+    ASSERT_EQ(presets.definitions[0].cameras.size(), 1u);
+    const auto& camera = presets.definitions[0].cameras[0];
+    EXPECT_EQ(camera.camera_id, 1u);
+    EXPECT_EQ(camera.state.zoom_level, 20u);
+    EXPECT_EQ(camera.state.focus_value, 70u);
+    EXPECT_EQ(camera.state.auto_focus, false);
+    EXPECT_FALSE(camera.state.stabilization);
+    EXPECT_EQ(camera.video_capabilities.at("hdr"), true);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnPresetFocusWithAutoFocus) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    presets:\n      definitions:\n        - name: day\n          cameras:\n            - camera_id: 1\n              auto_focus: true\n              focus: 70\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsSchedulingConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    scheduling:\n      resolution_us: 500\n      prepare_lead_ms: 50\n      max_lead_ms: 10000\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& scheduling = config.getCoreConfig().scheduling;
+    EXPECT_EQ(scheduling.resolution, std::chrono::microseconds(500));
+    EXPECT_EQ(scheduling.prepare_lead, std::chrono::milliseconds(50));
+    EXPECT_EQ(scheduling.max_lead, std::chrono::milliseconds(10000));
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnZeroSchedulingResolution) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    scheduling:\n      resolution_us: 0\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsMacros) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    macros:\n      definitions:\n        - name: sweep\n          steps:\n            - set_zoom: 10\n            - await_zoom: {tolerance: 2, timeout_ms: 500}\n            - repeat:\n                count: 3\n                steps:\n                  - zoom_step: 5\n                  - wait_ms: 20\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    using service::common::types::MacroStepType;
+    const auto& definitions = config.getCoreConfig().macros.definitions;
+    ASSERT_EQ(definitions.size(), 1u);
+    EXPECT_EQ(definitions[0].name, "sweep");
+    const auto& steps = definitions[0].steps;
+    ASSERT_EQ(steps.size(), 3u);
+    EXPECT_EQ(steps[0].type, MacroStepType::Operation);
+    EXPECT_EQ(steps[0].operation.value, 10u);
+    EXPECT_EQ(steps[1].type, MacroStepType::AwaitZoom);
+    EXPECT_EQ(steps[1].tolerance, 2u);
+    EXPECT_EQ(steps[1].timeout, std::chrono::milliseconds(500));
+    EXPECT_EQ(steps[2].type, MacroStepType::Repeat);
+    EXPECT_EQ(steps[2].count, 3u);
+    ASSERT_EQ(steps[2].steps.size(), 2u);
+    EXPECT_EQ(steps[2].steps[0].delta, 5);
+    EXPECT_EQ(steps[2].steps[1].duration, std::chrono::milliseconds(20));
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnMacroRepeatWithoutCount) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    macros:\n      definitions:\n        - name: sweep\n          steps:\n            - repeat:\n                count: 0\n                steps:\n                  - zoom_step: 5\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsLeasesConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    leases:\n      default_ttl_ms: 2000\n      max_ttl_ms: 8000\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& leases = config.getCoreConfig().leases;
+    EXPECT_EQ(leases.default_ttl, std::chrono::milliseconds(2000));
+    EXPECT_EQ(leases.max_ttl, std::chrono::milliseconds(8000));
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnDefaultLeaseTtlAboveMaximum) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    leases:\n      default_ttl_ms: 20000\n      max_ttl_ms: 10000\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsDispatchConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    dispatch:\n      max_in_flight: 1\n      max_queued: 16\n      background_max_queued: 4\n      max_callers: 32\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& dispatch = config.getCoreConfig().dispatch;
+    EXPECT_EQ(dispatch.max_in_flight, 1u);
+    EXPECT_EQ(dispatch.max_queued, 16u);
+    EXPECT_EQ(dispatch.background_max_queued, 4u);
+    EXPECT_EQ(dispatch.max_callers, 32u);
+}
+
+TEST_F(ConfigManagerTests, LoadsAdaptiveConcurrencyConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    dispatch:\n      max_in_flight: 4\n      adaptive:\n        enabled: true\n        min_limit: 2\n        max_limit: 8\n        tolerance: 2.0\n        smoothing: 0.5\n        queue_per_limit: 3\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& adaptive = config.getCoreConfig().dispatch.adaptive;
+    EXPECT_TRUE(adaptive.enabled);
+    EXPECT_EQ(adaptive.min_limit, 2u);
+    EXPECT_EQ(adaptive.max_limit, 8u);
+    EXPECT_DOUBLE_EQ(adaptive.tolerance, 2.0);
+    EXPECT_DOUBLE_EQ(adaptive.smoothing, 0.5);
+    EXPECT_EQ(adaptive.queue_per_limit, 3u);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnMaxInFlightOutsideAdaptiveLimits) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    dispatch:\n      max_in_flight: 2\n      adaptive:\n        enabled: true\n        min_limit: 4\n        max_limit: 8\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsDispatchCallerWeights) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    dispatch:\n      caller_weights:\n        hmi: 4\n        recorder: 1\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    EXPECT_THAT(config.getCoreConfig().dispatch.caller_weights,
+                UnorderedElementsAre(Pair("hmi", 4u), Pair("recorder", 1u)));
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnZeroCallerWeight) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    dispatch:\n      caller_weights:\n        hmi: 0\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnBackgroundQueueAboveMaxQueued) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    dispatch:\n      max_queued: 4\n      background_max_queued: 8\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsIdempotencyConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    idempotency:\n      ttl_ms: 5000\n      max_entries: 100\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& idempotency = config.getCoreConfig().idempotency;
+    EXPECT_EQ(idempotency.ttl, std::chrono::milliseconds(5000));
+    EXPECT_EQ(idempotency.max_entries, 100u);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnZeroIdempotencyEntries) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    idempotency:\n      max_entries: 0\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsReconcileConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    reconcile:\n      enabled: true\n      check_interval_ms: 3000\n      settle_time_ms: 500\n      connection_poll_ms: 100\n      max_checks: 2\n      history: 8\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& reconcile = config.getCoreConfig().reconcile;
+    EXPECT_TRUE(reconcile.enabled);
+    EXPECT_EQ(reconcile.check_interval, std::chrono::milliseconds(3000));
+    EXPECT_EQ(reconcile.settle_time, std::chrono::milliseconds(500));
+    EXPECT_EQ(reconcile.connection_poll, std::chrono::milliseconds(100));
+    EXPECT_EQ(reconcile.max_checks, 2u);
+    EXPECT_EQ(reconcile.history, 8u);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnReconcilePollAboveCheckInterval) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n  core:\n    reconcile:\n      check_interval_ms: 100\n      connection_poll_ms: 500\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, LoadsControlStreamRate) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n    control_stream:\n      max_rate_hz: 50\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    EXPECT_EQ(config.getApiConfig().control_stream.max_rate_hz, 50u);
+}
+
+TEST_F(ConfigManagerTests, LoadsQuotasConfig) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n    quotas:\n      rate_hz: 50\n      burst: 100\n      max_callers: 32\n      idle_timeout_ms: 5000\n      callers:\n        - caller: recorder\n          rate_hz: 5\n          burst: 10\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    const service::common::ConfigManager config(invalid_config_path_);
+
+    const auto& quotas = config.getApiConfig().quotas;
+    EXPECT_DOUBLE_EQ(quotas.defaults.rate_hz, 50.0);
+    EXPECT_EQ(quotas.defaults.burst, 100u);
+    EXPECT_EQ(quotas.max_callers, 32u);
+    EXPECT_EQ(quotas.idle_timeout, std::chrono::milliseconds(5000));
+    ASSERT_EQ(quotas.callers.size(), 1u);
+    EXPECT_EQ(quotas.callers[0].caller, "recorder");
+    EXPECT_DOUBLE_EQ(quotas.callers[0].rate_hz, 5.0);
+    EXPECT_EQ(quotas.callers[0].burst, 10u);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnDuplicateQuotaCaller) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n    quotas:\n      callers:\n        - caller: recorder\n          rate_hz: 5\n        - caller: recorder\n          rate_hz: 10\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
+
+TEST_F(ConfigManagerTests, ThrowsOnZeroControlStreamRate) {
+    createInvalidConfig("app:\n  name: test\n  log_level: info\n  api:\n    api_type: grpc\n    server_address: localhost:50051\n    control_stream:\n      max_rate_hz: 0\n  infrastructure:\n    clients:\n      camera_service:\n        instances:\n          - id: 1\n            address: localhost:50052");
+    EXPECT_THROW({
+        service::common::ConfigManager config(invalid_config_path_);
+    }, std::runtime_error);
+}
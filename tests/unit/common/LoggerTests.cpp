@@ -14,6 +14,13 @@ public:
     MOCK_METHOD(void, logImpl, (LogLevel, const std::string&), (override));
 };
 
+class InfoLevelLoggerAdapter : public MockLoggerAdapter {
+public:
+    bool isEnabled(const LogLevel level) const override {
+        return level >= LogLevel::Info;
+    }
+};
+
 class LoggerTest: public Test {
 protected:
     void SetUp() override {
@@ -98,3 +105,14 @@ TEST_F(LoggerTest, LogWithMultipleArgs) {
     EXPECT_CALL(*mock_logger, logImpl(LoggerInterface::LogLevel::Info, ::testing::HasSubstr("Hello World 42")));
     LOG_INFO("{} {} {}", "Hello", "World", 42);
 }
+
+TEST_F(LoggerTest, DisabledLevelIsNeitherFormattedNorWritten) {
+    auto adapter = std::make_shared<NiceMock<InfoLevelLoggerAdapter>>();
+    EXPECT_CALL(*adapter, logImpl(LoggerInterface::LogLevel::Debug, _)).Times(0);
+    EXPECT_CALL(*adapter, logImpl(LoggerInterface::LogLevel::Info, HasSubstr("Value: 42")));
+    service::common::LoggerRegistry::instance().setLoggerAdapter(adapter, "info");
+
+    // Formatting would throw, the format has more fields than arguments
+    EXPECT_NO_THROW(LOG_DEBUG("{} {}", 42));
+    LOG_INFO("Value: {}", 42);
+}
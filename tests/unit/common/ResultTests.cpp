@@ -20,20 +20,20 @@ TEST_F(ResultTests, VoidResultErrorCreation) {
     const auto result = Result<void>::error("Test error");
     EXPECT_FALSE(result.isSuccess());
     EXPECT_TRUE(result.isError());
-    EXPECT_EQ(result.error(), "Test error");
+    EXPECT_EQ(result.error().message, "Test error");
 }
 
 TEST_F(ResultTests, VoidResultErrorWithEmptyString) {
     const auto result = Result<void>::error("");
     EXPECT_FALSE(result.isSuccess());
     EXPECT_TRUE(result.isError());
-    EXPECT_EQ(result.error(), "");
+    EXPECT_EQ(result.error().message, "");
 }
 
 TEST_F(ResultTests, VoidResultMoveError) {
     auto result = Result<void>::error("Test error");
     const auto error = std::move(result).error();
-    EXPECT_EQ(error, "Test error");
+    EXPECT_EQ(error.message, "Test error");
 }
 
 TEST_F(ResultTests, IntResultSuccessCreation) {
@@ -47,7 +47,19 @@ TEST_F(ResultTests, IntResultErrorCreation) {
     const auto result = Result<int>::error("Failed to get value");
     EXPECT_FALSE(result.isSuccess());
     EXPECT_TRUE(result.isError());
-    EXPECT_EQ(result.error(), "Failed to get value");
+    EXPECT_EQ(result.error().message, "Failed to get value");
+}
+
+TEST_F(ResultTests, MessageErrorsAreInternal) {
+    const auto result = Result<int>::error("Failed to get value");
+    EXPECT_EQ(result.error().code, common::types::ErrorCode::Internal);
+}
+
+TEST_F(ResultTests, PrefixedErrorKeepsItsCode) {
+    const common::types::Error error(common::types::ErrorCode::ControlledByAnotherClient, "held");
+    const auto result = Result<int>::error(error.prefixed("Camera 1: "));
+    EXPECT_EQ(result.error().code, common::types::ErrorCode::ControlledByAnotherClient);
+    EXPECT_EQ(result.error().message, "Camera 1: held");
 }
 
 TEST_F(ResultTests, StringResultSuccessCreation) {
@@ -151,7 +163,7 @@ TEST_F(ResultTests, MoveSemantics) {
 TEST_F(ResultTests, ErrorMoveSemantics) {
     auto result = Result<int>::error("error message");
     auto moved_error = std::move(result).error();
-    EXPECT_EQ(moved_error, "error message");
+    EXPECT_EQ(moved_error.message, "error message");
 }
 
 TEST_F(ResultTests, ZoomTypeSuccess) {
@@ -169,13 +181,13 @@ TEST_F(ResultTests, FocusTypeSuccess) {
 TEST_F(ResultTests, ZoomTypeError) {
     const auto result = Result<common::types::zoom>::error("Invalid zoom value");
     EXPECT_TRUE(result.isError());
-    EXPECT_EQ(result.error(), "Invalid zoom value");
+    EXPECT_EQ(result.error().message, "Invalid zoom value");
 }
 
 TEST_F(ResultTests, FocusTypeError) {
     const auto result = Result<common::types::focus>::error("Invalid focus value");
     EXPECT_TRUE(result.isError());
-    EXPECT_EQ(result.error(), "Invalid focus value");
+    EXPECT_EQ(result.error().message, "Invalid focus value");
 }
 
 TEST_F(ResultTests, CustomErrorType) {
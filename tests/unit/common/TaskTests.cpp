@@ -0,0 +1,179 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <coroutine>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "common/async/Task.h"
+#include "common/types/Result.h"
+
+using namespace service;
+using namespace testing;
+using common::async::Task;
+
+namespace {
+    /**
+     * Resume the awaiting coroutine from a new thread after a delay, as a backend call completing would
+     */
+    struct ResumeOnThread {
+        std::chrono::milliseconds delay;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const {
+            std::thread([handle, delay = delay] {
+                std::this_thread::sleep_for(delay);
+                handle.resume();
+            }).detach();
+        }
+
+        void await_resume() const noexcept {
+        }
+    };
+
+    Task<Result<int>> immediate(const int value) {
+        co_return Result<int>::success(value);
+    }
+
+    Task<Result<int>> later(const int value, const std::chrono::milliseconds delay) {
+        co_await ResumeOnThread{delay};
+        co_return Result<int>::success(value);
+    }
+
+    Task<Result<std::thread::id>> threadAfterResume() {
+        co_await ResumeOnThread{std::chrono::milliseconds(1)};
+        co_return Result<std::thread::id>::success(std::this_thread::get_id());
+    }
+
+    Task<Result<int>> doubled(Task<Result<int>> task) {
+        auto result = co_await std::move(task);
+        if (result.isError()) {
+            co_return result;
+        }
+        co_return Result<int>::success(result.value() * 2);
+    }
+
+    Task<Result<int>> failing() {
+        co_await ResumeOnThread{std::chrono::milliseconds(1)};
+        throw std::runtime_error("backend gone");
+    }
+} // unnamed namespace
+
+class TaskTests : public Test {
+};
+
+TEST_F(TaskTests, SyncWaitReturnsTheValueOfATaskThatNeverSuspends) {
+    const auto result = common::async::syncWait(immediate(7));
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(result.value(), 7);
+}
+
+TEST_F(TaskTests, TaskDoesNotRunUntilAwaited) {
+    bool ran = false;
+    auto task = [](bool& flag) -> Task<Result<void>> {
+        flag = true;
+        co_return Result<void>::success();
+    }(ran);
+    EXPECT_FALSE(ran);
+
+    EXPECT_TRUE(common::async::syncWait(std::move(task)).isSuccess());
+    EXPECT_TRUE(ran);
+}
+
+TEST_F(TaskTests, AwaitingCoroutineContinuesOnTheThreadThatResumedTheTask) {
+    const auto result = common::async::syncWait(threadAfterResume());
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_NE(result.value(), std::this_thread::get_id());
+}
+
+TEST_F(TaskTests, ChainedTasksPassValuesAcrossThreads) {
+    const auto result = common::async::syncWait(doubled(later(21, std::chrono::milliseconds(1))));
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(result.value(), 42);
+}
+
+TEST_F(TaskTests, SyncWaitRethrowsAnExceptionOfTheTask) {
+    EXPECT_THROW(common::async::syncWait(failing()), std::runtime_error);
+}
+
+TEST_F(TaskTests, StartCallsDoneWhenTheTaskEnds) {
+    std::promise<int> done;
+    common::async::start(later(5, std::chrono::milliseconds(1)), [&done](Result<int> result) {
+        done.set_value(result.value());
+    });
+
+    auto value = done.get_future();
+    ASSERT_EQ(value.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_EQ(value.get(), 5);
+}
+
+TEST_F(TaskTests, WhenAllRunsTasksConcurrentlyAndKeepsTheirOrder) {
+    std::vector<Task<Result<int>>> tasks;
+    for (int i = 0; i < 8; ++i) {
+        tasks.push_back(later(i, std::chrono::milliseconds(50 - i * 5)));
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto results = common::async::syncWait(common::async::whenAll(std::move(tasks)));
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    ASSERT_EQ(results.size(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(results[i].isSuccess());
+        EXPECT_EQ(results[i].value(), i);
+    }
+    // One after the other they take 260 ms
+    EXPECT_LT(elapsed, std::chrono::milliseconds(200));
+}
+
+TEST_F(TaskTests, WhenAllOfTasksThatNeverSuspend) {
+    std::vector<Task<Result<int>>> tasks;
+    tasks.push_back(immediate(1));
+    tasks.push_back(immediate(2));
+
+    const auto results = common::async::syncWait(common::async::whenAll(std::move(tasks)));
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].value(), 1);
+    EXPECT_EQ(results[1].value(), 2);
+}
+
+TEST_F(TaskTests, WhenAllOfNoTasks) {
+    const auto results = common::async::syncWait(common::async::whenAll(std::vector<Task<Result<int>>>{}));
+    EXPECT_TRUE(results.empty());
+}
+
+TEST_F(TaskTests, WhenAllRethrowsAfterEveryTaskEnded) {
+    std::vector<Task<Result<int>>> tasks;
+    tasks.push_back(later(1, std::chrono::milliseconds(20)));
+    tasks.push_back(failing());
+
+    EXPECT_THROW(common::async::syncWait(common::async::whenAll(std::move(tasks))), std::runtime_error);
+}
+
+TEST_F(TaskTests, FromCallbackResumesWithTheValueDeliveredOnAnotherThread) {
+    const auto caller = std::this_thread::get_id();
+    const auto result = common::async::syncWait(common::async::fromCallback<Result<std::thread::id>>(
+        [](auto complete) {
+            std::thread([complete = std::move(complete)]() mutable {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                complete(Result<std::thread::id>::success(std::this_thread::get_id()));
+            }).detach();
+        }));
+
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_NE(result.value(), caller);
+}
+
+TEST_F(TaskTests, FromCallbackCompletedBeforeArmReturns) {
+    const auto result = common::async::syncWait(common::async::fromCallback<Result<int>>([](auto complete) {
+        complete(Result<int>::success(3));
+    }));
+
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(result.value(), 3);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+/* Add your project include files here */
+#include "core/dispatch/AdaptiveLimit.h"
+
+using namespace testing;
+using namespace service;
+
+class AdaptiveLimitTests : public Test {
+protected:
+    void SetUp() override {
+        config_.enabled = true;
+        config_.min_limit = 1;
+        config_.max_limit = 16;
+        config_.tolerance = 1.5;
+        config_.smoothing = 1.0;
+    }
+
+    common::AdaptiveConcurrencyConfig config_;
+};
+
+TEST_F(AdaptiveLimitTests, GrowsByOneCallPerSampleWhileLatencyHolds) {
+    config_.max_limit = 4;
+    core::AdaptiveLimit limit(config_, 1);
+
+    limit.sample(std::chrono::milliseconds(1), 1);
+    EXPECT_EQ(limit.limit(), 2u);
+    limit.sample(std::chrono::milliseconds(1), 2);
+    limit.sample(std::chrono::milliseconds(1), 3);
+    limit.sample(std::chrono::milliseconds(1), 4);
+    EXPECT_EQ(limit.limit(), 4u);
+}
+
+TEST_F(AdaptiveLimitTests, DoesNotGrowWhileMostOfTheLimitIsUnused) {
+    core::AdaptiveLimit limit(config_, 8);
+
+    for (int call = 0; call < 10; ++call) {
+        limit.sample(std::chrono::milliseconds(1), 3);
+    }
+
+    EXPECT_EQ(limit.limit(), 8u);
+}
+
+TEST_F(AdaptiveLimitTests, LatencyWithinToleranceStillCountsAsUnloaded) {
+    core::AdaptiveLimit limit(config_, 8);
+    limit.sample(std::chrono::milliseconds(10), 1);
+
+    limit.sample(std::chrono::milliseconds(14), 8);
+
+    EXPECT_EQ(limit.limit(), 9u);
+}
+
+TEST_F(AdaptiveLimitTests, HalvesAtMostPerSample) {
+    core::AdaptiveLimit limit(config_, 8);
+    limit.sample(std::chrono::milliseconds(1), 1);
+
+    limit.sample(std::chrono::seconds(1), 8);
+
+    EXPECT_EQ(limit.limit(), 4u);
+}
+
+TEST_F(AdaptiveLimitTests, ShrinksToTheMinimumWhileLatencyStaysHigh) {
+    config_.min_limit = 2;
+    core::AdaptiveLimit limit(config_, 16);
+    limit.sample(std::chrono::milliseconds(1), 1);
+
+    for (int call = 0; call < 20; ++call) {
+        limit.sample(std::chrono::milliseconds(10), 16);
+    }
+
+    EXPECT_EQ(limit.limit(), 2u);
+}
+
+TEST_F(AdaptiveLimitTests, SmoothingSpreadsAChangeOverSamples) {
+    config_.smoothing = 0.5;
+    core::AdaptiveLimit limit(config_, 8);
+    limit.sample(std::chrono::milliseconds(1), 1);
+
+    limit.sample(std::chrono::seconds(1), 8);
+
+    EXPECT_EQ(limit.limit(), 6u);
+}
+
+TEST_F(AdaptiveLimitTests, BaselineFollowsLowerLatencyAtOnceAndHigherSlowly) {
+    core::AdaptiveLimit limit(config_, 4);
+    limit.sample(std::chrono::milliseconds(8), 1);
+    for (int call = 0; call < 20; ++call) {
+        limit.sample(std::chrono::milliseconds(2), 1);
+    }
+    EXPECT_LT(limit.baseline(), std::chrono::microseconds(2100));
+
+    for (int call = 0; call < 20; ++call) {
+        limit.sample(std::chrono::milliseconds(20), 1);
+    }
+    EXPECT_LT(limit.baseline(), std::chrono::milliseconds(3));
+    EXPECT_GT(limit.latency(), std::chrono::milliseconds(19));
+}
@@ -0,0 +1,428 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "common/async/Task.h"
+#include "core/dispatch/CameraDispatcher.h"
+
+using namespace testing;
+using namespace service;
+
+class CameraDispatcherTests : public Test {
+protected:
+    using Priority = common::types::Priority;
+
+    void SetUp() override {
+        config_.max_in_flight = 1;
+        config_.max_queued = 3;
+        config_.background_max_queued = 2;
+        dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+    }
+
+    /**
+     * Queue a call on its own thread, it records its class once admitted or shed
+     */
+    void queue(const Priority priority, const std::string& caller = {}) {
+        callers_.emplace_back([this, priority, caller] {
+            const auto ticket = dispatcher_->admit(CAMERA_ID, {.priority = priority, .caller = caller});
+            std::lock_guard lock(mutex_);
+            if (ticket.admitted()) {
+                admitted_.push_back(priority);
+                admitted_callers_.push_back(caller);
+            } else {
+                shed_.push_back(priority);
+                shed_callers_.push_back(caller);
+            }
+        });
+        // Let the caller reach the queue before the next one arrives
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    void joinCallers() {
+        callers_.clear();
+    }
+
+    static constexpr uint32_t CAMERA_ID = 3;
+
+    common::DispatchConfig config_;
+    std::unique_ptr<core::CameraDispatcher> dispatcher_;
+    std::mutex mutex_;
+    std::vector<Priority> admitted_;
+    std::vector<Priority> shed_;
+    std::vector<std::string> admitted_callers_;
+    std::vector<std::string> shed_callers_;
+    std::vector<std::jthread> callers_;
+};
+
+TEST_F(CameraDispatcherTests, AdmitsUpToMaxInFlightAtOnce) {
+    config_.max_in_flight = 2;
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+
+    const auto first = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+    const auto second = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+
+    EXPECT_TRUE(first.admitted());
+    EXPECT_TRUE(second.admitted());
+    EXPECT_TRUE(second.error().message.empty());
+}
+
+TEST_F(CameraDispatcherTests, ServesHigherClassesFirstAndArrivalOrderWithinAClass) {
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Background);
+        queue(Priority::Normal);
+        queue(Priority::Interactive);
+    }
+    joinCallers();
+
+    EXPECT_THAT(admitted_, ElementsAre(Priority::Interactive, Priority::Normal, Priority::Background));
+    EXPECT_TRUE(shed_.empty());
+}
+
+TEST_F(CameraDispatcherTests, ShedsBackgroundCallsBeyondTheirQueue) {
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Background);
+        queue(Priority::Background);
+
+        const auto shed = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Background});
+        EXPECT_FALSE(shed.admitted());
+        EXPECT_THAT(shed.error().message, HasSubstr("overloaded"));
+        EXPECT_EQ(shed.error().code, common::types::ErrorCode::CallShed);
+    }
+    joinCallers();
+
+    EXPECT_EQ(admitted_.size(), 2u);
+}
+
+TEST_F(CameraDispatcherTests, FullQueueEvictsTheNewestWaiterOfTheLowestClass) {
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Background);
+        queue(Priority::Normal);
+        queue(Priority::Background);
+        queue(Priority::Interactive);
+    }
+    joinCallers();
+
+    EXPECT_THAT(shed_, ElementsAre(Priority::Background));
+    EXPECT_THAT(admitted_, ElementsAre(Priority::Interactive, Priority::Normal, Priority::Background));
+}
+
+TEST_F(CameraDispatcherTests, FullQueueShedsAnArrivalWithNothingBelowIt) {
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Interactive);
+        queue(Priority::Normal);
+        queue(Priority::Normal);
+
+        const auto shed = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        EXPECT_FALSE(shed.admitted());
+    }
+    joinCallers();
+
+    EXPECT_EQ(admitted_.size(), 3u);
+}
+
+TEST_F(CameraDispatcherTests, CallersOfAClassAreServedInTurn) {
+    config_.max_queued = 8;
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Normal, "poller");
+        queue(Priority::Normal, "poller");
+        queue(Priority::Normal, "poller");
+        queue(Priority::Normal, "hmi");
+    }
+    joinCallers();
+
+    EXPECT_THAT(admitted_callers_, ElementsAre("poller", "hmi", "poller", "poller"));
+}
+
+TEST_F(CameraDispatcherTests, CallerWeightsSetTheirShareOfTurns) {
+    config_.max_queued = 8;
+    config_.caller_weights["hmi"] = 2;
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Normal, "poller");
+        queue(Priority::Normal, "poller");
+        queue(Priority::Normal, "hmi");
+        queue(Priority::Normal, "hmi");
+        queue(Priority::Normal, "hmi");
+    }
+    joinCallers();
+
+    EXPECT_THAT(admitted_callers_, ElementsAre("poller", "hmi", "hmi", "poller", "hmi"));
+}
+
+TEST_F(CameraDispatcherTests, FullQueueEvictsFromTheBusiestCaller) {
+    config_.background_max_queued = 3;
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Background, "poller");
+        queue(Priority::Background, "logger");
+        queue(Priority::Background, "poller");
+        queue(Priority::Normal, "hmi");
+    }
+    joinCallers();
+
+    EXPECT_THAT(shed_callers_, ElementsAre("poller"));
+    EXPECT_THAT(admitted_callers_, ElementsAre("hmi", "poller", "logger"));
+}
+
+TEST_F(CameraDispatcherTests, MetricsAreKeptPerCaller) {
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal, .caller = "hmi"});
+        queue(Priority::Background, "poller");
+        queue(Priority::Background, "poller");
+        const auto shed = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Background, .caller = "poller"});
+    }
+    joinCallers();
+
+    const auto metrics = dispatcher_->metrics();
+    ASSERT_EQ(metrics.callers.size(), 2u);
+    EXPECT_EQ(metrics.callers[0].caller, "hmi");
+    EXPECT_EQ(metrics.callers[0].admitted, 1u);
+    EXPECT_EQ(metrics.callers[1].caller, "poller");
+    EXPECT_EQ(metrics.callers[1].admitted, 2u);
+    EXPECT_EQ(metrics.callers[1].shed, 1u);
+    EXPECT_EQ(metrics.callers[1].queue_wait.count, 2u);
+}
+
+TEST_F(CameraDispatcherTests, CallersPastTheCapShareOneEntry) {
+    config_.max_callers = 2;
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+
+    for (const auto* const caller : {"hmi", "recorder", "client-1", "client-2", "hmi"}) {
+        const auto ticket = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal, .caller = caller});
+        ASSERT_TRUE(ticket.admitted());
+    }
+
+    const auto metrics = dispatcher_->metrics();
+    ASSERT_EQ(metrics.callers.size(), 3u);
+    EXPECT_EQ(metrics.callers[0].caller, core::CameraDispatcher::OTHER_CALLERS);
+    EXPECT_EQ(metrics.callers[0].admitted, 2u);
+    EXPECT_EQ(metrics.callers[1].caller, "hmi");
+    EXPECT_EQ(metrics.callers[1].admitted, 2u);
+    EXPECT_EQ(metrics.callers[2].caller, "recorder");
+}
+
+TEST_F(CameraDispatcherTests, CallerMetricsAddUpAcrossCameras) {
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID, CAMERA_ID + 1}, config_);
+
+    for (const auto camera_id : {CAMERA_ID, CAMERA_ID + 1, CAMERA_ID + 2}) {
+        const auto ticket = dispatcher_->admit(camera_id, {.priority = Priority::Normal, .caller = "hmi"});
+        ASSERT_TRUE(ticket.admitted());
+    }
+
+    const auto metrics = dispatcher_->metrics();
+    ASSERT_EQ(metrics.callers.size(), 1u);
+    EXPECT_EQ(metrics.callers[0].caller, "hmi");
+    EXPECT_EQ(metrics.callers[0].admitted, 3u);
+    EXPECT_EQ(metrics.callers[0].queue_wait.count, 3u);
+    EXPECT_EQ(metrics.cameras.size(), 2u);
+}
+
+TEST_F(CameraDispatcherTests, CallsToUngatedCamerasAreAdmittedAtOnce) {
+    const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+
+    const auto other = dispatcher_->admit(CAMERA_ID + 1, {.priority = Priority::Background});
+    const auto another = dispatcher_->admit(CAMERA_ID + 1, {.priority = Priority::Background});
+
+    EXPECT_TRUE(other.admitted());
+    EXPECT_TRUE(another.admitted());
+}
+
+TEST_F(CameraDispatcherTests, WithoutMaxInFlightNoCameraIsGated) {
+    config_.max_in_flight = 0;
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+
+    const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+    const auto other = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Background});
+
+    EXPECT_TRUE(running.admitted());
+    EXPECT_TRUE(other.admitted());
+    EXPECT_TRUE(dispatcher_->metrics().cameras.empty());
+}
+
+TEST_F(CameraDispatcherTests, ShedsAWaiterWhoseDeadlinePasses) {
+    const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+
+    const auto arrived = std::chrono::steady_clock::now();
+    const auto late = dispatcher_->admit(
+        CAMERA_ID, {.priority = Priority::Normal, .deadline = arrived + std::chrono::milliseconds(50)});
+
+    EXPECT_FALSE(late.admitted());
+    EXPECT_THAT(late.error().message, HasSubstr("deadline"));
+    EXPECT_GE(std::chrono::steady_clock::now() - arrived, std::chrono::milliseconds(50));
+    const auto metrics = dispatcher_->metrics();
+    ASSERT_EQ(metrics.cameras.size(), 1u);
+    EXPECT_EQ(metrics.cameras.front().queued, 0u);
+}
+
+TEST_F(CameraDispatcherTests, SlotOfAnExpiredWaiterGoesToTheNext) {
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        callers_.emplace_back([this] {
+            const auto ticket = dispatcher_->admit(
+                CAMERA_ID, {.priority = Priority::Interactive,
+                            .deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(20)});
+            EXPECT_FALSE(ticket.admitted());
+        });
+        queue(Priority::Normal);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+    joinCallers();
+
+    EXPECT_THAT(admitted_, ElementsAre(Priority::Normal));
+    EXPECT_EQ(dispatcher_->metrics().cameras.front().in_flight, 0u);
+}
+
+TEST_F(CameraDispatcherTests, AwaitingCallResumesWhenASlotFrees) {
+    core::CommandScheduler scheduler(std::chrono::milliseconds(1));
+    std::promise<bool> outcome;
+    auto resumed = outcome.get_future();
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        common::async::start(dispatcher_->admitAsync(CAMERA_ID, {.priority = Priority::Normal}, scheduler),
+                             [&outcome](const core::CameraDispatcher::Ticket& ticket) {
+                                 outcome.set_value(ticket.admitted());
+                             });
+
+        EXPECT_EQ(resumed.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+        EXPECT_EQ(dispatcher_->metrics().cameras.front().queued, 1u);
+    }
+
+    ASSERT_EQ(resumed.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_TRUE(resumed.get());
+    EXPECT_EQ(dispatcher_->metrics().cameras.front().in_flight, 0u);
+}
+
+TEST_F(CameraDispatcherTests, ShedsAnAwaitingCallWhoseDeadlinePasses) {
+    core::CommandScheduler scheduler(std::chrono::milliseconds(1));
+    std::promise<std::string> outcome;
+    auto resumed = outcome.get_future();
+    const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+
+    common::async::start(
+        dispatcher_->admitAsync(
+            CAMERA_ID,
+            {.priority = Priority::Normal, .deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50)},
+            scheduler),
+        [&outcome](const core::CameraDispatcher::Ticket& ticket) {
+            outcome.set_value(ticket.admitted() ? std::string() : ticket.error().message);
+        });
+
+    ASSERT_EQ(resumed.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_THAT(resumed.get(), HasSubstr("deadline"));
+    EXPECT_EQ(dispatcher_->metrics().cameras.front().queued, 0u);
+}
+
+TEST_F(CameraDispatcherTests, MetricsAreKeptPerClass) {
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Interactive});
+        queue(Priority::Background);
+        queue(Priority::Background);
+        const auto shed = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Background});
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    joinCallers();
+
+    const auto metrics = dispatcher_->metrics();
+    const auto& interactive = metrics.classes[static_cast<std::size_t>(Priority::Interactive)];
+    const auto& background = metrics.classes[static_cast<std::size_t>(Priority::Background)];
+    EXPECT_EQ(interactive.priority, Priority::Interactive);
+    EXPECT_EQ(interactive.admitted, 1u);
+    EXPECT_EQ(interactive.latency.count, 1u);
+    EXPECT_GE(interactive.latency.max, std::chrono::milliseconds(40));
+    EXPECT_EQ(background.admitted, 2u);
+    EXPECT_EQ(background.shed, 1u);
+    EXPECT_EQ(background.queue_wait.count, 2u);
+    EXPECT_GE(background.queue_wait.max, std::chrono::milliseconds(30));
+    EXPECT_LE(background.queue_wait.p50, background.queue_wait.max);
+    EXPECT_EQ(metrics.classes[static_cast<std::size_t>(Priority::Normal)].admitted, 0u);
+}
+
+TEST_F(CameraDispatcherTests, MetricsReportTheFixedLimitOfEachCamera) {
+    const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+
+    const auto metrics = dispatcher_->metrics();
+
+    ASSERT_EQ(metrics.cameras.size(), 1u);
+    EXPECT_EQ(metrics.cameras[0].camera_id, CAMERA_ID);
+    EXPECT_EQ(metrics.cameras[0].limit, 1u);
+    EXPECT_EQ(metrics.cameras[0].in_flight, 1u);
+    EXPECT_FALSE(metrics.cameras[0].adaptive);
+}
+
+TEST_F(CameraDispatcherTests, AdaptiveLimitShrinksWhenLatencyRises) {
+    config_.max_in_flight = 4;
+    config_.adaptive = {.enabled = true, .min_limit = 1, .max_limit = 4, .smoothing = 1.0};
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+
+    {
+        const auto fast = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        dispatcher_->sample(CAMERA_ID, std::chrono::milliseconds(1));
+    }
+    {
+        const auto slow = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        dispatcher_->sample(CAMERA_ID, std::chrono::milliseconds(100));
+    }
+
+    const auto metrics = dispatcher_->metrics();
+    ASSERT_EQ(metrics.cameras.size(), 1u);
+    const auto& camera = metrics.cameras[0];
+    EXPECT_TRUE(camera.adaptive);
+    EXPECT_EQ(camera.limit, 2u);
+    EXPECT_EQ(camera.decreases, 1u);
+    EXPECT_EQ(camera.increases, 0u);
+    EXPECT_LT(camera.baseline, camera.latency);
+
+    {
+        const auto first = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        const auto second = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Normal);
+        std::lock_guard lock(mutex_);
+        EXPECT_TRUE(admitted_.empty());
+    }
+    joinCallers();
+    EXPECT_THAT(admitted_, ElementsAre(Priority::Normal));
+}
+
+TEST_F(CameraDispatcherTests, AdaptiveLimitIgnoresTimeHeldBeforeTheBackendCall) {
+    config_.max_in_flight = 4;
+    config_.adaptive = {.enabled = true, .min_limit = 1, .max_limit = 4, .smoothing = 1.0};
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+
+    for (int call = 0; call < 2; ++call) {
+        const auto ticket = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        std::this_thread::sleep_for(call == 0 ? std::chrono::milliseconds(1) : std::chrono::milliseconds(100));
+        dispatcher_->sample(CAMERA_ID, std::chrono::milliseconds(1));
+    }
+
+    const auto metrics = dispatcher_->metrics();
+    ASSERT_EQ(metrics.cameras.size(), 1u);
+    EXPECT_EQ(metrics.cameras[0].limit, 4u);
+    EXPECT_EQ(metrics.cameras[0].decreases, 0u);
+}
+
+TEST_F(CameraDispatcherTests, AdaptiveQueueIsBoundedByTheLimit) {
+    config_.adaptive = {.enabled = true, .min_limit = 1, .max_limit = 4, .queue_per_limit = 1};
+    dispatcher_ = std::make_unique<core::CameraDispatcher>(std::vector<uint32_t>{CAMERA_ID}, config_);
+
+    {
+        const auto running = dispatcher_->admit(CAMERA_ID, {.priority = Priority::Normal});
+        queue(Priority::Normal, "first");
+        queue(Priority::Normal, "second");
+    }
+    joinCallers();
+
+    EXPECT_THAT(admitted_callers_, ElementsAre("first"));
+    EXPECT_THAT(shed_callers_, ElementsAre("second"));
+}
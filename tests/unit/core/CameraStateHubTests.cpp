@@ -0,0 +1,299 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+/* Add your project include files here */
+#include "core/state/CameraStateHub.h"
+
+using namespace testing;
+using namespace service;
+
+class CameraStateHubTests : public Test {
+protected:
+    void SetUp() override {
+        config_.poll_min = std::chrono::milliseconds(10);
+        config_.poll_max = std::chrono::milliseconds(40);
+        config_.queue_size = 2;
+    }
+
+    core::CameraStateHub::RefreshFunction fakeBackend() {
+        return [this](uint32_t) {
+            ++polls_;
+            std::lock_guard lock(mutex_);
+            return backend_state_;
+        };
+    }
+
+    void setBackendZoom(const common::types::zoom zoom_level) {
+        std::lock_guard lock(mutex_);
+        backend_state_.zoom_level = zoom_level;
+    }
+
+    static std::optional<common::types::CameraStateUpdate> waitForUpdate(
+        common::state::CameraStateSubscription& subscription) {
+        for (int attempt = 0; attempt < 200; ++attempt) {
+            if (auto update = subscription.poll()) {
+                return update;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return std::nullopt;
+    }
+
+    common::StateHubConfig config_;
+    std::atomic<int> polls_{0};
+    std::mutex mutex_;
+    common::types::CameraState backend_state_{.zoom_level = 10, .focus_value = 20,
+                                              .auto_focus = false, .stabilization = true};
+};
+
+TEST_F(CameraStateHubTests, StartsWithSnapshotThenSendsOnlyDeltas) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 10, .focus_value = 20, .auto_focus = false, .stabilization = true});
+
+    const auto subscription = hub.subscribe(0, common::types::ALL_CAMERA_STATE_FIELDS);
+    const auto snapshot = subscription->poll();
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_TRUE(snapshot->snapshot);
+    EXPECT_EQ(snapshot->state.zoom_level, 10u);
+    EXPECT_EQ(snapshot->state.stabilization, true);
+
+    EXPECT_TRUE(hub.publish(0, {.zoom_level = 30, .focus_value = 20}));
+    const auto delta = subscription->poll();
+    ASSERT_TRUE(delta.has_value());
+    EXPECT_FALSE(delta->snapshot);
+    EXPECT_EQ(delta->state, (common::types::CameraState{.zoom_level = 30}));
+}
+
+TEST_F(CameraStateHubTests, UnchangedValuesAreNotPublished) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 10});
+    const auto subscription = hub.subscribe(0, common::types::ALL_CAMERA_STATE_FIELDS);
+    ASSERT_TRUE(subscription->poll().has_value());
+
+    EXPECT_FALSE(hub.publish(0, {.zoom_level = 10}));
+    EXPECT_FALSE(subscription->poll().has_value());
+}
+
+TEST_F(CameraStateHubTests, FieldMaskFiltersDeltas) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 10, .focus_value = 20});
+    const auto subscription =
+        hub.subscribe(0, static_cast<common::types::CameraStateFields>(common::types::CameraStateField::Focus));
+
+    const auto snapshot = subscription->poll();
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_EQ(snapshot->state, (common::types::CameraState{.focus_value = 20}));
+
+    hub.publish(0, {.zoom_level = 50});
+    EXPECT_FALSE(subscription->poll().has_value());
+}
+
+TEST_F(CameraStateHubTests, SlowSubscriberGetsConflatedLatestState) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 0});
+    const auto subscription = hub.subscribe(0, common::types::ALL_CAMERA_STATE_FIELDS);
+
+    for (common::types::zoom zoom_level = 1; zoom_level <= 50; ++zoom_level) {
+        hub.publish(0, {.zoom_level = zoom_level});
+    }
+    hub.publish(0, {.focus_value = 7});
+
+    ASSERT_TRUE(subscription->poll().has_value()); // snapshot
+    const auto latest = subscription->poll();
+    ASSERT_TRUE(latest.has_value());
+    EXPECT_EQ(latest->state.zoom_level, 50u);
+    EXPECT_EQ(latest->state.focus_value, 7u);
+    EXPECT_FALSE(subscription->poll().has_value());
+}
+
+TEST_F(CameraStateHubTests, PollsWatchedCamerasAndPublishesBackendChanges) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    const auto subscription = hub.subscribe(0, common::types::ALL_CAMERA_STATE_FIELDS);
+    ASSERT_TRUE(subscription->poll().has_value());
+
+    // First poll brings in the backend state
+    auto update = waitForUpdate(*subscription);
+    ASSERT_TRUE(update.has_value());
+    EXPECT_EQ(update->state.zoom_level, 10u);
+
+    setBackendZoom(80);
+    update = waitForUpdate(*subscription);
+    ASSERT_TRUE(update.has_value());
+    EXPECT_EQ(update->state, (common::types::CameraState{.zoom_level = 80}));
+}
+
+TEST_F(CameraStateHubTests, UnwatchedCamerasAreNotPolled) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 10});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(polls_.load(), 0);
+
+    auto subscription = hub.subscribe(0, common::types::ALL_CAMERA_STATE_FIELDS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_GT(polls_.load(), 0);
+
+    subscription->cancel();
+    subscription.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto polls_after_cancel = polls_.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(polls_.load(), polls_after_cancel);
+    EXPECT_EQ(hub.subscriberCount(0), 0u);
+}
+
+TEST_F(CameraStateHubTests, PollingBacksOffWhileNothingChanges) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, backend_state_);
+    const auto subscription = hub.subscribe(0, common::types::ALL_CAMERA_STATE_FIELDS);
+
+    // 10 ms interval would poll ~30 times in 300 ms, backing off to 40 ms leaves fewer than 15
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_GT(polls_.load(), 2);
+    EXPECT_LT(polls_.load(), 15);
+}
+
+TEST_F(CameraStateHubTests, ListenerIsNotifiedOfUpdates) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, backend_state_);
+    const auto subscription = hub.subscribe(0, common::types::ALL_CAMERA_STATE_FIELDS);
+
+    std::atomic<int> notifications{0};
+    subscription->setListener([&notifications] { ++notifications; });
+    EXPECT_EQ(notifications.load(), 1); // pending snapshot
+
+    ASSERT_TRUE(subscription->poll().has_value());
+    hub.publish(0, {.stabilization = false});
+    EXPECT_EQ(notifications.load(), 2);
+}
+
+TEST_F(CameraStateHubTests, DestroyingHubClosesSubscriptions) {
+    auto hub = std::make_unique<core::CameraStateHub>(config_, fakeBackend());
+    const auto subscription = hub->subscribe(0, common::types::ALL_CAMERA_STATE_FIELDS);
+
+    hub.reset();
+
+    EXPECT_TRUE(subscription->isClosed());
+}
+
+TEST_F(CameraStateHubTests, GenerationAdvancesOnlyWhenAFieldChanges) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    EXPECT_EQ(hub.versioned(0, common::types::CameraStateField::Zoom).generation, 0u);
+
+    hub.publish(0, {.zoom_level = 10, .focus_value = 20});
+    const auto zoom = hub.versioned(0, common::types::CameraStateField::Zoom);
+    const auto focus = hub.versioned(0, common::types::CameraStateField::Focus);
+    ASSERT_TRUE(zoom.value.has_value());
+    EXPECT_EQ(std::get<uint32_t>(*zoom.value), 10u);
+    EXPECT_GT(zoom.generation, 0u);
+
+    hub.publish(0, {.zoom_level = 10});
+    EXPECT_EQ(hub.versioned(0, common::types::CameraStateField::Zoom).generation, zoom.generation);
+
+    hub.publish(0, {.zoom_level = 30});
+    EXPECT_GT(hub.versioned(0, common::types::CameraStateField::Zoom).generation, zoom.generation);
+    EXPECT_EQ(hub.versioned(0, common::types::CameraStateField::Focus).generation, focus.generation);
+}
+
+TEST_F(CameraStateHubTests, VideoCapabilityStatesCarryGenerations) {
+    core::CameraStateHub hub(config_, fakeBackend());
+
+    EXPECT_TRUE(hub.publishVideoState(0, "hdr", false));
+    const auto first = hub.versioned(0, std::string("hdr"));
+    ASSERT_TRUE(first.value.has_value());
+    EXPECT_FALSE(std::get<bool>(*first.value));
+
+    EXPECT_FALSE(hub.publishVideoState(0, "hdr", false));
+    EXPECT_TRUE(hub.publishVideoState(0, "hdr", true));
+    EXPECT_GT(hub.versioned(0, std::string("hdr")).generation, first.generation);
+    EXPECT_EQ(hub.versioned(0, std::string("osd")).generation, 0u);
+}
+
+TEST_F(CameraStateHubTests, WaitForChangeWakesOnPublish) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 10});
+    const auto generation = hub.versioned(0, common::types::CameraStateField::Zoom).generation;
+
+    std::jthread publisher([&hub] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        hub.publish(0, {.zoom_level = 20});
+    });
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto current = hub.waitForChange(0, common::types::CameraStateField::Zoom, generation,
+                                           started + std::chrono::seconds(5));
+    ASSERT_TRUE(current.has_value());
+    EXPECT_NE(*current, generation);
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(1));
+}
+
+TEST_F(CameraStateHubTests, WaitForChangeReturnsAtDeadline) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 10});
+    const auto generation = hub.versioned(0, common::types::CameraStateField::Zoom).generation;
+
+    const auto current = hub.waitForChange(0, common::types::CameraStateField::Zoom, generation,
+                                           std::chrono::steady_clock::now() + std::chrono::milliseconds(30));
+    ASSERT_TRUE(current.has_value());
+    EXPECT_EQ(*current, generation);
+}
+
+TEST_F(CameraStateHubTests, OnChangeEndsOnThePublishingThread) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 10});
+    const auto generation = hub.versioned(0, common::types::CameraStateField::Zoom).generation;
+
+    std::promise<std::thread::id> ended_on;
+    hub.onChange(0, common::types::CameraStateField::Zoom, generation,
+                 std::chrono::steady_clock::now() + std::chrono::seconds(5),
+                 [&ended_on](const std::optional<common::types::Generation> current) {
+                     EXPECT_TRUE(current.has_value());
+                     ended_on.set_value(std::this_thread::get_id());
+                 });
+
+    std::thread::id publisher_id;
+    std::jthread publisher([&hub, &publisher_id] {
+        publisher_id = std::this_thread::get_id();
+        hub.publish(0, {.zoom_level = 20});
+    });
+    publisher.join();
+
+    auto ended = ended_on.get_future();
+    ASSERT_EQ(ended.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    EXPECT_EQ(ended.get(), publisher_id);
+}
+
+TEST_F(CameraStateHubTests, OnChangeEndsAtDeadlineWithTheSameGeneration) {
+    core::CameraStateHub hub(config_, fakeBackend());
+    hub.publish(0, {.zoom_level = 10});
+    const auto generation = hub.versioned(0, common::types::CameraStateField::Zoom).generation;
+
+    std::promise<std::optional<common::types::Generation>> ended;
+    const auto started = std::chrono::steady_clock::now();
+    hub.onChange(0, common::types::CameraStateField::Zoom, generation, started + std::chrono::milliseconds(30),
+                 [&ended](const std::optional<common::types::Generation> current) { ended.set_value(current); });
+
+    auto current = ended.get_future();
+    ASSERT_EQ(current.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_GE(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(30));
+    const auto value = current.get();
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, generation);
+}
+
+TEST_F(CameraStateHubTests, DestructionEndsPendingChangeWaits) {
+    std::promise<std::optional<common::types::Generation>> ended;
+    {
+        core::CameraStateHub hub(config_, fakeBackend());
+        hub.onChange(0, common::types::CameraStateField::Zoom, 0,
+                     std::chrono::steady_clock::now() + std::chrono::seconds(10),
+                     [&ended](const std::optional<common::types::Generation> current) { ended.set_value(current); });
+    }
+
+    auto current = ended.get_future();
+    ASSERT_EQ(current.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    EXPECT_FALSE(current.get().has_value());
+}
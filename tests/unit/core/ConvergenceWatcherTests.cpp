@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "core/motion/ConvergenceWatcher.h"
+
+using namespace testing;
+using namespace service;
+
+class ConvergenceWatcherTests : public Test {
+protected:
+    using Axis = core::ConvergenceWatcher::Axis;
+    using Clock = std::chrono::steady_clock;
+
+    void SetUp() override {
+        config_.min_poll_interval = std::chrono::milliseconds(10);
+        config_.max_poll_interval = std::chrono::milliseconds(100);
+        config_.settle_time = std::chrono::milliseconds(50);
+    }
+
+    /**
+     * A lens moving from 0 at speed units per second until it reaches stop
+     */
+    core::ConvergenceWatcher::ReadFunction fakeLens(const double speed, const uint32_t stop) {
+        const auto started = Clock::now();
+        return [this, started, speed, stop](Axis) {
+            ++reads_;
+            const std::chrono::duration<double> elapsed = Clock::now() - started;
+            return Result<uint32_t>::success(std::min(static_cast<uint32_t>(speed * elapsed.count()), stop));
+        };
+    }
+
+    static Clock::time_point in(const std::chrono::milliseconds timeout) {
+        return Clock::now() + timeout;
+    }
+
+    common::ConvergenceConfig config_;
+    std::atomic<int> reads_{0};
+};
+
+TEST_F(ConvergenceWatcherTests, ReturnsOnceWithinTolerance) {
+    core::ConvergenceWatcher watcher(config_, fakeLens(250.0, 50));
+
+    const auto result = watcher.waitFor(Axis::Zoom, 50, 2, in(std::chrono::milliseconds(2000)));
+
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(result.value().status, common::types::ConvergenceStatus::Reached);
+    EXPECT_GE(result.value().value, 48u);
+    EXPECT_GE(result.value().elapsed, std::chrono::milliseconds(150));
+    EXPECT_LT(result.value().elapsed, std::chrono::milliseconds(1000));
+}
+
+TEST_F(ConvergenceWatcherTests, SettlesShortOfUnreachableTarget) {
+    core::ConvergenceWatcher watcher(config_, fakeLens(500.0, 40));
+
+    const auto result = watcher.waitFor(Axis::Focus, 50, 0, in(std::chrono::milliseconds(2000)));
+
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(result.value().status, common::types::ConvergenceStatus::Settled);
+    EXPECT_EQ(result.value().value, 40u);
+}
+
+TEST_F(ConvergenceWatcherTests, TimesOutWhileStillMoving) {
+    core::ConvergenceWatcher watcher(config_, fakeLens(100.0, 100));
+
+    const auto result = watcher.waitFor(Axis::Zoom, 100, 0, in(std::chrono::milliseconds(150)));
+
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(result.value().status, common::types::ConvergenceStatus::TimedOut);
+    EXPECT_LT(result.value().value, 100u);
+}
+
+TEST_F(ConvergenceWatcherTests, ConcurrentWaitersShareOnePoll) {
+    core::ConvergenceWatcher watcher(config_, fakeLens(200.0, 60));
+
+    const auto started = Clock::now();
+    std::vector<std::jthread> waiters;
+    std::atomic<int> reached{0};
+    for (int i = 0; i < 8; ++i) {
+        waiters.emplace_back([&] {
+            const auto result = watcher.waitFor(Axis::Zoom, 60, 0, in(std::chrono::milliseconds(2000)));
+            if (result.isSuccess() && result.value().status == common::types::ConvergenceStatus::Reached) {
+                ++reached;
+            }
+        });
+    }
+    waiters.clear();
+    const auto elapsed = Clock::now() - started;
+
+    EXPECT_EQ(reached.load(), 8);
+    // Never more often than one loop at the minimum interval
+    EXPECT_LE(reads_.load(), elapsed / config_.min_poll_interval + 2);
+}
+
+TEST_F(ConvergenceWatcherTests, ReadFailureEndsTheWait) {
+    core::ConvergenceWatcher watcher(config_, [](Axis) { return Result<uint32_t>::error("camera unreachable"); });
+
+    const auto result = watcher.waitFor(Axis::Zoom, 10, 0, in(std::chrono::milliseconds(1000)));
+
+    ASSERT_TRUE(result.isError());
+    EXPECT_THAT(result.error().message, HasSubstr("unreachable"));
+}
+
+TEST_F(ConvergenceWatcherTests, WatchReturnsAtOnceAndEndsOnTheWatcherThread) {
+    core::ConvergenceWatcher watcher(config_, fakeLens(250.0, 50));
+
+    std::promise<std::thread::id> ended_on;
+    std::promise<Result<common::types::Convergence>> outcome;
+    watcher.watch(Axis::Zoom, 50, 2, in(std::chrono::milliseconds(2000)),
+                  [&ended_on, &outcome](Result<common::types::Convergence> result) {
+                      ended_on.set_value(std::this_thread::get_id());
+                      outcome.set_value(std::move(result));
+                  });
+
+    auto result = outcome.get_future();
+    // The lens needs 200 ms to get there, watch() did not wait for it
+    EXPECT_EQ(result.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_EQ(result.get().value().status, common::types::ConvergenceStatus::Reached);
+    EXPECT_NE(ended_on.get_future().get(), std::this_thread::get_id());
+}
+
+TEST_F(ConvergenceWatcherTests, DestructionEndsPendingWaits) {
+    std::promise<Result<common::types::Convergence>> outcome;
+    {
+        core::ConvergenceWatcher watcher(config_, fakeLens(1.0, 100));
+        watcher.watch(Axis::Focus, 100, 0, in(std::chrono::seconds(10)),
+                      [&outcome](Result<common::types::Convergence> result) {
+                          outcome.set_value(std::move(result));
+                      });
+    }
+
+    auto result = outcome.get_future();
+    ASSERT_EQ(result.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    const auto convergence = result.get();
+    ASSERT_TRUE(convergence.isError());
+    EXPECT_THAT(convergence.error().message, HasSubstr("stopping"));
+}
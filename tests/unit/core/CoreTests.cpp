@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <chrono>
+#include <thread>
 /* Add your project include files here */
+#include "../../GrpcFixture.h"
 #include "core/Core.h"
+#include "common/state/CallContext.h"
 #include "common/config/ConfigManager.h"
 #include "common/types/Result.h"
 
@@ -39,7 +43,7 @@ TEST_F(CoreTests, StartsSuccessfully) {
     const auto config = createValidConfig();
     service::core::Core core(config);
     const auto result = core.start();
-    ASSERT_TRUE(result.isSuccess()) << "Failed to start: " << result.error();
+    ASSERT_TRUE(result.isSuccess()) << "Failed to start: " << result.error().message;
 }
 
 TEST_F(CoreTests, StopsSuccessfully) {
@@ -47,7 +51,103 @@ TEST_F(CoreTests, StopsSuccessfully) {
     service::core::Core core(config);
     ASSERT_TRUE(core.start().isSuccess());
     const auto result = core.stop();
-    ASSERT_TRUE(result.isSuccess()) << "Failed to stop: " << result.error();
+    ASSERT_TRUE(result.isSuccess()) << "Failed to stop: " << result.error().message;
+}
+
+TEST_F(CoreTests, StopsWhileAMacroIsRunning) {
+    FakeCameraService camera_service;
+    grpc::ServerBuilder builder;
+    int backend_port = 0;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &backend_port);
+    builder.RegisterService(&camera_service);
+    const auto backend = builder.BuildAndStart();
+    ASSERT_NE(nullptr, backend);
+
+    auto config = createValidConfig();
+    config.clients["camera_service"].instances.front().address = "127.0.0.1:" + std::to_string(backend_port);
+    service::core::Core core(config);
+    ASSERT_TRUE(core.start().isSuccess());
+
+    // The macro keeps stepping the zoom under a lease, every step checks it while the core stops
+    const auto lease = core.acquireControl(1, std::chrono::seconds(10));
+    ASSERT_TRUE(lease.isSuccess()) << lease.error().message;
+    service::common::types::MacroStep step{.type = service::common::types::MacroStepType::ZoomStep, .delta = 1};
+    service::common::types::MacroStep wait{.type = service::common::types::MacroStepType::Wait,
+                                           .duration = std::chrono::milliseconds(1)};
+    service::common::types::MacroStep repeat{.type = service::common::types::MacroStepType::Repeat,
+                                             .count = 10000, .steps = {step, wait}};
+    const service::common::types::Macro macro{.name = "sweep", .steps = {repeat}};
+    service::common::state::CallContext call;
+    call.lease_id = lease.value().lease_id;
+    const auto execution = [&] {
+        service::common::state::CallContext::Scope scope(call);
+        return core.runMacro(1, macro);
+    }();
+    ASSERT_TRUE(execution.isSuccess()) << execution.error().message;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (camera_service.set_zoom_calls.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_GE(camera_service.set_zoom_calls.load(), 3);
+
+    ASSERT_TRUE(core.stop().isSuccess());
+    EXPECT_TRUE(execution.value()->isClosed());
+    std::optional<service::common::types::MacroProgress> last;
+    while (auto progress = execution.value()->poll()) {
+        last = std::move(progress);
+    }
+    ASSERT_TRUE(last.has_value());
+    EXPECT_NE(last->status, service::common::types::MacroStatus::Completed);
+    backend->Shutdown();
+}
+
+TEST_F(CoreTests, CommandsFailAfterStop) {
+    const auto config = createValidConfig();
+    service::core::Core core(config);
+    ASSERT_TRUE(core.start().isSuccess());
+    ASSERT_TRUE(core.stop().isSuccess());
+
+    const auto zoom = core.setZoom(1, 50);
+    ASSERT_TRUE(zoom.isError());
+    EXPECT_THAT(zoom.error().message, ::testing::HasSubstr("not initialized"));
+
+    const auto step = core.stepFocus(1, 5);
+    ASSERT_TRUE(step.isError());
+    EXPECT_THAT(step.error().message, ::testing::HasSubstr("not initialized"));
+
+    const auto stabilize = core.stabilize(1, true);
+    ASSERT_TRUE(stabilize.isError());
+    EXPECT_THAT(stabilize.error().message, ::testing::HasSubstr("not initialized"));
+}
+
+TEST_F(CoreTests, AsyncSetIsBoundByTheCallDeadline) {
+    FakeCameraService camera_service;
+    camera_service.command_delay = std::chrono::seconds(2);
+    grpc::ServerBuilder builder;
+    int backend_port = 0;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &backend_port);
+    builder.RegisterService(&camera_service);
+    const auto backend = builder.BuildAndStart();
+    ASSERT_NE(nullptr, backend);
+
+    auto config = createValidConfig();
+    config.clients["camera_service"].instances.front().address = "127.0.0.1:" + std::to_string(backend_port);
+    service::core::Core core(config);
+    ASSERT_TRUE(core.start().isSuccess());
+
+    service::common::state::CallContext call;
+    call.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    const auto started = std::chrono::steady_clock::now();
+    const auto result = [&] {
+        service::common::state::CallContext::Scope scope(call);
+        return service::common::async::syncWait(core.setZoomAsync(1, 50));
+    }();
+
+    EXPECT_TRUE(result.isError());
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(1));
+    ASSERT_TRUE(core.stop().isSuccess());
+    backend->Shutdown();
 }
 
 TEST_F(CoreTests, StopsWhenNotStartedSuccessfully) {
@@ -64,11 +164,11 @@ TEST_F(CoreTests, ZoomOperationsFailWhenNotInitialized) {
     // Operations should fail when not initialized (not started)
     const auto set_result = core.setZoom(1, 50);
     ASSERT_TRUE(set_result.isError());
-    EXPECT_THAT(set_result.error(), ::testing::HasSubstr("not initialized"));
+    EXPECT_THAT(set_result.error().message, ::testing::HasSubstr("not initialized"));
 
     const auto get_result = core.getZoom(1);
     ASSERT_TRUE(get_result.isError());
-    EXPECT_THAT(get_result.error(), ::testing::HasSubstr("not initialized"));
+    EXPECT_THAT(get_result.error().message, ::testing::HasSubstr("not initialized"));
 }
 
 TEST_F(CoreTests, FocusOperationsFailWhenNotInitialized) {
@@ -77,11 +177,11 @@ TEST_F(CoreTests, FocusOperationsFailWhenNotInitialized) {
 
     const auto set_result = core.setFocus(1, 50);
     ASSERT_TRUE(set_result.isError());
-    EXPECT_THAT(set_result.error(), ::testing::HasSubstr("not initialized"));
+    EXPECT_THAT(set_result.error().message, ::testing::HasSubstr("not initialized"));
 
     const auto get_result = core.getFocus(1);
     ASSERT_TRUE(get_result.isError());
-    EXPECT_THAT(get_result.error(), ::testing::HasSubstr("not initialized"));
+    EXPECT_THAT(get_result.error().message, ::testing::HasSubstr("not initialized"));
 }
 
 TEST_F(CoreTests, InfoOperationFailsWhenNotInitialized) {
@@ -90,7 +190,7 @@ TEST_F(CoreTests, InfoOperationFailsWhenNotInitialized) {
 
     const auto result = core.getInfo(1);
     ASSERT_TRUE(result.isError());
-    EXPECT_THAT(result.error(), ::testing::HasSubstr("not initialized"));
+    EXPECT_THAT(result.error().message, ::testing::HasSubstr("not initialized"));
 }
 
 TEST_F(CoreTests, AutoFocusOperationFailsWhenNotInitialized) {
@@ -99,7 +199,7 @@ TEST_F(CoreTests, AutoFocusOperationFailsWhenNotInitialized) {
 
     const auto result = core.enableAutoFocus(1, true);
     ASSERT_TRUE(result.isError());
-    EXPECT_THAT(result.error(), ::testing::HasSubstr("not initialized"));
+    EXPECT_THAT(result.error().message, ::testing::HasSubstr("not initialized"));
 }
 
 TEST_F(CoreTests, StabilizeOperationFailsWhenNotInitialized) {
@@ -108,7 +208,7 @@ TEST_F(CoreTests, StabilizeOperationFailsWhenNotInitialized) {
 
     const auto result = core.stabilize(1, true);
     ASSERT_TRUE(result.isError());
-    EXPECT_THAT(result.error(), ::testing::HasSubstr("not initialized"));
+    EXPECT_THAT(result.error().message, ::testing::HasSubstr("not initialized"));
 }
 
 TEST_F(CoreTests, GetCapabilitiesFailsWhenNotInitialized) {
@@ -117,5 +217,5 @@ TEST_F(CoreTests, GetCapabilitiesFailsWhenNotInitialized) {
 
     const auto result = core.getCapabilities(1);
     ASSERT_TRUE(result.isError());
-    EXPECT_THAT(result.error(), ::testing::HasSubstr("not initialized"));
+    EXPECT_THAT(result.error().message, ::testing::HasSubstr("not initialized"));
 }
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <optional>
+#include <thread>
+/* Add your project include files here */
+#include "core/idempotency/IdempotencyTable.h"
+
+using namespace testing;
+using namespace service;
+
+class IdempotencyTableTests : public Test {
+protected:
+    using OperationResult = common::types::OperationResult;
+
+    static constexpr auto NO_DEADLINE = core::IdempotencyTable::Clock::time_point::max();
+
+    static common::types::Operation setZoom(const uint32_t zoom) {
+        return {.type = common::types::OperationType::SetZoom, .camera_id = 1, .value = zoom};
+    }
+
+    /**
+     * SetZoom through the table, counting the calls that reached the camera
+     */
+    OperationResult run(core::IdempotencyTable& table, const std::string& key, const uint32_t zoom,
+                        const std::string& caller = "hmi") {
+        return table.run(caller, key, setZoom(zoom), NO_DEADLINE, [this, zoom] {
+            ++executed_;
+            return OperationResult::success(common::types::OperationValue{zoom});
+        });
+    }
+
+    /**
+     * SetZoom answered by a task, counting the calls that reached the camera
+     */
+    common::async::Task<OperationResult> setZoomTask(const uint32_t zoom) {
+        ++executed_;
+        co_return OperationResult::success(common::types::OperationValue{zoom});
+    }
+
+    static uint32_t zoomOf(const OperationResult& result) {
+        return std::get<uint32_t>(result.value());
+    }
+
+    common::IdempotencyConfig config_;
+    core::CommandScheduler scheduler_{std::chrono::microseconds(1000)};
+    std::atomic<int> executed_{0};
+};
+
+TEST_F(IdempotencyTableTests, RetryOfACompletedCallGetsItsResult) {
+    core::IdempotencyTable table(config_, scheduler_);
+
+    const auto first = run(table, "a", 40);
+    const auto retry = run(table, "a", 40);
+
+    ASSERT_TRUE(retry.isSuccess());
+    EXPECT_EQ(zoomOf(retry), zoomOf(first));
+    EXPECT_EQ(executed_, 1);
+}
+
+TEST_F(IdempotencyTableTests, RetryOfARunningCallWaitsForIt) {
+    core::IdempotencyTable table(config_, scheduler_);
+    std::promise<void> started;
+    std::promise<void> release;
+    auto first = std::async(std::launch::async, [&] {
+        return table.run("hmi", "a", setZoom(40), NO_DEADLINE, [&] {
+            ++executed_;
+            started.set_value();
+            release.get_future().wait();
+            return OperationResult::success(common::types::OperationValue{uint32_t{40}});
+        });
+    });
+    started.get_future().wait();
+
+    auto retry = std::async(std::launch::async, [&] { return run(table, "a", 40); });
+    EXPECT_EQ(retry.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+    release.set_value();
+
+    EXPECT_EQ(zoomOf(retry.get()), 40u);
+    EXPECT_EQ(zoomOf(first.get()), 40u);
+    EXPECT_EQ(executed_, 1);
+}
+
+TEST_F(IdempotencyTableTests, AwaitedRetryOfARunningCallResumesWithItsResult) {
+    core::IdempotencyTable table(config_, scheduler_);
+    std::function<void(OperationResult)> respond;
+    auto first = table.runAsync("hmi", "a", setZoom(40), NO_DEADLINE,
+                                common::async::fromCallback<OperationResult>([&](auto complete) {
+                                    ++executed_;
+                                    respond = std::move(complete);
+                                }));
+    std::optional<OperationResult> first_result;
+    std::optional<OperationResult> retry_result;
+    common::async::start(std::move(first), [&](OperationResult result) { first_result = std::move(result); });
+    common::async::start(table.runAsync("hmi", "a", setZoom(40), NO_DEADLINE, setZoomTask(40)),
+                         [&](OperationResult result) { retry_result = std::move(result); });
+    EXPECT_FALSE(retry_result.has_value());
+
+    respond(OperationResult::success(common::types::OperationValue{uint32_t{40}}));
+
+    ASSERT_TRUE(first_result.has_value());
+    ASSERT_TRUE(retry_result.has_value());
+    EXPECT_EQ(zoomOf(*retry_result), 40u);
+    EXPECT_EQ(executed_, 1);
+}
+
+TEST_F(IdempotencyTableTests, RetryStopsWaitingAtItsDeadline) {
+    core::IdempotencyTable table(config_, scheduler_);
+    std::promise<void> started;
+    std::promise<void> release;
+    auto first = std::async(std::launch::async, [&] {
+        return table.run("hmi", "a", setZoom(40), NO_DEADLINE, [&] {
+            started.set_value();
+            release.get_future().wait();
+            return OperationResult::success(common::types::OperationValue{uint32_t{40}});
+        });
+    });
+    started.get_future().wait();
+
+    const auto retry = table.run("hmi", "a", setZoom(40),
+                                 core::IdempotencyTable::Clock::now() + std::chrono::milliseconds(20),
+                                 [] { return OperationResult::error("Retry must not run"); });
+    release.set_value();
+
+    ASSERT_TRUE(retry.isError());
+    EXPECT_EQ(retry.error().code, common::types::ErrorCode::DeadlineExceeded);
+    EXPECT_TRUE(first.get().isSuccess());
+}
+
+TEST_F(IdempotencyTableTests, AwaitedRetryStopsWaitingAtItsDeadline) {
+    core::IdempotencyTable table(config_, scheduler_);
+    std::function<void(OperationResult)> respond;
+    common::async::start(table.runAsync("hmi", "a", setZoom(40), NO_DEADLINE,
+                                        common::async::fromCallback<OperationResult>(
+                                            [&](auto complete) { respond = std::move(complete); })),
+                         [](OperationResult) {});
+    std::promise<OperationResult> retry;
+    common::async::start(table.runAsync("hmi", "a", setZoom(40),
+                                        core::IdempotencyTable::Clock::now() + std::chrono::milliseconds(20),
+                                        setZoomTask(40)),
+                         [&retry](OperationResult result) { retry.set_value(std::move(result)); });
+
+    auto result = retry.get_future();
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    const auto timed_out = result.get();
+    ASSERT_TRUE(timed_out.isError());
+    EXPECT_EQ(timed_out.error().code, common::types::ErrorCode::DeadlineExceeded);
+    EXPECT_EQ(executed_, 0);
+
+    respond(OperationResult::success(common::types::OperationValue{uint32_t{40}}));
+}
+
+TEST_F(IdempotencyTableTests, FailedCallIsRunAgain) {
+    core::IdempotencyTable table(config_, scheduler_);
+    const auto failed = table.run("hmi", "a", setZoom(40), NO_DEADLINE, [this] {
+        ++executed_;
+        return OperationResult::error("Camera is not available");
+    });
+    ASSERT_TRUE(failed.isError());
+
+    EXPECT_TRUE(run(table, "a", 40).isSuccess());
+    EXPECT_EQ(executed_, 2);
+}
+
+TEST_F(IdempotencyTableTests, KeyOfAnotherOperationIsRejected) {
+    core::IdempotencyTable table(config_, scheduler_);
+    run(table, "a", 40);
+
+    const auto reused = run(table, "a", 50);
+
+    ASSERT_TRUE(reused.isError());
+    EXPECT_THAT(reused.error().message, HasSubstr("different operation"));
+    EXPECT_EQ(executed_, 1);
+}
+
+TEST_F(IdempotencyTableTests, KeysBelongToTheirCaller) {
+    core::IdempotencyTable table(config_, scheduler_);
+
+    run(table, "a", 40, "hmi");
+    run(table, "a", 50, "recorder");
+
+    EXPECT_EQ(executed_, 2);
+}
+
+TEST_F(IdempotencyTableTests, ResultsExpireAfterTheTtl) {
+    config_.ttl = std::chrono::milliseconds(20);
+    core::IdempotencyTable table(config_, scheduler_);
+    run(table, "a", 40);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    run(table, "a", 40);
+
+    EXPECT_EQ(executed_, 2);
+}
+
+TEST_F(IdempotencyTableTests, FullTableDropsTheOldestKey) {
+    config_.max_entries = 2;
+    core::IdempotencyTable table(config_, scheduler_);
+    run(table, "a", 40);
+    run(table, "b", 40);
+    run(table, "c", 40);
+
+    run(table, "b", 40);
+    run(table, "a", 40);
+
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(executed_, 4);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <thread>
+/* Add your project include files here */
+#include "core/lease/LeaseTable.h"
+
+using namespace testing;
+using namespace service;
+
+class LeaseTableTests : public Test {
+protected:
+    void SetUp() override {
+        config_.default_ttl = std::chrono::milliseconds(1000);
+        config_.max_ttl = std::chrono::milliseconds(5000);
+        table_ = std::make_unique<core::LeaseTable>(std::vector<uint32_t>{0, 1}, config_, scheduler_);
+    }
+
+    static constexpr uint64_t OTHER_CLIENT = 42;
+
+    common::LeasesConfig config_;
+    core::CommandScheduler scheduler_{std::chrono::microseconds(1000)};
+    std::unique_ptr<core::LeaseTable> table_;
+};
+
+TEST_F(LeaseTableTests, OnlyTheHolderIsPermittedWhileALeaseIsHeld) {
+    EXPECT_TRUE(table_->permits(0, OTHER_CLIENT));
+
+    const auto lease = table_->acquire(0, std::chrono::milliseconds(0));
+
+    ASSERT_TRUE(lease.isSuccess());
+    EXPECT_NE(lease.value().lease_id, 0u);
+    EXPECT_EQ(lease.value().ttl, config_.default_ttl);
+    EXPECT_TRUE(table_->permits(0, lease.value().lease_id));
+    EXPECT_FALSE(table_->permits(0, OTHER_CLIENT));
+    EXPECT_FALSE(table_->permits(0, 0));
+    EXPECT_TRUE(table_->permits(1, OTHER_CLIENT));
+}
+
+TEST_F(LeaseTableTests, HolderIsTheLeaseOfTheCamera) {
+    EXPECT_EQ(table_->holder(0), 0u);
+
+    const auto lease = table_->acquire(0, std::chrono::milliseconds(0));
+
+    ASSERT_TRUE(lease.isSuccess());
+    EXPECT_EQ(table_->holder(0), lease.value().lease_id);
+    EXPECT_EQ(table_->holder(1), 0u);
+    EXPECT_EQ(table_->holder(7), 0u);
+}
+
+TEST_F(LeaseTableTests, SecondAcquireFailsUntilRelease) {
+    const auto lease = table_->acquire(0, std::chrono::milliseconds(0));
+    ASSERT_TRUE(lease.isSuccess());
+
+    const auto second = table_->acquire(0, std::chrono::milliseconds(0));
+    ASSERT_TRUE(second.isError());
+    EXPECT_EQ(second.error().code, common::types::ErrorCode::ControlledByAnotherClient);
+    EXPECT_TRUE(table_->release(0, OTHER_CLIENT).isError());
+    ASSERT_TRUE(table_->release(0, lease.value().lease_id).isSuccess());
+
+    EXPECT_TRUE(table_->permits(0, OTHER_CLIENT));
+    EXPECT_TRUE(table_->acquire(0, std::chrono::milliseconds(0)).isSuccess());
+}
+
+TEST_F(LeaseTableTests, CapsTtlAtTheMaximum) {
+    const auto lease = table_->acquire(0, std::chrono::milliseconds(60000));
+
+    ASSERT_TRUE(lease.isSuccess());
+    EXPECT_EQ(lease.value().ttl, config_.max_ttl);
+}
+
+TEST_F(LeaseTableTests, LeaseExpiresWithoutRenewal) {
+    const auto lease = table_->acquire(0, std::chrono::milliseconds(50));
+    ASSERT_TRUE(lease.isSuccess());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_TRUE(table_->permits(0, OTHER_CLIENT));
+    EXPECT_TRUE(table_->renew(0, lease.value().lease_id, std::chrono::milliseconds(50)).isError());
+    EXPECT_TRUE(table_->acquire(0, std::chrono::milliseconds(0)).isSuccess());
+}
+
+TEST_F(LeaseTableTests, RenewalOutlivesTheFirstExpiry) {
+    const auto lease = table_->acquire(0, std::chrono::milliseconds(60));
+    ASSERT_TRUE(lease.isSuccess());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    ASSERT_TRUE(table_->renew(0, lease.value().lease_id, std::chrono::milliseconds(200)).isSuccess());
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+
+    EXPECT_FALSE(table_->permits(0, OTHER_CLIENT));
+    EXPECT_TRUE(table_->permits(0, lease.value().lease_id));
+}
+
+TEST_F(LeaseTableTests, RejectsUnknownCamera) {
+    EXPECT_TRUE(table_->acquire(7, std::chrono::milliseconds(0)).isError());
+    EXPECT_TRUE(table_->permits(7, OTHER_CLIENT));
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "core/macro/MacroRunner.h"
+
+using namespace testing;
+using namespace service;
+
+class MacroRunnerTests : public Test {
+protected:
+    using Axis = core::MacroRunner::Axis;
+    using Clock = core::MacroRunner::Clock;
+    using MacroStepType = common::types::MacroStepType;
+    using MacroStatus = common::types::MacroStatus;
+
+    static common::types::MacroStep setZoom(const uint32_t zoom) {
+        return {.type = MacroStepType::Operation,
+                .operation = {.type = common::types::OperationType::SetZoom, .value = zoom}};
+    }
+
+    static common::types::MacroStep zoomStep(const int32_t delta) {
+        return {.type = MacroStepType::ZoomStep, .delta = delta};
+    }
+
+    static common::types::MacroStep wait(const std::chrono::microseconds duration) {
+        return {.type = MacroStepType::Wait, .duration = duration};
+    }
+
+    static common::types::MacroStep awaitZoom(const uint32_t tolerance) {
+        return {.type = MacroStepType::AwaitZoom, .tolerance = tolerance};
+    }
+
+    static common::types::MacroStep repeat(const uint32_t count, std::vector<common::types::MacroStep> steps) {
+        return {.type = MacroStepType::Repeat, .count = count, .steps = std::move(steps)};
+    }
+
+    /**
+     * A camera whose zoom moves instantly, SetZoom to 99 fails
+     */
+    core::MacroRunner::Actions fakeCamera() {
+        return {
+            .execute = [this](const common::types::Operation& operation) {
+                std::lock_guard lock(mutex_);
+                cameras_.push_back(operation.camera_id);
+                if (operation.value == 99) {
+                    return common::types::OperationResult::error("Zoom out of range");
+                }
+                zoom_ = operation.value;
+                return common::types::OperationResult::success(common::types::OperationValue{zoom_});
+            },
+            .step = [this](Axis, const int32_t delta) {
+                std::lock_guard lock(mutex_);
+                zoom_ = static_cast<uint32_t>(static_cast<int32_t>(zoom_) + delta);
+                return Result<uint32_t>::success(zoom_);
+            },
+            .await = [this](Axis, const uint32_t target, const uint32_t tolerance, Clock::time_point) {
+                std::lock_guard lock(mutex_);
+                awaits_.emplace_back(target, tolerance);
+                return Result<common::types::Convergence>::success({.value = target});
+            }};
+    }
+
+    std::unique_ptr<core::MacroRunner> run(std::vector<common::types::MacroStep> steps) {
+        return std::make_unique<core::MacroRunner>(CAMERA_ID, common::types::Macro{"test", std::move(steps)},
+                                                   fakeCamera(), std::chrono::milliseconds(1000), execution_);
+    }
+
+    /**
+     * Every report of the run, waiting for it to end
+     */
+    std::vector<common::types::MacroProgress> reports() {
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (!execution_->isClosed() && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::vector<common::types::MacroProgress> progress;
+        while (auto next = execution_->poll()) {
+            progress.push_back(std::move(*next));
+        }
+        return progress;
+    }
+
+    static constexpr uint32_t CAMERA_ID = 2;
+
+    std::shared_ptr<common::state::MacroExecution> execution_ =
+        std::make_shared<common::state::MacroExecution>(CAMERA_ID, "test");
+    std::mutex mutex_;
+    uint32_t zoom_{0};
+    std::vector<uint32_t> cameras_;
+    std::vector<std::pair<uint32_t, uint32_t>> awaits_;
+};
+
+TEST_F(MacroRunnerTests, ReportsEveryStepWithItsPathAndIteration) {
+    auto runner = run({setZoom(10), repeat(2, {zoomStep(5)})});
+
+    const auto progress = reports();
+
+    ASSERT_EQ(progress.size(), 4u);
+    EXPECT_EQ(progress[0].sequence, 1u);
+    EXPECT_THAT(progress[0].path, ElementsAre(0u));
+    EXPECT_EQ(progress[0].value, 10u);
+    EXPECT_THAT(progress[1].path, ElementsAre(1u, 0u));
+    EXPECT_THAT(progress[1].iterations, ElementsAre(0u));
+    EXPECT_EQ(progress[1].value, 15u);
+    EXPECT_THAT(progress[2].iterations, ElementsAre(1u));
+    EXPECT_EQ(progress[2].value, 20u);
+    EXPECT_EQ(progress[3].status, MacroStatus::Completed);
+    EXPECT_EQ(progress[3].sequence, 3u);
+    EXPECT_TRUE(progress[3].path.empty());
+    EXPECT_FALSE(runner->isRunning());
+}
+
+TEST_F(MacroRunnerTests, RunsOperationsOnTheMacroCamera) {
+    auto runner = run({setZoom(10)});
+
+    reports();
+
+    EXPECT_THAT(cameras_, ElementsAre(CAMERA_ID));
+}
+
+TEST_F(MacroRunnerTests, WaitsForTheRequestedDuration) {
+    auto runner = run({wait(std::chrono::milliseconds(20)), wait(std::chrono::microseconds(1500))});
+
+    const auto progress = reports();
+
+    ASSERT_EQ(progress.size(), 3u);
+    EXPECT_GE(progress[0].elapsed, std::chrono::milliseconds(20));
+    EXPECT_LT(progress[0].elapsed, std::chrono::milliseconds(30));
+    EXPECT_GE(progress[1].elapsed - progress[0].elapsed, std::chrono::microseconds(1500));
+    EXPECT_FALSE(progress[1].value);
+}
+
+TEST_F(MacroRunnerTests, StopEndsAWaitEarly) {
+    auto runner = run({setZoom(10), wait(std::chrono::seconds(10)), setZoom(20)});
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    runner->stop();
+    const auto progress = reports();
+
+    ASSERT_EQ(progress.size(), 2u);
+    EXPECT_EQ(progress[1].status, MacroStatus::Cancelled);
+    EXPECT_THAT(progress[1].path, ElementsAre(1u));
+    EXPECT_LT(progress[1].elapsed, std::chrono::seconds(1));
+    EXPECT_EQ(zoom_, 10u);
+}
+
+TEST_F(MacroRunnerTests, FailedStepEndsTheRun) {
+    auto runner = run({setZoom(10), repeat(3, {setZoom(99)}), setZoom(20)});
+
+    const auto progress = reports();
+
+    ASSERT_EQ(progress.size(), 2u);
+    EXPECT_EQ(progress[1].status, MacroStatus::Failed);
+    EXPECT_EQ(progress[1].error, "Zoom out of range");
+    EXPECT_THAT(progress[1].path, ElementsAre(1u, 0u));
+    EXPECT_THAT(progress[1].iterations, ElementsAre(0u));
+    EXPECT_EQ(zoom_, 10u);
+}
+
+TEST_F(MacroRunnerTests, AwaitTargetsTheLastValueTheMacroSet) {
+    auto runner = run({setZoom(10), zoomStep(-4), awaitZoom(2)});
+
+    const auto progress = reports();
+
+    ASSERT_EQ(progress.size(), 4u);
+    EXPECT_EQ(progress[3].status, MacroStatus::Completed);
+    EXPECT_THAT(awaits_, ElementsAre(Pair(6u, 2u)));
+    EXPECT_EQ(progress[2].value, 6u);
+}
+
+TEST_F(MacroRunnerTests, AwaitWithoutAPriorSetFails) {
+    auto runner = run({awaitZoom(0)});
+
+    const auto progress = reports();
+
+    ASSERT_EQ(progress.size(), 1u);
+    EXPECT_EQ(progress[0].status, MacroStatus::Failed);
+    EXPECT_TRUE(awaits_.empty());
+}
+
+TEST_F(MacroRunnerTests, DestructionCancelsTheRun) {
+    auto runner = run({wait(std::chrono::seconds(10))});
+
+    runner.reset();
+    const auto progress = reports();
+
+    ASSERT_EQ(progress.size(), 1u);
+    EXPECT_EQ(progress[0].status, MacroStatus::Cancelled);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "core/motion/MotionScheduler.h"
+
+using namespace testing;
+using namespace service;
+
+class MotionSchedulerTests : public Test {
+protected:
+    using Axis = core::MotionScheduler::Axis;
+
+    std::unique_ptr<core::MotionScheduler> makeScheduler(const uint32_t backend_limit = 100) {
+        return std::make_unique<core::MotionScheduler>(
+            std::chrono::milliseconds(10),
+            [this](Axis) {
+                std::lock_guard lock(mutex_);
+                return Result<uint32_t>::success(position_);
+            },
+            [this, backend_limit](Axis, const uint32_t position) {
+                std::lock_guard lock(mutex_);
+                position_ = std::min(position, backend_limit);
+                commands_.push_back(position);
+                return Result<uint32_t>::success(position_);
+            });
+    }
+
+    static bool waitUntilStopped(const core::MotionScheduler& scheduler, const Axis axis) {
+        for (int attempt = 0; attempt < 200 && scheduler.isMoving(axis); ++attempt) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return !scheduler.isMoving(axis);
+    }
+
+    uint32_t position() {
+        std::lock_guard lock(mutex_);
+        return position_;
+    }
+
+    std::size_t commandCount() {
+        std::lock_guard lock(mutex_);
+        return commands_.size();
+    }
+
+    std::mutex mutex_;
+    uint32_t position_{10};
+    std::vector<uint32_t> commands_;
+};
+
+TEST_F(MotionSchedulerTests, MovesAtVelocityUntilDeadline) {
+    const auto scheduler = makeScheduler();
+    ASSERT_TRUE(scheduler->move(Axis::Zoom, 100.0, std::chrono::milliseconds(200)).isSuccess());
+    EXPECT_TRUE(scheduler->isMoving(Axis::Zoom));
+
+    ASSERT_TRUE(waitUntilStopped(*scheduler, Axis::Zoom));
+    // 10 + 100 units/s * 0.2 s, the final tick integrates up to the deadline
+    EXPECT_NEAR(position(), 30u, 1);
+    EXPECT_GT(commandCount(), 5u);
+}
+
+TEST_F(MotionSchedulerTests, StopsAtEndOfRange) {
+    const auto scheduler = makeScheduler();
+    ASSERT_TRUE(scheduler->move(Axis::Focus, -500.0, std::chrono::milliseconds(1000)).isSuccess());
+
+    ASSERT_TRUE(waitUntilStopped(*scheduler, Axis::Focus));
+    EXPECT_EQ(position(), 0u);
+}
+
+TEST_F(MotionSchedulerTests, StopsAtBackendLimit) {
+    const auto scheduler = makeScheduler(40);
+    ASSERT_TRUE(scheduler->move(Axis::Zoom, 500.0, std::chrono::milliseconds(1000)).isSuccess());
+
+    ASSERT_TRUE(waitUntilStopped(*scheduler, Axis::Zoom));
+    EXPECT_EQ(position(), 40u);
+}
+
+TEST_F(MotionSchedulerTests, StopHaltsCommands) {
+    const auto scheduler = makeScheduler();
+    ASSERT_TRUE(scheduler->move(Axis::Zoom, 50.0, std::chrono::milliseconds(1000)).isSuccess());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    scheduler->stop(Axis::Zoom);
+    const auto commands = commandCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_FALSE(scheduler->isMoving(Axis::Zoom));
+    EXPECT_EQ(commandCount(), commands);
+}
+
+TEST_F(MotionSchedulerTests, StopCallbackRunsOnceNoCommandFollows) {
+    const auto scheduler = makeScheduler();
+    ASSERT_TRUE(scheduler->move(Axis::Zoom, 10.0, std::chrono::seconds(10)).isSuccess());
+    std::this_thread::sleep_for(std::chrono::milliseconds(35));
+
+    std::promise<std::size_t> stopped;
+    auto commands = stopped.get_future();
+    scheduler->stop(Axis::Zoom, [this, &stopped] { stopped.set_value(commandCount()); });
+
+    ASSERT_EQ(commands.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    const auto at_stop = commands.get();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(scheduler->isMoving(Axis::Zoom));
+    EXPECT_EQ(commandCount(), at_stop);
+}
+
+TEST_F(MotionSchedulerTests, NewVelocityKeepsPositionAndRestartsDeadline) {
+    const auto scheduler = makeScheduler();
+    ASSERT_TRUE(scheduler->move(Axis::Zoom, 100.0, std::chrono::milliseconds(100)).isSuccess());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(scheduler->move(Axis::Zoom, -100.0, std::chrono::milliseconds(100)).isSuccess());
+
+    ASSERT_TRUE(waitUntilStopped(*scheduler, Axis::Zoom));
+    // Up for about 50 ms then down for 100 ms
+    EXPECT_NEAR(position(), 5u, 3);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <filesystem>
+#include <fstream>
+/* Add your project include files here */
+#include "core/preset/PresetStore.h"
+
+using namespace testing;
+using namespace service;
+
+class PresetStoreTests : public Test {
+protected:
+    void SetUp() override {
+        config_.file = (std::filesystem::temp_directory_path() /
+                        ("presets_" + std::string(UnitTest::GetInstance()->current_test_info()->name()) + ".yaml"))
+                           .string();
+        std::filesystem::remove(config_.file);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(config_.file);
+    }
+
+    static common::types::Preset makePreset(const std::string& name, const uint32_t zoom) {
+        common::types::Preset preset;
+        preset.name = name;
+        auto& camera = preset.cameras.emplace_back();
+        camera.camera_id = 1;
+        camera.state.zoom_level = zoom;
+        camera.state.auto_focus = false;
+        camera.state.focus_value = 40;
+        camera.video_capabilities["hdr"] = true;
+        return preset;
+    }
+
+    common::PresetsConfig config_;
+};
+
+TEST_F(PresetStoreTests, SavedPresetsSurviveARestart) {
+    {
+        core::PresetStore store(config_);
+        ASSERT_TRUE(store.save(makePreset("night", 20)).isSuccess());
+        ASSERT_TRUE(store.save(makePreset("day", 80)).isSuccess());
+    }
+
+    const core::PresetStore reloaded(config_);
+    const auto presets = reloaded.list();
+    ASSERT_EQ(presets.size(), 2u);
+    EXPECT_EQ(presets[0], makePreset("day", 80));
+    EXPECT_EQ(presets[1], makePreset("night", 20));
+}
+
+TEST_F(PresetStoreTests, ConfigPresetsOnlySeedAMissingFile) {
+    config_.definitions = {makePreset("day", 80), makePreset("night", 20)};
+    {
+        core::PresetStore store(config_);
+        EXPECT_EQ(store.list().size(), 2u);
+        ASSERT_TRUE(store.remove("day").isSuccess());
+    }
+
+    const core::PresetStore reloaded(config_);
+    EXPECT_FALSE(reloaded.find("day"));
+    EXPECT_TRUE(reloaded.find("night"));
+}
+
+TEST_F(PresetStoreTests, RejectsInvalidPresets) {
+    core::PresetStore store(config_);
+
+    auto conflicting = makePreset("day", 80);
+    conflicting.cameras[0].state.auto_focus = true;
+    EXPECT_TRUE(store.save(conflicting).isError());
+
+    auto duplicated = makePreset("night", 20);
+    duplicated.cameras.push_back(duplicated.cameras[0]);
+    EXPECT_TRUE(store.save(duplicated).isError());
+
+    EXPECT_TRUE(store.remove("missing").isError());
+    EXPECT_TRUE(store.list().empty());
+    EXPECT_FALSE(std::filesystem::exists(config_.file));
+}
+
+TEST_F(PresetStoreTests, ThrowsOnUnreadableFile) {
+    std::ofstream(config_.file) << "presets:\n  - name: day\n    cameras: 7\n";
+
+    EXPECT_THROW(core::PresetStore store(config_), std::runtime_error);
+}
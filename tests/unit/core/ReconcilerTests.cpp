@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "core/reconcile/Reconciler.h"
+
+using namespace testing;
+using namespace service;
+
+class ReconcilerTests : public Test {
+protected:
+    using OperationType = common::types::OperationType;
+
+    void SetUp() override {
+        config_.enabled = true;
+        config_.check_interval = std::chrono::milliseconds(50);
+        config_.settle_time = std::chrono::milliseconds(0);
+        config_.connection_poll = std::chrono::milliseconds(5);
+    }
+
+    /**
+     * One camera whose state is camera_, commands apply to it unless fail_ is set
+     */
+    core::Reconciler::Actions fakeCamera() {
+        return {
+            .read = [this](uint32_t, const common::types::DesiredState& desired) {
+                std::lock_guard lock(mutex_);
+                ++reads_;
+                common::types::DesiredState observed;
+                observed.state = camera_.state.masked(desired.state.fields());
+                for (const auto& [capability, enable] : desired.video) {
+                    if (const auto it = camera_.video.find(capability); it != camera_.video.end()) {
+                        observed.video[capability] = it->second;
+                    }
+                }
+                return observed;
+            },
+            .apply = [this](uint32_t, const std::vector<common::types::Operation>& operations) {
+                std::lock_guard lock(mutex_);
+                std::vector<common::types::OperationResult> results;
+                for (const auto& operation : operations) {
+                    applied_.push_back(operation.type);
+                    if (fail_) {
+                        results.push_back(common::types::OperationResult::error("Camera is not available"));
+                        continue;
+                    }
+                    switch (operation.type) {
+                    case OperationType::SetZoom:
+                        camera_.state.zoom_level = operation.value;
+                        break;
+                    case OperationType::SetFocus:
+                        camera_.state.focus_value = operation.value;
+                        break;
+                    case OperationType::SetAutoFocus:
+                        camera_.state.auto_focus = operation.enable;
+                        break;
+                    case OperationType::SetStabilization:
+                        camera_.state.stabilization = operation.enable;
+                        break;
+                    case OperationType::SetVideoCapabilityState:
+                        camera_.video[operation.capability] = operation.enable;
+                        break;
+                    default:
+                        break;
+                    }
+                    results.push_back(common::types::OperationResult::success(common::types::OperationValue{}));
+                }
+                return results;
+            },
+            .connected = [this](uint32_t) { return connected_.load(); }};
+    }
+
+    /**
+     * Wait until the reconciler recorded count drift events
+     */
+    common::types::ReconcileMetrics waitForDrifts(const core::Reconciler& reconciler, const std::size_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        auto metrics = reconciler.metrics();
+        while (metrics.recent_drifts.size() < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            metrics = reconciler.metrics();
+        }
+        return metrics;
+    }
+
+    static constexpr uint32_t CAMERA_ID = 3;
+
+    common::ReconcileConfig config_;
+    std::mutex mutex_;
+    common::types::DesiredState camera_;
+    std::vector<OperationType> applied_;
+    int reads_{0};
+    bool fail_{false};
+    std::atomic<bool> connected_{true};
+};
+
+TEST_F(ReconcilerTests, RestoresOnlyTheDriftedFields) {
+    camera_.state = {.zoom_level = 10, .stabilization = true};
+    camera_.video["hdr"] = false;
+    core::Reconciler reconciler(config_, fakeCamera());
+
+    reconciler.desire(CAMERA_ID, {.zoom_level = 40});
+    reconciler.desire(CAMERA_ID, {.stabilization = true});
+    reconciler.desireVideo(CAMERA_ID, "hdr", true);
+    const auto metrics = waitForDrifts(reconciler, 1);
+
+    ASSERT_EQ(metrics.recent_drifts.size(), 1u);
+    const auto& event = metrics.recent_drifts[0];
+    EXPECT_EQ(event.camera_id, CAMERA_ID);
+    EXPECT_EQ(event.cause, common::types::DriftCause::Check);
+    EXPECT_TRUE(event.restored);
+    EXPECT_EQ(event.drifted.state, (common::types::CameraState{.zoom_level = 40}));
+    EXPECT_THAT(event.drifted.video, ElementsAre(Pair("hdr", true)));
+    std::lock_guard lock(mutex_);
+    EXPECT_THAT(applied_, ElementsAre(OperationType::SetZoom, OperationType::SetVideoCapabilityState));
+    EXPECT_EQ(camera_.state.zoom_level, 40u);
+}
+
+TEST_F(ReconcilerTests, CameraInItsDesiredStateIsLeftAlone) {
+    camera_.state = {.zoom_level = 40};
+    core::Reconciler reconciler(config_, fakeCamera());
+
+    reconciler.desire(CAMERA_ID, {.zoom_level = 40});
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    const auto metrics = reconciler.metrics();
+    ASSERT_EQ(metrics.cameras.size(), 1u);
+    EXPECT_GE(metrics.cameras[0].checks, 2u);
+    EXPECT_EQ(metrics.cameras[0].drifts, 0u);
+    std::lock_guard lock(mutex_);
+    EXPECT_TRUE(applied_.empty());
+}
+
+TEST_F(ReconcilerTests, OnlyTheLatestDesiredValueIsRestored) {
+    config_.settle_time = std::chrono::milliseconds(30);
+    camera_.state = {.zoom_level = 10};
+    core::Reconciler reconciler(config_, fakeCamera());
+
+    reconciler.desire(CAMERA_ID, {.zoom_level = 40});
+    reconciler.desire(CAMERA_ID, {.zoom_level = 60});
+    const auto metrics = waitForDrifts(reconciler, 1);
+
+    ASSERT_EQ(metrics.recent_drifts.size(), 1u);
+    EXPECT_EQ(metrics.recent_drifts[0].drifted.state.zoom_level, 60u);
+    std::lock_guard lock(mutex_);
+    EXPECT_THAT(applied_, ElementsAre(OperationType::SetZoom));
+    EXPECT_EQ(camera_.state.zoom_level, 60u);
+}
+
+TEST_F(ReconcilerTests, RecentlyCommandedCameraIsNotCheckedYet) {
+    config_.settle_time = std::chrono::seconds(10);
+    camera_.state = {.zoom_level = 10};
+    core::Reconciler reconciler(config_, fakeCamera());
+
+    reconciler.desire(CAMERA_ID, {.zoom_level = 40});
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::lock_guard lock(mutex_);
+    EXPECT_EQ(reads_, 0);
+}
+
+TEST_F(ReconcilerTests, ReconnectTriggersACheckAtOnce) {
+    config_.settle_time = std::chrono::seconds(10);
+    camera_.state = {.zoom_level = 40, .auto_focus = false};
+    core::Reconciler reconciler(config_, fakeCamera());
+    reconciler.desire(CAMERA_ID, {.zoom_level = 40, .auto_focus = false});
+
+    connected_ = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    {
+        // The camera rebooted into its defaults
+        std::lock_guard lock(mutex_);
+        camera_.state = {.zoom_level = 0, .auto_focus = true};
+    }
+    connected_ = true;
+    const auto metrics = waitForDrifts(reconciler, 1);
+
+    ASSERT_EQ(metrics.recent_drifts.size(), 1u);
+    EXPECT_EQ(metrics.recent_drifts[0].cause, common::types::DriftCause::Reconnect);
+    EXPECT_TRUE(metrics.recent_drifts[0].restored);
+    EXPECT_EQ(metrics.latency.count, 1u);
+    std::lock_guard lock(mutex_);
+    EXPECT_THAT(applied_, ElementsAre(OperationType::SetZoom, OperationType::SetAutoFocus));
+}
+
+TEST_F(ReconcilerTests, FocusIsLeftToAutoFocus) {
+    camera_.state = {.focus_value = 70, .auto_focus = true};
+    core::Reconciler reconciler(config_, fakeCamera());
+
+    reconciler.desire(CAMERA_ID, {.focus_value = 30});
+    reconciler.desire(CAMERA_ID, {.auto_focus = true});
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(reconciler.metrics().cameras[0].drifts, 0u);
+}
+
+TEST_F(ReconcilerTests, FailedRestoreIsReported) {
+    fail_ = true;
+    camera_.state = {.stabilization = false};
+    core::Reconciler reconciler(config_, fakeCamera());
+
+    reconciler.desire(CAMERA_ID, {.stabilization = true});
+    const auto metrics = waitForDrifts(reconciler, 1);
+
+    ASSERT_GE(metrics.recent_drifts.size(), 1u);
+    EXPECT_FALSE(metrics.recent_drifts[0].restored);
+    EXPECT_EQ(metrics.recent_drifts[0].error, "Camera is not available");
+    EXPECT_EQ(metrics.cameras[0].restored, 0u);
+    EXPECT_EQ(metrics.latency.count, 0u);
+}
+
+TEST_F(ReconcilerTests, ChecksAtMostMaxChecksCamerasAtOnce) {
+    config_.max_checks = 2;
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> checked{0};
+    auto actions = fakeCamera();
+    actions.read = [&](uint32_t, const common::types::DesiredState& desired) {
+        const auto now = ++running;
+        peak = std::max(peak.load(), now);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        --running;
+        ++checked;
+        return desired;
+    };
+    core::Reconciler reconciler(config_, std::move(actions));
+
+    for (uint32_t camera_id = 1; camera_id <= 5; ++camera_id) {
+        reconciler.desire(camera_id, {.zoom_level = 40});
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (checked < 5 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_GE(checked, 5);
+    EXPECT_LE(peak, 2);
+}
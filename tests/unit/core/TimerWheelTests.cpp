@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+/* Add your project include files here */
+#include "core/schedule/TimerWheel.h"
+
+using namespace testing;
+using namespace service;
+
+class TimerWheelTests : public Test {
+protected:
+    using Clock = core::TimerWheel<int>::Clock;
+
+    static constexpr auto TICK = std::chrono::milliseconds(1);
+
+    Clock::time_point at(const int64_t ticks) const {
+        return start_ + ticks * TICK;
+    }
+
+    const Clock::time_point start_ = Clock::now();
+    core::TimerWheel<int> wheel_{TICK, start_};
+};
+
+TEST_F(TimerWheelTests, ExpiresEntriesOnceTheirTimeHasPassed) {
+    wheel_.add(at(5), 1);
+    wheel_.add(at(3), 2);
+
+    EXPECT_TRUE(wheel_.advance(at(2)).empty());
+    EXPECT_THAT(wheel_.advance(at(3)), ElementsAre(2));
+    EXPECT_THAT(wheel_.advance(at(10)), ElementsAre(1));
+    EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTests, EntriesOfHigherLevelsExpireOnTheirTick) {
+    // One entry per level, each just past a level boundary
+    const std::vector<int64_t> due = {63, 64, 4095, 4097, 262145};
+    for (std::size_t index = 0; index < due.size(); ++index) {
+        wheel_.add(at(due[index]), static_cast<int>(index));
+    }
+
+    for (std::size_t index = 0; index < due.size(); ++index) {
+        EXPECT_TRUE(wheel_.advance(at(due[index] - 1)).empty()) << "entry " << index;
+        EXPECT_THAT(wheel_.advance(at(due[index])), ElementsAre(static_cast<int>(index)));
+    }
+}
+
+TEST_F(TimerWheelTests, EntriesBeyondTheTopLevelAreKept) {
+    constexpr int64_t far = (int64_t{1} << 24) + 100;
+    wheel_.add(at(far), 1);
+
+    EXPECT_TRUE(wheel_.advance(at(far - 1)).empty());
+    EXPECT_THAT(wheel_.advance(at(far)), ElementsAre(1));
+}
+
+TEST_F(TimerWheelTests, PastDueTimesExpireOnTheNextAdvance) {
+    wheel_.advance(at(100));
+    wheel_.add(at(50), 1);
+
+    EXPECT_THAT(wheel_.advance(at(101)), ElementsAre(1));
+}
+
+TEST_F(TimerWheelTests, NextExpiryNeverLiesBeyondTheEarliestEntry) {
+    EXPECT_FALSE(wheel_.nextExpiry());
+
+    wheel_.add(at(5000), 1);
+    wheel_.add(at(70), 2);
+    EXPECT_EQ(wheel_.nextExpiry(), at(64)); // entry 2 moves down to level 0 at tick 64
+
+    wheel_.advance(at(64));
+    EXPECT_EQ(wheel_.nextExpiry(), at(70));
+}
+
+TEST_F(TimerWheelTests, DrainRemovesEveryEntry) {
+    wheel_.add(at(1), 1);
+    wheel_.add(at(100000), 2);
+
+    EXPECT_THAT(wheel_.drain(), UnorderedElementsAre(1, 2));
+    EXPECT_TRUE(wheel_.empty());
+    EXPECT_FALSE(wheel_.nextExpiry());
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+/* Add your project include files here */
+#include "core/schedule/WorkerPool.h"
+
+using namespace testing;
+using namespace service;
+
+TEST(WorkerPoolTests, RunsNoMoreJobsAtOnceThanItHasThreads) {
+    std::atomic<int> running{0};
+    std::atomic<int> most_running{0};
+    std::atomic<int> done{0};
+    {
+        core::WorkerPool pool(2);
+        for (int i = 0; i < 6; ++i) {
+            pool.submit([&] {
+                const auto now_running = ++running;
+                int most = most_running;
+                while (now_running > most && !most_running.compare_exchange_weak(most, now_running)) {
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                --running;
+                ++done;
+            });
+        }
+    }
+
+    EXPECT_EQ(done.load(), 6);
+    EXPECT_EQ(most_running.load(), 2);
+}
+
+TEST(WorkerPoolTests, DestructionRunsQueuedJobs) {
+    std::atomic<int> done{0};
+    {
+        core::WorkerPool pool(1);
+        pool.submit([] { std::this_thread::sleep_for(std::chrono::milliseconds(50)); });
+        for (int i = 0; i < 3; ++i) {
+            pool.submit([&done] { ++done; });
+        }
+    }
+
+    EXPECT_EQ(done.load(), 3);
+}
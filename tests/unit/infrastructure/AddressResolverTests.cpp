@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <future>
+#include <thread>
+/* Add your project include files here */
+#include "infrastructure/clients/AddressResolver.h"
+
+using namespace testing;
+using namespace service;
+
+class AddressResolverTests : public Test {
+protected:
+    infrastructure::AddressResolver::ResolveFunction fakeResolver() {
+        return [this](const std::string& host) {
+            ++lookups_;
+            if (fail_) {
+                return Result<std::string>::error("Failed to resolve " + host);
+            }
+            return Result<std::string>::success(ip_address_);
+        };
+    }
+
+    std::atomic<int> lookups_{0};
+    std::atomic<bool> fail_{false};
+    std::string ip_address_{"192.168.1.20"};
+};
+
+TEST_F(AddressResolverTests, ServesFreshEntriesFromCache) {
+    infrastructure::AddressResolver resolver(std::chrono::seconds(60), fakeResolver());
+
+    EXPECT_EQ(resolver.resolve("camera.local").value(), "192.168.1.20");
+    EXPECT_EQ(resolver.resolve("camera.local").value(), "192.168.1.20");
+    EXPECT_EQ(lookups_.load(), 1);
+}
+
+TEST_F(AddressResolverTests, BuildsIpv4ChannelTarget) {
+    infrastructure::AddressResolver resolver(std::chrono::seconds(60), fakeResolver());
+
+    const auto target = resolver.toChannelTarget("camera.local:50051");
+
+    ASSERT_TRUE(target.isSuccess());
+    EXPECT_EQ(target.value(), "ipv4:192.168.1.20:50051");
+}
+
+TEST_F(AddressResolverTests, Ipv4LiteralIsNotLookedUp) {
+    infrastructure::AddressResolver resolver(std::chrono::seconds(60), fakeResolver());
+
+    EXPECT_EQ(resolver.toChannelTarget("10.0.0.5:50050").value(), "ipv4:10.0.0.5:50050");
+    EXPECT_EQ(lookups_.load(), 0);
+}
+
+TEST_F(AddressResolverTests, FailsForUnresolvedHostWithoutHistory) {
+    fail_ = true;
+    infrastructure::AddressResolver resolver(std::chrono::seconds(60), fakeResolver());
+
+    EXPECT_TRUE(resolver.resolve("camera.local").isError());
+}
+
+TEST_F(AddressResolverTests, KeepsLastKnownGoodAddressWhenResolutionFails) {
+    infrastructure::AddressResolver resolver(std::chrono::seconds(1), fakeResolver());
+    ASSERT_TRUE(resolver.resolve("camera.local").isSuccess());
+
+    fail_ = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+    const auto ip_address = resolver.resolve("camera.local");
+    ASSERT_TRUE(ip_address.isSuccess());
+    EXPECT_EQ(ip_address.value(), "192.168.1.20");
+}
+
+TEST_F(AddressResolverTests, RejectsMissingPort) {
+    infrastructure::AddressResolver resolver(std::chrono::seconds(60), fakeResolver());
+
+    EXPECT_TRUE(resolver.toChannelTarget("camera.local").isError());
+}
+
+TEST_F(AddressResolverTests, ReportsHostsWhoseAddressChanged) {
+    std::atomic<int> lookups{0};
+    std::promise<std::string> changed;
+    infrastructure::AddressResolver resolver(
+        std::chrono::seconds(1),
+        [&lookups](const std::string&) {
+            return Result<std::string>::success(std::string(lookups++ == 0 ? "192.168.1.20" : "192.168.1.21"));
+        },
+        [&changed](const std::string& host) { changed.set_value(host); });
+    ASSERT_EQ(resolver.resolve("camera.local").value(), "192.168.1.20");
+
+    auto reported = changed.get_future();
+    ASSERT_EQ(reported.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_EQ(reported.get(), "camera.local");
+    EXPECT_EQ(resolver.resolve("camera.local").value(), "192.168.1.21");
+}
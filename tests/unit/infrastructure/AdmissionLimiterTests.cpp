@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "infrastructure/clients/AdmissionLimiter.h"
+
+using namespace testing;
+using namespace service;
+
+class AdmissionLimiterTests : public Test {
+protected:
+    using Clock = infrastructure::AdmissionLimiter::Clock;
+
+    static common::AdmissionConfig limitSets(const common::AdmissionMode mode) {
+        common::AdmissionConfig config;
+        config.set = {.rate_hz = 10, .burst = 1, .on_limit = mode, .max_wait = std::chrono::milliseconds(500)};
+        return config;
+    }
+
+    /**
+     * A zoom command sent to the backend, remembered in the order it arrived there
+     */
+    std::function<Result<uint32_t>()> setZoom(const uint32_t zoom) {
+        return [this, zoom] {
+            std::lock_guard lock(mutex_);
+            sent_.push_back(zoom);
+            return Result<uint32_t>::success(zoom);
+        };
+    }
+
+    /**
+     * setZoom() sent through an asynchronous client
+     */
+    infrastructure::AdmissionLimiter::AsyncSend<uint32_t> setZoomAsync(const uint32_t zoom) {
+        return [send = setZoom(zoom)] { return sendAsync(send); };
+    }
+
+    static common::async::Task<Result<uint32_t>> sendAsync(const std::function<Result<uint32_t>()> send) {
+        co_return send();
+    }
+
+    /**
+     * Timer the test fires by hand
+     */
+    infrastructure::AdmissionLimiter::Timer timer() {
+        return [this](Clock::time_point, std::function<void(bool)> wake) {
+            std::lock_guard lock(mutex_);
+            wakes_.push_back(std::move(wake));
+        };
+    }
+
+    std::size_t waiting() {
+        std::lock_guard lock(mutex_);
+        return wakes_.size();
+    }
+
+    void fire(const bool fired = true) {
+        std::vector<std::function<void(bool)>> wakes;
+        {
+            std::lock_guard lock(mutex_);
+            wakes.swap(wakes_);
+        }
+        for (const auto& wake : wakes) {
+            wake(fired);
+        }
+    }
+
+    std::mutex mutex_;
+    std::vector<uint32_t> sent_;
+    std::vector<std::function<void(bool)>> wakes_;
+};
+
+TEST_F(AdmissionLimiterTests, UnlimitedCommandsGoStraightThrough) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", {});
+
+    for (uint32_t zoom = 0; zoom < 100; ++zoom) {
+        ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(zoom)).isSuccess());
+    }
+    EXPECT_EQ(sent_.size(), 100u);
+}
+
+TEST_F(AdmissionLimiterTests, RejectFailsCommandsPastTheLimit) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Reject));
+
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(10)).isSuccess());
+    const auto rejected = limiter.command<uint32_t>("zoom", setZoom(20));
+
+    ASSERT_TRUE(rejected.isError());
+    EXPECT_EQ(rejected.error().code, common::types::ErrorCode::AdmissionRejected);
+    EXPECT_THAT(rejected.error().message, HasSubstr("camera_service instance 0"));
+    EXPECT_THAT(sent_, ElementsAre(10u));
+}
+
+TEST_F(AdmissionLimiterTests, QueueWaitsForTheNextToken) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Queue));
+
+    const auto started = Clock::now();
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(10)).isSuccess());
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(20)).isSuccess());
+
+    EXPECT_GE(Clock::now() - started, std::chrono::milliseconds(100));
+    EXPECT_THAT(sent_, ElementsAre(10u, 20u));
+}
+
+TEST_F(AdmissionLimiterTests, QueueRejectsWaitsBeyondItsBound) {
+    auto config = limitSets(common::AdmissionMode::Queue);
+    config.set.max_wait = std::chrono::milliseconds(150);
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", config);
+
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(10)).isSuccess());
+    std::thread queued([&] { EXPECT_TRUE(limiter.command<uint32_t>("zoom", setZoom(20)).isSuccess()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto rejected = limiter.command<uint32_t>("zoom", setZoom(30));
+    queued.join();
+
+    ASSERT_TRUE(rejected.isError());
+    EXPECT_EQ(rejected.error().code, common::types::ErrorCode::AdmissionRejected);
+    EXPECT_THAT(sent_, ElementsAre(10u, 20u));
+}
+
+TEST_F(AdmissionLimiterTests, ConflateSendsTheNewestCommandOfAKind) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Conflate));
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(10)).isSuccess());
+
+    std::vector<uint32_t> results(3);
+    std::vector<std::thread> callers;
+    for (uint32_t index = 0; index < results.size(); ++index) {
+        callers.emplace_back([&, index] {
+            const auto result = limiter.command<uint32_t>("zoom", setZoom(20 + index));
+            results[index] = result.isSuccess() ? result.value() : 0;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    EXPECT_THAT(sent_, ElementsAre(10u, 22u));
+    EXPECT_THAT(results, Each(22u));
+}
+
+TEST_F(AdmissionLimiterTests, ConflateKeepsKindsApart) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Conflate));
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(10)).isSuccess());
+
+    std::thread zoom([&] { EXPECT_TRUE(limiter.command<uint32_t>("zoom", setZoom(20)).isSuccess()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread focus([&] { EXPECT_TRUE(limiter.command<uint32_t>("focus", setZoom(30)).isSuccess()); });
+    zoom.join();
+    focus.join();
+
+    EXPECT_THAT(sent_, ElementsAre(10u, 20u, 30u));
+}
+
+TEST_F(AdmissionLimiterTests, ReadsAreLimitedApartFromSets) {
+    auto config = limitSets(common::AdmissionMode::Reject);
+    config.get = {.rate_hz = 10, .burst = 2, .on_limit = common::AdmissionMode::Reject};
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", config);
+    const std::function<Result<bool>()> read = [] { return Result<bool>::success(true); };
+
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(10)).isSuccess());
+    EXPECT_TRUE(limiter.read(read).isSuccess());
+    EXPECT_TRUE(limiter.read(read).isSuccess());
+    EXPECT_TRUE(limiter.read(read).isError());
+}
+
+TEST_F(AdmissionLimiterTests, AsyncCommandsAwaitTheirTokenOnTheTimer) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Queue),
+                                             timer());
+    ASSERT_TRUE(common::async::syncWait(limiter.commandAsync<uint32_t>("zoom", setZoomAsync(10))).isSuccess());
+
+    std::atomic<bool> done{false};
+    common::async::start(limiter.commandAsync<uint32_t>("zoom", setZoomAsync(20)), [&](const Result<uint32_t>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        done = true;
+    });
+
+    // Nothing waits on this thread, the command goes out when the timer fires
+    EXPECT_FALSE(done);
+    EXPECT_EQ(waiting(), 1u);
+    fire();
+    EXPECT_TRUE(done);
+    EXPECT_THAT(sent_, ElementsAre(10u, 20u));
+}
+
+TEST_F(AdmissionLimiterTests, AsyncCommandsConflateWithSynchronousOnes) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Conflate),
+                                             timer());
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(10)).isSuccess());
+
+    std::vector<uint32_t> results;
+    for (const uint32_t zoom : {20u, 30u}) {
+        common::async::start(limiter.commandAsync<uint32_t>("zoom", setZoomAsync(zoom)),
+                             [&](const Result<uint32_t>& result) { results.push_back(result.value()); });
+    }
+    ASSERT_EQ(waiting(), 1u);
+    fire();
+
+    EXPECT_THAT(sent_, ElementsAre(10u, 30u));
+    EXPECT_THAT(results, ElementsAre(30u, 30u));
+}
+
+TEST_F(AdmissionLimiterTests, StoppedTimerFailsWaitingCommands) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Conflate),
+                                             timer());
+    ASSERT_TRUE(limiter.command<uint32_t>("zoom", setZoom(10)).isSuccess());
+
+    std::vector<bool> failed;
+    for (const uint32_t zoom : {20u, 30u}) {
+        common::async::start(limiter.commandAsync<uint32_t>("zoom", setZoomAsync(zoom)),
+                             [&](const Result<uint32_t>& result) { failed.push_back(result.isError()); });
+    }
+    fire(false);
+
+    EXPECT_THAT(failed, ElementsAre(true, true));
+    EXPECT_THAT(sent_, ElementsAre(10u));
+}
+
+TEST_F(AdmissionLimiterTests, RawCallsTakeTokensFromTheSameBucket) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Reject));
+
+    ASSERT_TRUE(common::async::syncWait(limiter.acquireAsync(true)).isSuccess());
+    const auto rejected = limiter.command<uint32_t>("zoom", setZoom(10));
+
+    ASSERT_TRUE(rejected.isError());
+    EXPECT_EQ(rejected.error().code, common::types::ErrorCode::AdmissionRejected);
+    EXPECT_TRUE(common::async::syncWait(limiter.acquireAsync(false)).isSuccess());
+    EXPECT_TRUE(sent_.empty());
+}
+
+TEST_F(AdmissionLimiterTests, ConflatedLimitQueuesRawCommands) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Conflate));
+
+    const auto started = Clock::now();
+    ASSERT_TRUE(common::async::syncWait(limiter.acquireAsync(true)).isSuccess());
+    ASSERT_TRUE(common::async::syncWait(limiter.acquireAsync(true)).isSuccess());
+
+    EXPECT_GE(Clock::now() - started, std::chrono::milliseconds(100));
+}
+
+TEST_F(AdmissionLimiterTests, RawCallsAwaitTheirTokenOnTheTimer) {
+    infrastructure::AdmissionLimiter limiter("camera_service instance 0", limitSets(common::AdmissionMode::Queue),
+                                             timer());
+    ASSERT_TRUE(common::async::syncWait(limiter.acquireAsync(true)).isSuccess());
+
+    std::atomic<bool> admitted{false};
+    common::async::start(limiter.acquireAsync(true), [&](const Result<void>& result) {
+        admitted = result.isSuccess();
+    });
+
+    EXPECT_FALSE(admitted);
+    fire();
+    EXPECT_TRUE(admitted);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <grpcpp/grpcpp.h>
+/* Add your project include files here */
+#include "api/proto/camera_service.grpc.pb.h"
+#include "infrastructure/clients/ChannelWarmup.h"
+
+using namespace testing;
+using namespace service;
+
+class ChannelWarmupTests : public Test {
+protected:
+    void SetUp() override {
+        grpc::ServerBuilder builder;
+        builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port_);
+        builder.RegisterService(&service_);
+        server_ = builder.BuildAndStart();
+        ASSERT_NE(nullptr, server_);
+    }
+
+    void TearDown() override {
+        if (server_) {
+            server_->Shutdown();
+        }
+    }
+
+    std::shared_ptr<grpc::Channel> liveChannel() const {
+        return grpc::CreateChannel("127.0.0.1:" + std::to_string(port_), grpc::InsecureChannelCredentials());
+    }
+
+    static std::shared_ptr<grpc::Channel> deadChannel() {
+        // Port 1 (tcpmux) is privileged and not listening in the test environment
+        return grpc::CreateChannel("127.0.0.1:1", grpc::InsecureChannelCredentials());
+    }
+
+    camera::v1::CameraService::Service service_;
+    int port_{0};
+    std::unique_ptr<grpc::Server> server_;
+};
+
+TEST_F(ChannelWarmupTests, ConnectsAllReachableChannels) {
+    infrastructure::ChannelWarmup warmup({{"camera_service", 0, liveChannel()}, {"video_service", 0, liveChannel()}},
+                                         std::chrono::seconds(5));
+
+    EXPECT_TRUE(warmup.waitForReady(1.0));
+    EXPECT_EQ(warmup.readyCount(), 2u);
+    EXPECT_EQ(warmup.totalCount(), 2u);
+}
+
+TEST_F(ChannelWarmupTests, ReachesFractionWithUnreachableBackend) {
+    infrastructure::ChannelWarmup warmup({{"camera_service", 0, liveChannel()}, {"camera_service", 1, deadChannel()}},
+                                         std::chrono::milliseconds(300));
+
+    EXPECT_TRUE(warmup.waitForReady(0.5));
+    EXPECT_EQ(warmup.readyCount(), 1u);
+}
+
+TEST_F(ChannelWarmupTests, GivesUpWhenBudgetIsSpent) {
+    infrastructure::ChannelWarmup warmup({{"camera_service", 0, liveChannel()}, {"camera_service", 1, deadChannel()}},
+                                         std::chrono::milliseconds(300));
+
+    EXPECT_FALSE(warmup.waitForReady(1.0));
+    EXPECT_TRUE(warmup.isComplete());
+    EXPECT_EQ(warmup.readyCount(), 1u);
+}
+
+TEST_F(ChannelWarmupTests, ZeroFractionDoesNotWait) {
+    infrastructure::ChannelWarmup warmup({{"camera_service", 1, deadChannel()}}, std::chrono::seconds(30));
+
+    EXPECT_TRUE(warmup.waitForReady(0.0));
+    warmup.cancel();
+    EXPECT_TRUE(warmup.isComplete());
+}
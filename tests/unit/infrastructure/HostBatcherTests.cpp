@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <grpcpp/grpcpp.h>
+/* Add your project include files here */
+#include "common/state/CallContext.h"
+#include "infrastructure/clients/HostBatcher.h"
+
+using namespace testing;
+using namespace service;
+
+namespace {
+    class FakeBatchCameraService final : public camera::v1::CameraService::Service {
+    public:
+        explicit FakeBatchCameraService(const bool supports_batch) : supports_batch_(supports_batch) {}
+
+        grpc::Status ExecuteBatch(grpc::ServerContext*, const camera::v1::BatchRequest* request,
+                                  camera::v1::BatchResponse* response) override {
+            if (!supports_batch_) {
+                return {grpc::StatusCode::UNIMPLEMENTED, "ExecuteBatch not supported"};
+            }
+
+            ++batch_calls;
+            last_batch_size = request->commands_size();
+            std::this_thread::sleep_for(delay.load());
+            for (const auto& command : request->commands()) {
+                auto* result = response->add_results();
+                if (command.has_get_zoom()) {
+                    result->mutable_get_zoom()->set_zoom(command.port());
+                } else {
+                    result->set_status_code(grpc::StatusCode::FAILED_PRECONDITION);
+                    result->set_error_message("unexpected command");
+                }
+            }
+            return grpc::Status::OK;
+        }
+
+        std::atomic<int> batch_calls{0};
+        std::atomic<int> last_batch_size{0};
+        std::atomic<std::chrono::milliseconds> delay{std::chrono::milliseconds::zero()};
+
+    private:
+        bool supports_batch_;
+    };
+} // unnamed namespace
+
+class HostBatcherTests : public Test {
+protected:
+    void startServer(const bool supports_batch) {
+        service_ = std::make_unique<FakeBatchCameraService>(supports_batch);
+        grpc::ServerBuilder builder;
+        int port = 0;
+        builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+        builder.RegisterService(service_.get());
+        server_ = builder.BuildAndStart();
+        ASSERT_NE(nullptr, server_);
+        channel_ = grpc::CreateChannel("127.0.0.1:" + std::to_string(port), grpc::InsecureChannelCredentials());
+    }
+
+    void TearDown() override {
+        if (server_) {
+            server_->Shutdown();
+        }
+    }
+
+    static common::BatchingConfig batchingConfig() {
+        common::BatchingConfig config;
+        config.enabled = true;
+        config.window = std::chrono::milliseconds(50);
+        config.max_batch_size = 2;
+        return config;
+    }
+
+    static camera::v1::BatchCommand getZoomCommand(const uint32_t port) {
+        camera::v1::BatchCommand command;
+        command.set_port(port);
+        command.mutable_get_zoom();
+        return command;
+    }
+
+    std::unique_ptr<FakeBatchCameraService> service_;
+    std::unique_ptr<grpc::Server> server_;
+    std::shared_ptr<grpc::Channel> channel_;
+};
+
+TEST_F(HostBatcherTests, ConcurrentCommandsAreSentAsOneBatch) {
+    startServer(true);
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, batchingConfig());
+    const auto busy_sibling = batcher.track(50052);
+
+    std::optional<camera::v1::BatchResult> first;
+    std::optional<camera::v1::BatchResult> second;
+    {
+        std::jthread first_caller([&] { first = batcher.execute(getZoomCommand(50050)); });
+        std::jthread second_caller([&] { second = batcher.execute(getZoomCommand(50051)); });
+    }
+
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->get_zoom().zoom(), 50050u);
+    EXPECT_EQ(second->get_zoom().zoom(), 50051u);
+    EXPECT_EQ(service_->batch_calls.load(), 1);
+    EXPECT_EQ(service_->last_batch_size.load(), 2);
+}
+
+TEST_F(HostBatcherTests, RoundTripsLeaveOutTheBatchingWindow) {
+    startServer(true);
+    auto config = batchingConfig();
+    config.window = std::chrono::milliseconds(200);
+    config.max_batch_size = 3;
+    std::mutex mutex;
+    std::map<uint32_t, std::chrono::microseconds> round_trips;
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, config,
+                                        [&](const uint32_t port, const std::chrono::microseconds round_trip) {
+                                            std::lock_guard lock(mutex);
+                                            round_trips[port] = round_trip;
+                                        });
+    const auto busy_sibling = batcher.track(50052);
+
+    {
+        std::jthread first_caller([&] { batcher.execute(getZoomCommand(50050)); });
+        std::jthread second_caller([&] { batcher.execute(getZoomCommand(50051)); });
+    }
+
+    std::lock_guard lock(mutex);
+    ASSERT_EQ(round_trips.size(), 2u);
+    EXPECT_LT(round_trips[50050], config.window);
+    EXPECT_LT(round_trips[50051], config.window);
+}
+
+TEST_F(HostBatcherTests, SingleCommandIsSentIndividually) {
+    startServer(true);
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, batchingConfig());
+
+    const auto result = batcher.execute(getZoomCommand(50050));
+
+    EXPECT_FALSE(result.has_value());
+    EXPECT_EQ(service_->batch_calls.load(), 0);
+}
+
+TEST_F(HostBatcherTests, LoneCommandIsNotHeldForTheWindow) {
+    startServer(true);
+    auto config = batchingConfig();
+    config.window = std::chrono::milliseconds(500);
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, config);
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto result = batcher.execute(getZoomCommand(50050));
+
+    EXPECT_FALSE(result.has_value());
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(250));
+}
+
+TEST_F(HostBatcherTests, WindowIsHeldWhileSiblingIsBusy) {
+    startServer(true);
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, batchingConfig());
+    const auto busy_sibling = batcher.track(50051);
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto result = batcher.execute(getZoomCommand(50050));
+
+    EXPECT_FALSE(result.has_value());
+    EXPECT_GE(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(50));
+    EXPECT_EQ(service_->batch_calls.load(), 0);
+}
+
+TEST_F(HostBatcherTests, ExecuteAsyncDoesNotHoldTheCallerForTheWindow) {
+    startServer(true);
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, batchingConfig());
+    const auto busy_sibling = batcher.track(50051);
+
+    std::promise<std::optional<camera::v1::BatchResult>> finished;
+    const auto started = std::chrono::steady_clock::now();
+    common::async::start(batcher.executeAsync(getZoomCommand(50050), {}),
+                         [&finished](std::optional<camera::v1::BatchResult> result) {
+                             finished.set_value(std::move(result));
+                         });
+    const auto returned_after = std::chrono::steady_clock::now() - started;
+
+    auto result = finished.get_future();
+    EXPECT_LT(returned_after, std::chrono::milliseconds(50));
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_FALSE(result.get().has_value());
+    EXPECT_GE(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(50));
+}
+
+TEST_F(HostBatcherTests, FallsBackWhenBatchIsUnimplemented) {
+    startServer(false);
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, batchingConfig());
+    const auto busy_sibling = batcher.track(50052);
+
+    std::optional<camera::v1::BatchResult> first;
+    std::optional<camera::v1::BatchResult> second;
+    {
+        std::jthread first_caller([&] { first = batcher.execute(getZoomCommand(50050)); });
+        std::jthread second_caller([&] { second = batcher.execute(getZoomCommand(50051)); });
+    }
+
+    EXPECT_FALSE(first.has_value());
+    EXPECT_FALSE(second.has_value());
+    EXPECT_FALSE(batcher.isSupported());
+    EXPECT_FALSE(batcher.execute(getZoomCommand(50050)).has_value());
+}
+
+TEST_F(HostBatcherTests, BatchErrorIsReportedPerCommand) {
+    startServer(true);
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, batchingConfig());
+    const auto busy_sibling = batcher.track(50052);
+
+    std::optional<camera::v1::BatchResult> zoom;
+    std::optional<camera::v1::BatchResult> focus;
+    {
+        std::jthread zoom_caller([&] { zoom = batcher.execute(getZoomCommand(50050)); });
+        std::jthread focus_caller([&] {
+            camera::v1::BatchCommand command;
+            command.set_port(50051);
+            command.mutable_get_focus();
+            focus = batcher.execute(command);
+        });
+    }
+
+    ASSERT_TRUE(zoom.has_value());
+    ASSERT_TRUE(focus.has_value());
+    EXPECT_EQ(zoom->status_code(), grpc::StatusCode::OK);
+    EXPECT_EQ(focus->status_code(), grpc::StatusCode::FAILED_PRECONDITION);
+}
+
+TEST_F(HostBatcherTests, BatchIsBoundByItsEarliestDeadline) {
+    startServer(true);
+    service_->delay = std::chrono::milliseconds(1000);
+    infrastructure::HostBatcher batcher("127.0.0.1", channel_, batchingConfig());
+    const auto busy_sibling = batcher.track(50052);
+
+    const auto started = std::chrono::steady_clock::now();
+    std::optional<camera::v1::BatchResult> urgent;
+    std::optional<camera::v1::BatchResult> relaxed;
+    {
+        std::jthread urgent_caller([&] {
+            common::state::CallContext call;
+            call.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+            common::state::CallContext::Scope scope(call);
+            urgent = batcher.execute(getZoomCommand(50050));
+        });
+        std::jthread relaxed_caller([&] { relaxed = batcher.execute(getZoomCommand(50051)); });
+    }
+
+    ASSERT_TRUE(urgent.has_value());
+    ASSERT_TRUE(relaxed.has_value());
+    EXPECT_EQ(urgent->status_code(), grpc::StatusCode::DEADLINE_EXCEEDED);
+    EXPECT_EQ(relaxed->status_code(), grpc::StatusCode::DEADLINE_EXCEEDED);
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(800));
+}
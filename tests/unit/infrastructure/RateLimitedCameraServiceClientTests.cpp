@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "infrastructure/clients/RateLimitedCameraServiceClient.h"
+
+using namespace testing;
+using namespace service;
+
+namespace {
+    /**
+     * Commands that reached the backend in order, and which path the zoom setpoints took
+     */
+    struct Backend {
+        void record(const std::string& command) {
+            std::lock_guard lock(mutex);
+            commands.push_back(command);
+        }
+
+        std::vector<std::string> sent() {
+            std::lock_guard lock(mutex);
+            return commands;
+        }
+
+        std::mutex mutex;
+        std::vector<std::string> commands;
+        std::atomic<int> sync_sets{0};
+        std::atomic<int> async_sets{0};
+    };
+
+    /**
+     * camera_service client answering at once
+     */
+    class FakeCameraClient final : public infrastructure::ICameraServiceClient {
+    public:
+        explicit FakeCameraClient(Backend& backend) : backend_(backend) {}
+
+        Result<common::types::zoom> setZoom(const common::types::zoom zoom_level) override {
+            ++backend_.sync_sets;
+            backend_.record("zoom " + std::to_string(zoom_level));
+            return Result<common::types::zoom>::success(zoom_level);
+        }
+
+        common::async::Task<Result<common::types::zoom>> setZoomAsync(common::state::CallContext,
+                                                                      const common::types::zoom zoom_level) override {
+            ++backend_.async_sets;
+            backend_.record("zoom " + std::to_string(zoom_level));
+            co_return Result<common::types::zoom>::success(zoom_level);
+        }
+
+        Result<common::types::zoom> getZoom() override { return Result<common::types::zoom>::success(0u); }
+
+        Result<common::types::zoom> goToMinZoom() override {
+            backend_.record("min_zoom");
+            return Result<common::types::zoom>::success(0u);
+        }
+
+        Result<common::types::zoom> goToMaxZoom() override {
+            backend_.record("max_zoom");
+            return Result<common::types::zoom>::success(100u);
+        }
+
+        Result<common::types::focus> setFocus(const common::types::focus focus_value) override {
+            return Result<common::types::focus>::success(focus_value);
+        }
+
+        Result<common::types::focus> getFocus() override { return Result<common::types::focus>::success(0u); }
+        Result<void> enableAutoFocus(bool) override { return Result<void>::success(); }
+        Result<bool> getAutoFocus() override { return Result<bool>::success(false); }
+
+        Result<common::types::info> getInfo() override {
+            return Result<common::types::info>::success(std::string("camera"));
+        }
+
+        Result<void> stabilize(bool) override { return Result<void>::success(); }
+        Result<bool> getStabilization() override { return Result<bool>::success(false); }
+
+        Result<common::capabilities::CapabilityList> getCapabilities() override {
+            return Result<common::capabilities::CapabilityList>::success(common::capabilities::CapabilityList{});
+        }
+
+    private:
+        Backend& backend_;
+    };
+} // unnamed namespace
+
+class RateLimitedCameraServiceClientTests : public Test {
+protected:
+    static constexpr auto MAX_WAIT = std::chrono::milliseconds(500);
+
+    std::unique_ptr<infrastructure::RateLimitedCameraServiceClient> limitedClient(const double rate_hz,
+                                                                                  const common::AdmissionMode mode) {
+        common::AdmissionConfig config;
+        config.set = {.rate_hz = rate_hz, .burst = 1, .on_limit = mode, .max_wait = MAX_WAIT};
+        return std::make_unique<infrastructure::RateLimitedCameraServiceClient>(
+            std::make_unique<FakeCameraClient>(backend_),
+            std::make_unique<infrastructure::AdmissionLimiter>("camera_service instance 0", config));
+    }
+
+    Backend backend_;
+};
+
+TEST_F(RateLimitedCameraServiceClientTests, ZoomSetpointDoesNotReplaceAQueuedEndStop) {
+    const auto client = limitedClient(10, common::AdmissionMode::Conflate);
+    ASSERT_TRUE(client->setZoom(30).isSuccess());
+
+    std::jthread end_stop([&client] { EXPECT_TRUE(client->goToMaxZoom().isSuccess()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(client->setZoom(40).isSuccess());
+    end_stop.join();
+
+    EXPECT_THAT(backend_.sent(), ElementsAre("zoom 30", "max_zoom", "zoom 40"));
+}
+
+TEST_F(RateLimitedCameraServiceClientTests, NewestZoomCommandIsSentLast) {
+    const auto client = limitedClient(10, common::AdmissionMode::Conflate);
+    ASSERT_TRUE(client->setZoom(30).isSuccess());
+
+    // 50 waits for the next token, the end stop for the one after, 80 must not overtake the end stop through 50
+    std::jthread setpoint([&client] { EXPECT_TRUE(client->setZoom(50).isSuccess()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::jthread end_stop([&client] { EXPECT_TRUE(client->goToMinZoom().isSuccess()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(client->setZoom(80).isSuccess());
+    setpoint.join();
+    end_stop.join();
+
+    EXPECT_THAT(backend_.sent(), ElementsAre("zoom 30", "zoom 50", "min_zoom", "zoom 80"));
+}
+
+TEST_F(RateLimitedCameraServiceClientTests, AsyncSetWithATokenAtHandStaysAsynchronous) {
+    const auto client = limitedClient(10, common::AdmissionMode::Queue);
+
+    const auto result = common::async::syncWait(client->setZoomAsync({}, 30));
+
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(backend_.async_sets.load(), 1);
+    EXPECT_EQ(backend_.sync_sets.load(), 0);
+}
+
+TEST_F(RateLimitedCameraServiceClientTests, AsyncSetPastTheLimitWaitsForItsTokenAsynchronously) {
+    const auto client = limitedClient(10, common::AdmissionMode::Queue);
+    ASSERT_TRUE(common::async::syncWait(client->setZoomAsync({}, 30)).isSuccess());
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto result = common::async::syncWait(client->setZoomAsync({}, 40));
+    const auto waited = std::chrono::steady_clock::now() - started;
+
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(result.value(), 40u);
+    EXPECT_EQ(backend_.async_sets.load(), 2);
+    EXPECT_EQ(backend_.sync_sets.load(), 0);
+    // The next token of a 10 Hz bucket, never longer than max_wait
+    EXPECT_GE(waited, std::chrono::milliseconds(50));
+    EXPECT_LT(waited, MAX_WAIT);
+}
+
+TEST_F(RateLimitedCameraServiceClientTests, UnlimitedAsyncSetsStayAsynchronous) {
+    const auto client = limitedClient(0, common::AdmissionMode::Queue);
+
+    for (uint32_t zoom = 0; zoom < 10; ++zoom) {
+        ASSERT_TRUE(common::async::syncWait(client->setZoomAsync({}, zoom)).isSuccess());
+    }
+
+    EXPECT_EQ(backend_.async_sets.load(), 10);
+    EXPECT_EQ(backend_.sync_sets.load(), 0);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+/* Add your project include files here */
+#include "infrastructure/clients/TokenBucket.h"
+
+using namespace testing;
+using namespace service;
+
+class TokenBucketTests : public Test {
+protected:
+    using Clock = infrastructure::TokenBucket::Clock;
+
+    const Clock::time_point start_ = Clock::now();
+};
+
+TEST_F(TokenBucketTests, GrantsTheBurstAtOnce) {
+    infrastructure::TokenBucket bucket(10, 3);
+
+    for (int call = 0; call < 3; ++call) {
+        const auto reservation = bucket.reserve(start_);
+        EXPECT_TRUE(reservation.granted);
+        EXPECT_EQ(reservation.ready, start_);
+    }
+    const auto reservation = bucket.reserve(start_);
+    EXPECT_FALSE(reservation.granted);
+    EXPECT_EQ(reservation.ready, start_ + std::chrono::milliseconds(100));
+}
+
+TEST_F(TokenBucketTests, RefillsAtItsRate) {
+    infrastructure::TokenBucket bucket(10, 1);
+    ASSERT_TRUE(bucket.reserve(start_).granted);
+
+    EXPECT_FALSE(bucket.reserve(start_ + std::chrono::milliseconds(50)).granted);
+    EXPECT_TRUE(bucket.reserve(start_ + std::chrono::milliseconds(100)).granted);
+    EXPECT_TRUE(bucket.reserve(start_ + std::chrono::seconds(5)).granted);
+    EXPECT_FALSE(bucket.reserve(start_ + std::chrono::seconds(5)).granted);
+}
+
+TEST_F(TokenBucketTests, ReservesTokensAheadWithinTheWait) {
+    infrastructure::TokenBucket bucket(10, 1);
+    ASSERT_TRUE(bucket.reserve(start_).granted);
+
+    const auto first = bucket.reserve(start_, std::chrono::milliseconds(250));
+    const auto second = bucket.reserve(start_, std::chrono::milliseconds(250));
+    const auto third = bucket.reserve(start_, std::chrono::milliseconds(250));
+
+    EXPECT_TRUE(first.granted);
+    EXPECT_EQ(first.ready, start_ + std::chrono::milliseconds(100));
+    EXPECT_TRUE(second.granted);
+    EXPECT_EQ(second.ready, start_ + std::chrono::milliseconds(200));
+    EXPECT_FALSE(third.granted);
+    EXPECT_EQ(third.ready, start_ + std::chrono::milliseconds(300));
+}
+
+TEST_F(TokenBucketTests, ConcurrentCallersShareTheBurst) {
+    infrastructure::TokenBucket bucket(1, 100);
+    std::atomic<int> granted{0};
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 8; ++thread) {
+        threads.emplace_back([&] {
+            for (int call = 0; call < 50; ++call) {
+                if (bucket.reserve(start_).granted) {
+                    ++granted;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(granted, 100);
+}